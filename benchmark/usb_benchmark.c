@@ -0,0 +1,363 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_benchmark.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The (micro)frames to run before a device is started, the host loopback controller settles */
+#define USB_BENCHMARK_IDLE_FRAMES (10U)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static usb_status_t USB_BenchmarkHostCallback(usb_device_handle deviceHandle,
+                                              usb_host_configuration_handle configurationHandle,
+                                              uint32_t eventCode);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The benchmark instance, the host callback has no parameter */
+static usb_benchmark_struct_t s_Benchmark;
+
+/* The runners of the classes enabled in both stacks */
+static const usb_benchmark_runner_t s_BenchmarkRunners[] = {
+#if ((defined(USB_DEVICE_CONFIG_MSC)) && (USB_DEVICE_CONFIG_MSC > 0U) && (defined(USB_HOST_CONFIG_MSD)) && \
+     (USB_HOST_CONFIG_MSD > 0U))
+    USB_BenchmarkMsc,
+#endif
+#if ((defined(USB_DEVICE_CONFIG_CDC_ACM)) && (USB_DEVICE_CONFIG_CDC_ACM > 0U) && (defined(USB_HOST_CONFIG_CDC)) && \
+     (USB_HOST_CONFIG_CDC > 0U))
+    USB_BenchmarkCdcAcm,
+#endif
+#if ((defined(USB_DEVICE_CONFIG_CDC_RNDIS)) && (USB_DEVICE_CONFIG_CDC_RNDIS > 0U) && \
+     (defined(USB_HOST_CONFIG_CDC_RNDIS)) && (USB_HOST_CONFIG_CDC_RNDIS > 0U))
+    USB_BenchmarkCdcRndis,
+#endif
+#if ((defined(USB_DEVICE_CONFIG_HID)) && (USB_DEVICE_CONFIG_HID > 0U) && (defined(USB_HOST_CONFIG_HID)) && \
+     (USB_HOST_CONFIG_HID > 0U))
+    USB_BenchmarkHid,
+#endif
+#if ((defined(USB_DEVICE_CONFIG_VIDEO)) && (USB_DEVICE_CONFIG_VIDEO > 0U) && (defined(USB_HOST_CONFIG_VIDEO)) && \
+     (USB_HOST_CONFIG_VIDEO > 0U))
+    USB_BenchmarkVideo,
+#endif
+#if ((defined(USB_DEVICE_CONFIG_AUDIO)) && (USB_DEVICE_CONFIG_AUDIO > 0U) && (defined(USB_HOST_CONFIG_AUDIO)) && \
+     (USB_HOST_CONFIG_AUDIO > 0U) && (defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) &&                          \
+     (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+    USB_BenchmarkAudio,
+#endif
+    NULL,
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Host callback.
+ *
+ * Every configuration of the benchmark devices is accepted, the runner binds its host class driver after the
+ * enumeration.
+ *
+ * @param deviceHandle        The host side device handle.
+ * @param configurationHandle The configuration handle.
+ * @param eventCode           The host event.
+ *
+ * @return kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkHostCallback(usb_device_handle deviceHandle,
+                                              usb_host_configuration_handle configurationHandle,
+                                              uint32_t eventCode)
+{
+    switch (eventCode & 0x0000FFFFU)
+    {
+        case kUSB_HostEventAttach:
+            break;
+
+        case kUSB_HostEventEnumerationDone:
+            s_Benchmark.attachedDeviceHandle = deviceHandle;
+            s_Benchmark.configurationHandle  = configurationHandle;
+            s_Benchmark.enumerated           = 1U;
+            break;
+
+        case kUSB_HostEventDetach:
+            /* The device handle is kept, the host class driver is de-initialized after the detach */
+            s_Benchmark.configurationHandle = NULL;
+            s_Benchmark.enumerated          = 0U;
+            break;
+
+        default:
+            /*no action*/
+            break;
+    }
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_BenchmarkDeviceCallback(usb_device_handle handle, uint32_t event, void *param)
+{
+    usb_benchmark_struct_t *benchmark = &s_Benchmark;
+    usb_status_t error                = kStatus_USB_InvalidRequest;
+    uint8_t interface;
+
+    switch (event)
+    {
+        case kUSB_DeviceEventBusReset:
+            benchmark->configuration = 0U;
+            error                    = kStatus_USB_Success;
+            break;
+
+        case kUSB_DeviceEventSetConfiguration:
+            benchmark->configuration = *((uint8_t *)param);
+            (void)memset(benchmark->alternateSetting, 0, sizeof(benchmark->alternateSetting));
+            error = kStatus_USB_Success;
+            break;
+
+        case kUSB_DeviceEventGetConfiguration:
+            *((uint8_t *)param) = benchmark->configuration;
+            error               = kStatus_USB_Success;
+            break;
+
+        case kUSB_DeviceEventSetInterface:
+            /* The Bit[15~8] is the interface, the Bit[7~0] is the alternate setting */
+            interface = (uint8_t)((*((uint16_t *)param)) >> 8U);
+            if (interface < USB_BENCHMARK_INTERFACE_COUNT)
+            {
+                benchmark->alternateSetting[interface] = (uint8_t)(*((uint16_t *)param) & 0xFFU);
+                error                                  = kStatus_USB_Success;
+            }
+            break;
+
+        case kUSB_DeviceEventGetInterface:
+            interface = (uint8_t)((*((uint16_t *)param)) >> 8U);
+            if (interface < USB_BENCHMARK_INTERFACE_COUNT)
+            {
+                *((uint16_t *)param) = (uint16_t)(((uint32_t)interface << 8U) | benchmark->alternateSetting[interface]);
+                error                = kStatus_USB_Success;
+            }
+            break;
+
+        default:
+            /*no action*/
+            break;
+    }
+    return error;
+}
+
+void USB_BenchmarkRunFrames(usb_benchmark_struct_t *benchmark, uint32_t frames)
+{
+    while (frames > 0U)
+    {
+        USB_HostLoopbackTaskFunction(benchmark->hostHandle);
+        frames--;
+    }
+}
+
+usb_status_t USB_BenchmarkWait(usb_benchmark_struct_t *benchmark, volatile uint8_t *flag, uint32_t frames)
+{
+    while ((0U == *flag) && (frames > 0U))
+    {
+        USB_HostLoopbackTaskFunction(benchmark->hostHandle);
+        frames--;
+    }
+    return (0U != *flag) ? kStatus_USB_Success : kStatus_USB_Error;
+}
+
+void USB_BenchmarkRequestCallback(void *param, uint8_t *data, uint32_t dataLength, usb_status_t status)
+{
+    usb_benchmark_struct_t *benchmark = (usb_benchmark_struct_t *)param;
+
+    benchmark->requestStatus = status;
+    benchmark->requestDone   = 1U;
+}
+
+usb_status_t USB_BenchmarkRequestWait(usb_benchmark_struct_t *benchmark, usb_status_t status)
+{
+    if ((kStatus_USB_Success == status) &&
+        (kStatus_USB_Success != USB_BenchmarkWait(benchmark, &benchmark->requestDone, USB_BENCHMARK_TIMEOUT_FRAMES)))
+    {
+        status = kStatus_USB_Error;
+    }
+    if ((kStatus_USB_Success == status) && (kStatus_USB_Success != benchmark->requestStatus))
+    {
+        status = kStatus_USB_Error;
+    }
+    /* The next request starts with the flag cleared */
+    benchmark->requestDone = 0U;
+    return status;
+}
+
+usb_status_t USB_BenchmarkDeviceStart(usb_benchmark_struct_t *benchmark,
+                                      usb_device_class_config_list_struct_t *configList,
+                                      const usb_device_descriptor_table_struct_t *descriptorTable)
+{
+    if (kStatus_USB_Success !=
+        USB_DeviceClassInit((uint8_t)USB_BENCHMARK_CONTROLLER_ID, configList, &benchmark->deviceHandle))
+    {
+        return kStatus_USB_Error;
+    }
+    if ((kStatus_USB_Success !=
+         USB_DeviceClassSetDescriptorTable((uint8_t)USB_BENCHMARK_CONTROLLER_ID, descriptorTable)) ||
+        (kStatus_USB_Success != USB_DeviceRun(benchmark->deviceHandle)))
+    {
+        (void)USB_DeviceClassDeinit((uint8_t)USB_BENCHMARK_CONTROLLER_ID);
+        return kStatus_USB_Error;
+    }
+    return USB_BenchmarkWait(benchmark, &benchmark->enumerated, USB_BENCHMARK_TIMEOUT_FRAMES);
+}
+
+usb_status_t USB_BenchmarkDeviceStop(usb_benchmark_struct_t *benchmark)
+{
+    uint32_t frames = USB_BENCHMARK_TIMEOUT_FRAMES;
+
+    (void)USB_DeviceStop(benchmark->deviceHandle);
+    while ((0U != benchmark->enumerated) && (frames > 0U))
+    {
+        USB_HostLoopbackTaskFunction(benchmark->hostHandle);
+        frames--;
+    }
+    if (kStatus_USB_Success != USB_DeviceClassDeinit((uint8_t)USB_BENCHMARK_CONTROLLER_ID))
+    {
+        return kStatus_USB_Error;
+    }
+    benchmark->deviceHandle = NULL;
+    return (0U == benchmark->enumerated) ? kStatus_USB_Success : kStatus_USB_Error;
+}
+
+usb_host_interface_handle USB_BenchmarkGetInterface(usb_benchmark_struct_t *benchmark,
+                                                    uint8_t classCode,
+                                                    uint8_t subclassCode)
+{
+    usb_host_configuration_t *configuration = (usb_host_configuration_t *)benchmark->configurationHandle;
+    usb_host_interface_t *interface;
+    uint8_t index;
+
+    if (NULL == configuration)
+    {
+        return NULL;
+    }
+    for (index = 0U; index < configuration->interfaceCount; index++)
+    {
+        interface = &configuration->interfaceList[index];
+        if ((classCode == interface->interfaceDesc->bInterfaceClass) &&
+            (subclassCode == interface->interfaceDesc->bInterfaceSubClass))
+        {
+            return (usb_host_interface_handle)interface;
+        }
+    }
+    return NULL;
+}
+
+uint64_t USB_BenchmarkGetBusTime(usb_benchmark_struct_t *benchmark)
+{
+    usb_device_loopback_statistic_struct_t statistic;
+
+    if (kStatus_USB_Success !=
+        USB_DeviceLoopbackGetStatistic((uint8_t)USB_BENCHMARK_CONTROLLER_ID, &statistic))
+    {
+        return 0U;
+    }
+    return statistic.busTime;
+}
+
+void USB_BenchmarkStart(usb_benchmark_struct_t *benchmark)
+{
+    (void)USB_DeviceLoopbackGetStatistic((uint8_t)USB_BENCHMARK_CONTROLLER_ID, &benchmark->deviceStatistic);
+    (void)USB_HostLoopbackGetStatistic(benchmark->hostHandle, &benchmark->hostStatistic);
+    benchmark->callCycles = 0U;
+}
+
+void USB_BenchmarkStop(usb_benchmark_struct_t *benchmark, usb_benchmark_result_t *result)
+{
+    usb_device_loopback_statistic_struct_t deviceStatistic;
+    usb_host_loopback_statistic_t hostStatistic;
+
+    (void)USB_DeviceLoopbackGetStatistic((uint8_t)USB_BENCHMARK_CONTROLLER_ID, &deviceStatistic);
+    (void)USB_HostLoopbackGetStatistic(benchmark->hostHandle, &hostStatistic);
+
+    result->busTime = deviceStatistic.busTime - benchmark->deviceStatistic.busTime;
+    result->cycles  = (deviceStatistic.stackCycles - benchmark->deviceStatistic.stackCycles) +
+                     (hostStatistic.stackCycles - benchmark->hostStatistic.stackCycles) + benchmark->callCycles;
+}
+
+uint32_t USB_BenchmarkRate(uint32_t count, uint64_t busTime)
+{
+    if (0U == busTime)
+    {
+        return 0U;
+    }
+    /* The bus time is in picoseconds */
+    return (uint32_t)(((uint64_t)count * 1000000000000U) / busTime);
+}
+
+void USB_BenchmarkPrint(const char *name, const usb_benchmark_result_t *result)
+{
+    uint32_t kiloBytesPerSecond = 0U;
+    uint32_t cyclesPerByte      = 0U;
+    uint32_t cyclesPerTransfer  = 0U;
+
+    if (0U != result->busTime)
+    {
+        /* MB/s in thousandths, the bus time is in picoseconds */
+        kiloBytesPerSecond = (uint32_t)(((uint64_t)result->bytes * 1000000000U) / result->busTime);
+    }
+    if (0U != result->bytes)
+    {
+        /* cycles per byte in hundredths */
+        cyclesPerByte = (uint32_t)((result->cycles * 100U) / result->bytes);
+    }
+    if (0U != result->transfers)
+    {
+        cyclesPerTransfer = (uint32_t)(result->cycles / result->transfers);
+    }
+    usb_echo("%-24s %8u transfers %10u bytes %5u.%03u MB/s %6u.%02u cycles/byte %8u cycles/transfer\r\n", name,
+             result->transfers, result->bytes, kiloBytesPerSecond / 1000U, kiloBytesPerSecond % 1000U,
+             cyclesPerByte / 100U, cyclesPerByte % 100U, cyclesPerTransfer);
+}
+
+usb_status_t USB_BenchmarkRun(void)
+{
+    usb_benchmark_struct_t *benchmark = &s_Benchmark;
+    usb_status_t status               = kStatus_USB_Success;
+    uint32_t index;
+
+#if defined(DWT)
+    /* Start the DWT cycle counter read by USB_DEVICE_LOOPBACK_CYCLE_COUNTER */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    (void)memset(benchmark, 0, sizeof(*benchmark));
+    if (kStatus_USB_Success !=
+        USB_HostInit((uint8_t)USB_BENCHMARK_CONTROLLER_ID, &benchmark->hostHandle, USB_BenchmarkHostCallback))
+    {
+        usb_echo("host init error\r\n");
+        return kStatus_USB_Error;
+    }
+    USB_BenchmarkRunFrames(benchmark, USB_BENCHMARK_IDLE_FRAMES);
+
+    usb_echo("USB loopback benchmark, %s speed\r\n",
+             (USB_SPEED_HIGH == USB_HOST_LOOPBACK_BUS_SPEED) ? "high" : "full");
+    for (index = 0U; NULL != s_BenchmarkRunners[index]; index++)
+    {
+        if (kStatus_USB_Success != s_BenchmarkRunners[index](benchmark))
+        {
+            status = kStatus_USB_Error;
+        }
+    }
+    usb_echo("USB loopback benchmark %s\r\n", (kStatus_USB_Success == status) ? "done" : "failed");
+
+    (void)USB_HostDeinit(benchmark->hostHandle);
+    benchmark->hostHandle = NULL;
+    return status;
+}
@@ -0,0 +1,432 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __USB_BENCHMARK_H__
+#define __USB_BENCHMARK_H__
+
+#include "usb_host_config.h"
+#include "usb_device_config.h"
+#include "usb.h"
+#include "usb_host.h"
+#include "usb_host_loopback.h"
+#include "usb_device.h"
+#include "usb_device_class.h"
+#include "usb_device_dci.h"
+#include "usb_device_loopback.h"
+
+/*!
+ * @addtogroup usb_benchmark
+ * @{
+ */
+
+/*
+ * The benchmarks measure the hot paths of the class drivers on the software loopback controllers. The host stack
+ * and the device stack run in the same image: the host loopback controller drives the device loopback controller
+ * with the same controller ID, so the host class driver (host/class) talks to the device class driver
+ * (output/source/device/class) through the unmodified stacks.
+ *
+ * There is one runner per class. A runner initializes its device class with its descriptors, waits for the host to
+ * enumerate it, binds the host class driver, then moves the class traffic while the loopback controllers account
+ * the bus time and the CPU cycles:
+ *
+ * - MSC: READ(10) and WRITE(10) of a RAM disk at several block counts per command.
+ * - CDC ACM: small bulk writes from the host to the device.
+ * - RNDIS: Ethernet frames in REMOTE_NDIS_PACKET_MSG messages from the host to the device.
+ * - HID: interrupt IN reports, the latency from the device send to the host completion.
+ * - UVC: ISO IN video frames with payload headers after the probe and commit negotiation, the frame rate.
+ * - UAC: an ISO OUT stream from the host streaming engine to the device, the arrival jitter.
+ *
+ * Each measurement prints the MB/s on the simulated bus, and the CPU cycles per byte and per class transfer spent in
+ * the device and host stacks and the class drivers (the loopback controllers themselves are not accounted). The
+ * cycles are read by USB_DEVICE_LOOPBACK_CYCLE_COUNTER, the DWT cycle counter on Cortex-M.
+ *
+ * The benchmarks run to completion in the calling task, the loopback controllers need no interrupt.
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The controller ID of the host and the device loopback controllers */
+#define USB_BENCHMARK_CONTROLLER_ID (kUSB_ControllerLoopback0)
+
+/*! @brief The (micro)frames to wait for the enumeration, the detach or a class request */
+#define USB_BENCHMARK_TIMEOUT_FRAMES (20000U)
+
+/*! @brief The maximum packet size of the bulk endpoints at the loopback bus speed */
+#if (USB_SPEED_HIGH == USB_HOST_LOOPBACK_BUS_SPEED)
+#define USB_BENCHMARK_BULK_MAX_PACKET_SIZE (512U)
+#else
+#define USB_BENCHMARK_BULK_MAX_PACKET_SIZE (64U)
+#endif
+
+/*! @brief The maximum interface count of the benchmark devices */
+#define USB_BENCHMARK_INTERFACE_COUNT (4U)
+
+/*! @brief The element count of an array */
+#define USB_BENCHMARK_ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+/*! @brief Reads the cycle counter */
+#define USB_BENCHMARK_CYCLES() ((uint32_t)USB_DEVICE_LOOPBACK_CYCLE_COUNTER())
+
+/*! @brief The result of one measurement */
+typedef struct _usb_benchmark_result
+{
+    uint64_t busTime;   /*!< The bus time of the measurement in picoseconds */
+    uint64_t cycles;    /*!< The CPU cycles spent in the device and host stacks and the class drivers */
+    uint32_t bytes;     /*!< The class payload bytes */
+    uint32_t transfers; /*!< The class transfers: commands, writes, packets, reports, frames or ISO packets */
+} usb_benchmark_result_t;
+
+/*! @brief The benchmark instance */
+typedef struct _usb_benchmark_struct
+{
+    usb_host_handle hostHandle;                        /*!< The loopback host */
+    usb_device_handle deviceHandle;                    /*!< The device stack handle of the running class */
+    usb_device_handle attachedDeviceHandle;            /*!< The host side handle of the last attached device */
+    usb_host_configuration_handle configurationHandle; /*!< The configuration selected by the host */
+    usb_device_loopback_statistic_struct_t deviceStatistic; /*!< The device loopback statistics at the start */
+    usb_host_loopback_statistic_t hostStatistic;            /*!< The host loopback statistics at the start */
+    uint64_t callCycles;         /*!< The cycles of the class calls made outside the transfer callbacks */
+    volatile uint8_t enumerated; /*!< The device is enumerated */
+    volatile uint8_t requestDone; /*!< The host class request is done, see USB_BenchmarkRequestCallback */
+    usb_status_t requestStatus;   /*!< The status of the host class request */
+    uint8_t configuration;       /*!< The configuration of the device */
+    uint8_t alternateSetting[USB_BENCHMARK_INTERFACE_COUNT]; /*!< The alternate settings of the device interfaces */
+} usb_benchmark_struct_t;
+
+/*! @brief The runner of one class */
+typedef usb_status_t (*usb_benchmark_runner_t)(usb_benchmark_struct_t *benchmark);
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @brief Runs all the benchmarks.
+ *
+ * The runners of the classes enabled in both usb_device_config.h and usb_host_config.h run one after the other, the
+ * results are printed with usb_echo.
+ *
+ * @retval kStatus_USB_Success        All the runners completed.
+ * @retval kStatus_USB_Error          The host could not be initialized, or a runner failed.
+ */
+usb_status_t USB_BenchmarkRun(void);
+
+/*!
+ * @brief Starts the device and waits for the host to enumerate it.
+ *
+ * @param benchmark       The benchmark instance.
+ * @param configList      The class configuration list of the device.
+ * @param descriptorTable The descriptors of the device.
+ *
+ * @retval kStatus_USB_Success        The device is enumerated.
+ * @retval kStatus_USB_Error          The device stack failed to start or the enumeration timed out.
+ */
+usb_status_t USB_BenchmarkDeviceStart(usb_benchmark_struct_t *benchmark,
+                                      usb_device_class_config_list_struct_t *configList,
+                                      const usb_device_descriptor_table_struct_t *descriptorTable);
+
+/*!
+ * @brief Handles the standard device events of the benchmark devices.
+ *
+ * It is the device callback of the class configuration list, or it is called by the device callback of a runner for
+ * the events the runner does not handle. The configuration and the alternate settings are kept.
+ *
+ * @param handle The device handle.
+ * @param event  The device event, usb_device_event_t.
+ * @param param  The event parameter.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_BenchmarkDeviceCallback(usb_device_handle handle, uint32_t event, void *param);
+
+/*!
+ * @brief Stops the device and waits for the host to detach it.
+ *
+ * The host class driver is de-initialized after it, as an application does on the detach event, the host releases
+ * the device when its interfaces are closed. A runner that did not initialize its host class driver closes the
+ * interfaces by USB_HostCloseDeviceInterface.
+ *
+ * @param benchmark The benchmark instance.
+ *
+ * @retval kStatus_USB_Success        The device is detached.
+ * @retval kStatus_USB_Error          The device stack failed to stop or the detach timed out.
+ */
+usb_status_t USB_BenchmarkDeviceStop(usb_benchmark_struct_t *benchmark);
+
+/*!
+ * @brief Gets the first interface of a class in the configuration selected by the host.
+ *
+ * @param benchmark     The benchmark instance.
+ * @param classCode     The interface class code.
+ * @param subclassCode  The interface subclass code.
+ *
+ * @return The interface handle, NULL if the configuration has no such interface.
+ */
+usb_host_interface_handle USB_BenchmarkGetInterface(usb_benchmark_struct_t *benchmark,
+                                                    uint8_t classCode,
+                                                    uint8_t subclassCode);
+
+/*!
+ * @brief Host class request callback.
+ *
+ * It is the callback of the host class requests that the runners issue before the measurements, the callback
+ * parameter is the benchmark instance.
+ *
+ * @param param      The benchmark instance.
+ * @param data       The data buffer.
+ * @param dataLength The data length.
+ * @param status     The request status.
+ */
+void USB_BenchmarkRequestCallback(void *param, uint8_t *data, uint32_t dataLength, usb_status_t status);
+
+/*!
+ * @brief Waits for a host class request.
+ *
+ * The bus runs until USB_BenchmarkRequestCallback is called, the request may complete in the class call already.
+ *
+ * @param benchmark The benchmark instance.
+ * @param status    The return value of the class call that issued the request.
+ *
+ * @retval kStatus_USB_Success        The request completed successfully.
+ * @retval kStatus_USB_Error          The request could not be issued, it failed or it timed out.
+ */
+usb_status_t USB_BenchmarkRequestWait(usb_benchmark_struct_t *benchmark, usb_status_t status);
+
+/*!
+ * @brief Runs the bus until a flag is set.
+ *
+ * @param benchmark The benchmark instance.
+ * @param flag      The flag set by a callback.
+ * @param frames    The maximum (micro)frames to run.
+ *
+ * @retval kStatus_USB_Success        The flag is set.
+ * @retval kStatus_USB_Error          The flag is not set after the frames.
+ */
+usb_status_t USB_BenchmarkWait(usb_benchmark_struct_t *benchmark, volatile uint8_t *flag, uint32_t frames);
+
+/*!
+ * @brief Runs the bus for a number of (micro)frames.
+ *
+ * @param benchmark The benchmark instance.
+ * @param frames    The (micro)frames to run.
+ */
+void USB_BenchmarkRunFrames(usb_benchmark_struct_t *benchmark, uint32_t frames);
+
+/*!
+ * @brief Gets the bus time.
+ *
+ * @param benchmark The benchmark instance.
+ *
+ * @return The bus time in picoseconds.
+ */
+uint64_t USB_BenchmarkGetBusTime(usb_benchmark_struct_t *benchmark);
+
+/*!
+ * @brief Starts a measurement.
+ *
+ * @param benchmark The benchmark instance.
+ */
+void USB_BenchmarkStart(usb_benchmark_struct_t *benchmark);
+
+/*!
+ * @brief Ends a measurement.
+ *
+ * The bus time and the cycles since USB_BenchmarkStart are returned, the bytes and the transfers are left to the
+ * runner.
+ *
+ * @param benchmark The benchmark instance.
+ * @param result    Returns the measurement.
+ */
+void USB_BenchmarkStop(usb_benchmark_struct_t *benchmark, usb_benchmark_result_t *result);
+
+/*!
+ * @brief Prints a measurement.
+ *
+ * The line has the transfers, the bytes, the MB/s on the bus, the cycles per byte and the cycles per transfer.
+ *
+ * @param name   The measurement name.
+ * @param result The measurement.
+ */
+void USB_BenchmarkPrint(const char *name, const usb_benchmark_result_t *result);
+
+/*!
+ * @brief Gets the rate of an event count on the bus.
+ *
+ * @param count   The event count.
+ * @param busTime The bus time in picoseconds.
+ *
+ * @return The events per second.
+ */
+uint32_t USB_BenchmarkRate(uint32_t count, uint64_t busTime);
+
+#if ((defined(USB_DEVICE_CONFIG_MSC)) && (USB_DEVICE_CONFIG_MSC > 0U) && (defined(USB_HOST_CONFIG_MSD)) && \
+     (USB_HOST_CONFIG_MSD > 0U))
+/*!
+ * @brief MSC benchmark, READ(10) and WRITE(10) MB/s at several block counts per command.
+ *
+ * @param benchmark The benchmark instance.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_BenchmarkMsc(usb_benchmark_struct_t *benchmark);
+#endif
+
+#if ((defined(USB_DEVICE_CONFIG_CDC_ACM)) && (USB_DEVICE_CONFIG_CDC_ACM > 0U) && (defined(USB_HOST_CONFIG_CDC)) && \
+     (USB_HOST_CONFIG_CDC > 0U))
+/*!
+ * @brief CDC ACM benchmark, the small write rate.
+ *
+ * @param benchmark The benchmark instance.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_BenchmarkCdcAcm(usb_benchmark_struct_t *benchmark);
+#endif
+
+#if ((defined(USB_DEVICE_CONFIG_CDC_RNDIS)) && (USB_DEVICE_CONFIG_CDC_RNDIS > 0U) && \
+     (defined(USB_HOST_CONFIG_CDC_RNDIS)) && (USB_HOST_CONFIG_CDC_RNDIS > 0U))
+/*!
+ * @brief RNDIS benchmark, the packet rate.
+ *
+ * @param benchmark The benchmark instance.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_BenchmarkCdcRndis(usb_benchmark_struct_t *benchmark);
+
+/*!
+ * @brief Starts the device of the RNDIS benchmark and waits for the enumeration.
+ *
+ * The device RNDIS function is in its own file, the device and the host RNDIS headers define the same message
+ * structures and can not be included together.
+ *
+ * @param benchmark The benchmark instance.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_BenchmarkCdcRndisDeviceStart(usb_benchmark_struct_t *benchmark);
+
+/*!
+ * @brief Stops the device of the RNDIS benchmark and waits for the detach.
+ *
+ * @param benchmark The benchmark instance.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_BenchmarkCdcRndisDeviceStop(usb_benchmark_struct_t *benchmark);
+
+/*!
+ * @brief Gets and clears the packets received by the device.
+ *
+ * @param packets Returns the RNDIS packet messages received.
+ * @param bytes   Returns the Ethernet frame bytes of the packet messages.
+ *
+ * @retval kStatus_USB_Success        All the received messages are packet messages.
+ * @retval kStatus_USB_Error          A malformed message was received.
+ */
+usb_status_t USB_BenchmarkCdcRndisDeviceGetCount(uint32_t *packets, uint32_t *bytes);
+#endif
+
+#if ((defined(USB_DEVICE_CONFIG_HID)) && (USB_DEVICE_CONFIG_HID > 0U) && (defined(USB_HOST_CONFIG_HID)) && \
+     (USB_HOST_CONFIG_HID > 0U))
+/*!
+ * @brief HID benchmark, the report latency.
+ *
+ * @param benchmark The benchmark instance.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_BenchmarkHid(usb_benchmark_struct_t *benchmark);
+#endif
+
+#if ((defined(USB_DEVICE_CONFIG_VIDEO)) && (USB_DEVICE_CONFIG_VIDEO > 0U) && (defined(USB_HOST_CONFIG_VIDEO)) && \
+     (USB_HOST_CONFIG_VIDEO > 0U))
+/*!
+ * @brief UVC benchmark, the frame throughput.
+ *
+ * @param benchmark The benchmark instance.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_BenchmarkVideo(usb_benchmark_struct_t *benchmark);
+#endif
+
+#if ((defined(USB_DEVICE_CONFIG_AUDIO)) && (USB_DEVICE_CONFIG_AUDIO > 0U) && (defined(USB_HOST_CONFIG_AUDIO)) && \
+     (USB_HOST_CONFIG_AUDIO > 0U) && (defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) &&                          \
+     (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+/*! @brief The UAC stream, 44.1 kHz 16-bit stereo, the packets alternate between 44 and 45 audio frames */
+#define USB_BENCHMARK_AUDIO_SAMPLE_RATE (44100U)
+#define USB_BENCHMARK_AUDIO_CHANNELS (2U)
+#define USB_BENCHMARK_AUDIO_SUBFRAME_SIZE (2U)
+#define USB_BENCHMARK_AUDIO_FRAME_SIZE (USB_BENCHMARK_AUDIO_CHANNELS * USB_BENCHMARK_AUDIO_SUBFRAME_SIZE)
+/*! @brief The maximum packet size of the UAC ISO OUT endpoint, 48 audio frames */
+#define USB_BENCHMARK_AUDIO_MAX_PACKET_SIZE (48U * USB_BENCHMARK_AUDIO_FRAME_SIZE)
+
+/*! @brief The arrival of the UAC ISO OUT packets at the device */
+typedef struct _usb_benchmark_audio_arrival
+{
+    uint32_t packets;   /*!< The packets received */
+    uint32_t bytes;     /*!< The bytes received */
+    uint32_t jitter;    /*!< The average deviation of the packet period in nanoseconds */
+    uint32_t maxJitter; /*!< The largest deviation of the packet period in nanoseconds */
+    uint32_t minLength; /*!< The shortest packet */
+    uint32_t maxLength; /*!< The longest packet */
+} usb_benchmark_audio_arrival_t;
+
+/*!
+ * @brief UAC benchmark, the ISO OUT stream jitter.
+ *
+ * @param benchmark The benchmark instance.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_BenchmarkAudio(usb_benchmark_struct_t *benchmark);
+
+/*!
+ * @brief Starts the device of the UAC benchmark and waits for the enumeration.
+ *
+ * The device audio function is in its own file, the device and the host audio headers define the same format type
+ * macros and can not be included together.
+ *
+ * @param benchmark The benchmark instance.
+ * @param packets   The ISO OUT packets to record.
+ * @param done      Set when the packets are recorded.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_BenchmarkAudioDeviceStart(usb_benchmark_struct_t *benchmark, uint32_t packets, volatile uint8_t *done);
+
+/*!
+ * @brief Stops the device of the UAC benchmark and waits for the detach.
+ *
+ * @param benchmark The benchmark instance.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_BenchmarkAudioDeviceStop(usb_benchmark_struct_t *benchmark);
+
+/*!
+ * @brief Gets the arrival of the ISO OUT packets recorded by the device.
+ *
+ * @param arrival Returns the packet arrival.
+ */
+void USB_BenchmarkAudioDeviceGetArrival(usb_benchmark_audio_arrival_t *arrival);
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @} */
+
+#endif /* __USB_BENCHMARK_H__ */
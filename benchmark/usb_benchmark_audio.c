@@ -0,0 +1,215 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_benchmark.h"
+
+#if ((defined(USB_DEVICE_CONFIG_AUDIO)) && (USB_DEVICE_CONFIG_AUDIO > 0U) && (defined(USB_HOST_CONFIG_AUDIO)) && \
+     (USB_HOST_CONFIG_AUDIO > 0U) && (defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) &&                          \
+     (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+#include "usb_host_audio.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The ISO OUT packets of the measurement, one each millisecond */
+#ifndef USB_BENCHMARK_AUDIO_PACKETS
+#define USB_BENCHMARK_AUDIO_PACKETS (1000U)
+#endif
+
+/*! @brief The streaming engine transfers and the service intervals of each transfer */
+#define USB_BENCHMARK_AUDIO_TRANSFERS (4U)
+#define USB_BENCHMARK_AUDIO_TRANSFER_PACKETS (2U)
+/*! @brief The PCM ring of the streaming engine */
+#define USB_BENCHMARK_AUDIO_RING_SIZE (16U * USB_BENCHMARK_AUDIO_MAX_PACKET_SIZE)
+
+/*! @brief The host side of the UAC benchmark */
+typedef struct _usb_benchmark_audio_struct
+{
+    usb_host_class_handle classHandle; /*!< The host audio instance */
+    volatile uint8_t done;             /*!< The device received the packets of the measurement */
+    volatile uint8_t stopped;          /*!< The stream of the host is stopped */
+} usb_benchmark_audio_struct_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The ISO transfer buffers of the streaming engine */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t s_BenchmarkAudioTransferBuffer[USB_BENCHMARK_AUDIO_TRANSFERS * USB_BENCHMARK_AUDIO_TRANSFER_PACKETS *
+                                              USB_BENCHMARK_AUDIO_MAX_PACKET_SIZE];
+/* The PCM ring of the streaming engine, and the PCM data written into it */
+static uint8_t s_BenchmarkAudioRing[USB_BENCHMARK_AUDIO_RING_SIZE];
+static uint8_t s_BenchmarkAudioPcm[USB_BENCHMARK_AUDIO_RING_SIZE];
+
+static usb_benchmark_audio_struct_t s_BenchmarkAudio;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Host streaming engine callback, the PCM ring is filled up at each transfer.
+ *
+ * @param param The host side of the UAC benchmark.
+ * @param event The streaming engine event.
+ * @param level The PCM ring fill level.
+ */
+static void USB_BenchmarkAudioStreamCallback(void *param, uint32_t event, uint32_t level)
+{
+    usb_benchmark_audio_struct_t *audio = (usb_benchmark_audio_struct_t *)param;
+
+    switch (event)
+    {
+        case kUSB_HostAudioStreamEventTransferDone:
+            (void)USB_HostAudioStreamWrite(audio->classHandle, s_BenchmarkAudioPcm,
+                                           USB_BENCHMARK_AUDIO_RING_SIZE - level);
+            break;
+
+        case kUSB_HostAudioStreamEventStopped:
+            audio->stopped = 1U;
+            break;
+
+        default:
+            /*no action*/
+            break;
+    }
+}
+
+/*!
+ * @brief Runs the audio measurement.
+ *
+ * The streaming engine of the host sends the PCM ring at the nominal rate, the device records the packet arrivals.
+ *
+ * @param benchmark The benchmark instance.
+ * @param audio     The host side of the UAC benchmark.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkAudioMeasure(usb_benchmark_struct_t *benchmark, usb_benchmark_audio_struct_t *audio)
+{
+    usb_host_audio_stream_config_t config;
+    usb_host_audio_stream_statistic_t statistic;
+    usb_benchmark_audio_arrival_t arrival;
+    usb_benchmark_result_t result;
+    usb_status_t status;
+    uint32_t startCycles;
+
+    (void)memset(&config, 0, sizeof(config));
+    config.ringBuffer         = s_BenchmarkAudioRing;
+    config.ringSize           = sizeof(s_BenchmarkAudioRing);
+    config.transferBuffer     = s_BenchmarkAudioTransferBuffer;
+    config.transferBufferSize = sizeof(s_BenchmarkAudioTransferBuffer);
+    config.sampleRate         = USB_BENCHMARK_AUDIO_SAMPLE_RATE;
+    config.callbackFn         = USB_BenchmarkAudioStreamCallback;
+    config.callbackParam      = audio;
+    config.frameSize          = USB_BENCHMARK_AUDIO_FRAME_SIZE;
+    config.transferCount      = USB_BENCHMARK_AUDIO_TRANSFERS;
+    config.packetCount        = USB_BENCHMARK_AUDIO_TRANSFER_PACKETS;
+    config.rateSource         = (uint8_t)kUSB_HostAudioStreamRateNominal;
+
+    USB_BenchmarkStart(benchmark);
+    /* The stream and the first PCM data are started here, the ring is filled up by the engine callback */
+    startCycles = USB_BENCHMARK_CYCLES();
+    status      = USB_HostAudioStreamStart(audio->classHandle, USB_OUT, &config);
+    if (kStatus_USB_Success == status)
+    {
+        (void)USB_HostAudioStreamWrite(audio->classHandle, s_BenchmarkAudioPcm, sizeof(s_BenchmarkAudioPcm));
+    }
+    benchmark->callCycles += (uint32_t)(USB_BENCHMARK_CYCLES() - startCycles);
+    if ((kStatus_USB_Success != status) ||
+        (kStatus_USB_Success !=
+         USB_BenchmarkWait(benchmark, &audio->done, (USB_BENCHMARK_AUDIO_PACKETS + 1U) * USB_BENCHMARK_TIMEOUT_FRAMES)))
+    {
+        usb_echo("UAC stream error\r\n");
+        return kStatus_USB_Error;
+    }
+    USB_BenchmarkStop(benchmark, &result);
+    if ((kStatus_USB_Success != USB_HostAudioStreamGetStatistic(audio->classHandle, USB_OUT, &statistic)) ||
+        (kStatus_USB_Success != USB_HostAudioStreamStop(audio->classHandle, USB_OUT)) ||
+        (kStatus_USB_Success != USB_BenchmarkWait(benchmark, &audio->stopped, USB_BENCHMARK_TIMEOUT_FRAMES)))
+    {
+        usb_echo("UAC stream stop error\r\n");
+        return kStatus_USB_Error;
+    }
+    USB_BenchmarkAudioDeviceGetArrival(&arrival);
+    result.transfers = arrival.packets;
+    result.bytes     = arrival.bytes;
+    USB_BenchmarkPrint("UAC OUT 44.1kHz stereo", &result);
+    usb_echo("%-24s %8u packets/s jitter %5u.%03u us average %5u.%03u us max\r\n", "UAC OUT 44.1kHz stereo",
+             USB_BenchmarkRate(result.transfers, result.busTime), arrival.jitter / 1000U, arrival.jitter % 1000U,
+             arrival.maxJitter / 1000U, arrival.maxJitter % 1000U);
+    usb_echo("%-24s %8u-%u frames/packet %u underruns %u missed packets\r\n", "UAC OUT 44.1kHz stereo",
+             arrival.minLength / USB_BENCHMARK_AUDIO_FRAME_SIZE, arrival.maxLength / USB_BENCHMARK_AUDIO_FRAME_SIZE,
+             statistic.underrunCount, statistic.missedPackets);
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_BenchmarkAudio(usb_benchmark_struct_t *benchmark)
+{
+    usb_benchmark_audio_struct_t *audio = &s_BenchmarkAudio;
+    usb_host_interface_handle controlInterface;
+    usb_host_interface_handle streamInterface;
+    usb_status_t status = kStatus_USB_Error;
+    uint32_t index;
+
+    audio->classHandle = NULL;
+    audio->done        = 0U;
+    audio->stopped     = 0U;
+    if (kStatus_USB_Success != USB_BenchmarkAudioDeviceStart(benchmark, USB_BENCHMARK_AUDIO_PACKETS, &audio->done))
+    {
+        usb_echo("UAC enumeration error\r\n");
+        return kStatus_USB_Error;
+    }
+
+    controlInterface = USB_BenchmarkGetInterface(benchmark, USB_AUDIO_CLASS_CODE, USB_AUDIO_SUBCLASS_CODE_CONTROL);
+    streamInterface =
+        USB_BenchmarkGetInterface(benchmark, USB_AUDIO_CLASS_CODE, USB_AUDIO_SUBCLASS_CODE_AUDIOSTREAMING);
+    if ((NULL != controlInterface) && (NULL != streamInterface) &&
+        (kStatus_USB_Success == USB_HostAudioInit(benchmark->attachedDeviceHandle, &audio->classHandle)) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark,
+                                  USB_HostAudioControlSetInterface(audio->classHandle, controlInterface, 0U,
+                                                                   USB_BenchmarkRequestCallback, benchmark))) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark,
+                                  USB_HostAudioStreamSetInterface(audio->classHandle, streamInterface, 1U,
+                                                                  USB_BenchmarkRequestCallback, benchmark))))
+    {
+        for (index = 0U; index < sizeof(s_BenchmarkAudioPcm); index++)
+        {
+            s_BenchmarkAudioPcm[index] = (uint8_t)index;
+        }
+        status = USB_BenchmarkAudioMeasure(benchmark, audio);
+    }
+    else
+    {
+        usb_echo("UAC host class error\r\n");
+    }
+
+    if (kStatus_USB_Success != USB_BenchmarkAudioDeviceStop(benchmark))
+    {
+        status = kStatus_USB_Error;
+    }
+    if (NULL != audio->classHandle)
+    {
+        (void)USB_HostAudioDeinit(benchmark->attachedDeviceHandle, audio->classHandle);
+        audio->classHandle = NULL;
+    }
+    else
+    {
+        (void)USB_HostCloseDeviceInterface(benchmark->attachedDeviceHandle, NULL);
+    }
+    return status;
+}
+
+#endif /* USB_DEVICE_CONFIG_AUDIO && USB_HOST_CONFIG_AUDIO && USB_HOST_CONFIG_AUDIO_STREAM_ENGINE */
@@ -0,0 +1,292 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_benchmark.h"
+
+#if ((defined(USB_DEVICE_CONFIG_AUDIO)) && (USB_DEVICE_CONFIG_AUDIO > 0U) && (defined(USB_HOST_CONFIG_AUDIO)) && \
+     (USB_HOST_CONFIG_AUDIO > 0U) && (defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) &&                          \
+     (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+#include "usb_device_audio.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The service interval of the ISO OUT endpoint, one millisecond */
+#if (USB_SPEED_HIGH == USB_HOST_LOOPBACK_BUS_SPEED)
+#define USB_BENCHMARK_AUDIO_INTERVAL (4U)
+#else
+#define USB_BENCHMARK_AUDIO_INTERVAL (1U)
+#endif
+/*! @brief The service interval in picoseconds */
+#define USB_BENCHMARK_AUDIO_PERIOD (1000000000U)
+
+#define USB_BENCHMARK_AUDIO_CONTROL_INTERFACE (0U)
+#define USB_BENCHMARK_AUDIO_STREAM_INTERFACE (1U)
+#define USB_BENCHMARK_AUDIO_ISO_OUT_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(2U, USB_OUT)
+#define USB_BENCHMARK_AUDIO_INPUT_TERMINAL_ID (1U)
+#define USB_BENCHMARK_AUDIO_OUTPUT_TERMINAL_ID (2U)
+
+/*! @brief The USB streaming input terminal and the speaker output terminal of the audio control interface */
+#define USB_BENCHMARK_AUDIO_CONTROL_UNITS                                                                          \
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_AUDIO_CS_INTERFACE,                                          \
+                                  USB_DESCRIPTOR_SUBTYPE_AUDIO_CONTROL_INPUT_TERMINAL,                             \
+                                  USB_BENCHMARK_AUDIO_INPUT_TERMINAL_ID, USB_DESCRIPTOR_WORD(0x0101U), 0x00U,      \
+                                  USB_BENCHMARK_AUDIO_CHANNELS, USB_DESCRIPTOR_WORD(0x0003U), 0U, 0U),             \
+        USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_AUDIO_CS_INTERFACE,                                      \
+                                      USB_DESCRIPTOR_SUBTYPE_AUDIO_CONTROL_OUTPUT_TERMINAL,                        \
+                                      USB_BENCHMARK_AUDIO_OUTPUT_TERMINAL_ID, USB_DESCRIPTOR_WORD(0x0301U), 0x00U, \
+                                      USB_BENCHMARK_AUDIO_INPUT_TERMINAL_ID, 0U)
+
+/*! @brief The device side of the UAC benchmark, the arrival of the ISO OUT packets */
+typedef struct _usb_benchmark_audio_device_struct
+{
+    usb_benchmark_struct_t *benchmark; /*!< The benchmark instance */
+    volatile uint8_t *done;            /*!< Set when the packets are recorded */
+    uint64_t arrivalTime;              /*!< The bus time of the last packet */
+    uint64_t jitter;                   /*!< The sum of the deviations of the packet period */
+    uint64_t maxJitter;                /*!< The largest deviation of the packet period */
+    uint32_t count;                    /*!< The packets to record */
+    uint32_t packets;                  /*!< The packets received */
+    uint32_t bytes;                    /*!< The bytes received */
+    uint32_t minLength;                /*!< The shortest packet */
+    uint32_t maxLength;                /*!< The longest packet */
+} usb_benchmark_audio_device_struct_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static usb_status_t USB_BenchmarkAudioClassCallback(class_handle_t handle, uint32_t event, void *param);
+static usb_status_t USB_BenchmarkAudioDeviceCallback(usb_device_handle handle, uint32_t event, void *param);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The receive buffer of the device */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t s_BenchmarkAudioRecvBuffer[USB_BENCHMARK_AUDIO_MAX_PACKET_SIZE];
+
+static usb_benchmark_audio_device_struct_t s_BenchmarkAudioDevice;
+
+static usb_device_endpoint_struct_t s_BenchmarkAudioStreamEndpoints[] = {
+    {USB_BENCHMARK_AUDIO_ISO_OUT_ENDPOINT, USB_ENDPOINT_ISOCHRONOUS, USB_BENCHMARK_AUDIO_MAX_PACKET_SIZE,
+     USB_BENCHMARK_AUDIO_INTERVAL},
+};
+
+static usb_device_interface_struct_t s_BenchmarkAudioControlInterface[] = {
+    {0U, {0U, NULL}, NULL},
+};
+
+/* The stream interface has no endpoint in the alternate setting 0, the ISO OUT endpoint is in the setting 1 */
+static usb_device_interface_struct_t s_BenchmarkAudioStreamInterface[] = {
+    {0U, {0U, NULL}, NULL},
+    {1U, {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkAudioStreamEndpoints), s_BenchmarkAudioStreamEndpoints}, NULL},
+};
+
+static usb_device_interfaces_struct_t s_BenchmarkAudioInterfaces[] = {
+    {USB_DEVICE_CONFIG_AUDIO_CLASS_CODE, USB_DEVICE_AUDIO_CONTROL_SUBCLASS, 0x00U,
+     USB_BENCHMARK_AUDIO_CONTROL_INTERFACE, s_BenchmarkAudioControlInterface,
+     USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkAudioControlInterface)},
+    {USB_DEVICE_CONFIG_AUDIO_CLASS_CODE, USB_DEVICE_AUDIO_STREAM_SUBCLASS, 0x00U, USB_BENCHMARK_AUDIO_STREAM_INTERFACE,
+     s_BenchmarkAudioStreamInterface, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkAudioStreamInterface)},
+};
+
+static usb_device_interface_list_t s_BenchmarkAudioInterfaceList[] = {
+    {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkAudioInterfaces), s_BenchmarkAudioInterfaces},
+};
+
+static usb_device_class_struct_t s_BenchmarkAudioClass = {s_BenchmarkAudioInterfaceList, kUSB_DeviceClassTypeAudio,
+                                                          1U};
+
+static usb_device_class_config_struct_t s_BenchmarkAudioConfig[] = {
+    {USB_BenchmarkAudioClassCallback, (class_handle_t)NULL, &s_BenchmarkAudioClass},
+};
+
+static usb_device_class_config_list_struct_t s_BenchmarkAudioConfigList = {
+    s_BenchmarkAudioConfig, USB_BenchmarkAudioDeviceCallback, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkAudioConfig)};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkAudioDeviceDescriptor[] = {USB_DESCRIPTOR_DEVICE(
+    0x0200U, 0x00U, 0x00U, 0x00U, USB_CONTROL_MAX_PACKET_SIZE, 0x1FC9U, 0x0105U, 0x0101U, 0U, 0U, 0U, 1U)};
+
+/* A USB Audio 1.0 speaker, the ISO OUT endpoint descriptor has the bRefresh and bSynchAddress fields of the UAC 1.0 */
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkAudioConfigurationDescriptor[] = {USB_DESCRIPTOR_CONFIGURATION(
+    2U, 1U, 0U, 0xC0U, 50U,
+    USB_DESCRIPTOR_INTERFACE(USB_BENCHMARK_AUDIO_CONTROL_INTERFACE, 0U, 0U, USB_DEVICE_CONFIG_AUDIO_CLASS_CODE,
+                             USB_DEVICE_AUDIO_CONTROL_SUBCLASS, 0x00U, 0U),
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_AUDIO_CS_INTERFACE, USB_DESCRIPTOR_SUBTYPE_AUDIO_CONTROL_HEADER,
+                                  USB_DESCRIPTOR_WORD(0x0100U),
+                                  USB_DESCRIPTOR_WORD(9U + USB_DESCRIPTOR_LENGTH_OF(USB_BENCHMARK_AUDIO_CONTROL_UNITS)),
+                                  1U, USB_BENCHMARK_AUDIO_STREAM_INTERFACE),
+    USB_BENCHMARK_AUDIO_CONTROL_UNITS,
+    USB_DESCRIPTOR_INTERFACE(USB_BENCHMARK_AUDIO_STREAM_INTERFACE, 0U, 0U, USB_DEVICE_CONFIG_AUDIO_CLASS_CODE,
+                             USB_DEVICE_AUDIO_STREAM_SUBCLASS, 0x00U, 0U),
+    USB_DESCRIPTOR_INTERFACE(USB_BENCHMARK_AUDIO_STREAM_INTERFACE, 1U, 1U, USB_DEVICE_CONFIG_AUDIO_CLASS_CODE,
+                             USB_DEVICE_AUDIO_STREAM_SUBCLASS, 0x00U, 0U),
+    /* The general descriptor, PCM, and the type I format descriptor with one sample rate */
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_AUDIO_CS_INTERFACE, 0x01U, USB_BENCHMARK_AUDIO_INPUT_TERMINAL_ID,
+                                  1U, USB_DESCRIPTOR_WORD(0x0001U)),
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_AUDIO_CS_INTERFACE, 0x02U, 0x01U, USB_BENCHMARK_AUDIO_CHANNELS,
+                                  USB_BENCHMARK_AUDIO_SUBFRAME_SIZE, USB_BENCHMARK_AUDIO_SUBFRAME_SIZE * 8U, 1U,
+                                  (uint8_t)(USB_BENCHMARK_AUDIO_SAMPLE_RATE & 0xFFU),
+                                  (uint8_t)((USB_BENCHMARK_AUDIO_SAMPLE_RATE >> 8U) & 0xFFU),
+                                  (uint8_t)((USB_BENCHMARK_AUDIO_SAMPLE_RATE >> 16U) & 0xFFU)),
+    /* The ISO OUT endpoint, adaptive */
+    USB_DESCRIPTOR_LENGTH_ENDPOINT + 2U, USB_DESCRIPTOR_TYPE_ENDPOINT, USB_BENCHMARK_AUDIO_ISO_OUT_ENDPOINT,
+    USB_ENDPOINT_ISOCHRONOUS | 0x08U, USB_DESCRIPTOR_WORD(USB_BENCHMARK_AUDIO_MAX_PACKET_SIZE),
+    USB_BENCHMARK_AUDIO_INTERVAL, 0U, 0U,
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_AUDIO_CS_ENDPOINT, 0x01U, 0x00U, 0U,
+                                  USB_DESCRIPTOR_WORD(0U)))};
+
+static const usb_device_descriptor_entry_struct_t s_BenchmarkAudioDescriptorEntries[] = {
+    {s_BenchmarkAudioDeviceDescriptor, sizeof(s_BenchmarkAudioDeviceDescriptor), 0U, USB_DESCRIPTOR_TYPE_DEVICE, 0U,
+     USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+    {s_BenchmarkAudioConfigurationDescriptor, sizeof(s_BenchmarkAudioConfigurationDescriptor), 0U,
+     USB_DESCRIPTOR_TYPE_CONFIGURE, 0U, USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+};
+
+static const usb_device_descriptor_table_struct_t s_BenchmarkAudioDescriptorTable = {
+    s_BenchmarkAudioDescriptorEntries, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkAudioDescriptorEntries)};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Records the arrival of one ISO OUT packet.
+ *
+ * The jitter is the deviation of the time between two packets from the service interval.
+ *
+ * @param device The device side of the UAC benchmark.
+ * @param length The packet length.
+ */
+static void USB_BenchmarkAudioArrival(usb_benchmark_audio_device_struct_t *device, uint32_t length)
+{
+    uint64_t now;
+    uint64_t jitter;
+
+    if (device->count == device->packets)
+    {
+        return;
+    }
+    now = USB_BenchmarkGetBusTime(device->benchmark);
+    if (0U != device->packets)
+    {
+        jitter = now - device->arrivalTime;
+        jitter = (jitter > USB_BENCHMARK_AUDIO_PERIOD) ? (jitter - USB_BENCHMARK_AUDIO_PERIOD) :
+                                                         (USB_BENCHMARK_AUDIO_PERIOD - jitter);
+        device->jitter += jitter;
+        if (jitter > device->maxJitter)
+        {
+            device->maxJitter = jitter;
+        }
+    }
+    device->arrivalTime = now;
+    if ((0U == device->packets) || (length < device->minLength))
+    {
+        device->minLength = length;
+    }
+    if (length > device->maxLength)
+    {
+        device->maxLength = length;
+    }
+    device->packets++;
+    device->bytes += length;
+    if (device->count == device->packets)
+    {
+        *device->done = 1U;
+    }
+}
+
+/*!
+ * @brief Device audio class callback, the ISO OUT endpoint is primed again when a packet is received.
+ *
+ * @param handle The audio class handle.
+ * @param event  The audio event.
+ * @param param  The event parameter.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkAudioClassCallback(class_handle_t handle, uint32_t event, void *param)
+{
+    usb_device_endpoint_callback_message_struct_t *message;
+    usb_status_t error = kStatus_USB_Success;
+
+    switch (event)
+    {
+        case kUSB_DeviceAudioEventStreamRecvResponse:
+            message = (usb_device_endpoint_callback_message_struct_t *)param;
+            if (USB_CANCELLED_TRANSFER_LENGTH != message->length)
+            {
+                USB_BenchmarkAudioArrival(&s_BenchmarkAudioDevice, message->length);
+                error = USB_DeviceAudioRecv(handle, USB_BENCHMARK_AUDIO_ISO_OUT_ENDPOINT & USB_ENDPOINT_NUMBER_MASK,
+                                            s_BenchmarkAudioRecvBuffer, sizeof(s_BenchmarkAudioRecvBuffer));
+            }
+            break;
+
+        default:
+            error = kStatus_USB_InvalidRequest;
+            break;
+    }
+    return error;
+}
+
+/*!
+ * @brief Device callback, the ISO OUT endpoint is primed when the stream interface is in the alternate setting 1.
+ *
+ * @param handle The device handle.
+ * @param event  The device event.
+ * @param param  The event parameter.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkAudioDeviceCallback(usb_device_handle handle, uint32_t event, void *param)
+{
+    usb_status_t error = USB_BenchmarkDeviceCallback(handle, event, param);
+
+    if ((kStatus_USB_Success == error) && ((uint32_t)kUSB_DeviceEventSetInterface == event) &&
+        ((((uint16_t)USB_BENCHMARK_AUDIO_STREAM_INTERFACE << 8U) | 1U) == *((uint16_t *)param)))
+    {
+        error = USB_DeviceAudioRecv(s_BenchmarkAudioConfig[0].classHandle,
+                                    USB_BENCHMARK_AUDIO_ISO_OUT_ENDPOINT & USB_ENDPOINT_NUMBER_MASK,
+                                    s_BenchmarkAudioRecvBuffer, sizeof(s_BenchmarkAudioRecvBuffer));
+    }
+    return error;
+}
+
+usb_status_t USB_BenchmarkAudioDeviceStart(usb_benchmark_struct_t *benchmark, uint32_t packets, volatile uint8_t *done)
+{
+    (void)memset(&s_BenchmarkAudioDevice, 0, sizeof(s_BenchmarkAudioDevice));
+    s_BenchmarkAudioDevice.benchmark = benchmark;
+    s_BenchmarkAudioDevice.done      = done;
+    s_BenchmarkAudioDevice.count     = packets;
+
+    return USB_BenchmarkDeviceStart(benchmark, &s_BenchmarkAudioConfigList, &s_BenchmarkAudioDescriptorTable);
+}
+
+usb_status_t USB_BenchmarkAudioDeviceStop(usb_benchmark_struct_t *benchmark)
+{
+    return USB_BenchmarkDeviceStop(benchmark);
+}
+
+void USB_BenchmarkAudioDeviceGetArrival(usb_benchmark_audio_arrival_t *arrival)
+{
+    usb_benchmark_audio_device_struct_t *device = &s_BenchmarkAudioDevice;
+
+    arrival->packets   = device->packets;
+    arrival->bytes     = device->bytes;
+    arrival->minLength = device->minLength;
+    arrival->maxLength = device->maxLength;
+    /* The bus time is in picoseconds */
+    arrival->jitter    = (device->packets > 1U) ? (uint32_t)(device->jitter / (device->packets - 1U) / 1000U) : 0U;
+    arrival->maxJitter = (uint32_t)(device->maxJitter / 1000U);
+}
+
+#endif /* USB_DEVICE_CONFIG_AUDIO && USB_HOST_CONFIG_AUDIO && USB_HOST_CONFIG_AUDIO_STREAM_ENGINE */
@@ -0,0 +1,354 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_benchmark.h"
+
+#if ((defined(USB_DEVICE_CONFIG_CDC_ACM)) && (USB_DEVICE_CONFIG_CDC_ACM > 0U) && (defined(USB_HOST_CONFIG_CDC)) && \
+     (USB_HOST_CONFIG_CDC > 0U))
+#include "usb_device_cdc_acm.h"
+#include "usb_host_cdc.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The writes of each measurement */
+#ifndef USB_BENCHMARK_CDC_ACM_WRITES
+#define USB_BENCHMARK_CDC_ACM_WRITES (4096U)
+#endif
+
+/*! @brief The largest write */
+#define USB_BENCHMARK_CDC_ACM_MAX_WRITE (64U)
+
+#define USB_BENCHMARK_CDC_ACM_COMM_INTERFACE (0U)
+#define USB_BENCHMARK_CDC_ACM_DATA_INTERFACE (1U)
+#define USB_BENCHMARK_CDC_ACM_NOTIFICATION_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(3U, USB_IN)
+#define USB_BENCHMARK_CDC_ACM_BULK_IN_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(1U, USB_IN)
+#define USB_BENCHMARK_CDC_ACM_BULK_OUT_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(2U, USB_OUT)
+#define USB_BENCHMARK_CDC_ACM_NOTIFICATION_MAX_PACKET_SIZE (16U)
+#define USB_BENCHMARK_CDC_ACM_NOTIFICATION_INTERVAL (8U)
+
+/*! @brief The CDC ACM measurement state */
+typedef struct _usb_benchmark_cdc_acm_struct
+{
+    usb_host_class_handle classHandle; /*!< The host CDC instance */
+    uint32_t writeLength;              /*!< The bytes of each write */
+    uint32_t remaining;                /*!< The writes to issue */
+    uint32_t writes;                   /*!< The completed writes */
+    uint32_t receivedBytes;            /*!< The bytes received by the device */
+    volatile uint8_t done;             /*!< The measurement is done */
+    usb_status_t status;               /*!< The first error of the measurement */
+} usb_benchmark_cdc_acm_struct_t;
+
+/*! @brief The write size of one CDC ACM measurement */
+typedef struct _usb_benchmark_cdc_acm_size_struct
+{
+    uint32_t writeLength; /*!< The bytes of each write */
+    const char *name;     /*!< The measurement name */
+} usb_benchmark_cdc_acm_size_struct_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static usb_status_t USB_BenchmarkCdcAcmClassCallback(class_handle_t handle, uint32_t event, void *param);
+static usb_status_t USB_BenchmarkCdcAcmDeviceCallback(usb_device_handle handle, uint32_t event, void *param);
+static void USB_BenchmarkCdcAcmCallback(void *param, uint8_t *data, uint32_t dataLen, usb_status_t status);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The receive buffer of the device */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t s_BenchmarkCdcAcmRecvBuffer[USB_BENCHMARK_BULK_MAX_PACKET_SIZE];
+/* The write buffer of the host */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t s_BenchmarkCdcAcmWriteBuffer[USB_BENCHMARK_CDC_ACM_MAX_WRITE];
+
+static usb_benchmark_cdc_acm_struct_t s_BenchmarkCdcAcm;
+
+static const usb_benchmark_cdc_acm_size_struct_t s_BenchmarkCdcAcmSizes[] = {
+    {8U, "CDC ACM write 8B"},
+    {USB_BENCHMARK_CDC_ACM_MAX_WRITE, "CDC ACM write 64B"},
+};
+
+static usb_device_endpoint_struct_t s_BenchmarkCdcAcmCommEndpoints[] = {
+    {USB_BENCHMARK_CDC_ACM_NOTIFICATION_ENDPOINT, USB_ENDPOINT_INTERRUPT,
+     USB_BENCHMARK_CDC_ACM_NOTIFICATION_MAX_PACKET_SIZE, USB_BENCHMARK_CDC_ACM_NOTIFICATION_INTERVAL},
+};
+
+static usb_device_endpoint_struct_t s_BenchmarkCdcAcmDataEndpoints[] = {
+    {USB_BENCHMARK_CDC_ACM_BULK_IN_ENDPOINT, USB_ENDPOINT_BULK, USB_BENCHMARK_BULK_MAX_PACKET_SIZE, 0U},
+    {USB_BENCHMARK_CDC_ACM_BULK_OUT_ENDPOINT, USB_ENDPOINT_BULK, USB_BENCHMARK_BULK_MAX_PACKET_SIZE, 0U},
+};
+
+static usb_device_interface_struct_t s_BenchmarkCdcAcmCommInterface[] = {
+    {0U, {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcAcmCommEndpoints), s_BenchmarkCdcAcmCommEndpoints}, NULL},
+};
+
+static usb_device_interface_struct_t s_BenchmarkCdcAcmDataInterface[] = {
+    {0U, {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcAcmDataEndpoints), s_BenchmarkCdcAcmDataEndpoints}, NULL},
+};
+
+static usb_device_interfaces_struct_t s_BenchmarkCdcAcmInterfaces[] = {
+    {USB_DEVICE_CONFIG_CDC_COMM_CLASS_CODE, 0x02U, 0x00U, USB_BENCHMARK_CDC_ACM_COMM_INTERFACE,
+     s_BenchmarkCdcAcmCommInterface, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcAcmCommInterface)},
+    {USB_DEVICE_CONFIG_CDC_DATA_CLASS_CODE, 0x00U, 0x00U, USB_BENCHMARK_CDC_ACM_DATA_INTERFACE,
+     s_BenchmarkCdcAcmDataInterface, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcAcmDataInterface)},
+};
+
+static usb_device_interface_list_t s_BenchmarkCdcAcmInterfaceList[] = {
+    {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcAcmInterfaces), s_BenchmarkCdcAcmInterfaces},
+};
+
+static usb_device_class_struct_t s_BenchmarkCdcAcmClass = {s_BenchmarkCdcAcmInterfaceList, kUSB_DeviceClassTypeCdc,
+                                                           1U};
+
+static usb_device_class_config_struct_t s_BenchmarkCdcAcmConfig[] = {
+    {USB_BenchmarkCdcAcmClassCallback, (class_handle_t)NULL, &s_BenchmarkCdcAcmClass},
+};
+
+static usb_device_class_config_list_struct_t s_BenchmarkCdcAcmConfigList = {
+    s_BenchmarkCdcAcmConfig, USB_BenchmarkCdcAcmDeviceCallback, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcAcmConfig)};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkCdcAcmDeviceDescriptor[] = {USB_DESCRIPTOR_DEVICE(
+    0x0200U, 0xEFU, 0x02U, 0x01U, USB_CONTROL_MAX_PACKET_SIZE, 0x1FC9U, 0x0101U, 0x0101U, 0U, 0U, 0U, 1U)};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkCdcAcmConfigurationDescriptor[] = {USB_DESCRIPTOR_CONFIGURATION(
+    USB_DESCRIPTOR_CDC_ACM_INTERFACE_COUNT, 1U, 0U, 0xC0U, 50U,
+    USB_DESCRIPTOR_CDC_ACM_FUNCTION(USB_BENCHMARK_CDC_ACM_COMM_INTERFACE, USB_BENCHMARK_CDC_ACM_NOTIFICATION_ENDPOINT,
+                                    USB_BENCHMARK_CDC_ACM_NOTIFICATION_MAX_PACKET_SIZE,
+                                    USB_BENCHMARK_CDC_ACM_NOTIFICATION_INTERVAL, USB_BENCHMARK_CDC_ACM_BULK_IN_ENDPOINT,
+                                    USB_BENCHMARK_CDC_ACM_BULK_OUT_ENDPOINT, USB_BENCHMARK_BULK_MAX_PACKET_SIZE, 0U))};
+
+static const usb_device_descriptor_entry_struct_t s_BenchmarkCdcAcmDescriptorEntries[] = {
+    {s_BenchmarkCdcAcmDeviceDescriptor, sizeof(s_BenchmarkCdcAcmDeviceDescriptor), 0U, USB_DESCRIPTOR_TYPE_DEVICE, 0U,
+     USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+    {s_BenchmarkCdcAcmConfigurationDescriptor, sizeof(s_BenchmarkCdcAcmConfigurationDescriptor), 0U,
+     USB_DESCRIPTOR_TYPE_CONFIGURE, 0U, USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+};
+
+static const usb_device_descriptor_table_struct_t s_BenchmarkCdcAcmDescriptorTable = {
+    s_BenchmarkCdcAcmDescriptorEntries, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcAcmDescriptorEntries)};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Device CDC ACM class callback, the bulk OUT endpoint is primed again when a write is received.
+ *
+ * @param handle The CDC ACM class handle.
+ * @param event  The CDC ACM event.
+ * @param param  The event parameter.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkCdcAcmClassCallback(class_handle_t handle, uint32_t event, void *param)
+{
+    usb_device_endpoint_callback_message_struct_t *message;
+    usb_status_t error = kStatus_USB_Success;
+
+    switch (event)
+    {
+        case kUSB_DeviceCdcEventRecvResponse:
+            message = (usb_device_endpoint_callback_message_struct_t *)param;
+            if (USB_CANCELLED_TRANSFER_LENGTH != message->length)
+            {
+                s_BenchmarkCdcAcm.receivedBytes += message->length;
+                error = USB_DeviceCdcAcmRecv(handle, USB_BENCHMARK_CDC_ACM_BULK_OUT_ENDPOINT & USB_ENDPOINT_NUMBER_MASK,
+                                             s_BenchmarkCdcAcmRecvBuffer, sizeof(s_BenchmarkCdcAcmRecvBuffer));
+            }
+            break;
+
+        case kUSB_DeviceCdcEventSendResponse:
+        case kUSB_DeviceCdcEventSerialStateNotif:
+            break;
+
+        default:
+            error = kStatus_USB_InvalidRequest;
+            break;
+    }
+    return error;
+}
+
+/*!
+ * @brief Device callback, the bulk OUT endpoint is primed when the device is configured.
+ *
+ * @param handle The device handle.
+ * @param event  The device event.
+ * @param param  The event parameter.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkCdcAcmDeviceCallback(usb_device_handle handle, uint32_t event, void *param)
+{
+    usb_status_t error = USB_BenchmarkDeviceCallback(handle, event, param);
+
+    if ((kStatus_USB_Success == error) && ((uint32_t)kUSB_DeviceEventSetConfiguration == event) &&
+        (0U != *((uint8_t *)param)))
+    {
+        error = USB_DeviceCdcAcmRecv(s_BenchmarkCdcAcmConfig[0].classHandle,
+                                     USB_BENCHMARK_CDC_ACM_BULK_OUT_ENDPOINT & USB_ENDPOINT_NUMBER_MASK,
+                                     s_BenchmarkCdcAcmRecvBuffer, sizeof(s_BenchmarkCdcAcmRecvBuffer));
+    }
+    return error;
+}
+
+/*!
+ * @brief Issues the next write of the measurement.
+ *
+ * @param cdcAcm The CDC ACM measurement state.
+ */
+static void USB_BenchmarkCdcAcmIssue(usb_benchmark_cdc_acm_struct_t *cdcAcm)
+{
+    usb_status_t status;
+
+    if (0U == cdcAcm->remaining)
+    {
+        cdcAcm->done = 1U;
+        return;
+    }
+    cdcAcm->remaining--;
+    status = USB_HostCdcDataSend(cdcAcm->classHandle, s_BenchmarkCdcAcmWriteBuffer, cdcAcm->writeLength,
+                                 USB_BenchmarkCdcAcmCallback, cdcAcm);
+    if (kStatus_USB_Success != status)
+    {
+        cdcAcm->status = status;
+        cdcAcm->done   = 1U;
+    }
+}
+
+/*!
+ * @brief Host CDC data send callback, the next write is issued until the measurement is done.
+ *
+ * @param param   The CDC ACM measurement state.
+ * @param data    The data buffer.
+ * @param dataLen The data length.
+ * @param status  The write status.
+ */
+static void USB_BenchmarkCdcAcmCallback(void *param, uint8_t *data, uint32_t dataLen, usb_status_t status)
+{
+    usb_benchmark_cdc_acm_struct_t *cdcAcm = (usb_benchmark_cdc_acm_struct_t *)param;
+
+    if (kStatus_USB_Success != status)
+    {
+        cdcAcm->status = status;
+        cdcAcm->done   = 1U;
+        return;
+    }
+    cdcAcm->writes++;
+    USB_BenchmarkCdcAcmIssue(cdcAcm);
+}
+
+/*!
+ * @brief Runs one CDC ACM measurement.
+ *
+ * @param benchmark The benchmark instance.
+ * @param cdcAcm    The CDC ACM measurement state.
+ * @param size      The write size.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkCdcAcmMeasure(usb_benchmark_struct_t *benchmark,
+                                               usb_benchmark_cdc_acm_struct_t *cdcAcm,
+                                               const usb_benchmark_cdc_acm_size_struct_t *size)
+{
+    usb_benchmark_result_t result;
+    uint32_t startCycles;
+
+    cdcAcm->writeLength   = size->writeLength;
+    cdcAcm->remaining     = USB_BENCHMARK_CDC_ACM_WRITES;
+    cdcAcm->writes        = 0U;
+    cdcAcm->receivedBytes = 0U;
+    cdcAcm->done          = 0U;
+    cdcAcm->status        = kStatus_USB_Success;
+
+    USB_BenchmarkStart(benchmark);
+    /* The first write is issued here, the others by the completion callback */
+    startCycles = USB_BENCHMARK_CYCLES();
+    USB_BenchmarkCdcAcmIssue(cdcAcm);
+    benchmark->callCycles += (uint32_t)(USB_BENCHMARK_CYCLES() - startCycles);
+    if ((kStatus_USB_Success !=
+         USB_BenchmarkWait(benchmark, &cdcAcm->done,
+                           (USB_BENCHMARK_CDC_ACM_WRITES + 1U) * USB_BENCHMARK_TIMEOUT_FRAMES)) ||
+        (kStatus_USB_Success != cdcAcm->status) || (cdcAcm->receivedBytes != (cdcAcm->writes * size->writeLength)))
+    {
+        usb_echo("CDC ACM write error\r\n");
+        return kStatus_USB_Error;
+    }
+    USB_BenchmarkStop(benchmark, &result);
+    result.transfers = cdcAcm->writes;
+    result.bytes     = cdcAcm->receivedBytes;
+    USB_BenchmarkPrint(size->name, &result);
+    usb_echo("%-24s %8u writes/s\r\n", size->name, USB_BenchmarkRate(result.transfers, result.busTime));
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_BenchmarkCdcAcm(usb_benchmark_struct_t *benchmark)
+{
+    usb_benchmark_cdc_acm_struct_t *cdcAcm = &s_BenchmarkCdcAcm;
+    usb_host_interface_handle commInterfaceHandle;
+    usb_host_interface_handle dataInterfaceHandle;
+    usb_status_t status = kStatus_USB_Error;
+    uint32_t index;
+
+    if (kStatus_USB_Success !=
+        USB_BenchmarkDeviceStart(benchmark, &s_BenchmarkCdcAcmConfigList, &s_BenchmarkCdcAcmDescriptorTable))
+    {
+        usb_echo("CDC ACM enumeration error\r\n");
+        return kStatus_USB_Error;
+    }
+
+    commInterfaceHandle = USB_BenchmarkGetInterface(benchmark, 0x02U, 0x02U);
+    dataInterfaceHandle = USB_BenchmarkGetInterface(benchmark, 0x0AU, 0x00U);
+    if ((NULL != commInterfaceHandle) && (NULL != dataInterfaceHandle) &&
+        (kStatus_USB_Success == USB_HostCdcInit(benchmark->attachedDeviceHandle, &cdcAcm->classHandle)) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark,
+                                  USB_HostCdcSetControlInterface(cdcAcm->classHandle, commInterfaceHandle, 0U,
+                                                                 USB_BenchmarkRequestCallback, benchmark))) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark, USB_HostCdcSetDataInterface(cdcAcm->classHandle, dataInterfaceHandle, 0U,
+                                                                         USB_BenchmarkRequestCallback, benchmark))))
+    {
+        status = kStatus_USB_Success;
+        for (index = 0U; index < sizeof(s_BenchmarkCdcAcmWriteBuffer); index++)
+        {
+            s_BenchmarkCdcAcmWriteBuffer[index] = (uint8_t)index;
+        }
+        for (index = 0U;
+             (kStatus_USB_Success == status) && (index < USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcAcmSizes)); index++)
+        {
+            status = USB_BenchmarkCdcAcmMeasure(benchmark, cdcAcm, &s_BenchmarkCdcAcmSizes[index]);
+        }
+    }
+    else
+    {
+        usb_echo("CDC ACM host class error\r\n");
+    }
+
+    if (kStatus_USB_Success != USB_BenchmarkDeviceStop(benchmark))
+    {
+        status = kStatus_USB_Error;
+    }
+    if (NULL != cdcAcm->classHandle)
+    {
+        (void)USB_HostCdcDeinit(benchmark->attachedDeviceHandle, cdcAcm->classHandle);
+        cdcAcm->classHandle = NULL;
+    }
+    else
+    {
+        (void)USB_HostCloseDeviceInterface(benchmark->attachedDeviceHandle, NULL);
+    }
+    return status;
+}
+
+#endif /* USB_DEVICE_CONFIG_CDC_ACM && USB_HOST_CONFIG_CDC */
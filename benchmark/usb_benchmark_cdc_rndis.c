@@ -0,0 +1,312 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_benchmark.h"
+
+#if ((defined(USB_DEVICE_CONFIG_CDC_RNDIS)) && (USB_DEVICE_CONFIG_CDC_RNDIS > 0U) && \
+     (defined(USB_HOST_CONFIG_CDC_RNDIS)) && (USB_HOST_CONFIG_CDC_RNDIS > 0U))
+#include "usb_host_cdc.h"
+#include "usb_host_cdc_rndis.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The packets of each measurement */
+#ifndef USB_BENCHMARK_CDC_RNDIS_PACKETS
+#define USB_BENCHMARK_CDC_RNDIS_PACKETS (2048U)
+#endif
+
+/*! @brief The largest Ethernet frame */
+#define USB_BENCHMARK_CDC_RNDIS_MAX_FRAME_SIZE (1514U)
+
+/*! @brief The buffer of the control messages and of their responses */
+#define USB_BENCHMARK_CDC_RNDIS_CONTROL_BUFFER_SIZE (128U)
+
+/*! @brief The RESPONSE_AVAILABLE notification */
+#define USB_BENCHMARK_CDC_RNDIS_NOTIFICATION_SIZE (8U)
+
+/*! @brief The RNDIS measurement state */
+typedef struct _usb_benchmark_cdc_rndis_struct
+{
+    usb_host_class_handle classHandle; /*!< The host CDC instance */
+    uint32_t frameLength;              /*!< The Ethernet frame bytes of each packet */
+    uint32_t remaining;                /*!< The packets to send */
+    uint32_t packets;                  /*!< The sent packets */
+    volatile uint8_t done;             /*!< The measurement is done */
+    usb_status_t status;               /*!< The first error of the measurement */
+} usb_benchmark_cdc_rndis_struct_t;
+
+/*! @brief The frame size of one RNDIS measurement */
+typedef struct _usb_benchmark_cdc_rndis_size_struct
+{
+    uint32_t frameLength; /*!< The Ethernet frame bytes of each packet */
+    const char *name;     /*!< The measurement name */
+} usb_benchmark_cdc_rndis_size_struct_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void USB_BenchmarkCdcRndisCallback(void *param, uint8_t *data, uint32_t dataLen, usb_status_t status);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The packet message of the host */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint32_t s_BenchmarkCdcRndisMessage[(sizeof(rndis_packet_msg_struct_t) + 3U) / sizeof(uint32_t)];
+/* The Ethernet frame of the host */
+static uint8_t s_BenchmarkCdcRndisFrame[USB_BENCHMARK_CDC_RNDIS_MAX_FRAME_SIZE];
+/* The control message and its response */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint32_t s_BenchmarkCdcRndisControl[USB_BENCHMARK_CDC_RNDIS_CONTROL_BUFFER_SIZE / sizeof(uint32_t)];
+/* The RESPONSE_AVAILABLE notification */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t s_BenchmarkCdcRndisNotification[USB_BENCHMARK_CDC_RNDIS_NOTIFICATION_SIZE];
+
+static usb_benchmark_cdc_rndis_struct_t s_BenchmarkCdcRndis;
+
+/* The frame sizes, the message length of none of them is a multiple of the bulk max packet size */
+static const usb_benchmark_cdc_rndis_size_struct_t s_BenchmarkCdcRndisSizes[] = {
+    {64U, "RNDIS packet 64B"},
+    {512U, "RNDIS packet 512B"},
+    {USB_BENCHMARK_CDC_RNDIS_MAX_FRAME_SIZE, "RNDIS packet 1514B"},
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Completes a control message, the response is read when the device notifies that it is available.
+ *
+ * @param benchmark The benchmark instance.
+ * @param rndis     The RNDIS measurement state.
+ * @param status    The return value of the call that sent the control message.
+ * @param type      The completion message type.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkCdcRndisControl(usb_benchmark_struct_t *benchmark,
+                                                 usb_benchmark_cdc_rndis_struct_t *rndis,
+                                                 usb_status_t status,
+                                                 uint32_t type)
+{
+    rndis_set_cmplt_struct_t *response = (rndis_set_cmplt_struct_t *)((void *)s_BenchmarkCdcRndisControl);
+
+    if ((kStatus_USB_Success != USB_BenchmarkRequestWait(benchmark, status)) ||
+        (kStatus_USB_Success !=
+         USB_BenchmarkRequestWait(benchmark,
+                                  USB_HostCdcInterruptRecv(rndis->classHandle, s_BenchmarkCdcRndisNotification,
+                                                           sizeof(s_BenchmarkCdcRndisNotification),
+                                                           USB_BenchmarkRequestCallback, benchmark))))
+    {
+        return kStatus_USB_Error;
+    }
+    (void)memset(s_BenchmarkCdcRndisControl, 0, sizeof(s_BenchmarkCdcRndisControl));
+    if ((kStatus_USB_Success !=
+         USB_BenchmarkRequestWait(benchmark, USB_HostCdcGetEncapsulatedResponse(
+                                                 rndis->classHandle, (uint8_t *)s_BenchmarkCdcRndisControl,
+                                                 sizeof(s_BenchmarkCdcRndisControl), USB_BenchmarkRequestCallback,
+                                                 benchmark))) ||
+        (type != USB_LONG_TO_LITTLE_ENDIAN(response->messageType)) ||
+        (RNDIS_STATUS_SUCCESS != USB_LONG_TO_LITTLE_ENDIAN(response->status)))
+    {
+        return kStatus_USB_Error;
+    }
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Initializes the device and sets the packet filter, the device enters the RNDIS data initialized state.
+ *
+ * @param benchmark The benchmark instance.
+ * @param rndis     The RNDIS measurement state.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkCdcRndisOpen(usb_benchmark_struct_t *benchmark,
+                                              usb_benchmark_cdc_rndis_struct_t *rndis)
+{
+    uint32_t packetFilter = NDIS_PACKET_TYPE_DIRECTED | NDIS_PACKET_TYPE_BROADCAST;
+
+    if (kStatus_USB_Success !=
+        USB_BenchmarkCdcRndisControl(benchmark, rndis,
+                                     USB_HostRndisInitMsg(rndis->classHandle, (uint8_t *)s_BenchmarkCdcRndisControl,
+                                                          sizeof(s_BenchmarkCdcRndisControl),
+                                                          USB_BenchmarkRequestCallback, benchmark),
+                                     REMOTE_NDIS_INITIALIZE_CMPLT))
+    {
+        return kStatus_USB_Error;
+    }
+    return USB_BenchmarkCdcRndisControl(
+        benchmark, rndis,
+        USB_HostRndisSetMsg(rndis->classHandle, OID_GEN_CURRENT_PACKET_FILTER, (uint8_t *)s_BenchmarkCdcRndisControl,
+                            sizeof(s_BenchmarkCdcRndisControl), RNDIS_SET_MSG_SIZE - 8U, sizeof(packetFilter),
+                            &packetFilter, USB_BenchmarkRequestCallback, benchmark),
+        REMOTE_NDIS_SET_CMPLT);
+}
+
+/*!
+ * @brief Sends the next packet of the measurement.
+ *
+ * @param rndis The RNDIS measurement state.
+ */
+static void USB_BenchmarkCdcRndisIssue(usb_benchmark_cdc_rndis_struct_t *rndis)
+{
+    usb_status_t status;
+
+    if (0U == rndis->remaining)
+    {
+        rndis->done = 1U;
+        return;
+    }
+    rndis->remaining--;
+    status = USB_HostRndisSendDataMsg(rndis->classHandle, (uint8_t *)s_BenchmarkCdcRndisMessage,
+                                      sizeof(s_BenchmarkCdcRndisMessage), 0U, 0U, 0U, 0U, 0U, s_BenchmarkCdcRndisFrame,
+                                      rndis->frameLength, USB_BenchmarkCdcRndisCallback, rndis);
+    if (kStatus_USB_Success != status)
+    {
+        rndis->status = status;
+        rndis->done   = 1U;
+    }
+}
+
+/*!
+ * @brief Host packet message callback, the next packet is sent until the measurement is done.
+ *
+ * @param param   The RNDIS measurement state.
+ * @param data    The data buffer.
+ * @param dataLen The data length.
+ * @param status  The transfer status.
+ */
+static void USB_BenchmarkCdcRndisCallback(void *param, uint8_t *data, uint32_t dataLen, usb_status_t status)
+{
+    usb_benchmark_cdc_rndis_struct_t *rndis = (usb_benchmark_cdc_rndis_struct_t *)param;
+
+    if (kStatus_USB_Success != status)
+    {
+        rndis->status = status;
+        rndis->done   = 1U;
+        return;
+    }
+    rndis->packets++;
+    USB_BenchmarkCdcRndisIssue(rndis);
+}
+
+/*!
+ * @brief Runs one RNDIS measurement.
+ *
+ * The bytes are the Ethernet frame bytes received by the device, without the packet message headers.
+ *
+ * @param benchmark The benchmark instance.
+ * @param rndis     The RNDIS measurement state.
+ * @param size      The frame size.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkCdcRndisMeasure(usb_benchmark_struct_t *benchmark,
+                                                 usb_benchmark_cdc_rndis_struct_t *rndis,
+                                                 const usb_benchmark_cdc_rndis_size_struct_t *size)
+{
+    usb_benchmark_result_t result;
+    uint32_t startCycles;
+    uint32_t packets;
+    uint32_t bytes;
+
+    rndis->frameLength = size->frameLength;
+    rndis->remaining   = USB_BENCHMARK_CDC_RNDIS_PACKETS;
+    rndis->packets     = 0U;
+    rndis->done        = 0U;
+    rndis->status      = kStatus_USB_Success;
+    (void)USB_BenchmarkCdcRndisDeviceGetCount(&packets, &bytes);
+
+    USB_BenchmarkStart(benchmark);
+    /* The first packet is sent here, the others by the completion callback */
+    startCycles = USB_BENCHMARK_CYCLES();
+    USB_BenchmarkCdcRndisIssue(rndis);
+    benchmark->callCycles += (uint32_t)(USB_BENCHMARK_CYCLES() - startCycles);
+    if ((kStatus_USB_Success !=
+         USB_BenchmarkWait(benchmark, &rndis->done,
+                           (USB_BENCHMARK_CDC_RNDIS_PACKETS + 1U) * USB_BENCHMARK_TIMEOUT_FRAMES)) ||
+        (kStatus_USB_Success != rndis->status) ||
+        (kStatus_USB_Success != USB_BenchmarkCdcRndisDeviceGetCount(&packets, &bytes)) || (packets != rndis->packets) ||
+        (bytes != (packets * size->frameLength)))
+    {
+        usb_echo("RNDIS packet error\r\n");
+        return kStatus_USB_Error;
+    }
+    USB_BenchmarkStop(benchmark, &result);
+    result.transfers = packets;
+    result.bytes     = bytes;
+    USB_BenchmarkPrint(size->name, &result);
+    usb_echo("%-24s %8u packets/s\r\n", size->name, USB_BenchmarkRate(result.transfers, result.busTime));
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_BenchmarkCdcRndis(usb_benchmark_struct_t *benchmark)
+{
+    usb_benchmark_cdc_rndis_struct_t *rndis = &s_BenchmarkCdcRndis;
+    usb_host_interface_handle commInterfaceHandle;
+    usb_host_interface_handle dataInterfaceHandle;
+    usb_status_t status = kStatus_USB_Error;
+    uint32_t index;
+
+    if (kStatus_USB_Success != USB_BenchmarkCdcRndisDeviceStart(benchmark))
+    {
+        usb_echo("RNDIS enumeration error\r\n");
+        return kStatus_USB_Error;
+    }
+
+    commInterfaceHandle = USB_BenchmarkGetInterface(benchmark, 0x02U, 0x02U);
+    dataInterfaceHandle = USB_BenchmarkGetInterface(benchmark, 0x0AU, 0x00U);
+    if ((NULL != commInterfaceHandle) && (NULL != dataInterfaceHandle) &&
+        (kStatus_USB_Success == USB_HostCdcInit(benchmark->attachedDeviceHandle, &rndis->classHandle)) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark,
+                                  USB_HostCdcSetControlInterface(rndis->classHandle, commInterfaceHandle, 0U,
+                                                                 USB_BenchmarkRequestCallback, benchmark))) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark, USB_HostCdcSetDataInterface(rndis->classHandle, dataInterfaceHandle, 0U,
+                                                                         USB_BenchmarkRequestCallback, benchmark))) &&
+        (kStatus_USB_Success == USB_BenchmarkCdcRndisOpen(benchmark, rndis)))
+    {
+        status = kStatus_USB_Success;
+        for (index = 0U; index < sizeof(s_BenchmarkCdcRndisFrame); index++)
+        {
+            s_BenchmarkCdcRndisFrame[index] = (uint8_t)index;
+        }
+        for (index = 0U;
+             (kStatus_USB_Success == status) && (index < USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcRndisSizes)); index++)
+        {
+            status = USB_BenchmarkCdcRndisMeasure(benchmark, rndis, &s_BenchmarkCdcRndisSizes[index]);
+        }
+    }
+    else
+    {
+        usb_echo("RNDIS host class error\r\n");
+    }
+
+    if (kStatus_USB_Success != USB_BenchmarkCdcRndisDeviceStop(benchmark))
+    {
+        status = kStatus_USB_Error;
+    }
+    if (NULL != rndis->classHandle)
+    {
+        (void)USB_HostCdcDeinit(benchmark->attachedDeviceHandle, rndis->classHandle);
+        rndis->classHandle = NULL;
+    }
+    else
+    {
+        (void)USB_HostCloseDeviceInterface(benchmark->attachedDeviceHandle, NULL);
+    }
+    return status;
+}
+
+#endif /* USB_DEVICE_CONFIG_CDC_RNDIS && USB_HOST_CONFIG_CDC_RNDIS */
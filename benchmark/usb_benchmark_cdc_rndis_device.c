@@ -0,0 +1,352 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_benchmark.h"
+
+#if ((defined(USB_DEVICE_CONFIG_CDC_RNDIS)) && (USB_DEVICE_CONFIG_CDC_RNDIS > 0U) && \
+     (defined(USB_HOST_CONFIG_CDC_RNDIS)) && (USB_HOST_CONFIG_CDC_RNDIS > 0U))
+#include "usb_device_cdc_acm.h"
+#include "usb_device_cdc_rndis.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The receive buffer of the device, one RNDIS packet message with the largest Ethernet frame */
+#define USB_BENCHMARK_CDC_RNDIS_RECV_BUFFER_SIZE (2048U)
+
+/*! @brief The largest Ethernet frame */
+#define USB_BENCHMARK_CDC_RNDIS_MAX_FRAME_SIZE (1514U)
+
+#define USB_BENCHMARK_CDC_RNDIS_COMM_INTERFACE (0U)
+#define USB_BENCHMARK_CDC_RNDIS_DATA_INTERFACE (1U)
+#define USB_BENCHMARK_CDC_RNDIS_NOTIFICATION_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(3U, USB_IN)
+#define USB_BENCHMARK_CDC_RNDIS_BULK_IN_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(1U, USB_IN)
+#define USB_BENCHMARK_CDC_RNDIS_BULK_OUT_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(2U, USB_OUT)
+#define USB_BENCHMARK_CDC_RNDIS_NOTIFICATION_MAX_PACKET_SIZE (8U)
+#define USB_BENCHMARK_CDC_RNDIS_NOTIFICATION_INTERVAL (4U)
+
+/*! @brief The device side of the RNDIS benchmark */
+typedef struct _usb_benchmark_cdc_rndis_device_struct
+{
+    usb_device_cdc_rndis_struct_t *rndisHandle; /*!< The device RNDIS instance */
+    uint32_t packets;                           /*!< The packet messages received */
+    uint32_t bytes;                             /*!< The Ethernet frame bytes received */
+    uint8_t error;                              /*!< A malformed message was received */
+} usb_benchmark_cdc_rndis_device_struct_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static usb_status_t USB_BenchmarkCdcRndisClassCallback(class_handle_t handle, uint32_t event, void *param);
+static usb_status_t USB_BenchmarkCdcRndisDeviceCallback(usb_device_handle handle, uint32_t event, void *param);
+static usb_status_t USB_BenchmarkCdcRndisCallback(class_handle_t handle, uint32_t event, void *param);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The receive buffer of the device */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint32_t s_BenchmarkCdcRndisRecvBuffer[USB_BENCHMARK_CDC_RNDIS_RECV_BUFFER_SIZE / sizeof(uint32_t)];
+
+static usb_benchmark_cdc_rndis_device_struct_t s_BenchmarkCdcRndisDevice;
+
+static const uint8_t s_BenchmarkCdcRndisMacAddress[RNDIS_ETHER_ADDR_SIZE] = {0x02U, 0x00U, 0x00U,
+                                                                             0x00U, 0x00U, 0x01U};
+
+static usb_device_endpoint_struct_t s_BenchmarkCdcRndisCommEndpoints[] = {
+    {USB_BENCHMARK_CDC_RNDIS_NOTIFICATION_ENDPOINT, USB_ENDPOINT_INTERRUPT,
+     USB_BENCHMARK_CDC_RNDIS_NOTIFICATION_MAX_PACKET_SIZE, USB_BENCHMARK_CDC_RNDIS_NOTIFICATION_INTERVAL},
+};
+
+static usb_device_endpoint_struct_t s_BenchmarkCdcRndisDataEndpoints[] = {
+    {USB_BENCHMARK_CDC_RNDIS_BULK_IN_ENDPOINT, USB_ENDPOINT_BULK, USB_BENCHMARK_BULK_MAX_PACKET_SIZE, 0U},
+    {USB_BENCHMARK_CDC_RNDIS_BULK_OUT_ENDPOINT, USB_ENDPOINT_BULK, USB_BENCHMARK_BULK_MAX_PACKET_SIZE, 0U},
+};
+
+static usb_device_interface_struct_t s_BenchmarkCdcRndisCommInterface[] = {
+    {0U, {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcRndisCommEndpoints), s_BenchmarkCdcRndisCommEndpoints}, NULL},
+};
+
+static usb_device_interface_struct_t s_BenchmarkCdcRndisDataInterface[] = {
+    {0U, {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcRndisDataEndpoints), s_BenchmarkCdcRndisDataEndpoints}, NULL},
+};
+
+static usb_device_interfaces_struct_t s_BenchmarkCdcRndisInterfaces[] = {
+    {USB_DEVICE_CONFIG_CDC_COMM_CLASS_CODE, 0x02U, 0xFFU, USB_BENCHMARK_CDC_RNDIS_COMM_INTERFACE,
+     s_BenchmarkCdcRndisCommInterface, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcRndisCommInterface)},
+    {USB_DEVICE_CONFIG_CDC_DATA_CLASS_CODE, 0x00U, 0x00U, USB_BENCHMARK_CDC_RNDIS_DATA_INTERFACE,
+     s_BenchmarkCdcRndisDataInterface, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcRndisDataInterface)},
+};
+
+static usb_device_interface_list_t s_BenchmarkCdcRndisInterfaceList[] = {
+    {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcRndisInterfaces), s_BenchmarkCdcRndisInterfaces},
+};
+
+static usb_device_class_struct_t s_BenchmarkCdcRndisClass = {s_BenchmarkCdcRndisInterfaceList,
+                                                             kUSB_DeviceClassTypeCdc, 1U};
+
+static usb_device_class_config_struct_t s_BenchmarkCdcRndisConfig[] = {
+    {USB_BenchmarkCdcRndisClassCallback, (class_handle_t)NULL, &s_BenchmarkCdcRndisClass},
+};
+
+static usb_device_class_config_list_struct_t s_BenchmarkCdcRndisConfigList = {
+    s_BenchmarkCdcRndisConfig, USB_BenchmarkCdcRndisDeviceCallback,
+    USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcRndisConfig)};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkCdcRndisDeviceDescriptor[] = {USB_DESCRIPTOR_DEVICE(
+    0x0200U, 0xEFU, 0x02U, 0x01U, USB_CONTROL_MAX_PACKET_SIZE, 0x1FC9U, 0x0102U, 0x0101U, 0U, 0U, 0U, 1U)};
+
+/* The RNDIS function: the communication interface with the vendor specific protocol and the data interface */
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkCdcRndisConfigurationDescriptor[] = {USB_DESCRIPTOR_CONFIGURATION(
+    2U, 1U, 0U, 0xC0U, 50U,
+    USB_DESCRIPTOR_INTERFACE_ASSOCIATION(USB_BENCHMARK_CDC_RNDIS_COMM_INTERFACE, 2U, 0x02U, 0x02U, 0xFFU, 0U),
+    USB_DESCRIPTOR_INTERFACE(USB_BENCHMARK_CDC_RNDIS_COMM_INTERFACE, 0U, 1U, 0x02U, 0x02U, 0xFFU, 0U),
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x00U, USB_DESCRIPTOR_WORD(0x0110U)),
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x01U, 0x00U,
+                                  USB_BENCHMARK_CDC_RNDIS_DATA_INTERFACE),
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x02U, 0x00U),
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x06U,
+                                  USB_BENCHMARK_CDC_RNDIS_COMM_INTERFACE, USB_BENCHMARK_CDC_RNDIS_DATA_INTERFACE),
+    USB_DESCRIPTOR_ENDPOINT(USB_BENCHMARK_CDC_RNDIS_NOTIFICATION_ENDPOINT, USB_ENDPOINT_INTERRUPT,
+                            USB_BENCHMARK_CDC_RNDIS_NOTIFICATION_MAX_PACKET_SIZE,
+                            USB_BENCHMARK_CDC_RNDIS_NOTIFICATION_INTERVAL),
+    USB_DESCRIPTOR_INTERFACE(USB_BENCHMARK_CDC_RNDIS_DATA_INTERFACE, 0U, 2U, 0x0AU, 0x00U, 0x00U, 0U),
+    USB_DESCRIPTOR_ENDPOINT(USB_BENCHMARK_CDC_RNDIS_BULK_IN_ENDPOINT, USB_ENDPOINT_BULK,
+                            USB_BENCHMARK_BULK_MAX_PACKET_SIZE, 0U),
+    USB_DESCRIPTOR_ENDPOINT(USB_BENCHMARK_CDC_RNDIS_BULK_OUT_ENDPOINT, USB_ENDPOINT_BULK,
+                            USB_BENCHMARK_BULK_MAX_PACKET_SIZE, 0U))};
+
+static const usb_device_descriptor_entry_struct_t s_BenchmarkCdcRndisDescriptorEntries[] = {
+    {s_BenchmarkCdcRndisDeviceDescriptor, sizeof(s_BenchmarkCdcRndisDeviceDescriptor), 0U, USB_DESCRIPTOR_TYPE_DEVICE,
+     0U, USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+    {s_BenchmarkCdcRndisConfigurationDescriptor, sizeof(s_BenchmarkCdcRndisConfigurationDescriptor), 0U,
+     USB_DESCRIPTOR_TYPE_CONFIGURE, 0U, USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+};
+
+static const usb_device_descriptor_table_struct_t s_BenchmarkCdcRndisDescriptorTable = {
+    s_BenchmarkCdcRndisDescriptorEntries, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkCdcRndisDescriptorEntries)};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Device RNDIS callback, the Ethernet link of the device.
+ *
+ * @param handle The CDC ACM class handle.
+ * @param event  The RNDIS event.
+ * @param param  The usb_device_cdc_rndis_request_param_struct_t of the event.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkCdcRndisCallback(class_handle_t handle, uint32_t event, void *param)
+{
+    usb_device_cdc_rndis_request_param_struct_t *request = (usb_device_cdc_rndis_request_param_struct_t *)param;
+    usb_status_t error                                   = kStatus_USB_Success;
+
+    switch (event)
+    {
+        case kUSB_DeviceCdcEventAppGetLinkSpeed:
+            /* 480Mbps in the units of 100bps */
+            *((uint32_t *)((void *)request->buffer)) = 4800000U;
+            break;
+
+        case kUSB_DeviceCdcEventAppGetSendPacketSize:
+        case kUSB_DeviceCdcEventAppGetRecvPacketSize:
+            *((uint32_t *)((void *)request->buffer)) = USB_BENCHMARK_BULK_MAX_PACKET_SIZE;
+            break;
+
+        case kUSB_DeviceCdcEventAppGetMacAddress:
+            (void)memcpy(request->buffer, s_BenchmarkCdcRndisMacAddress, sizeof(s_BenchmarkCdcRndisMacAddress));
+            break;
+
+        case kUSB_DeviceCdcEventAppGetLinkStatus:
+            *((uint32_t *)((void *)request->buffer)) = 1U;
+            break;
+
+        case kUSB_DeviceCdcEventAppGetMaxFrameSize:
+            *((uint32_t *)((void *)request->buffer)) = USB_BENCHMARK_CDC_RNDIS_MAX_FRAME_SIZE;
+            break;
+
+        default:
+            error = kStatus_USB_InvalidRequest;
+            break;
+    }
+    return error;
+}
+
+/*!
+ * @brief Counts a message received on the bulk OUT endpoint.
+ *
+ * @param message The message.
+ * @param length  The message length.
+ */
+static void USB_BenchmarkCdcRndisReceive(uint8_t *message, uint32_t length)
+{
+    rndis_packet_msg_struct_t *packet = (rndis_packet_msg_struct_t *)((void *)message);
+
+    if ((length < sizeof(rndis_packet_msg_struct_t)) ||
+        (RNDIS_PACKET_MSG != USB_LONG_TO_LITTLE_ENDIAN(packet->messageType)) ||
+        (length != USB_LONG_TO_LITTLE_ENDIAN(packet->messageLength)) ||
+        ((length - sizeof(rndis_packet_msg_struct_t)) < USB_LONG_TO_LITTLE_ENDIAN(packet->dataLength)))
+    {
+        s_BenchmarkCdcRndisDevice.error = 1U;
+        return;
+    }
+    s_BenchmarkCdcRndisDevice.packets++;
+    s_BenchmarkCdcRndisDevice.bytes += USB_LONG_TO_LITTLE_ENDIAN(packet->dataLength);
+}
+
+/*!
+ * @brief Device CDC ACM class callback of the RNDIS function.
+ *
+ * The encapsulated commands are passed to the RNDIS function, the packet messages are counted and the bulk OUT
+ * endpoint is primed again.
+ *
+ * @param handle The CDC ACM class handle.
+ * @param event  The CDC ACM event.
+ * @param param  The event parameter.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkCdcRndisClassCallback(class_handle_t handle, uint32_t event, void *param)
+{
+    usb_device_cdc_acm_request_param_struct_t *request;
+    usb_device_endpoint_callback_message_struct_t *message;
+    usb_status_t error = kStatus_USB_Success;
+
+    switch (event)
+    {
+        case kUSB_DeviceCdcEventSendEncapsulatedCommand:
+            request = (usb_device_cdc_acm_request_param_struct_t *)param;
+            if (0U != request->isSetup)
+            {
+                if (*request->length > RNDIS_MAX_EXPECTED_COMMAND_SIZE)
+                {
+                    error = kStatus_USB_InvalidRequest;
+                }
+                else
+                {
+                    *request->buffer = s_BenchmarkCdcRndisDevice.rndisHandle->rndisCommand;
+                }
+            }
+            else
+            {
+                error = USB_DeviceCdcRndisMessageSet(s_BenchmarkCdcRndisDevice.rndisHandle, request->buffer,
+                                                     request->length);
+            }
+            break;
+
+        case kUSB_DeviceCdcEventGetEncapsulatedResponse:
+            request = (usb_device_cdc_acm_request_param_struct_t *)param;
+            error   = USB_DeviceCdcRndisMessageGet(s_BenchmarkCdcRndisDevice.rndisHandle, request->buffer,
+                                                   request->length);
+            break;
+
+        case kUSB_DeviceCdcEventRecvResponse:
+            message = (usb_device_endpoint_callback_message_struct_t *)param;
+            if (USB_CANCELLED_TRANSFER_LENGTH != message->length)
+            {
+                USB_BenchmarkCdcRndisReceive(message->buffer, message->length);
+                error = USB_DeviceCdcAcmRecv(handle,
+                                             USB_BENCHMARK_CDC_RNDIS_BULK_OUT_ENDPOINT & USB_ENDPOINT_NUMBER_MASK,
+                                             (uint8_t *)s_BenchmarkCdcRndisRecvBuffer,
+                                             sizeof(s_BenchmarkCdcRndisRecvBuffer));
+            }
+            break;
+
+        case kUSB_DeviceCdcEventSendResponse:
+        case kUSB_DeviceCdcEventSerialStateNotif:
+            break;
+
+        default:
+            error = kStatus_USB_InvalidRequest;
+            break;
+    }
+    return error;
+}
+
+/*!
+ * @brief Device callback, the bulk OUT endpoint is primed when the device is configured.
+ *
+ * @param handle The device handle.
+ * @param event  The device event.
+ * @param param  The event parameter.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkCdcRndisDeviceCallback(usb_device_handle handle, uint32_t event, void *param)
+{
+    usb_status_t error = USB_BenchmarkDeviceCallback(handle, event, param);
+
+    if ((kStatus_USB_Success == error) && ((uint32_t)kUSB_DeviceEventSetConfiguration == event) &&
+        (0U != *((uint8_t *)param)))
+    {
+        error = USB_DeviceCdcAcmRecv(s_BenchmarkCdcRndisConfig[0].classHandle,
+                                     USB_BENCHMARK_CDC_RNDIS_BULK_OUT_ENDPOINT & USB_ENDPOINT_NUMBER_MASK,
+                                     (uint8_t *)s_BenchmarkCdcRndisRecvBuffer, sizeof(s_BenchmarkCdcRndisRecvBuffer));
+    }
+    return error;
+}
+
+usb_status_t USB_BenchmarkCdcRndisDeviceStart(usb_benchmark_struct_t *benchmark)
+{
+    usb_device_cdc_rndis_config_struct_t rndisConfig;
+
+    s_BenchmarkCdcRndisDevice.rndisHandle = NULL;
+    s_BenchmarkCdcRndisDevice.packets     = 0U;
+    s_BenchmarkCdcRndisDevice.bytes       = 0U;
+    s_BenchmarkCdcRndisDevice.error       = 0U;
+
+    if (kStatus_USB_Success !=
+        USB_BenchmarkDeviceStart(benchmark, &s_BenchmarkCdcRndisConfigList, &s_BenchmarkCdcRndisDescriptorTable))
+    {
+        return kStatus_USB_Error;
+    }
+    /* The RNDIS function is created on the CDC ACM instance, the host sends no encapsulated command before the
+     * measurement starts */
+    rndisConfig.devMaxTxSize  = USB_BENCHMARK_CDC_RNDIS_MAX_FRAME_SIZE + sizeof(rndis_packet_msg_struct_t);
+    rndisConfig.rndisCallback = USB_BenchmarkCdcRndisCallback;
+    if (kStatus_USB_Success != USB_DeviceCdcRndisInit(s_BenchmarkCdcRndisConfig[0].classHandle, &rndisConfig,
+                                                      &s_BenchmarkCdcRndisDevice.rndisHandle))
+    {
+        (void)USB_BenchmarkDeviceStop(benchmark);
+        return kStatus_USB_Error;
+    }
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_BenchmarkCdcRndisDeviceStop(usb_benchmark_struct_t *benchmark)
+{
+    usb_status_t status = USB_BenchmarkDeviceStop(benchmark);
+
+    if (NULL != s_BenchmarkCdcRndisDevice.rndisHandle)
+    {
+        (void)USB_DeviceCdcRndisDeinit(s_BenchmarkCdcRndisDevice.rndisHandle);
+        s_BenchmarkCdcRndisDevice.rndisHandle = NULL;
+    }
+    return status;
+}
+
+usb_status_t USB_BenchmarkCdcRndisDeviceGetCount(uint32_t *packets, uint32_t *bytes)
+{
+    usb_status_t status = (0U != s_BenchmarkCdcRndisDevice.error) ? kStatus_USB_Error : kStatus_USB_Success;
+
+    *packets                          = s_BenchmarkCdcRndisDevice.packets;
+    *bytes                            = s_BenchmarkCdcRndisDevice.bytes;
+    s_BenchmarkCdcRndisDevice.packets = 0U;
+    s_BenchmarkCdcRndisDevice.bytes   = 0U;
+    s_BenchmarkCdcRndisDevice.error   = 0U;
+    return status;
+}
+
+#endif /* USB_DEVICE_CONFIG_CDC_RNDIS && USB_HOST_CONFIG_CDC_RNDIS */
@@ -0,0 +1,386 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_benchmark.h"
+
+#if ((defined(USB_DEVICE_CONFIG_HID)) && (USB_DEVICE_CONFIG_HID > 0U) && (defined(USB_HOST_CONFIG_HID)) && \
+     (USB_HOST_CONFIG_HID > 0U))
+#include "usb_device_hid.h"
+#include "usb_host_hid.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The reports of each measurement */
+#ifndef USB_BENCHMARK_HID_REPORTS
+#define USB_BENCHMARK_HID_REPORTS (1024U)
+#endif
+
+/*! @brief The largest report, the max packet size of the interrupt IN endpoint */
+#define USB_BENCHMARK_HID_MAX_REPORT (64U)
+
+#define USB_BENCHMARK_HID_INTERFACE (0U)
+#define USB_BENCHMARK_HID_INTERRUPT_IN_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(1U, USB_IN)
+/*! @brief The polling interval, each (micro)frame */
+#define USB_BENCHMARK_HID_INTERVAL (1U)
+
+/*! @brief The HID measurement state */
+typedef struct _usb_benchmark_hid_struct
+{
+    usb_benchmark_struct_t *benchmark; /*!< The benchmark instance */
+    usb_host_class_handle classHandle; /*!< The host HID instance */
+    class_handle_t deviceHandle;       /*!< The device HID instance */
+    uint64_t sendTime;                 /*!< The bus time when the device sent the report */
+    uint64_t latency;                  /*!< The sum of the report latencies */
+    uint64_t maxLatency;               /*!< The largest report latency */
+    uint32_t reportLength;             /*!< The bytes of each report */
+    uint32_t remaining;                /*!< The reports to send */
+    uint32_t reports;                  /*!< The reports received by the host */
+    uint32_t bytes;                    /*!< The bytes received by the host */
+    volatile uint8_t done;             /*!< The measurement is done */
+    uint8_t hostReceived;              /*!< The host received the last report */
+    uint8_t deviceSent;                /*!< The device completed the last report */
+    usb_status_t status;               /*!< The first error of the measurement */
+} usb_benchmark_hid_struct_t;
+
+/*! @brief The report size of one HID measurement */
+typedef struct _usb_benchmark_hid_size_struct
+{
+    uint32_t reportLength; /*!< The bytes of each report */
+    const char *name;      /*!< The measurement name */
+} usb_benchmark_hid_size_struct_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static usb_status_t USB_BenchmarkHidClassCallback(class_handle_t handle, uint32_t event, void *param);
+static void USB_BenchmarkHidCallback(void *param, uint8_t *data, uint32_t dataLen, usb_status_t status);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The report of the device */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t s_BenchmarkHidReport[USB_BENCHMARK_HID_MAX_REPORT];
+/* The receive buffer of the host, also the report descriptor read by the host */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t s_BenchmarkHidBuffer[USB_BENCHMARK_HID_MAX_REPORT];
+
+static usb_benchmark_hid_struct_t s_BenchmarkHid;
+
+static const usb_benchmark_hid_size_struct_t s_BenchmarkHidSizes[] = {
+    {8U, "HID report 8B"},
+    {USB_BENCHMARK_HID_MAX_REPORT, "HID report 64B"},
+};
+
+/* A vendor defined input report of up to 64 bytes */
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkHidReportDescriptor[] = {
+    0x06U, 0x00U, 0xFFU, /* Usage Page (Vendor Defined 0xFF00) */
+    0x09U, 0x01U,        /* Usage (0x01) */
+    0xA1U, 0x01U,        /* Collection (Application) */
+    0x09U, 0x02U,        /*   Usage (0x02) */
+    0x15U, 0x00U,        /*   Logical Minimum (0) */
+    0x26U, 0xFFU, 0x00U, /*   Logical Maximum (255) */
+    0x75U, 0x08U,        /*   Report Size (8) */
+    0x95U, USB_BENCHMARK_HID_MAX_REPORT, /*   Report Count (64) */
+    0x81U, 0x02U,        /*   Input (Data, Variable, Absolute) */
+    0xC0U,               /* End Collection */
+};
+
+static usb_device_endpoint_struct_t s_BenchmarkHidEndpoints[] = {
+    {USB_BENCHMARK_HID_INTERRUPT_IN_ENDPOINT, USB_ENDPOINT_INTERRUPT, USB_BENCHMARK_HID_MAX_REPORT,
+     USB_BENCHMARK_HID_INTERVAL},
+};
+
+static usb_device_interface_struct_t s_BenchmarkHidInterface[] = {
+    {0U, {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkHidEndpoints), s_BenchmarkHidEndpoints}, NULL},
+};
+
+static usb_device_interfaces_struct_t s_BenchmarkHidInterfaces[] = {
+    {0x03U, 0x00U, 0x00U, USB_BENCHMARK_HID_INTERFACE, s_BenchmarkHidInterface,
+     USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkHidInterface)},
+};
+
+static usb_device_interface_list_t s_BenchmarkHidInterfaceList[] = {
+    {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkHidInterfaces), s_BenchmarkHidInterfaces},
+};
+
+static usb_device_class_struct_t s_BenchmarkHidClass = {s_BenchmarkHidInterfaceList, kUSB_DeviceClassTypeHid, 1U};
+
+static usb_device_class_config_struct_t s_BenchmarkHidConfig[] = {
+    {USB_BenchmarkHidClassCallback, (class_handle_t)NULL, &s_BenchmarkHidClass},
+};
+
+static usb_device_class_config_list_struct_t s_BenchmarkHidConfigList = {
+    s_BenchmarkHidConfig, USB_BenchmarkDeviceCallback, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkHidConfig)};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkHidDeviceDescriptor[] = {USB_DESCRIPTOR_DEVICE(
+    0x0200U, 0x00U, 0x00U, 0x00U, USB_CONTROL_MAX_PACKET_SIZE, 0x1FC9U, 0x0103U, 0x0101U, 0U, 0U, 0U, 1U)};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkHidConfigurationDescriptor[] = {USB_DESCRIPTOR_CONFIGURATION(
+    1U, 1U, 0U, 0xC0U, 50U, USB_DESCRIPTOR_INTERFACE(USB_BENCHMARK_HID_INTERFACE, 0U, 1U, 0x03U, 0x00U, 0x00U, 0U),
+    USB_DESCRIPTOR_HID(0x0111U, 0U, sizeof(s_BenchmarkHidReportDescriptor)),
+    USB_DESCRIPTOR_ENDPOINT(USB_BENCHMARK_HID_INTERRUPT_IN_ENDPOINT, USB_ENDPOINT_INTERRUPT,
+                            USB_BENCHMARK_HID_MAX_REPORT, USB_BENCHMARK_HID_INTERVAL))};
+
+static const usb_device_descriptor_entry_struct_t s_BenchmarkHidDescriptorEntries[] = {
+    {s_BenchmarkHidDeviceDescriptor, sizeof(s_BenchmarkHidDeviceDescriptor), 0U, USB_DESCRIPTOR_TYPE_DEVICE, 0U,
+     USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+    {s_BenchmarkHidConfigurationDescriptor, sizeof(s_BenchmarkHidConfigurationDescriptor), 0U,
+     USB_DESCRIPTOR_TYPE_CONFIGURE, 0U, USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+    {s_BenchmarkHidReportDescriptor, sizeof(s_BenchmarkHidReportDescriptor), USB_BENCHMARK_HID_INTERFACE,
+     USB_DESCRIPTOR_TYPE_HID_REPORT, 0U, USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+};
+
+static const usb_device_descriptor_table_struct_t s_BenchmarkHidDescriptorTable = {
+    s_BenchmarkHidDescriptorEntries, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkHidDescriptorEntries)};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Sends the next report when the host received the last one and the device completed it.
+ *
+ * The report latency is the bus time from the send call of the device to the receive callback of the host.
+ *
+ * @param hid The HID measurement state.
+ */
+static void USB_BenchmarkHidNext(usb_benchmark_hid_struct_t *hid)
+{
+    usb_status_t status;
+
+    if ((0U == hid->hostReceived) || (0U == hid->deviceSent))
+    {
+        return;
+    }
+    if (0U == hid->remaining)
+    {
+        hid->done = 1U;
+        return;
+    }
+    hid->remaining--;
+    hid->hostReceived = 0U;
+    hid->deviceSent   = 0U;
+    hid->sendTime     = USB_BenchmarkGetBusTime(hid->benchmark);
+    status = USB_DeviceHidSend(hid->deviceHandle, USB_BENCHMARK_HID_INTERRUPT_IN_ENDPOINT & USB_ENDPOINT_NUMBER_MASK,
+                               s_BenchmarkHidReport, hid->reportLength);
+    if (kStatus_USB_Success != status)
+    {
+        hid->status = status;
+        hid->done   = 1U;
+    }
+}
+
+/*!
+ * @brief Device HID class callback.
+ *
+ * @param handle The HID class handle.
+ * @param event  The HID event.
+ * @param param  The event parameter.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkHidClassCallback(class_handle_t handle, uint32_t event, void *param)
+{
+    usb_device_endpoint_callback_message_struct_t *message;
+    usb_status_t error = kStatus_USB_Success;
+
+    switch (event)
+    {
+        case kUSB_DeviceHidEventSendResponse:
+            message = (usb_device_endpoint_callback_message_struct_t *)param;
+            if (USB_CANCELLED_TRANSFER_LENGTH != message->length)
+            {
+                s_BenchmarkHid.deviceSent = 1U;
+                USB_BenchmarkHidNext(&s_BenchmarkHid);
+            }
+            break;
+
+        case kUSB_DeviceHidEventSetIdle:
+        case kUSB_DeviceHidEventSetProtocol:
+            break;
+
+        default:
+            error = kStatus_USB_InvalidRequest;
+            break;
+    }
+    return error;
+}
+
+/*!
+ * @brief Host HID receive callback, the report latency is recorded and the next report is received.
+ *
+ * @param param   The HID measurement state.
+ * @param data    The data buffer.
+ * @param dataLen The data length.
+ * @param status  The transfer status.
+ */
+static void USB_BenchmarkHidCallback(void *param, uint8_t *data, uint32_t dataLen, usb_status_t status)
+{
+    usb_benchmark_hid_struct_t *hid = (usb_benchmark_hid_struct_t *)param;
+    uint64_t latency;
+
+    if ((kStatus_USB_Success != status) || (dataLen != hid->reportLength))
+    {
+        hid->status = kStatus_USB_Error;
+        hid->done   = 1U;
+        return;
+    }
+    latency = USB_BenchmarkGetBusTime(hid->benchmark) - hid->sendTime;
+    hid->latency += latency;
+    if (latency > hid->maxLatency)
+    {
+        hid->maxLatency = latency;
+    }
+    hid->reports++;
+    hid->bytes += dataLen;
+    if (0U != hid->remaining)
+    {
+        status = USB_HostHidRecv(hid->classHandle, s_BenchmarkHidBuffer, sizeof(s_BenchmarkHidBuffer),
+                                 USB_BenchmarkHidCallback, hid);
+        if (kStatus_USB_Success != status)
+        {
+            hid->status = status;
+            hid->done   = 1U;
+            return;
+        }
+    }
+    hid->hostReceived = 1U;
+    USB_BenchmarkHidNext(hid);
+}
+
+/*!
+ * @brief Runs one HID measurement.
+ *
+ * Each report is sent when the last one is received, the measurement is the report latency and the report rate.
+ *
+ * @param benchmark The benchmark instance.
+ * @param hid       The HID measurement state.
+ * @param size      The report size.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkHidMeasure(usb_benchmark_struct_t *benchmark,
+                                            usb_benchmark_hid_struct_t *hid,
+                                            const usb_benchmark_hid_size_struct_t *size)
+{
+    usb_benchmark_result_t result;
+    uint32_t startCycles;
+    uint32_t averageLatency;
+    uint32_t maxLatency;
+
+    hid->reportLength = size->reportLength;
+    hid->remaining    = USB_BENCHMARK_HID_REPORTS;
+    hid->reports      = 0U;
+    hid->bytes        = 0U;
+    hid->latency      = 0U;
+    hid->maxLatency   = 0U;
+    hid->done         = 0U;
+    hid->hostReceived = 1U;
+    hid->deviceSent   = 1U;
+    hid->status       = kStatus_USB_Success;
+
+    USB_BenchmarkStart(benchmark);
+    /* The first receive and the first report are issued here, the others by the completion callbacks */
+    startCycles = USB_BENCHMARK_CYCLES();
+    hid->status = USB_HostHidRecv(hid->classHandle, s_BenchmarkHidBuffer, sizeof(s_BenchmarkHidBuffer),
+                                  USB_BenchmarkHidCallback, hid);
+    if (kStatus_USB_Success == hid->status)
+    {
+        USB_BenchmarkHidNext(hid);
+    }
+    benchmark->callCycles += (uint32_t)(USB_BENCHMARK_CYCLES() - startCycles);
+    if ((kStatus_USB_Success != hid->status) ||
+        (kStatus_USB_Success !=
+         USB_BenchmarkWait(benchmark, &hid->done, (USB_BENCHMARK_HID_REPORTS + 1U) * USB_BENCHMARK_TIMEOUT_FRAMES)) ||
+        (kStatus_USB_Success != hid->status) || (USB_BENCHMARK_HID_REPORTS != hid->reports))
+    {
+        usb_echo("HID report error\r\n");
+        return kStatus_USB_Error;
+    }
+    USB_BenchmarkStop(benchmark, &result);
+    result.transfers = hid->reports;
+    result.bytes     = hid->bytes;
+    USB_BenchmarkPrint(size->name, &result);
+    /* The latencies in nanoseconds, the bus time is in picoseconds */
+    averageLatency = (uint32_t)(hid->latency / hid->reports / 1000U);
+    maxLatency     = (uint32_t)(hid->maxLatency / 1000U);
+    usb_echo("%-24s %8u reports/s latency %5u.%03u us average %5u.%03u us max\r\n", size->name,
+             USB_BenchmarkRate(result.transfers, result.busTime), averageLatency / 1000U, averageLatency % 1000U,
+             maxLatency / 1000U, maxLatency % 1000U);
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_BenchmarkHid(usb_benchmark_struct_t *benchmark)
+{
+    usb_benchmark_hid_struct_t *hid = &s_BenchmarkHid;
+    usb_host_interface_handle interfaceHandle;
+    usb_status_t status = kStatus_USB_Error;
+    uint32_t index;
+
+    if (kStatus_USB_Success !=
+        USB_BenchmarkDeviceStart(benchmark, &s_BenchmarkHidConfigList, &s_BenchmarkHidDescriptorTable))
+    {
+        usb_echo("HID enumeration error\r\n");
+        return kStatus_USB_Error;
+    }
+    hid->benchmark    = benchmark;
+    hid->deviceHandle = s_BenchmarkHidConfig[0].classHandle;
+
+    interfaceHandle = USB_BenchmarkGetInterface(benchmark, 0x03U, 0x00U);
+    if ((NULL != interfaceHandle) &&
+        (kStatus_USB_Success == USB_HostHidInit(benchmark->attachedDeviceHandle, &hid->classHandle)) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark, USB_HostHidSetInterface(hid->classHandle, interfaceHandle, 0U,
+                                                                     USB_BenchmarkRequestCallback, benchmark))) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark, USB_HostHidGetReportDescriptor(
+                                                 hid->classHandle, s_BenchmarkHidBuffer,
+                                                 sizeof(s_BenchmarkHidReportDescriptor),
+                                                 USB_BenchmarkRequestCallback, benchmark))) &&
+        (0 == memcmp(s_BenchmarkHidBuffer, s_BenchmarkHidReportDescriptor, sizeof(s_BenchmarkHidReportDescriptor))))
+    {
+        status = kStatus_USB_Success;
+        for (index = 0U; index < sizeof(s_BenchmarkHidReport); index++)
+        {
+            s_BenchmarkHidReport[index] = (uint8_t)index;
+        }
+        for (index = 0U;
+             (kStatus_USB_Success == status) && (index < USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkHidSizes)); index++)
+        {
+            status = USB_BenchmarkHidMeasure(benchmark, hid, &s_BenchmarkHidSizes[index]);
+        }
+    }
+    else
+    {
+        usb_echo("HID host class error\r\n");
+    }
+
+    if (kStatus_USB_Success != USB_BenchmarkDeviceStop(benchmark))
+    {
+        status = kStatus_USB_Error;
+    }
+    if (NULL != hid->classHandle)
+    {
+        (void)USB_HostHidDeinit(benchmark->attachedDeviceHandle, hid->classHandle);
+        hid->classHandle = NULL;
+    }
+    else
+    {
+        (void)USB_HostCloseDeviceInterface(benchmark->attachedDeviceHandle, NULL);
+    }
+    return status;
+}
+
+#endif /* USB_DEVICE_CONFIG_HID && USB_HOST_CONFIG_HID */
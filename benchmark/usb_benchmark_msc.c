@@ -0,0 +1,355 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_benchmark.h"
+
+#if ((defined(USB_DEVICE_CONFIG_MSC)) && (USB_DEVICE_CONFIG_MSC > 0U) && (defined(USB_HOST_CONFIG_MSD)) && \
+     (USB_HOST_CONFIG_MSD > 0U))
+#include "usb_device_msc.h"
+#include "usb_host_msd.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The block size of the RAM disk */
+#define USB_BENCHMARK_MSC_BLOCK_SIZE (512U)
+
+/*! @brief The block count of the RAM disk (32KB), it is also the largest block count of one command */
+#define USB_BENCHMARK_MSC_BLOCK_COUNT (64U)
+
+/*! @brief The bytes moved by each measurement */
+#ifndef USB_BENCHMARK_MSC_BYTES
+#define USB_BENCHMARK_MSC_BYTES (2U * 1024U * 1024U)
+#endif
+
+#define USB_BENCHMARK_MSC_INTERFACE (0U)
+#define USB_BENCHMARK_MSC_BULK_IN_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(1U, USB_IN)
+#define USB_BENCHMARK_MSC_BULK_OUT_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(2U, USB_OUT)
+
+/*! @brief The MSC measurement state */
+typedef struct _usb_benchmark_msc_struct
+{
+    usb_host_class_handle classHandle; /*!< The host MSD instance */
+    uint32_t blockNumber;              /*!< The blocks of each command */
+    uint32_t remaining;                /*!< The commands to issue */
+    uint32_t commands;                 /*!< The completed commands */
+    uint8_t write;                     /*!< WRITE(10) or READ(10) */
+    volatile uint8_t done;             /*!< The measurement or the request is done */
+    usb_status_t status;               /*!< The first error of the measurement */
+} usb_benchmark_msc_struct_t;
+
+/*! @brief The command size of one MSC measurement */
+typedef struct _usb_benchmark_msc_size_struct
+{
+    uint32_t blockNumber;  /*!< The blocks of each command */
+    const char *writeName; /*!< The name of the WRITE(10) measurement */
+    const char *readName;  /*!< The name of the READ(10) measurement */
+} usb_benchmark_msc_size_struct_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static usb_status_t USB_BenchmarkMscClassCallback(class_handle_t handle, uint32_t event, void *param);
+static void USB_BenchmarkMscCallback(void *param, uint8_t *data, uint32_t dataLen, usb_status_t status);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The RAM disk of the device */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t s_BenchmarkMscDisk[USB_BENCHMARK_MSC_BLOCK_COUNT * USB_BENCHMARK_MSC_BLOCK_SIZE];
+/* The data buffer of the host */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t s_BenchmarkMscBuffer[USB_BENCHMARK_MSC_BLOCK_COUNT * USB_BENCHMARK_MSC_BLOCK_SIZE];
+
+static usb_benchmark_msc_struct_t s_BenchmarkMsc;
+
+/* The block counts of one command and the measurement names */
+static const usb_benchmark_msc_size_struct_t s_BenchmarkMscSizes[] = {
+    {1U, "MSC WRITE10 512B", "MSC READ10 512B"},
+    {8U, "MSC WRITE10 4KB", "MSC READ10 4KB"},
+    {USB_BENCHMARK_MSC_BLOCK_COUNT, "MSC WRITE10 32KB", "MSC READ10 32KB"},
+};
+
+static usb_device_endpoint_struct_t s_BenchmarkMscEndpoints[] = {
+    {USB_BENCHMARK_MSC_BULK_IN_ENDPOINT, USB_ENDPOINT_BULK, USB_BENCHMARK_BULK_MAX_PACKET_SIZE, 0U},
+    {USB_BENCHMARK_MSC_BULK_OUT_ENDPOINT, USB_ENDPOINT_BULK, USB_BENCHMARK_BULK_MAX_PACKET_SIZE, 0U},
+};
+
+static usb_device_interface_struct_t s_BenchmarkMscInterface[] = {
+    {0U, {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkMscEndpoints), s_BenchmarkMscEndpoints}, NULL},
+};
+
+static usb_device_interfaces_struct_t s_BenchmarkMscInterfaces[] = {
+    {0x08U, 0x06U, 0x50U, USB_BENCHMARK_MSC_INTERFACE, s_BenchmarkMscInterface,
+     USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkMscInterface)},
+};
+
+static usb_device_interface_list_t s_BenchmarkMscInterfaceList[] = {
+    {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkMscInterfaces), s_BenchmarkMscInterfaces},
+};
+
+static usb_device_class_struct_t s_BenchmarkMscClass = {s_BenchmarkMscInterfaceList, kUSB_DeviceClassTypeMsc, 1U};
+
+static usb_device_class_config_struct_t s_BenchmarkMscConfig[] = {
+    {USB_BenchmarkMscClassCallback, (class_handle_t)NULL, &s_BenchmarkMscClass},
+};
+
+static usb_device_class_config_list_struct_t s_BenchmarkMscConfigList = {
+    s_BenchmarkMscConfig, USB_BenchmarkDeviceCallback, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkMscConfig)};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkMscDeviceDescriptor[] = {USB_DESCRIPTOR_DEVICE(
+    0x0200U, 0x00U, 0x00U, 0x00U, USB_CONTROL_MAX_PACKET_SIZE, 0x1FC9U, 0x0100U, 0x0101U, 0U, 0U, 0U, 1U)};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkMscConfigurationDescriptor[] = {USB_DESCRIPTOR_CONFIGURATION(
+    1U, 1U, 0U, 0xC0U, 50U,
+    USB_DESCRIPTOR_INTERFACE(USB_BENCHMARK_MSC_INTERFACE, 0U, 2U, 0x08U, 0x06U, 0x50U, 0U),
+    USB_DESCRIPTOR_ENDPOINT(USB_BENCHMARK_MSC_BULK_IN_ENDPOINT, USB_ENDPOINT_BULK, USB_BENCHMARK_BULK_MAX_PACKET_SIZE,
+                            0U),
+    USB_DESCRIPTOR_ENDPOINT(USB_BENCHMARK_MSC_BULK_OUT_ENDPOINT, USB_ENDPOINT_BULK, USB_BENCHMARK_BULK_MAX_PACKET_SIZE,
+                            0U))};
+
+static const usb_device_descriptor_entry_struct_t s_BenchmarkMscDescriptorEntries[] = {
+    {s_BenchmarkMscDeviceDescriptor, sizeof(s_BenchmarkMscDeviceDescriptor), 0U, USB_DESCRIPTOR_TYPE_DEVICE, 0U,
+     USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+    {s_BenchmarkMscConfigurationDescriptor, sizeof(s_BenchmarkMscConfigurationDescriptor), 0U,
+     USB_DESCRIPTOR_TYPE_CONFIGURE, 0U, USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+};
+
+static const usb_device_descriptor_table_struct_t s_BenchmarkMscDescriptorTable = {
+    s_BenchmarkMscDescriptorEntries, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkMscDescriptorEntries)};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Device MSC class callback, a RAM disk.
+ *
+ * The READ(10) and WRITE(10) data is sent from and received to the disk without a copy.
+ *
+ * @param handle The MSC class handle.
+ * @param event  The MSC event.
+ * @param param  The event parameter.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkMscClassCallback(class_handle_t handle, uint32_t event, void *param)
+{
+    usb_device_lba_information_struct_t *lbaInformation;
+    usb_device_lba_app_struct_t *lba;
+    usb_status_t error = kStatus_USB_Success;
+
+    switch (event)
+    {
+        case kUSB_DeviceMscEventGetLbaInformation:
+            lbaInformation                             = (usb_device_lba_information_struct_t *)param;
+            lbaInformation->logicalUnitNumberSupported = 1U;
+            lbaInformation->logicalUnitInformations[0].totalLbaNumberSupports = USB_BENCHMARK_MSC_BLOCK_COUNT;
+            lbaInformation->logicalUnitInformations[0].lengthOfEachLba        = USB_BENCHMARK_MSC_BLOCK_SIZE;
+            lbaInformation->logicalUnitInformations[0].bulkInBufferSize       = sizeof(s_BenchmarkMscDisk);
+            lbaInformation->logicalUnitInformations[0].bulkOutBufferSize      = sizeof(s_BenchmarkMscDisk);
+            break;
+
+        case kUSB_DeviceMscEventReadRequest:
+        case kUSB_DeviceMscEventWriteRequest:
+            lba         = (usb_device_lba_app_struct_t *)param;
+            lba->buffer = &s_BenchmarkMscDisk[lba->offset * USB_BENCHMARK_MSC_BLOCK_SIZE];
+            break;
+
+        case kUSB_DeviceMscEventReadResponse:
+        case kUSB_DeviceMscEventWriteResponse:
+        case kUSB_DeviceMscEventTestUnitReady:
+            break;
+
+        default:
+            error = kStatus_USB_InvalidRequest;
+            break;
+    }
+    return error;
+}
+
+/*!
+ * @brief Issues the next command of the measurement.
+ *
+ * @param msc The MSC measurement state.
+ */
+static void USB_BenchmarkMscIssue(usb_benchmark_msc_struct_t *msc)
+{
+    usb_status_t status;
+    uint32_t blockAddress;
+
+    if (0U == msc->remaining)
+    {
+        msc->done = 1U;
+        return;
+    }
+    msc->remaining--;
+    /* The commands walk the disk */
+    blockAddress = (msc->commands * msc->blockNumber) % USB_BENCHMARK_MSC_BLOCK_COUNT;
+    if (0U != msc->write)
+    {
+        status = USB_HostMsdWrite10(msc->classHandle, 0U, blockAddress, s_BenchmarkMscBuffer,
+                                    msc->blockNumber * USB_BENCHMARK_MSC_BLOCK_SIZE, msc->blockNumber,
+                                    USB_BenchmarkMscCallback, msc);
+    }
+    else
+    {
+        status = USB_HostMsdRead10(msc->classHandle, 0U, blockAddress, s_BenchmarkMscBuffer,
+                                   msc->blockNumber * USB_BENCHMARK_MSC_BLOCK_SIZE, msc->blockNumber,
+                                   USB_BenchmarkMscCallback, msc);
+    }
+    if (kStatus_USB_Success != status)
+    {
+        msc->status = status;
+        msc->done   = 1U;
+    }
+}
+
+/*!
+ * @brief Host MSD callback, the next command is issued until the measurement is done.
+ *
+ * @param param   The MSC measurement state.
+ * @param data    The data buffer.
+ * @param dataLen The data length.
+ * @param status  The command status.
+ */
+static void USB_BenchmarkMscCallback(void *param, uint8_t *data, uint32_t dataLen, usb_status_t status)
+{
+    usb_benchmark_msc_struct_t *msc = (usb_benchmark_msc_struct_t *)param;
+
+    if (kStatus_USB_Success != status)
+    {
+        msc->status = status;
+        msc->done   = 1U;
+        return;
+    }
+    msc->commands++;
+    USB_BenchmarkMscIssue(msc);
+}
+
+/*!
+ * @brief Runs one MSC measurement.
+ *
+ * @param benchmark   The benchmark instance.
+ * @param msc         The MSC measurement state.
+ * @param write       WRITE(10) or READ(10).
+ * @param size        The command size.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkMscMeasure(usb_benchmark_struct_t *benchmark,
+                                            usb_benchmark_msc_struct_t *msc,
+                                            uint8_t write,
+                                            const usb_benchmark_msc_size_struct_t *size)
+{
+    usb_benchmark_result_t result;
+    uint32_t startCycles;
+    uint32_t frames;
+
+    msc->write       = write;
+    msc->blockNumber = size->blockNumber;
+    msc->remaining   = USB_BENCHMARK_MSC_BYTES / (size->blockNumber * USB_BENCHMARK_MSC_BLOCK_SIZE);
+    frames           = (msc->remaining + 1U) * USB_BENCHMARK_TIMEOUT_FRAMES;
+    msc->commands    = 0U;
+    msc->done        = 0U;
+    msc->status      = kStatus_USB_Success;
+
+    USB_BenchmarkStart(benchmark);
+    /* The first command is issued here, the others by the completion callback */
+    startCycles = USB_BENCHMARK_CYCLES();
+    USB_BenchmarkMscIssue(msc);
+    benchmark->callCycles += (uint32_t)(USB_BENCHMARK_CYCLES() - startCycles);
+    if ((kStatus_USB_Success != USB_BenchmarkWait(benchmark, &msc->done, frames)) ||
+        (kStatus_USB_Success != msc->status))
+    {
+        usb_echo("MSC %s error\r\n", (0U != write) ? "WRITE10" : "READ10");
+        return kStatus_USB_Error;
+    }
+    USB_BenchmarkStop(benchmark, &result);
+    result.transfers = msc->commands;
+    result.bytes     = msc->commands * size->blockNumber * USB_BENCHMARK_MSC_BLOCK_SIZE;
+    USB_BenchmarkPrint((0U != write) ? size->writeName : size->readName, &result);
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_BenchmarkMsc(usb_benchmark_struct_t *benchmark)
+{
+    usb_benchmark_msc_struct_t *msc = &s_BenchmarkMsc;
+    usb_host_interface_handle interfaceHandle;
+    usb_status_t status = kStatus_USB_Error;
+    uint32_t index;
+    uint32_t sizeIndex;
+
+    if (kStatus_USB_Success !=
+        USB_BenchmarkDeviceStart(benchmark, &s_BenchmarkMscConfigList, &s_BenchmarkMscDescriptorTable))
+    {
+        usb_echo("MSC enumeration error\r\n");
+        return kStatus_USB_Error;
+    }
+
+    interfaceHandle = USB_BenchmarkGetInterface(benchmark, 0x08U, 0x06U);
+    if ((NULL != interfaceHandle) &&
+        (kStatus_USB_Success == USB_HostMsdInit(benchmark->attachedDeviceHandle, &msc->classHandle)) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark, USB_HostMsdSetInterface(msc->classHandle, interfaceHandle, 0U,
+                                                                     USB_BenchmarkRequestCallback, benchmark))))
+    {
+        status = kStatus_USB_Success;
+        for (index = 0U; index < sizeof(s_BenchmarkMscBuffer); index++)
+        {
+            s_BenchmarkMscBuffer[index] = (uint8_t)(index * 7U + 1U);
+        }
+        for (sizeIndex = 0U;
+             (kStatus_USB_Success == status) && (sizeIndex < USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkMscSizes));
+             sizeIndex++)
+        {
+            status = USB_BenchmarkMscMeasure(benchmark, msc, 1U, &s_BenchmarkMscSizes[sizeIndex]);
+        }
+        for (sizeIndex = 0U;
+             (kStatus_USB_Success == status) && (sizeIndex < USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkMscSizes));
+             sizeIndex++)
+        {
+            status = USB_BenchmarkMscMeasure(benchmark, msc, 0U, &s_BenchmarkMscSizes[sizeIndex]);
+        }
+        /* The last read command got the whole disk, it is the data written */
+        for (index = 0U; (kStatus_USB_Success == status) && (index < sizeof(s_BenchmarkMscBuffer)); index++)
+        {
+            if (s_BenchmarkMscBuffer[index] != (uint8_t)(index * 7U + 1U))
+            {
+                usb_echo("MSC data error\r\n");
+                status = kStatus_USB_Error;
+            }
+        }
+    }
+    else
+    {
+        usb_echo("MSC host class error\r\n");
+    }
+
+    if (kStatus_USB_Success != USB_BenchmarkDeviceStop(benchmark))
+    {
+        status = kStatus_USB_Error;
+    }
+    if (NULL != msc->classHandle)
+    {
+        (void)USB_HostMsdDeinit(benchmark->attachedDeviceHandle, msc->classHandle);
+        msc->classHandle = NULL;
+    }
+    else
+    {
+        (void)USB_HostCloseDeviceInterface(benchmark->attachedDeviceHandle, NULL);
+    }
+    return status;
+}
+
+#endif /* USB_DEVICE_CONFIG_MSC && USB_HOST_CONFIG_MSD */
@@ -0,0 +1,532 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_benchmark.h"
+
+#if ((defined(USB_DEVICE_CONFIG_VIDEO)) && (USB_DEVICE_CONFIG_VIDEO > 0U) && (defined(USB_HOST_CONFIG_VIDEO)) && \
+     (USB_HOST_CONFIG_VIDEO > 0U))
+#include "usb_device_video.h"
+#include "usb_host_video.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The frames of the measurement */
+#ifndef USB_BENCHMARK_VIDEO_FRAMES
+#define USB_BENCHMARK_VIDEO_FRAMES (32U)
+#endif
+
+/*! @brief The ISO IN transfers the host keeps in flight */
+#ifndef USB_BENCHMARK_VIDEO_TRANSFERS
+#define USB_BENCHMARK_VIDEO_TRANSFERS (4U)
+#endif
+
+/*! @brief The frame, 320x240 YUY2 */
+#define USB_BENCHMARK_VIDEO_WIDTH (320U)
+#define USB_BENCHMARK_VIDEO_HEIGHT (240U)
+#define USB_BENCHMARK_VIDEO_FRAME_SIZE (USB_BENCHMARK_VIDEO_WIDTH * USB_BENCHMARK_VIDEO_HEIGHT * 2U)
+/*! @brief The frame interval in 100ns units, 30 fps */
+#define USB_BENCHMARK_VIDEO_FRAME_INTERVAL (333333U)
+
+/*! @brief The maximum packet size of the ISO IN endpoint, one packet each (micro)frame */
+#if (USB_SPEED_HIGH == USB_HOST_LOOPBACK_BUS_SPEED)
+#define USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE (1024U)
+#else
+#define USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE (1023U)
+#endif
+
+/*! @brief The payload header, bHeaderLength and bmHeaderInfo */
+#define USB_BENCHMARK_VIDEO_HEADER_LENGTH (2U)
+#define USB_BENCHMARK_VIDEO_HEADER_FID (0x01U)
+#define USB_BENCHMARK_VIDEO_HEADER_EOF (0x02U)
+#define USB_BENCHMARK_VIDEO_HEADER_EOH (0x80U)
+
+#define USB_BENCHMARK_VIDEO_CONTROL_INTERFACE (0U)
+#define USB_BENCHMARK_VIDEO_STREAM_INTERFACE (1U)
+#define USB_BENCHMARK_VIDEO_ISO_IN_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(1U, USB_IN)
+#define USB_BENCHMARK_VIDEO_INPUT_TERMINAL_ID (1U)
+#define USB_BENCHMARK_VIDEO_OUTPUT_TERMINAL_ID (2U)
+
+/*! @brief The camera input terminal and the USB streaming output terminal of the video control interface */
+#define USB_BENCHMARK_VIDEO_CONTROL_UNITS                                                                         \
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x02U,                            \
+                                  USB_BENCHMARK_VIDEO_INPUT_TERMINAL_ID, USB_DESCRIPTOR_WORD(0x0201U), 0x00U, 0U, \
+                                  USB_DESCRIPTOR_WORD(0U), USB_DESCRIPTOR_WORD(0U), USB_DESCRIPTOR_WORD(0U), 3U,  \
+                                  0x00U, 0x00U, 0x00U),                                                           \
+        USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x03U,                        \
+                                      USB_BENCHMARK_VIDEO_OUTPUT_TERMINAL_ID, USB_DESCRIPTOR_WORD(0x0101U),       \
+                                      0x00U, USB_BENCHMARK_VIDEO_INPUT_TERMINAL_ID, 0U)
+
+/*! @brief The uncompressed YUY2 format and its frame of the video streaming interface */
+#define USB_BENCHMARK_VIDEO_STREAM_FORMATS                                                                          \
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x04U, 1U, 1U, 0x59U, 0x55U, 0x59U, \
+                                  0x32U, 0x00U, 0x00U, 0x10U, 0x00U, 0x80U, 0x00U, 0x00U, 0xAAU, 0x00U, 0x38U,      \
+                                  0x9BU, 0x71U, 16U, 1U, 0U, 0U, 0x00U, 0x00U),                                     \
+        USB_DESCRIPTOR_CLASS_SPECIFIC(                                                                              \
+            USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x05U, 1U, 0x00U,                                         \
+            USB_DESCRIPTOR_WORD(USB_BENCHMARK_VIDEO_WIDTH), USB_DESCRIPTOR_WORD(USB_BENCHMARK_VIDEO_HEIGHT),        \
+            USB_DESCRIPTOR_DWORD(USB_BENCHMARK_VIDEO_FRAME_SIZE * 8U * 30U),                                        \
+            USB_DESCRIPTOR_DWORD(USB_BENCHMARK_VIDEO_FRAME_SIZE * 8U * 30U),                                        \
+            USB_DESCRIPTOR_DWORD(USB_BENCHMARK_VIDEO_FRAME_SIZE),                                                   \
+            USB_DESCRIPTOR_DWORD(USB_BENCHMARK_VIDEO_FRAME_INTERVAL),                                               \
+            1U, USB_DESCRIPTOR_DWORD(USB_BENCHMARK_VIDEO_FRAME_INTERVAL))
+
+/*! @brief The video measurement state */
+typedef struct _usb_benchmark_video_struct
+{
+    usb_benchmark_struct_t *benchmark; /*!< The benchmark instance */
+    usb_host_class_handle classHandle; /*!< The host video instance */
+    class_handle_t deviceHandle;       /*!< The device video instance */
+    uint32_t deviceFrames;             /*!< The frames left to send by the device */
+    uint32_t deviceOffset;             /*!< The bytes of the current frame sent by the device */
+    uint32_t frames;                   /*!< The complete frames received by the host */
+    uint32_t frameBytes;               /*!< The bytes of the current frame received by the host */
+    uint32_t packets;                  /*!< The ISO packets with payload received by the host */
+    uint32_t bytes;                    /*!< The frame bytes received by the host */
+    uint32_t outstanding;              /*!< The ISO IN transfers of the host in flight */
+    volatile uint8_t done;             /*!< The measurement is done */
+    uint8_t deviceFid;                 /*!< The frame ID of the device */
+    uint8_t hostFid;                   /*!< The frame ID of the last frame received by the host */
+    usb_status_t status;               /*!< The first error of the measurement */
+} usb_benchmark_video_struct_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static usb_status_t USB_BenchmarkVideoClassCallback(class_handle_t handle, uint32_t event, void *param);
+static void USB_BenchmarkVideoCallback(void *param, uint8_t *data, uint32_t dataLen, usb_status_t status);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The payload of the device, the header and the frame bytes */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t s_BenchmarkVideoPacket[USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE];
+/* The receive buffers of the host */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static uint8_t s_BenchmarkVideoBuffer[USB_BENCHMARK_VIDEO_TRANSFERS][USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE];
+/* The probe and commit controls of the host */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static usb_host_video_probe_commit_controls_t s_BenchmarkVideoHostProbe;
+/* The probe and commit controls of the device, and the data of the SET_CUR requests */
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static usb_device_video_probe_and_commit_controls_struct_t s_BenchmarkVideoProbe;
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static usb_device_video_probe_and_commit_controls_struct_t s_BenchmarkVideoCommit;
+USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static usb_device_video_probe_and_commit_controls_struct_t s_BenchmarkVideoRequest;
+
+static usb_benchmark_video_struct_t s_BenchmarkVideo;
+
+static usb_device_endpoint_struct_t s_BenchmarkVideoStreamEndpoints[] = {
+    {USB_BENCHMARK_VIDEO_ISO_IN_ENDPOINT, USB_ENDPOINT_ISOCHRONOUS, USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE, 1U},
+};
+
+static usb_device_interface_struct_t s_BenchmarkVideoControlInterface[] = {
+    {0U, {0U, NULL}, NULL},
+};
+
+/* The stream interface has no endpoint in the alternate setting 0, the ISO IN endpoint is in the setting 1 */
+static usb_device_interface_struct_t s_BenchmarkVideoStreamInterface[] = {
+    {0U, {0U, NULL}, NULL},
+    {1U, {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkVideoStreamEndpoints), s_BenchmarkVideoStreamEndpoints}, NULL},
+};
+
+static usb_device_interfaces_struct_t s_BenchmarkVideoInterfaces[] = {
+    {USB_DEVICE_VIDEO_CC_VIDEO, USB_DEVICE_VIDEO_SC_VIDEOCONTROL, 0x00U, USB_BENCHMARK_VIDEO_CONTROL_INTERFACE,
+     s_BenchmarkVideoControlInterface, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkVideoControlInterface)},
+    {USB_DEVICE_VIDEO_CC_VIDEO, USB_DEVICE_VIDEO_SC_VIDEOSTREAMING, 0x00U, USB_BENCHMARK_VIDEO_STREAM_INTERFACE,
+     s_BenchmarkVideoStreamInterface, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkVideoStreamInterface)},
+};
+
+static usb_device_interface_list_t s_BenchmarkVideoInterfaceList[] = {
+    {USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkVideoInterfaces), s_BenchmarkVideoInterfaces},
+};
+
+static usb_device_class_struct_t s_BenchmarkVideoClass = {s_BenchmarkVideoInterfaceList, kUSB_DeviceClassTypeVideo,
+                                                          1U};
+
+static usb_device_class_config_struct_t s_BenchmarkVideoConfig[] = {
+    {USB_BenchmarkVideoClassCallback, (class_handle_t)NULL, &s_BenchmarkVideoClass},
+};
+
+static usb_device_class_config_list_struct_t s_BenchmarkVideoConfigList = {
+    s_BenchmarkVideoConfig, USB_BenchmarkDeviceCallback, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkVideoConfig)};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkVideoDeviceDescriptor[] = {USB_DESCRIPTOR_DEVICE(
+    0x0200U, 0xEFU, 0x02U, 0x01U, USB_CONTROL_MAX_PACKET_SIZE, 0x1FC9U, 0x0104U, 0x0101U, 0U, 0U, 0U, 1U)};
+
+USB_DMA_INIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE)
+static const uint8_t s_BenchmarkVideoConfigurationDescriptor[] = {USB_DESCRIPTOR_CONFIGURATION(
+    2U, 1U, 0U, 0xC0U, 50U,
+    USB_DESCRIPTOR_INTERFACE_ASSOCIATION(USB_BENCHMARK_VIDEO_CONTROL_INTERFACE, 2U, USB_DEVICE_VIDEO_CC_VIDEO,
+                                         USB_DEVICE_VIDEO_SC_VIDEO_INTERFACE_COLLECTION, 0x00U, 0U),
+    USB_DESCRIPTOR_INTERFACE(USB_BENCHMARK_VIDEO_CONTROL_INTERFACE, 0U, 0U, USB_DEVICE_VIDEO_CC_VIDEO,
+                             USB_DEVICE_VIDEO_SC_VIDEOCONTROL, 0x00U, 0U),
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x01U, USB_DESCRIPTOR_WORD(0x0100U),
+                                  USB_DESCRIPTOR_WORD(13U +
+                                                      USB_DESCRIPTOR_LENGTH_OF(USB_BENCHMARK_VIDEO_CONTROL_UNITS)),
+                                  USB_DESCRIPTOR_DWORD(48000000U), 1U, USB_BENCHMARK_VIDEO_STREAM_INTERFACE),
+    USB_BENCHMARK_VIDEO_CONTROL_UNITS,
+    USB_DESCRIPTOR_INTERFACE(USB_BENCHMARK_VIDEO_STREAM_INTERFACE, 0U, 0U, USB_DEVICE_VIDEO_CC_VIDEO,
+                             USB_DEVICE_VIDEO_SC_VIDEOSTREAMING, 0x00U, 0U),
+    USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x01U, 1U,
+                                  USB_DESCRIPTOR_WORD(14U +
+                                                      USB_DESCRIPTOR_LENGTH_OF(USB_BENCHMARK_VIDEO_STREAM_FORMATS)),
+                                  USB_BENCHMARK_VIDEO_ISO_IN_ENDPOINT, 0x00U, USB_BENCHMARK_VIDEO_OUTPUT_TERMINAL_ID,
+                                  0x00U, 0x00U, 0x00U, 1U, 0x00U),
+    USB_BENCHMARK_VIDEO_STREAM_FORMATS,
+    USB_DESCRIPTOR_INTERFACE(USB_BENCHMARK_VIDEO_STREAM_INTERFACE, 1U, 1U, USB_DEVICE_VIDEO_CC_VIDEO,
+                             USB_DEVICE_VIDEO_SC_VIDEOSTREAMING, 0x00U, 0U),
+    USB_DESCRIPTOR_ENDPOINT(USB_BENCHMARK_VIDEO_ISO_IN_ENDPOINT, USB_ENDPOINT_ISOCHRONOUS | 0x04U,
+                            USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE, 1U))};
+
+static const usb_device_descriptor_entry_struct_t s_BenchmarkVideoDescriptorEntries[] = {
+    {s_BenchmarkVideoDeviceDescriptor, sizeof(s_BenchmarkVideoDeviceDescriptor), 0U, USB_DESCRIPTOR_TYPE_DEVICE, 0U,
+     USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+    {s_BenchmarkVideoConfigurationDescriptor, sizeof(s_BenchmarkVideoConfigurationDescriptor), 0U,
+     USB_DESCRIPTOR_TYPE_CONFIGURE, 0U, USB_DEVICE_DESCRIPTOR_SPEED_ANY},
+};
+
+static const usb_device_descriptor_table_struct_t s_BenchmarkVideoDescriptorTable = {
+    s_BenchmarkVideoDescriptorEntries, USB_BENCHMARK_ARRAY_SIZE(s_BenchmarkVideoDescriptorEntries)};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Sends the next payload of the device.
+ *
+ * Each payload is a header and the next frame bytes that fit in one packet, the last payload of a frame has the EOF
+ * bit and the frame ID toggles at each frame.
+ *
+ * @param video The video measurement state.
+ */
+static void USB_BenchmarkVideoSend(usb_benchmark_video_struct_t *video)
+{
+    uint32_t length;
+    usb_status_t status;
+
+    if (USB_BENCHMARK_VIDEO_FRAME_SIZE == video->deviceOffset)
+    {
+        video->deviceOffset = 0U;
+        video->deviceFid ^= USB_BENCHMARK_VIDEO_HEADER_FID;
+        video->deviceFrames--;
+    }
+    if (0U == video->deviceFrames)
+    {
+        return;
+    }
+    length = USB_BENCHMARK_VIDEO_FRAME_SIZE - video->deviceOffset;
+    if (length > (USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE - USB_BENCHMARK_VIDEO_HEADER_LENGTH))
+    {
+        length = USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE - USB_BENCHMARK_VIDEO_HEADER_LENGTH;
+    }
+    video->deviceOffset += length;
+    s_BenchmarkVideoPacket[0] = USB_BENCHMARK_VIDEO_HEADER_LENGTH;
+    s_BenchmarkVideoPacket[1] = USB_BENCHMARK_VIDEO_HEADER_EOH | video->deviceFid;
+    if (USB_BENCHMARK_VIDEO_FRAME_SIZE == video->deviceOffset)
+    {
+        s_BenchmarkVideoPacket[1] |= USB_BENCHMARK_VIDEO_HEADER_EOF;
+    }
+    status = USB_DeviceVideoSend(video->deviceHandle, USB_BENCHMARK_VIDEO_ISO_IN_ENDPOINT & USB_ENDPOINT_NUMBER_MASK,
+                                 s_BenchmarkVideoPacket, length + USB_BENCHMARK_VIDEO_HEADER_LENGTH);
+    if (kStatus_USB_Success != status)
+    {
+        video->status = status;
+        video->done   = 1U;
+    }
+}
+
+/*!
+ * @brief Device video class callback.
+ *
+ * @param handle The video class handle.
+ * @param event  The video event or the probe and commit control command.
+ * @param param  The event parameter.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkVideoClassCallback(class_handle_t handle, uint32_t event, void *param)
+{
+    usb_device_control_request_struct_t *request = (usb_device_control_request_struct_t *)param;
+    usb_device_endpoint_callback_message_struct_t *message;
+    usb_status_t error = kStatus_USB_Success;
+
+    switch (event)
+    {
+        case kUSB_DeviceVideoEventStreamSendResponse:
+            message = (usb_device_endpoint_callback_message_struct_t *)param;
+            if (USB_CANCELLED_TRANSFER_LENGTH != message->length)
+            {
+                USB_BenchmarkVideoSend(&s_BenchmarkVideo);
+            }
+            break;
+
+        case kUSB_DeviceVideoEventClassRequestBuffer:
+            if (request->setup->wLength > sizeof(s_BenchmarkVideoRequest))
+            {
+                error = kStatus_USB_InvalidRequest;
+                break;
+            }
+            request->buffer = (uint8_t *)&s_BenchmarkVideoRequest;
+            break;
+
+        case USB_DEVICE_VIDEO_SET_CUR_VS_PROBE_CONTROL:
+            /* The format and the frame are fixed, the host chooses the frame interval */
+            s_BenchmarkVideoProbe.bFormatIndex             = 1U;
+            s_BenchmarkVideoProbe.bFrameIndex              = 1U;
+            s_BenchmarkVideoProbe.dwFrameInterval          = s_BenchmarkVideoRequest.dwFrameInterval;
+            s_BenchmarkVideoProbe.dwMaxVideoFrameSize      = USB_LONG_TO_LITTLE_ENDIAN(USB_BENCHMARK_VIDEO_FRAME_SIZE);
+            s_BenchmarkVideoProbe.dwMaxPayloadTransferSize =
+                USB_LONG_TO_LITTLE_ENDIAN(USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE);
+            break;
+
+        case USB_DEVICE_VIDEO_SET_CUR_VS_COMMIT_CONTROL:
+            (void)memcpy(&s_BenchmarkVideoCommit, &s_BenchmarkVideoProbe, sizeof(s_BenchmarkVideoCommit));
+            break;
+
+        case USB_DEVICE_VIDEO_GET_CUR_VS_PROBE_CONTROL:
+            request->buffer = (uint8_t *)&s_BenchmarkVideoProbe;
+            request->length = sizeof(s_BenchmarkVideoProbe);
+            break;
+
+        case USB_DEVICE_VIDEO_GET_CUR_VS_COMMIT_CONTROL:
+            request->buffer = (uint8_t *)&s_BenchmarkVideoCommit;
+            request->length = sizeof(s_BenchmarkVideoCommit);
+            break;
+
+        default:
+            error = kStatus_USB_InvalidRequest;
+            break;
+    }
+    return error;
+}
+
+/*!
+ * @brief Host video stream callback, the payload is checked and the transfer is queued again.
+ *
+ * @param param   The video measurement state.
+ * @param data    The data buffer.
+ * @param dataLen The data length.
+ * @param status  The transfer status.
+ */
+static void USB_BenchmarkVideoCallback(void *param, uint8_t *data, uint32_t dataLen, usb_status_t status)
+{
+    usb_benchmark_video_struct_t *video = (usb_benchmark_video_struct_t *)param;
+    uint8_t fid;
+
+    video->outstanding--;
+    if (kStatus_USB_Success != status)
+    {
+        video->status = status;
+        video->done   = 1U;
+        return;
+    }
+    /* An empty packet is a (micro)frame the device had nothing to send in */
+    if (0U != dataLen)
+    {
+        fid = data[1] & USB_BENCHMARK_VIDEO_HEADER_FID;
+        if ((dataLen < USB_BENCHMARK_VIDEO_HEADER_LENGTH) || (USB_BENCHMARK_VIDEO_HEADER_LENGTH != data[0]) ||
+            (0U == (data[1] & USB_BENCHMARK_VIDEO_HEADER_EOH)) ||
+            ((0U == video->frameBytes) && (0U != video->frames) && (fid == video->hostFid)))
+        {
+            video->status = kStatus_USB_Error;
+            video->done   = 1U;
+            return;
+        }
+        video->packets++;
+        video->frameBytes += dataLen - USB_BENCHMARK_VIDEO_HEADER_LENGTH;
+        video->bytes += dataLen - USB_BENCHMARK_VIDEO_HEADER_LENGTH;
+        if (0U != (data[1] & USB_BENCHMARK_VIDEO_HEADER_EOF))
+        {
+            if (USB_BENCHMARK_VIDEO_FRAME_SIZE != video->frameBytes)
+            {
+                video->status = kStatus_USB_Error;
+                video->done   = 1U;
+                return;
+            }
+            video->frames++;
+            video->frameBytes = 0U;
+            video->hostFid    = fid;
+        }
+    }
+    if (video->frames < USB_BENCHMARK_VIDEO_FRAMES)
+    {
+        status = USB_HosVideoStreamRecv(video->classHandle, data, USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE,
+                                        USB_BenchmarkVideoCallback, video);
+        if (kStatus_USB_Success != status)
+        {
+            video->status = status;
+            video->done   = 1U;
+            return;
+        }
+        video->outstanding++;
+    }
+    else if (0U == video->outstanding)
+    {
+        video->done = 1U;
+    }
+    else
+    {
+        /*no action*/
+    }
+}
+
+/*!
+ * @brief Runs the video measurement.
+ *
+ * The device streams the frames in one payload per packet, the host keeps several ISO IN transfers in flight.
+ *
+ * @param benchmark The benchmark instance.
+ * @param video     The video measurement state.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_BenchmarkVideoMeasure(usb_benchmark_struct_t *benchmark, usb_benchmark_video_struct_t *video)
+{
+    usb_benchmark_result_t result;
+    uint32_t startCycles;
+    uint32_t index;
+
+    video->deviceFrames = USB_BENCHMARK_VIDEO_FRAMES;
+    video->deviceOffset = 0U;
+    video->deviceFid    = 0U;
+    video->frames       = 0U;
+    video->frameBytes   = 0U;
+    video->packets      = 0U;
+    video->bytes        = 0U;
+    video->outstanding  = 0U;
+    video->hostFid      = 0U;
+    video->done         = 0U;
+    video->status       = kStatus_USB_Success;
+
+    USB_BenchmarkStart(benchmark);
+    /* The receives and the first payload are issued here, the others by the completion callbacks */
+    startCycles = USB_BENCHMARK_CYCLES();
+    for (index = 0U; (kStatus_USB_Success == video->status) && (index < USB_BENCHMARK_VIDEO_TRANSFERS); index++)
+    {
+        video->status = USB_HosVideoStreamRecv(video->classHandle, s_BenchmarkVideoBuffer[index],
+                                               USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE, USB_BenchmarkVideoCallback, video);
+        if (kStatus_USB_Success == video->status)
+        {
+            video->outstanding++;
+        }
+    }
+    if (kStatus_USB_Success == video->status)
+    {
+        USB_BenchmarkVideoSend(video);
+    }
+    benchmark->callCycles += (uint32_t)(USB_BENCHMARK_CYCLES() - startCycles);
+    if ((kStatus_USB_Success != video->status) ||
+        (kStatus_USB_Success !=
+         USB_BenchmarkWait(benchmark, &video->done,
+                           (USB_BENCHMARK_VIDEO_FRAMES + 1U) * USB_BENCHMARK_TIMEOUT_FRAMES)) ||
+        (kStatus_USB_Success != video->status) || (USB_BENCHMARK_VIDEO_FRAMES != video->frames))
+    {
+        usb_echo("UVC stream error\r\n");
+        return kStatus_USB_Error;
+    }
+    USB_BenchmarkStop(benchmark, &result);
+    result.transfers = video->packets;
+    result.bytes     = video->bytes;
+    USB_BenchmarkPrint("UVC frame 320x240 YUY2", &result);
+    usb_echo("%-24s %8u frames/s\r\n", "UVC frame 320x240 YUY2", USB_BenchmarkRate(video->frames, result.busTime));
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_BenchmarkVideo(usb_benchmark_struct_t *benchmark)
+{
+    usb_benchmark_video_struct_t *video = &s_BenchmarkVideo;
+    usb_host_interface_handle controlInterface;
+    usb_host_interface_handle streamInterface;
+    usb_status_t status = kStatus_USB_Error;
+    uint32_t index;
+
+    if (kStatus_USB_Success !=
+        USB_BenchmarkDeviceStart(benchmark, &s_BenchmarkVideoConfigList, &s_BenchmarkVideoDescriptorTable))
+    {
+        usb_echo("UVC enumeration error\r\n");
+        return kStatus_USB_Error;
+    }
+    video->benchmark    = benchmark;
+    video->deviceHandle = s_BenchmarkVideoConfig[0].classHandle;
+
+    (void)memset(&s_BenchmarkVideoHostProbe, 0, sizeof(s_BenchmarkVideoHostProbe));
+    s_BenchmarkVideoHostProbe.bFormatIndex = 1U;
+    s_BenchmarkVideoHostProbe.bFrameIndex  = 1U;
+    USB_LONG_TO_LITTLE_ENDIAN_ADDRESS(USB_BENCHMARK_VIDEO_FRAME_INTERVAL, s_BenchmarkVideoHostProbe.dwFrameInterval);
+
+    /* The probe and commit negotiation in the alternate setting 0, then the stream in the setting 1 */
+    controlInterface = USB_BenchmarkGetInterface(benchmark, USB_HOST_VIDEO_CLASS_CODE,
+                                                 USB_HOST_VIDEO_SUBCLASS_CODE_CONTROL);
+    streamInterface  = USB_BenchmarkGetInterface(benchmark, USB_HOST_VIDEO_CLASS_CODE,
+                                                 USB_HOST_VIDEO_SUBCLASS_CODE_STREAM);
+    if ((NULL != controlInterface) && (NULL != streamInterface) &&
+        (kStatus_USB_Success == USB_HostVideoInit(benchmark->attachedDeviceHandle, &video->classHandle)) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark,
+                                  USB_HostVideoControlSetInterface(video->classHandle, controlInterface, 0U,
+                                                                   USB_BenchmarkRequestCallback, benchmark))) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark,
+                                  USB_HostVideoStreamSetInterface(video->classHandle, streamInterface, 0U,
+                                                                  USB_BenchmarkRequestCallback, benchmark))) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark, USB_HostVideoSetProbe(video->classHandle, USB_HOST_VIDEO_SET_CUR,
+                                                                   (uint8_t *)&s_BenchmarkVideoHostProbe,
+                                                                   USB_BenchmarkRequestCallback, benchmark))) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark, USB_HostVideoGetProbe(video->classHandle, USB_HOST_VIDEO_GET_CUR,
+                                                                   (uint8_t *)&s_BenchmarkVideoHostProbe,
+                                                                   USB_BenchmarkRequestCallback, benchmark))) &&
+        (USB_BENCHMARK_VIDEO_FRAME_SIZE ==
+         USB_LONG_FROM_LITTLE_ENDIAN_ADDRESS(s_BenchmarkVideoHostProbe.dwMaxVideoFrameSize)) &&
+        (USB_BENCHMARK_VIDEO_MAX_PACKET_SIZE >=
+         USB_LONG_FROM_LITTLE_ENDIAN_ADDRESS(s_BenchmarkVideoHostProbe.dwMaxPayloadTransferSize)) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark, USB_HostVideoSetCommit(video->classHandle, USB_HOST_VIDEO_SET_CUR,
+                                                                    (uint8_t *)&s_BenchmarkVideoHostProbe,
+                                                                    USB_BenchmarkRequestCallback, benchmark))) &&
+        (kStatus_USB_Success ==
+         USB_BenchmarkRequestWait(benchmark,
+                                  USB_HostVideoStreamSetInterface(video->classHandle, streamInterface, 1U,
+                                                                  USB_BenchmarkRequestCallback, benchmark))))
+    {
+        for (index = 0U; index < sizeof(s_BenchmarkVideoPacket); index++)
+        {
+            s_BenchmarkVideoPacket[index] = (uint8_t)index;
+        }
+        status = USB_BenchmarkVideoMeasure(benchmark, video);
+    }
+    else
+    {
+        usb_echo("UVC host class error\r\n");
+    }
+
+    if (kStatus_USB_Success != USB_BenchmarkDeviceStop(benchmark))
+    {
+        status = kStatus_USB_Error;
+    }
+    if (NULL != video->classHandle)
+    {
+        (void)USB_HostVideoDeinit(benchmark->attachedDeviceHandle, video->classHandle);
+        video->classHandle = NULL;
+    }
+    else
+    {
+        (void)USB_HostCloseDeviceInterface(benchmark->attachedDeviceHandle, NULL);
+    }
+    return status;
+}
+
+#endif /* USB_DEVICE_CONFIG_VIDEO && USB_HOST_CONFIG_VIDEO */
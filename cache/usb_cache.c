@@ -0,0 +1,253 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb.h"
+#include "fsl_cache.h"
+#include "usb_cache.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "middleware.usb.cache"
+#endif
+
+/*! @brief The start of the cache line of an address */
+#define USB_CACHE_LINE_START(address) ((uint32_t)(address) & (~((uint32_t)USB_CACHE_LINE_SIZE - 1U)))
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static uint8_t USB_CacheIsNonCacheable(uint32_t address, uint32_t length);
+static void USB_CacheMaintainLines(uint32_t start, uint32_t end, uint8_t operation);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The registered non-cacheable regions */
+static const usb_cache_region_t *s_UsbCacheRegions;
+static uint8_t s_UsbCacheRegionCount;
+
+static usb_cache_statistic_t s_UsbCacheStatistic;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Check whether a buffer is in a non-cacheable region.
+ *
+ * @param address   The buffer address.
+ * @param length    The buffer length.
+ *
+ * @return 1 if the whole buffer is in one registered region, else 0.
+ */
+static uint8_t USB_CacheIsNonCacheable(uint32_t address, uint32_t length)
+{
+    uint8_t index;
+
+    for (index = 0U; index < s_UsbCacheRegionCount; index++)
+    {
+        if ((address >= s_UsbCacheRegions[index].start) &&
+            ((address - s_UsbCacheRegions[index].start) <= s_UsbCacheRegions[index].length) &&
+            (length <= (s_UsbCacheRegions[index].length - (address - s_UsbCacheRegions[index].start))))
+        {
+            return 1U;
+        }
+    }
+    return 0U;
+}
+
+/*!
+ * @brief Maintain the cache lines of an address range.
+ *
+ * @param start       The range start, aligned to the cache line.
+ * @param end         The range end, aligned to the cache line.
+ * @param operation   See the enumeration usb_cache_operation_t.
+ */
+static void USB_CacheMaintainLines(uint32_t start, uint32_t end, uint8_t operation)
+{
+    s_UsbCacheStatistic.maintained++;
+    if ((uint8_t)kUSB_CacheCleanInvalidate == operation)
+    {
+        DCACHE_CleanInvalidateByRange(start, end - start);
+    }
+    else
+    {
+        DCACHE_CleanByRange(start, end - start);
+    }
+}
+
+usb_status_t USB_CacheSetNonCacheableRegions(const usb_cache_region_t *regions, uint8_t count)
+{
+    OSA_SR_ALLOC();
+
+    if ((NULL != regions) && (0U == count))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    OSA_ENTER_CRITICAL();
+    s_UsbCacheRegions     = regions;
+    s_UsbCacheRegionCount = (NULL != regions) ? count : 0U;
+    OSA_EXIT_CRITICAL();
+    return kStatus_USB_Success;
+}
+
+void USB_CacheMaintain(void *buffer, uint32_t length, usb_cache_operation_t operation)
+{
+    usb_cache_range_t range;
+
+    range.buffer    = buffer;
+    range.length    = length;
+    range.operation = (uint8_t)operation;
+    USB_CacheMaintainList(&range, 1U);
+}
+
+void USB_CacheMaintainList(const usb_cache_range_t *ranges, uint32_t count)
+{
+    uint32_t index;
+    uint32_t address;
+    uint32_t start     = 0U;
+    uint32_t end       = 0U;
+    uint32_t lineStart = 0U;
+    uint32_t lineEnd   = 0U;
+    uint32_t gap;
+    uint8_t operation  = 0U;
+
+    for (index = 0U; index < count; index++)
+    {
+        if (0U == ranges[index].length)
+        {
+            continue;
+        }
+        address = (uint32_t)ranges[index].buffer;
+        if (0U != USB_CacheIsNonCacheable(address, ranges[index].length))
+        {
+            s_UsbCacheStatistic.skipped++;
+            continue;
+        }
+        if (((uint8_t)kUSB_CacheCleanInvalidate == ranges[index].operation) &&
+            (0U != ((address | (address + ranges[index].length)) & ((uint32_t)USB_CACHE_LINE_SIZE - 1U))))
+        {
+            /* The rest of the first or last line is not owned by the buffer */
+            s_UsbCacheStatistic.partialLines++;
+#if ((defined(USB_CACHE_CONFIG_WARN_PARTIAL_LINE)) && (USB_CACHE_CONFIG_WARN_PARTIAL_LINE > 0U))
+            usb_echo("usb cache: receive buffer 0x%x (%d bytes) is not cache line aligned\r\n", address,
+                     ranges[index].length);
+#endif
+        }
+
+        start = USB_CACHE_LINE_START(address);
+        end   = USB_CACHE_LINE_START(address + ranges[index].length + (uint32_t)USB_CACHE_LINE_SIZE - 1U);
+        /* The lines between two ranges are only cleaned, never invalidated */
+        gap = ((uint8_t)kUSB_CacheClean == (operation | ranges[index].operation)) ?
+                  ((uint32_t)USB_CACHE_CONFIG_COALESCE_GAP * (uint32_t)USB_CACHE_LINE_SIZE) :
+                  0U;
+        if ((0U != operation) && (start <= (lineEnd + gap)) && ((end + gap) >= lineStart))
+        {
+            /* Merge into the pending range */
+            s_UsbCacheStatistic.coalesced++;
+            lineStart = (start < lineStart) ? start : lineStart;
+            lineEnd   = (end > lineEnd) ? end : lineEnd;
+            operation |= ranges[index].operation;
+        }
+        else
+        {
+            if (0U != operation)
+            {
+                USB_CacheMaintainLines(lineStart, lineEnd, operation);
+            }
+            lineStart = start;
+            lineEnd   = end;
+            operation = ranges[index].operation;
+        }
+    }
+    if (0U != operation)
+    {
+        USB_CacheMaintainLines(lineStart, lineEnd, operation);
+    }
+}
+
+void USB_CacheGetStatistic(usb_cache_statistic_t *statistic)
+{
+    if (NULL != statistic)
+    {
+        *statistic = s_UsbCacheStatistic;
+    }
+}
+
+usb_status_t USB_CacheBufferPoolInit(usb_cache_buffer_pool_t *pool, void *memory, uint32_t size, uint32_t blockSize)
+{
+    uint32_t start;
+    uint32_t end;
+    uint32_t count;
+    void **block;
+
+    if ((NULL == pool) || (NULL == memory) || (0U == blockSize))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    start           = USB_CACHE_LINE_START((uint32_t)memory + (uint32_t)USB_CACHE_LINE_SIZE - 1U);
+    end             = (uint32_t)memory + size;
+    pool->blockSize = USB_CACHE_LINE_ALIGNED_SIZE(blockSize);
+    pool->freeList  = NULL;
+    pool->freeCount = 0U;
+    if ((end < start) || ((end - start) < pool->blockSize))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    /* Link the blocks from the last one, the first block is the head of the free list */
+    count = (end - start) / pool->blockSize;
+    while (count > 0U)
+    {
+        count--;
+        block          = (void **)(start + (count * pool->blockSize));
+        *block         = pool->freeList;
+        pool->freeList = (void *)block;
+        pool->freeCount++;
+    }
+    return kStatus_USB_Success;
+}
+
+void *USB_CacheBufferPoolAlloc(usb_cache_buffer_pool_t *pool)
+{
+    void **block;
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    block = (void **)pool->freeList;
+    if (NULL != block)
+    {
+        pool->freeList = *block;
+        pool->freeCount--;
+    }
+    OSA_EXIT_CRITICAL();
+    return (void *)block;
+}
+
+void USB_CacheBufferPoolFree(usb_cache_buffer_pool_t *pool, void *buffer)
+{
+    void **block = (void **)buffer;
+    OSA_SR_ALLOC();
+
+    if (NULL == block)
+    {
+        return;
+    }
+    OSA_ENTER_CRITICAL();
+    *block         = pool->freeList;
+    pool->freeList = (void *)block;
+    pool->freeCount++;
+    OSA_EXIT_CRITICAL();
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __USB_CACHE_H__
+#define __USB_CACHE_H__
+
+/*!
+ * @addtogroup usb_cache
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The data cache line size, the largest line size of the L1 and L2 caches */
+#ifndef USB_CACHE_LINE_SIZE
+#if ((defined(FSL_FEATURE_L2CACHE_LINESIZE_BYTE)) && (defined(FSL_FEATURE_L1DCACHE_LINESIZE_BYTE)))
+#define USB_CACHE_LINE_SIZE MAX(FSL_FEATURE_L2CACHE_LINESIZE_BYTE, FSL_FEATURE_L1DCACHE_LINESIZE_BYTE)
+#elif (defined(FSL_FEATURE_L2CACHE_LINESIZE_BYTE))
+#define USB_CACHE_LINE_SIZE FSL_FEATURE_L2CACHE_LINESIZE_BYTE
+#elif (defined(FSL_FEATURE_L1DCACHE_LINESIZE_BYTE))
+#define USB_CACHE_LINE_SIZE FSL_FEATURE_L1DCACHE_LINESIZE_BYTE
+#else
+#define USB_CACHE_LINE_SIZE (32U)
+#endif
+#endif
+
+/*! @brief The size rounded up to whole cache lines */
+#define USB_CACHE_LINE_ALIGNED_SIZE(n) \
+    (((uint32_t)(n) + (uint32_t)USB_CACHE_LINE_SIZE - 1U) & (~((uint32_t)USB_CACHE_LINE_SIZE - 1U)))
+
+/*! @brief The memory size of a buffer pool of count blocks, the start of the memory is aligned by the pool */
+#define USB_CACHE_BUFFER_POOL_MEMORY_SIZE(count, blockSize) \
+    (((uint32_t)(count)*USB_CACHE_LINE_ALIGNED_SIZE(blockSize)) + (uint32_t)USB_CACHE_LINE_SIZE - 1U)
+
+/*! @brief The maximum gap in cache lines between two clean ranges of a list that are maintained as one range. The
+ * lines of the gap are cleaned too. Ranges that are invalidated are merged only if their lines overlap or are adjacent,
+ * the lines of a gap belong to no buffer and must not be invalidated. */
+#ifndef USB_CACHE_CONFIG_COALESCE_GAP
+#define USB_CACHE_CONFIG_COALESCE_GAP (0U)
+#endif
+
+/*! @brief Whether a receive buffer that does not start or end on a cache line boundary is reported with usb_echo. The
+ * CPU writes to the rest of such a line while the controller fills the buffer are lost. */
+#ifndef USB_CACHE_CONFIG_WARN_PARTIAL_LINE
+#define USB_CACHE_CONFIG_WARN_PARTIAL_LINE (1U)
+#endif
+
+/*! @brief The cache maintenance operations, the bits of an operation include the bits of the weaker ones */
+typedef enum _usb_cache_operation
+{
+    kUSB_CacheClean           = 0x01U, /*!< Clean, the controller reads the buffer (transmit) */
+    kUSB_CacheCleanInvalidate = 0x03U, /*!< Clean and invalidate, the controller writes the buffer (receive) */
+} usb_cache_operation_t;
+
+/*! @brief A memory region that is not cacheable, the buffers inside are not maintained */
+typedef struct _usb_cache_region
+{
+    uint32_t start;  /*!< Region start address */
+    uint32_t length; /*!< Region length in bytes */
+} usb_cache_region_t;
+
+/*! @brief A buffer of a scatter list */
+typedef struct _usb_cache_range
+{
+    void *buffer;      /*!< Buffer address */
+    uint32_t length;   /*!< Buffer length */
+    uint8_t operation; /*!< See the enumeration usb_cache_operation_t */
+} usb_cache_range_t;
+
+/*! @brief Cache maintenance statistics */
+typedef struct _usb_cache_statistic
+{
+    uint32_t maintained;   /*!< Ranges maintained by the cache driver */
+    uint32_t skipped;      /*!< Buffers skipped because they are in a non-cacheable region */
+    uint32_t coalesced;    /*!< Buffers merged into the previous range of a list */
+    uint32_t partialLines; /*!< Receive buffers not aligned to the cache line at the start or the end */
+} usb_cache_statistic_t;
+
+/*! @brief A pool of buffers that start on a cache line boundary and are a whole number of lines long */
+typedef struct _usb_cache_buffer_pool
+{
+    void *freeList;     /*!< The free blocks, the first word of a free block links the next one */
+    uint32_t blockSize; /*!< Block size, a multiple of the cache line size */
+    uint32_t freeCount; /*!< Free block count */
+} usb_cache_buffer_pool_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @brief Registers the non-cacheable regions.
+ *
+ * The buffers in these regions (the non-cacheable sections of the linker file, the USB dedicated RAM, a region
+ * configured as non-cacheable by the MPU...) are used by the controller without cache maintenance.
+ *
+ * @param[in] regions  The region table, it is used in place and must stay valid. NULL removes the table.
+ * @param[in] count    The region count.
+ *
+ * @retval kStatus_USB_Success              The regions are registered.
+ * @retval kStatus_USB_InvalidParameter     The table is not NULL and has no region.
+ */
+usb_status_t USB_CacheSetNonCacheableRegions(const usb_cache_region_t *regions, uint8_t count);
+
+/*!
+ * @brief Maintains the cache of one buffer before it is passed to the controller.
+ *
+ * @param[in] buffer     The buffer.
+ * @param[in] length     The buffer length, nothing is done if it is 0.
+ * @param[in] operation  See the enumeration #usb_cache_operation_t.
+ */
+void USB_CacheMaintain(void *buffer, uint32_t length, usb_cache_operation_t operation);
+
+/*!
+ * @brief Maintains the cache of a scatter list before it is passed to the controller.
+ *
+ * The ranges whose lines overlap or are adjacent to the previous range of the list are merged into it, the merged
+ * range gets the stronger operation. Clean ranges are also merged across a gap of USB_CACHE_CONFIG_COALESCE_GAP
+ * lines. The list is walked in order, so a list sorted by address is merged the best.
+ *
+ * @param[in] ranges     The ranges.
+ * @param[in] count      The range count.
+ */
+void USB_CacheMaintainList(const usb_cache_range_t *ranges, uint32_t count);
+
+/*!
+ * @brief Gets the cache maintenance statistics.
+ *
+ * @param[out] statistic  Returns the statistics.
+ */
+void USB_CacheGetStatistic(usb_cache_statistic_t *statistic);
+
+/*!
+ * @brief Initializes a cache line aligned buffer pool.
+ *
+ * The blocks of the pool do not share a cache line with any other data, so a receive buffer from the pool is never
+ * partially maintained.
+ *
+ * @param[out] pool       The pool.
+ * @param[in] memory      The pool memory, see USB_CACHE_BUFFER_POOL_MEMORY_SIZE.
+ * @param[in] size        The pool memory size.
+ * @param[in] blockSize   The block size, it is rounded up to whole cache lines.
+ *
+ * @retval kStatus_USB_Success              The pool is initialized.
+ * @retval kStatus_USB_InvalidParameter     The memory cannot hold one block.
+ */
+usb_status_t USB_CacheBufferPoolInit(usb_cache_buffer_pool_t *pool, void *memory, uint32_t size, uint32_t blockSize);
+
+/*!
+ * @brief Allocates a block of a buffer pool.
+ *
+ * @param[in] pool  The pool.
+ *
+ * @return The block, NULL if the pool is empty.
+ */
+void *USB_CacheBufferPoolAlloc(usb_cache_buffer_pool_t *pool);
+
+/*!
+ * @brief Frees a block of a buffer pool.
+ *
+ * @param[in] pool    The pool.
+ * @param[in] buffer  The block returned by USB_CacheBufferPoolAlloc.
+ */
+void USB_CacheBufferPoolFree(usb_cache_buffer_pool_t *pool, void *buffer);
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* __USB_CACHE_H__ */
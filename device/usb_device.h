@@ -91,6 +91,8 @@ typedef enum _usb_endpoint_status
 #define USB_DEVICE_EHCI_MAX_FRAME_COUNT (0x00003FFFU)
 /* USB device EHCI max frame count */
 #define USB_DEVICE_KHCI_MAX_FRAME_COUNT (0x000007FFU)
+/* USB device loopback max frame count, counts micro-frames as EHCI does */
+#define USB_DEVICE_LOOPBACK_MAX_FRAME_COUNT (0x00003FFFU)
 
 /*! @brief usb device controller max frame count */
 #if ((defined(USB_DEVICE_CONFIG_KHCI)) && (USB_DEVICE_CONFIG_KHCI > 0U))
@@ -100,6 +102,8 @@ typedef enum _usb_endpoint_status
 #define USB_DEVICE_MAX_FRAME_COUNT (USB_DEVICE_IP3511_MAX_FRAME_COUNT)
 #elif ((defined(USB_DEVICE_CONFIG_EHCI)) && (USB_DEVICE_CONFIG_EHCI > 0U))
 #define USB_DEVICE_MAX_FRAME_COUNT (USB_DEVICE_EHCI_MAX_FRAME_COUNT)
+#elif ((defined(USB_DEVICE_CONFIG_LOOPBACK)) && (USB_DEVICE_CONFIG_LOOPBACK > 0U))
+#define USB_DEVICE_MAX_FRAME_COUNT (USB_DEVICE_LOOPBACK_MAX_FRAME_COUNT)
 #endif
 #endif
 
@@ -391,6 +395,31 @@ extern usb_status_t USB_DeviceInitEndpoint(usb_device_handle handle,
  */
 extern usb_status_t USB_DeviceDeinitEndpoint(usb_device_handle handle, uint8_t endpointAddress);
 
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+/*!
+ * @brief Selects the direct callback mode of a specified endpoint.
+ *
+ * In the direct callback mode, the controller driver calls the endpoint callback from the token done interrupt with
+ * the transfer buffer and the transferred length, the device notification message is not built and decoded. The
+ * callback runs in the interrupt context also when USB_DEVICE_CONFIG_USE_TASK is enabled, so it is for the latency
+ * sensitive interrupt and isochronous endpoints. A cancelled transfer is still notified through the device
+ * notification. The selection is kept when the endpoint is de-initialized or the bus is reset, it applies again when
+ * the endpoint is initialized by #USB_DeviceInitEndpoint.
+ *
+ * @param[in] handle The device handle got from #USB_DeviceInit.
+ * @param[in] endpointAddress Endpoint address, bit7 is the direction of endpoint, 1U - IN, and 0U - OUT.
+ * @param[in] enable 1U - enable the direct callback mode, 0U - disable it.
+ *
+ * @retval kStatus_USB_Success              The mode is selected successfully.
+ * @retval kStatus_USB_InvalidHandle        The handle is a NULL pointer.
+ * @retval kStatus_USB_InvalidParameter     The endpoint is the control endpoint or the endpoint number is more than
+ * USB_DEVICE_CONFIG_ENDPOINTS.
+ */
+extern usb_status_t USB_DeviceSetEndpointDirectCallback(usb_device_handle handle,
+                                                        uint8_t endpointAddress,
+                                                        uint8_t enable);
+#endif
+
 /*!
  * @brief Stalls a specified endpoint.
  *
@@ -33,8 +33,12 @@
 #include "usb_device_dwc3.h"
 #endif
 
+#if ((defined(USB_DEVICE_CONFIG_LOOPBACK)) && (USB_DEVICE_CONFIG_LOOPBACK > 0U))
+#include "usb_device_loopback.h"
+#endif
+
 #if (defined(USB_DEVICE_CONFIG_BUFFER_PROPERTY_CACHEABLE) && (USB_DEVICE_CONFIG_BUFFER_PROPERTY_CACHEABLE > 0U))
-#include "fsl_cache.h"
+#include "usb_cache.h"
 #endif
 
 /*******************************************************************************
@@ -52,6 +56,49 @@
 #endif
 #endif
 
+/* When only one controller type is built, the controller driver functions are called directly instead of through the
+ * controller interface table, so the link time optimization can inline them. USB_DEVICE_CONTROLLER_FUNCTION is the
+ * driver function name of the only controller type. */
+#if ((defined(USB_DEVICE_CONFIG_KHCI)) && (USB_DEVICE_CONFIG_KHCI > 0U))
+#define USB_DEVICE_CONTROLLER_FUNCTION(name) USB_DeviceKhci##name
+#endif
+#if ((defined(USB_DEVICE_CONFIG_EHCI)) && (USB_DEVICE_CONFIG_EHCI > 0U))
+#if (defined(USB_DEVICE_CONTROLLER_FUNCTION))
+#define USB_DEVICE_CONTROLLER_MULTIPLE_TYPES (1U)
+#else
+#define USB_DEVICE_CONTROLLER_FUNCTION(name) USB_DeviceEhci##name
+#endif
+#endif
+#if (((defined(USB_DEVICE_CONFIG_LPCIP3511FS)) && (USB_DEVICE_CONFIG_LPCIP3511FS > 0U)) || \
+     ((defined(USB_DEVICE_CONFIG_LPCIP3511HS)) && (USB_DEVICE_CONFIG_LPCIP3511HS > 0U)))
+#if (defined(USB_DEVICE_CONTROLLER_FUNCTION))
+#define USB_DEVICE_CONTROLLER_MULTIPLE_TYPES (1U)
+#else
+#define USB_DEVICE_CONTROLLER_FUNCTION(name) USB_DeviceLpc3511Ip##name
+#endif
+#endif
+#if ((defined(USB_DEVICE_CONFIG_DWC3)) && (USB_DEVICE_CONFIG_DWC3 > 0U))
+#if (defined(USB_DEVICE_CONTROLLER_FUNCTION))
+#define USB_DEVICE_CONTROLLER_MULTIPLE_TYPES (1U)
+#else
+#define USB_DEVICE_CONTROLLER_FUNCTION(name) USB_DeviceDwc3##name
+#endif
+#endif
+#if ((defined(USB_DEVICE_CONFIG_LOOPBACK)) && (USB_DEVICE_CONFIG_LOOPBACK > 0U))
+#if (defined(USB_DEVICE_CONTROLLER_FUNCTION))
+#define USB_DEVICE_CONTROLLER_MULTIPLE_TYPES (1U)
+#else
+#define USB_DEVICE_CONTROLLER_FUNCTION(name) USB_DeviceLoopback##name
+#endif
+#endif
+
+/* The controller driver function of a device, for example USB_DEVICE_CONTROLLER(deviceHandle, Send) */
+#if ((defined(USB_DEVICE_CONTROLLER_MULTIPLE_TYPES)) || (!defined(USB_DEVICE_CONTROLLER_FUNCTION)))
+#define USB_DEVICE_CONTROLLER(deviceHandle, name) ((deviceHandle)->controllerInterface->device##name)
+#else
+#define USB_DEVICE_CONTROLLER(deviceHandle, name) USB_DEVICE_CONTROLLER_FUNCTION(name)
+#endif
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -153,6 +200,10 @@ static usb_status_t USB_DeviceFreeHandle(usb_device_struct_t *handle)
     OSA_ENTER_CRITICAL();
     handle->controllerHandle = NULL;
     handle->controllerId     = 0U;
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+    handle->epDirectCallbackRequest = 0U;
+    handle->epDirectCallbackActive  = 0U;
+#endif
     OSA_EXIT_CRITICAL();
     return kStatus_USB_Success;
 }
@@ -186,6 +237,13 @@ static const usb_device_controller_interface_struct_t s_UsbDeviceDwc3Interface =
     USB_DeviceDwc3Recv, USB_DeviceDwc3Cancel, USB_DeviceDwc3Control};
 #endif
 
+#if ((defined(USB_DEVICE_CONFIG_LOOPBACK)) && (USB_DEVICE_CONFIG_LOOPBACK > 0U))
+/* Software loopback device driver interface */
+static const usb_device_controller_interface_struct_t s_UsbDeviceLoopbackInterface = {
+    USB_DeviceLoopbackInit, USB_DeviceLoopbackDeinit, USB_DeviceLoopbackSend,
+    USB_DeviceLoopbackRecv, USB_DeviceLoopbackCancel, USB_DeviceLoopbackControl};
+#endif
+
 /*!
  * @brief Get the controller interface handle.
  *
@@ -238,6 +296,14 @@ static usb_status_t USB_DeviceGetControllerInterface(
         error                = kStatus_USB_Success;
     }
 #endif
+#if ((defined(USB_DEVICE_CONFIG_LOOPBACK)) && (USB_DEVICE_CONFIG_LOOPBACK > 0U))
+    /* Get the software loopback controller driver interface */
+    if ((kUSB_ControllerLoopback0 == controlerIndex) || (kUSB_ControllerLoopback1 == controlerIndex))
+    {
+        *controllerInterface = (const usb_device_controller_interface_struct_t *)&s_UsbDeviceLoopbackInterface;
+        error                = kStatus_USB_Success;
+    }
+#endif
 
     return error;
 }
@@ -287,27 +353,21 @@ static usb_status_t USB_DeviceTransfer(usb_device_handle handle,
         if (0U != (endpointAddress & USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK))
         {
 #if (defined(USB_DEVICE_CONFIG_BUFFER_PROPERTY_CACHEABLE) && (USB_DEVICE_CONFIG_BUFFER_PROPERTY_CACHEABLE > 0U))
-            if (0U != length)
-            {
-                DCACHE_CleanByRange((uint32_t)buffer, length);
-            }
+            USB_CacheMaintain(buffer, length, kUSB_CacheClean);
 #endif
             /* Call the controller send interface, the callbackFn is initialized in
             USB_DeviceGetControllerInterface */
-            status = deviceHandle->controllerInterface->deviceSend(deviceHandle->controllerHandle, endpointAddress,
+            status = USB_DEVICE_CONTROLLER(deviceHandle, Send)(deviceHandle->controllerHandle, endpointAddress,
                                                                    buffer, length);
         }
         else
         {
 #if (defined(USB_DEVICE_CONFIG_BUFFER_PROPERTY_CACHEABLE) && (USB_DEVICE_CONFIG_BUFFER_PROPERTY_CACHEABLE > 0U))
-            if (length)
-            {
-                DCACHE_CleanInvalidateByRange((uint32_t)buffer, length);
-            }
+            USB_CacheMaintain(buffer, length, kUSB_CacheCleanInvalidate);
 #endif
             /* Call the controller receive interface, the callbackFn is initialized in
             USB_DeviceGetControllerInterface */
-            status = deviceHandle->controllerInterface->deviceRecv(deviceHandle->controllerHandle, endpointAddress,
+            status = USB_DEVICE_CONTROLLER(deviceHandle, Recv)(deviceHandle->controllerHandle, endpointAddress,
                                                                    buffer, length);
         }
         if (kStatus_USB_Success != status)
@@ -353,7 +413,7 @@ static usb_status_t USB_DeviceControl(usb_device_handle handle, usb_device_contr
     {
         /* Call the controller control interface. the controllerInterface is initialized in
         USB_DeviceGetControllerInterface */
-        status = deviceHandle->controllerInterface->deviceControl(deviceHandle->controllerHandle, type, param);
+        status = USB_DEVICE_CONTROLLER(deviceHandle, Control)(deviceHandle->controllerHandle, type, param);
     }
     else
     {
@@ -415,6 +475,10 @@ static usb_status_t USB_DeviceResetNotification(usb_device_struct_t *handle,
     handle->state         = (uint8_t)kUSB_DeviceStateDefault;
     handle->deviceAddress = 0U;
 
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+    /* The selection is kept, the endpoints are active again when they are initialized. */
+    handle->epDirectCallbackActive = 0U;
+#endif
     for (count = 0U; count < (USB_DEVICE_CONFIG_ENDPOINTS * 2U); count++)
     {
         handle->epCallback[count].callbackFn    = (usb_device_endpoint_callback_t)NULL;
@@ -708,6 +772,34 @@ usb_status_t USB_DeviceNotificationTrigger(void *handle, void *msg)
 #endif
 }
 
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+/*!
+ * @brief Notify the endpoint callback that a transfer is done.
+ *
+ * This function calls the endpoint callback without the notification message and its decoding, the controller
+ * driver calls it when USB_DEVICE_ENDPOINT_DIRECT_CALLBACK is true for the endpoint.
+ *
+ * @param handle                 The device handle. It equals the value returned from USB_DeviceInit.
+ * @param index                  The endpoint index, (endpoint number << 1) | direction.
+ * @param buffer                 The transfer buffer.
+ * @param length                 The transferred length.
+ *
+ * @return The endpoint callback return value.
+ */
+usb_status_t USB_DeviceEndpointNotificationTrigger(void *handle, uint8_t index, uint8_t *buffer, uint32_t length)
+{
+    usb_device_struct_t *deviceHandle                 = (usb_device_struct_t *)handle;
+    usb_device_endpoint_callback_struct_t *epCallback = &deviceHandle->epCallback[index];
+    usb_device_endpoint_callback_message_struct_t endpointCallbackMessage;
+
+    endpointCallbackMessage.buffer  = buffer;
+    endpointCallbackMessage.length  = length;
+    endpointCallbackMessage.isSetup = 0U;
+    epCallback->isBusy              = 0U;
+    return epCallback->callbackFn(deviceHandle, &endpointCallbackMessage, epCallback->callbackParam);
+}
+#endif
+
 /*!
  * @brief Initialize the USB device stack.
  *
@@ -829,7 +921,7 @@ usb_status_t USB_DeviceInit(uint8_t controllerId, usb_device_callback_t deviceCa
     *handle = deviceHandle;
 
     /* Initialize the controller, the callbackFn is initialized in USB_DeviceGetControllerInterface */
-    error = deviceHandle->controllerInterface->deviceInit(controllerId, deviceHandle, &deviceHandle->controllerHandle);
+    error = USB_DEVICE_CONTROLLER(deviceHandle, Init)(controllerId, deviceHandle, &deviceHandle->controllerHandle);
     if (kStatus_USB_Success != error)
     {
 #if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
@@ -905,12 +997,12 @@ usb_status_t USB_DeviceDeinit(usb_device_handle handle)
     {
         /* the callbackFn is initialized in USB_DeviceGetControllerInterface */
 #if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
-        if (kStatus_USB_Success != deviceHandle->controllerInterface->deviceDeinit(deviceHandle->controllerHandle))
+        if (kStatus_USB_Success != USB_DEVICE_CONTROLLER(deviceHandle, Deinit)(deviceHandle->controllerHandle))
         {
             return kStatus_USB_Error;
         }
 #else
-        (void)deviceHandle->controllerInterface->deviceDeinit(deviceHandle->controllerHandle);
+        (void)USB_DEVICE_CONTROLLER(deviceHandle, Deinit)(deviceHandle->controllerHandle);
 #endif
         deviceHandle->controllerInterface = (usb_device_controller_interface_struct_t *)NULL;
     }
@@ -1032,7 +1124,7 @@ usb_status_t USB_DeviceCancel(usb_device_handle handle, uint8_t endpointAddress)
     if (NULL != deviceHandle->controllerInterface)
     {
         /* the callbackFn is initialized in USB_DeviceGetControllerInterface */
-        status = deviceHandle->controllerInterface->deviceCancel(deviceHandle->controllerHandle, endpointAddress);
+        status = USB_DEVICE_CONTROLLER(deviceHandle, Cancel)(deviceHandle->controllerHandle, endpointAddress);
     }
     else
     {
@@ -1065,6 +1157,9 @@ usb_status_t USB_DeviceInitEndpoint(usb_device_handle handle,
     usb_device_struct_t *deviceHandle = (usb_device_struct_t *)handle;
     uint8_t endpoint;
     uint8_t direction;
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+    OSA_SR_ALLOC();
+#endif
 
     if (NULL == deviceHandle)
     {
@@ -1086,6 +1181,15 @@ usb_status_t USB_DeviceInitEndpoint(usb_device_handle handle,
         deviceHandle->epCallback[(uint8_t)((uint32_t)endpoint << 1U) | direction].callbackParam =
             epCallback->callbackParam;
         deviceHandle->epCallback[(uint8_t)((uint32_t)endpoint << 1U) | direction].isBusy = 0U;
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+        if ((NULL != epCallback->callbackFn) &&
+            (0U != (deviceHandle->epDirectCallbackRequest & (1UL << (((uint32_t)endpoint << 1U) | direction)))))
+        {
+            OSA_ENTER_CRITICAL();
+            deviceHandle->epDirectCallbackActive |= (1UL << (((uint32_t)endpoint << 1U) | direction));
+            OSA_EXIT_CRITICAL();
+        }
+#endif
     }
     else
     {
@@ -1115,7 +1219,8 @@ usb_status_t USB_DeviceDeinitEndpoint(usb_device_handle handle, uint8_t endpoint
     uint8_t direction                 = (endpointAddress & USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK) >>
                         USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT;
     usb_status_t status;
-#if (defined(USB_DEVICE_CONFIG_USE_TASK) && (USB_DEVICE_CONFIG_USE_TASK > 0U))
+#if ((defined(USB_DEVICE_CONFIG_USE_TASK) && (USB_DEVICE_CONFIG_USE_TASK > 0U)) || \
+     (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U)))
     OSA_SR_ALLOC();
 #endif
 
@@ -1137,6 +1242,11 @@ usb_status_t USB_DeviceDeinitEndpoint(usb_device_handle handle, uint8_t endpoint
 
     if (endpoint < USB_DEVICE_CONFIG_ENDPOINTS)
     {
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+        OSA_ENTER_CRITICAL();
+        deviceHandle->epDirectCallbackActive &= ~(1UL << (((uint32_t)endpoint << 1U) | direction));
+        OSA_EXIT_CRITICAL();
+#endif
         deviceHandle->epCallback[(uint8_t)((uint32_t)endpoint << 1U) | direction].callbackFn =
             (usb_device_endpoint_callback_t)NULL;
         deviceHandle->epCallback[(uint8_t)((uint32_t)endpoint << 1U) | direction].callbackParam = NULL;
@@ -1149,6 +1259,60 @@ usb_status_t USB_DeviceDeinitEndpoint(usb_device_handle handle, uint8_t endpoint
     return status;
 }
 
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+/*!
+ * @brief Select the direct callback mode of a specified endpoint.
+ *
+ * The function is used to select the direct callback mode of a specified endpoint.
+ *
+ * @param handle The device handle got from USB_DeviceInit.
+ * @param endpointAddress Endpoint address, bit7 is the direction of endpoint, 1U - IN, and 0U - OUT.
+ * @param enable 1U - the endpoint callback is called from the controller interrupt, 0U - through the notification.
+ *
+ * @retval kStatus_USB_Success              The mode is selected successfully.
+ * @retval kStatus_USB_InvalidHandle        The handle is a NULL pointer.
+ * @retval kStatus_USB_InvalidParameter     The endpoint is the control endpoint or the endpoint number is not less than
+ * USB_DEVICE_CONFIG_ENDPOINTS.
+ */
+usb_status_t USB_DeviceSetEndpointDirectCallback(usb_device_handle handle, uint8_t endpointAddress, uint8_t enable)
+{
+    usb_device_struct_t *deviceHandle = (usb_device_struct_t *)handle;
+    uint8_t endpoint                  = endpointAddress & USB_ENDPOINT_NUMBER_MASK;
+    uint8_t direction                 = (endpointAddress & USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK) >>
+                        USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT;
+    uint32_t mask;
+    OSA_SR_ALLOC();
+
+    if (NULL == deviceHandle)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    /* The setup packets and the control transfer stages always use the notification. */
+    if ((USB_CONTROL_ENDPOINT == endpoint) || (endpoint >= USB_DEVICE_CONFIG_ENDPOINTS))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    mask = 1UL << (((uint32_t)endpoint << 1U) | direction);
+    OSA_ENTER_CRITICAL();
+    if (0U != enable)
+    {
+        deviceHandle->epDirectCallbackRequest |= mask;
+        if (NULL != deviceHandle->epCallback[(uint8_t)((uint32_t)endpoint << 1U) | direction].callbackFn)
+        {
+            deviceHandle->epDirectCallbackActive |= mask;
+        }
+    }
+    else
+    {
+        deviceHandle->epDirectCallbackRequest &= ~mask;
+        deviceHandle->epDirectCallbackActive &= ~mask;
+    }
+    OSA_EXIT_CRITICAL();
+    return kStatus_USB_Success;
+}
+#endif
+
 /*!
  * @brief Stall a specified endpoint.
  *
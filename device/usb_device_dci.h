@@ -149,8 +149,19 @@ typedef struct _usb_device_struct
 #if (defined(USB_DEVICE_CONFIG_USE_TASK) && (USB_DEVICE_CONFIG_USE_TASK > 0U))
     uint8_t epCallbackDirectly; /*!< Whether call ep callback directly when the task is enabled */
 #endif
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+    uint32_t epDirectCallbackRequest;         /*!< Endpoints selected for the direct callback, bit is the index */
+    volatile uint32_t epDirectCallbackActive; /*!< Selected endpoints that have an endpoint callback installed */
+#endif
 } usb_device_struct_t;
 
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+/*! @brief Whether the controller driver delivers the completion of the endpoint by
+ * USB_DeviceEndpointNotificationTrigger, index is (endpoint number << 1) | direction */
+#define USB_DEVICE_ENDPOINT_DIRECT_CALLBACK(handle, index) \
+    (0U != (((usb_device_struct_t *)(handle))->epDirectCallbackActive & (1UL << (index))))
+#endif
+
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -165,6 +176,25 @@ typedef struct _usb_device_struct
  * @return A USB error code or kStatus_USB_Success.
  */
 usb_status_t USB_DeviceNotificationTrigger(void *handle, void *msg);
+
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+/*!
+ * @brief Notify the endpoint callback that a transfer is done.
+ *
+ * This function is the completion fast path of the controller drivers. It is called from the token done interrupt
+ * in place of USB_DeviceNotificationTrigger when USB_DEVICE_ENDPOINT_DIRECT_CALLBACK is true for the endpoint, the
+ * endpoint callback is called at once, also when the device task is enabled. The cancelled transfers still use
+ * USB_DeviceNotificationTrigger.
+ *
+ * @param handle                 The device handle. It equals the value returned from USB_DeviceInit.
+ * @param index                  The endpoint index, (endpoint number << 1) | direction.
+ * @param buffer                 The transfer buffer.
+ * @param length                 The transferred length.
+ *
+ * @return The endpoint callback return value.
+ */
+usb_status_t USB_DeviceEndpointNotificationTrigger(void *handle, uint8_t index, uint8_t *buffer, uint32_t length);
+#endif
 /*! @}*/
 
 #endif /* __USB_DEVICE_DCI_H__ */
@@ -766,18 +766,29 @@ static void USB_DeviceEhciInterruptTokenDone(usb_device_ehci_state_struct_t *ehc
                         if ((0U != currentDtd->dtdTokenUnion.dtdTokenBitmap.ioc) ||
                             (0U == ((uint32_t)ehciState->dtdHard[index] & USB_DEVICE_ECHI_DTD_POINTER_MASK)))
                         {
-                            message.code    = endpoint | (uint8_t)((uint32_t)direction << 0x07U);
-                            message.isSetup = 0U;
-#if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
-                            if (kStatus_USB_Success != USB_DeviceNotificationTrigger(ehciState->deviceHandle, &message))
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+                            if (USB_DEVICE_ENDPOINT_DIRECT_CALLBACK(ehciState->deviceHandle, index))
                             {
+                                (void)USB_DeviceEndpointNotificationTrigger(ehciState->deviceHandle, index,
+                                                                            message.buffer, message.length);
+                            }
+                            else
+#endif
+                            {
+                                message.code    = endpoint | (uint8_t)((uint32_t)direction << 0x07U);
+                                message.isSetup = 0U;
+#if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
+                                if (kStatus_USB_Success !=
+                                    USB_DeviceNotificationTrigger(ehciState->deviceHandle, &message))
+                                {
 #if (defined(DEVICE_ECHO) && (DEVICE_ECHO > 0U))
-                                usb_echo("notification error\n");
+                                    usb_echo("notification error\n");
 #endif
-                            }
+                                }
 #else
-                            (void)USB_DeviceNotificationTrigger(ehciState->deviceHandle, &message);
+                                (void)USB_DeviceNotificationTrigger(ehciState->deviceHandle, &message);
 #endif
+                            }
                             message.buffer = NULL;
                             message.length = 0U;
                         }
@@ -46,7 +46,13 @@
 static usb_status_t USB_DeviceKhciEndpointTransfer(
     usb_device_khci_state_struct_t *khciState, uint8_t endpoint, uint8_t direction, uint8_t *buffer, uint32_t length);
 static void USB_DeviceKhciPrimeNextSetup(usb_device_khci_state_struct_t *khciState);
+#if (defined(USB_DEVICE_CONFIG_KHCI_PING_PONG) && (USB_DEVICE_CONFIG_KHCI_PING_PONG > 0U))
+static void USB_DeviceKhciEndpointPrimePingPong(usb_device_khci_state_struct_t *khciState, uint8_t endpoint);
+static void USB_DeviceKhciEndpointDisarmPingPong(usb_device_khci_state_struct_t *khciState, uint8_t endpoint);
+#endif
 static void USB_DeviceKhciSetDefaultState(usb_device_khci_state_struct_t *khciState);
+static void USB_DeviceKhciDmaAlignBufferFree(usb_device_khci_state_struct_t *khciState, uint8_t index);
+static void USB_DeviceKhciDmaAlignBufferCopy(uint8_t *destination, const uint8_t *source, uint32_t length);
 static usb_status_t USB_DeviceKhciEndpointInit(usb_device_khci_state_struct_t *khciState,
                                                usb_device_endpoint_init_struct_t *epInit);
 static usb_status_t USB_DeviceKhciEndpointDeinit(usb_device_khci_state_struct_t *khciState, uint8_t ep);
@@ -82,10 +88,10 @@ USB_GLOBAL USB_RAM_ADDRESS_ALIGNMENT(USB_DATA_ALIGN_SIZE) static usb_device_dcd_
     s_UsbDeviceDcdState[USB_DEVICE_CONFIG_KHCI];
 #endif
 
-/* Apply for KHCI DMA aligned buffer when macro USB_DEVICE_CONFIG_KHCI_DMA_ALIGN enabled */
+/* Apply for KHCI DMA aligned buffers */
 USB_GLOBAL USB_RAM_ADDRESS_ALIGNMENT(USB_DATA_ALIGN_SIZE) static uint32_t
-    s_UsbDeviceKhciDmaAlignBuffer[USB_DEVICE_CONFIG_KHCI]
-                                 [((USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_LENGTH - 1U) >> 2U) + 1U];
+    s_UsbDeviceKhciDmaAlignBuffer[USB_DEVICE_CONFIG_KHCI][USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT]
+                                 [USB_DEVICE_KHCI_DMA_ALIGN_BUFFER_SIZE / sizeof(uint32_t)];
 
 /*******************************************************************************
  * Code
@@ -116,6 +122,10 @@ static usb_status_t USB_DeviceKhciEndpointTransfer(
 
     /* Flag the endpoint is busy. */
     khciState->endpointState[index].stateUnion.stateBitField.transferring = 1U;
+#if (defined(USB_DEVICE_CONFIG_KHCI_PING_PONG) && (USB_DEVICE_CONFIG_KHCI_PING_PONG > 0U))
+    /* Only the BDT bdtOdd is armed. */
+    khciState->endpointState[index].stateUnion.stateBitField.armedCount = 1U;
+#endif
 
     /* Add the data buffer address to the BDT. */
     USB_KHCI_BDT_SET_ADDRESS((uint32_t)khciState->bdt, endpoint, direction,
@@ -135,6 +145,117 @@ static usb_status_t USB_DeviceKhciEndpointTransfer(
     return kStatus_USB_Success;
 }
 
+#if (defined(USB_DEVICE_CONFIG_KHCI_PING_PONG) && (USB_DEVICE_CONFIG_KHCI_PING_PONG > 0U))
+/*!
+ * @brief Arm the free BDT of an IN endpoint with the next packets of the transfer.
+ *
+ * The function arms the packets of the current transfer that are not armed yet, until the even and the odd BDT are
+ * both armed. The first armed BDT is bdtOdd with the data toggle data0 and the second one is the other BDT with the
+ * other data toggle, so the token done interrupt keeps toggling bdtOdd and data0 once per packet.
+ *
+ * @param khciState       Pointer of the device KHCI state structure.
+ * @param endpoint         Endpoint number.
+ *
+ */
+static void USB_DeviceKhciEndpointPrimePingPong(usb_device_khci_state_struct_t *khciState, uint8_t endpoint)
+{
+    usb_device_khci_endpoint_state_struct_t *epState = &khciState->endpointState[((uint32_t)endpoint << 1U) | USB_IN];
+    uint32_t length;
+    uint8_t odd;
+    uint8_t data0;
+    OSA_SR_ALLOC();
+
+    /* Enter critical */
+    OSA_ENTER_CRITICAL();
+
+    /* Flag the endpoint is busy. */
+    epState->stateUnion.stateBitField.transferring = 1U;
+
+    /* A zero length transfer is one zero length packet. */
+    while ((epState->stateUnion.stateBitField.armedCount < 2U) &&
+           ((epState->transferPrimed < epState->transferLength) ||
+            ((0U == epState->transferLength) && (0U == epState->stateUnion.stateBitField.armedCount))))
+    {
+        length = epState->transferLength - epState->transferPrimed;
+        if (length > epState->stateUnion.stateBitField.maxPacketSize)
+        {
+            length = epState->stateUnion.stateBitField.maxPacketSize;
+        }
+        odd   = (uint8_t)(epState->stateUnion.stateBitField.bdtOdd ^ epState->stateUnion.stateBitField.armedCount);
+        data0 = (uint8_t)(epState->stateUnion.stateBitField.data0 ^ epState->stateUnion.stateBitField.armedCount);
+
+        /* Add the data buffer address to the BDT. */
+        USB_KHCI_BDT_SET_ADDRESS((uint32_t)khciState->bdt, endpoint, USB_IN, odd,
+                                 (uint32_t)epState->transferBuffer + epState->transferPrimed);
+
+        /* Change the BDT control field to start the transfer. */
+        USB_KHCI_BDT_SET_CONTROL((uint32_t)khciState->bdt, endpoint, USB_IN, odd,
+                                 USB_LONG_TO_LITTLE_ENDIAN(USB_KHCI_BDT_BC(length) | USB_KHCI_BDT_OWN |
+                                                           USB_KHCI_BDT_DTS | USB_KHCI_BDT_DATA01(data0)));
+
+        epState->transferPrimed += length;
+        epState->stateUnion.stateBitField.armedCount++;
+    }
+
+    /* Exit critical */
+    OSA_EXIT_CRITICAL();
+
+    /* Clear the token busy state */
+    khciState->registerBase->CTL &= (uint8_t)(~USB_CTL_TXSUSPENDTOKENBUSY_MASK);
+}
+
+/*!
+ * @brief Disarm the BDTs of an IN endpoint that are armed by USB_DeviceKhciEndpointPrimePingPong.
+ *
+ * The armed BDTs are walked from bdtOdd on. A BDT that is still owned by the SIE is taken back, a BDT that the SIE has
+ * already sent is consumed, so bdtOdd and data0 are toggled for it as the token done interrupt would do. The token
+ * done interrupt of the consumed BDT is ignored after the cancel because the endpoint is not transferring anymore.
+ *
+ * @param khciState       Pointer of the device KHCI state structure.
+ * @param endpoint         Endpoint number.
+ *
+ */
+static void USB_DeviceKhciEndpointDisarmPingPong(usb_device_khci_state_struct_t *khciState, uint8_t endpoint)
+{
+    usb_device_khci_endpoint_state_struct_t *epState = &khciState->endpointState[((uint32_t)endpoint << 1U) | USB_IN];
+    uint32_t control;
+    uint8_t odd;
+    uint8_t disarmed = 0U;
+    OSA_SR_ALLOC();
+
+    /* Enter critical */
+    OSA_ENTER_CRITICAL();
+
+    while (0U != epState->stateUnion.stateBitField.armedCount)
+    {
+        odd     = (uint8_t)(epState->stateUnion.stateBitField.bdtOdd ^ disarmed);
+        control = USB_KHCI_BDT_GET_CONTROL((uint32_t)khciState->bdt, endpoint, USB_IN, odd);
+        control = USB_LONG_FROM_LITTLE_ENDIAN(control);
+        if (0U != (control & USB_KHCI_BDT_OWN))
+        {
+            /* Not sent yet, the SIE keeps using this BDT next. */
+            USB_KHCI_BDT_SET_CONTROL((uint32_t)khciState->bdt, endpoint, USB_IN, odd, 0U);
+            disarmed = 1U;
+        }
+        else if (0U == disarmed)
+        {
+            /* Sent, the next packet of the endpoint goes to the other BDT with the other data toggle. */
+            epState->stateUnion.stateBitField.bdtOdd ^= 1U;
+            epState->stateUnion.stateBitField.data0 ^= 1U;
+        }
+        else
+        {
+            /*no action*/
+        }
+        epState->stateUnion.stateBitField.armedCount--;
+    }
+    epState->transferPrimed = 0U;
+
+    /* Exit critical */
+    OSA_EXIT_CRITICAL();
+}
+#endif
+
 /*!
  * @brief Prime a next setup transfer.
  *
@@ -188,6 +309,71 @@ static void USB_DeviceKhciPrimeNextSetup(usb_device_khci_state_struct_t *khciSta
 #endif
 }
 
+/*!
+ * @brief Put the DMA align buffer of an endpoint back to the free buffers.
+ *
+ * @param khciState       Pointer of the device KHCI state structure.
+ * @param index            The endpoint index, (endpoint number << 1) | direction.
+ *
+ */
+static void USB_DeviceKhciDmaAlignBufferFree(usb_device_khci_state_struct_t *khciState, uint8_t index)
+{
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    khciState->dmaAlignBufferFree[khciState->dmaAlignBufferFreeCount] =
+        (uint8_t)khciState->endpointState[index].stateUnion.stateBitField.dmaAlignIndex;
+    khciState->dmaAlignBufferFreeCount++;
+    khciState->endpointState[index].stateUnion.stateBitField.dmaAlign = 1U;
+    OSA_EXIT_CRITICAL();
+}
+
+/*!
+ * @brief Copy the received data from a DMA align buffer.
+ *
+ * The DMA align buffer is 4-byte aligned, so the data is read word by word. The words are written by word stores
+ * when the destination is 4-byte aligned too (only the length is not aligned), or by the copy of one word otherwise.
+ *
+ * @param destination      The transfer buffer.
+ * @param source           The DMA align buffer.
+ * @param length           The data length.
+ *
+ */
+static void USB_DeviceKhciDmaAlignBufferCopy(uint8_t *destination, const uint8_t *source, uint32_t length)
+{
+    const uint32_t *source32 = (const uint32_t *)(const void *)source;
+    uint32_t word;
+
+    if (0U == ((uint32_t)destination & 0x03U))
+    {
+        uint32_t *destination32 = (uint32_t *)(void *)destination;
+        for (; length >= sizeof(uint32_t); length -= sizeof(uint32_t))
+        {
+            *destination32 = *source32;
+            destination32++;
+            source32++;
+        }
+        destination = (uint8_t *)destination32;
+    }
+    else
+    {
+        for (; length >= sizeof(uint32_t); length -= sizeof(uint32_t))
+        {
+            word = *source32;
+            (void)memcpy(destination, &word, sizeof(uint32_t));
+            destination += sizeof(uint32_t);
+            source32++;
+        }
+    }
+    source = (const uint8_t *)source32;
+    for (; length > 0U; length--)
+    {
+        *destination = *source;
+        destination++;
+        source++;
+    }
+}
+
 /*!
  * @brief Set device controller state to default state.
  *
@@ -224,7 +410,12 @@ static void USB_DeviceKhciSetDefaultState(usb_device_khci_state_struct_t *khciSt
         khciState->endpointState[((uint32_t)count << 1U) | USB_IN].stateUnion.state  = 0U;
         khciState->registerBase->ENDPOINT[count].ENDPT                               = 0x00U;
     }
-    khciState->isDmaAlignBufferInusing = 0U;
+    /* All DMA align buffers are free */
+    for (count = 0U; count < USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT; count++)
+    {
+        khciState->dmaAlignBufferFree[count] = count;
+    }
+    khciState->dmaAlignBufferFreeCount = USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT;
 
     /* Clear the BDT odd reset flag */
     khciState->registerBase->CTL &= (uint8_t)(~USB_CTL_ODDRST_MASK);
@@ -698,6 +889,13 @@ static void USB_DeviceKhciInterruptTokenDone(usb_device_khci_state_struct_t *khc
         khciState->endpointState[index].stateUnion.stateBitField.data0 ^= 1U;
         /* Change the BDT odd toggle flag */
         khciState->endpointState[index].stateUnion.stateBitField.bdtOdd ^= 1U;
+#if (defined(USB_DEVICE_CONFIG_KHCI_PING_PONG) && (USB_DEVICE_CONFIG_KHCI_PING_PONG > 0U))
+        /* The other BDT, if it is armed, is the first armed one now. */
+        if (0U != khciState->endpointState[index].stateUnion.stateBitField.armedCount)
+        {
+            khciState->endpointState[index].stateUnion.stateBitField.armedCount--;
+        }
+#endif
 
         /* Whether the transfer is completed or not. */
         /*
@@ -768,6 +966,14 @@ static void USB_DeviceKhciInterruptTokenDone(usb_device_khci_state_struct_t *khc
         }
         else
         {
+#if (defined(USB_DEVICE_CONFIG_KHCI_PING_PONG) && (USB_DEVICE_CONFIG_KHCI_PING_PONG > 0U))
+            if (USB_CONTROL_ENDPOINT != endpoint)
+            {
+                /* Arm the BDT of the done packet with the next packet, the other BDT may be in progress already. */
+                USB_DeviceKhciEndpointPrimePingPong(khciState, endpoint);
+                return;
+            }
+#endif
             /* Send remaining data and terminate the token done interrupt service. */
 #if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
             if (kStatus_USB_Success != USB_DeviceKhciSend(khciState, endpoint | (USB_IN << 0x07U),
@@ -803,9 +1009,9 @@ static void USB_DeviceKhciInterruptTokenDone(usb_device_khci_state_struct_t *khc
                     khciState->endpointState[index].transferBuffer + khciState->endpointState[index].transferDone;
                 if (buffer != transferBuffer)
                 {
-                    (void)memcpy(transferBuffer, buffer, length);
+                    USB_DeviceKhciDmaAlignBufferCopy(transferBuffer, buffer, length);
                 }
-                khciState->isDmaAlignBufferInusing = 0U;
+                USB_DeviceKhciDmaAlignBufferFree(khciState, index);
             }
             /* The transferred length */
             khciState->endpointState[index].transferDone += length;
@@ -858,20 +1064,29 @@ static void USB_DeviceKhciInterruptTokenDone(usb_device_khci_state_struct_t *khc
         }
     }
 
-    message.isSetup = isSetup;
-    message.code    = (endpoint) | (uint8_t)(((uint32_t)direction << 0x07U));
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+    if (USB_DEVICE_ENDPOINT_DIRECT_CALLBACK(khciState->deviceHandle, index))
+    {
+        (void)USB_DeviceEndpointNotificationTrigger(khciState->deviceHandle, index, message.buffer, message.length);
+    }
+    else
+#endif
+    {
+        message.isSetup = isSetup;
+        message.code    = (endpoint) | (uint8_t)(((uint32_t)direction << 0x07U));
 
-    /* Notify the up layer the KHCI status changed. */
+        /* Notify the up layer the KHCI status changed. */
 #if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
-    if (kStatus_USB_Success != USB_DeviceNotificationTrigger(khciState->deviceHandle, &message))
-    {
+        if (kStatus_USB_Success != USB_DeviceNotificationTrigger(khciState->deviceHandle, &message))
+        {
 #if (defined(DEVICE_ECHO) && (DEVICE_ECHO > 0U))
-        usb_echo("notification error\n");
+            usb_echo("notification error\n");
 #endif
-    }
+        }
 #else
-    (void)USB_DeviceNotificationTrigger(khciState->deviceHandle, &message);
+        (void)USB_DeviceNotificationTrigger(khciState->deviceHandle, &message);
 #endif
+    }
 
     khciState->registerBase->CTL &= (uint8_t)(~USB_CTL_TXSUSPENDTOKENBUSY_MASK);
 }
@@ -1181,7 +1396,7 @@ usb_status_t USB_DeviceKhciInit(uint8_t controllerId,
     khciState->registerBase = (USB_Type *)khci_base[controllerId - (uint8_t)kUSB_ControllerKhci0];
 
     khciState->dmaAlignBuffer =
-        (uint8_t *)&s_UsbDeviceKhciDmaAlignBuffer[controllerId - (uint8_t)kUSB_ControllerKhci0][0];
+        (uint8_t *)&s_UsbDeviceKhciDmaAlignBuffer[controllerId - (uint8_t)kUSB_ControllerKhci0][0][0];
 
     /* Clear all interrupt flags. */
     khciState->registerBase->ISTAT = 0xFFU;
@@ -1309,8 +1524,25 @@ usb_status_t USB_DeviceKhciSend(usb_device_controller_handle khciHandle,
         khciState->endpointState[index].transferBuffer                    = buffer;
         khciState->endpointState[index].transferLength                    = length;
         khciState->endpointState[index].stateUnion.stateBitField.dmaAlign = 1U;
+#if (defined(USB_DEVICE_CONFIG_KHCI_PING_PONG) && (USB_DEVICE_CONFIG_KHCI_PING_PONG > 0U))
+        khciState->endpointState[index].transferPrimed                      = 0U;
+        khciState->endpointState[index].stateUnion.stateBitField.armedCount = 0U;
+#endif
     }
 
+#if (defined(USB_DEVICE_CONFIG_KHCI_PING_PONG) && (USB_DEVICE_CONFIG_KHCI_PING_PONG > 0U))
+    /* The non-control IN endpoints arm two packets at most, the token done interrupt arms the next ones. */
+    if (USB_CONTROL_ENDPOINT != (endpointAddress & USB_ENDPOINT_NUMBER_MASK))
+    {
+        if (0U == khciState->isResetting)
+        {
+            USB_DeviceKhciEndpointPrimePingPong(khciState, endpointAddress & USB_ENDPOINT_NUMBER_MASK);
+            status = kStatus_USB_Success;
+        }
+        return status;
+    }
+#endif
+
     /* Data length needs to less than max packet size in each call. */
     if (length > khciState->endpointState[index].stateUnion.stateBitField.maxPacketSize)
     {
@@ -1363,6 +1595,8 @@ usb_status_t USB_DeviceKhciRecv(usb_device_controller_handle khciHandle,
     usb_device_khci_state_struct_t *khciState = (usb_device_khci_state_struct_t *)khciHandle;
     uint32_t index      = (((uint32_t)endpointAddress & USB_ENDPOINT_NUMBER_MASK) << 1U) | USB_OUT;
     usb_status_t status = kStatus_USB_Error;
+    uint8_t dmaAlignIndex;
+    OSA_SR_ALLOC();
 
     if ((0U == length) && (USB_CONTROL_ENDPOINT == (endpointAddress & USB_ENDPOINT_NUMBER_MASK)))
     {
@@ -1388,13 +1622,31 @@ usb_status_t USB_DeviceKhciRecv(usb_device_controller_handle khciHandle,
 
         buffer = (uint8_t *)((uint32_t)buffer + (uint32_t)khciState->endpointState[index].transferDone);
 
-        if ((NULL != khciState->dmaAlignBuffer) && (0U == khciState->isDmaAlignBufferInusing) &&
-            (USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_LENGTH >= length) &&
+        if ((NULL != khciState->dmaAlignBuffer) && (USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_LENGTH >= length) &&
             ((0U != (length & 0x03U)) || (0U != (((uint32_t)buffer) & 0x03U))))
         {
-            khciState->endpointState[index].stateUnion.stateBitField.dmaAlign = 0U;
-            buffer                                                            = khciState->dmaAlignBuffer;
-            khciState->isDmaAlignBufferInusing                                = 1U;
+            OSA_ENTER_CRITICAL();
+            if (0U != khciState->dmaAlignBufferFreeCount)
+            {
+                /* Take the last free DMA align buffer */
+                khciState->dmaAlignBufferFreeCount--;
+                dmaAlignIndex = khciState->dmaAlignBufferFree[khciState->dmaAlignBufferFreeCount];
+                khciState->endpointState[index].stateUnion.stateBitField.dmaAlignIndex = dmaAlignIndex;
+                khciState->endpointState[index].stateUnion.stateBitField.dmaAlign      = 0U;
+                buffer = khciState->dmaAlignBuffer + (uint32_t)dmaAlignIndex * USB_DEVICE_KHCI_DMA_ALIGN_BUFFER_SIZE;
+                khciState->dmaAlignStatistic.stagedCount++;
+                if ((USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT - (uint32_t)khciState->dmaAlignBufferFreeCount) >
+                    khciState->dmaAlignStatistic.maxInUse)
+                {
+                    khciState->dmaAlignStatistic.maxInUse =
+                        USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT - (uint32_t)khciState->dmaAlignBufferFreeCount;
+                }
+            }
+            else
+            {
+                khciState->dmaAlignStatistic.exhaustedCount++;
+            }
+            OSA_EXIT_CRITICAL();
         }
 
         /* Receive data when the device is not resetting. */
@@ -1431,7 +1683,20 @@ usb_status_t USB_DeviceKhciCancel(usb_device_controller_handle khciHandle, uint8
         message.buffer  = khciState->endpointState[index].transferBuffer;
         message.code    = ep;
         message.isSetup = 0U;
+#if (defined(USB_DEVICE_CONFIG_KHCI_PING_PONG) && (USB_DEVICE_CONFIG_KHCI_PING_PONG > 0U))
+        /* Take back the armed BDTs before the buffer is returned to the up layer. */
+        if ((USB_CONTROL_ENDPOINT != (ep & USB_ENDPOINT_NUMBER_MASK)) &&
+            (0U != (ep & USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK)))
+        {
+            USB_DeviceKhciEndpointDisarmPingPong(khciState, ep & USB_ENDPOINT_NUMBER_MASK);
+        }
+#endif
         khciState->endpointState[index].stateUnion.stateBitField.transferring = 0U;
+        /* The received data of the cancelled transfer is dropped. */
+        if (0U == khciState->endpointState[index].stateUnion.stateBitField.dmaAlign)
+        {
+            USB_DeviceKhciDmaAlignBufferFree(khciState, index);
+        }
 #if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
         if (kStatus_USB_Success != USB_DeviceNotificationTrigger(khciState->deviceHandle, &message))
         {
@@ -1649,6 +1914,38 @@ usb_status_t USB_DeviceKhciControl(usb_device_controller_handle khciHandle, usb_
     return status;
 }
 
+/*!
+ * @brief Get the DMA align buffer statistics.
+ *
+ * The function is used to get the DMA align buffer statistics of a KHCI instance.
+ *
+ * @param controllerId    The controller ID, kUSB_ControllerKhci0 or kUSB_ControllerKhci1.
+ * @param statistic       The statistics.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceKhciGetDmaAlignStatistic(uint8_t controllerId,
+                                                usb_device_khci_dma_align_statistic_struct_t *statistic)
+{
+    usb_device_khci_state_struct_t *khciState;
+    OSA_SR_ALLOC();
+
+    if ((controllerId - (uint8_t)kUSB_ControllerKhci0) >= (uint8_t)USB_DEVICE_CONFIG_KHCI)
+    {
+        return kStatus_USB_ControllerNotFound;
+    }
+    if (NULL == statistic)
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    khciState = &s_UsbDeviceKhciState[controllerId - (uint8_t)kUSB_ControllerKhci0];
+
+    OSA_ENTER_CRITICAL();
+    *statistic = khciState->dmaAlignStatistic;
+    OSA_EXIT_CRITICAL();
+    return kStatus_USB_Success;
+}
+
 /*!
  * @brief Handle the KHCI device interrupt.
  *
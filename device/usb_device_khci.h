@@ -24,6 +24,20 @@
 /*! @brief The maximum value of non-ISO maximum packet size for FS in USB specification 2.0 */
 #define USB_DEVICE_MAX_FS_NONE_ISO_MAX_PACKET_SIZE (64U)
 
+/*! @brief The DMA align buffer count of a KHCI instance, the receive transfers of different endpoints use them at the
+ * same time */
+#ifndef USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT
+#define USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT (1U)
+#endif
+
+#if (USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT > 32U)
+#error "The DMA align buffer count is not more than 32."
+#endif
+
+/*! @brief The size of one DMA align buffer, rounded up to 4 bytes */
+#define USB_DEVICE_KHCI_DMA_ALIGN_BUFFER_SIZE \
+    ((((USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_LENGTH - 1U) >> 2U) + 1U) << 2U)
+
 #define USB_KHCI_BDT_DEVICE_OUT_TOKEN   (0x01U)
 #define USB_KHCI_BDT_DEVICE_IN_TOKEN    (0x09U)
 #define USB_KHCI_BDT_DEVICE_SETUP_TOKEN (0x0DU)
@@ -92,6 +106,9 @@ typedef struct _usb_device_khci_endpoint_state_struct
     uint8_t *transferBuffer; /*!< Address of buffer containing the data to be transmitted */
     uint32_t transferLength; /*!< Length of data to transmit. */
     uint32_t transferDone;   /*!< The data length has been transferred*/
+#if (defined(USB_DEVICE_CONFIG_KHCI_PING_PONG) && (USB_DEVICE_CONFIG_KHCI_PING_PONG > 0U))
+    uint32_t transferPrimed; /*!< The data length has been armed in the BDT, the offset of the next packet */
+#endif
     union
     {
         uint32_t state; /*!< The state of the endpoint */
@@ -104,10 +121,22 @@ typedef struct _usb_device_khci_endpoint_state_struct
             uint32_t dmaAlign : 1U;       /*!< Whether the transferBuffer is DMA aligned or not */
             uint32_t transferring : 1U;   /*!< The endpoint is transferring */
             uint32_t zlt : 1U;            /*!< zlt flag */
+            uint32_t dmaAlignIndex : 5U;  /*!< The DMA align buffer used when dmaAlign is zero */
+#if (defined(USB_DEVICE_CONFIG_KHCI_PING_PONG) && (USB_DEVICE_CONFIG_KHCI_PING_PONG > 0U))
+            uint32_t armedCount : 2U; /*!< The armed BDT count, the first one is bdtOdd and the second one is !bdtOdd */
+#endif
         } stateBitField;
     } stateUnion;
 } usb_device_khci_endpoint_state_struct_t;
 
+/*! @brief The DMA align buffer statistics of a KHCI instance */
+typedef struct _usb_device_khci_dma_align_statistic_struct
+{
+    uint32_t stagedCount;    /*!< Receive packets that are staged in a DMA align buffer */
+    uint32_t exhaustedCount; /*!< Receive packets that need a DMA align buffer while all of them are in use */
+    uint32_t maxInUse;       /*!< The peak count of the DMA align buffers in use at the same time */
+} usb_device_khci_dma_align_statistic_struct_t;
+
 /*! @brief KHCI state structure */
 typedef struct _usb_device_khci_state_struct
 {
@@ -119,20 +148,20 @@ typedef struct _usb_device_khci_state_struct
 #endif
     USB_Type *registerBase;                               /*!< The base address of the register */
     uint8_t setupPacketBuffer[USB_SETUP_PACKET_SIZE * 2]; /*!< The setup request buffer */
-    uint8_t *dmaAlignBuffer; /*!< This buffer is used to fix the transferBuffer or transferLength does
-                               not align to 4-bytes when the function USB_DeviceKhciRecv is called.
-                               The macro USB_DEVICE_CONFIG_KHCI_DMA_ALIGN is used to enable or disable this feature.
-                               If the feature is enabled, when the transferBuffer or transferLength does not align to
-                               4-bytes,
-                               the transferLength is not more than USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_LENGTH, and
-                               the flag isDmaAlignBufferInusing is zero, the dmaAlignBuffer is used to receive data
-                               and the flag isDmaAlignBufferInusing is set to 1.
-                               When the transfer is done, the received data, kept in dmaAlignBuffer, is copied
-                               to the transferBuffer, and the flag isDmaAlignBufferInusing is cleared.
+    uint8_t *dmaAlignBuffer; /*!< The USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT buffers are used to fix the
+                               transferBuffer or transferLength does not align to 4-bytes when the function
+                               USB_DeviceKhciRecv is called.
+                               When the transferBuffer or transferLength does not align to 4-bytes, the
+                               transferLength is not more than USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_LENGTH, and
+                               a buffer is free, the buffer is taken from dmaAlignBufferFree to receive data.
+                               When the transfer is done or cancelled, the received data, kept in the buffer, is
+                               copied to the transferBuffer, and the buffer is put back to dmaAlignBufferFree.
                                 */
+    usb_device_khci_dma_align_statistic_struct_t dmaAlignStatistic; /*!< The DMA align buffer statistics */
     usb_device_khci_endpoint_state_struct_t
         endpointState[USB_DEVICE_CONFIG_ENDPOINTS * 2]; /*!< Endpoint state structures */
-    uint8_t isDmaAlignBufferInusing;                    /*!< The dmaAlignBuffer is used or not */
+    uint8_t dmaAlignBufferFree[USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT]; /*!< The free DMA align buffers */
+    uint8_t dmaAlignBufferFreeCount;                    /*!< The count of the free DMA align buffers */
     uint8_t isResetting;                                /*!< Is doing device reset or not */
     uint8_t controllerId;                               /*!< Controller ID */
     uint8_t setupBufferIndex;                           /*!< A valid setup buffer flag */
@@ -271,6 +300,22 @@ usb_status_t USB_DeviceKhciControl(usb_device_controller_handle khciHandle,
                                    usb_device_control_type_t type,
                                    void *param);
 
+/*!
+ * @brief Gets the DMA align buffer statistics.
+ *
+ * The statistics tell whether USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT is enough for the receive transfers of the
+ * application, the exhaustedCount packets are received to the unaligned transferBuffer directly.
+ *
+ * @param[in] controllerId    The controller ID, kUSB_ControllerKhci0 or kUSB_ControllerKhci1.
+ * @param[out] statistic      The statistics.
+ *
+ * @retval kStatus_USB_Success              Gets the statistics successfully.
+ * @retval kStatus_USB_ControllerNotFound   The controller ID is not a KHCI controller.
+ * @retval kStatus_USB_InvalidParameter     The statistic is a NULL pointer.
+ */
+usb_status_t USB_DeviceKhciGetDmaAlignStatistic(uint8_t controllerId,
+                                                usb_device_khci_dma_align_statistic_struct_t *statistic);
+
 /*! @} */
 
 #if defined(__cplusplus)
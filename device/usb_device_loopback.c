@@ -0,0 +1,1050 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_device_config.h"
+#include "usb.h"
+
+#include "usb_device.h"
+
+#if ((defined(USB_DEVICE_CONFIG_LOOPBACK)) && (USB_DEVICE_CONFIG_LOOPBACK > 0U))
+
+#include "usb_device_dci.h"
+
+#include "usb_device_loopback.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static usb_device_loopback_state_struct_t *USB_DeviceLoopbackGetState(uint8_t controllerId);
+static void USB_DeviceLoopbackSetDefaultState(usb_device_loopback_state_struct_t *loopbackState);
+static usb_status_t USB_DeviceLoopbackEndpointInit(usb_device_loopback_state_struct_t *loopbackState,
+                                                   usb_device_endpoint_init_struct_t *epInit);
+static usb_status_t USB_DeviceLoopbackEndpointDeinit(usb_device_loopback_state_struct_t *loopbackState, uint8_t ep);
+static usb_status_t USB_DeviceLoopbackEndpointStall(usb_device_loopback_state_struct_t *loopbackState, uint8_t ep);
+static usb_status_t USB_DeviceLoopbackEndpointUnstall(usb_device_loopback_state_struct_t *loopbackState, uint8_t ep);
+static void USB_DeviceLoopbackNotify(usb_device_loopback_state_struct_t *loopbackState,
+                                     uint8_t *buffer,
+                                     uint32_t length,
+                                     uint8_t code,
+                                     uint8_t isSetup);
+static void USB_DeviceLoopbackBusCharge(usb_device_loopback_state_struct_t *loopbackState,
+                                        uint32_t length,
+                                        uint8_t handshake);
+static usb_status_t USB_DeviceLoopbackTransaction(usb_device_loopback_state_struct_t *loopbackState,
+                                                  uint8_t index,
+                                                  uint8_t *buffer,
+                                                  uint32_t length,
+                                                  uint32_t *actualLength);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Apply for loopback device state structure */
+static usb_device_loopback_state_struct_t s_UsbDeviceLoopbackState[USB_DEVICE_CONFIG_LOOPBACK];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Get the loopback state of a controller id.
+ *
+ * @param controllerId    The controller id of the loopback instance.
+ *
+ * @return The loopback state, or NULL if the instance is not initialized.
+ */
+static usb_device_loopback_state_struct_t *USB_DeviceLoopbackGetState(uint8_t controllerId)
+{
+    uint8_t instance = controllerId - (uint8_t)kUSB_ControllerLoopback0;
+
+    if ((controllerId < (uint8_t)kUSB_ControllerLoopback0) || (instance >= (uint8_t)USB_DEVICE_CONFIG_LOOPBACK) ||
+        (NULL == s_UsbDeviceLoopbackState[instance].deviceHandle))
+    {
+        return NULL;
+    }
+    return &s_UsbDeviceLoopbackState[instance];
+}
+
+/*!
+ * @brief Set device controller state to default state.
+ *
+ * @param loopbackState       Pointer of the device loopback state structure.
+ *
+ */
+static void USB_DeviceLoopbackSetDefaultState(usb_device_loopback_state_struct_t *loopbackState)
+{
+    uint8_t count;
+
+    for (count = 0U; count < USB_DEVICE_CONFIG_ENDPOINTS; count++)
+    {
+        loopbackState->endpointState[((uint32_t)count << 1U) | USB_OUT].stateUnion.state = 0U;
+        loopbackState->endpointState[((uint32_t)count << 1U) | USB_IN].stateUnion.state  = 0U;
+    }
+    loopbackState->address     = 0U;
+    loopbackState->isResetting = 0U;
+}
+
+/*!
+ * @brief Initialize a specified endpoint.
+ *
+ * @param loopbackState       Pointer of the device loopback state structure.
+ * @param epInit          The endpoint initialization structure pointer.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_DeviceLoopbackEndpointInit(usb_device_loopback_state_struct_t *loopbackState,
+                                                   usb_device_endpoint_init_struct_t *epInit)
+{
+    uint16_t maxPacketSize = epInit->maxPacketSize;
+    uint8_t endpoint       = (epInit->endpointAddress & USB_ENDPOINT_NUMBER_MASK);
+    uint8_t direction      = (epInit->endpointAddress & USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK) >>
+                        USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT;
+    uint8_t index = ((uint8_t)((uint32_t)endpoint << 1U)) | (uint8_t)direction;
+
+    if (endpoint >= USB_DEVICE_CONFIG_ENDPOINTS)
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    /* Make the endpoint max packet size align with USB Specification 2.0. */
+    if (USB_SPEED_HIGH == loopbackState->speed)
+    {
+        if (maxPacketSize > USB_DEVICE_LOOPBACK_MAX_HS_MAX_PACKET_SIZE)
+        {
+            maxPacketSize = USB_DEVICE_LOOPBACK_MAX_HS_MAX_PACKET_SIZE;
+        }
+    }
+    else if (USB_ENDPOINT_ISOCHRONOUS == epInit->transferType)
+    {
+        if (maxPacketSize > USB_DEVICE_LOOPBACK_MAX_FS_ISO_MAX_PACKET_SIZE)
+        {
+            maxPacketSize = USB_DEVICE_LOOPBACK_MAX_FS_ISO_MAX_PACKET_SIZE;
+        }
+    }
+    else
+    {
+        if (maxPacketSize > USB_DEVICE_LOOPBACK_MAX_FS_NONE_ISO_MAX_PACKET_SIZE)
+        {
+            maxPacketSize = USB_DEVICE_LOOPBACK_MAX_FS_NONE_ISO_MAX_PACKET_SIZE;
+        }
+    }
+    /* A zero max packet size would never end a transfer. */
+    if (0U == maxPacketSize)
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    loopbackState->endpointState[index].stateUnion.state                       = 0U;
+    loopbackState->endpointState[index].stateUnion.stateBitField.maxPacketSize = maxPacketSize;
+    loopbackState->endpointState[index].stateUnion.stateBitField.transferType  = epInit->transferType;
+    loopbackState->endpointState[index].stateUnion.stateBitField.zlt           = epInit->zlt;
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief De-initialize a specified endpoint.
+ *
+ * Current transfer of the endpoint will be canceled and the specified endpoint will be disabled.
+ *
+ * @param loopbackState       Pointer of the device loopback state structure.
+ * @param ep               The endpoint address, Bit7, 0U - USB_OUT, 1U - USB_IN.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_DeviceLoopbackEndpointDeinit(usb_device_loopback_state_struct_t *loopbackState, uint8_t ep)
+{
+    uint8_t index = ((ep & USB_ENDPOINT_NUMBER_MASK) << 1U) |
+                    ((ep & USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK) >>
+                     USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT);
+
+    /* Cancel the transfer of the endpoint */
+#if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
+    if (kStatus_USB_Success != USB_DeviceLoopbackCancel(loopbackState, ep))
+    {
+        return kStatus_USB_Error;
+    }
+#else
+    (void)USB_DeviceLoopbackCancel(loopbackState, ep);
+#endif
+
+    /* Clear the max packet size, the endpoint does not answer the host anymore */
+    loopbackState->endpointState[index].stateUnion.state = 0U;
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Stall a specified endpoint.
+ *
+ * Current transfer of the endpoint will be canceled and the specified endpoint will be stalled.
+ * Stalling the control endpoint stalls both directions until the next setup packet.
+ *
+ * @param loopbackState       Pointer of the device loopback state structure.
+ * @param ep               The endpoint address, Bit7, 0U - USB_OUT, 1U - USB_IN.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_DeviceLoopbackEndpointStall(usb_device_loopback_state_struct_t *loopbackState, uint8_t ep)
+{
+    uint8_t endpoint = ep & USB_ENDPOINT_NUMBER_MASK;
+    uint8_t index    = ((uint8_t)((uint32_t)endpoint << 1U)) |
+                    ((ep & USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK) >>
+                     USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT);
+
+    if (USB_CONTROL_ENDPOINT == endpoint)
+    {
+        (void)USB_DeviceLoopbackCancel(loopbackState, 0x00U);
+        (void)USB_DeviceLoopbackCancel(loopbackState, 0x80U);
+        loopbackState->endpointState[0].stateUnion.stateBitField.stalled = 1U;
+        loopbackState->endpointState[1].stateUnion.stateBitField.stalled = 1U;
+    }
+    else
+    {
+        (void)USB_DeviceLoopbackCancel(loopbackState, ep);
+        loopbackState->endpointState[index].stateUnion.stateBitField.stalled = 1U;
+    }
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Un-stall a specified endpoint.
+ *
+ * Current transfer of the endpoint will be canceled and the specified endpoint will be un-stalled.
+ *
+ * @param loopbackState       Pointer of the device loopback state structure.
+ * @param ep               The endpoint address, Bit7, 0U - USB_OUT, 1U - USB_IN.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_DeviceLoopbackEndpointUnstall(usb_device_loopback_state_struct_t *loopbackState, uint8_t ep)
+{
+    uint8_t endpoint = ep & USB_ENDPOINT_NUMBER_MASK;
+    uint8_t index    = ((uint8_t)((uint32_t)endpoint << 1U)) |
+                    ((ep & USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK) >>
+                     USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT);
+
+    /* Clear the endpoint stall state */
+    loopbackState->endpointState[index].stateUnion.stateBitField.stalled = 0U;
+    /* Reset the endpoint data toggle to DATA0 */
+    loopbackState->endpointState[index].stateUnion.stateBitField.data0 = 0U;
+
+    if (USB_CONTROL_ENDPOINT != endpoint)
+    {
+        (void)USB_DeviceLoopbackCancel(loopbackState, ep);
+    }
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Notify the up layer.
+ *
+ * The function plays the role of the controller interrupt, it is called from the simulated host functions.
+ *
+ * @param loopbackState       Pointer of the device loopback state structure.
+ * @param buffer              The message buffer.
+ * @param length              The message length.
+ * @param code                The message code, the endpoint address or a usb_device_notification_t value.
+ * @param isSetup             The message is a setup packet or not.
+ */
+static void USB_DeviceLoopbackNotify(usb_device_loopback_state_struct_t *loopbackState,
+                                     uint8_t *buffer,
+                                     uint32_t length,
+                                     uint8_t code,
+                                     uint8_t isSetup)
+{
+    usb_device_callback_message_struct_t message;
+    uint32_t startCycle = (uint32_t)USB_DEVICE_LOOPBACK_CYCLE_COUNTER();
+    uint8_t isNested    = loopbackState->isNotifying;
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+    uint8_t index = (uint8_t)((uint32_t)(code & USB_ENDPOINT_NUMBER_MASK) << 1U) |
+                    (uint8_t)((uint32_t)code >> USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT);
+#endif
+
+    loopbackState->isNotifying = 1U;
+
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+    /* The completed, not cancelled, transfers of the endpoints in the direct callback mode */
+    if ((0U == (code & 0x70U)) && (USB_CANCELLED_TRANSFER_LENGTH != length) &&
+        USB_DEVICE_ENDPOINT_DIRECT_CALLBACK(loopbackState->deviceHandle, index))
+    {
+        (void)USB_DeviceEndpointNotificationTrigger(loopbackState->deviceHandle, index, buffer, length);
+    }
+    else
+#endif
+    {
+        message.buffer  = buffer;
+        message.length  = length;
+        message.code    = code;
+        message.isSetup = isSetup;
+#if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
+        if (kStatus_USB_Success != USB_DeviceNotificationTrigger(loopbackState->deviceHandle, &message))
+        {
+#if (defined(DEVICE_ECHO) && (DEVICE_ECHO > 0U))
+            usb_echo("notification error\n");
+#endif
+        }
+#else
+        (void)USB_DeviceNotificationTrigger(loopbackState->deviceHandle, &message);
+#endif
+    }
+    loopbackState->statistic.notifyCount++;
+    if (0U == isNested)
+    {
+        loopbackState->isNotifying = 0U;
+        loopbackState->statistic.stackCycles +=
+            (uint32_t)((uint32_t)USB_DEVICE_LOOPBACK_CYCLE_COUNTER() - startCycle);
+    }
+}
+
+/*!
+ * @brief Account the bus time of one transaction.
+ *
+ * A transaction never crosses a (micro-)frame boundary, it is deferred to the next SOF when it does not fit in the
+ * remaining time of the current one.
+ *
+ * @param loopbackState       Pointer of the device loopback state structure.
+ * @param length              The data packet length.
+ * @param handshake           The transaction has a handshake packet or not.
+ */
+static void USB_DeviceLoopbackBusCharge(usb_device_loopback_state_struct_t *loopbackState,
+                                        uint32_t length,
+                                        uint8_t handshake)
+{
+    uint64_t frameTime;
+    uint64_t cost;
+    uint64_t offset;
+
+    if (USB_SPEED_HIGH == loopbackState->speed)
+    {
+        frameTime = USB_DEVICE_LOOPBACK_HS_FRAME_TIME_PS;
+        cost      = (uint64_t)USB_DEVICE_LOOPBACK_HS_TRANSACTION_TIME_PS +
+               ((uint64_t)length * USB_DEVICE_LOOPBACK_HS_BYTE_TIME_PS) +
+               ((0U != handshake) ? USB_DEVICE_LOOPBACK_HS_HANDSHAKE_TIME_PS : 0U);
+    }
+    else
+    {
+        frameTime = USB_DEVICE_LOOPBACK_FS_FRAME_TIME_PS;
+        cost      = (uint64_t)USB_DEVICE_LOOPBACK_FS_TRANSACTION_TIME_PS +
+               ((uint64_t)length * USB_DEVICE_LOOPBACK_FS_BYTE_TIME_PS) +
+               ((0U != handshake) ? USB_DEVICE_LOOPBACK_FS_HANDSHAKE_TIME_PS : 0U);
+    }
+
+    offset = loopbackState->statistic.busTime % frameTime;
+    if ((offset + cost) > frameTime)
+    {
+        loopbackState->statistic.busTime += frameTime - offset;
+    }
+    loopbackState->statistic.busTime += cost;
+}
+
+/*!
+ * @brief Run one IN or OUT transaction.
+ *
+ * @param loopbackState       Pointer of the device loopback state structure.
+ * @param index               The endpoint state index.
+ * @param buffer              The host buffer of the data packet.
+ * @param length              For OUT, the data packet length. For IN, the host buffer length.
+ * @param actualLength        Return the data packet length.
+ *
+ * @return kStatus_USB_Success when the transaction is acknowledged, kStatus_USB_Busy when it is NAKed.
+ */
+static usb_status_t USB_DeviceLoopbackTransaction(usb_device_loopback_state_struct_t *loopbackState,
+                                                  uint8_t index,
+                                                  uint8_t *buffer,
+                                                  uint32_t length,
+                                                  uint32_t *actualLength)
+{
+    usb_device_loopback_endpoint_state_struct_t *epState = &loopbackState->endpointState[index];
+    uint8_t endpoint                                     = index >> 1U;
+    uint8_t direction                                    = index & 0x01U;
+    uint8_t handshake     = (USB_ENDPOINT_ISOCHRONOUS != epState->stateUnion.stateBitField.transferType) ? 1U : 0U;
+    uint32_t maxPacketSize = epState->stateUnion.stateBitField.maxPacketSize;
+    uint32_t packetLength;
+    uint8_t isDone;
+    uint8_t retry;
+    void *temp;
+
+    *actualLength = 0U;
+    loopbackState->statistic.transactionCount++;
+
+    if ((0U != epState->stateUnion.stateBitField.stalled) && (0U != handshake))
+    {
+        USB_DeviceLoopbackBusCharge(loopbackState, 0U, 1U);
+        loopbackState->statistic.stallCount++;
+        return kStatus_USB_TransferStall;
+    }
+
+    /* The endpoint is not enabled, not primed, or the bus is told to NAK. */
+    if ((0U == maxPacketSize) || (0U == epState->stateUnion.stateBitField.transferring) ||
+        (0U != loopbackState->fault.nakCount))
+    {
+        if (0U != loopbackState->fault.nakCount)
+        {
+            loopbackState->fault.nakCount--;
+        }
+        USB_DeviceLoopbackBusCharge(loopbackState, 0U, handshake);
+        loopbackState->statistic.nakCount++;
+        return kStatus_USB_Busy;
+    }
+
+    if (USB_IN == direction)
+    {
+        packetLength = epState->transferLength - epState->transferDone;
+        if (packetLength > maxPacketSize)
+        {
+            packetLength = maxPacketSize;
+        }
+    }
+    else
+    {
+        packetLength = length;
+        if ((packetLength > maxPacketSize) || (packetLength > (epState->transferLength - epState->transferDone)))
+        {
+            /* The device is not ready to take the whole packet. */
+            USB_DeviceLoopbackBusCharge(loopbackState, packetLength, 0U);
+            loopbackState->statistic.errorCount++;
+            return kStatus_USB_DataOverRun;
+        }
+    }
+
+    /* The host controller retries the transaction on bus errors. */
+    for (retry = 0U; retry < USB_DEVICE_LOOPBACK_ERROR_RETRY; retry++)
+    {
+        USB_DeviceLoopbackBusCharge(loopbackState, packetLength, handshake);
+        if ((0U == loopbackState->fault.errorInterval) ||
+            (0U != (loopbackState->statistic.transactionCount % loopbackState->fault.errorInterval)))
+        {
+            break;
+        }
+        loopbackState->statistic.errorCount++;
+        loopbackState->statistic.transactionCount++;
+#if defined(USB_DEVICE_CONFIG_ERROR_HANDLING) && (USB_DEVICE_CONFIG_ERROR_HANDLING > 0U)
+        USB_DeviceLoopbackNotify(loopbackState, (uint8_t *)NULL, 0U, (uint8_t)kUSB_DeviceNotifyError, 0U);
+#endif
+    }
+    if (retry >= USB_DEVICE_LOOPBACK_ERROR_RETRY)
+    {
+        return kStatus_USB_TransferFailed;
+    }
+
+    if (USB_IN == direction)
+    {
+        if (packetLength > length)
+        {
+            return kStatus_USB_DataOverRun;
+        }
+        if (0U != packetLength)
+        {
+            (void)memcpy(buffer, epState->transferBuffer + epState->transferDone, packetLength);
+        }
+    }
+    else
+    {
+        if (0U != packetLength)
+        {
+            (void)memcpy(epState->transferBuffer + epState->transferDone, buffer, packetLength);
+        }
+    }
+    epState->transferDone += packetLength;
+    epState->stateUnion.stateBitField.data0 ^= 1U;
+    loopbackState->statistic.byteCount += packetLength;
+    *actualLength = packetLength;
+
+    /*
+     * The transfer is completed when one of the following conditions meet:
+     * 1. The length of current transaction is less than the max packet size of the endpoint.
+     * 2. The remaining length is zero and no ZLT needs to follow.
+     */
+    isDone = (packetLength < maxPacketSize) ? 1U : 0U;
+    if ((0U == isDone) && (epState->transferDone == epState->transferLength))
+    {
+        isDone = 1U;
+        if (USB_IN == direction)
+        {
+            if (USB_CONTROL_ENDPOINT == endpoint)
+            {
+                temp                             = (void *)&loopbackState->setupPacketBuffer[0];
+                usb_setup_struct_t *setup_packet = (usb_setup_struct_t *)temp;
+                /* The ZLT is sent when the data phase is shorter than the host request. */
+                if (USB_SHORT_FROM_LITTLE_ENDIAN(setup_packet->wLength) > epState->transferLength)
+                {
+                    isDone = 0U;
+                }
+            }
+            else if (0U != epState->stateUnion.stateBitField.zlt)
+            {
+                isDone = 0U;
+            }
+            else
+            {
+                /*no action*/
+            }
+        }
+    }
+
+    if (0U != isDone)
+    {
+        epState->stateUnion.stateBitField.transferring = 0U;
+        USB_DeviceLoopbackNotify(loopbackState, epState->transferBuffer, epState->transferDone,
+                                 endpoint | (uint8_t)((uint32_t)direction << 0x07U), 0U);
+    }
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Initialize the USB device loopback instance.
+ *
+ * @param controllerId The controller id of the USB IP. Please refer to enumeration type usb_controller_index_t.
+ * @param handle        Pointer of the device handle, used to identify the device object is belonged to.
+ * @param loopbackHandle   It is out parameter, is used to return pointer of the device loopback handle to the caller.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackInit(uint8_t controllerId,
+                                    usb_device_handle handle,
+                                    usb_device_controller_handle *loopbackHandle)
+{
+    usb_device_loopback_state_struct_t *loopbackState;
+
+    if ((controllerId < (uint8_t)kUSB_ControllerLoopback0) ||
+        ((controllerId - (uint8_t)kUSB_ControllerLoopback0) >= (uint8_t)USB_DEVICE_CONFIG_LOOPBACK))
+    {
+        return kStatus_USB_ControllerNotFound;
+    }
+    loopbackState = &s_UsbDeviceLoopbackState[controllerId - (uint8_t)kUSB_ControllerLoopback0];
+
+    (void)memset(loopbackState, 0, sizeof(usb_device_loopback_state_struct_t));
+    loopbackState->controllerId = controllerId;
+    loopbackState->speed        = USB_SPEED_FULL;
+
+    USB_DeviceLoopbackSetDefaultState(loopbackState);
+
+    *loopbackHandle             = loopbackState;
+    loopbackState->deviceHandle = (usb_device_struct_t *)handle;
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief De-initialize the USB device loopback instance.
+ *
+ * @param loopbackHandle   Pointer of the device loopback handle.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackDeinit(usb_device_controller_handle loopbackHandle)
+{
+    usb_device_loopback_state_struct_t *loopbackState = (usb_device_loopback_state_struct_t *)loopbackHandle;
+
+    if (NULL == loopbackHandle)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    loopbackState->isRunning    = 0U;
+    loopbackState->deviceHandle = NULL;
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Send data through a specified endpoint.
+ *
+ * @param loopbackHandle      Pointer of the device loopback handle.
+ * @param endpointAddress Endpoint index.
+ * @param buffer           The memory address to hold the data need to be sent.
+ * @param length           The data length need to be sent.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ *
+ * @note The return value just means if the sending request is successful or not; the transfer done is notified by the
+ * corresponding callback function when the simulated host has read the data.
+ */
+usb_status_t USB_DeviceLoopbackSend(usb_device_controller_handle loopbackHandle,
+                                    uint8_t endpointAddress,
+                                    uint8_t *buffer,
+                                    uint32_t length)
+{
+    usb_device_loopback_state_struct_t *loopbackState = (usb_device_loopback_state_struct_t *)loopbackHandle;
+    uint32_t index = (((uint32_t)endpointAddress & USB_ENDPOINT_NUMBER_MASK) << 1U) | USB_IN;
+
+    if ((0U != loopbackState->isResetting) ||
+        (0U != loopbackState->endpointState[index].stateUnion.stateBitField.transferring))
+    {
+        return kStatus_USB_Error;
+    }
+
+    loopbackState->endpointState[index].transferDone                          = 0U;
+    loopbackState->endpointState[index].transferBuffer                        = buffer;
+    loopbackState->endpointState[index].transferLength                        = length;
+    loopbackState->endpointState[index].stateUnion.stateBitField.transferring = 1U;
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Receive data through a specified endpoint.
+ *
+ * @param loopbackHandle      Pointer of the device loopback handle.
+ * @param endpointAddress Endpoint index.
+ * @param buffer           The memory address to save the received data.
+ * @param length           The data length want to be received.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ *
+ * @note The return value just means if the receiving request is successful or not; the transfer done is notified by
+ * the corresponding callback function when the simulated host has written the data.
+ * A zero length receive on the control endpoint primes the status stage of a control IN transfer.
+ */
+usb_status_t USB_DeviceLoopbackRecv(usb_device_controller_handle loopbackHandle,
+                                    uint8_t endpointAddress,
+                                    uint8_t *buffer,
+                                    uint32_t length)
+{
+    usb_device_loopback_state_struct_t *loopbackState = (usb_device_loopback_state_struct_t *)loopbackHandle;
+    uint32_t index = (((uint32_t)endpointAddress & USB_ENDPOINT_NUMBER_MASK) << 1U) | USB_OUT;
+
+    if (0U != loopbackState->isResetting)
+    {
+        return kStatus_USB_Error;
+    }
+    /* A zero length receive on the control endpoint only re-arms the status stage, it may be primed again. */
+    if ((0U != loopbackState->endpointState[index].stateUnion.stateBitField.transferring) &&
+        ((0U != length) || (USB_CONTROL_ENDPOINT != (endpointAddress & USB_ENDPOINT_NUMBER_MASK))))
+    {
+        return kStatus_USB_Error;
+    }
+
+    loopbackState->endpointState[index].transferDone                          = 0U;
+    loopbackState->endpointState[index].transferBuffer                        = buffer;
+    loopbackState->endpointState[index].transferLength                        = length;
+    loopbackState->endpointState[index].stateUnion.stateBitField.transferring = 1U;
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Cancel the pending transfer in a specified endpoint.
+ *
+ * @param loopbackHandle      Pointer of the device loopback handle.
+ * @param ep               Endpoint address, bit7 is the direction of endpoint, 1U - IN, abd 0U - OUT.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackCancel(usb_device_controller_handle loopbackHandle, uint8_t ep)
+{
+    usb_device_loopback_state_struct_t *loopbackState = (usb_device_loopback_state_struct_t *)loopbackHandle;
+    uint8_t index = ((ep & USB_ENDPOINT_NUMBER_MASK) << 1U) | ((ep & USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK) >>
+                                                               USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT);
+
+    /* Cancel the transfer and notify the up layer when the endpoint is busy. */
+    if (0U != loopbackState->endpointState[index].stateUnion.stateBitField.transferring)
+    {
+        loopbackState->endpointState[index].stateUnion.stateBitField.transferring = 0U;
+        USB_DeviceLoopbackNotify(loopbackState, loopbackState->endpointState[index].transferBuffer,
+                                 USB_CANCELLED_TRANSFER_LENGTH, ep, 0U);
+    }
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Control the status of the selected item.
+ *
+ * @param loopbackHandle      Pointer of the device loopback handle.
+ * @param type             The selected item. Please refer to enumeration type usb_device_control_type_t.
+ * @param param            The param type is determined by the selected item.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackControl(usb_device_controller_handle loopbackHandle,
+                                       usb_device_control_type_t type,
+                                       void *param)
+{
+    usb_device_loopback_state_struct_t *loopbackState = (usb_device_loopback_state_struct_t *)loopbackHandle;
+    uint16_t *temp16;
+    uint8_t *temp8;
+#if defined(USB_DEVICE_CONFIG_GET_SOF_COUNT) && (USB_DEVICE_CONFIG_GET_SOF_COUNT > 0U)
+    uint32_t *temp32;
+#endif
+    uint8_t count;
+    usb_status_t status = kStatus_USB_Error;
+
+    if (NULL == loopbackHandle)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+
+    switch (type)
+    {
+        case kUSB_DeviceControlRun:
+            loopbackState->isRunning = 1U;
+            status                   = kStatus_USB_Success;
+            break;
+        case kUSB_DeviceControlStop:
+            loopbackState->isRunning = 0U;
+            status                   = kStatus_USB_Success;
+            break;
+        case kUSB_DeviceControlEndpointInit:
+            if (NULL != param)
+            {
+                status = USB_DeviceLoopbackEndpointInit(loopbackState, (usb_device_endpoint_init_struct_t *)param);
+            }
+            break;
+        case kUSB_DeviceControlEndpointDeinit:
+            if (NULL != param)
+            {
+                temp8  = (uint8_t *)param;
+                status = USB_DeviceLoopbackEndpointDeinit(loopbackState, *temp8);
+            }
+            break;
+        case kUSB_DeviceControlEndpointStall:
+            if (NULL != param)
+            {
+                temp8  = (uint8_t *)param;
+                status = USB_DeviceLoopbackEndpointStall(loopbackState, *temp8);
+            }
+            break;
+        case kUSB_DeviceControlEndpointUnstall:
+            if (NULL != param)
+            {
+                temp8  = (uint8_t *)param;
+                status = USB_DeviceLoopbackEndpointUnstall(loopbackState, *temp8);
+            }
+            break;
+        case kUSB_DeviceControlGetDeviceStatus:
+            if (NULL != param)
+            {
+                temp16  = (uint16_t *)param;
+                *temp16 = (USB_DEVICE_CONFIG_SELF_POWER << (USB_REQUEST_STANDARD_GET_STATUS_DEVICE_SELF_POWERED_SHIFT))
+#if ((defined(USB_DEVICE_CONFIG_REMOTE_WAKEUP)) && (USB_DEVICE_CONFIG_REMOTE_WAKEUP > 0U))
+                          | ((uint16_t)(((uint32_t)loopbackState->deviceHandle->remotewakeup)
+                                        << (USB_REQUEST_STANDARD_GET_STATUS_DEVICE_REMOTE_WARKUP_SHIFT)))
+#endif
+                    ;
+                status = kStatus_USB_Success;
+            }
+            break;
+        case kUSB_DeviceControlGetEndpointStatus:
+            if (NULL != param)
+            {
+                usb_device_endpoint_status_struct_t *endpointStatus = (usb_device_endpoint_status_struct_t *)param;
+
+                if (((endpointStatus->endpointAddress) & USB_ENDPOINT_NUMBER_MASK) < USB_DEVICE_CONFIG_ENDPOINTS)
+                {
+                    endpointStatus->endpointStatus = (uint16_t)(
+                        (loopbackState
+                             ->endpointState[(((endpointStatus->endpointAddress) & USB_ENDPOINT_NUMBER_MASK) << 1U) |
+                                             (((endpointStatus->endpointAddress) &
+                                               USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK) >>
+                                              USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT)]
+                             .stateUnion.stateBitField.stalled == 1U) ?
+                            kUSB_DeviceEndpointStateStalled :
+                            kUSB_DeviceEndpointStateIdle);
+                    status = kStatus_USB_Success;
+                }
+            }
+            break;
+        case kUSB_DeviceControlPreSetDeviceAddress:
+            /* The address is applied after the status stage, as the hardware does. */
+            status = kStatus_USB_Success;
+            break;
+        case kUSB_DeviceControlSetDeviceAddress:
+            if (NULL != param)
+            {
+                temp8                  = (uint8_t *)param;
+                loopbackState->address = *temp8;
+                status                 = kStatus_USB_Success;
+            }
+            break;
+        case kUSB_DeviceControlGetSynchFrame:
+            break;
+        case kUSB_DeviceControlSetDefaultStatus:
+            for (count = 0U; count < USB_DEVICE_CONFIG_ENDPOINTS; count++)
+            {
+                (void)USB_DeviceLoopbackEndpointDeinit(loopbackState, (count | (USB_IN << 0x07U)));
+                (void)USB_DeviceLoopbackEndpointDeinit(loopbackState, (count | (USB_OUT << 0x07U)));
+            }
+            USB_DeviceLoopbackSetDefaultState(loopbackState);
+            status = kStatus_USB_Success;
+            break;
+        case kUSB_DeviceControlGetSpeed:
+            if (NULL != param)
+            {
+                temp8  = (uint8_t *)param;
+                *temp8 = loopbackState->speed;
+                status = kStatus_USB_Success;
+            }
+            break;
+#if (defined(USB_DEVICE_CONFIG_CHARGER_DETECT) && (USB_DEVICE_CONFIG_CHARGER_DETECT > 0U))
+        case kUSB_DeviceControlUpdateHwTick:
+            status = kStatus_USB_Success;
+            break;
+#endif
+#if defined(USB_DEVICE_CONFIG_GET_SOF_COUNT) && (USB_DEVICE_CONFIG_GET_SOF_COUNT > 0U)
+        case kUSB_DeviceControlGetCurrentFrameCount:
+            if (NULL != param)
+            {
+                temp32 = (uint32_t *)param;
+                if (USB_SPEED_HIGH == loopbackState->speed)
+                {
+                    *temp32 = (uint32_t)(loopbackState->statistic.busTime / USB_DEVICE_LOOPBACK_HS_FRAME_TIME_PS) &
+                              USB_DEVICE_LOOPBACK_MAX_FRAME_COUNT;
+                }
+                else
+                {
+                    /* if not high speed, use frame count */
+                    *temp32 = (uint32_t)(loopbackState->statistic.busTime / USB_DEVICE_LOOPBACK_FS_FRAME_TIME_PS) &
+                              (USB_DEVICE_LOOPBACK_MAX_FRAME_COUNT >> 3U);
+                }
+                status = kStatus_USB_Success;
+            }
+            break;
+#endif
+
+        default:
+            /*no action*/
+            break;
+    }
+
+    return status;
+}
+
+/*!
+ * @brief Drive a bus reset.
+ *
+ * @param controllerId    The controller id of the loopback instance.
+ * @param speed           The speed negotiated by the reset.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackBusReset(uint8_t controllerId, uint8_t speed)
+{
+    usb_device_loopback_state_struct_t *loopbackState = USB_DeviceLoopbackGetState(controllerId);
+
+    if (NULL == loopbackState)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if ((USB_SPEED_FULL != speed) && (USB_SPEED_HIGH != speed))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    if (0U == loopbackState->isRunning)
+    {
+        return kStatus_USB_Error;
+    }
+
+    /* Reset signal lasts at least 10 ms. */
+    loopbackState->statistic.busTime += 10U * (uint64_t)USB_DEVICE_LOOPBACK_FS_FRAME_TIME_PS;
+    loopbackState->speed       = speed;
+    loopbackState->isResetting = 1U;
+
+    USB_DeviceLoopbackNotify(loopbackState, (uint8_t *)NULL, 0U, (uint8_t)kUSB_DeviceNotifyBusReset, 0U);
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Send a SETUP transaction to the control endpoint.
+ *
+ * @param controllerId    The controller id of the loopback instance.
+ * @param setup           The setup packet.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackHostSetup(uint8_t controllerId, const uint8_t *setup)
+{
+    usb_device_loopback_state_struct_t *loopbackState = USB_DeviceLoopbackGetState(controllerId);
+
+    if (NULL == loopbackState)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if ((NULL == setup) || (0U == loopbackState->isRunning) ||
+        (0U ==
+         loopbackState->endpointState[(USB_CONTROL_ENDPOINT << 1U) | USB_OUT].stateUnion.stateBitField.maxPacketSize))
+    {
+        return kStatus_USB_Error;
+    }
+
+    USB_DeviceLoopbackBusCharge(loopbackState, USB_SETUP_PACKET_SIZE, 1U);
+    loopbackState->statistic.setupCount++;
+
+    /* A setup packet aborts the previous control transfer and clears the protocol stall. */
+    loopbackState->endpointState[(USB_CONTROL_ENDPOINT << 1U) | USB_OUT].stateUnion.stateBitField.transferring = 0U;
+    loopbackState->endpointState[(USB_CONTROL_ENDPOINT << 1U) | USB_IN].stateUnion.stateBitField.transferring  = 0U;
+    loopbackState->endpointState[(USB_CONTROL_ENDPOINT << 1U) | USB_OUT].stateUnion.stateBitField.stalled      = 0U;
+    loopbackState->endpointState[(USB_CONTROL_ENDPOINT << 1U) | USB_IN].stateUnion.stateBitField.stalled       = 0U;
+    loopbackState->endpointState[(USB_CONTROL_ENDPOINT << 1U) | USB_OUT].stateUnion.stateBitField.data0        = 1U;
+    loopbackState->endpointState[(USB_CONTROL_ENDPOINT << 1U) | USB_IN].stateUnion.stateBitField.data0         = 1U;
+
+    (void)memcpy(&loopbackState->setupPacketBuffer[0], setup, USB_SETUP_PACKET_SIZE);
+    USB_DeviceLoopbackNotify(loopbackState, &loopbackState->setupPacketBuffer[0], USB_SETUP_PACKET_SIZE,
+                             USB_CONTROL_ENDPOINT | (USB_OUT << 0x07U), 1U);
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Issue IN or OUT transactions on an endpoint.
+ *
+ * @param controllerId    The controller id of the loopback instance.
+ * @param endpointAddress The endpoint address.
+ * @param buffer          The host buffer.
+ * @param length          The host buffer length.
+ * @param transferred     Return the transferred length.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackHostTransfer(
+    uint8_t controllerId, uint8_t endpointAddress, uint8_t *buffer, uint32_t length, uint32_t *transferred)
+{
+    usb_device_loopback_state_struct_t *loopbackState = USB_DeviceLoopbackGetState(controllerId);
+    uint8_t index = ((endpointAddress & USB_ENDPOINT_NUMBER_MASK) << 1U) |
+                    ((endpointAddress & USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK) >>
+                     USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT);
+    uint32_t maxPacketSize;
+    uint32_t packetLength;
+    uint32_t actualLength;
+    uint32_t done       = 0U;
+    usb_status_t status = kStatus_USB_Success;
+
+    if (NULL != transferred)
+    {
+        *transferred = 0U;
+    }
+    if (NULL == loopbackState)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if (((endpointAddress & USB_ENDPOINT_NUMBER_MASK) >= USB_DEVICE_CONFIG_ENDPOINTS) ||
+        ((NULL == buffer) && (0U != length)))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    if ((0U == loopbackState->isRunning) || (0U != loopbackState->isResetting))
+    {
+        return kStatus_USB_Error;
+    }
+
+    do
+    {
+        /* The device callback may re-initialize the endpoint, read the max packet size on each packet. */
+        maxPacketSize = loopbackState->endpointState[index].stateUnion.stateBitField.maxPacketSize;
+        packetLength  = length - done;
+        if ((0U != maxPacketSize) && (packetLength > maxPacketSize))
+        {
+            packetLength = maxPacketSize;
+        }
+        status = USB_DeviceLoopbackTransaction(loopbackState, index, (NULL != buffer) ? (buffer + done) : NULL,
+                                               packetLength, &actualLength);
+        if (kStatus_USB_Success != status)
+        {
+            break;
+        }
+        done += actualLength;
+    } while ((actualLength == maxPacketSize) && (done < length));
+
+    if (NULL != transferred)
+    {
+        *transferred = done;
+    }
+    return status;
+}
+
+/*!
+ * @brief Advance the bus time without traffic.
+ *
+ * @param controllerId    The controller id of the loopback instance.
+ * @param frames          The number of (micro-)frames.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackHostIdle(uint8_t controllerId, uint32_t frames)
+{
+    usb_device_loopback_state_struct_t *loopbackState = USB_DeviceLoopbackGetState(controllerId);
+
+    if (NULL == loopbackState)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    loopbackState->statistic.busTime +=
+        (uint64_t)frames * ((USB_SPEED_HIGH == loopbackState->speed) ? USB_DEVICE_LOOPBACK_HS_FRAME_TIME_PS :
+                                                                       USB_DEVICE_LOOPBACK_FS_FRAME_TIME_PS);
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Configure the fault injection.
+ *
+ * @param controllerId    The controller id of the loopback instance.
+ * @param fault           The fault configuration.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackSetFault(uint8_t controllerId, const usb_device_loopback_fault_struct_t *fault)
+{
+    usb_device_loopback_state_struct_t *loopbackState = USB_DeviceLoopbackGetState(controllerId);
+
+    if ((NULL == loopbackState) || (NULL == fault))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    loopbackState->fault = *fault;
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Get the bus statistics.
+ *
+ * @param controllerId    The controller id of the loopback instance.
+ * @param statistic       Return the statistics.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackGetStatistic(uint8_t controllerId, usb_device_loopback_statistic_struct_t *statistic)
+{
+    usb_device_loopback_state_struct_t *loopbackState = USB_DeviceLoopbackGetState(controllerId);
+
+    if ((NULL == loopbackState) || (NULL == statistic))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    *statistic = loopbackState->statistic;
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Get the attach status.
+ *
+ * @param controllerId    The controller id of the loopback instance.
+ * @param attached        Return the attach status.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackGetAttachStatus(uint8_t controllerId, uint8_t *attached)
+{
+    usb_device_loopback_state_struct_t *loopbackState = USB_DeviceLoopbackGetState(controllerId);
+
+    if (NULL == attached)
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    /* the instance that isn't initialized is not attached */
+    *attached = ((NULL != loopbackState) && (0U != loopbackState->isRunning)) ? 1U : 0U;
+    return kStatus_USB_Success;
+}
+
+#endif /* USB_DEVICE_CONFIG_LOOPBACK */
@@ -0,0 +1,322 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __USB_DEVICE_LOOPBACK_H__
+#define __USB_DEVICE_LOOPBACK_H__
+
+/*!
+ * @addtogroup usb_device_controller_loopback_driver
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The maximum value of ISO maximum packet size for FS in USB specification 2.0 */
+#define USB_DEVICE_LOOPBACK_MAX_FS_ISO_MAX_PACKET_SIZE (1023U)
+
+/*! @brief The maximum value of non-ISO maximum packet size for FS in USB specification 2.0 */
+#define USB_DEVICE_LOOPBACK_MAX_FS_NONE_ISO_MAX_PACKET_SIZE (64U)
+
+/*! @brief The maximum value of maximum packet size for HS in USB specification 2.0 */
+#define USB_DEVICE_LOOPBACK_MAX_HS_MAX_PACKET_SIZE (1024U)
+
+/*! @brief How many times the simulated host retries a transaction that got a bus error */
+#define USB_DEVICE_LOOPBACK_ERROR_RETRY (3U)
+
+/*
+ * Bus timing model, all values are in picoseconds.
+ * The packet costs are the SYNC, PID, CRC and EOP fields plus the inter-packet delay. Bit stuffing is not modeled.
+ */
+/*! @brief Length of one FS frame */
+#define USB_DEVICE_LOOPBACK_FS_FRAME_TIME_PS (1000000000U)
+/*! @brief Time to send one data byte at FS */
+#define USB_DEVICE_LOOPBACK_FS_BYTE_TIME_PS (666667U)
+/*! @brief Token packet plus data packet framing at FS */
+#define USB_DEVICE_LOOPBACK_FS_TRANSACTION_TIME_PS (8500000U)
+/*! @brief Handshake packet at FS */
+#define USB_DEVICE_LOOPBACK_FS_HANDSHAKE_TIME_PS (2916667U)
+/*! @brief Length of one HS micro-frame */
+#define USB_DEVICE_LOOPBACK_HS_FRAME_TIME_PS (125000000U)
+/*! @brief Time to send one data byte at HS */
+#define USB_DEVICE_LOOPBACK_HS_BYTE_TIME_PS (16667U)
+/*! @brief Token packet plus data packet framing at HS */
+#define USB_DEVICE_LOOPBACK_HS_TRANSACTION_TIME_PS (633333U)
+/*! @brief Handshake packet at HS */
+#define USB_DEVICE_LOOPBACK_HS_HANDSHAKE_TIME_PS (283333U)
+
+/*!
+ * @brief Reads the free running CPU cycle counter used by the statistics.
+ *
+ * Define it to the core cycle counter (for example DWT->CYCCNT) or to a host clock to get the CPU cycles spent in the
+ * USB stacks, the cycles are not accounted by default.
+ */
+#ifndef USB_DEVICE_LOOPBACK_CYCLE_COUNTER
+#define USB_DEVICE_LOOPBACK_CYCLE_COUNTER() (0U)
+#endif
+
+/*! @brief Fault injection configuration of the simulated bus */
+typedef struct _usb_device_loopback_fault_struct
+{
+    uint32_t nakCount;      /*!< The next nakCount data transactions are NAKed by the bus, whatever the device state */
+    uint32_t errorInterval; /*!< Every errorInterval-th data transaction gets a bus error, 0 means no error */
+} usb_device_loopback_fault_struct_t;
+
+/*! @brief Statistics of the simulated bus */
+typedef struct _usb_device_loopback_statistic_struct
+{
+    uint64_t busTime;          /*!< Elapsed bus time in picoseconds */
+    uint32_t setupCount;       /*!< SETUP transactions */
+    uint32_t transactionCount; /*!< IN and OUT transactions, including the NAKed and failed ones */
+    uint32_t nakCount;         /*!< NAKed transactions */
+    uint32_t stallCount;       /*!< STALLed transactions */
+    uint32_t errorCount;       /*!< Transactions with a bus error */
+    uint32_t byteCount;        /*!< Data bytes moved by the successful transactions */
+    uint32_t notifyCount;      /*!< Notifications delivered to the device stack, transfer done, setup and bus reset */
+    uint64_t stackCycles; /*!< CPU cycles spent in the device stack and the class drivers to handle the notifications */
+} usb_device_loopback_statistic_struct_t;
+
+/*! @brief Endpoint state structure */
+typedef struct _usb_device_loopback_endpoint_state_struct
+{
+    uint8_t *transferBuffer; /*!< Address of buffer containing the data to be transmitted */
+    uint32_t transferLength; /*!< Length of data to transmit. */
+    uint32_t transferDone;   /*!< The data length has been transferred*/
+    union
+    {
+        uint32_t state; /*!< The state of the endpoint */
+        struct
+        {
+            uint32_t maxPacketSize : 11U; /*!< The maximum packet size of the endpoint */
+            uint32_t transferType : 2U;   /*!< The transfer type of the endpoint */
+            uint32_t stalled : 1U;        /*!< The endpoint is stalled or not */
+            uint32_t data0 : 1U;          /*!< The data toggle of the transaction */
+            uint32_t transferring : 1U;   /*!< The endpoint is transferring */
+            uint32_t zlt : 1U;            /*!< zlt flag */
+        } stateBitField;
+    } stateUnion;
+} usb_device_loopback_endpoint_state_struct_t;
+
+/*! @brief Loopback state structure */
+typedef struct _usb_device_loopback_state_struct
+{
+    usb_device_struct_t *deviceHandle;                /*!< Device handle used to identify the device object */
+    usb_device_loopback_fault_struct_t fault;         /*!< Fault injection configuration */
+    usb_device_loopback_statistic_struct_t statistic; /*!< Bus statistics */
+    uint8_t setupPacketBuffer[USB_SETUP_PACKET_SIZE]; /*!< The setup request buffer */
+    usb_device_loopback_endpoint_state_struct_t
+        endpointState[USB_DEVICE_CONFIG_ENDPOINTS * 2]; /*!< Endpoint state structures */
+    uint8_t controllerId;                               /*!< Controller ID */
+    uint8_t speed;                                      /*!< Bus speed, USB_SPEED_FULL or USB_SPEED_HIGH */
+    uint8_t address;                                    /*!< Device address */
+    uint8_t isRunning;                                  /*!< The device is connected to the bus or not */
+    uint8_t isResetting;                                /*!< Is doing device reset or not */
+    uint8_t isNotifying;                                /*!< Is notifying the device stack or not */
+} usb_device_loopback_state_struct_t;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name USB device loopback functions
+ * @{
+ */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Initializes the USB device loopback instance.
+ *
+ * This function initializes the software loopback controller specified by the controllerId.
+ * The controller has no hardware behind it, the bus is driven by the simulated host functions below.
+ *
+ * @param[in] controllerId    The controller ID, kUSB_ControllerLoopback0 or kUSB_ControllerLoopback1.
+ * @param[in] handle          Pointer of the device handle used to identify the device object belongs to.
+ * @param[out] loopbackHandle An out parameter used to return the pointer of the device loopback handle to the caller.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackInit(uint8_t controllerId,
+                                    usb_device_handle handle,
+                                    usb_device_controller_handle *loopbackHandle);
+
+/*!
+ * @brief Deinitializes the USB device loopback instance.
+ *
+ * @param[in] loopbackHandle Pointer of the device loopback handle.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackDeinit(usb_device_controller_handle loopbackHandle);
+
+/*!
+ * @brief Sends data through a specified endpoint.
+ *
+ * The data is moved when the simulated host issues IN transactions on the endpoint.
+ *
+ * @param[in] loopbackHandle  Pointer of the device loopback handle.
+ * @param[in] endpointAddress Endpoint index.
+ * @param[in] buffer          The memory address to hold the data need to be sent.
+ * @param[in] length          The data length need to be sent.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackSend(usb_device_controller_handle loopbackHandle,
+                                    uint8_t endpointAddress,
+                                    uint8_t *buffer,
+                                    uint32_t length);
+
+/*!
+ * @brief Receives data through a specified endpoint.
+ *
+ * The data is moved when the simulated host issues OUT transactions on the endpoint.
+ *
+ * @param[in] loopbackHandle  Pointer of the device loopback handle.
+ * @param[in] endpointAddress Endpoint index.
+ * @param[in] buffer          The memory address to save the received data.
+ * @param[in] length          The data length to be received.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackRecv(usb_device_controller_handle loopbackHandle,
+                                    uint8_t endpointAddress,
+                                    uint8_t *buffer,
+                                    uint32_t length);
+
+/*!
+ * @brief Cancels the pending transfer in a specified endpoint.
+ *
+ * @param[in] loopbackHandle Pointer of the device loopback handle.
+ * @param[in] ep             Endpoint address, bit7 is the direction of endpoint, 1U - IN, 0U - OUT.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackCancel(usb_device_controller_handle loopbackHandle, uint8_t ep);
+
+/*!
+ * @brief Controls the status of the selected item.
+ *
+ * @param[in] loopbackHandle Pointer of the device loopback handle.
+ * @param[in] type           The selected item. See enumeration type usb_device_control_type_t.
+ * @param[in,out] param      The parameter type is determined by the selected item.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackControl(usb_device_controller_handle loopbackHandle,
+                                       usb_device_control_type_t type,
+                                       void *param);
+
+/*! @} */
+
+/*!
+ * @name Simulated host functions
+ *
+ * These functions play the role of the host and of the controller interrupt. The device stack is notified
+ * synchronously from them, so they must not be called concurrently with each other or from a device callback.
+ * @{
+ */
+
+/*!
+ * @brief Drives a bus reset.
+ *
+ * @param[in] controllerId The controller ID of the loopback instance.
+ * @param[in] speed        The speed negotiated by the reset, USB_SPEED_FULL or USB_SPEED_HIGH.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackBusReset(uint8_t controllerId, uint8_t speed);
+
+/*!
+ * @brief Sends a SETUP transaction to the control endpoint.
+ *
+ * A SETUP transaction is always acknowledged. It clears the control endpoint stall and aborts the pending
+ * data and status stages.
+ *
+ * @param[in] controllerId The controller ID of the loopback instance.
+ * @param[in] setup        The 8 bytes setup packet.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackHostSetup(uint8_t controllerId, const uint8_t *setup);
+
+/*!
+ * @brief Issues IN or OUT transactions on an endpoint.
+ *
+ * The transfer is split into max packet size transactions. It ends when the length is reached, on a short packet,
+ * or when a transaction is not acknowledged. A zero length OUT transfer sends one zero length packet.
+ *
+ * @param[in] controllerId    The controller ID of the loopback instance.
+ * @param[in] endpointAddress The endpoint address, bit7 is the direction, 1U - IN, 0U - OUT.
+ * @param[in] buffer          The host buffer.
+ * @param[in] length          The host buffer length.
+ * @param[out] transferred    The transferred length, may be NULL.
+ *
+ * @retval kStatus_USB_Success        The transfer is done.
+ * @retval kStatus_USB_Busy           The endpoint NAKed, the transferred data is kept and the transfer can be resumed.
+ * @retval kStatus_USB_TransferStall  The endpoint is stalled.
+ * @retval kStatus_USB_TransferFailed A transaction failed USB_DEVICE_LOOPBACK_ERROR_RETRY times in a row.
+ * @retval kStatus_USB_DataOverRun    The device sent more data than the host buffer can hold.
+ */
+usb_status_t USB_DeviceLoopbackHostTransfer(
+    uint8_t controllerId, uint8_t endpointAddress, uint8_t *buffer, uint32_t length, uint32_t *transferred);
+
+/*!
+ * @brief Advances the bus time without traffic.
+ *
+ * @param[in] controllerId The controller ID of the loopback instance.
+ * @param[in] frames       The number of frames (FS) or micro-frames (HS) to skip.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackHostIdle(uint8_t controllerId, uint32_t frames);
+
+/*!
+ * @brief Configures the fault injection.
+ *
+ * @param[in] controllerId The controller ID of the loopback instance.
+ * @param[in] fault        The fault configuration.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackSetFault(uint8_t controllerId, const usb_device_loopback_fault_struct_t *fault);
+
+/*!
+ * @brief Gets the bus statistics.
+ *
+ * @param[in] controllerId The controller ID of the loopback instance.
+ * @param[out] statistic   The statistics.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackGetStatistic(uint8_t controllerId, usb_device_loopback_statistic_struct_t *statistic);
+
+/*!
+ * @brief Gets the attach status.
+ *
+ * The device is attached to the bus after the device stack runs the controller, it is detached after the stack
+ * stops or de-initializes it.
+ *
+ * @param[in] controllerId The controller ID of the loopback instance.
+ * @param[out] attached    1U - the device is attached, 0U - not attached.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceLoopbackGetAttachStatus(uint8_t controllerId, uint8_t *attached);
+
+/*! @} */
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @} */
+
+#endif /* __USB_DEVICE_LOOPBACK_H__ */
@@ -1388,6 +1388,14 @@ static void USB_DeviceLpc3511IpInterruptToken(usb_device_lpc3511ip_state_struct_
 #if ((defined(USB_DEVICE_IP3511_DISABLE_OUT_DOUBLE_BUFFER)) && (USB_DEVICE_IP3511_DISABLE_OUT_DOUBLE_BUFFER > 0U))
     USB_DeviceLpc3511IpDoPreviousTransactionMemcpy(lpc3511IpState, epState, len, endpointIndex,
                                                    (uint8_t)(epState->stateUnion.stateBitField.consumerOdd ^ 1U));
+#endif
+#if (defined(USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK) && (USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK > 0U))
+    if (USB_DEVICE_ENDPOINT_DIRECT_CALLBACK(lpc3511IpState->deviceHandle, endpointIndex))
+    {
+        (void)USB_DeviceEndpointNotificationTrigger(lpc3511IpState->deviceHandle, endpointIndex, message.buffer,
+                                                    message.length);
+        return;
+    }
 #endif
     /* Notify the up layer the controller status changed. */
 #if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
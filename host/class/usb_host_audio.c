@@ -19,6 +19,9 @@ typedef union usb_audio_ctrl_common_fu_desc_t
     usb_audio_ctrl_fu_desc_t fuDesc10;
     usb_audio_2_0_ctrl_fu_desc_t fuDesc20;
 } usb_audio_ctrl_common_fu_desc;
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -106,6 +109,10 @@ usb_status_t USB_HostAudioDeinit(usb_device_handle deviceHandle, usb_host_class_
 
     if (classHandle != NULL)
     {
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+        (void)USB_HostAudioStreamStop(classHandle, USB_IN);
+        (void)USB_HostAudioStreamStop(classHandle, USB_OUT);
+#endif
         if (audioPtr->isoInPipe != NULL)
         {
             status = USB_HostCancelTransfer(audioPtr->hostHandle, audioPtr->isoInPipe, NULL);
@@ -144,6 +151,24 @@ usb_status_t USB_HostAudioDeinit(usb_device_handle deviceHandle, usb_host_class_
             }
             audioPtr->isoOutPipe = NULL;
         }
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+        if (audioPtr->isoFeedbackPipe != NULL)
+        {
+            (void)USB_HostCancelTransfer(audioPtr->hostHandle, audioPtr->isoFeedbackPipe, NULL);
+            (void)USB_HostClosePipe(audioPtr->hostHandle, audioPtr->isoFeedbackPipe);
+            audioPtr->isoFeedbackPipe = NULL;
+        }
+        /* the streams are released by the canceled transfers, release the remaining ones in case the controller
+         * doesn't call back the canceled transfers */
+        if (audioPtr->inStream != NULL)
+        {
+            USB_HostClassEngineRelease(&audioPtr->inStream->engine);
+        }
+        if (audioPtr->outStream != NULL)
+        {
+            USB_HostClassEngineRelease(&audioPtr->outStream->engine);
+        }
+#endif
         (void)USB_HostCloseDeviceInterface(deviceHandle, audioPtr->streamIntfHandle);
 
         if ((audioPtr->controlPipe != NULL) && (audioPtr->controlTransfer != NULL))
@@ -308,6 +333,12 @@ static usb_status_t _USB_HostAudioInitEndpoint(audio_instance_t *audioPtr, usb_d
                                            USB_DESCRIPTOR_ENDPOINT_MAXPACKETSIZE_MULT_TRANSACTIONS_MASK));
     pipe_init.nakCount        = USB_HOST_CONFIG_MAX_NAK;
 
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+    if (ep_desc == audioPtr->feedbackEndpDesc)
+    {
+        return USB_HostOpenPipe(audioPtr->hostHandle, &audioPtr->isoFeedbackPipe, &pipe_init);
+    }
+#endif
     if (pipe_init.direction == USB_IN)
     {
         audioPtr->inPacketSize = pipe_init.maxPacketSize;
@@ -362,6 +393,13 @@ static usb_status_t _USB_HostAudioOpenInterface(audio_instance_t *audioPtr)
         }
         audioPtr->isoOutPipe = NULL;
     }
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+    if (audioPtr->isoFeedbackPipe != NULL)
+    {
+        (void)USB_HostClosePipe(audioPtr->hostHandle, audioPtr->isoFeedbackPipe);
+        audioPtr->isoFeedbackPipe = NULL;
+    }
+#endif
 
     /* open interface pipes */
     interface_ptr = (usb_host_interface_t *)audioPtr->streamIntfHandle;
@@ -459,7 +497,8 @@ usb_status_t USB_HostAudioStreamSetInterface(usb_host_class_handle classHandle,
     usb_host_interface_t *interface_ptr;
     usb_host_transfer_t *transfer;
     audio_descriptor_union_t ptr1;
-    uint32_t length = 0U, ep = 0U;
+    usb_descriptor_interface_t *interfaceDesc;
+    uint32_t ep = 0U;
     void *temp;
     usb_descriptor_endpoint_t *endpointDesc;
     if (classHandle == NULL)
@@ -475,6 +514,11 @@ usb_status_t USB_HostAudioStreamSetInterface(usb_host_class_handle classHandle,
         return status;
     }
 
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+    /* the pipes are opened again, stop the streams */
+    (void)USB_HostAudioStreamStop(classHandle, USB_IN);
+    (void)USB_HostAudioStreamStop(classHandle, USB_OUT);
+#endif
     if (audioPtr->isoInPipe != NULL)
     {
         status = USB_HostCancelTransfer(audioPtr->hostHandle, audioPtr->isoInPipe, NULL);
@@ -498,21 +542,23 @@ usb_status_t USB_HostAudioStreamSetInterface(usb_host_class_handle classHandle,
 #endif
         }
     }
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+    if (audioPtr->isoFeedbackPipe != NULL)
+    {
+        (void)USB_HostCancelTransfer(audioPtr->hostHandle, audioPtr->isoFeedbackPipe, NULL);
+    }
+    audioPtr->feedbackEndpDesc = NULL;
+#endif
     /* open interface pipes */
     interface_ptr = (usb_host_interface_t *)interfaceHandle;
-    ptr1.bufr     = interface_ptr->interfaceExtension;
-
-    length = 0U;
-    while (length < interface_ptr->interfaceExtensionLength)
+    if (USB_HostHelperGetAlternateSettingDescriptor(interfaceHandle, alternateSetting, &interfaceDesc) !=
+        kStatus_USB_Success)
     {
-        if ((ptr1.common->bDescriptorType == 0x04U) && (ptr1.interface->bAlternateSetting == alternateSetting))
-        {
-            interface_ptr->epCount = ptr1.interface->bNumEndpoints;
-            break;
-        }
-        ptr1.bufr += ptr1.common->bLength;
-        length += ptr1.common->bLength;
+        return kStatus_USB_InvalidParameter;
     }
+    temp                   = (void *)interfaceDesc;
+    ptr1.bufr              = (uint8_t *)temp;
+    interface_ptr->epCount = interfaceDesc->bNumEndpoints;
     while (ep < interface_ptr->epCount)
     {
         if (ptr1.common->bDescriptorType == 0x24U)
@@ -575,6 +621,10 @@ usb_status_t USB_HostAudioStreamSetInterface(usb_host_class_handle classHandle,
             else if (0x01U == ((endpointDesc->bmAttributes >> 4U) & 0x3U))
             {
                 /*feedback endpoint*/
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+                interface_ptr->epList[ep].epDesc = endpointDesc;
+                audioPtr->feedbackEndpDesc       = endpointDesc;
+#endif
             }
             else
             {
@@ -868,6 +918,12 @@ usb_status_t USB_HostAudioStreamRecv(usb_host_class_handle classHandle,
     {
         return kStatus_USB_Error;
     }
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+    if (audioPtr->inStream != NULL)
+    {
+        return kStatus_USB_Busy;
+    }
+#endif
 
     if (USB_HostMallocTransfer(audioPtr->hostHandle, &transfer) != kStatus_USB_Success)
     {
@@ -930,6 +986,12 @@ usb_status_t USB_HostAudioStreamSend(usb_host_class_handle classHandle,
     {
         return kStatus_USB_Error;
     }
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+    if (audioPtr->outStream != NULL)
+    {
+        return kStatus_USB_Busy;
+    }
+#endif
 
     if (USB_HostMallocTransfer(audioPtr->hostHandle, &transfer) != kStatus_USB_Success)
     {
@@ -1785,4 +1847,687 @@ usb_status_t USB_HostAudioSetStreamOutDataInterval(usb_host_class_handle classHa
 
     return status;
 }
+
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+/*!
+ * @brief update the OUT stream rate by the rate estimator.
+ *
+ * The PI controller corrects the nominal rate by the fill level error, a ring above the target level is drained
+ * faster. It runs once for every completed transfer.
+ *
+ * @param stream      the stream pointer.
+ */
+static void _USB_HostAudioStreamUpdateRate(usb_host_audio_stream_t *stream)
+{
+    int32_t limit = (int32_t)(stream->nominalRate >> USB_HOST_AUDIO_STREAM_RATE_LIMIT_SHIFT);
+    int32_t sumLimit;
+    int32_t error;
+    int32_t correction;
+
+    error = ((int32_t)USB_HostClassRingCount(&stream->ring) - (int32_t)stream->config.targetLevel) /
+            (int32_t)stream->config.frameSize;
+
+    /* the integral term alone stays in the limit, it doesn't wind up during a long underrun */
+    sumLimit = limit / (int32_t)(1UL << (16U - USB_HOST_AUDIO_STREAM_KI_SHIFT));
+    stream->levelErrorSum += error;
+    if (stream->levelErrorSum > sumLimit)
+    {
+        stream->levelErrorSum = sumLimit;
+    }
+    else if (stream->levelErrorSum < -sumLimit)
+    {
+        stream->levelErrorSum = -sumLimit;
+    }
+    else
+    {
+        /*no action*/
+    }
+
+    correction = (error * (int32_t)(1UL << (16U - USB_HOST_AUDIO_STREAM_KP_SHIFT))) +
+                 (stream->levelErrorSum * (int32_t)(1UL << (16U - USB_HOST_AUDIO_STREAM_KI_SHIFT)));
+    if (correction > limit)
+    {
+        correction = limit;
+    }
+    else if (correction < -limit)
+    {
+        correction = -limit;
+    }
+    else
+    {
+        /*no action*/
+    }
+    stream->statistic.rate = (uint32_t)((int32_t)stream->nominalRate + correction);
+}
+
+/*!
+ * @brief prepare one stream transfer.
+ *
+ * The OUT transfer takes the audio frames of each service interval from the PCM ring, the IN transfer requests the
+ * maximum packet of each service interval.
+ *
+ * @param stream      the stream pointer.
+ * @param index       the transfer index.
+ *
+ * @return 1 if the OUT transfer is padded with silence, otherwise 0.
+ */
+static uint8_t _USB_HostAudioStreamPrepare(usb_host_audio_stream_t *stream, uint32_t index)
+{
+    usb_host_transfer_t *transfer = stream->transfer[index];
+    uint8_t *buffer               = transfer->transferBuffer;
+    uint32_t offset               = 0U;
+    uint32_t length;
+    uint32_t count;
+    uint8_t underrun = 0U;
+
+    for (uint32_t packet = 0U; packet < stream->config.packetCount; packet++)
+    {
+        if (stream->direction == USB_OUT)
+        {
+            stream->rateAccumulator += stream->statistic.rate;
+            length = (stream->rateAccumulator >> 16U) * stream->config.frameSize;
+            stream->rateAccumulator &= 0xFFFFU;
+            if (length > stream->maxPacketLength)
+            {
+                length = stream->maxPacketLength - (stream->maxPacketLength % stream->config.frameSize);
+            }
+            count = 0U;
+            if (0U != stream->primed)
+            {
+                count = USB_HostClassRingGet(&stream->ring, &buffer[offset], length);
+            }
+            if (count < length)
+            {
+                (void)memset(&buffer[offset + count], 0, length - count);
+                if (0U != stream->primed)
+                {
+                    stream->statistic.underrunCount++;
+                    underrun = 1U;
+                }
+            }
+        }
+        else
+        {
+            length = stream->maxPacketLength;
+        }
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+        stream->packet[index][packet].offset = offset;
+        stream->packet[index][packet].length = length;
+#endif
+        offset += length;
+    }
+
+    transfer->transferLength = offset;
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    transfer->isoPacketDescriptor = &stream->packet[index][0];
+    transfer->isoPacketCount      = stream->config.packetCount;
+#endif
+    return underrun;
+}
+
+/*!
+ * @brief store the received data of one IN stream transfer into the PCM ring.
+ *
+ * @param stream      the stream pointer.
+ * @param transfer    the transfer.
+ * @param status      the transfer status.
+ *
+ * @return 1 if the ring overflows, otherwise 0.
+ */
+static uint8_t _USB_HostAudioStreamStore(usb_host_audio_stream_t *stream,
+                                         usb_host_transfer_t *transfer,
+                                         usb_status_t status)
+{
+    uint8_t overrun = 0U;
+
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    usb_host_iso_packet_descriptor_t *packet;
+
+    for (uint32_t index = 0U; index < transfer->isoPacketCount; index++)
+    {
+        packet = &transfer->isoPacketDescriptor[index];
+        if (packet->status != kStatus_USB_Success)
+        {
+            stream->statistic.missedPackets++;
+        }
+        else if (USB_HostClassRingPut(&stream->ring, &transfer->transferBuffer[packet->offset],
+                                      packet->actualLength) < packet->actualLength)
+        {
+            stream->statistic.overrunCount++;
+            overrun = 1U;
+        }
+        else
+        {
+            /*no action*/
+        }
+    }
+#else
+    if (status != kStatus_USB_Success)
+    {
+        stream->statistic.missedPackets++;
+    }
+    else if (USB_HostClassRingPut(&stream->ring, transfer->transferBuffer, transfer->transferSofar) <
+             transfer->transferSofar)
+    {
+        stream->statistic.overrunCount++;
+        overrun = 1U;
+    }
+    else
+    {
+        /*no action*/
+    }
+#endif
+    return overrun;
+}
+
+/*!
+ * @brief get the pipe of one stream transfer.
+ *
+ * @param audioPtr    audio instance pointer.
+ * @param stream      the stream pointer.
+ * @param transfer    the transfer.
+ *
+ * @return the pipe handle.
+ */
+static usb_host_pipe_handle _USB_HostAudioStreamPipe(audio_instance_t *audioPtr,
+                                                     usb_host_audio_stream_t *stream,
+                                                     usb_host_transfer_t *transfer)
+{
+    if (transfer == stream->feedbackTransfer)
+    {
+        return audioPtr->isoFeedbackPipe;
+    }
+    return (stream->direction == USB_IN) ? audioPtr->isoInPipe : audioPtr->isoOutPipe;
+}
+
+/*!
+ * @brief release the stream, it is called by the class engine after the transfers are freed.
+ *
+ * @param audioPtr       audio instance pointer.
+ * @param streamPointer  the stream pointer of the audio instance.
+ */
+static void _USB_HostAudioStreamRelease(audio_instance_t *audioPtr, usb_host_audio_stream_t **streamPointer)
+{
+    usb_host_audio_stream_t *stream = *streamPointer;
+
+    *streamPointer = NULL;
+    if (stream->config.callbackFn != NULL)
+    {
+        stream->config.callbackFn(stream->config.callbackParam, (uint32_t)kUSB_HostAudioStreamEventStopped,
+                                  USB_HostClassRingCount(&stream->ring));
+    }
+    OSA_MemoryFree(stream);
+}
+
+static void _USB_HostAudioStreamInRelease(void *param)
+{
+    audio_instance_t *audioPtr = (audio_instance_t *)param;
+
+    _USB_HostAudioStreamRelease(audioPtr, &audioPtr->inStream);
+}
+
+static void _USB_HostAudioStreamOutRelease(void *param)
+{
+    audio_instance_t *audioPtr = (audio_instance_t *)param;
+
+    _USB_HostAudioStreamRelease(audioPtr, &audioPtr->outStream);
+}
+
+/*!
+ * @brief handle the completion of one stream transfer and submit it again.
+ *
+ * @param audioPtr    audio instance pointer.
+ * @param stream      the stream pointer.
+ * @param transfer    callback transfer.
+ * @param status      transfer status.
+ */
+static void _USB_HostAudioStreamTransferDone(audio_instance_t *audioPtr,
+                                             usb_host_audio_stream_t *stream,
+                                             usb_host_transfer_t *transfer,
+                                             usb_status_t status)
+{
+    uint32_t index = 0U;
+    uint32_t level;
+    uint8_t xrun;
+
+    if (0U != USB_HostClassEngineTransferDone(&stream->engine, status))
+    {
+        return;
+    }
+
+    while ((index < stream->config.transferCount) && (stream->transfer[index] != transfer))
+    {
+        index++;
+    }
+
+    if (stream->direction == USB_IN)
+    {
+        xrun = _USB_HostAudioStreamStore(stream, transfer, status);
+        (void)_USB_HostAudioStreamPrepare(stream, index);
+    }
+    else
+    {
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+        for (uint32_t packet = 0U; packet < transfer->isoPacketCount; packet++)
+        {
+            if (transfer->isoPacketDescriptor[packet].status != kStatus_USB_Success)
+            {
+                stream->statistic.missedPackets++;
+            }
+        }
+#else
+        if (status != kStatus_USB_Success)
+        {
+            stream->statistic.missedPackets++;
+        }
+#endif
+        if ((0U == stream->primed) && (USB_HostClassRingCount(&stream->ring) >= stream->config.targetLevel))
+        {
+            stream->primed = 1U;
+        }
+        if ((0U != stream->primed) && (stream->config.rateSource == (uint8_t)kUSB_HostAudioStreamRateEstimator))
+        {
+            _USB_HostAudioStreamUpdateRate(stream);
+        }
+        xrun = _USB_HostAudioStreamPrepare(stream, index);
+    }
+    stream->statistic.transferCount++;
+
+    level = USB_HostClassRingCount(&stream->ring);
+    if (level < stream->statistic.minLevel)
+    {
+        stream->statistic.minLevel = level;
+    }
+    if (level > stream->statistic.maxLevel)
+    {
+        stream->statistic.maxLevel = level;
+    }
+
+    status = USB_HostClassEngineResubmit(&stream->engine, _USB_HostAudioStreamPipe(audioPtr, stream, transfer),
+                                         transfer);
+    if (status == kStatus_USB_TransferCancel)
+    {
+        /* no transfer is in flight, the stream is released */
+        return;
+    }
+    if (status != kStatus_USB_Success)
+    {
+#ifdef HOST_ECHO
+        usb_echo("audio stream fail to submit transfer\r\n");
+#endif
+        stream->statistic.missedPackets += stream->config.packetCount;
+    }
+
+    /* the stream can be stopped and released in the callback, it is not accessed after */
+    if (stream->config.callbackFn != NULL)
+    {
+        if (0U != xrun)
+        {
+            stream->config.callbackFn(stream->config.callbackParam,
+                                      (stream->direction == USB_IN) ? (uint32_t)kUSB_HostAudioStreamEventOverrun :
+                                                                      (uint32_t)kUSB_HostAudioStreamEventUnderrun,
+                                      level);
+        }
+        stream->config.callbackFn(stream->config.callbackParam, (uint32_t)kUSB_HostAudioStreamEventTransferDone,
+                                  level);
+    }
+}
+
+/*!
+ * @brief audio stream engine iso in pipe transfer callback.
+ *
+ * @param param       callback parameter.
+ * @param transfer    callback transfer.
+ * @param status      transfer status.
+ */
+static void _USB_HostAudioStreamInCallback(void *param, usb_host_transfer_t *transfer, usb_status_t status)
+{
+    audio_instance_t *audioPtr = (audio_instance_t *)param;
+
+    _USB_HostAudioStreamTransferDone(audioPtr, audioPtr->inStream, transfer, status);
+}
+
+/*!
+ * @brief audio stream engine iso out pipe transfer callback.
+ *
+ * @param param       callback parameter.
+ * @param transfer    callback transfer.
+ * @param status      transfer status.
+ */
+static void _USB_HostAudioStreamOutCallback(void *param, usb_host_transfer_t *transfer, usb_status_t status)
+{
+    audio_instance_t *audioPtr = (audio_instance_t *)param;
+
+    _USB_HostAudioStreamTransferDone(audioPtr, audioPtr->outStream, transfer, status);
+}
+
+/*!
+ * @brief audio stream engine feedback pipe transfer callback.
+ *
+ * The full-speed feedback is 10.14 audio frames per frame in 3 bytes, the high-speed feedback is 16.16 audio frames
+ * per micro-frame in 4 bytes. A value out of the nominal rate +/- 12.5% is ignored.
+ *
+ * @param param       callback parameter.
+ * @param transfer    callback transfer.
+ * @param status      transfer status.
+ */
+static void _USB_HostAudioStreamFeedbackCallback(void *param, usb_host_transfer_t *transfer, usb_status_t status)
+{
+    audio_instance_t *audioPtr      = (audio_instance_t *)param;
+    usb_host_audio_stream_t *stream = audioPtr->outStream;
+    uint8_t *data                   = transfer->transferBuffer;
+    uint32_t feedback;
+    uint32_t rate;
+
+    if (0U != USB_HostClassEngineTransferDone(&stream->engine, status))
+    {
+        return;
+    }
+
+    if ((status == kStatus_USB_Success) && (transfer->transferSofar >= 3U))
+    {
+        if (transfer->transferSofar == 3U)
+        {
+            feedback = ((uint32_t)data[0] | ((uint32_t)data[1] << 8U) | ((uint32_t)data[2] << 16U)) << 2U;
+        }
+        else
+        {
+            feedback = USB_LONG_FROM_LITTLE_ENDIAN_ADDRESS(data);
+        }
+        rate = feedback * stream->serviceInterval;
+        if ((rate >= (stream->nominalRate - (stream->nominalRate >> 3U))) &&
+            (rate <= (stream->nominalRate + (stream->nominalRate >> 3U))))
+        {
+            stream->statistic.feedback = feedback;
+            if (stream->config.rateSource == (uint8_t)kUSB_HostAudioStreamRateFeedback)
+            {
+                stream->statistic.rate = rate;
+            }
+        }
+    }
+
+    transfer->transferSofar = 0U;
+    if (USB_HostClassEngineResubmit(&stream->engine, audioPtr->isoFeedbackPipe, transfer) == kStatus_USB_Error)
+    {
+#ifdef HOST_ECHO
+        usb_echo("audio stream fail to submit feedback transfer\r\n");
+#endif
+    }
+}
+
+/*!
+ * @brief start the streaming engine of one direction.
+ *
+ * @param classHandle  the class handle.
+ * @param direction    USB_OUT or USB_IN.
+ * @param config       the stream configuration.
+ *
+ * @retval kStatus_USB_Success              The stream is started.
+ * @retval kStatus_USB_InvalidHandle        The classHandle is NULL pointer.
+ * @retval kStatus_USB_InvalidParameter     The configuration is invalid.
+ * @retval kStatus_USB_Busy                 The stream is running.
+ * @retval kStatus_USB_Error                The pipe is not initialized.
+ * @retval kStatus_USB_AllocFail            There is no memory or idle transfer.
+ */
+usb_status_t USB_HostAudioStreamStart(usb_host_class_handle classHandle,
+                                      uint8_t direction,
+                                      usb_host_audio_stream_config_t *config)
+{
+    audio_instance_t *audioPtr = (audio_instance_t *)classHandle;
+    usb_status_t status        = kStatus_USB_Success;
+    uint32_t speed             = 0U;
+    usb_host_audio_stream_t *stream;
+    usb_host_pipe_t *pipe;
+    uint32_t maxPacketLength;
+    uint32_t framesPerSecond;
+    uint8_t feedback;
+
+    if (classHandle == NULL)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if ((config == NULL) || (config->ringBuffer == NULL) || (config->transferBuffer == NULL) ||
+        (config->frameSize == 0U) || (config->ringSize < config->frameSize) ||
+        (0U != (config->ringSize % config->frameSize)) || (config->targetLevel > config->ringSize) ||
+        (config->sampleRate == 0U) || (config->transferCount == 0U) ||
+        (config->transferCount > USB_HOST_AUDIO_STREAM_MAX_TRANSFERS) || (config->packetCount == 0U) ||
+        (config->rateSource > (uint8_t)kUSB_HostAudioStreamRateEstimator))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    if (config->packetCount > USB_HOST_AUDIO_STREAM_MAX_PACKETS)
+#else
+    /* without the packet descriptors one transfer is one service interval */
+    if (config->packetCount > 1U)
+#endif
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    pipe = (usb_host_pipe_t *)((direction == USB_IN) ? audioPtr->isoInPipe : audioPtr->isoOutPipe);
+    if (pipe == NULL)
+    {
+        return kStatus_USB_Error;
+    }
+    if (((direction == USB_IN) ? audioPtr->inStream : audioPtr->outStream) != NULL)
+    {
+        return kStatus_USB_Busy;
+    }
+    feedback = ((direction == USB_OUT) && (audioPtr->isoFeedbackPipe != NULL)) ? 1U : 0U;
+    if ((0U == feedback) && (direction == USB_OUT) &&
+        (config->rateSource == (uint8_t)kUSB_HostAudioStreamRateFeedback))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    maxPacketLength = (uint32_t)pipe->maxPacketSize * ((pipe->numberPerUframe > 1U) ? pipe->numberPerUframe : 1U);
+    if (config->transferBufferSize < ((uint32_t)config->transferCount * config->packetCount * maxPacketLength))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    stream = (usb_host_audio_stream_t *)OSA_MemoryAllocate(sizeof(usb_host_audio_stream_t));
+    if (stream == NULL)
+    {
+        return kStatus_USB_AllocFail;
+    }
+    (void)memset(stream, 0, sizeof(usb_host_audio_stream_t));
+    stream->config          = *config;
+    stream->direction       = direction;
+    stream->maxPacketLength = maxPacketLength;
+    stream->serviceInterval = (pipe->interval > 0U) ? pipe->interval : 1U;
+    if (stream->config.targetLevel == 0U)
+    {
+        stream->config.targetLevel = (config->ringSize / 2U) - ((config->ringSize / 2U) % config->frameSize);
+    }
+
+    /* nominal rate = sample rate / (micro)frames per second * (micro)frames per service interval, 16.16 */
+    (void)USB_HostHelperGetPeripheralInformation(audioPtr->deviceHandle, (uint32_t)kUSB_HostGetDeviceSpeed, &speed);
+    framesPerSecond     = (speed == USB_SPEED_HIGH) ? 8000U : 1000U;
+    stream->nominalRate = ((config->sampleRate / framesPerSecond) << 16U) +
+                          (((config->sampleRate % framesPerSecond) << 16U) / framesPerSecond);
+    stream->nominalRate *= stream->serviceInterval;
+    stream->statistic.rate     = stream->nominalRate;
+    stream->statistic.minLevel = config->ringSize; /* no level seen yet, the first completion sets both */
+    stream->statistic.maxLevel = 0U;
+    USB_HostClassEngineInit(&stream->engine, audioPtr->hostHandle, &stream->transfer[0],
+                            (direction == USB_IN) ? _USB_HostAudioStreamInRelease : _USB_HostAudioStreamOutRelease,
+                            audioPtr);
+    USB_HostClassRingInit(&stream->ring, config->ringBuffer, config->ringSize, 0U);
+
+    if (direction == USB_IN)
+    {
+        audioPtr->inStream = stream;
+    }
+    else
+    {
+        audioPtr->outStream = stream;
+    }
+
+    status = USB_HostClassEngineAllocTransfer(
+        &stream->engine, config->transferCount, config->transferBuffer, config->packetCount * maxPacketLength,
+        (direction == USB_IN) ? _USB_HostAudioStreamInCallback : _USB_HostAudioStreamOutCallback, audioPtr);
+    if ((status == kStatus_USB_Success) && (0U != feedback))
+    {
+        status = USB_HostClassEngineAllocTransfer(
+            &stream->engine, 1U, (uint8_t *)&stream->feedbackData,
+            (((usb_host_pipe_t *)audioPtr->isoFeedbackPipe)->maxPacketSize < 4U) ? 3U : 4U,
+            _USB_HostAudioStreamFeedbackCallback, audioPtr);
+        stream->feedbackTransfer = stream->transfer[config->transferCount];
+    }
+    if (status != kStatus_USB_Success)
+    {
+        stream->config.callbackFn = NULL;
+        USB_HostClassEngineRelease(&stream->engine);
+        return status;
+    }
+
+    /* keep all the transfers in flight from the start */
+    for (uint32_t index = 0U; index < config->transferCount; index++)
+    {
+        (void)_USB_HostAudioStreamPrepare(stream, index);
+        status = USB_HostClassEngineSubmit(&stream->engine, pipe, stream->transfer[index]);
+        if (status != kStatus_USB_Success)
+        {
+            break;
+        }
+    }
+    if ((status == kStatus_USB_Success) && (0U != feedback))
+    {
+        status = USB_HostClassEngineSubmit(&stream->engine, audioPtr->isoFeedbackPipe, stream->feedbackTransfer);
+    }
+    if (status != kStatus_USB_Success)
+    {
+        (void)USB_HostAudioStreamStop(classHandle, direction);
+        return kStatus_USB_Error;
+    }
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief stop the streaming engine of one direction.
+ *
+ * @param classHandle  the class handle.
+ * @param direction    USB_OUT or USB_IN.
+ *
+ * @retval kStatus_USB_Success              The stream is stopping or stopped.
+ * @retval kStatus_USB_InvalidHandle        The classHandle is NULL pointer.
+ * @retval kStatus_USB_Error                The stream is not running.
+ */
+usb_status_t USB_HostAudioStreamStop(usb_host_class_handle classHandle, uint8_t direction)
+{
+    audio_instance_t *audioPtr = (audio_instance_t *)classHandle;
+    usb_host_audio_stream_t *stream;
+
+    if (classHandle == NULL)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    stream = (direction == USB_IN) ? audioPtr->inStream : audioPtr->outStream;
+    if (stream == NULL)
+    {
+        return kStatus_USB_Error;
+    }
+
+    USB_HostClassEngineStop(&stream->engine, (direction == USB_IN) ? audioPtr->isoInPipe : audioPtr->isoOutPipe,
+                            (stream->feedbackTransfer != NULL) ? audioPtr->isoFeedbackPipe : NULL);
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief write PCM data into the OUT stream ring.
+ *
+ * @param classHandle  the class handle.
+ * @param data         the PCM data.
+ * @param length       the data length.
+ *
+ * @return the written length.
+ */
+uint32_t USB_HostAudioStreamWrite(usb_host_class_handle classHandle, const uint8_t *data, uint32_t length)
+{
+    audio_instance_t *audioPtr = (audio_instance_t *)classHandle;
+    usb_host_audio_stream_t *stream;
+
+    if ((classHandle == NULL) || (data == NULL))
+    {
+        return 0U;
+    }
+    stream = audioPtr->outStream;
+    if ((stream == NULL) || (0U != stream->engine.stopping))
+    {
+        return 0U;
+    }
+
+    /* the ring keeps whole audio frames */
+    length -= length % stream->config.frameSize;
+    return USB_HostClassRingPut(&stream->ring, data, length);
+}
+
+/*!
+ * @brief read PCM data from the IN stream ring.
+ *
+ * @param classHandle  the class handle.
+ * @param data         returns the PCM data.
+ * @param length       the buffer length.
+ *
+ * @return the read length.
+ */
+uint32_t USB_HostAudioStreamRead(usb_host_class_handle classHandle, uint8_t *data, uint32_t length)
+{
+    audio_instance_t *audioPtr = (audio_instance_t *)classHandle;
+    usb_host_audio_stream_t *stream;
+
+    if ((classHandle == NULL) || (data == NULL))
+    {
+        return 0U;
+    }
+    stream = audioPtr->inStream;
+    if ((stream == NULL) || (0U != stream->engine.stopping))
+    {
+        return 0U;
+    }
+
+    return USB_HostClassRingGet(&stream->ring, data, length);
+}
+
+/*!
+ * @brief get the statistics of one stream.
+ *
+ * @param classHandle  the class handle.
+ * @param direction    USB_OUT or USB_IN.
+ * @param statistic    returns the statistics.
+ *
+ * @retval kStatus_USB_Success              The statistics are got.
+ * @retval kStatus_USB_InvalidHandle        The classHandle or statistic is NULL pointer.
+ * @retval kStatus_USB_Error                The stream is not running.
+ */
+usb_status_t USB_HostAudioStreamGetStatistic(usb_host_class_handle classHandle,
+                                             uint8_t direction,
+                                             usb_host_audio_stream_statistic_t *statistic)
+{
+    audio_instance_t *audioPtr = (audio_instance_t *)classHandle;
+    usb_host_audio_stream_t *stream;
+    OSA_SR_ALLOC();
+
+    if ((classHandle == NULL) || (statistic == NULL))
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    stream = (direction == USB_IN) ? audioPtr->inStream : audioPtr->outStream;
+    if (stream == NULL)
+    {
+        return kStatus_USB_Error;
+    }
+
+    OSA_ENTER_CRITICAL();
+    stream->statistic.level = USB_HostClassRingCount(&stream->ring);
+    *statistic              = stream->statistic;
+    /* the watermarks restart from the current level */
+    stream->statistic.minLevel = stream->statistic.level;
+    stream->statistic.maxLevel = stream->statistic.level;
+    OSA_EXIT_CRITICAL();
+    return kStatus_USB_Success;
+}
+#endif /* USB_HOST_CONFIG_AUDIO_STREAM_ENGINE */
 #endif /* USB_HOST_CONFIG_AUDIO */
@@ -9,6 +9,10 @@
 #ifndef __USB_HOST_AUDIO_H__
 #define __USB_HOST_AUDIO_H__
 
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+#include "usb_host_class_engine.h"
+#endif
+
 /*******************************************************************************
  * Audio class private structure, enumerations, macros
  ******************************************************************************/
@@ -538,6 +542,128 @@ typedef struct _usb_audio_2_0_stream_format_type_desc
     uint8_t bBitResolution;     /*!< The number of effectively used bits from the available bits in an audio subslot*/
 } usb_audio_2_0_stream_format_type_desc_t;
 
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+/*! @brief The maximum ISO transfer count the streaming engine keeps in flight for one stream */
+#ifndef USB_HOST_AUDIO_STREAM_MAX_TRANSFERS
+#define USB_HOST_AUDIO_STREAM_MAX_TRANSFERS (4U)
+#endif
+
+/*! @brief The maximum service interval count of one ISO transfer of the streaming engine */
+#ifndef USB_HOST_AUDIO_STREAM_MAX_PACKETS
+#define USB_HOST_AUDIO_STREAM_MAX_PACKETS (8U)
+#endif
+
+/*! @brief The proportional gain of the rate estimator, the correction of the fill level error E (audio frames) is
+ * E * 2^(16 - USB_HOST_AUDIO_STREAM_KP_SHIFT) in 16.16 frames per service interval */
+#ifndef USB_HOST_AUDIO_STREAM_KP_SHIFT
+#define USB_HOST_AUDIO_STREAM_KP_SHIFT (10U)
+#endif
+
+/*! @brief The integral gain of the rate estimator, the correction of the accumulated error S is
+ * S * 2^(16 - USB_HOST_AUDIO_STREAM_KI_SHIFT) in 16.16 frames per service interval */
+#ifndef USB_HOST_AUDIO_STREAM_KI_SHIFT
+#define USB_HOST_AUDIO_STREAM_KI_SHIFT (16U)
+#endif
+
+/*! @brief The rate is kept in the nominal rate +/- (nominal rate >> USB_HOST_AUDIO_STREAM_RATE_LIMIT_SHIFT) */
+#ifndef USB_HOST_AUDIO_STREAM_RATE_LIMIT_SHIFT
+#define USB_HOST_AUDIO_STREAM_RATE_LIMIT_SHIFT (6U)
+#endif
+
+/*! @brief The source of the OUT stream rate, the audio frame count sent in each service interval */
+typedef enum _usb_host_audio_stream_rate_source
+{
+    kUSB_HostAudioStreamRateNominal = 0U, /*!< The nominal rate, sample rate / service intervals per second*/
+    kUSB_HostAudioStreamRateFeedback,     /*!< The rate reported by the device feedback endpoint*/
+    kUSB_HostAudioStreamRateEstimator,    /*!< The nominal rate corrected by a PI controller that keeps the PCM ring
+                                               at the target fill level*/
+} usb_host_audio_stream_rate_source_t;
+
+/*! @brief The streaming engine events */
+typedef enum _usb_host_audio_stream_event
+{
+    kUSB_HostAudioStreamEventTransferDone = 0U, /*!< One transfer is done, the PCM ring can be written (OUT) or read
+                                                     (IN)*/
+    kUSB_HostAudioStreamEventUnderrun,          /*!< The PCM ring is empty, silence is sent (OUT)*/
+    kUSB_HostAudioStreamEventOverrun,           /*!< The PCM ring is full, received data is dropped (IN)*/
+    kUSB_HostAudioStreamEventStopped,           /*!< The stream is stopped, the buffers are released*/
+} usb_host_audio_stream_event_t;
+
+/*!
+ * @brief The streaming engine event callback.
+ *
+ * It is called in the host task (the transfer callback context).
+ *
+ * @param param  The callbackParam of the stream configuration.
+ * @param event  See the enumeration usb_host_audio_stream_event_t.
+ * @param level  The PCM ring fill level in bytes.
+ */
+typedef void (*usb_host_audio_stream_callback_t)(void *param, uint32_t event, uint32_t level);
+
+/*! @brief The streaming engine configuration */
+typedef struct _usb_host_audio_stream_config
+{
+    uint8_t *ringBuffer;         /*!< The PCM ring buffer*/
+    uint32_t ringSize;           /*!< The PCM ring size in bytes, a multiple of the frameSize*/
+    uint8_t *transferBuffer;     /*!< The ISO transfer buffers, transferCount * packetCount * (maximum packet size of
+                                      the pipe) bytes*/
+    uint32_t transferBufferSize; /*!< The ISO transfer buffers size in bytes*/
+    uint32_t sampleRate;         /*!< The nominal sample rate in Hz*/
+    uint32_t targetLevel;        /*!< The fill level the rate estimator keeps in bytes, 0 means half the ring*/
+    usb_host_audio_stream_callback_t callbackFn; /*!< The event callback, it can be NULL*/
+    void *callbackParam;                         /*!< The first parameter of the event callback*/
+    uint8_t frameSize;     /*!< The audio frame size, number of channels * subframe size in bytes*/
+    uint8_t transferCount; /*!< The ISO transfers kept in flight, 1 to USB_HOST_AUDIO_STREAM_MAX_TRANSFERS*/
+    uint8_t packetCount;   /*!< The service intervals of one transfer, 1 to USB_HOST_AUDIO_STREAM_MAX_PACKETS. It must
+                                be 1 if USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR is disabled*/
+    uint8_t rateSource;    /*!< See the enumeration usb_host_audio_stream_rate_source_t, only for the OUT stream*/
+} usb_host_audio_stream_config_t;
+
+/*! @brief The streaming engine statistics */
+typedef struct _usb_host_audio_stream_statistic
+{
+    uint32_t level;         /*!< The PCM ring fill level in bytes*/
+    uint32_t minLevel;      /*!< The lowest fill level seen at the transfer completions*/
+    uint32_t maxLevel;      /*!< The highest fill level seen at the transfer completions*/
+    uint32_t transferCount; /*!< Completed transfers*/
+    uint32_t underrunCount; /*!< OUT packets padded with silence*/
+    uint32_t overrunCount;  /*!< IN packets not stored completely*/
+    uint32_t missedPackets; /*!< Packets that are not transferred or failed*/
+    uint32_t rate;          /*!< The current rate, 16.16 audio frames per service interval*/
+    uint32_t feedback;      /*!< The last valid feedback, 16.16 audio frames per (micro)frame, 0 means no feedback*/
+} usb_host_audio_stream_statistic_t;
+
+/*!
+ * @brief The streaming engine stream structure.
+ *
+ * The class engine keeps the ISO transfers and the feedback transfer in flight. The PCM ring has one producer and
+ * one consumer, the transfer callback and USB_HostAudioStreamRead (IN), or USB_HostAudioStreamWrite and the transfer
+ * callback (OUT).
+ */
+typedef struct _usb_host_audio_stream
+{
+    usb_host_audio_stream_config_t config;       /*!< The stream configuration*/
+    usb_host_audio_stream_statistic_t statistic; /*!< The stream statistics*/
+    usb_host_class_engine_t engine;              /*!< The class engine of the transfers in flight*/
+    usb_host_class_ring_t ring;                  /*!< The PCM ring*/
+    usb_host_transfer_t
+        *transfer[USB_HOST_AUDIO_STREAM_MAX_TRANSFERS + 1U]; /*!< The ISO transfers, then the feedback transfer*/
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    usb_host_iso_packet_descriptor_t packet[USB_HOST_AUDIO_STREAM_MAX_TRANSFERS]
+                                           [USB_HOST_AUDIO_STREAM_MAX_PACKETS]; /*!< The packets of the transfers*/
+#endif
+    usb_host_transfer_t *feedbackTransfer; /*!< The feedback endpoint transfer*/
+    uint32_t feedbackData;                 /*!< The feedback endpoint transfer buffer*/
+    uint32_t nominalRate;                  /*!< The nominal rate, 16.16 audio frames per service interval*/
+    uint32_t rateAccumulator;              /*!< The fraction of the audio frames not sent yet, 16.16*/
+    int32_t levelErrorSum;                 /*!< The accumulated fill level error of the rate estimator*/
+    uint32_t maxPacketLength;              /*!< The data length of one service interval*/
+    uint32_t serviceInterval;              /*!< The (micro)frames of one service interval*/
+    uint8_t direction;                     /*!< The stream direction, USB_IN or USB_OUT*/
+    uint8_t primed; /*!< The PCM ring reached the target level once, the OUT stream sends silence until then*/
+} usb_host_audio_stream_t;
+#endif
+
 /*! @brief Audio instance structure and audio usb_host_class_handle pointer to this structure */
 typedef struct _audio_instance
 {
@@ -569,6 +695,12 @@ typedef struct _audio_instance
     uint8_t isSetup;                        /*!< Whether the audio setup transfer is transmitting*/
     uint8_t isoEpNum;                       /*!< Audio stream ISO endpoint number*/
     uint8_t streamIfnum;                    /*!< Audio stream ISO interface number*/
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+    usb_descriptor_endpoint_t *feedbackEndpDesc; /*!< Audio class ISO feedback endpoint descriptor pointer*/
+    usb_host_pipe_handle isoFeedbackPipe;        /*!< Audio class ISO feedback in pipe*/
+    usb_host_audio_stream_t *inStream;           /*!< The streaming engine IN stream*/
+    usb_host_audio_stream_t *outStream;          /*!< The streaming engine OUT stream*/
+#endif
 
 } audio_instance_t;
 
@@ -931,6 +1063,90 @@ usb_status_t USB_HostAudioGetSetEndpointRequest(usb_host_class_handle classHandl
  */
 usb_status_t USB_HostAudioSetStreamOutDataInterval(usb_host_class_handle classHandle, uint8_t intervalValue);
 
+#if ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U))
+/*!
+ * @brief Starts the streaming engine of one direction.
+ *
+ * The engine keeps config->transferCount ISO transfers in flight on the stream pipe. Each OUT transfer takes the
+ * audio frames of its service intervals from the PCM ring (silence is sent when the ring is empty), each IN transfer
+ * puts the received data into the PCM ring. The OUT packet length of each service interval follows the rate source:
+ * the nominal rate, the device feedback endpoint or the rate estimator that keeps the ring at the target level.
+ * The OUT stream sends silence until the ring reaches the target level for the first time.
+ *
+ * The transfers are allocated from the host transfer pool (plus one for the feedback endpoint) until the stream is
+ * stopped. USB_HostAudioStreamSend and USB_HostAudioStreamRecv return kStatus_USB_Busy for the running direction.
+ *
+ * @param classHandle  The class handle.
+ * @param direction    USB_OUT or USB_IN.
+ * @param config       The stream configuration, it is copied.
+ *
+ * @retval kStatus_USB_Success              The stream is started.
+ * @retval kStatus_USB_InvalidHandle        The classHandle is NULL pointer.
+ * @retval kStatus_USB_InvalidParameter     The configuration is invalid, or the feedback rate source is selected and
+ *                                          the interface has no feedback endpoint.
+ * @retval kStatus_USB_Busy                 The stream is running.
+ * @retval kStatus_USB_Error                The pipe is not initialized.
+ * @retval kStatus_USB_AllocFail            There is no memory or idle transfer.
+ */
+usb_status_t USB_HostAudioStreamStart(usb_host_class_handle classHandle,
+                                      uint8_t direction,
+                                      usb_host_audio_stream_config_t *config);
+
+/*!
+ * @brief Stops the streaming engine of one direction.
+ *
+ * The transfers in flight are canceled, kUSB_HostAudioStreamEventStopped is notified when the transfers are released.
+ * Changing the stream interface alternate setting also stops the streams.
+ *
+ * @param classHandle  The class handle.
+ * @param direction    USB_OUT or USB_IN.
+ *
+ * @retval kStatus_USB_Success              The stream is stopping or stopped.
+ * @retval kStatus_USB_InvalidHandle        The classHandle is NULL pointer.
+ * @retval kStatus_USB_Error                The stream is not running.
+ */
+usb_status_t USB_HostAudioStreamStop(usb_host_class_handle classHandle, uint8_t direction);
+
+/*!
+ * @brief Writes PCM data into the OUT stream ring.
+ *
+ * @param classHandle  The class handle.
+ * @param data         The PCM data.
+ * @param length       The data length in bytes.
+ *
+ * @return The written length, it is less than length when the ring is full.
+ */
+uint32_t USB_HostAudioStreamWrite(usb_host_class_handle classHandle, const uint8_t *data, uint32_t length);
+
+/*!
+ * @brief Reads PCM data from the IN stream ring.
+ *
+ * @param classHandle  The class handle.
+ * @param data         Returns the PCM data.
+ * @param length       The buffer length in bytes.
+ *
+ * @return The read length, it is less than length when the ring has less data.
+ */
+uint32_t USB_HostAudioStreamRead(usb_host_class_handle classHandle, uint8_t *data, uint32_t length);
+
+/*!
+ * @brief Gets the statistics of one stream.
+ *
+ * The lowest and highest fill levels are reset after they are got.
+ *
+ * @param classHandle  The class handle.
+ * @param direction    USB_OUT or USB_IN.
+ * @param statistic    Returns the statistics.
+ *
+ * @retval kStatus_USB_Success              The statistics are got.
+ * @retval kStatus_USB_InvalidHandle        The classHandle or statistic is NULL pointer.
+ * @retval kStatus_USB_Error                The stream is not running.
+ */
+usb_status_t USB_HostAudioStreamGetStatistic(usb_host_class_handle classHandle,
+                                             uint8_t direction,
+                                             usb_host_audio_stream_statistic_t *statistic);
+#endif
+
 /*! @}*/
 #ifdef __cplusplus
 }
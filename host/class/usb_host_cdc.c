@@ -456,6 +456,117 @@ static void USB_HostCdcSetContorlInterfaceCallback(void *param, usb_host_transfe
     (void)USB_HostFreeTransfer(cdcInstance->hostHandle, transfer);
 }
 
+#if ((defined(USB_HOST_CONFIG_CDC_POLL_ENGINE)) && (USB_HOST_CONFIG_CDC_POLL_ENGINE > 0U))
+#if ((defined USB_HOST_CONFIG_CLASS_AUTO_CLEAR_STALL) && USB_HOST_CONFIG_CLASS_AUTO_CLEAR_STALL)
+static void USB_HostCdcClearPollHaltCallback(void *param, usb_host_transfer_t *transfer, usb_status_t status)
+{
+    usb_host_cdc_instance_struct_t *cdcInstance = (usb_host_cdc_instance_struct_t *)param;
+
+    /* the polling engine is stopped by the stall, it is started again by the application */
+    cdcInstance->controlTransfer = NULL;
+    (void)USB_HostFreeTransfer(cdcInstance->hostHandle, transfer);
+}
+#endif
+
+/*!
+ * @brief release the polling engine, it is called by the class engine after the transfers are freed.
+ *
+ * @param param       cdc instance pointer.
+ */
+static void USB_HostCdcPollRelease(void *param)
+{
+    usb_host_cdc_instance_struct_t *cdcInstance = (usb_host_cdc_instance_struct_t *)param;
+    usb_host_cdc_poll_t *poll                   = cdcInstance->interruptPoll;
+
+    cdcInstance->interruptPoll = NULL;
+    if (poll->config.callbackFn != NULL)
+    {
+        poll->config.callbackFn(poll->config.callbackParam, (uint32_t)kUSB_HostCdcPollEventStopped, 0U);
+    }
+    OSA_MemoryFree(poll);
+}
+
+/*!
+ * @brief cdc polling engine interrupt pipe transfer callback, the transfer is armed again.
+ *
+ * @param param       callback parameter.
+ * @param transfer    callback transfer.
+ * @param status      transfer status.
+ */
+static void USB_HostCdcPollCallback(void *param, usb_host_transfer_t *transfer, usb_status_t status)
+{
+    usb_host_cdc_instance_struct_t *cdcInstance = (usb_host_cdc_instance_struct_t *)param;
+    usb_host_cdc_poll_t *poll                   = cdcInstance->interruptPoll;
+    usb_host_cdc_poll_callback_t callbackFn;
+    void *callbackParam;
+    uint32_t event = (uint32_t)kUSB_HostCdcPollEventStopped;
+
+    if (0U != USB_HostClassEngineTransferDone(&poll->engine, status))
+    {
+        return;
+    }
+
+    callbackFn    = poll->config.callbackFn;
+    callbackParam = poll->config.callbackParam;
+    if (status == kStatus_USB_TransferStall)
+    {
+        poll->statistic.errorCount++;
+#if ((defined USB_HOST_CONFIG_CLASS_AUTO_CLEAR_STALL) && USB_HOST_CONFIG_CLASS_AUTO_CLEAR_STALL)
+        (void)USB_HostCdcClearHalt(
+            cdcInstance, transfer, USB_HostCdcClearPollHaltCallback,
+            (USB_REQUEST_TYPE_DIR_IN | ((usb_host_pipe_t *)cdcInstance->interruptPipe)->endpointAddress));
+#endif
+        if (callbackFn != NULL)
+        {
+            callbackFn(callbackParam, (uint32_t)kUSB_HostCdcPollEventStall, USB_HostClassRingCount(&poll->ring));
+        }
+        /* the other armed transfers are canceled, the last one releases the engine */
+        (void)USB_HostCdcInterruptPollStop(cdcInstance);
+        return;
+    }
+
+    if (status != kStatus_USB_Success)
+    {
+        poll->statistic.errorCount++;
+    }
+    else if (transfer->transferSofar == 0U)
+    {
+        /*no action*/
+    }
+    else if (USB_HostClassRingPutRecord(&poll->ring, transfer->transferBuffer, transfer->transferSofar) > 0U)
+    {
+        poll->statistic.notificationCount++;
+        event = (uint32_t)kUSB_HostCdcPollEventNotification;
+    }
+    else
+    {
+        poll->statistic.overrunCount++;
+        event = (uint32_t)kUSB_HostCdcPollEventOverrun;
+    }
+
+    transfer->transferLength = poll->config.notificationLength;
+    status                   = USB_HostClassEngineResubmit(&poll->engine, cdcInstance->interruptPipe, transfer);
+    if (status == kStatus_USB_TransferCancel)
+    {
+        /* no transfer is armed, the engine is released */
+        return;
+    }
+    if (status != kStatus_USB_Success)
+    {
+#ifdef HOST_ECHO
+        usb_echo("cdc poll fail to arm transfer\r\n");
+#endif
+        poll->statistic.errorCount++;
+    }
+
+    /* the engine can be stopped and released in the callback, it is not accessed after */
+    if ((callbackFn != NULL) && (event != (uint32_t)kUSB_HostCdcPollEventStopped))
+    {
+        callbackFn(callbackParam, event, USB_HostClassRingCount(&poll->ring));
+    }
+}
+#endif
+
 /*!
  * @brief initialize the cdc instance.
  *
@@ -530,6 +641,9 @@ usb_status_t USB_HostCdcSetControlInterface(usb_host_class_handle classHandle,
 
     cdcInstance->controlInterfaceHandle = interfaceHandle;
 
+#if ((defined(USB_HOST_CONFIG_CDC_POLL_ENGINE)) && (USB_HOST_CONFIG_CDC_POLL_ENGINE > 0U))
+    (void)USB_HostCdcInterruptPollStop(classHandle);
+#endif
     /* cancel transfers */
     if (cdcInstance->interruptPipe != NULL)
     {
@@ -717,6 +831,9 @@ usb_status_t USB_HostCdcDeinit(usb_device_handle deviceHandle, usb_host_class_ha
 
     if (classHandle != NULL)
     {
+#if ((defined(USB_HOST_CONFIG_CDC_POLL_ENGINE)) && (USB_HOST_CONFIG_CDC_POLL_ENGINE > 0U))
+        (void)USB_HostCdcInterruptPollStop(classHandle);
+#endif
         if (cdcInstance->interruptPipe != NULL)
         {
             status = USB_HostCancelTransfer(cdcInstance->hostHandle, cdcInstance->interruptPipe, NULL);
@@ -736,6 +853,14 @@ usb_status_t USB_HostCdcDeinit(usb_device_handle deviceHandle, usb_host_class_ha
             }
             cdcInstance->interruptPipe = NULL;
         }
+#if ((defined(USB_HOST_CONFIG_CDC_POLL_ENGINE)) && (USB_HOST_CONFIG_CDC_POLL_ENGINE > 0U))
+        /* the engine is released by the canceled transfers, release it here in case the controller doesn't call back
+         * the canceled transfers */
+        if (cdcInstance->interruptPoll != NULL)
+        {
+            USB_HostClassEngineRelease(&cdcInstance->interruptPoll->engine);
+        }
+#endif
 
         (void)USB_HostCloseDeviceInterface(deviceHandle, cdcInstance->controlInterfaceHandle);
 
@@ -954,6 +1079,12 @@ usb_status_t USB_HostCdcInterruptRecv(usb_host_class_handle classHandle,
     {
         return kStatus_USB_Error;
     }
+#if ((defined(USB_HOST_CONFIG_CDC_POLL_ENGINE)) && (USB_HOST_CONFIG_CDC_POLL_ENGINE > 0U))
+    if (cdcInstance->interruptPoll != NULL)
+    {
+        return kStatus_USB_Busy;
+    }
+#endif
 
     if (USB_HostMallocTransfer(cdcInstance->hostHandle, &transfer) != kStatus_USB_Success)
     {
@@ -1300,4 +1431,172 @@ usb_status_t USB_HostCdcGetAcmDescriptor(usb_host_class_handle classHandle,
     return status;
 }
 
+#if ((defined(USB_HOST_CONFIG_CDC_POLL_ENGINE)) && (USB_HOST_CONFIG_CDC_POLL_ENGINE > 0U))
+/*!
+ * @brief start the interrupt pipe polling engine.
+ *
+ * @param classHandle  the class handle.
+ * @param config       the polling configuration.
+ *
+ * @retval kStatus_USB_Success              The engine is started.
+ * @retval kStatus_USB_InvalidHandle        The classHandle is NULL pointer.
+ * @retval kStatus_USB_InvalidParameter     The configuration is invalid.
+ * @retval kStatus_USB_Busy                 The engine is running.
+ * @retval kStatus_USB_Error                The pipe is not initialized, or the transfers fail to be armed.
+ * @retval kStatus_USB_AllocFail            There is no memory or idle transfer.
+ */
+usb_status_t USB_HostCdcInterruptPollStart(usb_host_class_handle classHandle, usb_host_cdc_poll_config_t *config)
+{
+    usb_host_cdc_instance_struct_t *cdcInstance = (usb_host_cdc_instance_struct_t *)classHandle;
+    usb_status_t status                         = kStatus_USB_Success;
+    usb_host_cdc_poll_t *poll;
+    uint32_t notificationLength;
+
+    if (classHandle == NULL)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if ((config == NULL) || (config->ringBuffer == NULL) || (config->transferBuffer == NULL) ||
+        (config->transferCount == 0U) || (config->transferCount > USB_HOST_CDC_POLL_MAX_TRANSFERS))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    if (cdcInstance->interruptPipe == NULL)
+    {
+        return kStatus_USB_Error;
+    }
+    if (cdcInstance->interruptPoll != NULL)
+    {
+        return kStatus_USB_Busy;
+    }
+    notificationLength = (config->notificationLength > 0U) ? config->notificationLength : cdcInstance->packetSize;
+    if ((notificationLength == 0U) || (config->ringSize < USB_HOST_CLASS_RING_RECORD_SIZE(notificationLength)) ||
+        (config->transferBufferSize < ((uint32_t)config->transferCount * notificationLength)))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    poll = (usb_host_cdc_poll_t *)OSA_MemoryAllocate(sizeof(usb_host_cdc_poll_t));
+    if (poll == NULL)
+    {
+        return kStatus_USB_AllocFail;
+    }
+    (void)memset(poll, 0, sizeof(usb_host_cdc_poll_t));
+    poll->config                    = *config;
+    poll->config.notificationLength = notificationLength;
+    USB_HostClassEngineInit(&poll->engine, cdcInstance->hostHandle, &poll->transfer[0], USB_HostCdcPollRelease,
+                            cdcInstance);
+    USB_HostClassRingInit(&poll->ring, config->ringBuffer, config->ringSize,
+                          USB_HOST_CLASS_RING_RECORD_SIZE(notificationLength));
+    cdcInstance->interruptPoll = poll;
+
+    if (USB_HostClassEngineAllocTransfer(&poll->engine, config->transferCount, config->transferBuffer,
+                                         notificationLength, USB_HostCdcPollCallback,
+                                         cdcInstance) != kStatus_USB_Success)
+    {
+        poll->config.callbackFn = NULL;
+        USB_HostClassEngineRelease(&poll->engine);
+        return kStatus_USB_AllocFail;
+    }
+
+    /* keep all the transfers armed from the start */
+    for (uint32_t index = 0U; index < config->transferCount; index++)
+    {
+        status = USB_HostClassEngineSubmit(&poll->engine, cdcInstance->interruptPipe, poll->transfer[index]);
+        if (status != kStatus_USB_Success)
+        {
+            break;
+        }
+    }
+    if (status != kStatus_USB_Success)
+    {
+        (void)USB_HostCdcInterruptPollStop(classHandle);
+        return kStatus_USB_Error;
+    }
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief stop the interrupt pipe polling engine.
+ *
+ * @param classHandle  the class handle.
+ *
+ * @retval kStatus_USB_Success              The engine is stopping or stopped.
+ * @retval kStatus_USB_InvalidHandle        The classHandle is NULL pointer.
+ * @retval kStatus_USB_Error                The engine is not running.
+ */
+usb_status_t USB_HostCdcInterruptPollStop(usb_host_class_handle classHandle)
+{
+    usb_host_cdc_instance_struct_t *cdcInstance = (usb_host_cdc_instance_struct_t *)classHandle;
+
+    if (classHandle == NULL)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if (cdcInstance->interruptPoll == NULL)
+    {
+        return kStatus_USB_Error;
+    }
+
+    USB_HostClassEngineStop(&cdcInstance->interruptPoll->engine, cdcInstance->interruptPipe, NULL);
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief read the oldest notification from the notification ring.
+ *
+ * @param classHandle  the class handle.
+ * @param buffer       returns the notification.
+ * @param length       the buffer length.
+ *
+ * @return the notification length, 0 when the ring is empty.
+ */
+uint32_t USB_HostCdcInterruptPollRead(usb_host_class_handle classHandle, uint8_t *buffer, uint32_t length)
+{
+    usb_host_cdc_instance_struct_t *cdcInstance = (usb_host_cdc_instance_struct_t *)classHandle;
+    usb_host_cdc_poll_t *poll;
+
+    if ((classHandle == NULL) || (buffer == NULL))
+    {
+        return 0U;
+    }
+    poll = cdcInstance->interruptPoll;
+    if ((poll == NULL) || (0U != poll->engine.stopping))
+    {
+        return 0U;
+    }
+
+    return USB_HostClassRingGetRecord(&poll->ring, buffer, length);
+}
+
+/*!
+ * @brief get the statistics of the interrupt pipe polling engine.
+ *
+ * @param classHandle  the class handle.
+ * @param statistic    returns the statistics.
+ *
+ * @retval kStatus_USB_Success              The statistics are got.
+ * @retval kStatus_USB_InvalidHandle        The classHandle or statistic is NULL pointer.
+ * @retval kStatus_USB_Error                The engine is not running.
+ */
+usb_status_t USB_HostCdcInterruptPollGetStatistic(usb_host_class_handle classHandle,
+                                                  usb_host_cdc_poll_statistic_t *statistic)
+{
+    usb_host_cdc_instance_struct_t *cdcInstance = (usb_host_cdc_instance_struct_t *)classHandle;
+
+    if ((classHandle == NULL) || (statistic == NULL))
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if (cdcInstance->interruptPoll == NULL)
+    {
+        return kStatus_USB_Error;
+    }
+
+    *statistic = cdcInstance->interruptPoll->statistic;
+    return kStatus_USB_Success;
+}
+#endif
+
 #endif
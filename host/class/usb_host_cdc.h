@@ -9,6 +9,10 @@
 #ifndef __USB_HOST_CDC_H__
 #define __USB_HOST_CDC_H__
 
+#if ((defined(USB_HOST_CONFIG_CDC_POLL_ENGINE)) && (USB_HOST_CONFIG_CDC_POLL_ENGINE > 0U))
+#include "usb_host_class_engine.h"
+#endif
+
 /*!
  * @addtogroup usb_host_cdc_drv
  * @{
@@ -207,6 +211,74 @@ typedef union _usb_cdc_func_desc_struct
     usb_host_cdc_tcLsr_desc_struct_t tcLsr;
 } usb_cdc_func_desc_struct_t;
 
+#if ((defined(USB_HOST_CONFIG_CDC_POLL_ENGINE)) && (USB_HOST_CONFIG_CDC_POLL_ENGINE > 0U))
+/*! @brief The maximum transfers the polling engine keeps armed on the interrupt pipe */
+#ifndef USB_HOST_CDC_POLL_MAX_TRANSFERS
+#define USB_HOST_CDC_POLL_MAX_TRANSFERS (2U)
+#endif
+
+/*! @brief The notification ring size in bytes for count notifications of notificationLength bytes, the length is kept
+ * in front of each notification */
+#define USB_HOST_CDC_POLL_RING_SIZE(notificationLength, count) \
+    ((count) * USB_HOST_CLASS_RING_RECORD_SIZE(notificationLength))
+
+/*! @brief The polling engine events */
+typedef enum _usb_host_cdc_poll_event
+{
+    kUSB_HostCdcPollEventNotification = 0U, /*!< One notification is queued into the ring*/
+    kUSB_HostCdcPollEventOverrun,           /*!< The ring is full, the received notification is dropped*/
+    kUSB_HostCdcPollEventStall,             /*!< The endpoint is stalled, the engine stops*/
+    kUSB_HostCdcPollEventStopped,           /*!< The engine is stopped, the transfers are released*/
+} usb_host_cdc_poll_event_t;
+
+/*!
+ * @brief The polling engine event callback.
+ *
+ * It is called in the host task (the transfer callback context).
+ *
+ * @param param  The callbackParam of the polling configuration.
+ * @param event  See the enumeration usb_host_cdc_poll_event_t.
+ * @param count  The notifications in the ring.
+ */
+typedef void (*usb_host_cdc_poll_callback_t)(void *param, uint32_t event, uint32_t count);
+
+/*! @brief The polling engine configuration */
+typedef struct _usb_host_cdc_poll_config
+{
+    uint8_t *ringBuffer;                     /*!< The notification ring, see USB_HOST_CDC_POLL_RING_SIZE*/
+    uint32_t ringSize;                       /*!< The notification ring size in bytes*/
+    uint8_t *transferBuffer;                 /*!< The transfer buffers, transferCount * notificationLength bytes*/
+    uint32_t transferBufferSize;             /*!< The transfer buffers size in bytes*/
+    uint32_t notificationLength;             /*!< The maximum notification length, 0 means the maximum packet size*/
+    usb_host_cdc_poll_callback_t callbackFn; /*!< The event callback, it can be NULL*/
+    void *callbackParam;                     /*!< The first parameter of the event callback*/
+    uint8_t transferCount;                   /*!< The transfers kept armed, 1 to USB_HOST_CDC_POLL_MAX_TRANSFERS*/
+} usb_host_cdc_poll_config_t;
+
+/*! @brief The polling engine statistics */
+typedef struct _usb_host_cdc_poll_statistic
+{
+    uint32_t notificationCount; /*!< Notifications queued into the ring*/
+    uint32_t overrunCount;      /*!< Notifications dropped because the ring is full*/
+    uint32_t errorCount;        /*!< Transfers completed with an error, they are armed again*/
+} usb_host_cdc_poll_statistic_t;
+
+/*!
+ * @brief The polling engine structure.
+ *
+ * The class engine keeps the transfers armed. The notification ring has one producer, the transfer callback, and one
+ * consumer, USB_HostCdcInterruptPollRead.
+ */
+typedef struct _usb_host_cdc_poll
+{
+    usb_host_cdc_poll_config_t config;                              /*!< The polling configuration*/
+    usb_host_cdc_poll_statistic_t statistic;                        /*!< The polling statistics*/
+    usb_host_class_engine_t engine;                                 /*!< The class engine of the armed transfers*/
+    usb_host_class_ring_t ring;                                     /*!< The notification ring*/
+    usb_host_transfer_t *transfer[USB_HOST_CDC_POLL_MAX_TRANSFERS]; /*!< The armed transfers*/
+} usb_host_cdc_poll_t;
+#endif
+
 typedef struct _usb_host_cdc_instance_struct
 {
     usb_host_handle hostHandle;                             /*!< The handle of the USB host. */
@@ -238,6 +310,9 @@ typedef struct _usb_host_cdc_instance_struct
     uint16_t packetSize;        /*!< CDC control pipe maximum packet size*/
     uint16_t bulkOutPacketSize; /*!< CDC bulk out maximum packet size*/
     uint16_t bulkInPacketSize;  /*!< CDC bulk in maximum packet size*/
+#if ((defined(USB_HOST_CONFIG_CDC_POLL_ENGINE)) && (USB_HOST_CONFIG_CDC_POLL_ENGINE > 0U))
+    usb_host_cdc_poll_t *interruptPoll; /*!< The interrupt pipe polling engine*/
+#endif
 } usb_host_cdc_instance_struct_t;
 
 #ifdef __cplusplus
@@ -399,7 +474,7 @@ extern usb_status_t USB_HostCdcDataSend(usb_host_class_handle classHandle,
  *
  * @retval kStatus_USB_Success         Receive request successfully.
  * @retval kStatus_USB_InvalidHandle   The classHandle is NULL pointer.
- * @retval kStatus_USB_Busy            There is no idle transfer.
+ * @retval kStatus_USB_Busy            There is no idle transfer, or the polling engine is running.
  * @retval kStatus_USB_Error           Pipe is not initialized.
  *                                    Or, send transfer fail. See the USB_HostRecv.
  */
@@ -557,6 +632,73 @@ extern usb_status_t USB_HostCdcControl(usb_host_class_handle classHandle,
                                        uint8_t *data,
                                        transfer_callback_t callbackFn,
                                        void *callbackParam);
+
+#if ((defined(USB_HOST_CONFIG_CDC_POLL_ENGINE)) && (USB_HOST_CONFIG_CDC_POLL_ENGINE > 0U))
+/*!
+ * @brief Starts the interrupt pipe polling engine.
+ *
+ * The engine keeps config->transferCount transfers armed on the notification interrupt pipe, each completed transfer
+ * is armed again from its callback so no notification is missed between two receive requests. The received
+ * notifications are queued into the notification ring and read by USB_HostCdcInterruptPollRead. A notification is
+ * dropped and counted as an overrun when the ring is full, the zero length transfers are not queued.
+ *
+ * The transfers are allocated from the host transfer pool until the engine is stopped. USB_HostCdcInterruptRecv
+ * returns kStatus_USB_Busy while the engine runs.
+ *
+ * @param classHandle    The class handle.
+ * @param config         The polling configuration, it is copied.
+ *
+ * @retval kStatus_USB_Success              The engine is started.
+ * @retval kStatus_USB_InvalidHandle        The classHandle is NULL pointer.
+ * @retval kStatus_USB_InvalidParameter     The configuration is invalid.
+ * @retval kStatus_USB_Busy                 The engine is running.
+ * @retval kStatus_USB_Error                The pipe is not initialized, or the transfers fail to be armed.
+ * @retval kStatus_USB_AllocFail            There is no memory or idle transfer.
+ */
+extern usb_status_t USB_HostCdcInterruptPollStart(usb_host_class_handle classHandle,
+                                                  usb_host_cdc_poll_config_t *config);
+
+/*!
+ * @brief Stops the interrupt pipe polling engine.
+ *
+ * The armed transfers are canceled, kUSB_HostCdcPollEventStopped is notified when the transfers are released. The
+ * notifications still in the ring are dropped. Changing the control interface alternate setting also stops the
+ * engine.
+ *
+ * @param classHandle    The class handle.
+ *
+ * @retval kStatus_USB_Success              The engine is stopping or stopped.
+ * @retval kStatus_USB_InvalidHandle        The classHandle is NULL pointer.
+ * @retval kStatus_USB_Error                The engine is not running.
+ */
+extern usb_status_t USB_HostCdcInterruptPollStop(usb_host_class_handle classHandle);
+
+/*!
+ * @brief Reads the oldest notification from the notification ring.
+ *
+ * It can be called from one task only, the ring is not locked.
+ *
+ * @param classHandle    The class handle.
+ * @param buffer         Returns the notification, a longer notification is truncated.
+ * @param length         The buffer length.
+ *
+ * @return The notification length, 0 when the ring is empty.
+ */
+extern uint32_t USB_HostCdcInterruptPollRead(usb_host_class_handle classHandle, uint8_t *buffer, uint32_t length);
+
+/*!
+ * @brief Gets the statistics of the interrupt pipe polling engine.
+ *
+ * @param classHandle    The class handle.
+ * @param statistic      Returns the statistics.
+ *
+ * @retval kStatus_USB_Success              The statistics are got.
+ * @retval kStatus_USB_InvalidHandle        The classHandle or statistic is NULL pointer.
+ * @retval kStatus_USB_Error                The engine is not running.
+ */
+extern usb_status_t USB_HostCdcInterruptPollGetStatistic(usb_host_class_handle classHandle,
+                                                         usb_host_cdc_poll_statistic_t *statistic);
+#endif
 /*@}*/
 
 #ifdef __cplusplus
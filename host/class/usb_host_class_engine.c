@@ -0,0 +1,337 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_host_config.h"
+#include "fsl_common.h"
+#include "usb_host.h"
+#include "usb_host_class_engine.h"
+#if ((defined(USB_HOST_CLASS_ENGINE_ENABLE)) && (USB_HOST_CLASS_ENGINE_ENABLE > 0U))
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief get the used bytes of the class ring.
+ *
+ * @param ring        the class ring.
+ * @param writeIndex  the producer index.
+ * @param readIndex   the consumer index.
+ *
+ * @return the used bytes.
+ */
+static uint32_t USB_HostClassRingUsed(usb_host_class_ring_t *ring, uint32_t writeIndex, uint32_t readIndex);
+
+/*!
+ * @brief move the class ring index.
+ *
+ * @param ring    the class ring.
+ * @param index   the index.
+ * @param length  the moved bytes.
+ *
+ * @return the moved index.
+ */
+static uint32_t USB_HostClassRingAdvance(usb_host_class_ring_t *ring, uint32_t index, uint32_t length);
+
+/*!
+ * @brief copy data into the class ring, the copy wraps at the ring end.
+ *
+ * @param ring    the class ring.
+ * @param index   the ring index of the data.
+ * @param data    the data.
+ * @param length  the data length.
+ */
+static void USB_HostClassRingWrite(usb_host_class_ring_t *ring, uint32_t index, const uint8_t *data, uint32_t length);
+
+/*!
+ * @brief copy data out of the class ring, the copy wraps at the ring end.
+ *
+ * @param ring    the class ring.
+ * @param index   the ring index of the data.
+ * @param data    returns the data.
+ * @param length  the data length.
+ */
+static void USB_HostClassRingRead(usb_host_class_ring_t *ring, uint32_t index, uint8_t *data, uint32_t length);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+void USB_HostClassEngineInit(usb_host_class_engine_t *engine,
+                             usb_host_handle hostHandle,
+                             usb_host_transfer_t **transfer,
+                             usb_host_class_engine_release_t releaseFn,
+                             void *releaseParam)
+{
+    engine->hostHandle    = hostHandle;
+    engine->transfer      = transfer;
+    engine->releaseFn     = releaseFn;
+    engine->releaseParam  = releaseParam;
+    engine->cancelling    = 0U;
+    engine->transferCount = 0U;
+    engine->pending       = 0U;
+    engine->stopping      = 0U;
+}
+
+usb_status_t USB_HostClassEngineAllocTransfer(usb_host_class_engine_t *engine,
+                                              uint32_t count,
+                                              uint8_t *buffer,
+                                              uint32_t length,
+                                              host_inner_transfer_callback_t callbackFn,
+                                              void *callbackParam)
+{
+    usb_host_transfer_t *transfer;
+
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        if (USB_HostMallocTransfer(engine->hostHandle, &transfer) != kStatus_USB_Success)
+        {
+#ifdef HOST_ECHO
+            usb_echo("error to get transfer\r\n");
+#endif
+            return kStatus_USB_AllocFail;
+        }
+        engine->transfer[engine->transferCount] = transfer;
+        engine->transferCount++;
+        transfer->transferBuffer = &buffer[index * length];
+        transfer->transferLength = length;
+        transfer->callbackFn     = callbackFn;
+        transfer->callbackParam  = callbackParam;
+    }
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_HostClassEngineSubmit(usb_host_class_engine_t *engine,
+                                       usb_host_pipe_handle pipeHandle,
+                                       usb_host_transfer_t *transfer)
+{
+    usb_status_t status;
+
+    if (((usb_host_pipe_t *)pipeHandle)->direction == USB_IN)
+    {
+        status = USB_HostRecv(engine->hostHandle, pipeHandle, transfer);
+    }
+    else
+    {
+        status = USB_HostSend(engine->hostHandle, pipeHandle, transfer);
+    }
+    if (status == kStatus_USB_Success)
+    {
+        engine->pending++;
+    }
+    return status;
+}
+
+usb_status_t USB_HostClassEngineResubmit(usb_host_class_engine_t *engine,
+                                         usb_host_pipe_handle pipeHandle,
+                                         usb_host_transfer_t *transfer)
+{
+    if (USB_HostClassEngineSubmit(engine, pipeHandle, transfer) == kStatus_USB_Success)
+    {
+        return kStatus_USB_Success;
+    }
+    if (0U == engine->pending)
+    {
+        /* no transfer is in flight */
+        engine->stopping = 1U;
+        USB_HostClassEngineRelease(engine);
+        return kStatus_USB_TransferCancel;
+    }
+    return kStatus_USB_Error;
+}
+
+uint8_t USB_HostClassEngineTransferDone(usb_host_class_engine_t *engine, usb_status_t status)
+{
+    engine->pending--;
+    if (status == kStatus_USB_TransferCancel)
+    {
+        /* the pipe is canceled or closed, the interface is changed for example */
+        engine->stopping = 1U;
+    }
+    if (0U == engine->stopping)
+    {
+        return 0U;
+    }
+    if ((0U == engine->pending) && (0U == engine->cancelling))
+    {
+        USB_HostClassEngineRelease(engine);
+    }
+    return 1U;
+}
+
+void USB_HostClassEngineStop(usb_host_class_engine_t *engine,
+                             usb_host_pipe_handle pipeHandle,
+                             usb_host_pipe_handle auxPipeHandle)
+{
+    uint32_t count = engine->transferCount;
+
+    engine->stopping = 1U;
+    /* the canceled transfers don't release the engine while it is canceled here, it is released below */
+    engine->cancelling = 1U;
+    for (uint32_t index = 0U; (index <= count) && (0U != engine->pending); index++)
+    {
+        (void)USB_HostCancelTransfer(engine->hostHandle, pipeHandle, NULL);
+        if ((0U != engine->pending) && (auxPipeHandle != NULL))
+        {
+            (void)USB_HostCancelTransfer(engine->hostHandle, auxPipeHandle, NULL);
+        }
+    }
+    engine->cancelling = 0U;
+    if (0U == engine->pending)
+    {
+        USB_HostClassEngineRelease(engine);
+    }
+}
+
+void USB_HostClassEngineRelease(usb_host_class_engine_t *engine)
+{
+    for (uint32_t index = 0U; index < engine->transferCount; index++)
+    {
+        (void)USB_HostFreeTransfer(engine->hostHandle, engine->transfer[index]);
+        engine->transfer[index] = NULL;
+    }
+    engine->transferCount = 0U;
+    engine->releaseFn(engine->releaseParam);
+}
+
+static uint32_t USB_HostClassRingUsed(usb_host_class_ring_t *ring, uint32_t writeIndex, uint32_t readIndex)
+{
+    return (writeIndex >= readIndex) ? (writeIndex - readIndex) : ((ring->size << 1U) + writeIndex - readIndex);
+}
+
+static uint32_t USB_HostClassRingAdvance(usb_host_class_ring_t *ring, uint32_t index, uint32_t length)
+{
+    index += length;
+    if (index >= (ring->size << 1U))
+    {
+        index -= (ring->size << 1U);
+    }
+    return index;
+}
+
+static void USB_HostClassRingWrite(usb_host_class_ring_t *ring, uint32_t index, const uint8_t *data, uint32_t length)
+{
+    uint32_t offset = (index >= ring->size) ? (index - ring->size) : index;
+    uint32_t count  = MIN(ring->size - offset, length);
+
+    (void)memcpy(&ring->buffer[offset], data, count);
+    if (count < length)
+    {
+        (void)memcpy(&ring->buffer[0], &data[count], length - count);
+    }
+}
+
+static void USB_HostClassRingRead(usb_host_class_ring_t *ring, uint32_t index, uint8_t *data, uint32_t length)
+{
+    uint32_t offset = (index >= ring->size) ? (index - ring->size) : index;
+    uint32_t count  = MIN(ring->size - offset, length);
+
+    (void)memcpy(data, &ring->buffer[offset], count);
+    if (count < length)
+    {
+        (void)memcpy(&data[count], &ring->buffer[0], length - count);
+    }
+}
+
+void USB_HostClassRingInit(usb_host_class_ring_t *ring, uint8_t *buffer, uint32_t size, uint32_t recordSize)
+{
+    ring->buffer     = buffer;
+    ring->size       = (recordSize > 0U) ? (size - (size % recordSize)) : size;
+    ring->recordSize = recordSize;
+    ring->writeIndex = 0U;
+    ring->readIndex  = 0U;
+}
+
+uint32_t USB_HostClassRingCount(usb_host_class_ring_t *ring)
+{
+    uint32_t used = USB_HostClassRingUsed(ring, ring->writeIndex, ring->readIndex);
+
+    return (ring->recordSize > 0U) ? (used / ring->recordSize) : used;
+}
+
+uint32_t USB_HostClassRingPut(usb_host_class_ring_t *ring, const uint8_t *data, uint32_t length)
+{
+    uint32_t writeIndex = ring->writeIndex;
+    uint32_t space      = ring->size - USB_HostClassRingUsed(ring, writeIndex, ring->readIndex);
+
+    if (length > space)
+    {
+        length = space;
+    }
+    /* the space is written after the consumer frees it */
+    __DMB();
+    USB_HostClassRingWrite(ring, writeIndex, data, length);
+    /* the data is written before the index publishes it */
+    __DMB();
+    ring->writeIndex = USB_HostClassRingAdvance(ring, writeIndex, length);
+    return length;
+}
+
+uint32_t USB_HostClassRingGet(usb_host_class_ring_t *ring, uint8_t *data, uint32_t length)
+{
+    uint32_t readIndex = ring->readIndex;
+    uint32_t used      = USB_HostClassRingUsed(ring, ring->writeIndex, readIndex);
+
+    if (length > used)
+    {
+        length = used;
+    }
+    /* the data is read after the producer publishes it */
+    __DMB();
+    USB_HostClassRingRead(ring, readIndex, data, length);
+    /* the data is read before the index frees the space */
+    __DMB();
+    ring->readIndex = USB_HostClassRingAdvance(ring, readIndex, length);
+    return length;
+}
+
+uint32_t USB_HostClassRingPutRecord(usb_host_class_ring_t *ring, const uint8_t *data, uint32_t length)
+{
+    uint32_t writeIndex = ring->writeIndex;
+
+    if ((ring->size - USB_HostClassRingUsed(ring, writeIndex, ring->readIndex)) < ring->recordSize)
+    {
+        return 0U;
+    }
+    /* the slot is written after the consumer frees it, the slot doesn't wrap at the ring end */
+    __DMB();
+    USB_HostClassRingWrite(ring, writeIndex, (uint8_t *)&length, sizeof(length));
+    USB_HostClassRingWrite(ring, writeIndex + sizeof(length), data, length);
+    /* the record is written before the index publishes it */
+    __DMB();
+    ring->writeIndex = USB_HostClassRingAdvance(ring, writeIndex, ring->recordSize);
+    return length;
+}
+
+uint32_t USB_HostClassRingGetRecord(usb_host_class_ring_t *ring, uint8_t *data, uint32_t length)
+{
+    uint32_t readIndex = ring->readIndex;
+    uint32_t recordLength;
+
+    if (readIndex == ring->writeIndex)
+    {
+        return 0U;
+    }
+    /* the record is read after the producer publishes it */
+    __DMB();
+    USB_HostClassRingRead(ring, readIndex, (uint8_t *)&recordLength, sizeof(recordLength));
+    if (recordLength > length)
+    {
+        recordLength = length;
+    }
+    USB_HostClassRingRead(ring, readIndex + sizeof(recordLength), data, recordLength);
+    /* the record is read before the index frees the slot */
+    __DMB();
+    ring->readIndex = USB_HostClassRingAdvance(ring, readIndex, ring->recordSize);
+    return recordLength;
+}
+
+#endif /* USB_HOST_CLASS_ENGINE_ENABLE */
@@ -0,0 +1,270 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _USB_HOST_CLASS_ENGINE_H_
+#define _USB_HOST_CLASS_ENGINE_H_
+
+/*******************************************************************************
+ * Class engine public structure, enumerations, macros, functions
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!
+ * @addtogroup usb_host_class_engine
+ * @{
+ */
+
+#if (((defined(USB_HOST_CONFIG_HID_POLL_ENGINE)) && (USB_HOST_CONFIG_HID_POLL_ENGINE > 0U)) ||       \
+     ((defined(USB_HOST_CONFIG_CDC_POLL_ENGINE)) && (USB_HOST_CONFIG_CDC_POLL_ENGINE > 0U)) ||       \
+     ((defined(USB_HOST_CONFIG_AUDIO_STREAM_ENGINE)) && (USB_HOST_CONFIG_AUDIO_STREAM_ENGINE > 0U)))
+/*! @brief The class engine and the class ring are used by the HID, CDC polling engines and the audio stream engine */
+#define USB_HOST_CLASS_ENGINE_ENABLE (1U)
+#endif
+
+#if ((defined(USB_HOST_CLASS_ENGINE_ENABLE)) && (USB_HOST_CLASS_ENGINE_ENABLE > 0U))
+/*! @brief The record slot size of the class ring for the records of up to length bytes, the length is kept in front */
+#define USB_HOST_CLASS_RING_RECORD_SIZE(length) ((length) + 4U)
+
+/*!
+ * @brief The class engine release callback.
+ *
+ * It is called once after the transfers are freed, by the last completed transfer of the stopping engine or by
+ * USB_HostClassEngineStop when its pipes are canceled. It frees the class structure that holds the engine.
+ *
+ * @param param  The releaseParam of the engine.
+ */
+typedef void (*usb_host_class_engine_release_t)(void *param);
+
+/*!
+ * @brief The class engine structure.
+ *
+ * The engine keeps the transfers of one class driver in flight, each completed transfer is submitted again from its
+ * callback until the engine is stopped, and the last completed transfer releases the engine. The engine functions
+ * are called in the host task.
+ */
+typedef struct _usb_host_class_engine
+{
+    usb_host_handle hostHandle;                /*!< The host handle*/
+    usb_host_transfer_t **transfer;            /*!< The transfer array of the class driver*/
+    usb_host_class_engine_release_t releaseFn; /*!< The release callback*/
+    void *releaseParam;                        /*!< The first parameter of the release callback*/
+    uint8_t cancelling;                        /*!< USB_HostClassEngineStop is canceling, it releases the engine*/
+    uint8_t transferCount;                     /*!< The allocated transfers*/
+    uint8_t pending;                           /*!< The transfers in flight*/
+    uint8_t stopping;                          /*!< The engine is stopping, the transfers are not submitted again*/
+} usb_host_class_engine_t;
+
+/*!
+ * @brief The class ring structure.
+ *
+ * The ring has one producer and one consumer, each side only writes its own index so the ring needs no lock. The
+ * indexes run in [0, 2 * size) so the full ring is told from the empty ring without a free byte. The producer
+ * writes the data before it publishes the write index and the consumer reads the data before it frees the space by
+ * the read index, a memory barrier keeps the order, so the other side never sees a partial record.
+ *
+ * The byte ring (recordSize is 0) keeps a byte stream. The record ring keeps one record in each recordSize bytes
+ * slot, see USB_HOST_CLASS_RING_RECORD_SIZE.
+ */
+typedef struct _usb_host_class_ring
+{
+    uint8_t *buffer;              /*!< The ring buffer*/
+    uint32_t size;                /*!< The ring size in bytes*/
+    uint32_t recordSize;          /*!< The record slot size in bytes, 0 for the byte ring*/
+    volatile uint32_t writeIndex; /*!< The producer index*/
+    volatile uint32_t readIndex;  /*!< The consumer index*/
+} usb_host_class_ring_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @brief Initialize the class engine.
+ *
+ * @param[in] engine        The class engine.
+ * @param[in] hostHandle    The host handle.
+ * @param[in] transfer      The transfer array of the class driver, it keeps the allocated transfers.
+ * @param[in] releaseFn     The release callback.
+ * @param[in] releaseParam  The first parameter of the release callback.
+ */
+extern void USB_HostClassEngineInit(usb_host_class_engine_t *engine,
+                                    usb_host_handle hostHandle,
+                                    usb_host_transfer_t **transfer,
+                                    usb_host_class_engine_release_t releaseFn,
+                                    void *releaseParam);
+
+/*!
+ * @brief Allocate the transfers of the class engine.
+ *
+ * The transfers are appended to the transfer array, transfer n uses length bytes at buffer + n * length.
+ *
+ * @param[in] engine         The class engine.
+ * @param[in] count          The transfer count.
+ * @param[in] buffer         The transfer buffers.
+ * @param[in] length         The transfer length.
+ * @param[in] callbackFn     The transfer callback.
+ * @param[in] callbackParam  The transfer callback parameter.
+ *
+ * @retval kStatus_USB_Success              The transfers are allocated.
+ * @retval kStatus_USB_AllocFail            There is no idle transfer, the allocated ones are freed by the release.
+ */
+extern usb_status_t USB_HostClassEngineAllocTransfer(usb_host_class_engine_t *engine,
+                                                     uint32_t count,
+                                                     uint8_t *buffer,
+                                                     uint32_t length,
+                                                     host_inner_transfer_callback_t callbackFn,
+                                                     void *callbackParam);
+
+/*!
+ * @brief Submit one transfer of the class engine, it is received or sent by the pipe direction.
+ *
+ * @param[in] engine      The class engine.
+ * @param[in] pipeHandle  The pipe handle.
+ * @param[in] transfer    The transfer.
+ *
+ * @return kStatus_USB_Success or the error codes of USB_HostRecv and USB_HostSend.
+ */
+extern usb_status_t USB_HostClassEngineSubmit(usb_host_class_engine_t *engine,
+                                              usb_host_pipe_handle pipeHandle,
+                                              usb_host_transfer_t *transfer);
+
+/*!
+ * @brief Submit one completed transfer of the class engine again.
+ *
+ * The engine is released when the transfer fails to be submitted and no other transfer is in flight.
+ *
+ * @param[in] engine      The class engine.
+ * @param[in] pipeHandle  The pipe handle.
+ * @param[in] transfer    The transfer.
+ *
+ * @retval kStatus_USB_Success              The transfer is submitted.
+ * @retval kStatus_USB_Error                The transfer fails to be submitted, the other transfers are in flight.
+ * @retval kStatus_USB_TransferCancel       The transfer fails to be submitted and the engine is released, it must
+ *                                          not be accessed.
+ */
+extern usb_status_t USB_HostClassEngineResubmit(usb_host_class_engine_t *engine,
+                                                usb_host_pipe_handle pipeHandle,
+                                                usb_host_transfer_t *transfer);
+
+/*!
+ * @brief Account one completed transfer of the class engine, it is called first in the transfer callback.
+ *
+ * The canceled transfer stops the engine. The last completed transfer of the stopping engine releases it.
+ *
+ * @param[in] engine  The class engine.
+ * @param[in] status  The transfer status.
+ *
+ * @return 1 if the engine is stopping or released, the transfer is not handled; otherwise 0.
+ */
+extern uint8_t USB_HostClassEngineTransferDone(usb_host_class_engine_t *engine, usb_status_t status);
+
+/*!
+ * @brief Stop the class engine.
+ *
+ * The pipes are canceled until no transfer is in flight, some controllers cancel one transfer of the pipe in each
+ * call, and then the engine is released. A transfer the controller still keeps after the cancel releases the engine
+ * when it completes.
+ *
+ * @param[in] engine         The class engine.
+ * @param[in] pipeHandle     The pipe of the transfers.
+ * @param[in] auxPipeHandle  The second pipe of the transfers, it can be NULL.
+ */
+extern void USB_HostClassEngineStop(usb_host_class_engine_t *engine,
+                                    usb_host_pipe_handle pipeHandle,
+                                    usb_host_pipe_handle auxPipeHandle);
+
+/*!
+ * @brief Release the class engine, free the transfers and call the release callback.
+ *
+ * It is called by the class driver directly only when the transfers are not called back any more, the pipes are
+ * closed for example.
+ *
+ * @param[in] engine  The class engine.
+ */
+extern void USB_HostClassEngineRelease(usb_host_class_engine_t *engine);
+
+/*!
+ * @brief Initialize the class ring.
+ *
+ * The record ring size is rounded down to the multiple of the record slot size.
+ *
+ * @param[in] ring        The class ring.
+ * @param[in] buffer      The ring buffer.
+ * @param[in] size        The ring size in bytes.
+ * @param[in] recordSize  The record slot size, see USB_HOST_CLASS_RING_RECORD_SIZE. 0 for the byte ring.
+ */
+extern void USB_HostClassRingInit(usb_host_class_ring_t *ring, uint8_t *buffer, uint32_t size, uint32_t recordSize);
+
+/*!
+ * @brief Get the data in the class ring.
+ *
+ * @param[in] ring  The class ring.
+ *
+ * @return The byte count of the byte ring, or the record count of the record ring.
+ */
+extern uint32_t USB_HostClassRingCount(usb_host_class_ring_t *ring);
+
+/*!
+ * @brief Put data into the byte ring, it is called by the producer only.
+ *
+ * @param[in] ring    The class ring.
+ * @param[in] data    The data.
+ * @param[in] length  The data length.
+ *
+ * @return The length put into the ring, it is less than the length when the ring is full.
+ */
+extern uint32_t USB_HostClassRingPut(usb_host_class_ring_t *ring, const uint8_t *data, uint32_t length);
+
+/*!
+ * @brief Get data from the byte ring, it is called by the consumer only.
+ *
+ * @param[in] ring    The class ring.
+ * @param[out] data   Returns the data.
+ * @param[in] length  The buffer length.
+ *
+ * @return The length got from the ring.
+ */
+extern uint32_t USB_HostClassRingGet(usb_host_class_ring_t *ring, uint8_t *data, uint32_t length);
+
+/*!
+ * @brief Put one record into the record ring, it is called by the producer only.
+ *
+ * @param[in] ring    The class ring.
+ * @param[in] data    The record.
+ * @param[in] length  The record length, not more than the record slot size - 4.
+ *
+ * @return The record length, 0 when the ring is full.
+ */
+extern uint32_t USB_HostClassRingPutRecord(usb_host_class_ring_t *ring, const uint8_t *data, uint32_t length);
+
+/*!
+ * @brief Get the oldest record from the record ring, it is called by the consumer only.
+ *
+ * @param[in] ring    The class ring.
+ * @param[out] data   Returns the record, a longer record is truncated.
+ * @param[in] length  The buffer length.
+ *
+ * @return The record length, 0 when the ring is empty.
+ */
+extern uint32_t USB_HostClassRingGetRecord(usb_host_class_ring_t *ring, uint8_t *data, uint32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/*! @}*/
+
+#endif /* _USB_HOST_CLASS_ENGINE_H_ */
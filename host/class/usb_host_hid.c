@@ -88,9 +88,145 @@ static usb_status_t USB_HostHidControl(usb_host_class_handle classHandle,
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
+
+/*! @brief HID report descriptor item types */
+#define USB_HOST_HID_ITEM_TYPE_MAIN   (0U)
+#define USB_HOST_HID_ITEM_TYPE_GLOBAL (1U)
+#define USB_HOST_HID_ITEM_TYPE_LOCAL  (2U)
+/*! @brief HID report descriptor long item prefix */
+#define USB_HOST_HID_ITEM_LONG (0xFEU)
+
+/*! @brief HID report descriptor main item tags */
+#define USB_HOST_HID_MAIN_INPUT          (0x08U)
+#define USB_HOST_HID_MAIN_OUTPUT         (0x09U)
+#define USB_HOST_HID_MAIN_FEATURE        (0x0BU)
+/*! @brief HID report descriptor global item tags */
+#define USB_HOST_HID_GLOBAL_USAGE_PAGE   (0x00U)
+#define USB_HOST_HID_GLOBAL_LOGICAL_MIN  (0x01U)
+#define USB_HOST_HID_GLOBAL_LOGICAL_MAX  (0x02U)
+#define USB_HOST_HID_GLOBAL_REPORT_SIZE  (0x07U)
+#define USB_HOST_HID_GLOBAL_REPORT_ID    (0x08U)
+#define USB_HOST_HID_GLOBAL_REPORT_COUNT (0x09U)
+#define USB_HOST_HID_GLOBAL_PUSH         (0x0AU)
+#define USB_HOST_HID_GLOBAL_POP          (0x0BU)
+/*! @brief HID report descriptor local item tags */
+#define USB_HOST_HID_LOCAL_USAGE         (0x00U)
+#define USB_HOST_HID_LOCAL_USAGE_MIN     (0x01U)
+#define USB_HOST_HID_LOCAL_USAGE_MAX     (0x02U)
+
+/*! @brief The global item state of the report descriptor parser */
+typedef struct _usb_host_hid_parser_global
+{
+    uint32_t usagePage;       /*!< Usage page*/
+    int32_t logicalMinimum;   /*!< Logical minimum*/
+    int32_t logicalMaximum;   /*!< Logical maximum, sign extended*/
+    uint32_t reportSize;      /*!< Report size in bits*/
+    uint32_t reportCount;     /*!< Report count*/
+    uint8_t logicalMaxSize;   /*!< The data size of the logical maximum item*/
+    uint8_t reportId;         /*!< Report ID*/
+} usb_host_hid_parser_global_t;
+
+/*! @brief The usage range of a local usage item */
+typedef struct _usb_host_hid_parser_usage
+{
+    uint32_t minimum; /*!< The first usage*/
+    uint32_t maximum; /*!< The last usage*/
+} usb_host_hid_parser_usage_t;
+
+/*! @brief The bit length of one report */
+typedef struct _usb_host_hid_parser_report
+{
+    uint32_t bits;      /*!< The bits of the report got so far, the report ID byte is counted*/
+    uint8_t reportId;   /*!< The report ID*/
+    uint8_t reportType; /*!< The report type*/
+} usb_host_hid_parser_report_t;
+
+/*! @brief The report descriptor parser state */
+typedef struct _usb_host_hid_parser
+{
+    usb_host_hid_parser_global_t global;                                       /*!< Current global items*/
+    usb_host_hid_parser_global_t stack[USB_HOST_HID_PARSER_STACK_DEPTH];       /*!< Pushed global items*/
+    usb_host_hid_parser_usage_t usage[USB_HOST_HID_PARSER_MAX_USAGES];         /*!< Local usages*/
+    usb_host_hid_parser_report_t report[USB_HOST_HID_PARSER_MAX_REPORTS];      /*!< Reports*/
+    usb_host_hid_field_t *fields;                                              /*!< The field table*/
+    uint32_t fieldCapacity;                                                    /*!< The field table size*/
+    uint32_t fieldCount;                                                       /*!< The field count*/
+    uint32_t usageMinimum;                                                     /*!< The pending usage minimum*/
+    uint8_t usageCount;                                                        /*!< Local usage count*/
+    uint8_t stackDepth;                                                        /*!< Push depth*/
+    uint8_t reportCount;                                                       /*!< Report count*/
+} usb_host_hid_parser_t;
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
+
+/*!
+ * @brief get the data of a short item.
+ *
+ * @param data        item data.
+ * @param size        item data size, 0, 1, 2 or 4.
+ * @param isSigned    sign extend the data.
+ *
+ * @return The item data.
+ */
+static uint32_t USB_HostHidParserItemData(const uint8_t *data, uint8_t size, uint8_t isSigned);
+
+/*!
+ * @brief get the usage of one element of a main item.
+ *
+ * @param parser      parser state.
+ * @param element     element index.
+ *
+ * @return The usage, the last usage is repeated for the elements after the last usage.
+ */
+static uint32_t USB_HostHidParserUsage(usb_host_hid_parser_t *parser, uint32_t element);
+
+/*!
+ * @brief add the fields of an input, output or feature main item.
+ *
+ * @param parser      parser state.
+ * @param reportType  report type.
+ * @param flags       main item data.
+ *
+ * @return kStatus_USB_Success or error codes.
+ */
+static usb_status_t USB_HostHidParserMain(usb_host_hid_parser_t *parser, uint8_t reportType, uint32_t flags);
+
+/*!
+ * @brief handle a global item.
+ *
+ * @param parser      parser state.
+ * @param tag         item tag.
+ * @param data        item data.
+ * @param size        item data size.
+ *
+ * @return kStatus_USB_Success or error codes.
+ */
+static usb_status_t USB_HostHidParserGlobal(usb_host_hid_parser_t *parser,
+                                            uint8_t tag,
+                                            const uint8_t *data,
+                                            uint8_t size);
+
+/*!
+ * @brief handle a local item.
+ *
+ * @param parser      parser state.
+ * @param tag         item tag.
+ * @param data        item data.
+ * @param size        item data size.
+ */
+static void USB_HostHidParserLocal(usb_host_hid_parser_t *parser, uint8_t tag, const uint8_t *data, uint8_t size);
+
+#if ((defined(USB_HOST_CONFIG_HID_POLL_ENGINE)) && (USB_HOST_CONFIG_HID_POLL_ENGINE > 0U))
+/*!
+ * @brief release the polling engine, it is called by the class engine after the transfers are freed.
+ *
+ * @param param       hid instance pointer.
+ */
+static void USB_HostHidPollRelease(void *param);
+#endif
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -403,6 +539,9 @@ usb_status_t USB_HostHidSetInterface(usb_host_class_handle classHandle,
         return status;
     }
 
+#if ((defined(USB_HOST_CONFIG_HID_POLL_ENGINE)) && (USB_HOST_CONFIG_HID_POLL_ENGINE > 0U))
+    (void)USB_HostHidPollStop(classHandle);
+#endif
     /* cancel transfers */
     if (hidInstance->inPipe != NULL)
     {
@@ -487,6 +626,9 @@ usb_status_t USB_HostHidDeinit(usb_device_handle deviceHandle, usb_host_class_ha
 
     if (classHandle != NULL) /* class instance has initialized */
     {
+#if ((defined(USB_HOST_CONFIG_HID_POLL_ENGINE)) && (USB_HOST_CONFIG_HID_POLL_ENGINE > 0U))
+        (void)USB_HostHidPollStop(classHandle);
+#endif
         if (hidInstance->inPipe != NULL)
         {
             status = USB_HostCancelTransfer(hidInstance->hostHandle, hidInstance->inPipe, NULL); /* cancel pipe */
@@ -525,6 +667,14 @@ usb_status_t USB_HostHidDeinit(usb_device_handle deviceHandle, usb_host_class_ha
             }
             hidInstance->outPipe = NULL;
         }
+#if ((defined(USB_HOST_CONFIG_HID_POLL_ENGINE)) && (USB_HOST_CONFIG_HID_POLL_ENGINE > 0U))
+        /* the engine is released by the canceled transfers, release it here in case the controller doesn't call back
+         * the canceled transfers */
+        if (hidInstance->inPoll != NULL)
+        {
+            USB_HostClassEngineRelease(&hidInstance->inPoll->engine);
+        }
+#endif
         if ((hidInstance->controlPipe != NULL) &&
             (hidInstance->controlTransfer != NULL)) /* cancel control transfer if there is on-going control transfer */
         {
@@ -590,6 +740,12 @@ usb_status_t USB_HostHidRecv(usb_host_class_handle classHandle,
     {
         return kStatus_USB_Error;
     }
+#if ((defined(USB_HOST_CONFIG_HID_POLL_ENGINE)) && (USB_HOST_CONFIG_HID_POLL_ENGINE > 0U))
+    if (hidInstance->inPoll != NULL)
+    {
+        return kStatus_USB_Busy;
+    }
+#endif
 
     /* malloc one transfer */
     if (USB_HostMallocTransfer(hidInstance->hostHandle, &transfer) != kStatus_USB_Success)
@@ -805,4 +961,622 @@ usb_status_t USB_HostHidSetReport(usb_host_class_handle classHandle,
         USB_HOST_HID_SET_REPORT, reportId, reportType, (uint16_t)bufferLength, buffer, callbackFn, callbackParam);
 }
 
+static uint32_t USB_HostHidParserItemData(const uint8_t *data, uint8_t size, uint8_t isSigned)
+{
+    uint32_t value = 0U;
+
+    for (uint8_t index = 0U; index < size; index++)
+    {
+        value |= (uint32_t)data[index] << (8U * index);
+    }
+    if ((0U != isSigned) && (size > 0U) && (size < 4U) && (0U != (data[size - 1U] & 0x80U)))
+    {
+        value |= ~((1UL << (8U * size)) - 1UL);
+    }
+    return value;
+}
+
+static uint32_t USB_HostHidParserUsage(usb_host_hid_parser_t *parser, uint32_t element)
+{
+    usb_host_hid_parser_usage_t *usage;
+    uint32_t range;
+
+    for (uint8_t index = 0U; index < parser->usageCount; index++)
+    {
+        usage = &parser->usage[index];
+        range = (usage->maximum > usage->minimum) ? (usage->maximum - usage->minimum + 1U) : 1U;
+        if (element < range)
+        {
+            return usage->minimum + element;
+        }
+        element -= range;
+    }
+    if (0U != parser->usageCount)
+    {
+        usage = &parser->usage[parser->usageCount - 1U];
+        return (usage->maximum > usage->minimum) ? usage->maximum : usage->minimum;
+    }
+    return 0U;
+}
+
+static usb_status_t USB_HostHidParserMain(usb_host_hid_parser_t *parser, uint8_t reportType, uint32_t flags)
+{
+    usb_host_hid_parser_global_t *global = &parser->global;
+    usb_host_hid_parser_report_t *report = NULL;
+    usb_host_hid_field_t *field;
+    uint32_t bitOffset;
+
+    for (uint8_t index = 0U; index < parser->reportCount; index++)
+    {
+        if ((parser->report[index].reportId == global->reportId) &&
+            (parser->report[index].reportType == reportType))
+        {
+            report = &parser->report[index];
+            break;
+        }
+    }
+    if (NULL == report)
+    {
+        if (parser->reportCount >= USB_HOST_HID_PARSER_MAX_REPORTS)
+        {
+            return kStatus_USB_Error;
+        }
+        report             = &parser->report[parser->reportCount];
+        report->reportId   = global->reportId;
+        report->reportType = reportType;
+        report->bits       = (0U != global->reportId) ? 8U : 0U;
+        parser->reportCount++;
+    }
+
+    if ((global->reportCount > 0xFFFFU) || (global->reportSize > 0xFFFFU) ||
+        ((report->bits + (global->reportSize * global->reportCount)) > 0xFFFFU))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    bitOffset = report->bits;
+    report->bits += global->reportSize * global->reportCount;
+    /* The padding and the data that cannot be extracted in one word only move the offset */
+    if ((0U != (flags & USB_HOST_HID_FIELD_FLAG_CONSTANT)) || (0U == global->reportSize) || (global->reportSize > 32U))
+    {
+        return kStatus_USB_Success;
+    }
+
+    for (uint32_t element = 0U; element < global->reportCount; element++)
+    {
+        if (parser->fieldCount < parser->fieldCapacity)
+        {
+            field                 = &parser->fields[parser->fieldCount];
+            field->usage          = USB_HostHidParserUsage(
+                parser, (0U != (flags & USB_HOST_HID_FIELD_FLAG_VARIABLE)) ? element : 0U);
+            field->logicalMinimum = global->logicalMinimum;
+            field->logicalMaximum = global->logicalMaximum;
+            if ((global->logicalMinimum >= 0) && (global->logicalMaximum < 0) && (global->logicalMaxSize < 4U))
+            {
+                /* The logical maximum is unsigned when the logical minimum is not negative */
+                field->logicalMaximum =
+                    (int32_t)((uint32_t)global->logicalMaximum & ((1UL << (8U * global->logicalMaxSize)) - 1UL));
+            }
+            field->bitOffset  = (uint16_t)bitOffset;
+            field->bitSize    = (uint8_t)global->reportSize;
+            field->byteCount  = (uint8_t)(((bitOffset & 0x07U) + global->reportSize + 7U) >> 3U);
+            field->mask       = (global->reportSize >= 32U) ? 0xFFFFFFFFU : ((1UL << global->reportSize) - 1UL);
+            field->reportId   = global->reportId;
+            field->reportType = reportType;
+            field->flags      = (uint8_t)flags;
+        }
+        parser->fieldCount++;
+        bitOffset += global->reportSize;
+    }
+    return kStatus_USB_Success;
+}
+
+static usb_status_t USB_HostHidParserGlobal(usb_host_hid_parser_t *parser,
+                                            uint8_t tag,
+                                            const uint8_t *data,
+                                            uint8_t size)
+{
+    usb_host_hid_parser_global_t *global = &parser->global;
+    usb_status_t status                  = kStatus_USB_Success;
+
+    switch (tag)
+    {
+        case USB_HOST_HID_GLOBAL_USAGE_PAGE:
+            global->usagePage = USB_HostHidParserItemData(data, size, 0U);
+            break;
+        case USB_HOST_HID_GLOBAL_LOGICAL_MIN:
+            global->logicalMinimum = (int32_t)USB_HostHidParserItemData(data, size, 1U);
+            break;
+        case USB_HOST_HID_GLOBAL_LOGICAL_MAX:
+            global->logicalMaximum = (int32_t)USB_HostHidParserItemData(data, size, 1U);
+            global->logicalMaxSize = size;
+            break;
+        case USB_HOST_HID_GLOBAL_REPORT_SIZE:
+            global->reportSize = USB_HostHidParserItemData(data, size, 0U);
+            break;
+        case USB_HOST_HID_GLOBAL_REPORT_ID:
+            global->reportId = (uint8_t)USB_HostHidParserItemData(data, size, 0U);
+            if (0U == global->reportId)
+            {
+                /* The report ID 0 is reserved */
+                status = kStatus_USB_InvalidParameter;
+            }
+            break;
+        case USB_HOST_HID_GLOBAL_REPORT_COUNT:
+            global->reportCount = USB_HostHidParserItemData(data, size, 0U);
+            break;
+        case USB_HOST_HID_GLOBAL_PUSH:
+            if (parser->stackDepth >= USB_HOST_HID_PARSER_STACK_DEPTH)
+            {
+                status = kStatus_USB_Error;
+                break;
+            }
+            parser->stack[parser->stackDepth] = *global;
+            parser->stackDepth++;
+            break;
+        case USB_HOST_HID_GLOBAL_POP:
+            if (0U == parser->stackDepth)
+            {
+                status = kStatus_USB_InvalidParameter;
+                break;
+            }
+            parser->stackDepth--;
+            *global = parser->stack[parser->stackDepth];
+            break;
+        default:
+            /* the physical, unit and unit exponent items are not used by the fields */
+            break;
+    }
+    return status;
+}
+
+static void USB_HostHidParserLocal(usb_host_hid_parser_t *parser, uint8_t tag, const uint8_t *data, uint8_t size)
+{
+    uint32_t usage = USB_HostHidParserItemData(data, size, 0U);
+
+    /* The usage item of 4 bytes holds the usage page */
+    if (size < 4U)
+    {
+        usage |= parser->global.usagePage << 16U;
+    }
+    switch (tag)
+    {
+        case USB_HOST_HID_LOCAL_USAGE:
+            if (parser->usageCount < USB_HOST_HID_PARSER_MAX_USAGES)
+            {
+                parser->usage[parser->usageCount].minimum = usage;
+                parser->usage[parser->usageCount].maximum = usage;
+                parser->usageCount++;
+            }
+            break;
+        case USB_HOST_HID_LOCAL_USAGE_MIN:
+            parser->usageMinimum = usage;
+            break;
+        case USB_HOST_HID_LOCAL_USAGE_MAX:
+            if (parser->usageCount < USB_HOST_HID_PARSER_MAX_USAGES)
+            {
+                parser->usage[parser->usageCount].minimum = parser->usageMinimum;
+                parser->usage[parser->usageCount].maximum = usage;
+                parser->usageCount++;
+            }
+            break;
+        default:
+            /* the designator, string and delimiter items are not used by the fields */
+            break;
+    }
+}
+
+usb_status_t USB_HostHidParseReportDescriptor(const uint8_t *descriptor,
+                                              uint32_t length,
+                                              usb_host_hid_field_t *fields,
+                                              uint32_t *fieldCount)
+{
+    usb_host_hid_parser_t parser;
+    usb_status_t status = kStatus_USB_Success;
+    uint32_t index      = 0U;
+    uint8_t prefix;
+    uint8_t size;
+    uint8_t tag;
+
+    if ((NULL == descriptor) || (NULL == fieldCount) || ((NULL == fields) && (0U != *fieldCount)))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    (void)memset(&parser, 0, sizeof(parser));
+    parser.fields        = fields;
+    parser.fieldCapacity = *fieldCount;
+
+    while ((index < length) && (kStatus_USB_Success == status))
+    {
+        prefix = descriptor[index];
+        if (USB_HOST_HID_ITEM_LONG == prefix)
+        {
+            /* The long items are reserved, skip them */
+            if ((index + 2U) >= length)
+            {
+                status = kStatus_USB_InvalidParameter;
+                break;
+            }
+            index += 3U + (uint32_t)descriptor[index + 1U];
+            continue;
+        }
+        size = prefix & 0x03U;
+        size = (3U == size) ? 4U : size;
+        tag  = prefix >> 4U;
+        if ((index + 1U + size) > length)
+        {
+            status = kStatus_USB_InvalidParameter;
+            break;
+        }
+
+        switch ((prefix >> 2U) & 0x03U)
+        {
+            case USB_HOST_HID_ITEM_TYPE_MAIN:
+                if (USB_HOST_HID_MAIN_INPUT == tag)
+                {
+                    status = USB_HostHidParserMain(&parser, USB_HOST_HID_REPORT_TYPE_INPUT,
+                                                   USB_HostHidParserItemData(&descriptor[index + 1U], size, 0U));
+                }
+                else if (USB_HOST_HID_MAIN_OUTPUT == tag)
+                {
+                    status = USB_HostHidParserMain(&parser, USB_HOST_HID_REPORT_TYPE_OUTPUT,
+                                                   USB_HostHidParserItemData(&descriptor[index + 1U], size, 0U));
+                }
+                else if (USB_HOST_HID_MAIN_FEATURE == tag)
+                {
+                    status = USB_HostHidParserMain(&parser, USB_HOST_HID_REPORT_TYPE_FEATURE,
+                                                   USB_HostHidParserItemData(&descriptor[index + 1U], size, 0U));
+                }
+                else
+                {
+                    /* collection and end collection */
+                }
+                /* The local items apply to the next main item only */
+                parser.usageCount   = 0U;
+                parser.usageMinimum = 0U;
+                break;
+            case USB_HOST_HID_ITEM_TYPE_GLOBAL:
+                status = USB_HostHidParserGlobal(&parser, tag, &descriptor[index + 1U], size);
+                break;
+            case USB_HOST_HID_ITEM_TYPE_LOCAL:
+                USB_HostHidParserLocal(&parser, tag, &descriptor[index + 1U], size);
+                break;
+            default:
+                /* reserved item type */
+                break;
+        }
+        index += 1U + size;
+    }
+
+    *fieldCount = parser.fieldCount;
+    if ((kStatus_USB_Success == status) && (parser.fieldCount > parser.fieldCapacity))
+    {
+        status = kStatus_USB_AllocFail;
+    }
+    return status;
+}
+
+const usb_host_hid_field_t *USB_HostHidFindField(const usb_host_hid_field_t *fields,
+                                                 uint32_t fieldCount,
+                                                 uint8_t reportType,
+                                                 uint32_t usage,
+                                                 uint32_t instance)
+{
+    if (NULL == fields)
+    {
+        return NULL;
+    }
+    for (uint32_t index = 0U; index < fieldCount; index++)
+    {
+        if ((fields[index].usage == usage) && (fields[index].reportType == reportType))
+        {
+            if (0U == instance)
+            {
+                return &fields[index];
+            }
+            instance--;
+        }
+    }
+    return NULL;
+}
+
+int32_t USB_HostHidGetFieldValue(const usb_host_hid_field_t *field, const uint8_t *report)
+{
+    const uint8_t *data = &report[field->bitOffset >> 3U];
+    uint32_t shift      = (uint32_t)field->bitOffset & 0x07U;
+    uint32_t value      = data[0];
+
+    /* Assemble the word holding the value, the bytes out of the value are not read */
+    for (uint32_t index = 1U; (index < field->byteCount) && (index < 4U); index++)
+    {
+        value |= (uint32_t)data[index] << (8U * index);
+    }
+    value >>= shift;
+    if (field->byteCount > 4U)
+    {
+        value |= (uint32_t)data[4] << (32U - shift);
+    }
+    value &= field->mask;
+    if ((field->logicalMinimum < 0) && (0U != (value & ~(field->mask >> 1U))))
+    {
+        /* sign extend */
+        value |= ~field->mask;
+    }
+    return (int32_t)value;
+}
+
+uint32_t USB_HostHidUpdateFields(const usb_host_hid_field_t *fields,
+                                 uint32_t fieldCount,
+                                 const uint8_t *report,
+                                 uint32_t reportLength,
+                                 int32_t *values,
+                                 uint32_t *changedMap)
+{
+    const usb_host_hid_field_t *field;
+    uint32_t changed = 0U;
+    int32_t value;
+
+    if ((NULL == fields) || (NULL == report) || (NULL == values) || (0U == reportLength))
+    {
+        return 0U;
+    }
+    if (NULL != changedMap)
+    {
+        (void)memset(changedMap, 0, ((fieldCount + 31U) / 32U) * sizeof(uint32_t));
+    }
+
+    for (uint32_t index = 0U; index < fieldCount; index++)
+    {
+        field = &fields[index];
+        if ((USB_HOST_HID_REPORT_TYPE_INPUT != field->reportType) ||
+            ((0U != field->reportId) && (field->reportId != report[0])) ||
+            ((((uint32_t)field->bitOffset >> 3U) + field->byteCount) > reportLength))
+        {
+            continue;
+        }
+        value = USB_HostHidGetFieldValue(field, report);
+        if (value != values[index])
+        {
+            values[index] = value;
+            if (NULL != changedMap)
+            {
+                changedMap[index >> 5U] |= 1UL << (index & 0x1FU);
+            }
+            changed++;
+        }
+    }
+    return changed;
+}
+
+
+#if ((defined(USB_HOST_CONFIG_HID_POLL_ENGINE)) && (USB_HOST_CONFIG_HID_POLL_ENGINE > 0U))
+#if ((defined USB_HOST_CONFIG_CLASS_AUTO_CLEAR_STALL) && USB_HOST_CONFIG_CLASS_AUTO_CLEAR_STALL)
+static void USB_HostHidClearPollHaltCallback(void *param, usb_host_transfer_t *transfer, usb_status_t status)
+{
+    usb_host_hid_instance_t *hidInstance = (usb_host_hid_instance_t *)param;
+
+    /* the polling engine is stopped by the stall, it is started again by the application */
+    hidInstance->controlTransfer = NULL;
+    (void)USB_HostFreeTransfer(hidInstance->hostHandle, transfer);
+}
+#endif
+
+static void USB_HostHidPollRelease(void *param)
+{
+    usb_host_hid_instance_t *hidInstance = (usb_host_hid_instance_t *)param;
+    usb_host_hid_poll_t *poll            = hidInstance->inPoll;
+
+    hidInstance->inPoll = NULL;
+    if (poll->config.callbackFn != NULL)
+    {
+        poll->config.callbackFn(poll->config.callbackParam, (uint32_t)kUSB_HostHidPollEventStopped, 0U);
+    }
+    OSA_MemoryFree(poll);
+}
+
+/*!
+ * @brief hid polling engine interrupt in pipe transfer callback, the transfer is armed again.
+ *
+ * @param param       callback parameter.
+ * @param transfer    callback transfer.
+ * @param status      transfer status.
+ */
+static void USB_HostHidPollCallback(void *param, usb_host_transfer_t *transfer, usb_status_t status)
+{
+    usb_host_hid_instance_t *hidInstance = (usb_host_hid_instance_t *)param;
+    usb_host_hid_poll_t *poll            = hidInstance->inPoll;
+    usb_host_hid_poll_callback_t callbackFn;
+    void *callbackParam;
+    uint32_t event = (uint32_t)kUSB_HostHidPollEventStopped;
+
+    if (0U != USB_HostClassEngineTransferDone(&poll->engine, status))
+    {
+        return;
+    }
+
+    callbackFn    = poll->config.callbackFn;
+    callbackParam = poll->config.callbackParam;
+    if (status == kStatus_USB_TransferStall)
+    {
+        poll->statistic.errorCount++;
+#if ((defined USB_HOST_CONFIG_CLASS_AUTO_CLEAR_STALL) && USB_HOST_CONFIG_CLASS_AUTO_CLEAR_STALL)
+        (void)USB_HostHidClearHalt(
+            hidInstance, transfer, USB_HostHidClearPollHaltCallback,
+            (USB_REQUEST_TYPE_DIR_IN | ((usb_host_pipe_t *)hidInstance->inPipe)->endpointAddress));
+#endif
+        if (callbackFn != NULL)
+        {
+            callbackFn(callbackParam, (uint32_t)kUSB_HostHidPollEventStall, USB_HostClassRingCount(&poll->ring));
+        }
+        /* the other armed transfers are canceled, the last one releases the engine */
+        (void)USB_HostHidPollStop(hidInstance);
+        return;
+    }
+
+    if (status != kStatus_USB_Success)
+    {
+        poll->statistic.errorCount++;
+    }
+    else if (transfer->transferSofar == 0U)
+    {
+        /*no action*/
+    }
+    else if (USB_HostClassRingPutRecord(&poll->ring, transfer->transferBuffer, transfer->transferSofar) > 0U)
+    {
+        poll->statistic.reportCount++;
+        event = (uint32_t)kUSB_HostHidPollEventReport;
+    }
+    else
+    {
+        poll->statistic.overrunCount++;
+        event = (uint32_t)kUSB_HostHidPollEventOverrun;
+    }
+
+    transfer->transferLength = poll->config.reportLength;
+    status                   = USB_HostClassEngineResubmit(&poll->engine, hidInstance->inPipe, transfer);
+    if (status == kStatus_USB_TransferCancel)
+    {
+        /* no transfer is armed, the engine is released */
+        return;
+    }
+    if (status != kStatus_USB_Success)
+    {
+#ifdef HOST_ECHO
+        usb_echo("hid poll fail to arm transfer\r\n");
+#endif
+        poll->statistic.errorCount++;
+    }
+
+    /* the engine can be stopped and released in the callback, it is not accessed after */
+    if ((callbackFn != NULL) && (event != (uint32_t)kUSB_HostHidPollEventStopped))
+    {
+        callbackFn(callbackParam, event, USB_HostClassRingCount(&poll->ring));
+    }
+}
+
+usb_status_t USB_HostHidPollStart(usb_host_class_handle classHandle, usb_host_hid_poll_config_t *config)
+{
+    usb_host_hid_instance_t *hidInstance = (usb_host_hid_instance_t *)classHandle;
+    usb_status_t status                  = kStatus_USB_Success;
+    usb_host_hid_poll_t *poll;
+    uint32_t reportLength;
+
+    if (classHandle == NULL)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if ((config == NULL) || (config->ringBuffer == NULL) || (config->transferBuffer == NULL) ||
+        (config->transferCount == 0U) || (config->transferCount > USB_HOST_HID_POLL_MAX_TRANSFERS))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    if (hidInstance->inPipe == NULL)
+    {
+        return kStatus_USB_Error;
+    }
+    if (hidInstance->inPoll != NULL)
+    {
+        return kStatus_USB_Busy;
+    }
+    reportLength = (config->reportLength > 0U) ? config->reportLength : hidInstance->inPacketSize;
+    if ((reportLength == 0U) || (config->ringSize < USB_HOST_CLASS_RING_RECORD_SIZE(reportLength)) ||
+        (config->transferBufferSize < ((uint32_t)config->transferCount * reportLength)))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    poll = (usb_host_hid_poll_t *)OSA_MemoryAllocate(sizeof(usb_host_hid_poll_t));
+    if (poll == NULL)
+    {
+        return kStatus_USB_AllocFail;
+    }
+    (void)memset(poll, 0, sizeof(usb_host_hid_poll_t));
+    poll->config              = *config;
+    poll->config.reportLength = reportLength;
+    USB_HostClassEngineInit(&poll->engine, hidInstance->hostHandle, &poll->transfer[0], USB_HostHidPollRelease,
+                            hidInstance);
+    USB_HostClassRingInit(&poll->ring, config->ringBuffer, config->ringSize,
+                          USB_HOST_CLASS_RING_RECORD_SIZE(reportLength));
+    hidInstance->inPoll = poll;
+
+    if (USB_HostClassEngineAllocTransfer(&poll->engine, config->transferCount, config->transferBuffer, reportLength,
+                                         USB_HostHidPollCallback, hidInstance) != kStatus_USB_Success)
+    {
+        poll->config.callbackFn = NULL;
+        USB_HostClassEngineRelease(&poll->engine);
+        return kStatus_USB_AllocFail;
+    }
+
+    /* keep all the transfers armed from the start */
+    for (uint32_t index = 0U; index < config->transferCount; index++)
+    {
+        status = USB_HostClassEngineSubmit(&poll->engine, hidInstance->inPipe, poll->transfer[index]);
+        if (status != kStatus_USB_Success)
+        {
+            break;
+        }
+    }
+    if (status != kStatus_USB_Success)
+    {
+        (void)USB_HostHidPollStop(classHandle);
+        return kStatus_USB_Error;
+    }
+
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_HostHidPollStop(usb_host_class_handle classHandle)
+{
+    usb_host_hid_instance_t *hidInstance = (usb_host_hid_instance_t *)classHandle;
+
+    if (classHandle == NULL)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if (hidInstance->inPoll == NULL)
+    {
+        return kStatus_USB_Error;
+    }
+
+    USB_HostClassEngineStop(&hidInstance->inPoll->engine, hidInstance->inPipe, NULL);
+    return kStatus_USB_Success;
+}
+
+uint32_t USB_HostHidPollRead(usb_host_class_handle classHandle, uint8_t *buffer, uint32_t length)
+{
+    usb_host_hid_instance_t *hidInstance = (usb_host_hid_instance_t *)classHandle;
+    usb_host_hid_poll_t *poll;
+
+    if ((classHandle == NULL) || (buffer == NULL))
+    {
+        return 0U;
+    }
+    poll = hidInstance->inPoll;
+    if ((poll == NULL) || (0U != poll->engine.stopping))
+    {
+        return 0U;
+    }
+
+    return USB_HostClassRingGetRecord(&poll->ring, buffer, length);
+}
+
+usb_status_t USB_HostHidPollGetStatistic(usb_host_class_handle classHandle, usb_host_hid_poll_statistic_t *statistic)
+{
+    usb_host_hid_instance_t *hidInstance = (usb_host_hid_instance_t *)classHandle;
+
+    if ((classHandle == NULL) || (statistic == NULL))
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if (hidInstance->inPoll == NULL)
+    {
+        return kStatus_USB_Error;
+    }
+
+    *statistic = hidInstance->inPoll->statistic;
+    return kStatus_USB_Success;
+}
+#endif
+
 #endif /* USB_HOST_CONFIG_HID */
@@ -9,6 +9,10 @@
 #ifndef _USB_HOST_HID_H_
 #define _USB_HOST_HID_H_
 
+#if ((defined(USB_HOST_CONFIG_HID_POLL_ENGINE)) && (USB_HOST_CONFIG_HID_POLL_ENGINE > 0U))
+#include "usb_host_class_engine.h"
+#endif
+
 /*******************************************************************************
  * HID class public structure, enumerations, macros, functions
  ******************************************************************************/
@@ -53,6 +57,103 @@
 /*! @brief HID get/set protocol request data code */
 #define USB_HOST_HID_REQUEST_PROTOCOL_REPORT (1U)
 
+/*! @brief HID report type, the same code as the report type of the get/set report request */
+#define USB_HOST_HID_REPORT_TYPE_INPUT (1U)
+/*! @brief HID report type, the same code as the report type of the get/set report request */
+#define USB_HOST_HID_REPORT_TYPE_OUTPUT (2U)
+/*! @brief HID report type, the same code as the report type of the get/set report request */
+#define USB_HOST_HID_REPORT_TYPE_FEATURE (3U)
+
+/*! @brief HID report field flag, the bits of the input, output and feature main items */
+#define USB_HOST_HID_FIELD_FLAG_CONSTANT (0x01U)
+/*! @brief HID report field flag, the field is a variable, an array field holds a usage selector */
+#define USB_HOST_HID_FIELD_FLAG_VARIABLE (0x02U)
+/*! @brief HID report field flag, the value is relative to the last report */
+#define USB_HOST_HID_FIELD_FLAG_RELATIVE (0x04U)
+
+/*! @brief The maximum usage and usage range items of one main item the report descriptor parser keeps */
+#ifndef USB_HOST_HID_PARSER_MAX_USAGES
+#define USB_HOST_HID_PARSER_MAX_USAGES (16U)
+#endif
+
+/*! @brief The maximum nesting of the push items the report descriptor parser supports */
+#ifndef USB_HOST_HID_PARSER_STACK_DEPTH
+#define USB_HOST_HID_PARSER_STACK_DEPTH (4U)
+#endif
+
+/*! @brief The maximum count of the reports, the pairs of report ID and report type, in one report descriptor */
+#ifndef USB_HOST_HID_PARSER_MAX_REPORTS
+#define USB_HOST_HID_PARSER_MAX_REPORTS (16U)
+#endif
+
+#if ((defined(USB_HOST_CONFIG_HID_POLL_ENGINE)) && (USB_HOST_CONFIG_HID_POLL_ENGINE > 0U))
+/*! @brief The maximum transfers the polling engine keeps armed on the interrupt IN pipe */
+#ifndef USB_HOST_HID_POLL_MAX_TRANSFERS
+#define USB_HOST_HID_POLL_MAX_TRANSFERS (4U)
+#endif
+
+/*! @brief The report ring size in bytes for reportCount reports of reportLength bytes, the length is kept in front of
+ * each report */
+#define USB_HOST_HID_POLL_RING_SIZE(reportLength, reportCount) \
+    ((reportCount) * USB_HOST_CLASS_RING_RECORD_SIZE(reportLength))
+
+/*! @brief The polling engine events */
+typedef enum _usb_host_hid_poll_event
+{
+    kUSB_HostHidPollEventReport = 0U, /*!< One report is queued into the ring*/
+    kUSB_HostHidPollEventOverrun,     /*!< The ring is full, the received report is dropped*/
+    kUSB_HostHidPollEventStall,       /*!< The endpoint is stalled, the engine stops*/
+    kUSB_HostHidPollEventStopped,     /*!< The engine is stopped, the transfers are released*/
+} usb_host_hid_poll_event_t;
+
+/*!
+ * @brief The polling engine event callback.
+ *
+ * It is called in the host task (the transfer callback context).
+ *
+ * @param param  The callbackParam of the polling configuration.
+ * @param event  See the enumeration usb_host_hid_poll_event_t.
+ * @param count  The reports in the ring.
+ */
+typedef void (*usb_host_hid_poll_callback_t)(void *param, uint32_t event, uint32_t count);
+
+/*! @brief The polling engine configuration */
+typedef struct _usb_host_hid_poll_config
+{
+    uint8_t *ringBuffer;                     /*!< The report ring, see USB_HOST_HID_POLL_RING_SIZE*/
+    uint32_t ringSize;                       /*!< The report ring size in bytes*/
+    uint8_t *transferBuffer;                 /*!< The transfer buffers, transferCount * reportLength bytes*/
+    uint32_t transferBufferSize;             /*!< The transfer buffers size in bytes*/
+    uint32_t reportLength;                   /*!< The maximum report length, 0 means the maximum packet size*/
+    usb_host_hid_poll_callback_t callbackFn; /*!< The event callback, it can be NULL*/
+    void *callbackParam;                     /*!< The first parameter of the event callback*/
+    uint8_t transferCount;                   /*!< The transfers kept armed, 1 to USB_HOST_HID_POLL_MAX_TRANSFERS*/
+} usb_host_hid_poll_config_t;
+
+/*! @brief The polling engine statistics */
+typedef struct _usb_host_hid_poll_statistic
+{
+    uint32_t reportCount;  /*!< Reports queued into the ring*/
+    uint32_t overrunCount; /*!< Reports dropped because the ring is full*/
+    uint32_t errorCount;   /*!< Transfers completed with an error, they are armed again*/
+} usb_host_hid_poll_statistic_t;
+
+/*!
+ * @brief The polling engine structure.
+ *
+ * The class engine keeps the transfers armed. The report ring has one producer, the transfer callback, and one
+ * consumer, USB_HostHidPollRead.
+ */
+typedef struct _usb_host_hid_poll
+{
+    usb_host_hid_poll_config_t config;                              /*!< The polling configuration*/
+    usb_host_hid_poll_statistic_t statistic;                        /*!< The polling statistics*/
+    usb_host_class_engine_t engine;                                 /*!< The class engine of the armed transfers*/
+    usb_host_class_ring_t ring;                                     /*!< The report ring*/
+    usb_host_transfer_t *transfer[USB_HOST_HID_POLL_MAX_TRANSFERS]; /*!< The armed transfers*/
+} usb_host_hid_poll_t;
+#endif
+
 /*! @brief HID instance structure and HID usb_host_class_handle pointer to this structure */
 typedef struct _usb_host_hid_instance
 {
@@ -76,6 +177,9 @@ typedef struct _usb_host_hid_instance
 
     uint16_t inPacketSize;  /*!< HID interrupt in maximum packet size*/
     uint16_t outPacketSize; /*!< HID interrupt out maximum packet size*/
+#if ((defined(USB_HOST_CONFIG_HID_POLL_ENGINE)) && (USB_HOST_CONFIG_HID_POLL_ENGINE > 0U))
+    usb_host_hid_poll_t *inPoll; /*!< The interrupt IN polling engine*/
+#endif
 } usb_host_hid_instance_t;
 
 /*! @brief HID descriptor structure according to the 6.2.1 in HID specification */
@@ -97,6 +201,26 @@ typedef struct _usb_host_hid_class_descriptor
     uint8_t wDescriptorLength[2]; /*!< Numeric expression that is the total size of the optional descriptor*/
 } usb_host_hid_class_descriptor_t;
 
+/*!
+ * @brief HID report field structure, one field is one data element of a report.
+ *
+ * The table of the fields is built by USB_HostHidParseReportDescriptor, the extraction parameters are computed once so
+ * the value is read from a report with few shifts and one mask.
+ */
+typedef struct _usb_host_hid_field
+{
+    uint32_t usage;         /*!< Usage page in the high 16 bits and usage ID, the first usage of an array field*/
+    int32_t logicalMinimum; /*!< Logical minimum, the value is signed when it is negative*/
+    int32_t logicalMaximum; /*!< Logical maximum*/
+    uint32_t mask;          /*!< The value mask of bitSize bits*/
+    uint16_t bitOffset;     /*!< The bit offset in the report, the report ID byte is counted*/
+    uint8_t bitSize;        /*!< The value size in bits, 1 to 32*/
+    uint8_t byteCount;      /*!< The count of the report bytes the value spans, 1 to 5*/
+    uint8_t reportId;       /*!< The report ID, 0 when the report descriptor does not use report ID*/
+    uint8_t reportType;     /*!< The report type, see USB_HOST_HID_REPORT_TYPE_INPUT*/
+    uint8_t flags;          /*!< The low byte of the main item data, see USB_HOST_HID_FIELD_FLAG_CONSTANT*/
+} usb_host_hid_field_t;
+
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -209,7 +333,7 @@ extern usb_status_t USB_HostHidGetReportDescriptor(usb_host_class_handle classHa
  *
  * @retval kStatus_USB_Success        Receive request successfully.
  * @retval kStatus_USB_InvalidHandle  The classHandle is NULL pointer.
- * @retval kStatus_USB_Busy           There is no idle transfer.
+ * @retval kStatus_USB_Busy           There is no idle transfer, or the polling engine is running.
  * @retval kStatus_USB_Error          Pipe is not initialized.
  *                                    Or, send transfer fail. See the USB_HostRecv.
  */
@@ -378,6 +502,147 @@ extern usb_status_t USB_HostHidSetReport(usb_host_class_handle classHandle,
                                          transfer_callback_t callbackFn,
                                          void *callbackParam);
 
+/*!
+ * @brief Compiles the report descriptor into the field table.
+ *
+ * This function parses the report descriptor got by USB_HostHidGetReportDescriptor and fills one field for each data
+ * element of the input, output and feature reports, in the descriptor order. The constant (padding) elements only
+ * move the bit offset. The function can be called with *fieldCount 0 to get the table size.
+ *
+ * @param[in] descriptor      The report descriptor.
+ * @param[in] length          The report descriptor length.
+ * @param[out] fields         The field table, NULL when *fieldCount is 0.
+ * @param[in,out] fieldCount  Passes the field table size and returns the field count of the descriptor.
+ *
+ * @retval kStatus_USB_Success          The descriptor is compiled successfully.
+ * @retval kStatus_USB_InvalidParameter The descriptor is malformed or the parameters are invalid.
+ * @retval kStatus_USB_AllocFail        The field table is too small, *fieldCount returns the needed size.
+ * @retval kStatus_USB_Error            The descriptor exceeds USB_HOST_HID_PARSER_STACK_DEPTH or
+ *                                      USB_HOST_HID_PARSER_MAX_REPORTS.
+ */
+extern usb_status_t USB_HostHidParseReportDescriptor(const uint8_t *descriptor,
+                                                     uint32_t length,
+                                                     usb_host_hid_field_t *fields,
+                                                     uint32_t *fieldCount);
+
+/*!
+ * @brief Finds a field by usage.
+ *
+ * @param[in] fields      The field table.
+ * @param[in] fieldCount  The field count.
+ * @param[in] reportType  The report type, see USB_HOST_HID_REPORT_TYPE_INPUT.
+ * @param[in] usage       The usage page in the high 16 bits and the usage ID.
+ * @param[in] instance    The instance of the usage, 0 for the first field, for example the contact of a touch panel.
+ *
+ * @return The field, NULL if it is not found.
+ */
+extern const usb_host_hid_field_t *USB_HostHidFindField(const usb_host_hid_field_t *fields,
+                                                        uint32_t fieldCount,
+                                                        uint8_t reportType,
+                                                        uint32_t usage,
+                                                        uint32_t instance);
+
+/*!
+ * @brief Gets the value of a field from a report.
+ *
+ * The value is sign extended when the logical minimum is negative. The caller checks the report ID and the report
+ * length, USB_HostHidUpdateFields does it for all fields of a report.
+ *
+ * @param[in] field       The field.
+ * @param[in] report      The report, the report ID byte is included.
+ *
+ * @return The field value.
+ */
+extern int32_t USB_HostHidGetFieldValue(const usb_host_hid_field_t *field, const uint8_t *report);
+
+/*!
+ * @brief Updates the field values from an input report and reports the changed fields.
+ *
+ * This function extracts the input fields of the received report, compares them with the last values and marks the
+ * changed fields in the bitmap, bit (n % 32) of word (n / 32) for field n. The fields of the other reports are
+ * neither updated nor marked.
+ *
+ * @param[in] fields          The field table.
+ * @param[in] fieldCount      The field count.
+ * @param[in] report          The input report, the report ID byte is included.
+ * @param[in] reportLength    The received report length.
+ * @param[in,out] values      The last values of the fields, fieldCount entries, initialized to 0 by the caller.
+ * @param[out] changedMap     The changed field bitmap, (fieldCount + 31) / 32 words, NULL if it is not needed.
+ *
+ * @return The count of the changed fields.
+ */
+extern uint32_t USB_HostHidUpdateFields(const usb_host_hid_field_t *fields,
+                                        uint32_t fieldCount,
+                                        const uint8_t *report,
+                                        uint32_t reportLength,
+                                        int32_t *values,
+                                        uint32_t *changedMap);
+
+#if ((defined(USB_HOST_CONFIG_HID_POLL_ENGINE)) && (USB_HOST_CONFIG_HID_POLL_ENGINE > 0U))
+/*!
+ * @brief Starts the interrupt IN polling engine.
+ *
+ * The engine keeps config->transferCount transfers armed on the interrupt IN pipe, each completed transfer is armed
+ * again from its callback so no polling interval is lost between the reports. The received reports are queued into
+ * the report ring and read by USB_HostHidPollRead. A report is dropped and counted as an overrun when the ring is
+ * full, the zero length reports are not queued.
+ *
+ * The transfers are allocated from the host transfer pool until the engine is stopped. USB_HostHidRecv returns
+ * kStatus_USB_Busy while the engine runs.
+ *
+ * @param[in] classHandle   The class handle.
+ * @param[in] config        The polling configuration, it is copied.
+ *
+ * @retval kStatus_USB_Success              The engine is started.
+ * @retval kStatus_USB_InvalidHandle        The classHandle is NULL pointer.
+ * @retval kStatus_USB_InvalidParameter     The configuration is invalid.
+ * @retval kStatus_USB_Busy                 The engine is running.
+ * @retval kStatus_USB_Error                The pipe is not initialized, or the transfers fail to be armed.
+ * @retval kStatus_USB_AllocFail            There is no memory or idle transfer.
+ */
+extern usb_status_t USB_HostHidPollStart(usb_host_class_handle classHandle, usb_host_hid_poll_config_t *config);
+
+/*!
+ * @brief Stops the interrupt IN polling engine.
+ *
+ * The armed transfers are canceled, kUSB_HostHidPollEventStopped is notified when the transfers are released. The
+ * reports still in the ring are dropped. Changing the interface alternate setting also stops the engine.
+ *
+ * @param[in] classHandle   The class handle.
+ *
+ * @retval kStatus_USB_Success              The engine is stopping or stopped.
+ * @retval kStatus_USB_InvalidHandle        The classHandle is NULL pointer.
+ * @retval kStatus_USB_Error                The engine is not running.
+ */
+extern usb_status_t USB_HostHidPollStop(usb_host_class_handle classHandle);
+
+/*!
+ * @brief Reads the oldest report from the report ring.
+ *
+ * It can be called from one task only, the ring is not locked.
+ *
+ * @param[in] classHandle   The class handle.
+ * @param[out] buffer       Returns the report, a longer report is truncated.
+ * @param[in] length        The buffer length.
+ *
+ * @return The report length, 0 when the ring is empty.
+ */
+extern uint32_t USB_HostHidPollRead(usb_host_class_handle classHandle, uint8_t *buffer, uint32_t length);
+
+/*!
+ * @brief Gets the statistics of the polling engine.
+ *
+ * @param[in] classHandle   The class handle.
+ * @param[out] statistic    Returns the statistics.
+ *
+ * @retval kStatus_USB_Success              The statistics are got.
+ * @retval kStatus_USB_InvalidHandle        The classHandle or statistic is NULL pointer.
+ * @retval kStatus_USB_Error                The engine is not running.
+ */
+extern usb_status_t USB_HostHidPollGetStatistic(usb_host_class_handle classHandle,
+                                                usb_host_hid_poll_statistic_t *statistic);
+#endif
+
 /*! @}*/
 
 #ifdef __cplusplus
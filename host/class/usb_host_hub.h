@@ -88,6 +88,13 @@ typedef struct _usb_host_hub_port_instance
     uint8_t portStatus;             /*!< Port running status*/
     uint8_t resetCount;             /*!< Port reset time*/
     uint8_t speed;                  /*!< Port's device speed*/
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+    uint32_t specStatus;    /*!< The latest port status, wPortStatus in low 16 bits and wPortChange in high 16 bits*/
+    uint32_t debounceFrame; /*!< The frame (ms) from which the connection is stable, the port is checked again after
+                               USB_HOST_HUB_PORT_DEBOUNCE_TIME*/
+    uint8_t pendingClear;   /*!< Bit map of the C_PORT_x features that need clear, bit0 is C_PORT_CONNECTION*/
+    uint8_t pendingStatus;  /*!< 1 - the port status need to be read*/
+#endif
 } usb_host_hub_port_instance_t;
 
 /*! @brief HUB instance structure */
@@ -127,6 +134,13 @@ typedef struct _usb_host_hub_instance
     uint8_t portProcess; /*!< The port that is processing*/
     uint8_t primeStatus; /*!< Data prime transfer status*/
     uint8_t invalid;     /*!< 0/1, when invalid, cannot send transfer to the class*/
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+    uint8_t interruptPrimed;  /*!< 1 - the interrupt in transfer is primed*/
+    uint8_t hubChangePending; /*!< 1 - the HUB status need to be read*/
+    uint8_t enginePort;       /*!< The port whose control transfer is on-going*/
+    uint8_t engineRequest;    /*!< The on-going port request code*/
+    uint8_t engineNextPort;   /*!< The port index from which the engine looks for the next port request*/
+#endif
 #if ((defined(USB_HOST_CONFIG_LOW_POWER_MODE)) && (USB_HOST_CONFIG_LOW_POWER_MODE > 0U))
     uint8_t supportRemoteWakeup; /*!< The HUB supports remote wakeup or not*/
     uint8_t controlRetry;        /*!< Retry count for set remote wakeup feature*/
@@ -25,6 +25,13 @@
 /*! @brief HUB unlock */
 #define USB_HostHubUnlock() OSA_MutexUnlock(hubGlobal->hubMutex)
 
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+/*! @brief The C_PORT_x bits of wPortChange, bit0 is C_PORT_CONNECTION */
+#define USB_HOST_HUB_PORT_CHANGE_MASK (0x1FU)
+/*! @brief The frame number bits that are reported by all controllers */
+#define USB_HOST_HUB_FRAME_MASK (0x7FFU)
+#endif
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -43,6 +50,76 @@ static void USB_HostHubGetInterruptStatus(usb_host_hub_instance_t *hubInstance);
  */
 static void USB_HostHubProcess(usb_host_hub_instance_t *hubInstance);
 
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+/*!
+ * @brief hub port engine, send the next port control transfer if the control pipe is idle.
+ *
+ * @param hubGlobal    hub global instance pointer.
+ * @param hubInstance  hub instance pointer.
+ */
+static void USB_HostHubEngineRun(usb_host_hub_global_t *hubGlobal, usb_host_hub_instance_t *hubInstance);
+
+/*!
+ * @brief process the port status that is got by the engine.
+ *
+ * @param hubGlobal    hub global instance pointer.
+ * @param hubInstance  hub instance pointer.
+ * @param portIndex    port index.
+ */
+static void USB_HostHubEnginePortStatus(usb_host_hub_global_t *hubGlobal,
+                                        usb_host_hub_instance_t *hubInstance,
+                                        uint8_t portIndex);
+
+/*!
+ * @brief the port control transfer fails, the port waits the next status change.
+ *
+ * @param hubGlobal    hub global instance pointer.
+ * @param hubInstance  hub instance pointer.
+ * @param portIndex    port index.
+ */
+static void USB_HostHubEnginePortFail(usb_host_hub_global_t *hubGlobal,
+                                      usb_host_hub_instance_t *hubInstance,
+                                      uint8_t portIndex);
+
+/*!
+ * @brief release the port reset and address 0 enumeration, then the waiting ports can be reset.
+ *
+ * @param hubGlobal    hub global instance pointer.
+ * @param hubInstance  hub instance pointer.
+ * @param portIndex    port index.
+ */
+static void USB_HostHubEngineReleaseReset(usb_host_hub_global_t *hubGlobal,
+                                          usb_host_hub_instance_t *hubInstance,
+                                          uint8_t portIndex);
+
+/*!
+ * @brief whether the port is in the debounce and its connection has been stable for the debounce time.
+ *
+ * @param hubInstance   hub instance pointer.
+ * @param portInstance  port instance pointer.
+ *
+ * @return 1 if the debounce time expires, otherwise 0.
+ */
+static uint8_t USB_HostHubEngineDebounceDone(usb_host_hub_instance_t *hubInstance,
+                                             usb_host_hub_port_instance_t *portInstance);
+
+/*!
+ * @brief whether one port of the hub waits the debounce time.
+ *
+ * @param hubInstance  hub instance pointer.
+ *
+ * @return 1 if one port is debounced, otherwise 0.
+ */
+static uint8_t USB_HostHubEngineDebouncing(usb_host_hub_instance_t *hubInstance);
+
+/*!
+ * @brief hub interrupt in data process, the changed ports are marked and processed by the engine.
+ *
+ * @param hubGlobal    hub global instance pointer.
+ * @param hubInstance  hub instance pointer.
+ */
+static void USB_HostHubEngineProcessData(usb_host_hub_global_t *hubGlobal, usb_host_hub_instance_t *hubInstance);
+#else
 /*!
  * @brief hub port attach process state machine. one device is attached to the port after the state machine.
  *
@@ -70,6 +147,7 @@ static void USB_HostHubProcessPort(usb_host_hub_instance_t *hubInstance);
  * @param hubInstance  hub instance pointer.
  */
 static void USB_HostHubProcessData(usb_host_hub_global_t *hubGlobal, usb_host_hub_instance_t *hubInstance);
+#endif
 
 /*!
  * @brief hub control pipe transfer callback.
@@ -158,11 +236,19 @@ static void USB_HostHubGetInterruptStatus(usb_host_hub_instance_t *hubInstance)
         return;
     }
 
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+    /* the interrupt in transfer is primed independently of the control transfer */
+    if (hubInstance->interruptPrimed != 0U)
+    {
+        return;
+    }
+#else
     /* there is no prime for control or interrupt */
     if (hubInstance->primeStatus != (uint8_t)kPrimeNone)
     {
         return;
     }
+#endif
     portNum = (((uint16_t)hubInstance->portCount) >> 3U);
     /* receive interrupt data */
     if (USB_HostHubInterruptRecv(hubInstance, hubInstance->hubBitmapBuffer, (portNum + 1U),
@@ -174,7 +260,11 @@ static void USB_HostHubGetInterruptStatus(usb_host_hub_instance_t *hubInstance)
     }
     else
     {
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+        hubInstance->interruptPrimed = 1U;
+#else
         hubInstance->primeStatus = (uint8_t)kPrimeInterrupt;
+#endif
     }
 }
 
@@ -314,7 +404,16 @@ static void USB_HostHubProcess(usb_host_hub_instance_t *hubInstance)
                 hubInstance->portList[tmp].deviceHandle = NULL;
                 hubInstance->portList[tmp].resetCount   = USB_HOST_HUB_PORT_RESET_TIMES;
                 hubInstance->portList[tmp].portStatus   = (uint8_t)kPortRunWaitPortChange;
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+                hubInstance->portList[tmp].pendingClear  = 0U;
+                hubInstance->portList[tmp].pendingStatus = 0U;
+#endif
             }
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+            hubInstance->hubChangePending = 0U;
+            hubInstance->enginePort       = 0U;
+            hubInstance->engineNextPort   = 0U;
+#endif
             hubInstance->hubStatus = (uint8_t)kHubRunIdle;
             needPrimeInterrupt     = 1U;
             break;
@@ -380,6 +479,389 @@ static void USB_HostHubProcess(usb_host_hub_instance_t *hubInstance)
     }
 }
 
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+static uint32_t USB_HostHubEngineGetFrame(usb_host_hub_instance_t *hubInstance)
+{
+    usb_host_instance_t *hostInstance = (usb_host_instance_t *)hubInstance->hostHandle;
+    uint32_t frame                    = 0U;
+
+    /* the callbackFn is initialized in USB_HostGetControllerInterface */
+    (void)hostInstance->controllerTable->controllerIoctl(hostInstance->controllerHandle, kUSB_HostGetFrameNumber,
+                                                         &frame);
+#if ((defined USB_HOST_CONFIG_IP3516HS) && (USB_HOST_CONFIG_IP3516HS > 0U))
+    /* IP3516HS reports the micro frame number */
+    if ((hostInstance->controllerId == (uint8_t)kUSB_ControllerIp3516Hs0) ||
+        (hostInstance->controllerId == (uint8_t)kUSB_ControllerIp3516Hs1))
+    {
+        frame >>= 3U;
+    }
+#endif
+    return frame;
+}
+
+static uint8_t USB_HostHubEngineDebounceDone(usb_host_hub_instance_t *hubInstance,
+                                             usb_host_hub_port_instance_t *portInstance)
+{
+    uint32_t frame;
+
+    if (portInstance->portStatus != (uint8_t)kPortRunDebounce)
+    {
+        return 0U;
+    }
+    frame = (USB_HostHubEngineGetFrame(hubInstance) - portInstance->debounceFrame) & USB_HOST_HUB_FRAME_MASK;
+    return (frame >= USB_HOST_HUB_PORT_DEBOUNCE_TIME) ? 1U : 0U;
+}
+
+static uint8_t USB_HostHubEngineDebouncing(usb_host_hub_instance_t *hubInstance)
+{
+    uint8_t portIndex;
+
+    if ((hubInstance->invalid == 1U) || (hubInstance->portList == NULL))
+    {
+        return 0U;
+    }
+    for (portIndex = 0U; portIndex < hubInstance->portCount; ++portIndex)
+    {
+        if (hubInstance->portList[portIndex].portStatus == (uint8_t)kPortRunDebounce)
+        {
+            return 1U;
+        }
+    }
+    return 0U;
+}
+
+static void USB_HostHubEngineReleaseReset(usb_host_hub_global_t *hubGlobal,
+                                          usb_host_hub_instance_t *hubInstance,
+                                          uint8_t portIndex)
+{
+    usb_host_hub_instance_t *hubItem;
+
+    if ((hubGlobal->resetHub != hubInstance) || (hubGlobal->resetPort != portIndex))
+    {
+        return;
+    }
+    hubGlobal->resetHub  = NULL;
+    hubGlobal->resetPort = 0U;
+
+    /* the ports of the other HUBs may wait for the reset */
+    hubItem = hubGlobal->hubList;
+    while (hubItem != NULL)
+    {
+        if (hubItem != hubInstance)
+        {
+            USB_HostHubEngineRun(hubGlobal, hubItem);
+        }
+        hubItem = hubItem->next;
+    }
+}
+
+static void USB_HostHubEnginePortFail(usb_host_hub_global_t *hubGlobal,
+                                      usb_host_hub_instance_t *hubInstance,
+                                      uint8_t portIndex)
+{
+    usb_host_hub_port_instance_t *portInstance = &hubInstance->portList[portIndex - 1U];
+
+    /* the change bits are still set in the HUB, so the port is reported again by the interrupt in */
+    portInstance->pendingClear  = 0U;
+    portInstance->pendingStatus = 0U;
+    if (portInstance->deviceHandle == NULL)
+    {
+        portInstance->portStatus = (uint8_t)kPortRunWaitPortChange;
+        portInstance->resetCount = USB_HOST_HUB_PORT_RESET_TIMES;
+        USB_HostHubEngineReleaseReset(hubGlobal, hubInstance, portIndex);
+    }
+}
+
+static void USB_HostHubEngineRun(usb_host_hub_global_t *hubGlobal, usb_host_hub_instance_t *hubInstance)
+{
+    usb_host_hub_port_instance_t *portInstance;
+    usb_status_t status;
+    uint8_t portIndex;
+    uint8_t count;
+    uint8_t feature;
+
+    if ((hubInstance->invalid == 1U) || (hubInstance->portList == NULL) ||
+        (hubInstance->hubStatus != (uint8_t)kHubRunIdle) || (hubInstance->primeStatus != (uint8_t)kPrimeNone) ||
+        (hubInstance->controlTransfer != NULL))
+    {
+        return;
+    }
+
+    USB_HostHubGetInterruptStatus(hubInstance);
+
+    /* process hub status change firstly */
+    if (hubInstance->hubChangePending != 0U)
+    {
+        hubInstance->hubChangePending = 0U;
+        hubInstance->hubStatus        = (uint8_t)kHubRunGetStatusDone;
+        if (USB_HostHubGetStatus(hubInstance, hubInstance->hubStatusBuffer, 4U, USB_HostHubControlCallback,
+                                 hubInstance) == kStatus_USB_Success)
+        {
+            hubInstance->primeStatus = (uint8_t)kPrimeHubControl;
+            return;
+        }
+#ifdef HOST_ECHO
+        usb_echo("error in usb_class_hub_get_status\r\n");
+#endif
+        hubInstance->hubStatus = (uint8_t)kHubRunIdle;
+    }
+
+    /* look for the port request in turn, so one port cannot starve the others */
+    for (count = 0U; count < hubInstance->portCount; ++count)
+    {
+        portIndex    = (uint8_t)((((uint32_t)hubInstance->engineNextPort + count) % hubInstance->portCount) + 1U);
+        portInstance = &hubInstance->portList[portIndex - 1U];
+        if ((portInstance->pendingStatus == 0U) && (0U != USB_HostHubEngineDebounceDone(hubInstance, portInstance)))
+        {
+            /* the connection has been stable for the debounce time, get the port status once to confirm it */
+            portInstance->pendingStatus = 1U;
+        }
+        if (portInstance->pendingClear != 0U)
+        {
+            feature = 0U;
+            while (0U == (portInstance->pendingClear & (1U << feature)))
+            {
+                feature++;
+            }
+            portInstance->pendingClear &= (uint8_t)(~(1U << feature));
+            hubInstance->engineRequest = USB_REQUEST_STANDARD_CLEAR_FEATURE;
+            status = USB_HostHubClearPortFeature(hubInstance, portIndex, (uint8_t)(C_PORT_CONNECTION + feature),
+                                                 USB_HostHubControlCallback, hubInstance);
+        }
+        else if (portInstance->pendingStatus != 0U)
+        {
+            portInstance->pendingStatus = 0U;
+            hubInstance->engineRequest  = USB_REQUEST_STANDARD_GET_STATUS;
+            status = USB_HostHubGetPortStatus(hubInstance, portIndex, hubInstance->portStatusBuffer, 4U,
+                                              USB_HostHubControlCallback, hubInstance);
+        }
+        else if ((portInstance->portStatus == (uint8_t)kPortRunWaitReset) &&
+                 ((hubGlobal->resetHub == NULL) ||
+                  ((hubGlobal->resetHub == hubInstance) && (hubGlobal->resetPort == portIndex))))
+        {
+            /* only one port is reset and enumerated at address 0 at the same time */
+            hubGlobal->resetHub        = hubInstance;
+            hubGlobal->resetPort       = portIndex;
+            portInstance->portStatus   = (uint8_t)kPortRunWaitCPortReset;
+            hubInstance->engineRequest = USB_REQUEST_STANDARD_SET_FEATURE;
+            status = USB_HostHubSetPortFeature(hubInstance, portIndex, PORT_RESET, USB_HostHubControlCallback,
+                                               hubInstance);
+            if ((status == kStatus_USB_Success) && (portInstance->resetCount > 0U))
+            {
+                portInstance->resetCount--;
+            }
+        }
+        else
+        {
+            continue;
+        }
+
+        if (status == kStatus_USB_Success)
+        {
+            hubInstance->primeStatus = (uint8_t)kPrimePortControl;
+            hubInstance->enginePort  = portIndex;
+            /* clear all change bits of the port back-to-back, then move to the next port */
+            hubInstance->engineNextPort =
+                (portInstance->pendingClear != 0U) ? (portIndex - 1U) : (portIndex % hubInstance->portCount);
+        }
+        else
+        {
+            USB_HostHubEnginePortFail(hubGlobal, hubInstance, portIndex);
+        }
+        break;
+    }
+}
+
+static void USB_HostHubEnginePortStatus(usb_host_hub_global_t *hubGlobal,
+                                        usb_host_hub_instance_t *hubInstance,
+                                        uint8_t portIndex)
+{
+    usb_host_hub_port_instance_t *portInstance = &hubInstance->portList[portIndex - 1U];
+#if ((defined(USB_HOST_CONFIG_LOW_POWER_MODE)) && (USB_HOST_CONFIG_LOW_POWER_MODE > 0U))
+    usb_host_instance_t *hostPointer = (usb_host_instance_t *)hubInstance->hostHandle;
+#endif
+    uint32_t specStatus;
+    uint32_t infoValue = 0U;
+    usb_host_port_app_status_t appStatus;
+
+    specStatus               = USB_LONG_FROM_LITTLE_ENDIAN_ADDRESS(hubInstance->portStatusBuffer);
+    portInstance->specStatus = specStatus;
+    /* all change bits of this status are cleared before the port status is got again */
+    portInstance->pendingClear |= (uint8_t)((specStatus >> C_PORT_CONNECTION) & USB_HOST_HUB_PORT_CHANGE_MASK);
+
+    if (portInstance->deviceHandle != NULL)
+    {
+        if ((0U != ((1UL << PORT_CONNECTION) & specStatus)) && (0U == ((1UL << C_PORT_CONNECTION) & specStatus)))
+        {
+#if ((defined(USB_HOST_CONFIG_LOW_POWER_MODE)) && (USB_HOST_CONFIG_LOW_POWER_MODE > 0U))
+            if (0U != ((1UL << C_PORT_SUSPEND) & specStatus))
+            {
+                if (0U != ((1UL << PORT_SUSPEND) & specStatus))
+                {
+                    portInstance->portStatus = (uint8_t)kPortRunPortSuspended; /* update as next state */
+                    /* call host callback function, function is initialized in USB_HostInit */
+                    (void)hostPointer->deviceCallback(hostPointer->suspendedDevice, NULL,
+                                                      kUSB_HostEventSuspended); /* call host callback function */
+                }
+                else
+                {
+                    portInstance->portStatus = (uint8_t)kPortRunPortAttached; /* update as next state */
+                    /* call host callback function, function is initialized in USB_HostInit */
+                    (void)hostPointer->deviceCallback(hostPointer->suspendedDevice, NULL,
+                                                      kUSB_HostEventResumed); /* call host callback function */
+                    hostPointer->suspendedDevice = NULL;
+                }
+            }
+#endif
+            return;
+        }
+        /* port's device is detached, or detached and attached again */
+        (void)USB_HostDetachDeviceInternal(hubInstance->hostHandle, portInstance->deviceHandle);
+        portInstance->deviceHandle = NULL;
+        portInstance->portStatus   = (uint8_t)kPortRunWaitPortChange;
+    }
+
+    if (0U == ((1UL << PORT_CONNECTION) & specStatus))
+    {
+        /* no device, or the device is removed during the debounce or reset */
+        portInstance->portStatus = (uint8_t)kPortRunWaitPortChange;
+        portInstance->resetCount = USB_HOST_HUB_PORT_RESET_TIMES;
+        USB_HostHubEngineReleaseReset(hubGlobal, hubInstance, portIndex);
+        return;
+    }
+
+    appStatus = (usb_host_port_app_status_t)portInstance->portStatus;
+    switch (appStatus)
+    {
+        case kPortRunWaitCPortReset: /* wait C_PORT_RESET */
+            if (0U != ((1UL << C_PORT_RESET) & specStatus))
+            {
+                if (portInstance->resetCount > 0U)
+                {
+                    /* reset again, the port keeps the reset */
+                    portInstance->portStatus = (uint8_t)kPortRunWaitReset;
+                    break;
+                }
+                /* get port's device speed */
+                if (0U != (specStatus & (1UL << PORT_HIGH_SPEED)))
+                {
+                    portInstance->speed = USB_SPEED_HIGH;
+                }
+                else if (0U != (specStatus & (1UL << PORT_LOW_SPEED)))
+                {
+                    portInstance->speed = USB_SPEED_LOW;
+                }
+                else
+                {
+                    portInstance->speed = USB_SPEED_FULL;
+                }
+                portInstance->portStatus = (uint8_t)kPortRunPortAttached;
+                (void)USB_HostHelperGetPeripheralInformation(hubInstance->deviceHandle,
+                                                             (uint32_t)kUSB_HostGetDeviceAddress, &infoValue);
+                (void)USB_HostAttachDevice(hubInstance->hostHandle, portInstance->speed, (uint8_t)infoValue, portIndex,
+                                           hubInstance->hubLevel + 1U, &portInstance->deviceHandle);
+                portInstance->resetCount = USB_HOST_HUB_PORT_RESET_TIMES;
+                USB_HostHubEngineReleaseReset(hubGlobal, hubInstance, portIndex);
+            }
+            break;
+
+        case kPortRunWaitReset: /* the engine resets the port when no other port is reset */
+            break;
+
+        case kPortRunDebounce:
+            if (0U != ((1UL << C_PORT_CONNECTION) & specStatus))
+            {
+                /* the connection bounces, debounce again */
+                portInstance->debounceFrame = USB_HostHubEngineGetFrame(hubInstance);
+            }
+            else if (0U != USB_HostHubEngineDebounceDone(hubInstance, portInstance))
+            {
+                portInstance->portStatus = (uint8_t)kPortRunWaitReset;
+            }
+            else
+            {
+                /*no action*/
+            }
+            break;
+
+        default: /* the connection is detected */
+            /* the port status is not polled in the debounce, the next bounce sets C_PORT_CONNECTION again and it is
+             * reported by the interrupt in, and USB_HostHubEngineTimer checks the port when the debounce time expires.
+             */
+            portInstance->portStatus    = (uint8_t)kPortRunDebounce;
+            portInstance->debounceFrame = USB_HostHubEngineGetFrame(hubInstance);
+            break;
+    }
+}
+
+void USB_HostHubEngineTimer(usb_host_handle hostHandle)
+{
+    usb_host_hub_global_t *hubGlobal = USB_HostHubGetHubList(hostHandle);
+    usb_host_hub_instance_t *hubInstance;
+
+    if (hubGlobal == NULL)
+    {
+        return;
+    }
+    hubInstance = hubGlobal->hubList;
+    while (hubInstance != NULL)
+    {
+        if (0U != USB_HostHubEngineDebouncing(hubInstance))
+        {
+            USB_HostHubEngineRun(hubGlobal, hubInstance);
+        }
+        hubInstance = hubInstance->next;
+    }
+}
+
+uint8_t USB_HostHubEngineTimerPending(usb_host_handle hostHandle)
+{
+    usb_host_hub_global_t *hubGlobal = USB_HostHubGetHubList(hostHandle);
+    usb_host_hub_instance_t *hubInstance;
+
+    if (hubGlobal == NULL)
+    {
+        return 0U;
+    }
+    hubInstance = hubGlobal->hubList;
+    while (hubInstance != NULL)
+    {
+        if (0U != USB_HostHubEngineDebouncing(hubInstance))
+        {
+            return 1U;
+        }
+        hubInstance = hubInstance->next;
+    }
+    return 0U;
+}
+
+static void USB_HostHubEngineProcessData(usb_host_hub_global_t *hubGlobal, usb_host_hub_instance_t *hubInstance)
+{
+    uint8_t portIndex;
+
+    /* mark all the changed ports, the engine services them in turn */
+    for (portIndex = 0U; portIndex <= hubInstance->portCount; ++portIndex)
+    {
+        if (0U != ((0x01U << (portIndex & 0x07U)) & (hubInstance->hubBitmapBuffer[portIndex >> 3U])))
+        {
+            if (portIndex == 0U) /* hub status change */
+            {
+                hubInstance->hubChangePending = 1U;
+            }
+            else if (hubInstance->portList != NULL)
+            {
+                hubInstance->portList[portIndex - 1U].pendingStatus = 1U;
+            }
+            else
+            {
+                /*no action*/
+            }
+        }
+    }
+
+    USB_HostHubEngineRun(hubGlobal, hubInstance);
+}
+#else
 static void USB_HostHubProcessPort(usb_host_hub_instance_t *hubInstance)
 {
     usb_host_hub_port_instance_t *portInstance = &hubInstance->portList[hubInstance->portProcess - 1U];
@@ -832,11 +1314,15 @@ static void USB_HostHubProcessData(usb_host_hub_global_t *hubGlobal, usb_host_hu
         USB_HostHubGetInterruptStatus(hubInstance);
     }
 }
+#endif
 
 static void USB_HostHubControlCallback(void *param, uint8_t *data, uint32_t data_len, usb_status_t status)
 {
     usb_host_hub_instance_t *hubInstance = (usb_host_hub_instance_t *)param;
     usb_host_hub_global_t *hubGlobal     = USB_HostHubGetHubList(hubInstance->hostHandle);
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+    uint8_t portIndex;
+#endif
     if (hubGlobal == NULL)
     {
         return;
@@ -850,9 +1336,28 @@ static void USB_HostHubControlCallback(void *param, uint8_t *data, uint32_t data
     {
         /* if transfer fail, prime a new interrupt in transfer */
         hubInstance->primeStatus = (uint8_t)kPrimeNone;
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+        if (hubInstance->enginePort != 0U)
+        {
+            portIndex               = hubInstance->enginePort;
+            hubInstance->enginePort = 0U;
+            USB_HostHubEnginePortFail(hubGlobal, hubInstance, portIndex);
+        }
+        else if ((hubInstance->hubStatus == (uint8_t)kHubRunGetStatusDone) ||
+                 (hubInstance->hubStatus == (uint8_t)kHubRunClearDone))
+        {
+            hubInstance->hubStatus = (uint8_t)kHubRunIdle;
+        }
+        else
+        {
+            /*no action*/
+        }
+        USB_HostHubEngineRun(hubGlobal, hubInstance);
+#else
         hubGlobal->hubProcess    = NULL;
         hubInstance->portProcess = 0U;
         USB_HostHubGetInterruptStatus(hubInstance);
+#endif
         return;
     }
 
@@ -864,12 +1369,26 @@ static void USB_HostHubControlCallback(void *param, uint8_t *data, uint32_t data
     else if (hubInstance->primeStatus == (uint8_t)kPrimePortControl) /* hub's port related control transfer */
     {
         hubInstance->primeStatus = (uint8_t)kPrimeNone;
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+        portIndex               = hubInstance->enginePort;
+        hubInstance->enginePort = 0U;
+        /* the clear feature and reset request need nothing, the port change is reported by the interrupt in */
+        if (hubInstance->engineRequest == USB_REQUEST_STANDARD_GET_STATUS)
+        {
+            USB_HostHubEnginePortStatus(hubGlobal, hubInstance, portIndex);
+        }
+#else
         USB_HostHubProcessPort(hubInstance);
+#endif
     }
     else
     {
         /*no action*/
     }
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+    /* the control pipe is idle, send the next hub or port request */
+    USB_HostHubEngineRun(hubGlobal, hubInstance);
+#endif
 }
 
 #if ((defined(USB_HOST_CONFIG_LOW_POWER_MODE) && (USB_HOST_CONFIG_LOW_POWER_MODE > 0U)) || \
@@ -1122,6 +1641,21 @@ void USB_HostHubInterruptInCallback(void *param, uint8_t *data, uint32_t data_le
         return;
     }
     /* interrupt data received */
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+    hubInstance->interruptPrimed = 0U;
+    if (status != kStatus_USB_Success)
+    {
+#ifdef HOST_ECHO
+        usb_echo("hub interrupt in data callback error\r\n");
+#endif
+        /* prime next interrupt transfer when the control pipe is idle */
+        USB_HostHubEngineRun(hubGlobal, hubInstance);
+    }
+    else
+    {
+        USB_HostHubEngineProcessData(hubGlobal, hubInstance); /* process the interrupt data */
+    }
+#else
     hubInstance->primeStatus = (uint8_t)kPrimeNone;
     if (status != kStatus_USB_Success)
     {
@@ -1140,6 +1674,7 @@ void USB_HostHubInterruptInCallback(void *param, uint8_t *data, uint32_t data_le
     {
         USB_HostHubProcessData(hubGlobal, hubInstance); /* process the interrupt data */
     }
+#endif
 }
 
 /*!
@@ -1338,6 +1873,10 @@ usb_status_t USB_HostHubDeviceEvent(usb_host_handle hostHandle,
                 (void)usb_echo("address=%u\r\n", infoValue);
 #endif
                 hubInstance->invalid = 1U;
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+                /* the other HUBs' ports can be reset if the HUB's port owns the reset */
+                USB_HostHubEngineReleaseReset(hubGlobal, hubInstance, hubGlobal->resetPort);
+#endif
                 /* detach hub ports' devices */
                 for (uint8_t portIndex = 0U; portIndex < hubInstance->portCount; ++portIndex)
                 {
@@ -1409,6 +1948,14 @@ usb_status_t USB_HostHubRemovePort(usb_host_handle hostHandle, uint8_t hubNumber
     /* set port's status as default, and reset port */
     if (hubInstance != NULL)
     {
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+        /* the port is debounced and reset again by the engine */
+        hubInstance->portList[portNumber - 1U].deviceHandle  = NULL;
+        hubInstance->portList[portNumber - 1U].portStatus    = (uint8_t)kPortRunWaitPortChange;
+        hubInstance->portList[portNumber - 1U].resetCount    = USB_HOST_HUB_PORT_RESET_TIMES;
+        hubInstance->portList[portNumber - 1U].pendingStatus = 1U;
+        USB_HostHubEngineRun(hubGlobal, hubInstance);
+#else
         hubInstance->portList[portNumber - 1U].deviceHandle = NULL;
         hubInstance->portList[portNumber - 1U].portStatus   = (uint8_t)kPortRunInvalid;
         if (hubInstance->portProcess == portNumber)
@@ -1416,6 +1963,7 @@ usb_status_t USB_HostHubRemovePort(usb_host_handle hostHandle, uint8_t hubNumber
             hubInstance->portProcess = 0U;
         }
         (void)USB_HostHubSendPortReset(hubInstance, portNumber);
+#endif
     }
     return kStatus_USB_Error;
 }
@@ -18,6 +18,13 @@
 /*! @brief HUB reset times*/
 #define USB_HOST_HUB_PORT_RESET_TIMES (1)
 
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+/*! @brief HUB port connect debounce time (unit: ms), TATTDB in USB 2.0 specification*/
+#ifndef USB_HOST_HUB_PORT_DEBOUNCE_TIME
+#define USB_HOST_HUB_PORT_DEBOUNCE_TIME (100U)
+#endif
+#endif
+
 #if ((defined(USB_HOST_CONFIG_LOW_POWER_MODE)) && (USB_HOST_CONFIG_LOW_POWER_MODE > 0U))
 /*! @brief HUB Control tansaction retry times for remote wakeup*/
 #define USB_HOST_HUB_REMOTE_WAKEUP_TIMES (3U)
@@ -29,6 +36,10 @@ typedef struct _usb_host_hub_global
     usb_host_handle hostHandle;                            /*!< This HUB list belong to this host*/
     usb_host_hub_instance_t *hubProcess;                   /*!< HUB in processing*/
     usb_host_hub_instance_t *hubList;                      /*!< host's HUB list*/
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+    usb_host_hub_instance_t *resetHub; /*!< The HUB whose port owns the reset and address 0 enumeration*/
+    uint8_t resetPort;                 /*!< The port that owns the reset and address 0 enumeration*/
+#endif
     osa_mutex_handle_t hubMutex;                           /*!< HUB mutex*/
     uint32_t mutexBuffer[(OSA_MUTEX_HANDLE_SIZE + 3) / 4]; /*!< The mutex buffer. */
 } usb_host_hub_global_t;
@@ -68,6 +79,10 @@ typedef enum _usb_host_port_app_status
     kPortRunCheckPortSuspend,  /*!< Check PORT_SUSPEND */
     kPortRunPortSuspended,     /*!< Port is suspended */
 #endif
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+    kPortRunDebounce,  /*!< Wait the connection is stable */
+    kPortRunWaitReset, /*!< Wait the reset is allowed */
+#endif
 } usb_host_port_app_status_t;
 
 /*! @brief HUB data prime status */
@@ -165,6 +180,26 @@ usb_status_t USB_HostHubDeviceEvent(usb_host_handle hostHandle,
  * @return port number.
  */
 uint32_t USB_HostHubGetHsHubPort(usb_host_handle hostHandle, uint8_t parentHubNo, uint8_t parentPortNo);
+#if ((defined(USB_HOST_CONFIG_HUB_ENGINE)) && (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+/*!
+ * @brief hub engine timer, the ports whose debounce time expires are checked.
+ *
+ * The controller drivers call it from their periodic task event (timer or SOF), in the host task context.
+ *
+ * @param hostHandle  host handle.
+ */
+void USB_HostHubEngineTimer(usb_host_handle hostHandle);
+/*!
+ * @brief whether one port of the host's HUBs waits the debounce time.
+ *
+ * The controller drivers keep their periodic task event running when it returns 1.
+ *
+ * @param hostHandle  host handle.
+ *
+ * @return 1 if one port is debounced, otherwise 0.
+ */
+uint8_t USB_HostHubEngineTimerPending(usb_host_handle hostHandle);
+#endif
 #endif /* USB_HOST_CONFIG_HUB */
 
 #endif /* _USB_HOST_HUB_APP_H_ */
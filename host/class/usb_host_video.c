@@ -433,6 +433,7 @@ usb_status_t USB_HostVideoStreamSetInterface(usb_host_class_handle classHandle,
     usb_host_interface_t *interface_ptr;
     usb_host_transfer_t *transfer;
     usb_host_video_descriptor_union_t descUnion;
+    usb_descriptor_interface_t *interfaceDesc;
     uint32_t length, ep = 0U;
     uint32_t descLength = 0;
     void *temp;
@@ -488,19 +489,14 @@ usb_status_t USB_HostVideoStreamSetInterface(usb_host_class_handle classHandle,
     }
     else
     {
-        descUnion.bufr = interface_ptr->interfaceExtension;
-        length         = 0U;
-        while (length < interface_ptr->interfaceExtensionLength)
+        if (USB_HostHelperGetAlternateSettingDescriptor(interfaceHandle, alternateSetting, &interfaceDesc) !=
+            kStatus_USB_Success)
         {
-            if ((descUnion.common->bDescriptorType == USB_DESCRIPTOR_TYPE_INTERFACE) &&
-                (descUnion.interface->bAlternateSetting == alternateSetting))
-            {
-                interface_ptr->epCount = descUnion.interface->bNumEndpoints;
-                break;
-            }
-            length += descUnion.common->bLength;
-            descUnion.bufr += descUnion.common->bLength;
+            return kStatus_USB_InvalidParameter;
         }
+        temp                   = (void *)interfaceDesc;
+        descUnion.bufr         = (uint8_t *)temp;
+        interface_ptr->epCount = interfaceDesc->bNumEndpoints;
 
         while (ep < interface_ptr->epCount)
         {
@@ -197,6 +197,13 @@ typedef struct _usb_host_ep
     uint16_t epExtensionLength;        /*!< Extended descriptor length*/
 } usb_host_ep_t;
 
+#if ((defined(USB_HOST_CONFIG_DESCRIPTOR_CACHE)) && (USB_HOST_CONFIG_DESCRIPTOR_CACHE > 0U))
+/*! @brief The max alternate setting number of one interface that is indexed */
+#ifndef USB_HOST_CONFIG_INTERFACE_MAX_ALTSETTING
+#define USB_HOST_CONFIG_INTERFACE_MAX_ALTSETTING (16U)
+#endif
+#endif
+
 /*! @brief USB host interface information structure */
 typedef struct _usb_host_interface
 {
@@ -207,6 +214,11 @@ typedef struct _usb_host_interface
     uint8_t interfaceIndex;                                 /*!< The interface index*/
     uint8_t alternateSettingNumber;                         /*!< The interface alternate setting value*/
     uint8_t epCount;                                        /*!< Interface's endpoint number*/
+#if ((defined(USB_HOST_CONFIG_DESCRIPTOR_CACHE)) && (USB_HOST_CONFIG_DESCRIPTOR_CACHE > 0U))
+    usb_descriptor_interface_t
+        *altSettingDesc[USB_HOST_CONFIG_INTERFACE_MAX_ALTSETTING]; /*!< Interface descriptor of every alternate setting,
+                                                                        the index is the alternate setting value*/
+#endif
 } usb_host_interface_t;
 
 /*! @brief USB host configuration information structure */
@@ -219,6 +231,39 @@ typedef struct _usb_host_configuration
     uint8_t interfaceCount;                            /*!< The configuration's interface number*/
 } usb_host_configuration_t;
 
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+/*! @brief Latency histogram bucket number of the host metrics */
+#ifndef USB_HOST_METRICS_LATENCY_BUCKETS
+#define USB_HOST_METRICS_LATENCY_BUCKETS (8U)
+#endif
+
+/*! @brief USB host transfer metrics, they are recorded for every pipe and every device */
+typedef struct _usb_host_metrics
+{
+    uint32_t transfers;    /*!< Completed transfer count*/
+    uint32_t bytes;        /*!< Transferred data length*/
+    uint32_t shortPackets; /*!< Count of the transfers that complete with less data than the requested length*/
+    uint32_t naks;         /*!< NAK count, only the controllers that retry NAK in software (KHCI) report it*/
+    uint32_t timeouts;     /*!< Count of the transfers that are terminated by the controller timeout*/
+    uint32_t stalls;       /*!< Count of the transfers that complete with STALL*/
+    uint32_t errors;       /*!< Count of the transfers that fail*/
+    uint32_t retries;      /*!< Count of the control transfers that are retried by the enumeration*/
+    uint32_t latency[USB_HOST_METRICS_LATENCY_BUCKETS]; /*!< Submit-to-complete latency histogram, bucket 0 counts the
+                                                           latency less than 1 ms, bucket n counts the latency in
+                                                           [2^(n-1), 2^n) ms, the last bucket counts all longer ones*/
+} usb_host_metrics_t;
+#endif
+
+#if ((defined(USB_HOST_CONFIG_LOOPBACK)) && (USB_HOST_CONFIG_LOOPBACK > 0U))
+/*! @brief USB host loopback controller statistics, the bus statistics are got from the device loopback controller */
+typedef struct _usb_host_loopback_statistic
+{
+    uint32_t transfers;   /*!< Completed transfer count*/
+    uint32_t bytes;       /*!< Transferred data length*/
+    uint64_t stackCycles; /*!< CPU cycles spent in the host stack and the class drivers to handle the completions*/
+} usb_host_loopback_statistic_t;
+#endif
+
 /*! @brief USB host pipe common structure */
 typedef struct _usb_host_pipe
 {
@@ -234,8 +279,30 @@ typedef struct _usb_host_pipe
     uint8_t direction;              /*!< Pipe direction*/
     uint8_t pipeType;               /*!< Pipe type, for example USB_ENDPOINT_BULK*/
     uint8_t numberPerUframe;        /*!< Transaction number per micro-frame*/
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    usb_host_metrics_t metrics; /*!< The pipe's transfer metrics*/
+#endif
 } usb_host_pipe_t;
 
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+/*!
+ * @brief USB host ISO packet descriptor structure.
+ *
+ * One descriptor is one packet in one service interval of the ISO pipe. The length is not more than the data of one
+ * service interval (maxPacketSize * numberPerUframe for the high-bandwidth endpoint). The offsets must be in the
+ * ascending order. The EHCI high-speed ITD also requires the packets of one ITD (eight micro-frames) to be in seven 4K
+ * pages. The transfer is rejected with kStatus_USB_InvalidParameter when the descriptors don't meet these rules.
+ */
+typedef struct _usb_host_iso_packet_descriptor
+{
+    uint32_t offset;       /*!< Packet data offset in the transfer buffer*/
+    uint32_t length;       /*!< Requested packet length*/
+    uint32_t actualLength; /*!< Transferred packet length, it is filled by the controller driver*/
+    usb_status_t status;   /*!< Packet result, it is filled by the controller driver, kStatus_USB_TransferCancel means
+                                the packet is not transferred*/
+} usb_host_iso_packet_descriptor_t;
+#endif
+
 /*! @brief USB host transfer structure */
 typedef struct _usb_host_transfer
 {
@@ -261,6 +328,28 @@ typedef struct _usb_host_transfer
         uint32_t frame;    /*!< KHCI transfer frame number */
     } union2;
 
+    uint32_t timeout; /*!< Transfer timeout in ms for control and bulk transfers. It is counted from the time the
+                           transfer becomes the first pending transfer of its pipe, the data progress doesn't extend
+                           it, and the transfer completes with kStatus_USB_TransferFailed when it expires. 0 means the
+                           controller default (USB_HOST_CONTROL_TRANSFER_TIMEOUT or USB_HOST_BULK_TRANSFER_TIMEOUT,
+                           the EHCI default restarts when data moves and the KHCI default is the NAK timeout). */
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+    struct _usb_host_transfer *timeoutNext; /*!< The next transfer in the same timeout wheel slot*/
+    struct _usb_host_transfer *timeoutPrev; /*!< The previous transfer in the same timeout wheel slot*/
+    uint32_t timeoutDeadline;               /*!< Timeout wheel tick at which the transfer expires*/
+    uint32_t timeoutProgress;               /*!< Controller progress snapshot taken when the transfer is armed*/
+    uint8_t timeoutStarted; /*!< The transfer is armed with its timeout, otherwise it waits to become the first one*/
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    uint32_t submitFrame; /*!< The frame (ms) when the transfer is submitted, used by the latency metrics*/
+#endif
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    usb_host_iso_packet_descriptor_t *isoPacketDescriptor; /*!< ISO packet descriptor array; NULL means the buffer
+                                                                is split by the data length of one service interval*/
+    uint32_t isoPacketCount;                               /*!< ISO packet descriptor count*/
+    uint32_t isoPacketIndex; /*!< The next ISO packet, it is used by the controller drivers that move the packets
+                                  one by one*/
+#endif
 #if USB_HOST_CONFIG_KHCI
     uint16_t nakTimeout; /*!< KHCI transfer NAK timeout */
     uint16_t retry;      /*!< KHCI transfer retry */
@@ -281,6 +370,18 @@ typedef struct _usb_host_pipe_init
     uint8_t numberPerUframe; /*!< Transaction number for each micro-frame*/
 } usb_host_pipe_init_t;
 
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+/*!
+ * @brief Pipe type flag that requests the interrupt context transfer completion.
+ *
+ * OR it into usb_host_pipe_init_t::pipeType when calling USB_HostOpenPipe. The pipe's transfer callback is called in
+ * the controller ISR, so it must not call the APIs that lock the host mutex (for example USB_HostRecv); queue more than
+ * one transfer to keep the endpoint polled while the task primes the next one. The controller that doesn't support it
+ * (only the EHCI interrupt pipe supports it now) completes the pipe's transfers in the host task as usual.
+ */
+#define USB_HOST_PIPE_COMPLETION_ISR (0x80U)
+#endif
+
 /*! @brief Cancel transfer parameter structure */
 typedef struct _usb_host_cancel_param
 {
@@ -369,6 +470,25 @@ extern usb_status_t USB_HostHelperParseAlternateSetting(usb_host_interface_handl
                                                         uint8_t alternateSetting,
                                                         usb_host_interface_t *interface);
 
+/*!
+ * @brief Gets the alternate setting interface descriptor.
+ *
+ * The class-specific and endpoint descriptors of the alternate setting follow the returned interface descriptor.
+ * If USB_HOST_CONFIG_DESCRIPTOR_CACHE is enabled the descriptor is got from the index that is built when the
+ * configuration descriptor is parsed, otherwise the interface extended descriptors are searched.
+ *
+ * @param[in] interfaceHandle     The whole interface handle.
+ * @param[in] alternateSetting    Alternate setting value, 0 returns the interface descriptor of the interface handle.
+ * @param[out] interfaceDesc      Return the interface descriptor pointer.
+ *
+ * @retval kStatus_USB_Success              Get successfully.
+ * @retval kStatus_USB_InvalidHandle        The interfaceHandle is a NULL pointer.
+ * @retval kStatus_USB_Error                The alternate setting doesn't exist.
+ */
+extern usb_status_t USB_HostHelperGetAlternateSettingDescriptor(usb_host_interface_handle interfaceHandle,
+                                                                uint8_t alternateSetting,
+                                                                usb_descriptor_interface_t **interfaceDesc);
+
 /*!
  * @brief Removes the attached device.
  *
@@ -431,6 +551,33 @@ extern void USB_HostOhciTaskFunction(void *hostHandle);
  */
 extern void USB_HostIp3516HsTaskFunction(void *hostHandle);
 #endif
+#if (defined(USB_HOST_CONFIG_LOOPBACK) && (USB_HOST_CONFIG_LOOPBACK > 0U))
+/*!
+ * @brief Loopback task function.
+ *
+ * The function schedules the transfers of the loopback controller for one bus (micro)frame. The transactions are
+ * issued to the device loopback controller of the same controller ID, so the device stack must be initialized in the
+ * same image.
+ * In the bare metal environment, this function should be called periodically in the main function.
+ * In the RTOS environment, this function should be used as a function entry to create a task.
+ *
+ * @param[in] hostHandle The host handle.
+ */
+extern void USB_HostLoopbackTaskFunction(void *hostHandle);
+
+/*!
+ * @brief Gets the loopback controller statistics.
+ *
+ * The CPU cycles are read by USB_DEVICE_LOOPBACK_CYCLE_COUNTER, they are not accounted if it is not defined.
+ *
+ * @param[in] hostHandle  The host handle.
+ * @param[out] statistic  Returns the statistics.
+ *
+ * @retval kStatus_USB_Success              Get successfully.
+ * @retval kStatus_USB_InvalidHandle        The hostHandle is a NULL pointer or it is not a loopback host.
+ */
+extern usb_status_t USB_HostLoopbackGetStatistic(usb_host_handle hostHandle, usb_host_loopback_statistic_t *statistic);
+#endif
 #if (defined(USB_HOST_CONFIG_KHCI) && (USB_HOST_CONFIG_KHCI > 0U))
 /*!
  * @brief Device KHCI ISR function.
@@ -515,6 +662,8 @@ extern usb_status_t USB_HostClosePipe(usb_host_handle hostHandle, usb_host_pipe_
  * @brief Sends data to a pipe.
  *
  * This function requests to send the transfer to the specified pipe.
+ * The transfer of the ISO pipe can carry the packet descriptors (usb_host_transfer_t::isoPacketDescriptor), the
+ * results of the packets are filled in the descriptors before the transfer callback.
  *
  * @param[in] hostHandle     The host handle.
  * @param[in] pipeHandle     The sending pipe handle.
@@ -522,6 +671,7 @@ extern usb_status_t USB_HostClosePipe(usb_host_handle hostHandle, usb_host_pipe_
  *
  * @retval kStatus_USB_Success              Send successfully.
  * @retval kStatus_USB_InvalidHandle        The hostHandle, pipeHandle or transfer is a NULL pointer.
+ * @retval kStatus_USB_InvalidParameter     The ISO packet descriptors are invalid.
  * @retval kStatus_USB_LackSwapBuffer       There is no swap buffer for KHCI.
  * @retval kStatus_USB_Error                There is no idle QTD/ITD/SITD for EHCI.
  */
@@ -551,6 +701,8 @@ extern usb_status_t USB_HostSendSetup(usb_host_handle hostHandle,
  * @brief Receives the data from the pipe.
  *
  * This function requests to receive the transfer from the specified pipe.
+ * The transfer of the ISO pipe can carry the packet descriptors (usb_host_transfer_t::isoPacketDescriptor), the
+ * results of the packets are filled in the descriptors before the transfer callback.
  *
  * @param[in] hostHandle     The host handle.
  * @param[in] pipeHandle     The receiving pipe handle.
@@ -558,6 +710,7 @@ extern usb_status_t USB_HostSendSetup(usb_host_handle hostHandle,
  *
  * @retval kStatus_USB_Success              Receive successfully.
  * @retval kStatus_USB_InvalidHandle        The hostHandle, pipeHandle or transfer is a NULL pointer.
+ * @retval kStatus_USB_InvalidParameter     The ISO packet descriptors are invalid.
  * @retval kStatus_USB_LackSwapBuffer       There is no swap buffer for KHCI.
  * @retval kStatus_USB_Error                There is no idle QTD/ITD/SITD for EHCI.
  */
@@ -776,6 +929,37 @@ extern usb_status_t USB_HostUpdateHwTick(usb_host_handle hostHandle, uint64_t ti
 extern usb_status_t USB_HostSetChargerType(usb_host_handle hostHandle, uint8_t type);
 #endif
 
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+/*!
+ * @brief Get the transfer metrics of one pipe.
+ *
+ * The metrics are cleared when the pipe is opened.
+ *
+ * @param[in] hostHandle  The host handle.
+ * @param[in] pipeHandle  The pipe handle.
+ * @param[out] metrics    Return the metrics snapshot.
+ *
+ * @retval kStatus_USB_Success              Get the metrics successfully.
+ * @retval kStatus_USB_InvalidHandle        The hostHandle, pipeHandle or metrics is a NULL pointer.
+ */
+extern usb_status_t USB_HostGetPipeMetrics(usb_host_handle hostHandle,
+                                           usb_host_pipe_handle pipeHandle,
+                                           usb_host_metrics_t *metrics);
+
+/*!
+ * @brief Get the transfer metrics of one device, it is the sum of all the device's pipes.
+ *
+ * The metrics are cleared when the device is attached.
+ *
+ * @param[in] deviceHandle  The device handle.
+ * @param[out] metrics      Return the metrics snapshot.
+ *
+ * @retval kStatus_USB_Success              Get the metrics successfully.
+ * @retval kStatus_USB_InvalidHandle        The deviceHandle or metrics is a NULL pointer.
+ */
+extern usb_status_t USB_HostGetDeviceMetrics(usb_device_handle deviceHandle, usb_host_metrics_t *metrics);
+#endif
+
 /*! @}*/
 
 #ifdef __cplusplus
@@ -209,6 +209,9 @@ static void USB_HostEnumerationTransferCallback(void *param, usb_host_transfer_t
         {
             nextStep = 0U;
             deviceInstance->stallRetries--;
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+            USB_HostMetricsRecordEvent((usb_host_pipe_t *)deviceInstance->controlPipe, kUSB_HostMetricsRetry);
+#endif
         }
         else
         {
@@ -264,6 +267,9 @@ static void USB_HostEnumerationTransferCallback(void *param, usb_host_transfer_t
         if (deviceInstance->enumRetries > 0U) /* next whole retry */
         {
             deviceInstance->enumRetries--;
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+            USB_HostMetricsRecordEvent((usb_host_pipe_t *)deviceInstance->controlPipe, kUSB_HostMetricsRetry);
+#endif
             deviceInstance->stallRetries       = USB_HOST_CONFIG_ENUMERATION_MAX_STALL_RETRIES;
             deviceInstance->configurationValue = 0U;
             deviceInstance->state              = (uint8_t)kStatus_DEV_GetDes8;
@@ -875,6 +881,9 @@ static usb_status_t USB_HostParseDeviceConfigurationDescriptor(usb_device_handle
                     interfaceParse->interfaceExtensionLength = 0;
                     interfaceParse->interfaceExtension       = NULL;
                     interfaceParse->interfaceIndex           = unionDes->interface.bInterfaceNumber;
+#if ((defined(USB_HOST_CONFIG_DESCRIPTOR_CACHE)) && (USB_HOST_CONFIG_DESCRIPTOR_CACHE > 0U))
+                    interfaceParse->altSettingDesc[0] = &unionDes->interface;
+#endif
                     if (unionDes->common.bLength == 0x00U) /* the descriptor data is wrong */
                     {
                         return kStatus_USB_Error;
@@ -972,6 +981,14 @@ static usb_status_t USB_HostParseDeviceConfigurationDescriptor(usb_device_handle
                         return kStatus_USB_Error; /* in normal situation this cannot reach */
                     }
                     interfaceParse->alternateSettingNumber++;
+#if ((defined(USB_HOST_CONFIG_DESCRIPTOR_CACHE)) && (USB_HOST_CONFIG_DESCRIPTOR_CACHE > 0U))
+                    /* index the alternate setting interface descriptor */
+                    if ((unionDes->interface.bAlternateSetting < USB_HOST_CONFIG_INTERFACE_MAX_ALTSETTING) &&
+                        (interfaceParse->altSettingDesc[unionDes->interface.bAlternateSetting] == NULL))
+                    {
+                        interfaceParse->altSettingDesc[unionDes->interface.bAlternateSetting] = &unionDes->interface;
+                    }
+#endif
                     if (interfaceParse->interfaceExtension == NULL)
                     {
                         interfaceParse->interfaceExtension = (uint8_t *)unionDes;
@@ -1089,6 +1106,9 @@ usb_status_t USB_HostAttachDevice(usb_host_handle hostHandle,
     newInstance->enumRetries       = USB_HOST_CONFIG_ENUMERATION_MAX_RETRIES;
     newInstance->setAddress        = 0;
     newInstance->deviceAttachState = (uint8_t)kStatus_device_Attached;
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    USB_HostMetricsReset(&newInstance->metrics);
+#endif
 #if ((defined(USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE)) && (USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE > 0U))
     newInstance->deviceDescriptor =
         (usb_descriptor_device_t *)SDK_Malloc(sizeof(usb_descriptor_device_t) + 9, USB_CACHE_LINESIZE);
@@ -78,6 +78,9 @@ typedef struct _usb_host_device_instance
     uint8_t hsHubPort;   /*!< Device's first connected high-speed hub's port no (1 - 8) */
     uint8_t level;       /*!< Device's level (root device = 0) */
 #endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    usb_host_metrics_t metrics; /*!< The device's transfer metrics */
+#endif
 } usb_host_device_instance_t;
 
 typedef struct _usb_host_enum_process_entry
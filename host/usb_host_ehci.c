@@ -15,6 +15,11 @@
 #endif
 #include "fsl_device_registers.h"
 #include "usb_host_ehci.h"
+#if ((defined USB_HOST_CONFIG_HUB) && (USB_HOST_CONFIG_HUB) && (defined(USB_HOST_CONFIG_HUB_ENGINE)) && \
+     (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+#include "usb_host_hub.h"
+#include "usb_host_hub_app.h"
+#endif
 #if ((defined FSL_FEATURE_SOC_USBPHY_COUNT) && (FSL_FEATURE_SOC_USBPHY_COUNT))
 #include "usb_phy.h"
 #endif
@@ -290,6 +295,26 @@ static void USB_HostEhciRemoveFromFrame(usb_host_ehci_instance_t *ehciInstance,
                                         uint32_t entryPointerValue,
                                         uint16_t framePos);
 
+#if (((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD)) || \
+     ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD)))
+/*!
+ * @brief get the data of one iso packet.
+ *
+ * The packet is got from the transfer's packet descriptors, or the transfer buffer is split by the packet size.
+ *
+ * @param transfer      transfer information.
+ * @param packetIndex   packet index.
+ * @param packetSize    the data length of one service interval.
+ * @param packetOffset  return the packet data offset in the transfer buffer.
+ *
+ * @return the packet length.
+ */
+static uint32_t USB_HostEhciGetIsoPacket(usb_host_transfer_t *transfer,
+                                         uint32_t packetIndex,
+                                         uint32_t packetSize,
+                                         uint32_t *packetOffset);
+#endif
+
 #if ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD))
 /*!
  * @brief add sitd array to the frame list.
@@ -326,6 +351,16 @@ static uint32_t USB_HostEhciSitdArrayRelease(usb_host_ehci_instance_t *ehciInsta
                                              usb_host_ehci_sitd_t *startSitdPointer,
                                              usb_host_ehci_sitd_t *endSitdPointer);
 
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+/*!
+ * @brief record the packet results of the transfer's sitd list, it is called before releasing the sitd list.
+ *
+ * @param ehciInstance    ehci instance pointer.
+ * @param transfer        transfer information.
+ */
+static void USB_HostEhciSitdArrayPacketDone(usb_host_ehci_instance_t *ehciInstance, usb_host_transfer_t *transfer);
+#endif
+
 /*!
  * @brief de-initialize sitd list.
  * 1. remove transfer; 2. remove sitd from frame list and release sitd; 3. transfer callback
@@ -382,6 +417,31 @@ static uint32_t USB_HostEhciItdArrayRelease(usb_host_ehci_instance_t *ehciInstan
                                             usb_host_ehci_itd_t *startItdPointer,
                                             usb_host_ehci_itd_t *endItdPointer);
 
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+/*!
+ * @brief record the packet results of the transfer's itd list, it is called before releasing the itd list.
+ *
+ * @param transfer        transfer information.
+ */
+static void USB_HostEhciItdArrayPacketDone(usb_host_transfer_t *transfer);
+
+/*!
+ * @brief check the packet descriptors of the transfer against the itd buffer pages.
+ *
+ * One itd has seven 4K page buffer pointers that start from the page of its first packet, all the packets of the itd
+ * must end in these pages.
+ *
+ * @param ehciPipePointer ehci pipe pointer.
+ * @param transfer        transfer information.
+ * @param linkUframe      the micro-frame that the first itd is linked to.
+ *
+ * @return kStatus_USB_Success or kStatus_USB_InvalidParameter.
+ */
+static usb_status_t USB_HostEhciItdCheckPackets(usb_host_ehci_pipe_t *ehciPipePointer,
+                                                usb_host_transfer_t *transfer,
+                                                uint32_t linkUframe);
+#endif
+
 /*!
  * @brief de-initialize itd list.
  * 1. remove transfer; 2. remove itd from frame list and release itd; 3. transfer callback
@@ -522,6 +582,80 @@ static usb_status_t USB_HostEhciControlBus(usb_host_ehci_instance_t *ehciInstanc
  */
 void USB_HostEhciTransactionDone(usb_host_ehci_instance_t *ehciInstance);
 
+/*!
+ * @brief process the done transfers of one control/bulk/interrupt pipe.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ * @param ehciPipePointer   ehci pipe pointer.
+ */
+static void USB_HostEhciQhTransferDone(usb_host_ehci_instance_t *ehciInstance, usb_host_ehci_pipe_t *ehciPipePointer);
+
+#if (((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD)) || \
+     ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD)))
+/*!
+ * @brief process the done transfers of one iso pipe.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ * @param ehciPipePointer   ehci pipe pointer.
+ */
+static void USB_HostEhciIsoTransferDone(usb_host_ehci_instance_t *ehciInstance, usb_host_ehci_pipe_t *ehciPipePointer);
+#endif
+
+/*!
+ * @brief process the done transfers of one pipe in the task.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ * @param ehciPipePointer   ehci pipe pointer.
+ */
+static void USB_HostEhciPipeTransferDone(usb_host_ehci_instance_t *ehciInstance, usb_host_ehci_pipe_t *ehciPipePointer);
+
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+/*!
+ * @brief check whether the pipe's first transfer is done, it is called in the ISR.
+ *
+ * @param ehciPipePointer   ehci pipe pointer.
+ * @param status            return the qTD token (or the iTD/siTD status) of the done transfer.
+ *
+ * @return 1 if the first transfer is done, otherwise 0.
+ */
+static uint8_t USB_HostEhciPipeIsDone(usb_host_ehci_pipe_t *ehciPipePointer, uint32_t *status);
+
+/*!
+ * @brief process the pipes of the done records that the ISR pushes.
+ * all the pipes are checked when the ring overflows.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ */
+static void USB_HostEhciEventRingDone(usb_host_ehci_instance_t *ehciInstance);
+#endif
+
+#if (USB_HOST_EHCI_ISR_PIPE_LIST > 0U)
+/*!
+ * @brief check the pipes of the ISR pipe list, it is called in the ISR.
+ * the ISR completion pipes are completed, a done record is pushed for the other pipes.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ */
+static void USB_HostEhciIsrTransactionDone(usb_host_ehci_instance_t *ehciInstance);
+
+/*!
+ * @brief add the pipe to the ISR pipe list.
+ * the transfers of the ISR completion pipe that are done when the pipe isn't in the list are completed here.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ * @param ehciPipePointer   ehci pipe pointer.
+ */
+static void USB_HostEhciIsrPipeAttach(usb_host_ehci_instance_t *ehciInstance, usb_host_ehci_pipe_t *ehciPipePointer);
+
+/*!
+ * @brief remove the pipe from the ISR pipe list.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ * @param ehciPipePointer   ehci pipe pointer.
+ */
+static void USB_HostEhciIsrPipeDetach(usb_host_ehci_instance_t *ehciInstance, usb_host_ehci_pipe_t *ehciPipePointer);
+#endif
+
 /*!
  * @brief ehci port change interrupt process function.
  *
@@ -537,6 +671,62 @@ static void USB_HostEhciPortChange(usb_host_ehci_instance_t *ehciInstance);
  */
 static void USB_HostEhciTimer0(usb_host_ehci_instance_t *ehciInstance);
 
+/*!
+ * @brief release the control/bulk transfer that time out and callback.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ * @param vltQhPointer      the transfer's qh pointer.
+ * @param vltQtdPointer     the qtd from which to search the transfer's last qtd.
+ * @param transfer          the transfer that time out, it must be the qh's first transfer.
+ */
+static void USB_HostEhciTimeoutRelease(usb_host_ehci_instance_t *ehciInstance,
+                                       volatile usb_host_ehci_qh_t *vltQhPointer,
+                                       usb_host_ehci_qtd_t *vltQtdPointer,
+                                       usb_host_transfer_t *transfer);
+
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+/*!
+ * @brief arm the control/bulk transfer in the timeout wheel, start timer0 if the wheel is idle.
+ * It is called with the ehci lock held.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ * @param ehciPipePointer   ehci pipe pointer.
+ * @param transfer          transfer pointer.
+ */
+static void USB_HostEhciTimeoutWheelArm(usb_host_ehci_instance_t *ehciInstance,
+                                        usb_host_ehci_pipe_t *ehciPipePointer,
+                                        usb_host_transfer_t *transfer);
+
+/*!
+ * @brief arm the transfer with its timeout when it becomes the qh's first transfer.
+ * It is called with the ehci lock held.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ * @param ehciPipePointer   ehci pipe pointer.
+ * @param transfer          transfer pointer.
+ */
+static void USB_HostEhciTimeoutWheelStart(usb_host_ehci_instance_t *ehciInstance,
+                                          usb_host_ehci_pipe_t *ehciPipePointer,
+                                          usb_host_transfer_t *transfer);
+
+/*!
+ * @brief remove the done transfer from the timeout wheel.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ * @param transfer          transfer pointer.
+ */
+static void USB_HostEhciTimeoutWheelDisarm(usb_host_ehci_instance_t *ehciInstance, usb_host_transfer_t *transfer);
+
+/*!
+ * @brief process one transfer that expires in the timeout wheel.
+ * the transfer is armed again if it is not started, or it still makes progress without its own timeout.
+ *
+ * @param ehciInstance      ehci instance pointer.
+ * @param transfer          transfer pointer.
+ */
+static void USB_HostEhciTransferTimeout(usb_host_ehci_instance_t *ehciInstance, usb_host_transfer_t *transfer);
+#endif
+
 #if ((defined(USB_HOST_CONFIG_LOW_POWER_MODE)) && (USB_HOST_CONFIG_LOW_POWER_MODE > 0U))
 /*!
  * @brief ehci timer1 interrupt process function.
@@ -733,13 +923,16 @@ static usb_status_t USB_HostEhciSingleStepQtdListInit(usb_host_ehci_instance_t *
     uint32_t dataLength;
     uint32_t dataAddress;
     uint8_t index;
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    OSA_SR_ALLOC();
+#endif
 
     /* compute the qtd number */
     qtdNumber = 1;
 
     vltQhPointer = (volatile usb_host_ehci_qh_t *)ehciPipePointer->ehciQh;
     /* get qtd list */
-    USB_HostEhciLock();
+    USB_HostEhciQtdLock();
     if (qtdNumber <= ehciInstance->ehciQtdNumber)
     {
         ehciInstance->ehciQtdNumber -= qtdNumber;
@@ -757,10 +950,10 @@ static usb_status_t USB_HostEhciSingleStepQtdListInit(usb_host_ehci_instance_t *
     }
     else
     {
-        USB_HostEhciUnlock();
+        USB_HostEhciQtdUnlock();
         return kStatus_USB_Error;
     }
-    USB_HostEhciUnlock();
+    USB_HostEhciQtdUnlock();
 
     /* int qTD */
     if (setupPhase == 1) /* setup transaction qtd init */
@@ -1940,6 +2133,9 @@ static usb_status_t USB_HostEhciQhQtdListInit(usb_host_ehci_instance_t *ehciInst
     uint32_t dataAddress;
     uint32_t endAddress;
     uint8_t index;
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    OSA_SR_ALLOC();
+#endif
 
     /* compute the qtd number */
     if (ehciPipePointer->pipeCommon.pipeType == USB_ENDPOINT_CONTROL)
@@ -1966,7 +2162,7 @@ static usb_status_t USB_HostEhciQhQtdListInit(usb_host_ehci_instance_t *ehciInst
 
     vltQhPointer = (volatile usb_host_ehci_qh_t *)ehciPipePointer->ehciQh;
     /* get qtd list */
-    USB_HostEhciLock();
+    USB_HostEhciQtdLock();
     if (qtdNumber <= ehciInstance->ehciQtdNumber)
     {
         ehciInstance->ehciQtdNumber -= (uint8_t)qtdNumber;
@@ -1998,10 +2194,10 @@ static usb_status_t USB_HostEhciQhQtdListInit(usb_host_ehci_instance_t *ehciInst
     }
     else
     {
-        USB_HostEhciUnlock();
+        USB_HostEhciQtdUnlock();
         return kStatus_USB_Error;
     }
-    USB_HostEhciUnlock();
+    USB_HostEhciQtdUnlock();
 
     /* int qTD list */
     if (ehciPipePointer->pipeCommon.pipeType == USB_ENDPOINT_CONTROL)
@@ -2166,6 +2362,10 @@ static usb_status_t USB_HostEhciQhQtdListInit(usb_host_ehci_instance_t *ehciInst
     /* save qtd to transfer */
     transfer->union1.unitHead = (uint32_t)BaseQtdPointer;
     transfer->union2.unitTail = (uint32_t)qtdPointer;
+    USB_HostEhciLock();
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    OSA_ENTER_CRITICAL(); /* the ISR completion accesses the transfer list and the qtd list too */
+#endif
     /* link transfer to qh */
     transfer->next = NULL;
     if (vltQhPointer->ehciTransferHead == NULL)
@@ -2181,7 +2381,6 @@ static usb_status_t USB_HostEhciQhQtdListInit(usb_host_ehci_instance_t *ehciInst
         vltQhPointer->ehciTransferTail       = transfer;
     }
 
-    USB_HostEhciLock();
     /* link qtd to qh (link to end) */
     entryPointer = &(vltQhPointer->nextQtdPointer);
     dataAddress  = *entryPointer; /* dataAddress variable means entry value here */
@@ -2194,6 +2393,15 @@ static usb_status_t USB_HostEhciQhQtdListInit(usb_host_ehci_instance_t *ehciInst
     *entryPointer = (uint32_t)USB_HOST_MEMORY_CPU_2_DMA(BaseQtdPointer);
 #else
     *entryPointer = (uint32_t)BaseQtdPointer;
+#endif
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    OSA_EXIT_CRITICAL();
+#endif
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+    if (ehciPipePointer->pipeCommon.pipeType != USB_ENDPOINT_INTERRUPT)
+    {
+        USB_HostEhciTimeoutWheelArm(ehciInstance, ehciPipePointer, transfer);
+    }
 #endif
     USB_HostEhciStartAsync(ehciInstance);
     USB_HostEhciUnlock();
@@ -2207,6 +2415,9 @@ static uint32_t USB_HostEhciQtdListRelease(usb_host_ehci_instance_t *ehciInstanc
 {
     uint32_t length = 0;
     usb_host_ehci_qtd_t *qtdPointer;
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    OSA_SR_ALLOC();
+#endif
 
     ehciQtdEnd->nextQtdPointer = 0U;
 
@@ -2226,7 +2437,7 @@ static uint32_t USB_HostEhciQtdListRelease(usb_host_ehci_instance_t *ehciInstanc
     length += ((qtdPointer->transferResults[0] & EHCI_HOST_QTD_TOTAL_BYTES_MASK) >> EHCI_HOST_QTD_TOTAL_BYTES_SHIFT);
 
     /* put releasing qtd to idle qtd list */
-    USB_HostEhciLock();
+    USB_HostEhciQtdLock();
     if (ehciInstance->ehciQtdNumber == 0U)
     {
         ehciInstance->ehciQtdHead = ehciQtdStart;
@@ -2248,7 +2459,7 @@ static uint32_t USB_HostEhciQtdListRelease(usb_host_ehci_instance_t *ehciInstanc
 #endif
     }
     ehciInstance->ehciQtdNumber++;
-    USB_HostEhciUnlock();
+    USB_HostEhciQtdUnlock();
 
     return length;
 }
@@ -2313,6 +2524,12 @@ static usb_status_t USB_HostEhciQhQtdListDeinit(usb_host_ehci_instance_t *ehciIn
     transfer                       = vltQhPointer->ehciTransferHead;
     vltQhPointer->ehciTransferTail = NULL;
     vltQhPointer->ehciTransferHead = NULL;
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+    for (nextTransfer = transfer; nextTransfer != NULL; nextTransfer = nextTransfer->next)
+    {
+        USB_HostTimeoutWheelRemove(&ehciInstance->timeoutWheel, nextTransfer);
+    }
+#endif
     USB_HostEhciUnlock();
 
     /* release qtd  and transfer callback*/
@@ -2325,6 +2542,9 @@ static usb_status_t USB_HostEhciQhQtdListDeinit(usb_host_ehci_instance_t *ehciIn
         transfer->transferSofar = (transfer->transferLength < transfer->transferSofar) ?
                                       0U :
                                       (transfer->transferLength - transfer->transferSofar);
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+        USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer, kStatus_USB_TransferCancel);
+#endif
         /* callback function is different from the current condition */
         transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferCancel);
         transfer = nextTransfer;
@@ -2420,6 +2640,9 @@ static usb_status_t USB_HostEhciTransferQtdListDeinit(usb_host_ehci_instance_t *
             }
         }
     }
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+    USB_HostTimeoutWheelRemove(&ehciInstance->timeoutWheel, transfer);
+#endif
     USB_HostEhciUnlock();
 
     /* release qtd and callback */
@@ -2429,6 +2652,9 @@ static usb_status_t USB_HostEhciTransferQtdListDeinit(usb_host_ehci_instance_t *
     transfer->transferSofar = (transfer->transferLength < transfer->transferSofar) ?
                                   0U :
                                   (transfer->transferLength - transfer->transferSofar);
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer, kStatus_USB_TransferCancel);
+#endif
     /* callback function is different from the current condition */
     transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferCancel);
 
@@ -2479,7 +2705,7 @@ static usb_status_t USB_HostEhciQhInit(usb_host_ehci_instance_t *ehciInstance, u
     qhPointer->alternateNextQtdPointer = EHCI_HOST_T_INVALID_VALUE;
     qhPointer->ehciPipePointer         = ehciPipePointer;
     qhPointer->timeOutLabel            = 0;
-    qhPointer->timeOutValue            = USB_HOST_EHCI_CONTROL_BULK_TIME_OUT_VALUE;
+    qhPointer->timeOutValue            = 0U;
     (void)USB_HostHelperGetPeripheralInformation(ehciPipePointer->pipeCommon.deviceHandle,
                                                  (uint32_t)kUSB_HostGetDeviceSpeed, &speed);
     /* initialize staticEndpointStates[0] */
@@ -2667,6 +2893,32 @@ static void USB_HostEhciRemoveFromFrame(usb_host_ehci_instance_t *ehciInstance,
     }
 }
 
+#if (((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD)) || \
+     ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD)))
+static uint32_t USB_HostEhciGetIsoPacket(usb_host_transfer_t *transfer,
+                                         uint32_t packetIndex,
+                                         uint32_t packetSize,
+                                         uint32_t *packetOffset)
+{
+    uint32_t packetLength;
+
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    if (NULL != transfer->isoPacketDescriptor)
+    {
+        *packetOffset = transfer->isoPacketDescriptor[packetIndex].offset;
+        return transfer->isoPacketDescriptor[packetIndex].length;
+    }
+#endif
+    *packetOffset = packetIndex * packetSize;
+    packetLength  = transfer->transferLength - *packetOffset;
+    if (packetLength > packetSize)
+    {
+        packetLength = packetSize;
+    }
+    return packetLength;
+}
+#endif
+
 #if ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD))
 static void USB_HostEhciLinkSitd(usb_host_ehci_instance_t *ehciInstance,
                                  usb_host_ehci_pipe_t *ehciPipePointer,
@@ -2794,7 +3046,8 @@ static usb_status_t USB_HostEhciSitdArrayInit(usb_host_ehci_instance_t *ehciInst
     usb_host_ehci_iso_t *isoPointer;
     uint32_t sitdNumber = 0;
     usb_host_ehci_sitd_t *sitdPointer;
-    uint32_t dataLength = 0;
+    uint32_t packetIndex = 0U;
+    uint32_t packetOffset;
     uint32_t sitdLength = 0;
     uint32_t dataBufferValue;
     uint32_t hubNumber  = 0U;
@@ -2809,6 +3062,12 @@ static usb_status_t USB_HostEhciSitdArrayInit(usb_host_ehci_instance_t *ehciInst
 
     sitdNumber = ((transfer->transferLength - 1U + (ehciPipePointer->pipeCommon.maxPacketSize)) /
                   (ehciPipePointer->pipeCommon.maxPacketSize));
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    if (NULL != transfer->isoPacketDescriptor)
+    {
+        sitdNumber = transfer->isoPacketCount; /* one sitd for one packet */
+    }
+#endif
     /* get sitd array */
     /* USB_HostEhciLock(); */
     if (ehciInstance->ehciSitdNumber >= sitdNumber)
@@ -2840,21 +3099,17 @@ static usb_status_t USB_HostEhciSitdArrayInit(usb_host_ehci_instance_t *ehciInst
     (void)USB_HostHelperGetPeripheralInformation(ehciPipePointer->pipeCommon.deviceHandle,
                                                  (uint32_t)kUSB_HostGetDevicePortNumber, &portNumber);
     sitdPointer = (usb_host_ehci_sitd_t *)transfer->union1.unitHead;
-    dataLength  = transfer->transferLength;
     while (0U != sitdNumber)
     {
         sitdNumber--;
         USB_HostEhciZeroMem((void *)sitdPointer, 7);
-        sitdLength = dataLength;
-        if (sitdLength > ehciPipePointer->pipeCommon.maxPacketSize)
-        {
-            sitdLength = ehciPipePointer->pipeCommon.maxPacketSize;
-        }
-        dataBufferValue = (uint32_t)(transfer->transferBuffer + (transfer->transferLength - dataLength));
+        sitdLength =
+            USB_HostEhciGetIsoPacket(transfer, packetIndex, ehciPipePointer->pipeCommon.maxPacketSize, &packetOffset);
+        packetIndex++;
+        dataBufferValue = (uint32_t)(transfer->transferBuffer + packetOffset);
 #if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
         dataBufferValue = (uint32_t)USB_HOST_MEMORY_CPU_2_DMA(dataBufferValue);
 #endif
-        dataLength -= sitdLength; /* update left data length */
         sitdPointer->transferResults[1] = dataBufferValue;
         sitdPointer->transferResults[2] = ((dataBufferValue + 4U * 1024U) & 0xFFFFF000U);
         sitdPointer->endpointStates[0] =
@@ -2948,6 +3203,49 @@ static uint32_t USB_HostEhciSitdArrayRelease(usb_host_ehci_instance_t *ehciInsta
     return leftLength;
 }
 
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+static void USB_HostEhciSitdArrayPacketDone(usb_host_ehci_instance_t *ehciInstance, usb_host_transfer_t *transfer)
+{
+    usb_host_ehci_sitd_t *sitdPointer = (usb_host_ehci_sitd_t *)transfer->union1.unitHead;
+    uint32_t sitdStatus;
+    uint32_t leftLength;
+    uint32_t packetIndex = 0U;
+    usb_status_t packetStatus;
+
+    while (packetIndex < transfer->isoPacketCount)
+    {
+        sitdStatus = sitdPointer->transferResults[0];
+        leftLength = ((sitdStatus & EHCI_HOST_SITD_TOTAL_BYTES_MASK) >> EHCI_HOST_SITD_TOTAL_BYTES_SHIFT);
+        if (0U != (sitdStatus & EHCI_HOST_SITD_STATUS_ACTIVE_MASK))
+        {
+            packetStatus = kStatus_USB_TransferCancel; /* the packet is not transferred */
+            leftLength   = transfer->isoPacketDescriptor[packetIndex].length;
+        }
+        else if (0U != (sitdStatus & EHCI_HOST_SITD_STATUS_BABBLE_MASK))
+        {
+            packetStatus = kStatus_USB_DataOverRun;
+        }
+        else if (0U != (sitdStatus & EHCI_HOST_SITD_STATUS_ERROR_MASK))
+        {
+            packetStatus = kStatus_USB_TransferFailed;
+        }
+        else
+        {
+            packetStatus = kStatus_USB_Success;
+        }
+        /* the total bytes field counts down for both directions */
+        USB_HostIsoPacketDone(transfer, packetIndex, transfer->isoPacketDescriptor[packetIndex].length - leftLength,
+                              packetStatus);
+        packetIndex++;
+        if (sitdPointer == (usb_host_ehci_sitd_t *)transfer->union2.unitTail)
+        {
+            break;
+        }
+        sitdPointer = &(ehciInstance->ehciSitdIndexBase[sitdPointer->nextSitdIndex]);
+    }
+}
+#endif
+
 static usb_status_t USB_HostEhciSitdArrayDeinit(usb_host_ehci_instance_t *ehciInstance,
                                                 usb_host_ehci_pipe_t *ehciPipePointer)
 {
@@ -2965,11 +3263,25 @@ static usb_status_t USB_HostEhciSitdArrayDeinit(usb_host_ehci_instance_t *ehciIn
     while (transfer != NULL)
     {
         nextTransfer = transfer->next;
-        /* remove sitd from frame list and release itd */
-        transfer->transferSofar =
-            transfer->transferLength - USB_HostEhciSitdArrayRelease(ehciInstance,
-                                                                    (usb_host_ehci_sitd_t *)transfer->union1.unitHead,
-                                                                    (usb_host_ehci_sitd_t *)transfer->union2.unitTail);
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+        if (NULL != transfer->isoPacketDescriptor)
+        {
+            USB_HostEhciSitdArrayPacketDone(ehciInstance, transfer);
+            (void)USB_HostEhciSitdArrayRelease(ehciInstance, (usb_host_ehci_sitd_t *)transfer->union1.unitHead,
+                                               (usb_host_ehci_sitd_t *)transfer->union2.unitTail);
+        }
+        else
+#endif
+        {
+            /* remove sitd from frame list and release itd */
+            transfer->transferSofar = transfer->transferLength -
+                                      USB_HostEhciSitdArrayRelease(ehciInstance,
+                                                                   (usb_host_ehci_sitd_t *)transfer->union1.unitHead,
+                                                                   (usb_host_ehci_sitd_t *)transfer->union2.unitTail);
+        }
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+        USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer, kStatus_USB_TransferCancel);
+#endif
         /* callback function is different from the current condition */
         transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferCancel);
         /* next transfer */
@@ -3051,6 +3363,46 @@ static uint32_t USB_HostEhciGetItdLinkFrame(usb_host_ehci_instance_t *ehciInstan
     return currentUframe;
 }
 
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+static usb_status_t USB_HostEhciItdCheckPackets(usb_host_ehci_pipe_t *ehciPipePointer,
+                                                usb_host_transfer_t *transfer,
+                                                uint32_t linkUframe)
+{
+    usb_host_iso_packet_descriptor_t *packet;
+    uint32_t packetPerItd = 0U;
+    uint32_t pageBase     = 0U;
+    uint32_t packetStart;
+    uint32_t packetEnd;
+
+    if (NULL == transfer->isoPacketDescriptor)
+    {
+        return kStatus_USB_Success;
+    }
+    /* the same as the transaction loop of USB_HostEhciItdArrayInit */
+    for (uint32_t index = (linkUframe & 0x0007U); index < 8U; index += ehciPipePointer->uframeInterval)
+    {
+        packetPerItd++;
+    }
+    for (uint32_t packetIndex = 0U; packetIndex < transfer->isoPacketCount; packetIndex++)
+    {
+        packet      = &transfer->isoPacketDescriptor[packetIndex];
+        packetStart = (uint32_t)(transfer->transferBuffer + packet->offset);
+        packetEnd   = packetStart + ((0U != packet->length) ? (packet->length - 1U) : 0U);
+        if (0U == (packetIndex % packetPerItd))
+        {
+            /* the first packet of one itd */
+            pageBase = packetStart & 0xFFFFF000U;
+        }
+        /* the offsets are ascending (checked by the host layer), so only the end page needs to be checked */
+        if ((((packetEnd & 0xFFFFF000U) - pageBase) >> EHCI_HOST_ITD_BUFFER_POINTER_SHIFT) > 6U)
+        {
+            return kStatus_USB_InvalidParameter;
+        }
+    }
+    return kStatus_USB_Success;
+}
+#endif
+
 static usb_status_t USB_HostEhciItdArrayInit(usb_host_ehci_instance_t *ehciInstance,
                                              usb_host_ehci_pipe_t *ehciPipePointer,
                                              usb_host_transfer_t *transfer)
@@ -3059,7 +3411,9 @@ static usb_status_t USB_HostEhciItdArrayInit(usb_host_ehci_instance_t *ehciInsta
     usb_host_ehci_itd_t *itdPointer = NULL;
     usb_host_ehci_itd_t *itdHead    = NULL;
     usb_host_ehci_itd_t *tmpItdPointer;
-    uint32_t dataLength;        /* the remaining data for sending */
+    uint32_t packetNumber;      /* one packet is the data of one service interval */
+    uint32_t packetIndex = 0U;  /* the initializing packet */
+    uint32_t packetOffset;      /* the packet data offset in the transfer buffer */
     uint32_t transactionLength; /* the initializing transaction descriptor data length */
     uint32_t itdBufferValue;
     uint32_t itdBufferBaseValue; /* for calculating PG value */
@@ -3079,8 +3433,15 @@ static usb_status_t USB_HostEhciItdArrayInit(usb_host_ehci_instance_t *ehciInsta
     (void)USB_HostHelperGetPeripheralInformation(ehciPipePointer->pipeCommon.deviceHandle,
                                                  (uint32_t)kUSB_HostGetDeviceAddress, &address);
 
+    packetNumber = (transfer->transferLength - 1U + minDataPerItd) / minDataPerItd;
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    if (NULL != transfer->isoPacketDescriptor)
+    {
+        packetNumber = transfer->isoPacketCount;
+    }
+#endif
     /* max needed itd number, the actual needed number may be less because micro-frame interval may be less than 8 */
-    maxItdNumber = (uint8_t)((transfer->transferLength - 1U + minDataPerItd) / minDataPerItd);
+    maxItdNumber = (uint8_t)packetNumber;
     if (ehciPipePointer->uframeInterval < 8U)
     {
         maxItdNumber = (uint8_t)((maxItdNumber * ehciPipePointer->uframeInterval + 7U) / 8U) + 1U;
@@ -3090,6 +3451,25 @@ static usb_status_t USB_HostEhciItdArrayInit(usb_host_ehci_instance_t *ehciInsta
         return kStatus_USB_Error;
     }
 
+    /* get the link micro-frame */
+    lastShouldLinkUframe = USB_HostEhciGetItdLinkFrame(
+        ehciInstance, isoPointer->lastLinkFrame,
+        (uint16_t)((ehciPipePointer->startFrame << 3) + ehciPipePointer->startUframe), ehciPipePointer->uframeInterval);
+    if (lastShouldLinkUframe > USB_HOST_EHCI_MAX_MICRFRAME_VALUE)
+    {
+        linkUframe = lastShouldLinkUframe - (USB_HOST_EHCI_MAX_MICRFRAME_VALUE + 1U);
+    }
+    else
+    {
+        linkUframe = lastShouldLinkUframe;
+    }
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    if (kStatus_USB_Success != USB_HostEhciItdCheckPackets(ehciPipePointer, transfer, linkUframe))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+#endif
+
     /* link transfer to usb_host_ehci_iso_t transfer list */
     transfer->next = NULL;
     /* USB_HostEhciLock(); */
@@ -3105,22 +3485,9 @@ static usb_status_t USB_HostEhciItdArrayInit(usb_host_ehci_instance_t *ehciInsta
     }
     /* USB_HostEhciUnlock(); */
 
-    dataLength                = transfer->transferLength;
     transfer->union1.unitHead = 0U;
-    /* get the link micro-frame */
-    lastShouldLinkUframe = USB_HostEhciGetItdLinkFrame(
-        ehciInstance, isoPointer->lastLinkFrame,
-        (uint16_t)((ehciPipePointer->startFrame << 3) + ehciPipePointer->startUframe), ehciPipePointer->uframeInterval);
-    if (lastShouldLinkUframe > USB_HOST_EHCI_MAX_MICRFRAME_VALUE)
-    {
-        linkUframe = lastShouldLinkUframe - (USB_HOST_EHCI_MAX_MICRFRAME_VALUE + 1U);
-    }
-    else
-    {
-        linkUframe = lastShouldLinkUframe;
-    }
     itdHead = ehciInstance->ehciItdList;
-    while (0U != dataLength)
+    while (packetIndex < packetNumber)
     {
         /* get one idle itd */
         tmpItdPointer = ehciInstance->ehciItdList;
@@ -3145,11 +3512,11 @@ static usb_status_t USB_HostEhciItdArrayInit(usb_host_ehci_instance_t *ehciInsta
         itdPointer = tmpItdPointer;
 
         /* itd has been set to all zero when releasing */
-        itdBufferValue     = (uint32_t)(transfer->transferBuffer + (transfer->transferLength - dataLength));
+        (void)USB_HostEhciGetIsoPacket(transfer, packetIndex, minDataPerItd, &packetOffset);
+        itdBufferValue     = (uint32_t)(transfer->transferBuffer + packetOffset);
         itdBufferBaseValue = itdBufferValue;
 #if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
-        convert_addr  = (uint32_t)USB_HOST_MEMORY_CPU_2_DMA(itdBufferBaseValue);
-        convert_addr1 = convert_addr;
+        convert_addr = (uint32_t)USB_HOST_MEMORY_CPU_2_DMA(itdBufferBaseValue);
 #endif
         for (index = 0; index < 7U; ++index)
         {
@@ -3170,16 +3537,16 @@ static usb_status_t USB_HostEhciItdArrayInit(usb_host_ehci_instance_t *ehciInsta
         /* initialize transaction descriptors */
         for (index = (uint8_t)(linkUframe & 0x0007U); index < 8U; index += ehciPipePointer->uframeInterval)
         {
-            transactionLength = ((dataLength > minDataPerItd) ? minDataPerItd : dataLength);
+            transactionLength = USB_HostEhciGetIsoPacket(transfer, packetIndex, minDataPerItd, &packetOffset);
+            itdBufferValue    = (uint32_t)(transfer->transferBuffer + packetOffset);
 #if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
+            convert_addr1 = (uint32_t)USB_HOST_MEMORY_CPU_2_DMA(itdBufferValue);
             /* initialize the uframeIndex's transaction descriptor in itd */
             itdPointer->transactions[index] =
                 ((EHCI_HOST_ITD_STATUS_ACTIVE_MASK) | (transactionLength << EHCI_HOST_ITD_TRANSACTION_LEN_SHIFT) |
                  ((((convert_addr1 & 0xFFFFF000U) - (convert_addr & 0xFFFFF000U)) >> EHCI_HOST_ITD_BUFFER_POINTER_SHIFT)
                   << EHCI_HOST_ITD_PG_SHIFT) |
                  (convert_addr1 & EHCI_HOST_ITD_TRANSACTION_OFFSET_MASK));
-            dataLength -= transactionLength;
-            convert_addr1 += transactionLength;
 #else
             /* initialize the uframeIndex's transaction descriptor in itd */
             itdPointer->transactions[index] =
@@ -3188,10 +3555,10 @@ static usb_status_t USB_HostEhciItdArrayInit(usb_host_ehci_instance_t *ehciInsta
                    EHCI_HOST_ITD_BUFFER_POINTER_SHIFT)
                   << EHCI_HOST_ITD_PG_SHIFT) |
                  (itdBufferValue & EHCI_HOST_ITD_TRANSACTION_OFFSET_MASK));
-            dataLength -= transactionLength;
-            itdBufferValue += transactionLength;
 #endif
-            if (dataLength <= 0U)
+            itdPointer->transactionMask |= (1UL << index);
+            packetIndex++;
+            if (packetIndex >= packetNumber)
             {
                 break;
             }
@@ -3292,43 +3659,114 @@ static uint32_t USB_HostEhciItdArrayRelease(usb_host_ehci_instance_t *ehciInstan
     return doneLength;
 }
 
-static usb_status_t USB_HostEhciItdArrayDeinit(usb_host_ehci_instance_t *ehciInstance,
-                                               usb_host_ehci_pipe_t *ehciPipePointer)
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+static void USB_HostEhciItdArrayPacketDone(usb_host_transfer_t *transfer)
 {
-    usb_host_ehci_iso_t *isoPointer = (usb_host_ehci_iso_t *)ehciPipePointer->ehciQh;
-    usb_host_transfer_t *transfer;
-    usb_host_transfer_t *nextTransfer;
-    uint32_t doneLength = 0;
-
-    /* firstly remove the transfer (because host task may occupy to access the resource) */
-    USB_HostEhciLock();
-    transfer                     = isoPointer->ehciTransferHead;
-    isoPointer->ehciTransferTail = NULL;
-    isoPointer->ehciTransferHead = NULL;
-    USB_HostEhciUnlock();
+    usb_host_ehci_itd_t *itdPointer = (usb_host_ehci_itd_t *)transfer->union1.unitHead;
+    uint32_t transaction;
+    uint32_t actualLength;
+    uint32_t packetIndex = 0U;
+    usb_status_t packetStatus;
 
-    while (transfer != NULL)
+    while (NULL != itdPointer)
     {
-        nextTransfer = transfer->next;
-        doneLength   = 0;
-        /* remove itd from frame list and release itd */
-        doneLength = USB_HostEhciItdArrayRelease(ehciInstance, (usb_host_ehci_itd_t *)transfer->union1.unitHead,
-                                                 (usb_host_ehci_itd_t *)transfer->union2.unitTail);
-
-        /* transfer callback */
-        if (ehciPipePointer->pipeCommon.direction == USB_OUT)
+        for (uint8_t index = 0U; (index < 8U) && (packetIndex < transfer->isoPacketCount); ++index)
         {
-            doneLength = transfer->transferLength;
-        }
-        transfer->transferSofar = doneLength;
-        /* callback function is different from the current condition */
-        transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferCancel);
-
-        /* next transfer */
-        transfer = nextTransfer;
-    }
-
-    return kStatus_USB_Success;
+            if (0U == (itdPointer->transactionMask & (1UL << index)))
+            {
+                continue;
+            }
+            transaction = itdPointer->transactions[index];
+            /* the IN transaction length is updated to the received length, the OUT one is not updated */
+            if (transfer->direction == USB_IN)
+            {
+                actualLength =
+                    ((transaction & EHCI_HOST_ITD_TRANSACTION_LEN_MASK) >> EHCI_HOST_ITD_TRANSACTION_LEN_SHIFT);
+            }
+            else
+            {
+                actualLength = transfer->isoPacketDescriptor[packetIndex].length;
+            }
+            if (0U != (transaction & EHCI_HOST_ITD_STATUS_ACTIVE_MASK))
+            {
+                packetStatus = kStatus_USB_TransferCancel; /* the packet is not transferred */
+                actualLength = 0U;
+            }
+            else if (0U != (transaction & EHCI_HOST_ITD_STATUS_BABBLE_MASK))
+            {
+                packetStatus = kStatus_USB_DataOverRun;
+            }
+            else if (0U != (transaction & EHCI_HOST_ITD_STATUS_ERROR_MASK))
+            {
+                packetStatus = kStatus_USB_TransferFailed;
+            }
+            else
+            {
+                packetStatus = kStatus_USB_Success;
+            }
+            USB_HostIsoPacketDone(transfer, packetIndex, actualLength, packetStatus);
+            packetIndex++;
+        }
+        if (itdPointer == (usb_host_ehci_itd_t *)transfer->union2.unitTail)
+        {
+            break;
+        }
+        itdPointer = itdPointer->nextItdPointer;
+    }
+}
+#endif
+
+static usb_status_t USB_HostEhciItdArrayDeinit(usb_host_ehci_instance_t *ehciInstance,
+                                               usb_host_ehci_pipe_t *ehciPipePointer)
+{
+    usb_host_ehci_iso_t *isoPointer = (usb_host_ehci_iso_t *)ehciPipePointer->ehciQh;
+    usb_host_transfer_t *transfer;
+    usb_host_transfer_t *nextTransfer;
+    uint32_t doneLength = 0;
+
+    /* firstly remove the transfer (because host task may occupy to access the resource) */
+    USB_HostEhciLock();
+    transfer                     = isoPointer->ehciTransferHead;
+    isoPointer->ehciTransferTail = NULL;
+    isoPointer->ehciTransferHead = NULL;
+    USB_HostEhciUnlock();
+
+    while (transfer != NULL)
+    {
+        nextTransfer = transfer->next;
+        doneLength   = 0;
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+        if (NULL != transfer->isoPacketDescriptor)
+        {
+            USB_HostEhciItdArrayPacketDone(transfer);
+            (void)USB_HostEhciItdArrayRelease(ehciInstance, (usb_host_ehci_itd_t *)transfer->union1.unitHead,
+                                              (usb_host_ehci_itd_t *)transfer->union2.unitTail);
+        }
+        else
+#endif
+        {
+            /* remove itd from frame list and release itd */
+            doneLength = USB_HostEhciItdArrayRelease(ehciInstance, (usb_host_ehci_itd_t *)transfer->union1.unitHead,
+                                                     (usb_host_ehci_itd_t *)transfer->union2.unitTail);
+
+            /* transfer callback */
+            if (ehciPipePointer->pipeCommon.direction == USB_OUT)
+            {
+                doneLength = transfer->transferLength;
+            }
+            transfer->transferSofar = doneLength;
+        }
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+        USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer, kStatus_USB_TransferCancel);
+#endif
+        /* callback function is different from the current condition */
+        transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferCancel);
+
+        /* next transfer */
+        transfer = nextTransfer;
+    }
+
+    return kStatus_USB_Success;
 }
 #endif /* USB_HOST_CONFIG_EHCI_MAX_ITD */
 
@@ -3628,7 +4066,11 @@ static usb_status_t USB_HostEhciStartIP(usb_host_ehci_instance_t *ehciInstance)
     /* start the controller */
     ehciInstance->ehciIpBase->USBCMD |= USBHS_USBCMD_RS_MASK;
     /* set timer0 */
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+    ehciInstance->ehciIpBase->GPTIMER0LD = (USB_HOST_TIMEOUT_WHEEL_TICK_MS * 1000U - 1U); /* one wheel tick */
+#else
     ehciInstance->ehciIpBase->GPTIMER0LD = (100U * 1000U - 1U); /* 100ms */
+#endif
 
     /* enable interrupt (USB interrupt enable + USB error interrupt enable + port change detect enable + system error
      * enable + interrupt on async advance enable) + general purpos Timer 0 Interrupt enable */
@@ -3675,6 +4117,12 @@ static usb_status_t USB_HostEhciCancelPipe(usb_host_ehci_instance_t *ehciInstanc
             {
                 cancelPipe = 1U;
             }
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+            if (0U != ehciPipePointer->isrCompletion)
+            {
+                USB_HostEhciIsrPipeDetach(ehciInstance, ehciPipePointer); /* the ISR doesn't access the qh now */
+            }
+#endif
             if (cancelPipe == 1U) /* cancel all pipe */
             {
                 (void)USB_HostEhciQhQtdListDeinit(ehciInstance, ehciPipePointer); /* release all the qtd */
@@ -3683,6 +4131,12 @@ static usb_status_t USB_HostEhciCancelPipe(usb_host_ehci_instance_t *ehciInstanc
             {
                 (void)USB_HostEhciTransferQtdListDeinit(ehciInstance, ehciPipePointer, transfer);
             }
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+            if (0U != ehciPipePointer->isrCompletion)
+            {
+                USB_HostEhciIsrPipeAttach(ehciInstance, ehciPipePointer);
+            }
+#endif
             break;
 
 #if (((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD)) || \
@@ -3812,16 +4266,217 @@ static usb_status_t USB_HostEhciControlBus(usb_host_ehci_instance_t *ehciInstanc
     return status;
 }
 
-void USB_HostEhciTransactionDone(usb_host_ehci_instance_t *ehciInstance)
+static void USB_HostEhciQhTransferDone(usb_host_ehci_instance_t *ehciInstance, usb_host_ehci_pipe_t *ehciPipePointer)
 {
-    /* process async QH */
-    usb_host_ehci_pipe_t *ehciPipePointer;
     usb_host_ehci_pipe_t *ehciClearPipePointer = NULL;
     volatile usb_host_ehci_qh_t *vltQhPointer;
     volatile usb_host_ehci_qtd_t *vltQtdPointer;
     usb_host_transfer_t *transfer;
     usb_host_transfer_t *nextTransfer;
     uint32_t qtdStatus = 0;
+    void *temp;
+    uint32_t transferResults;
+    uint32_t transferOverlayResults;
+
+    vltQhPointer = (volatile usb_host_ehci_qh_t *)ehciPipePointer->ehciQh; /* pipe's qh */
+    transfer     = vltQhPointer->ehciTransferHead;                         /* qh's transfer */
+    while (transfer != NULL)
+    {
+        nextTransfer = transfer->next;
+        /* normal case */
+        vltQtdPointer          = (volatile usb_host_ehci_qtd_t *)transfer->union2.unitTail;
+        transferResults        = vltQtdPointer->transferResults[0];
+        transferOverlayResults = vltQhPointer->transferOverlayResults[0];
+        if ((0U != (transferResults & (EHCI_HOST_QTD_IOC_MASK))) &&
+            (0U == (transferResults & EHCI_HOST_QTD_STATUS_ACTIVE_MASK))) /* transfer is done */
+        {
+            qtdStatus = (transferResults & EHCI_HOST_QTD_STATUS_ERROR_MASK);
+            transfer->transferSofar =
+                USB_HostEhciQtdListRelease(ehciInstance, (usb_host_ehci_qtd_t *)(transfer->union1.unitHead),
+                                           (usb_host_ehci_qtd_t *)(transfer->union2.unitTail));
+            transfer->transferSofar = (transfer->transferLength < transfer->transferSofar) ?
+                                          0U :
+                                          (transfer->transferLength - transfer->transferSofar);
+
+            vltQhPointer->ehciTransferHead = transfer->next;
+            vltQhPointer->timeOutLabel     = 0U;
+            vltQhPointer->timeOutValue     = 0U;
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+            if (ehciPipePointer->pipeCommon.pipeType != USB_ENDPOINT_INTERRUPT) /* interrupt transfer isn't armed */
+            {
+                USB_HostEhciTimeoutWheelDisarm(ehciInstance, transfer);
+            }
+#endif
+            if (0U != qtdStatus) /* has errors */
+            {
+                if (0U == (transferOverlayResults & EHCI_HOST_QTD_STATUS_ACTIVE_MASK))
+                {
+                    vltQhPointer->transferOverlayResults[0] &=
+                        (~EHCI_HOST_QTD_STATUS_MASK); /* clear error status */
+                }
+                if (0U != (qtdStatus & EHCI_HOST_QH_STATUS_NOSTALL_ERROR_MASK))
+                {
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                    USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer,
+                                                kStatus_USB_TransferFailed);
+#endif
+                    /* callback function is different from the current condition */
+                    transfer->callbackFn(transfer->callbackParam, transfer,
+                                         kStatus_USB_TransferFailed); /* transfer fail */
+                }
+                else
+                {
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                    USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer,
+                                                kStatus_USB_TransferStall);
+#endif
+                    /* callback function is different from the current condition */
+                    transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferStall);
+                }
+            }
+            else
+            {
+                if ((ehciPipePointer->pipeCommon.pipeType == USB_ENDPOINT_CONTROL) &&
+                    (transfer->setupPacket->bRequest == USB_REQUEST_STANDARD_CLEAR_FEATURE) &&
+                    (transfer->setupPacket->bmRequestType == USB_REQUEST_TYPE_RECIPIENT_ENDPOINT) &&
+                    ((USB_SHORT_FROM_LITTLE_ENDIAN(transfer->setupPacket->wValue) & 0x00FFu) ==
+                     USB_REQUEST_STANDARD_FEATURE_SELECTOR_ENDPOINT_HALT))
+                {
+                    ehciClearPipePointer = ehciInstance->ehciRunningPipeList;
+                    while (ehciClearPipePointer != NULL)
+                    {
+                        /* only compute bulk and interrupt pipe */
+                        if (((ehciClearPipePointer->pipeCommon.endpointAddress |
+                              (ehciClearPipePointer->pipeCommon.direction
+                               << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT)) ==
+                             (uint8_t)(USB_SHORT_FROM_LITTLE_ENDIAN(transfer->setupPacket->wIndex))) &&
+                            (ehciClearPipePointer->pipeCommon.deviceHandle ==
+                             ehciPipePointer->pipeCommon.deviceHandle))
+                        {
+                            break;
+                        }
+                        temp                 = (void *)ehciClearPipePointer->pipeCommon.next;
+                        ehciClearPipePointer = (usb_host_ehci_pipe_t *)temp;
+                    }
+
+                    if ((ehciClearPipePointer != NULL) &&
+                        ((ehciClearPipePointer->pipeCommon.pipeType == USB_ENDPOINT_INTERRUPT) ||
+                         (ehciClearPipePointer->pipeCommon.pipeType == USB_ENDPOINT_BULK)))
+                    {
+                        ((volatile usb_host_ehci_qh_t *)(ehciClearPipePointer->ehciQh))
+                            ->transferOverlayResults[0] &= (~EHCI_HOST_QTD_DT_MASK);
+                    }
+                }
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer, kStatus_USB_Success);
+#endif
+                /* callback function is different from the current condition */
+                transfer->callbackFn(transfer->callbackParam, transfer,
+                                     kStatus_USB_Success); /* transfer success */
+            }
+        }
+        else if ((0U == (transferOverlayResults & EHCI_HOST_QTD_STATUS_ACTIVE_MASK)) &&
+                 (0U != (transferOverlayResults &
+                         EHCI_HOST_QH_STATUS_ERROR_MASK))) /* there is error and transfer is done */
+        {
+            qtdStatus     = (vltQhPointer->transferOverlayResults[0] & EHCI_HOST_QH_STATUS_ERROR_MASK);
+            vltQtdPointer = (volatile usb_host_ehci_qtd_t *)(vltQhPointer->currentQtdPointer);
+#if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
+            vltQtdPointer = (volatile usb_host_ehci_qtd_t *)USB_HOST_MEMORY_DMA_2_CPU(vltQtdPointer);
+#endif
+            if ((0U != ((uint32_t)vltQtdPointer & EHCI_HOST_T_INVALID_VALUE)) ||
+                (vltQtdPointer == NULL)) /* the error status is unreasonable */
+            {
+                vltQhPointer->transferOverlayResults[0] &=
+                    (~EHCI_HOST_QTD_STATUS_MASK); /* clear error status */
+            }
+            else
+            {
+                /* remove qtd from qh */
+                do
+                {
+                    if (vltQtdPointer == NULL)
+                    {
+                        break;
+                    }
+                    else if (0U != (vltQtdPointer->transferResults[0] & EHCI_HOST_QTD_IOC_MASK))
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        /* no action */
+                    }
+                    vltQtdPointer = (volatile usb_host_ehci_qtd_t *)vltQtdPointer->nextQtdPointer;
+#if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
+                    vltQtdPointer =
+                        (volatile usb_host_ehci_qtd_t *)USB_HOST_MEMORY_DMA_2_CPU(vltQtdPointer);
+#endif
+                } while (true);
+
+                vltQhPointer->nextQtdPointer    = EHCI_HOST_T_INVALID_VALUE;
+                vltQhPointer->currentQtdPointer = EHCI_HOST_T_INVALID_VALUE;
+                vltQhPointer->transferOverlayResults[0] &=
+                    (~EHCI_HOST_QTD_STATUS_MASK); /* clear error status */
+                if (vltQtdPointer != NULL)
+                {
+#if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
+                    vltQhPointer->nextQtdPointer =
+                        (uint32_t)USB_HOST_MEMORY_DMA_2_CPU(vltQtdPointer->nextQtdPointer);
+#else
+                    vltQhPointer->nextQtdPointer = vltQtdPointer->nextQtdPointer;
+#endif
+                }
+
+                transfer->transferSofar = USB_HostEhciQtdListRelease(
+                    ehciInstance, (usb_host_ehci_qtd_t *)(transfer->union1.unitHead),
+                    (usb_host_ehci_qtd_t *)(transfer->union2.unitTail));
+                transfer->transferSofar = (transfer->transferLength < transfer->transferSofar) ?
+                                              0U :
+                                              (transfer->transferLength - transfer->transferSofar);
+                vltQhPointer->ehciTransferHead = transfer->next;
+                vltQhPointer->timeOutLabel     = 0U;
+                vltQhPointer->timeOutValue     = 0U;
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+                if (ehciPipePointer->pipeCommon.pipeType != USB_ENDPOINT_INTERRUPT)
+                {
+                    USB_HostEhciTimeoutWheelDisarm(ehciInstance, transfer);
+                }
+#endif
+                if (0U != (qtdStatus & EHCI_HOST_QH_STATUS_NOSTALL_ERROR_MASK))
+                {
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                    USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer,
+                                                kStatus_USB_TransferFailed);
+#endif
+                    /* callback function is different from the current condition */
+                    transfer->callbackFn(transfer->callbackParam, transfer,
+                                         kStatus_USB_TransferFailed); /* transfer fail */
+                }
+                else
+                {
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                    USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer,
+                                                kStatus_USB_TransferStall);
+#endif
+                    /* callback function is different from the current condition */
+                    transfer->callbackFn(transfer->callbackParam, transfer,
+                                         kStatus_USB_TransferStall); /* transfer stall */
+                }
+            }
+        }
+        else
+        {
+            break;
+        }
+        transfer = nextTransfer;
+    }
+}
+
+#if (((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD)) || \
+     ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD)))
+static void USB_HostEhciIsoTransferDone(usb_host_ehci_instance_t *ehciInstance, usb_host_ehci_pipe_t *ehciPipePointer)
+{
 #if ((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD))
     volatile usb_host_ehci_itd_t *vltItdPointer;
     uint8_t index = 0;
@@ -3829,271 +4484,376 @@ void USB_HostEhciTransactionDone(usb_host_ehci_instance_t *ehciInstance)
 #if ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD))
     volatile usb_host_ehci_sitd_t *vltSitdPointer;
 #endif
-#if (((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD)) || \
-     ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD)))
     usb_host_ehci_iso_t *isoPointer;
+    usb_host_transfer_t *transfer;
+    usb_host_transfer_t *nextTransfer;
+    uint32_t qtdStatus = 0;
     uint32_t dataLength;
     uint32_t speed = 0U;
+
+    qtdStatus  = 0; /* qtdStatus means break here, because there is only one break in while for misra */
+    isoPointer = (usb_host_ehci_iso_t *)ehciPipePointer->ehciQh; /* pipe's usb_host_ehci_iso_t */
+    transfer   = isoPointer->ehciTransferHead;                   /* usb_host_ehci_iso_t's transfer */
+    while (transfer != NULL)
+    {
+        nextTransfer = transfer->next;
+        (void)USB_HostHelperGetPeripheralInformation(ehciPipePointer->pipeCommon.deviceHandle,
+                                                     (uint32_t)kUSB_HostGetDeviceSpeed, &speed);
+        if (speed == USB_SPEED_HIGH)
+        {
+#if ((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD))
+            vltItdPointer =
+                (volatile usb_host_ehci_itd_t *)(transfer->union2.unitTail); /* transfer's last itd */
+            for (index = 0; index < 8U; ++index)
+            {
+                if (0U != (vltItdPointer->transactions[index] & EHCI_HOST_ITD_STATUS_ACTIVE_MASK))
+                {
+                    break;
+                }
+            }
+            if (index == 8U) /* transfer is done */
+            {
+                /* remove itd from frame list and release itd */
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+                if (NULL != transfer->isoPacketDescriptor)
+                {
+                    USB_HostEhciItdArrayPacketDone(transfer);
+                    (void)USB_HostEhciItdArrayRelease(ehciInstance,
+                                                      (usb_host_ehci_itd_t *)transfer->union1.unitHead,
+                                                      (usb_host_ehci_itd_t *)transfer->union2.unitTail);
+                }
+                else
 #endif
+                {
+                    dataLength = USB_HostEhciItdArrayRelease(
+                        ehciInstance, (usb_host_ehci_itd_t *)transfer->union1.unitHead,
+                        (usb_host_ehci_itd_t *)transfer->union2.unitTail);
+                    transfer->transferSofar = dataLength;
+                }
+                isoPointer->ehciTransferHead = transfer->next;
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer, kStatus_USB_Success);
+#endif
+                /* callback function is different from the current condition */
+                transfer->callbackFn(transfer->callbackParam, transfer,
+                                     kStatus_USB_Success); /* transfer callback success */
+                /* TODO: iso callback error */
+            }
+            else
+            {
+                qtdStatus = 1U; /* break */
+            }
+#endif
+        }
+        else
+        {
+#if ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD))
+            vltSitdPointer =
+                (volatile usb_host_ehci_sitd_t *)(transfer->union2.unitTail); /* transfer's last sitd */
+            if (0U == (vltSitdPointer->transferResults[0] &
+                       EHCI_HOST_SITD_STATUS_ACTIVE_MASK)) /* transfer is done */
+            {
+                /* remove sitd from frame list and release itd */
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+                if (NULL != transfer->isoPacketDescriptor)
+                {
+                    USB_HostEhciSitdArrayPacketDone(ehciInstance, transfer);
+                    (void)USB_HostEhciSitdArrayRelease(
+                        ehciInstance, (usb_host_ehci_sitd_t *)transfer->union1.unitHead,
+                        (usb_host_ehci_sitd_t *)transfer->union2.unitTail);
+                }
+                else
+#endif
+                {
+                    dataLength = USB_HostEhciSitdArrayRelease(
+                        ehciInstance, (usb_host_ehci_sitd_t *)transfer->union1.unitHead,
+                        (usb_host_ehci_sitd_t *)transfer->union2.unitTail);
+                    transfer->transferSofar = transfer->transferLength - dataLength;
+                }
+                isoPointer->ehciTransferHead = transfer->next;
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer, kStatus_USB_Success);
+#endif
+                /* callback function is different from the current condition */
+                transfer->callbackFn(transfer->callbackParam, transfer,
+                                     kStatus_USB_Success); /* transfer callback success */
+                /* TODO: iso callback error */
+            }
+            else
+            {
+                qtdStatus = 1U; /* break */
+            }
+#endif
+        }
+        if (qtdStatus == 1U)
+        {
+            break;
+        }
+        transfer = nextTransfer;
+    }
+}
+#endif
+
+static void USB_HostEhciPipeTransferDone(usb_host_ehci_instance_t *ehciInstance, usb_host_ehci_pipe_t *ehciPipePointer)
+{
+    switch (ehciPipePointer->pipeCommon.pipeType)
+    {
+        case USB_ENDPOINT_BULK:
+        case USB_ENDPOINT_INTERRUPT:
+        case USB_ENDPOINT_CONTROL:
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+            if (0U != ehciPipePointer->isrCompletion)
+            {
+                break; /* the pipe's transfers are completed in the ISR */
+            }
+#endif
+            USB_HostEhciQhTransferDone(ehciInstance, ehciPipePointer);
+            break;
+#if (((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD)) || \
+     ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD)))
+        case USB_ENDPOINT_ISOCHRONOUS:
+            USB_HostEhciIsoTransferDone(ehciInstance, ehciPipePointer);
+            break;
+#endif
+
+        default:
+            /*no action*/
+            break;
+    }
+}
+
+void USB_HostEhciTransactionDone(usb_host_ehci_instance_t *ehciInstance)
+{
+    usb_host_ehci_pipe_t *ehciPipePointer;
     void *temp;
-    uint32_t transferResults;
-    uint32_t transferOverlayResults;
 
     ehciPipePointer = ehciInstance->ehciRunningPipeList; /* check all the running pipes */
     while (ehciPipePointer != NULL)
     {
-        switch (ehciPipePointer->pipeCommon.pipeType)
-        {
-            case USB_ENDPOINT_BULK:
-            case USB_ENDPOINT_INTERRUPT:
-            case USB_ENDPOINT_CONTROL:
-                vltQhPointer = (volatile usb_host_ehci_qh_t *)ehciPipePointer->ehciQh; /* pipe's qh */
-                transfer     = vltQhPointer->ehciTransferHead;                         /* qh's transfer */
-                while (transfer != NULL)
+        USB_HostEhciPipeTransferDone(ehciInstance, ehciPipePointer);
+        temp            = (void *)ehciPipePointer->pipeCommon.next;
+        ehciPipePointer = (usb_host_ehci_pipe_t *)temp;
+    }
+}
+
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+static uint8_t USB_HostEhciPipeIsDone(usb_host_ehci_pipe_t *ehciPipePointer, uint32_t *status)
+{
+    volatile usb_host_ehci_qh_t *vltQhPointer;
+    volatile usb_host_ehci_qtd_t *vltQtdPointer;
+#if (((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD)) || \
+     ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD)))
+#if ((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD))
+    volatile usb_host_ehci_itd_t *vltItdPointer;
+    uint8_t index;
+#endif
+#if ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD))
+    volatile usb_host_ehci_sitd_t *vltSitdPointer;
+#endif
+    uint32_t speed = 0U;
+#endif
+    usb_host_transfer_t *transfer;
+    uint32_t transferResults;
+    uint32_t transferOverlayResults;
+    uint8_t done = 0U;
+
+    switch (ehciPipePointer->pipeCommon.pipeType)
+    {
+        case USB_ENDPOINT_BULK:
+        case USB_ENDPOINT_INTERRUPT:
+        case USB_ENDPOINT_CONTROL:
+            vltQhPointer = (volatile usb_host_ehci_qh_t *)ehciPipePointer->ehciQh;
+            transfer     = vltQhPointer->ehciTransferHead;
+            if (transfer != NULL)
+            {
+                /* the same done conditions as USB_HostEhciQhTransferDone */
+                vltQtdPointer          = (volatile usb_host_ehci_qtd_t *)transfer->union2.unitTail;
+                transferResults        = vltQtdPointer->transferResults[0];
+                transferOverlayResults = vltQhPointer->transferOverlayResults[0];
+                if ((0U != (transferResults & (EHCI_HOST_QTD_IOC_MASK))) &&
+                    (0U == (transferResults & EHCI_HOST_QTD_STATUS_ACTIVE_MASK)))
+                {
+                    *status = transferResults;
+                    done    = 1U;
+                }
+                else if ((0U == (transferOverlayResults & EHCI_HOST_QTD_STATUS_ACTIVE_MASK)) &&
+                         (0U != (transferOverlayResults & EHCI_HOST_QH_STATUS_ERROR_MASK)))
                 {
-                    nextTransfer = transfer->next;
-                    /* normal case */
-                    vltQtdPointer          = (volatile usb_host_ehci_qtd_t *)transfer->union2.unitTail;
-                    transferResults        = vltQtdPointer->transferResults[0];
-                    transferOverlayResults = vltQhPointer->transferOverlayResults[0];
-                    if ((0U != (transferResults & (EHCI_HOST_QTD_IOC_MASK))) &&
-                        (0U == (transferResults & EHCI_HOST_QTD_STATUS_ACTIVE_MASK))) /* transfer is done */
+                    *status = transferOverlayResults;
+                    done    = 1U;
+                }
+                else
+                {
+                    /*no action*/
+                }
+            }
+            break;
+#if (((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD)) || \
+     ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD)))
+        case USB_ENDPOINT_ISOCHRONOUS:
+            transfer = ((usb_host_ehci_iso_t *)ehciPipePointer->ehciQh)->ehciTransferHead;
+            if (transfer == NULL)
+            {
+                break;
+            }
+            (void)USB_HostHelperGetPeripheralInformation(ehciPipePointer->pipeCommon.deviceHandle,
+                                                         (uint32_t)kUSB_HostGetDeviceSpeed, &speed);
+            if (speed == USB_SPEED_HIGH)
+            {
+#if ((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD))
+                vltItdPointer = (volatile usb_host_ehci_itd_t *)(transfer->union2.unitTail);
+                for (index = 0; index < 8U; ++index)
+                {
+                    if (0U != (vltItdPointer->transactions[index] & EHCI_HOST_ITD_STATUS_ACTIVE_MASK))
                     {
-                        qtdStatus = (transferResults & EHCI_HOST_QTD_STATUS_ERROR_MASK);
-                        transfer->transferSofar =
-                            USB_HostEhciQtdListRelease(ehciInstance, (usb_host_ehci_qtd_t *)(transfer->union1.unitHead),
-                                                       (usb_host_ehci_qtd_t *)(transfer->union2.unitTail));
-                        transfer->transferSofar = (transfer->transferLength < transfer->transferSofar) ?
-                                                      0U :
-                                                      (transfer->transferLength - transfer->transferSofar);
-
-                        vltQhPointer->ehciTransferHead = transfer->next;
-                        vltQhPointer->timeOutLabel     = 0U;
-                        vltQhPointer->timeOutValue     = USB_HOST_EHCI_CONTROL_BULK_TIME_OUT_VALUE;
-                        if (0U != qtdStatus) /* has errors */
-                        {
-                            if (0U == (transferOverlayResults & EHCI_HOST_QTD_STATUS_ACTIVE_MASK))
-                            {
-                                vltQhPointer->transferOverlayResults[0] &=
-                                    (~EHCI_HOST_QTD_STATUS_MASK); /* clear error status */
-                            }
-                            if (0U != (qtdStatus & EHCI_HOST_QH_STATUS_NOSTALL_ERROR_MASK))
-                            {
-                                /* callback function is different from the current condition */
-                                transfer->callbackFn(transfer->callbackParam, transfer,
-                                                     kStatus_USB_TransferFailed); /* transfer fail */
-                            }
-                            else
-                            {
-                                /* callback function is different from the current condition */
-                                transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferStall);
-                            }
-                        }
-                        else
-                        {
-                            if ((ehciPipePointer->pipeCommon.pipeType == USB_ENDPOINT_CONTROL) &&
-                                (transfer->setupPacket->bRequest == USB_REQUEST_STANDARD_CLEAR_FEATURE) &&
-                                (transfer->setupPacket->bmRequestType == USB_REQUEST_TYPE_RECIPIENT_ENDPOINT) &&
-                                ((USB_SHORT_FROM_LITTLE_ENDIAN(transfer->setupPacket->wValue) & 0x00FFu) ==
-                                 USB_REQUEST_STANDARD_FEATURE_SELECTOR_ENDPOINT_HALT))
-                            {
-                                ehciClearPipePointer = ehciInstance->ehciRunningPipeList;
-                                while (ehciClearPipePointer != NULL)
-                                {
-                                    /* only compute bulk and interrupt pipe */
-                                    if (((ehciClearPipePointer->pipeCommon.endpointAddress |
-                                          (ehciClearPipePointer->pipeCommon.direction
-                                           << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT)) ==
-                                         (uint8_t)(USB_SHORT_FROM_LITTLE_ENDIAN(transfer->setupPacket->wIndex))) &&
-                                        (ehciClearPipePointer->pipeCommon.deviceHandle ==
-                                         ehciPipePointer->pipeCommon.deviceHandle))
-                                    {
-                                        break;
-                                    }
-                                    temp                 = (void *)ehciClearPipePointer->pipeCommon.next;
-                                    ehciClearPipePointer = (usb_host_ehci_pipe_t *)temp;
-                                }
-
-                                if ((ehciClearPipePointer != NULL) &&
-                                    ((ehciClearPipePointer->pipeCommon.pipeType == USB_ENDPOINT_INTERRUPT) ||
-                                     (ehciClearPipePointer->pipeCommon.pipeType == USB_ENDPOINT_BULK)))
-                                {
-                                    ((volatile usb_host_ehci_qh_t *)(ehciClearPipePointer->ehciQh))
-                                        ->transferOverlayResults[0] &= (~EHCI_HOST_QTD_DT_MASK);
-                                }
-                            }
-                            /* callback function is different from the current condition */
-                            transfer->callbackFn(transfer->callbackParam, transfer,
-                                                 kStatus_USB_Success); /* transfer success */
-                        }
+                        break;
                     }
-                    else if ((0U == (transferOverlayResults & EHCI_HOST_QTD_STATUS_ACTIVE_MASK)) &&
-                             (0U != (transferOverlayResults &
-                                     EHCI_HOST_QH_STATUS_ERROR_MASK))) /* there is error and transfer is done */
-                    {
-                        qtdStatus     = (vltQhPointer->transferOverlayResults[0] & EHCI_HOST_QH_STATUS_ERROR_MASK);
-                        vltQtdPointer = (volatile usb_host_ehci_qtd_t *)(vltQhPointer->currentQtdPointer);
-#if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
-                        vltQtdPointer = (volatile usb_host_ehci_qtd_t *)USB_HOST_MEMORY_DMA_2_CPU(vltQtdPointer);
+                }
+                if (index == 8U)
+                {
+                    *status = vltItdPointer->transactions[7];
+                    done    = 1U;
+                }
 #endif
-                        if ((0U != ((uint32_t)vltQtdPointer & EHCI_HOST_T_INVALID_VALUE)) ||
-                            (vltQtdPointer == NULL)) /* the error status is unreasonable */
-                        {
-                            vltQhPointer->transferOverlayResults[0] &=
-                                (~EHCI_HOST_QTD_STATUS_MASK); /* clear error status */
-                        }
-                        else
-                        {
-                            /* remove qtd from qh */
-                            do
-                            {
-                                if (vltQtdPointer == NULL)
-                                {
-                                    break;
-                                }
-                                else if (0U != (vltQtdPointer->transferResults[0] & EHCI_HOST_QTD_IOC_MASK))
-                                {
-                                    break;
-                                }
-                                else
-                                {
-                                    /* no action */
-                                }
-                                vltQtdPointer = (volatile usb_host_ehci_qtd_t *)vltQtdPointer->nextQtdPointer;
-#if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
-                                vltQtdPointer =
-                                    (volatile usb_host_ehci_qtd_t *)USB_HOST_MEMORY_DMA_2_CPU(vltQtdPointer);
+            }
+            else
+            {
+#if ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD))
+                vltSitdPointer = (volatile usb_host_ehci_sitd_t *)(transfer->union2.unitTail);
+                if (0U == (vltSitdPointer->transferResults[0] & EHCI_HOST_SITD_STATUS_ACTIVE_MASK))
+                {
+                    *status = vltSitdPointer->transferResults[0];
+                    done    = 1U;
+                }
+#endif
+            }
+            break;
+#endif
+
+        default:
+            /*no action*/
+            break;
+    }
+    return done;
+}
+
+static void USB_HostEhciEventRingDone(usb_host_ehci_instance_t *ehciInstance)
+{
+    usb_host_event_record_t recordList[USB_HOST_EVENT_RING_BATCH];
+    usb_host_ehci_pipe_t *ehciPipePointer;
+    uint32_t recordCount;
+    uint32_t index;
+    void *temp;
+
+    if (0U != USB_HostEventRingOverflow(&ehciInstance->eventRing))
+    {
+        /* the records are dropped, check all the running pipes */
+        ehciPipePointer = ehciInstance->ehciRunningPipeList;
+        while (ehciPipePointer != NULL)
+        {
+            ehciPipePointer->eventPending = 0U;
+            temp                          = (void *)ehciPipePointer->pipeCommon.next;
+            ehciPipePointer               = (usb_host_ehci_pipe_t *)temp;
+        }
+        USB_HostEhciTransactionDone(ehciInstance);
+        return;
+    }
+
+    do
+    {
+        recordCount = USB_HostEventRingDrain(&ehciInstance->eventRing, &recordList[0], USB_HOST_EVENT_RING_BATCH);
+        for (index = 0U; index < recordCount; ++index)
+        {
+            temp            = (void *)recordList[index].pipe;
+            ehciPipePointer = (usb_host_ehci_pipe_t *)temp;
+            /* the pipe may be closed after the record is pushed */
+            if (0U != ehciPipePointer->pipeCommon.open)
+            {
+                ehciPipePointer->eventPending = 0U; /* the ISR pushes a new record for the next done transfer */
+                USB_HostEhciPipeTransferDone(ehciInstance, ehciPipePointer);
+            }
+        }
+    } while (recordCount == USB_HOST_EVENT_RING_BATCH);
+}
 #endif
-                            } while (true);
 
-                            vltQhPointer->nextQtdPointer    = EHCI_HOST_T_INVALID_VALUE;
-                            vltQhPointer->currentQtdPointer = EHCI_HOST_T_INVALID_VALUE;
-                            vltQhPointer->transferOverlayResults[0] &=
-                                (~EHCI_HOST_QTD_STATUS_MASK); /* clear error status */
-                            if (vltQtdPointer != NULL)
-                            {
-#if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
-                                vltQhPointer->nextQtdPointer =
-                                    (uint32_t)USB_HOST_MEMORY_DMA_2_CPU(vltQtdPointer->nextQtdPointer);
-#else
-                                vltQhPointer->nextQtdPointer = vltQtdPointer->nextQtdPointer;
+#if (USB_HOST_EHCI_ISR_PIPE_LIST > 0U)
+static void USB_HostEhciIsrTransactionDone(usb_host_ehci_instance_t *ehciInstance)
+{
+    usb_host_ehci_pipe_t *ehciPipePointer = ehciInstance->ehciIsrPipeList;
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+    uint32_t status;
 #endif
-                            }
 
-                            transfer->transferSofar = USB_HostEhciQtdListRelease(
-                                ehciInstance, (usb_host_ehci_qtd_t *)(transfer->union1.unitHead),
-                                (usb_host_ehci_qtd_t *)(transfer->union2.unitTail));
-                            transfer->transferSofar = (transfer->transferLength < transfer->transferSofar) ?
-                                                          0U :
-                                                          (transfer->transferLength - transfer->transferSofar);
-                            vltQhPointer->ehciTransferHead = transfer->next;
-                            vltQhPointer->timeOutLabel     = 0U;
-                            vltQhPointer->timeOutValue     = USB_HOST_EHCI_CONTROL_BULK_TIME_OUT_VALUE;
-                            if (0U != (qtdStatus & EHCI_HOST_QH_STATUS_NOSTALL_ERROR_MASK))
-                            {
-                                /* callback function is different from the current condition */
-                                transfer->callbackFn(transfer->callbackParam, transfer,
-                                                     kStatus_USB_TransferFailed); /* transfer fail */
-                            }
-                            else
-                            {
-                                /* callback function is different from the current condition */
-                                transfer->callbackFn(transfer->callbackParam, transfer,
-                                                     kStatus_USB_TransferStall); /* transfer stall */
-                            }
-                        }
-                    }
-                    else
-                    {
-                        break;
-                    }
-                    transfer = nextTransfer;
-                }
-                break;
-#if (((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD)) || \
-     ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD)))
-            case USB_ENDPOINT_ISOCHRONOUS:
-                qtdStatus  = 0; /* qtdStatus means break here, because there is only one break in while for misra */
-                isoPointer = (usb_host_ehci_iso_t *)ehciPipePointer->ehciQh; /* pipe's usb_host_ehci_iso_t */
-                transfer   = isoPointer->ehciTransferHead;                   /* usb_host_ehci_iso_t's transfer */
-                while (transfer != NULL)
-                {
-                    nextTransfer = transfer->next;
-                    (void)USB_HostHelperGetPeripheralInformation(ehciPipePointer->pipeCommon.deviceHandle,
-                                                                 (uint32_t)kUSB_HostGetDeviceSpeed, &speed);
-                    if (speed == USB_SPEED_HIGH)
-                    {
-#if ((defined USB_HOST_CONFIG_EHCI_MAX_ITD) && (USB_HOST_CONFIG_EHCI_MAX_ITD))
-                        vltItdPointer =
-                            (volatile usb_host_ehci_itd_t *)(transfer->union2.unitTail); /* transfer's last itd */
-                        for (index = 0; index < 8U; ++index)
-                        {
-                            if (0U != (vltItdPointer->transactions[index] & EHCI_HOST_ITD_STATUS_ACTIVE_MASK))
-                            {
-                                break;
-                            }
-                        }
-                        if (index == 8U) /* transfer is done */
-                        {
-                            /* remove itd from frame list and release itd */
-                            dataLength                   = USB_HostEhciItdArrayRelease(ehciInstance,
-                                                                     (usb_host_ehci_itd_t *)transfer->union1.unitHead,
-                                                                     (usb_host_ehci_itd_t *)transfer->union2.unitTail);
-                            transfer->transferSofar      = dataLength;
-                            isoPointer->ehciTransferHead = transfer->next;
-                            /* callback function is different from the current condition */
-                            transfer->callbackFn(transfer->callbackParam, transfer,
-                                                 kStatus_USB_Success); /* transfer callback success */
-                            /* TODO: iso callback error */
-                        }
-                        else
-                        {
-                            qtdStatus = 1U; /* break */
-                        }
-#endif
-                    }
-                    else
-                    {
-#if ((defined USB_HOST_CONFIG_EHCI_MAX_SITD) && (USB_HOST_CONFIG_EHCI_MAX_SITD))
-                        vltSitdPointer =
-                            (volatile usb_host_ehci_sitd_t *)(transfer->union2.unitTail); /* transfer's last sitd */
-                        if (0U == (vltSitdPointer->transferResults[0] &
-                                   EHCI_HOST_SITD_STATUS_ACTIVE_MASK)) /* transfer is done */
-                        {
-                            /* remove sitd from frame list and release itd */
-                            dataLength = USB_HostEhciSitdArrayRelease(
-                                ehciInstance, (usb_host_ehci_sitd_t *)transfer->union1.unitHead,
-                                (usb_host_ehci_sitd_t *)transfer->union2.unitTail);
-                            transfer->transferSofar      = transfer->transferLength - dataLength;
-                            isoPointer->ehciTransferHead = transfer->next;
-                            /* callback function is different from the current condition */
-                            transfer->callbackFn(transfer->callbackParam, transfer,
-                                                 kStatus_USB_Success); /* transfer callback success */
-                            /* TODO: iso callback error */
-                        }
-                        else
-                        {
-                            qtdStatus = 1U; /* break */
-                        }
+    while (ehciPipePointer != NULL)
+    {
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+        if (0U != ehciPipePointer->isrCompletion)
+        {
+            USB_HostEhciQhTransferDone(ehciInstance, ehciPipePointer);
+        }
+        else
 #endif
-                    }
-                    if (qtdStatus == 1U)
-                    {
-                        break;
-                    }
-                    transfer = nextTransfer;
+        {
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+            /* one record for one pipe until the task processes it */
+            if ((0U == ehciPipePointer->eventPending) && (0U != USB_HostEhciPipeIsDone(ehciPipePointer, &status)))
+            {
+                if (kStatus_USB_Success ==
+                    USB_HostEventRingPush(&ehciInstance->eventRing, &ehciPipePointer->pipeCommon, status,
+                                          (uint16_t)((ehciInstance->ehciIpBase->FRINDEX & EHCI_MAX_UFRAME_VALUE) >> 3)))
+                {
+                    ehciPipePointer->eventPending = 1U;
                 }
-                break;
+            }
+#endif
+        }
+        ehciPipePointer = ehciPipePointer->isrNext;
+    }
+}
+
+static void USB_HostEhciIsrPipeAttach(usb_host_ehci_instance_t *ehciInstance, usb_host_ehci_pipe_t *ehciPipePointer)
+{
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    ehciPipePointer->isrNext      = ehciInstance->ehciIsrPipeList;
+    ehciInstance->ehciIsrPipeList = ehciPipePointer;
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    if (0U != ehciPipePointer->isrCompletion)
+    {
+        USB_HostEhciQhTransferDone(ehciInstance, ehciPipePointer);
+    }
 #endif
+    OSA_EXIT_CRITICAL();
+}
 
-            default:
-                /*no action*/
-                break;
+static void USB_HostEhciIsrPipeDetach(usb_host_ehci_instance_t *ehciInstance, usb_host_ehci_pipe_t *ehciPipePointer)
+{
+    usb_host_ehci_pipe_t *prevPointer;
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    if (ehciInstance->ehciIsrPipeList == ehciPipePointer)
+    {
+        ehciInstance->ehciIsrPipeList = ehciPipePointer->isrNext;
+    }
+    else
+    {
+        prevPointer = ehciInstance->ehciIsrPipeList;
+        while ((prevPointer != NULL) && (prevPointer->isrNext != ehciPipePointer))
+        {
+            prevPointer = prevPointer->isrNext;
+        }
+        if (prevPointer != NULL)
+        {
+            prevPointer->isrNext = ehciPipePointer->isrNext;
         }
-        temp            = (void *)ehciPipePointer->pipeCommon.next;
-        ehciPipePointer = (usb_host_ehci_pipe_t *)temp;
     }
+    ehciPipePointer->isrNext = NULL;
+    OSA_EXIT_CRITICAL();
 }
+#endif
 
 static void USB_HostEhciPortChange(usb_host_ehci_instance_t *ehciInstance)
 {
@@ -4174,9 +4934,13 @@ static void USB_HostEhciPortChange(usb_host_ehci_instance_t *ehciInstance)
         USB_HostEhciDelay(ehciInstance->ehciIpBase, USB_HOST_EHCI_PORT_RESET_DELAY);
         /* process attach */
         (void)OSA_EventSet(ehciInstance->taskEventHandle, EHCI_TASK_EVENT_DEVICE_ATTACH);
-        /* gpt timer start */
+#if (!((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))) || \
+    ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+        /* gpt timer start, the timeout wheel starts it only when there is pending transfer, but the metrics sample the
+         * frame number in each tick */
         ehciInstance->ehciIpBase->GPTIMER0CTL |=
             (USBHS_GPTIMER0CTL_RUN_MASK | USBHS_GPTIMER0CTL_MODE_MASK | USBHS_GPTIMER0CTL_RST_MASK);
+#endif
         ehciInstance->deviceAttached = (uint8_t)kEHCIDevicePhyAttached;
     }
     else
@@ -4202,15 +4966,264 @@ static void USB_HostEhciPortChange(usb_host_ehci_instance_t *ehciInstance)
     }
 }
 
-static void USB_HostEhciTimer0(usb_host_ehci_instance_t *ehciInstance)
+static void USB_HostEhciTimeoutRelease(usb_host_ehci_instance_t *ehciInstance,
+                                       volatile usb_host_ehci_qh_t *vltQhPointer,
+                                       usb_host_ehci_qtd_t *vltQtdPointer,
+                                       usb_host_transfer_t *transfer)
+{
+#if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
+    uint32_t convert_addr = 0U;
+#endif
+    void *temp;
+
+    /* remove qtd from qh */
+    temp = (void *)vltQhPointer->ehciTransferTail;
+    while ((vltQtdPointer != NULL) && (0U == (vltQtdPointer->transferResults[0] & EHCI_HOST_QTD_IOC_MASK)) &&
+           (vltQtdPointer != (usb_host_ehci_qtd_t *)temp))
+    {
+#if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
+        vltQtdPointer = (usb_host_ehci_qtd_t *)USB_HOST_MEMORY_DMA_2_CPU(vltQtdPointer->nextQtdPointer);
+#else
+        vltQtdPointer = (usb_host_ehci_qtd_t *)vltQtdPointer->nextQtdPointer;
+#endif
+    }
+#if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
+    convert_addr = (uint32_t)USB_HOST_MEMORY_DMA_2_CPU(vltQtdPointer->nextQtdPointer);
+    if ((vltQtdPointer != NULL) && (0U == (convert_addr & EHCI_HOST_T_INVALID_VALUE)))
+    {
+        vltQhPointer->nextQtdPointer =
+            convert_addr; /* start qh if there are other qtd that don't belong to the transfer */
+    }
+#else
+    if ((vltQtdPointer != NULL) && (0U == (vltQtdPointer->nextQtdPointer & EHCI_HOST_T_INVALID_VALUE)))
+    {
+        vltQhPointer->nextQtdPointer =
+            vltQtdPointer->nextQtdPointer; /* start qh if there are other qtd that don't belong to the transfer */
+    }
+#endif
+    transfer->transferSofar =
+        USB_HostEhciQtdListRelease(ehciInstance, (usb_host_ehci_qtd_t *)(transfer->union1.unitHead),
+                                   (usb_host_ehci_qtd_t *)(transfer->union2.unitTail));
+    transfer->transferSofar = (transfer->transferLength < transfer->transferSofar) ?
+                                  0U :
+                                  (transfer->transferLength - transfer->transferSofar);
+
+    vltQhPointer->ehciTransferHead = transfer->next;
+    vltQhPointer->timeOutValue     = 0U;
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    USB_HostMetricsRecordEvent(transfer->transferPipe, kUSB_HostMetricsTimeout);
+    USB_HostMetricsTransferDone(ehciInstance->hostHandle, transfer, kStatus_USB_TransferFailed);
+#endif
+    /* callback function is different from the current condition */
+    transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferFailed);
+}
+
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+static void USB_HostEhciTimeoutWheelArm(usb_host_ehci_instance_t *ehciInstance,
+                                        usb_host_ehci_pipe_t *ehciPipePointer,
+                                        usb_host_transfer_t *transfer)
+{
+    volatile usb_host_ehci_qh_t *vltQhPointer = (volatile usb_host_ehci_qh_t *)ehciPipePointer->ehciQh;
+
+    if (USB_HostTimeoutWheelIsIdle(&ehciInstance->timeoutWheel))
+    {
+        /* the timer only runs when there are pending transfers */
+        ehciInstance->timeoutWheelFrame = ehciInstance->ehciIpBase->FRINDEX & EHCI_MAX_UFRAME_VALUE;
+        ehciInstance->ehciIpBase->GPTIMER0CTL |=
+            (USBHS_GPTIMER0CTL_RUN_MASK | USBHS_GPTIMER0CTL_MODE_MASK | USBHS_GPTIMER0CTL_RST_MASK);
+    }
+    if (transfer == vltQhPointer->ehciTransferHead)
+    {
+        USB_HostEhciTimeoutWheelStart(ehciInstance, ehciPipePointer, transfer);
+    }
+    else
+    {
+        /* the timeout is counted after the previous transfers are done, check it in the next tick */
+        transfer->timeoutStarted = 0U;
+        USB_HostTimeoutWheelAdd(&ehciInstance->timeoutWheel, transfer, USB_HOST_TIMEOUT_WHEEL_TICK_MS);
+    }
+}
+
+static void USB_HostEhciTimeoutWheelStart(usb_host_ehci_instance_t *ehciInstance,
+                                          usb_host_ehci_pipe_t *ehciPipePointer,
+                                          usb_host_transfer_t *transfer)
+{
+    usb_host_ehci_qtd_t *qtdPointer = (usb_host_ehci_qtd_t *)transfer->union1.unitHead;
+
+    /* the first qtd's total bytes, the transfer makes no progress when the value doesn't change */
+    transfer->timeoutProgress =
+        ((qtdPointer->transferResults[0] & EHCI_HOST_QTD_TOTAL_BYTES_MASK) >> EHCI_HOST_QTD_TOTAL_BYTES_SHIFT);
+    transfer->timeoutStarted = 1U;
+    USB_HostTimeoutWheelAdd(&ehciInstance->timeoutWheel, transfer,
+                            USB_HostTransferTimeout(transfer, ehciPipePointer->pipeCommon.pipeType));
+}
+
+static void USB_HostEhciTimeoutWheelDisarm(usb_host_ehci_instance_t *ehciInstance, usb_host_transfer_t *transfer)
+{
+    USB_HostEhciLock();
+    USB_HostTimeoutWheelRemove(&ehciInstance->timeoutWheel, transfer);
+    USB_HostEhciUnlock();
+}
+
+static void USB_HostEhciTransferTimeout(usb_host_ehci_instance_t *ehciInstance, usb_host_transfer_t *transfer)
 {
+    usb_host_ehci_pipe_t *ehciPipePointer = (usb_host_ehci_pipe_t *)(void *)transfer->transferPipe;
     volatile usb_host_ehci_qh_t *vltQhPointer;
     usb_host_ehci_qtd_t *vltQtdPointer;
-    usb_host_transfer_t *transfer;
+    usb_host_transfer_t *searchTransfer;
     uint32_t backValue;
+    uint8_t timeoutLabel = 0U;
+
+    vltQhPointer = (volatile usb_host_ehci_qh_t *)ehciPipePointer->ehciQh;
+
+    USB_HostEhciLock();
+    /* the transfer may be done or cancelled after it expires */
+    searchTransfer = vltQhPointer->ehciTransferHead;
+    while ((searchTransfer != NULL) && (searchTransfer != transfer))
+    {
+        searchTransfer = searchTransfer->next;
+    }
+
+    if (searchTransfer == NULL)
+    {
+        /* no action */
+    }
+    else if (ehciInstance->deviceAttached != (uint8_t)kEHCIDeviceAttached)
+    {
+        if (transfer == vltQhPointer->ehciTransferHead)
+        {
+            vltQtdPointer                = (usb_host_ehci_qtd_t *)transfer->union2.unitTail;
+            vltQhPointer->nextQtdPointer = EHCI_HOST_T_INVALID_VALUE;                 /* invalid next qtd */
+            vltQhPointer->transferOverlayResults[0] &= (~EHCI_HOST_QTD_STATUS_MASK); /* clear error status */
+            timeoutLabel = 1U;
+        }
+        else
+        {
+            /* release it after the previous transfers */
+            USB_HostTimeoutWheelAdd(&ehciInstance->timeoutWheel, transfer, USB_HOST_TIMEOUT_WHEEL_TICK_MS);
+        }
+    }
+    else if (transfer != vltQhPointer->ehciTransferHead)
+    {
+        /* the transfer doesn't start, check it again in the next tick */
+        USB_HostTimeoutWheelAdd(&ehciInstance->timeoutWheel, transfer, USB_HOST_TIMEOUT_WHEEL_TICK_MS);
+    }
+    else if (0U == transfer->timeoutStarted)
+    {
+        /* the previous transfers are done, the timeout is counted from now */
+        USB_HostEhciTimeoutWheelStart(ehciInstance, ehciPipePointer, transfer);
+    }
+    else
+    {
+        /* stop the qh schedule */
+        USB_HostEhciStopAsync(ehciInstance);
+        if (0U != (vltQhPointer->transferOverlayResults[0] & EHCI_HOST_QTD_STATUS_ACTIVE_MASK))
+        {
 #if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
-    uint32_t convert_addr = 0U;
+            vltQtdPointer = (usb_host_ehci_qtd_t *)USB_HOST_MEMORY_DMA_2_CPU(vltQhPointer->currentQtdPointer);
+#else
+            vltQtdPointer = (usb_host_ehci_qtd_t *)vltQhPointer->currentQtdPointer;
+#endif
+            backValue = vltQhPointer->transferOverlayResults[0];
+        }
+        else
+        {
+            vltQtdPointer = (usb_host_ehci_qtd_t *)transfer->union2.unitTail;
+            backValue     = vltQtdPointer->transferResults[0];
+        }
+        /* backValue is used for total bytes to transfer */
+        backValue = ((backValue & EHCI_HOST_QTD_TOTAL_BYTES_MASK) >> EHCI_HOST_QTD_TOTAL_BYTES_SHIFT);
+        if ((0U == transfer->timeout) && (backValue != transfer->timeoutProgress))
+        {
+            /* the transfer makes progress, wait for another default duration */
+            USB_HostEhciStartAsync(ehciInstance);
+            transfer->timeoutProgress = backValue;
+            USB_HostTimeoutWheelAdd(&ehciInstance->timeoutWheel, transfer,
+                                    USB_HostTransferTimeout(transfer, ehciPipePointer->pipeCommon.pipeType));
+        }
+        else
+        {
+            vltQhPointer->nextQtdPointer = EHCI_HOST_T_INVALID_VALUE;                 /* invalid next qtd */
+            vltQhPointer->transferOverlayResults[0] &= (~EHCI_HOST_QTD_STATUS_MASK); /* clear error status */
+            USB_HostEhciStartAsync(ehciInstance);
+            timeoutLabel = 1U;
+        }
+    }
+    USB_HostEhciUnlock();
+
+    if (timeoutLabel == 1U)
+    {
+        USB_HostEhciTimeoutRelease(ehciInstance, vltQhPointer, vltQtdPointer, transfer);
+    }
+}
+
+static void USB_HostEhciTimer0(usb_host_ehci_instance_t *ehciInstance)
+{
+    usb_host_transfer_t *transfer;
+    usb_host_transfer_t *nextTransfer;
+    uint32_t frameIndex;
+    uint32_t ticks;
+
+    USB_HostEhciLock();
+    if (ehciInstance->deviceAttached != (uint8_t)kEHCIDeviceAttached)
+    {
+        transfer = USB_HostTimeoutWheelExpireAll(&ehciInstance->timeoutWheel);
+    }
+    else
+    {
+        /* the elapsed ticks are computed from the micro-frame index, the timer interrupt only triggers the process */
+        frameIndex = ehciInstance->ehciIpBase->FRINDEX & EHCI_MAX_UFRAME_VALUE;
+        ticks      = ((frameIndex - ehciInstance->timeoutWheelFrame) & EHCI_MAX_UFRAME_VALUE) /
+                (USB_HOST_TIMEOUT_WHEEL_TICK_MS * 8U);
+        if (ticks == 0U)
+        {
+            /* the frame index doesn't run when the schedule is stopped, one timer period is one tick */
+            ticks                           = 1U;
+            ehciInstance->timeoutWheelFrame = frameIndex;
+        }
+        else
+        {
+            ehciInstance->timeoutWheelFrame =
+                (ehciInstance->timeoutWheelFrame + ticks * USB_HOST_TIMEOUT_WHEEL_TICK_MS * 8U) &
+                EHCI_MAX_UFRAME_VALUE;
+        }
+        transfer = USB_HostTimeoutWheelAdvance(&ehciInstance->timeoutWheel, ticks);
+    }
+    USB_HostEhciUnlock();
+
+    while (transfer != NULL)
+    {
+        nextTransfer          = transfer->timeoutNext;
+        transfer->timeoutNext = NULL;
+        USB_HostEhciTransferTimeout(ehciInstance, transfer);
+        transfer = nextTransfer;
+    }
+
+    /* the timer keeps running when the metrics are enabled, it is their frame number sampling tick */
+#if !((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    USB_HostEhciLock();
+#if ((defined USB_HOST_CONFIG_HUB) && (USB_HOST_CONFIG_HUB) && (defined(USB_HOST_CONFIG_HUB_ENGINE)) && \
+     (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+    /* the timer keeps running for the HUB port debounce */
+    if ((USB_HostTimeoutWheelIsIdle(&ehciInstance->timeoutWheel)) &&
+        (0U == USB_HostHubEngineTimerPending(ehciInstance->hostHandle)))
+#else
+    if (USB_HostTimeoutWheelIsIdle(&ehciInstance->timeoutWheel))
+#endif
+    {
+        /* stop the timer until one new transfer is armed */
+        ehciInstance->ehciIpBase->GPTIMER0CTL &= ~USBHS_GPTIMER0CTL_RUN_MASK;
+    }
+    USB_HostEhciUnlock();
 #endif
+}
+#else
+static void USB_HostEhciTimer0(usb_host_ehci_instance_t *ehciInstance)
+{
+    volatile usb_host_ehci_qh_t *vltQhPointer;
+    usb_host_ehci_qtd_t *vltQtdPointer;
+    usb_host_transfer_t *transfer;
+    uint32_t backValue;
     volatile uint32_t *totalBytesAddress  = NULL;
     usb_host_ehci_pipe_t *ehciPipePointer = ehciInstance->ehciRunningPipeList;
     void *temp;
@@ -4257,15 +5270,19 @@ static void USB_HostEhciTimer0(usb_host_ehci_instance_t *ehciInstance)
                         backValue =
                             (((*totalBytesAddress) & EHCI_HOST_QTD_TOTAL_BYTES_MASK) >>
                              EHCI_HOST_QTD_TOTAL_BYTES_SHIFT);       /* backValue is used for total bytes to transfer */
-                        if (vltQhPointer->timeOutLabel != backValue) /* use total bytes to reflect the time out */
+                        if ((vltQhPointer->timeOutValue == 0U) ||
+                            ((transfer->timeout == 0U) &&
+                             (vltQhPointer->timeOutLabel != backValue))) /* use total bytes to reflect the time out */
                         {
-                            vltQhPointer->timeOutValue = USB_HOST_EHCI_CONTROL_BULK_TIME_OUT_VALUE;
+                            /* the transfer starts, or it makes progress without its own timeout */
+                            vltQhPointer->timeOutValue = USB_HOST_EHCI_CONTROL_BULK_TIME_OUT_VALUE(
+                                transfer, ehciPipePointer->pipeCommon.pipeType);
                             vltQhPointer->timeOutLabel = (uint16_t)backValue;
                         }
                         else
                         {
-                            /* time out when the total bytes don't change for the duration
-                             * USB_HOST_EHCI_CONTROL_BULK_TIME_OUT_VALUE
+                            /* time out when the transfer isn't done in its own timeout, or the total bytes don't
+                             * change for the default timeout
                              */
                             (vltQhPointer->timeOutValue)--;
                             if (vltQhPointer->timeOutValue == 0U)
@@ -4273,8 +5290,9 @@ static void USB_HostEhciTimer0(usb_host_ehci_instance_t *ehciInstance)
                                 USB_HostEhciLock();
                                 /* stop the qh schedule */
                                 USB_HostEhciStopAsync(ehciInstance);
-                                if (backValue != (((*totalBytesAddress) & EHCI_HOST_QTD_TOTAL_BYTES_MASK) >>
-                                                  EHCI_HOST_QTD_TOTAL_BYTES_SHIFT))
+                                if ((transfer->timeout == 0U) &&
+                                    (backValue != (((*totalBytesAddress) & EHCI_HOST_QTD_TOTAL_BYTES_MASK) >>
+                                                   EHCI_HOST_QTD_TOTAL_BYTES_SHIFT)))
                                 {
                                     USB_HostEhciStartAsync(ehciInstance);
                                 }
@@ -4293,46 +5311,7 @@ static void USB_HostEhciTimer0(usb_host_ehci_instance_t *ehciInstance)
 
                     if (timeoutLabel == 1U)
                     {
-                        /* remove qtd from qh */
-                        temp = (void *)vltQhPointer->ehciTransferTail;
-                        while ((vltQtdPointer != NULL) &&
-                               (0U == (vltQtdPointer->transferResults[0] & EHCI_HOST_QTD_IOC_MASK)) &&
-                               (vltQtdPointer != (usb_host_ehci_qtd_t *)temp))
-                        {
-#if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
-                            vltQtdPointer =
-                                (usb_host_ehci_qtd_t *)USB_HOST_MEMORY_DMA_2_CPU(vltQtdPointer->nextQtdPointer);
-#else
-                            vltQtdPointer = (usb_host_ehci_qtd_t *)vltQtdPointer->nextQtdPointer;
-#endif
-                        }
-#if (defined(FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET) && (FSL_FEATURE_MEMORY_HAS_ADDRESS_OFFSET > 0U))
-                        convert_addr = (uint32_t)USB_HOST_MEMORY_DMA_2_CPU(vltQtdPointer->nextQtdPointer);
-                        if ((vltQtdPointer != NULL) && (0U == (convert_addr & EHCI_HOST_T_INVALID_VALUE)))
-                        {
-                            vltQhPointer->nextQtdPointer = convert_addr; /* start qh if there are other qtd that don't
-                                                                            belong to the transfer */
-                        }
-#else
-                        if ((vltQtdPointer != NULL) &&
-                            (0U == (vltQtdPointer->nextQtdPointer & EHCI_HOST_T_INVALID_VALUE)))
-                        {
-                            vltQhPointer->nextQtdPointer =
-                                vltQtdPointer->nextQtdPointer; /* start qh if there are other qtd that don't belong to
-                                                                  the transfer */
-                        }
-#endif
-                        transfer->transferSofar =
-                            USB_HostEhciQtdListRelease(ehciInstance, (usb_host_ehci_qtd_t *)(transfer->union1.unitHead),
-                                                       (usb_host_ehci_qtd_t *)(transfer->union2.unitTail));
-                        transfer->transferSofar = (transfer->transferLength < transfer->transferSofar) ?
-                                                      0U :
-                                                      (transfer->transferLength - transfer->transferSofar);
-
-                        vltQhPointer->ehciTransferHead = transfer->next;
-                        vltQhPointer->timeOutValue     = USB_HOST_EHCI_CONTROL_BULK_TIME_OUT_VALUE;
-                        /* callback function is different from the current condition */
-                        transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferFailed);
+                        USB_HostEhciTimeoutRelease(ehciInstance, vltQhPointer, vltQtdPointer, transfer);
                     }
                 }
                 break;
@@ -4344,6 +5323,7 @@ static void USB_HostEhciTimer0(usb_host_ehci_instance_t *ehciInstance)
         ehciPipePointer = (usb_host_ehci_pipe_t *)temp;
     }
 }
+#endif
 
 #if ((defined(USB_HOST_CONFIG_LOW_POWER_MODE)) && (USB_HOST_CONFIG_LOW_POWER_MODE > 0U))
 static void USB_HostEhciTimer1(usb_host_ehci_instance_t *ehciInstance)
@@ -4485,6 +5465,15 @@ usb_status_t USB_HostEhciCreate(uint8_t controllerId,
 
 #endif
 
+#endif
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+    USB_HostTimeoutWheelInit(&ehciInstance->timeoutWheel);
+#endif
+#if (USB_HOST_EHCI_ISR_PIPE_LIST > 0U)
+    ehciInstance->ehciIsrPipeList = NULL;
+#endif
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+    USB_HostEventRingInit(&ehciInstance->eventRing);
 #endif
 
     if ((USB_HostEhciResetIP(ehciInstance) != kStatus_USB_Success) ||
@@ -4814,7 +5803,11 @@ usb_status_t USB_HostEhciOpenPipe(usb_host_controller_handle controllerHandle,
     temp                              = (void *)ehciInstance->ehciRunningPipeList;
     ehciPipePointer->pipeCommon.next  = (usb_host_pipe_t *)temp;
     ehciInstance->ehciRunningPipeList = ehciPipePointer;
+    ehciPipePointer->pipeCommon.open  = 1U;
     USB_HostEhciUnlock();
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+    USB_HostEhciIsrPipeAttach(ehciInstance, ehciPipePointer); /* the ISR pushes the done records of the pipe */
+#endif
 
     *pipeHandle = ehciPipePointer;
     return status;
@@ -4828,6 +5821,13 @@ usb_status_t USB_HostEhciClosePipe(usb_host_controller_handle controllerHandle,
     void *temp;
     void *tempCurrent;
 
+    ehciPipePointer->pipeCommon.open = 0U; /* the task drops the pending done records of the pipe */
+#if (USB_HOST_EHCI_ISR_PIPE_LIST > 0U)
+    USB_HostEhciIsrPipeDetach(ehciInstance, ehciPipePointer);
+#endif
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    ehciPipePointer->isrCompletion = 0U;
+#endif
     switch (ehciPipePointer->pipeCommon.pipeType)
     {
         case USB_ENDPOINT_BULK:
@@ -5011,6 +6011,24 @@ usb_status_t USB_HostEhciIoctl(usb_host_controller_handle controllerHandle, uint
         case kUSB_HostTestModeInit: /* test mode control */
             USB_HostEhciTestModeInit((usb_host_device_instance_t *)ioctlParam);
             break;
+#endif
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+        case kUSB_HostSetPipeIsrCompletion:
+            ehciPipePointer = (usb_host_ehci_pipe_t *)ioctlParam;
+            /* only the interrupt pipe is supported, the others are completed in the task */
+            if ((ehciPipePointer != NULL) && (ehciPipePointer->pipeCommon.pipeType == USB_ENDPOINT_INTERRUPT) &&
+                (0U == ehciPipePointer->isrCompletion))
+            {
+                /* the pipe is on the ISR pipe list already when the event ring is enabled */
+                USB_HostEhciIsrPipeDetach(ehciInstance, ehciPipePointer);
+                ehciPipePointer->isrCompletion = 1U;
+                USB_HostEhciIsrPipeAttach(ehciInstance, ehciPipePointer);
+            }
+            else
+            {
+                status = kStatus_USB_NotSupported;
+            }
+            break;
 #endif
         default:
             status = kStatus_USB_NotSupported;
@@ -5042,6 +6060,15 @@ void USB_HostEhciTaskFunction(void *hostHandle)
         if (0U != (bitSet & EHCI_TASK_EVENT_TIMER0)) /* timer0 */
         {
             USB_HostEhciTimer0(ehciInstance);
+#if ((defined USB_HOST_CONFIG_HUB) && (USB_HOST_CONFIG_HUB) && (defined(USB_HOST_CONFIG_HUB_ENGINE)) && \
+     (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+            /* the HUB ports whose debounce time expires are checked */
+            USB_HostHubEngineTimer(ehciInstance->hostHandle);
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+            /* sample the frame number for the transfer latency of the metrics */
+            USB_HostMetricsTimer(ehciInstance->hostHandle);
+#endif
         }
 
 #if ((defined(USB_HOST_CONFIG_LOW_POWER_MODE)) && (USB_HOST_CONFIG_LOW_POWER_MODE > 0U))
@@ -5055,7 +6082,11 @@ void USB_HostEhciTaskFunction(void *hostHandle)
         {
             if (0U != (bitSet & EHCI_TASK_EVENT_TRANSACTION_DONE)) /* transaction done */
             {
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+                USB_HostEhciEventRingDone(ehciInstance); /* only the pipes of the done records are processed */
+#else
                 USB_HostEhciTransactionDone(ehciInstance);
+#endif
             }
 
             if (0U != (bitSet & EHCI_TASK_EVENT_DEVICE_DETACH)) /* device detach */
@@ -5191,6 +6222,9 @@ void USB_HostEhciIsrFunction(void *hostHandle)
         if ((0U != (interruptStatus & USBHS_USBSTS_UI_MASK)) ||
             (0U != (interruptStatus & USBHS_USBSTS_UEI_MASK))) /* USB interrupt or USB error interrupt */
         {
+#if (USB_HOST_EHCI_ISR_PIPE_LIST > 0U)
+            USB_HostEhciIsrTransactionDone(ehciInstance);
+#endif
             (void)OSA_EventSet(ehciInstance->taskEventHandle, EHCI_TASK_EVENT_TRANSACTION_DONE);
         }
 
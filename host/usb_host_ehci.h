@@ -65,6 +65,8 @@
 #define EHCI_HOST_QTD_STATUS_STALL_ERROR_MASK (0x00000040U)
 
 #define EHCI_HOST_ITD_STATUS_ACTIVE_MASK       (0x80000000U)
+#define EHCI_HOST_ITD_STATUS_ERROR_MASK        (0x70000000U)
+#define EHCI_HOST_ITD_STATUS_BABBLE_MASK       (0x20000000U)
 #define EHCI_HOST_ITD_TRANSACTION_LEN_SHIFT    (16U)
 #define EHCI_HOST_ITD_TRANSACTION_LEN_MASK     (0x0FFF0000U)
 #define EHCI_HOST_ITD_IOC_SHIFT                (15U)
@@ -79,6 +81,8 @@
 #define EHCI_HOST_ITD_DIRECTION_SHIFT          (11U)
 
 #define EHCI_HOST_SITD_STATUS_ACTIVE_MASK   (0x00000080U)
+#define EHCI_HOST_SITD_STATUS_ERROR_MASK    (0x0000007CU)
+#define EHCI_HOST_SITD_STATUS_BABBLE_MASK   (0x00000010U)
 #define EHCI_HOST_SITD_DIRECTION_SHIFT      (31U)
 #define EHCI_HOST_SITD_PORT_NUMBER_SHIFT    (24U)
 #define EHCI_HOST_SITD_HUB_ADDR_SHIFT       (16U)
@@ -107,6 +111,23 @@
 #define USB_HostEhciLock()   (void)OSA_MutexLock(ehciInstance->ehciMutex, USB_OSA_WAIT_TIMEOUT)
 #define USB_HostEhciUnlock() (void)OSA_MutexUnlock(ehciInstance->ehciMutex)
 
+/* the ISR checks the pipes on the ISR pipe list, for the event records and for the ISR completion */
+#if (((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U)) || \
+     ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U)))
+#define USB_HOST_EHCI_ISR_PIPE_LIST (1U)
+#else
+#define USB_HOST_EHCI_ISR_PIPE_LIST (0U)
+#endif
+
+/* the idle qtd list and the QH transfer list are accessed by the ISR completion, protect them by critical section */
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+#define USB_HostEhciQtdLock()   OSA_ENTER_CRITICAL()
+#define USB_HostEhciQtdUnlock() OSA_EXIT_CRITICAL()
+#else
+#define USB_HostEhciQtdLock()   USB_HostEhciLock()
+#define USB_HostEhciQtdUnlock() USB_HostEhciUnlock()
+#endif
+
 /*******************************************************************************
  * KHCI driver public structures, enumerations, macros, functions
  ******************************************************************************/
@@ -150,8 +171,10 @@
  *           If not, the new ITD inserting micro-frame = the current micro-frame value + this MACRO value.
  */
 #define USB_HOST_EHCI_ISO_BOUNCE_UFRAME_NUMBER (16U)
-/*! @brief Control or bulk transaction timeout value (unit: 100 ms) */
-#define USB_HOST_EHCI_CONTROL_BULK_TIME_OUT_VALUE (50U)
+/*! @brief Control or bulk transaction timeout value (unit: 100 ms), it is loaded when the transfer becomes the first
+ * one of the QH */
+#define USB_HOST_EHCI_CONTROL_BULK_TIME_OUT_VALUE(transfer, pipeType) \
+    ((uint16_t)MIN((USB_HostTransferTimeout((transfer), (pipeType)) + 99U) / 100U, 0xFFFFU))
 
 #if ((defined(USB_HOST_CONFIG_LOW_POWER_MODE)) && (USB_HOST_CONFIG_LOW_POWER_MODE > 0U))
 typedef enum _bus_ehci_suspend_request_state
@@ -212,6 +235,15 @@ typedef struct _usb_host_ehci_pipe
                                      - When host works as HS:
                                          - For FS/LS device, it's the interrupt or ISO transfer complete-split mask.
                                  */
+#if (USB_HOST_EHCI_ISR_PIPE_LIST > 0U)
+    struct _usb_host_ehci_pipe *isrNext; /*!< Next pipe in the ISR pipe list*/
+#endif
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    uint8_t isrCompletion; /*!< 1 - the pipe's transfers are completed in the ISR*/
+#endif
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+    volatile uint8_t eventPending; /*!< 1 - the pipe's done record is in the event ring*/
+#endif
 } usb_host_ehci_pipe_t;
 
 /*! @brief EHCI QH structure. See the USB EHCI specification */
@@ -230,9 +262,12 @@ typedef struct _usb_host_ehci_qh
     usb_host_ehci_pipe_t *ehciPipePointer; /*!< EHCI pipe pointer */
     usb_host_transfer_t *ehciTransferHead; /*!< Transfer list head on this QH */
     usb_host_transfer_t *ehciTransferTail; /*!< Transfer list tail on this QH */
-    uint16_t timeOutValue; /*!< Its maximum value is USB_HOST_EHCI_CONTROL_BULK_TIME_OUT_VALUE. When the value is
-                                zero, the transfer times out. */
+    uint16_t timeOutValue; /*!< It is loaded by USB_HOST_EHCI_CONTROL_BULK_TIME_OUT_VALUE when the value is zero,
+                                the transfer times out when it decreases to zero. */
     uint16_t timeOutLabel; /*!< It's used to judge the transfer timeout. The EHCI driver maintain the value */
+#if (defined(__LP64__))
+    uint32_t reserved[4]; /*!< Reserved fields for 32 bytes align when the pointers are 64 bits (EHCI model) */
+#endif
 } usb_host_ehci_qh_t;
 
 /*! @brief EHCI QTD structure. See the USB EHCI specification. */
@@ -254,7 +289,8 @@ typedef struct _usb_host_ehci_itd
     /* add space */
     struct _usb_host_ehci_itd *nextItdPointer; /*!< Next ITD pointer */
     uint32_t frameEntryIndex;                  /*!< The ITD inserted frame value */
-    uint32_t reserved[6];                      /*!< Reserved fields for 32 bytes align */
+    uint32_t transactionMask;                  /*!< The initialized transactions, bit n is transactions[n] */
+    uint32_t reserved[5];                      /*!< Reserved fields for 32 bytes align */
 } usb_host_ehci_itd_t;
 
 /*! @brief EHCI SITD structure. See the USB EHCI specification. */
@@ -307,6 +343,16 @@ typedef struct _usb_host_ehci_instance
     uint32_t mutexBuffer[(OSA_MUTEX_HANDLE_SIZE + 3) / 4];           /*!< The mutex buffer. */
     osa_event_handle_t taskEventHandle;                              /*!< EHCI task event*/
     uint32_t taskEventHandleBuffer[(OSA_EVENT_HANDLE_SIZE + 3) / 4]; /*!< EHCI task event handle buffer*/
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+    usb_host_timeout_wheel_t timeoutWheel; /*!< Control/bulk transfer timeout wheel*/
+    uint32_t timeoutWheelFrame;            /*!< FRINDEX value of the last processed wheel tick*/
+#endif
+#if (USB_HOST_EHCI_ISR_PIPE_LIST > 0U)
+    usb_host_ehci_pipe_t *ehciIsrPipeList; /*!< The pipes that the ISR checks for the done transfers*/
+#endif
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+    usb_host_event_ring_t eventRing; /*!< The done records from the ISR to the task*/
+#endif
 #if ((defined(USB_HOST_CONFIG_LOW_POWER_MODE)) && (USB_HOST_CONFIG_LOW_POWER_MODE > 0U))
     uint64_t matchTick;
 #if ((defined FSL_FEATURE_SOC_USBPHY_COUNT) && (FSL_FEATURE_SOC_USBPHY_COUNT > 0U))
@@ -13,7 +13,7 @@
 #include "usb_host_devices.h"
 #include "fsl_device_registers.h"
 #if ((defined USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE) && (USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE))
-#include "fsl_cache.h"
+#include "usb_cache.h"
 #endif
 
 /*******************************************************************************
@@ -40,6 +40,28 @@
 #include "usb_host_hub_app.h"
 #endif
 
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+/*!
+ * @brief record the transfer submitting time.
+ *
+ * @param hostInstance  host instance pointer.
+ * @param transfer      the submitted transfer.
+ */
+static void USB_HostMetricsTransferStart(usb_host_instance_t *hostInstance, usb_host_transfer_t *transfer);
+#endif
+
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+/*!
+ * @brief check the ISO packet descriptors and clear the packet results.
+ *
+ * @param pipeHandle    the pipe handle.
+ * @param transfer      the submitted transfer.
+ *
+ * @return kStatus_USB_Success or kStatus_USB_InvalidParameter.
+ */
+static usb_status_t USB_HostIsoPacketDescriptorInit(usb_host_pipe_handle pipeHandle, usb_host_transfer_t *transfer);
+#endif
+
 /*!
  * @brief get the idle host instance.
  *
@@ -85,6 +107,14 @@ static const usb_host_controller_interface_t s_KhciInterface = {
 };
 #endif /* USB_HOST_CONFIG_KHCI */
 
+#if ((defined USB_HOST_CONFIG_LOOPBACK) && (USB_HOST_CONFIG_LOOPBACK > 0U))
+#include "usb_host_loopback.h"
+static const usb_host_controller_interface_t s_LoopbackInterface = {
+    USB_HostLoopbackCreate,    USB_HostLoopbackDestory,  USB_HostLoopbackOpenPipe, USB_HostLoopbackClosePipe,
+    USB_HostLoopbackWritePipe, USB_HostLoopbackReadPipe, USB_HostLoopbackIoctl,
+};
+#endif /* USB_HOST_CONFIG_LOOPBACK */
+
 #if ((defined USB_HOST_CONFIG_OHCI) && (USB_HOST_CONFIG_OHCI > 0U))
 #include "usb_host_ohci.h"
 static const usb_host_controller_interface_t s_OhciInterface = {
@@ -232,6 +262,13 @@ static void USB_HostGetControllerInterface(uint8_t controllerId,
         *controllerTable = &s_Ip3516HsInterface;
     }
 #endif /* USB_HOST_CONFIG_IP3516HS */
+
+#if ((defined USB_HOST_CONFIG_LOOPBACK) && (USB_HOST_CONFIG_LOOPBACK > 0U))
+    if ((controllerId == (uint8_t)kUSB_ControllerLoopback0) || (controllerId == (uint8_t)kUSB_ControllerLoopback1))
+    {
+        *controllerTable = &s_LoopbackInterface;
+    }
+#endif /* USB_HOST_CONFIG_LOOPBACK */
 }
 
 usb_status_t USB_HostInit(uint8_t controllerId, usb_host_handle *hostHandle, host_callback_t callbackFn)
@@ -354,14 +391,42 @@ usb_status_t USB_HostOpenPipe(usb_host_handle hostHandle,
 {
     usb_status_t status               = kStatus_USB_Success;
     usb_host_instance_t *hostInstance = (usb_host_instance_t *)hostHandle;
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    usb_host_pipe_init_t isrPipeInit;
+    uint8_t isrCompletion = 0U;
+#endif
 
     if ((hostHandle == NULL) || (pipeInit == NULL))
     {
         return kStatus_USB_InvalidHandle;
     }
 
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    if (0U != (pipeInit->pipeType & USB_HOST_PIPE_COMPLETION_ISR))
+    {
+        /* the controller open pipe interface gets the plain endpoint type */
+        isrPipeInit = *pipeInit;
+        isrPipeInit.pipeType &= (uint8_t)(~USB_HOST_PIPE_COMPLETION_ISR);
+        pipeInit      = &isrPipeInit;
+        isrCompletion = 1U;
+    }
+#endif
     /* call controller open pipe interface, the callbackFn is initialized in USB_HostGetControllerInterface */
     status = hostInstance->controllerTable->controllerOpenPipe(hostInstance->controllerHandle, pipeHandle, pipeInit);
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    if ((status == kStatus_USB_Success) && (0U != isrCompletion))
+    {
+        /* the controller that doesn't support it completes the transfers in the task */
+        (void)hostInstance->controllerTable->controllerIoctl(hostInstance->controllerHandle,
+                                                             (uint32_t)kUSB_HostSetPipeIsrCompletion, *pipeHandle);
+    }
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    if (status == kStatus_USB_Success)
+    {
+        USB_HostMetricsReset(&((usb_host_pipe_t *)(*pipeHandle))->metrics);
+    }
+#endif
 
     return status;
 }
@@ -395,6 +460,12 @@ usb_status_t USB_HostSend(usb_host_handle hostHandle, usb_host_pipe_handle pipeH
     /* initialize transfer */
     transfer->transferSofar = 0;
     transfer->direction     = USB_OUT;
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    if (kStatus_USB_Success != USB_HostIsoPacketDescriptorInit(pipeHandle, transfer))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+#endif
 
     (void)USB_HostLock(); /* This api can be called by host task and app task */
 /* keep this code: in normal situation application will guarantee the device is attached when call send/receive function
@@ -408,10 +479,10 @@ usb_status_t USB_HostSend(usb_host_handle hostHandle, usb_host_pipe_handle pipeH
 #endif
 /* call controller write pipe interface */
 #if ((defined USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE) && (USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE))
-    if (transfer->transferLength > 0)
-    {
-        DCACHE_CleanByRange((uint32_t)transfer->transferBuffer, transfer->transferLength);
-    }
+    USB_CacheMaintain(transfer->transferBuffer, transfer->transferLength, kUSB_CacheClean);
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    USB_HostMetricsTransferStart(hostInstance, transfer);
 #endif
     /* the callbackFn is initialized in USB_HostGetControllerInterface */
     status = hostInstance->controllerTable->controllerWritePipe(hostInstance->controllerHandle, pipeHandle, transfer);
@@ -457,11 +528,21 @@ usb_status_t USB_HostSendSetup(usb_host_handle hostHandle,
 #endif
 /* call controller write pipe interface */
 #if ((defined USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE) && (USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE))
-    DCACHE_CleanByRange((uint32_t)&transfer->setupPacket->bmRequestType, sizeof(usb_setup_struct_t));
-    if (transfer->transferLength > 0)
     {
-        DCACHE_CleanInvalidateByRange((uint32_t)transfer->transferBuffer, transfer->transferLength);
+        /* The setup packet and the data buffer are maintained as one list, they are often in the same lines */
+        usb_cache_range_t ranges[2];
+        ranges[0].buffer    = (void *)transfer->setupPacket;
+        ranges[0].length    = sizeof(usb_setup_struct_t);
+        ranges[0].operation = (uint8_t)kUSB_CacheClean;
+        ranges[1].buffer    = (void *)transfer->transferBuffer;
+        ranges[1].length    = transfer->transferLength;
+        ranges[1].operation =
+            (USB_IN == transfer->direction) ? (uint8_t)kUSB_CacheCleanInvalidate : (uint8_t)kUSB_CacheClean;
+        USB_CacheMaintainList(&ranges[0], 2U);
     }
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    USB_HostMetricsTransferStart(hostInstance, transfer);
 #endif
     /* the callbackFn is initialized in USB_HostGetControllerInterface */
     status = hostInstance->controllerTable->controllerWritePipe(hostInstance->controllerHandle, pipeHandle, transfer);
@@ -483,6 +564,12 @@ usb_status_t USB_HostRecv(usb_host_handle hostHandle, usb_host_pipe_handle pipeH
     /* initialize transfer */
     transfer->transferSofar = 0;
     transfer->direction     = USB_IN;
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    if (kStatus_USB_Success != USB_HostIsoPacketDescriptorInit(pipeHandle, transfer))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+#endif
 
     (void)USB_HostLock(); /* This API can be called by host task and application task */
 /* keep this code: in normal situation application will guarantee the device is attached when call send/receive function
@@ -496,10 +583,10 @@ usb_status_t USB_HostRecv(usb_host_handle hostHandle, usb_host_pipe_handle pipeH
 #endif
 
 #if ((defined USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE) && (USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE))
-    if (transfer->transferLength > 0)
-    {
-        DCACHE_CleanInvalidateByRange((uint32_t)transfer->transferBuffer, transfer->transferLength);
-    }
+    USB_CacheMaintain(transfer->transferBuffer, transfer->transferLength, kUSB_CacheCleanInvalidate);
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    USB_HostMetricsTransferStart(hostInstance, transfer);
 #endif
     /* the callbackFn is initialized in USB_HostGetControllerInterface */
     status = hostInstance->controllerTable->controllerReadPipe(hostInstance->controllerHandle, pipeHandle, transfer);
@@ -549,6 +636,15 @@ usb_status_t USB_HostMallocTransfer(usb_host_handle hostHandle, usb_host_transfe
     {
         *transfer                  = hostInstance->transferHead;
         hostInstance->transferHead = hostInstance->transferHead->next;
+        (*transfer)->timeout       = 0U;
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+        (*transfer)->timeoutNext = NULL;
+        (*transfer)->timeoutPrev = NULL;
+#endif
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+        (*transfer)->isoPacketDescriptor = NULL;
+        (*transfer)->isoPacketCount      = 0U;
+#endif
         (void)USB_HostUnlock();
         return kStatus_USB_Success;
     }
@@ -679,54 +775,87 @@ usb_status_t USB_HostHelperGetPeripheralInformation(usb_device_handle deviceHand
     return kStatus_USB_Success;
 }
 
-usb_status_t USB_HostHelperParseAlternateSetting(usb_host_interface_handle interfaceHandle,
-                                                 uint8_t alternateSetting,
-                                                 usb_host_interface_t *interface)
+usb_status_t USB_HostHelperGetAlternateSettingDescriptor(usb_host_interface_handle interfaceHandle,
+                                                         uint8_t alternateSetting,
+                                                         usb_descriptor_interface_t **interfaceDesc)
 {
+    usb_host_interface_t *interfaceInstance = (usb_host_interface_t *)interfaceHandle;
     uint32_t endPosition;
     usb_descriptor_union_t *unionDes;
-    usb_host_ep_t *epParse;
     void *temp;
+
     if (interfaceHandle == NULL)
     {
         return kStatus_USB_InvalidHandle;
     }
 
-    if (alternateSetting == 0U)
+    if (alternateSetting == interfaceInstance->interfaceDesc->bAlternateSetting)
     {
-        return kStatus_USB_InvalidParameter;
+        *interfaceDesc = interfaceInstance->interfaceDesc;
+        return kStatus_USB_Success;
     }
 
-    /* parse configuration descriptor */
-    temp = (void *)((usb_host_interface_t *)interfaceHandle)->interfaceExtension;
-    unionDes = (usb_descriptor_union_t *)temp; /* interface extend descriptor start */
-    endPosition =
-        (uint32_t)unionDes +
-        ((usb_host_interface_t *)interfaceHandle)->interfaceExtensionLength; /* interface extend descriptor end */
+#if ((defined(USB_HOST_CONFIG_DESCRIPTOR_CACHE)) && (USB_HOST_CONFIG_DESCRIPTOR_CACHE > 0U))
+    /* all the alternate settings that are less than the max value are indexed */
+    if (alternateSetting < USB_HOST_CONFIG_INTERFACE_MAX_ALTSETTING)
+    {
+        *interfaceDesc = interfaceInstance->altSettingDesc[alternateSetting];
+        return (*interfaceDesc != NULL) ? kStatus_USB_Success : kStatus_USB_Error;
+    }
+#endif
 
     /* search for the alternate setting interface descriptor */
+    temp        = (void *)interfaceInstance->interfaceExtension;
+    unionDes    = (usb_descriptor_union_t *)temp; /* interface extend descriptor start */
+    endPosition = (uint32_t)unionDes + interfaceInstance->interfaceExtensionLength; /* interface extend descriptor end */
     while ((uint32_t)unionDes < endPosition)
     {
-        if (unionDes->interface.bDescriptorType == USB_DESCRIPTOR_TYPE_INTERFACE)
+        if ((unionDes->interface.bDescriptorType == USB_DESCRIPTOR_TYPE_INTERFACE) &&
+            (unionDes->interface.bAlternateSetting == alternateSetting))
         {
-            if (unionDes->interface.bAlternateSetting == alternateSetting)
-            {
-                break;
-            }
-            else
-            {
-                unionDes = (usb_descriptor_union_t *)((uint32_t)unionDes + unionDes->common.bLength);
-            }
+            *interfaceDesc = &unionDes->interface;
+            return kStatus_USB_Success;
         }
-        else
+        if (unionDes->common.bLength == 0x00U) /* the descriptor data is wrong */
         {
-            unionDes = (usb_descriptor_union_t *)((uint32_t)unionDes + unionDes->common.bLength);
+            break;
         }
+        unionDes = (usb_descriptor_union_t *)((uint32_t)unionDes + unionDes->common.bLength);
     }
-    if ((uint32_t)unionDes >= endPosition)
+
+    return kStatus_USB_Error;
+}
+
+usb_status_t USB_HostHelperParseAlternateSetting(usb_host_interface_handle interfaceHandle,
+                                                 uint8_t alternateSetting,
+                                                 usb_host_interface_t *interface)
+{
+    uint32_t endPosition;
+    usb_descriptor_union_t *unionDes;
+    usb_descriptor_interface_t *interfaceDesc;
+    usb_host_ep_t *epParse;
+    void *temp;
+    if (interfaceHandle == NULL)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+
+    if (alternateSetting == 0U)
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    /* get the alternate setting interface descriptor */
+    if (USB_HostHelperGetAlternateSettingDescriptor(interfaceHandle, alternateSetting, &interfaceDesc) !=
+        kStatus_USB_Success)
     {
         return kStatus_USB_Error;
     }
+    temp     = (void *)interfaceDesc;
+    unionDes = (usb_descriptor_union_t *)temp;
+    endPosition =
+        (uint32_t)((usb_host_interface_t *)interfaceHandle)->interfaceExtension +
+        ((usb_host_interface_t *)interfaceHandle)->interfaceExtensionLength; /* interface extend descriptor end */
 
     /* initialize interface handle structure instance */
     interface->interfaceDesc            = &unionDes->interface;
@@ -815,6 +944,430 @@ void USB_HostGetVersion(uint32_t *version)
     }
 }
 
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+void USB_HostTimeoutWheelInit(usb_host_timeout_wheel_t *wheel)
+{
+    uint32_t index;
+
+    for (index = 0U; index < USB_HOST_TIMEOUT_WHEEL_SLOTS; ++index)
+    {
+        wheel->slotList[index] = NULL;
+    }
+    wheel->currentTick   = 0U;
+    wheel->transferCount = 0U;
+}
+
+static void USB_HostTimeoutWheelUnlink(usb_host_timeout_wheel_t *wheel, usb_host_transfer_t *transfer)
+{
+    usb_host_transfer_t **slotHead = &wheel->slotList[transfer->timeoutDeadline & (USB_HOST_TIMEOUT_WHEEL_SLOTS - 1U)];
+
+    if (transfer->timeoutPrev != NULL)
+    {
+        transfer->timeoutPrev->timeoutNext = transfer->timeoutNext;
+    }
+    else
+    {
+        *slotHead = transfer->timeoutNext;
+    }
+    if (transfer->timeoutNext != NULL)
+    {
+        transfer->timeoutNext->timeoutPrev = transfer->timeoutPrev;
+    }
+    transfer->timeoutNext = NULL;
+    transfer->timeoutPrev = NULL;
+    wheel->transferCount--;
+}
+
+void USB_HostTimeoutWheelAdd(usb_host_timeout_wheel_t *wheel, usb_host_transfer_t *transfer, uint32_t timeout)
+{
+    usb_host_transfer_t **slotHead;
+    uint32_t ticks;
+
+    ticks = (timeout + USB_HOST_TIMEOUT_WHEEL_TICK_MS - 1U) / USB_HOST_TIMEOUT_WHEEL_TICK_MS;
+    if (ticks == 0U)
+    {
+        ticks = 1U;
+    }
+    transfer->timeoutDeadline = wheel->currentTick + ticks;
+
+    /* insert to the slot head */
+    slotHead              = &wheel->slotList[transfer->timeoutDeadline & (USB_HOST_TIMEOUT_WHEEL_SLOTS - 1U)];
+    transfer->timeoutPrev = NULL;
+    transfer->timeoutNext = *slotHead;
+    if (*slotHead != NULL)
+    {
+        (*slotHead)->timeoutPrev = transfer;
+    }
+    *slotHead = transfer;
+    wheel->transferCount++;
+}
+
+void USB_HostTimeoutWheelRemove(usb_host_timeout_wheel_t *wheel, usb_host_transfer_t *transfer)
+{
+    /* the transfer is armed when it has previous node or it is the slot head */
+    if ((transfer->timeoutPrev != NULL) ||
+        (wheel->slotList[transfer->timeoutDeadline & (USB_HOST_TIMEOUT_WHEEL_SLOTS - 1U)] == transfer))
+    {
+        USB_HostTimeoutWheelUnlink(wheel, transfer);
+    }
+}
+
+usb_host_transfer_t *USB_HostTimeoutWheelAdvance(usb_host_timeout_wheel_t *wheel, uint32_t ticks)
+{
+    usb_host_transfer_t *expiredList = NULL;
+    usb_host_transfer_t *transfer;
+    usb_host_transfer_t *nextTransfer;
+    uint32_t targetTick = wheel->currentTick + ticks;
+    uint32_t scanNumber;
+    uint32_t index;
+
+    /* every slot is scanned one time at most, the transfers of the later rounds stay in the slot */
+    scanNumber = (ticks > USB_HOST_TIMEOUT_WHEEL_SLOTS) ? USB_HOST_TIMEOUT_WHEEL_SLOTS : ticks;
+    for (index = 1U; (index <= scanNumber) && (wheel->transferCount != 0U); ++index)
+    {
+        transfer = wheel->slotList[(wheel->currentTick + index) & (USB_HOST_TIMEOUT_WHEEL_SLOTS - 1U)];
+        while (transfer != NULL)
+        {
+            nextTransfer = transfer->timeoutNext;
+            if ((int32_t)(transfer->timeoutDeadline - targetTick) <= 0)
+            {
+                USB_HostTimeoutWheelUnlink(wheel, transfer);
+                transfer->timeoutNext = expiredList;
+                expiredList           = transfer;
+            }
+            transfer = nextTransfer;
+        }
+    }
+    wheel->currentTick = targetTick;
+
+    return expiredList;
+}
+
+usb_host_transfer_t *USB_HostTimeoutWheelExpireAll(usb_host_timeout_wheel_t *wheel)
+{
+    usb_host_transfer_t *expiredList = NULL;
+    usb_host_transfer_t *transfer;
+    uint32_t index;
+
+    for (index = 0U; index < USB_HOST_TIMEOUT_WHEEL_SLOTS; ++index)
+    {
+        while (wheel->slotList[index] != NULL)
+        {
+            transfer = wheel->slotList[index];
+            USB_HostTimeoutWheelUnlink(wheel, transfer);
+            transfer->timeoutNext = expiredList;
+            expiredList           = transfer;
+        }
+    }
+
+    return expiredList;
+}
+#endif
+
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+static usb_status_t USB_HostIsoPacketDescriptorInit(usb_host_pipe_handle pipeHandle, usb_host_transfer_t *transfer)
+{
+    usb_host_pipe_t *pipe = (usb_host_pipe_t *)pipeHandle;
+    usb_host_iso_packet_descriptor_t *packet;
+    uint32_t packetSize;
+
+    transfer->isoPacketIndex = 0U;
+    if (NULL == transfer->isoPacketDescriptor)
+    {
+        return kStatus_USB_Success;
+    }
+    if ((USB_ENDPOINT_ISOCHRONOUS != pipe->pipeType) || (0U == transfer->isoPacketCount))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    /* one packet is the data of one service interval */
+    packetSize = (uint32_t)pipe->maxPacketSize * ((0U != pipe->numberPerUframe) ? pipe->numberPerUframe : 1U);
+    for (uint32_t index = 0U; index < transfer->isoPacketCount; index++)
+    {
+        packet = &transfer->isoPacketDescriptor[index];
+        if ((packet->length > packetSize) || (packet->offset > transfer->transferLength) ||
+            (packet->length > (transfer->transferLength - packet->offset)))
+        {
+            return kStatus_USB_InvalidParameter;
+        }
+        /* the controllers compute the buffer pages of the packets from the first one, so the offset can't go back */
+        if ((index > 0U) && (packet->offset < transfer->isoPacketDescriptor[index - 1U].offset))
+        {
+            return kStatus_USB_InvalidParameter;
+        }
+        packet->actualLength = 0U;
+        packet->status       = kStatus_USB_TransferCancel;
+    }
+    return kStatus_USB_Success;
+}
+
+void USB_HostIsoPacketDone(usb_host_transfer_t *transfer,
+                           uint32_t packetIndex,
+                           uint32_t actualLength,
+                           usb_status_t status)
+{
+    usb_host_iso_packet_descriptor_t *packet = &transfer->isoPacketDescriptor[packetIndex];
+
+    if (actualLength > packet->length)
+    {
+        actualLength = packet->length;
+    }
+    packet->actualLength = actualLength;
+    packet->status       = status;
+    transfer->transferSofar += actualLength;
+}
+#endif
+
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+/* The controllers report 11 bits frame number that wraps every 2048 ms. It is extended to 32 bits here when a
+ * transfer is submitted or completed and by USB_HostMetricsTimer. The controller drivers call USB_HostMetricsTimer
+ * from their periodic tick while a device is attached, so the frame is sampled well within 2048 ms on an idle bus
+ * too and the latency of the transfer that is pending longer than 2048 ms saturates into the last bucket.
+ */
+static uint32_t USB_HostMetricsGetFrame(usb_host_instance_t *hostInstance)
+{
+    uint32_t frame = 0U;
+    uint32_t extendedFrame;
+    OSA_SR_ALLOC();
+
+    /* the callbackFn is initialized in USB_HostGetControllerInterface */
+    (void)hostInstance->controllerTable->controllerIoctl(hostInstance->controllerHandle, kUSB_HostGetFrameNumber,
+                                                         &frame);
+#if ((defined USB_HOST_CONFIG_IP3516HS) && (USB_HOST_CONFIG_IP3516HS > 0U))
+    /* IP3516HS reports the micro frame number */
+    if ((hostInstance->controllerId == (uint8_t)kUSB_ControllerIp3516Hs0) ||
+        (hostInstance->controllerId == (uint8_t)kUSB_ControllerIp3516Hs1))
+    {
+        frame >>= 3U;
+    }
+#endif
+    /* 11 bits are reported by all controllers */
+    frame &= 0x7FFU;
+    OSA_ENTER_CRITICAL();
+    hostInstance->metricsFrame += (frame - (uint32_t)hostInstance->metricsRawFrame) & 0x7FFU;
+    hostInstance->metricsRawFrame = (uint16_t)frame;
+    extendedFrame                 = hostInstance->metricsFrame;
+    OSA_EXIT_CRITICAL();
+    return extendedFrame;
+}
+
+static void USB_HostMetricsTransferStart(usb_host_instance_t *hostInstance, usb_host_transfer_t *transfer)
+{
+    transfer->submitFrame = USB_HostMetricsGetFrame(hostInstance);
+}
+
+static void USB_HostMetricsUpdate(usb_host_metrics_t *metrics,
+                                  usb_host_transfer_t *transfer,
+                                  usb_status_t status,
+                                  uint32_t bucket)
+{
+    metrics->transfers++;
+    metrics->bytes += transfer->transferSofar;
+    metrics->latency[bucket]++;
+    if (status == kStatus_USB_Success)
+    {
+        if (transfer->transferSofar < transfer->transferLength)
+        {
+            metrics->shortPackets++;
+        }
+    }
+    else if (status == kStatus_USB_TransferStall)
+    {
+        metrics->stalls++;
+    }
+    else if (status != kStatus_USB_TransferCancel)
+    {
+        metrics->errors++;
+    }
+    else
+    {
+        /*no action*/
+    }
+}
+
+void USB_HostMetricsReset(usb_host_metrics_t *metrics)
+{
+    (void)memset(metrics, 0, sizeof(usb_host_metrics_t));
+}
+
+void USB_HostMetricsTransferDone(usb_host_handle hostHandle, usb_host_transfer_t *transfer, usb_status_t status)
+{
+    usb_host_pipe_t *pipe = transfer->transferPipe;
+    usb_host_device_instance_t *deviceInstance;
+    uint32_t latency;
+    uint32_t bucket = 0U;
+    OSA_SR_ALLOC();
+
+    if ((hostHandle == NULL) || (pipe == NULL))
+    {
+        return;
+    }
+    latency = USB_HostMetricsGetFrame((usb_host_instance_t *)hostHandle) - transfer->submitFrame;
+    /* bucket n counts the latency in [2^(n-1), 2^n) ms */
+    while ((latency != 0U) && (bucket < (USB_HOST_METRICS_LATENCY_BUCKETS - 1U)))
+    {
+        latency >>= 1U;
+        bucket++;
+    }
+
+    deviceInstance = (usb_host_device_instance_t *)pipe->deviceHandle;
+    OSA_ENTER_CRITICAL();
+    USB_HostMetricsUpdate(&pipe->metrics, transfer, status, bucket);
+    if (deviceInstance != NULL)
+    {
+        USB_HostMetricsUpdate(&deviceInstance->metrics, transfer, status, bucket);
+    }
+    OSA_EXIT_CRITICAL();
+}
+
+void USB_HostMetricsTimer(usb_host_handle hostHandle)
+{
+    if (hostHandle != NULL)
+    {
+        (void)USB_HostMetricsGetFrame((usb_host_instance_t *)hostHandle);
+    }
+}
+
+void USB_HostMetricsRecordEvent(usb_host_pipe_t *pipe, usb_host_metrics_event_t event)
+{
+    usb_host_device_instance_t *deviceInstance;
+    uint32_t *pipeCounter;
+    uint32_t *deviceCounter = NULL;
+    OSA_SR_ALLOC();
+
+    if (pipe == NULL)
+    {
+        return;
+    }
+    deviceInstance = (usb_host_device_instance_t *)pipe->deviceHandle;
+    switch (event)
+    {
+        case kUSB_HostMetricsNak:
+            pipeCounter = &pipe->metrics.naks;
+            if (deviceInstance != NULL)
+            {
+                deviceCounter = &deviceInstance->metrics.naks;
+            }
+            break;
+
+        case kUSB_HostMetricsTimeout:
+            pipeCounter = &pipe->metrics.timeouts;
+            if (deviceInstance != NULL)
+            {
+                deviceCounter = &deviceInstance->metrics.timeouts;
+            }
+            break;
+
+        default:
+            pipeCounter = &pipe->metrics.retries;
+            if (deviceInstance != NULL)
+            {
+                deviceCounter = &deviceInstance->metrics.retries;
+            }
+            break;
+    }
+
+    OSA_ENTER_CRITICAL();
+    (*pipeCounter)++;
+    if (deviceCounter != NULL)
+    {
+        (*deviceCounter)++;
+    }
+    OSA_EXIT_CRITICAL();
+}
+
+usb_status_t USB_HostGetPipeMetrics(usb_host_handle hostHandle,
+                                    usb_host_pipe_handle pipeHandle,
+                                    usb_host_metrics_t *metrics)
+{
+    OSA_SR_ALLOC();
+
+    if ((hostHandle == NULL) || (pipeHandle == NULL) || (metrics == NULL))
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+
+    OSA_ENTER_CRITICAL();
+    *metrics = ((usb_host_pipe_t *)pipeHandle)->metrics;
+    OSA_EXIT_CRITICAL();
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_HostGetDeviceMetrics(usb_device_handle deviceHandle, usb_host_metrics_t *metrics)
+{
+    OSA_SR_ALLOC();
+
+    if ((deviceHandle == NULL) || (metrics == NULL))
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+
+    OSA_ENTER_CRITICAL();
+    *metrics = ((usb_host_device_instance_t *)deviceHandle)->metrics;
+    OSA_EXIT_CRITICAL();
+    return kStatus_USB_Success;
+}
+#endif
+
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+void USB_HostEventRingInit(usb_host_event_ring_t *ring)
+{
+    ring->head     = 0U;
+    ring->tail     = 0U;
+    ring->overflow = 0U;
+}
+
+usb_status_t USB_HostEventRingPush(usb_host_event_ring_t *ring, usb_host_pipe_t *pipe, uint32_t status, uint16_t frame)
+{
+    usb_host_event_record_t *record;
+    uint32_t head = ring->head;
+
+    if ((head - ring->tail) >= USB_HOST_EVENT_RING_SIZE)
+    {
+        ring->overflow = 1U;
+        return kStatus_USB_Busy;
+    }
+    record         = &ring->recordList[head & (USB_HOST_EVENT_RING_SIZE - 1U)];
+    record->pipe   = pipe;
+    record->status = status;
+    record->frame  = frame;
+    __DSB(); /* make sure the record is written before it is published */
+    ring->head = head + 1U;
+    return kStatus_USB_Success;
+}
+
+uint32_t USB_HostEventRingDrain(usb_host_event_ring_t *ring,
+                                usb_host_event_record_t *recordList,
+                                uint32_t recordCount)
+{
+    uint32_t tail   = ring->tail;
+    uint32_t head   = ring->head;
+    uint32_t number = 0U;
+
+    while ((number < recordCount) && (tail != head))
+    {
+        recordList[number] = ring->recordList[tail & (USB_HOST_EVENT_RING_SIZE - 1U)];
+        number++;
+        tail++;
+    }
+    ring->tail = tail; /* the slots can be reused by the ISR now */
+    return number;
+}
+
+uint8_t USB_HostEventRingOverflow(usb_host_event_ring_t *ring)
+{
+    if (0U == ring->overflow)
+    {
+        return 0U;
+    }
+    /* clear the flag first, the record that is dropped after it sets the flag again */
+    ring->overflow = 0U;
+    ring->tail     = ring->head;
+    return 1U;
+}
+#endif
+
 #if ((defined(USB_HOST_CONFIG_LOW_POWER_MODE)) && (USB_HOST_CONFIG_LOW_POWER_MODE > 0U))
 /* Send BUS or specific device suspend request */
 usb_status_t USB_HostSuspendDeviceResquest(usb_host_handle hostHandle, usb_device_handle deviceHandle)
@@ -38,6 +38,9 @@ typedef enum _usb_host_controller_control
 #if ((defined USB_HOST_CONFIG_COMPLIANCE_TEST) && (USB_HOST_CONFIG_COMPLIANCE_TEST))
     kUSB_HostTestModeInit, /*!< intialize charger type */
 #endif
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    kUSB_HostSetPipeIsrCompletion, /*!< Complete the pipe's transfers in the ISR, the parameter is the pipe handle */
+#endif
 } usb_host_controller_control_t;
 
 /*! @brief USB host controller bus control code */
@@ -82,6 +85,227 @@ typedef struct _usb_host_controller_interface
 #if ((defined USB_HOST_CONFIG_COMPLIANCE_TEST) && (USB_HOST_CONFIG_COMPLIANCE_TEST))
 usb_status_t USB_HostTestModeInit(usb_device_handle deviceHandle);
 #endif
+
+/*! @brief Default control transfer timeout (unit: ms), used when usb_host_transfer_t::timeout is 0 */
+#ifndef USB_HOST_CONTROL_TRANSFER_TIMEOUT
+#define USB_HOST_CONTROL_TRANSFER_TIMEOUT (5000U)
+#endif
+/*! @brief Default bulk transfer timeout (unit: ms), used when usb_host_transfer_t::timeout is 0 */
+#ifndef USB_HOST_BULK_TRANSFER_TIMEOUT
+#define USB_HOST_BULK_TRANSFER_TIMEOUT (5000U)
+#endif
+
+/*! @brief The transfer's timeout (unit: ms), the control/bulk default is used when the transfer doesn't specify one */
+#define USB_HostTransferTimeout(transfer, pipeType)                                      \
+    (((transfer)->timeout != 0U) ? (transfer)->timeout :                                 \
+     (((pipeType) == USB_ENDPOINT_CONTROL) ? USB_HOST_CONTROL_TRANSFER_TIMEOUT : USB_HOST_BULK_TRANSFER_TIMEOUT))
+
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+/*! @brief Timeout wheel slot number, must be power of 2 */
+#ifndef USB_HOST_TIMEOUT_WHEEL_SLOTS
+#define USB_HOST_TIMEOUT_WHEEL_SLOTS (32U)
+#endif
+/*! @brief Timeout wheel tick period (unit: ms) */
+#ifndef USB_HOST_TIMEOUT_WHEEL_TICK_MS
+#define USB_HOST_TIMEOUT_WHEEL_TICK_MS (10U)
+#endif
+
+/*! @brief Hashed timing wheel used by the controller drivers to track control/bulk transfer timeout */
+typedef struct _usb_host_timeout_wheel
+{
+    usb_host_transfer_t *slotList[USB_HOST_TIMEOUT_WHEEL_SLOTS]; /*!< Transfer list of every slot*/
+    uint32_t currentTick;                                        /*!< The tick that has been processed*/
+    uint32_t transferCount;                                      /*!< Armed transfer number*/
+} usb_host_timeout_wheel_t;
+
+/*! @brief Whether no transfer is armed in the timeout wheel, the controller can stop its tick source */
+#define USB_HostTimeoutWheelIsIdle(wheel) (0U == (wheel)->transferCount)
+
+/*!
+ * @brief Initialize the timeout wheel.
+ *
+ * @param wheel  The timeout wheel.
+ */
+extern void USB_HostTimeoutWheelInit(usb_host_timeout_wheel_t *wheel);
+
+/*!
+ * @brief Arm the transfer in the timeout wheel.
+ *
+ * The caller must serialize the wheel operations with the controller lock.
+ *
+ * @param wheel     The timeout wheel.
+ * @param transfer  The transfer to arm.
+ * @param timeout   The timeout (unit: ms), it is rounded up to the wheel tick.
+ */
+extern void USB_HostTimeoutWheelAdd(usb_host_timeout_wheel_t *wheel, usb_host_transfer_t *transfer, uint32_t timeout);
+
+/*!
+ * @brief Remove the transfer from the timeout wheel.
+ *
+ * It is safe to call this function for one transfer that is not armed.
+ *
+ * @param wheel     The timeout wheel.
+ * @param transfer  The transfer to remove.
+ */
+extern void USB_HostTimeoutWheelRemove(usb_host_timeout_wheel_t *wheel, usb_host_transfer_t *transfer);
+
+/*!
+ * @brief Advance the timeout wheel.
+ *
+ * The expired transfers are removed from the wheel and returned as one list that is linked by
+ * usb_host_transfer_t::timeoutNext, so the caller can process them after releasing the controller lock and arm them
+ * again if needed.
+ *
+ * @param wheel     The timeout wheel.
+ * @param ticks     Elapsed tick number.
+ *
+ * @return The expired transfer list, NULL if no transfer expires.
+ */
+extern usb_host_transfer_t *USB_HostTimeoutWheelAdvance(usb_host_timeout_wheel_t *wheel, uint32_t ticks);
+
+/*!
+ * @brief Expire all armed transfers, for example when the device is detached.
+ *
+ * @param wheel     The timeout wheel.
+ *
+ * @return The expired transfer list that is linked by usb_host_transfer_t::timeoutNext.
+ */
+extern usb_host_transfer_t *USB_HostTimeoutWheelExpireAll(usb_host_timeout_wheel_t *wheel);
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+/*! @brief Host metrics events that are reported outside of the transfer completion */
+typedef enum _usb_host_metrics_event
+{
+    kUSB_HostMetricsNak = 0U, /*!< The transaction is NAKed and retried by the controller driver */
+    kUSB_HostMetricsTimeout,  /*!< The transfer is terminated by the controller timeout */
+    kUSB_HostMetricsRetry,    /*!< The transfer is retried */
+} usb_host_metrics_event_t;
+
+/*!
+ * @brief Clear the metrics.
+ *
+ * @param metrics  The metrics.
+ */
+extern void USB_HostMetricsReset(usb_host_metrics_t *metrics);
+
+/*!
+ * @brief Record the transfer completion, the controller drivers call it before the transfer callback.
+ *
+ * @param hostHandle  The host handle.
+ * @param transfer    The completed transfer.
+ * @param status      The transfer status that is passed to the transfer callback.
+ */
+extern void USB_HostMetricsTransferDone(usb_host_handle hostHandle, usb_host_transfer_t *transfer, usb_status_t status);
+
+/*!
+ * @brief Record one metrics event of the pipe.
+ *
+ * @param pipe   The pipe.
+ * @param event  The event, see #usb_host_metrics_event_t.
+ */
+extern void USB_HostMetricsRecordEvent(usb_host_pipe_t *pipe, usb_host_metrics_event_t event);
+
+/*!
+ * @brief Sample the controller frame number, the controller drivers call it from their periodic tick in the task.
+ *
+ * The 11 bits frame number wraps every 2048 ms, it is extended to 32 bits for the transfer latency. The periodic tick
+ * (the EHCI GPTIMER0, the OHCI and IP3516HS SOF, the KHCI SOF token) keeps the extension correct when no transfer
+ * completes for longer than the wrap period.
+ *
+ * @param hostHandle  The host handle.
+ */
+extern void USB_HostMetricsTimer(usb_host_handle hostHandle);
+#endif
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+/*!
+ * @brief Record the result of one ISO packet, the controller drivers call it before the transfer callback.
+ *
+ * The actual length is added to usb_host_transfer_t::transferSofar.
+ *
+ * @param transfer      The transfer that has the packet descriptors.
+ * @param packetIndex   The packet index.
+ * @param actualLength  The transferred packet length.
+ * @param status        The packet result.
+ */
+extern void USB_HostIsoPacketDone(usb_host_transfer_t *transfer,
+                                  uint32_t packetIndex,
+                                  uint32_t actualLength,
+                                  usb_status_t status);
+#endif
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+/*! @brief Event ring record number, must be power of 2 */
+#ifndef USB_HOST_EVENT_RING_SIZE
+#define USB_HOST_EVENT_RING_SIZE (16U)
+#endif
+/*! @brief Record number that the task drains at one time */
+#ifndef USB_HOST_EVENT_RING_BATCH
+#define USB_HOST_EVENT_RING_BATCH (4U)
+#endif
+
+/*! @brief Done record that is pushed by the controller ISR, one record is one pipe that has done transfers */
+typedef struct _usb_host_event_record
+{
+    usb_host_pipe_t *pipe; /*!< The pipe that has the done transfer*/
+    uint32_t status;       /*!< The controller status of the done transfer (EHCI qTD token, IP3516HS PTD DW3)*/
+    uint16_t frame;        /*!< The frame number when the ISR finds the done transfer*/
+} usb_host_event_record_t;
+
+/*! @brief Single producer (ISR) and single consumer (task) lock-free event ring */
+typedef struct _usb_host_event_ring
+{
+    usb_host_event_record_t recordList[USB_HOST_EVENT_RING_SIZE]; /*!< Done records*/
+    volatile uint32_t head;    /*!< The producer index, only the ISR writes it*/
+    volatile uint32_t tail;    /*!< The consumer index, only the task writes it*/
+    volatile uint8_t overflow; /*!< The ISR sets it when a record is dropped, the task clears it*/
+} usb_host_event_ring_t;
+
+/*!
+ * @brief Initialize the event ring.
+ *
+ * @param ring  The event ring.
+ */
+extern void USB_HostEventRingInit(usb_host_event_ring_t *ring);
+
+/*!
+ * @brief Push one done record, it is only called by the controller ISR.
+ *
+ * @param ring    The event ring.
+ * @param pipe    The pipe that has the done transfer.
+ * @param status  The controller status of the done transfer.
+ * @param frame   The frame number.
+ *
+ * @retval kStatus_USB_Success  The record is pushed.
+ * @retval kStatus_USB_Busy     The ring is full, the record is dropped and the overflow flag is set.
+ */
+extern usb_status_t USB_HostEventRingPush(usb_host_event_ring_t *ring,
+                                          usb_host_pipe_t *pipe,
+                                          uint32_t status,
+                                          uint16_t frame);
+
+/*!
+ * @brief Drain the done records, it is only called by the controller task.
+ *
+ * @param ring         The event ring.
+ * @param recordList   The buffer that receives the records.
+ * @param recordCount  The buffer's record number.
+ *
+ * @return The drained record number.
+ */
+extern uint32_t USB_HostEventRingDrain(usb_host_event_ring_t *ring,
+                                       usb_host_event_record_t *recordList,
+                                       uint32_t recordCount);
+
+/*!
+ * @brief Check and clear the overflow flag, it is only called by the controller task.
+ *
+ * The records that are in the ring are dropped when the flag is set, because the task checks all the pipes.
+ *
+ * @param ring  The event ring.
+ *
+ * @return 1 if records were dropped and the task must check all the pipes, otherwise 0.
+ */
+extern uint8_t USB_HostEventRingOverflow(usb_host_event_ring_t *ring);
+#endif
 /*! @}*/
 
 /*!
@@ -104,6 +328,10 @@ typedef struct _usb_host_instance
     void *suspendedDevice;    /*!< Suspended device handle*/
     volatile uint64_t hwTick; /*!< Current hw tick(ms)*/
     uint8_t sleepType;        /*!< L1 LPM device handle*/
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    uint32_t metricsFrame;    /*!< The 11 bits controller frame number extended to 32 bits, used by the metrics*/
+    uint16_t metricsRawFrame; /*!< The controller frame number when metricsFrame is updated*/
 #endif
     uint8_t addressBitMap[16]; /*!< Used for address allocation. The first bit is the address 1, second bit is the
                                   address 2*/
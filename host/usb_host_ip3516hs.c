@@ -12,6 +12,11 @@
 #include "usb_host_hci.h"
 #include "fsl_device_registers.h"
 #include "usb_host_ip3516hs.h"
+#if ((defined USB_HOST_CONFIG_HUB) && (USB_HOST_CONFIG_HUB) && (defined(USB_HOST_CONFIG_HUB_ENGINE)) && \
+     (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+#include "usb_host_hub.h"
+#include "usb_host_hub_app.h"
+#endif
 #include "usb_host_devices.h"
 #if ((defined FSL_FEATURE_SOC_USBPHY_COUNT) && (FSL_FEATURE_SOC_USBPHY_COUNT > 0U))
 #include "usb_phy.h"
@@ -48,6 +53,12 @@ static usb_status_t USB_HostIp3516HsGetBuffer(usb_host_ip3516hs_state_struct_t *
 static usb_status_t USB_HostIp3516HsFreeBuffer(usb_host_ip3516hs_state_struct_t *usbHostState,
                                                uint32_t index,
                                                uint32_t bufferLength);
+static void USB_HostIp3516HsPipeTokenDone(usb_host_ip3516hs_state_struct_t *usbHostState,
+                                          usb_host_ip3516hs_pipe_struct_t *pipe);
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+static void USB_HostIp3516HsTimeoutWheelDisarm(usb_host_ip3516hs_state_struct_t *usbHostState,
+                                               usb_host_transfer_t *transfer);
+#endif
 
 #if ((defined USB_HOST_CONFIG_COMPLIANCE_TEST) && (USB_HOST_CONFIG_COMPLIANCE_TEST))
 /*!
@@ -1612,6 +1623,9 @@ static usb_status_t USB_HostIp3516HsCancelPipe(usb_host_ip3516hs_state_struct_t
     }
 
     USB_HostIp3516HsLock();
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    USB_HostOhciDisableIsr(usbHostState); /* the ISR completion accesses the transfer list too */
+#endif
     trCurrent = pipe->trList;
     trPre     = NULL;
     while (NULL != trCurrent)
@@ -1652,8 +1666,12 @@ static usb_status_t USB_HostIp3516HsCancelPipe(usb_host_ip3516hs_state_struct_t
                             }
                             else
                             {
+                                /* the transfer is terminated by the timeout */
                                 trStatus                         = kStatus_USB_TransferFailed;
                                 trCurrent->union1.transferResult = (int32_t)kStatus_USB_Success;
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                                USB_HostMetricsRecordEvent(trCurrent->transferPipe, kUSB_HostMetricsTimeout);
+#endif
                             }
                         }
                     }
@@ -1763,8 +1781,14 @@ static usb_status_t USB_HostIp3516HsCancelPipe(usb_host_ip3516hs_state_struct_t
             {
                 pipe->trList = trPos;
             }
-            pipe->cutOffTime = USB_HOST_IP3516HS_TRANSFER_TIMEOUT_GAP;
+            pipe->cutOffTime = 0U;
             pipe->isBusy     = 0U;
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+            USB_HostIp3516HsTimeoutWheelDisarm(usbHostState, trCurrent);
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+            USB_HostMetricsTransferDone(usbHostState->hostHandle, trCurrent, trStatus);
+#endif
             /* callback function is different from the current condition */
             trCurrent->callbackFn(trCurrent->callbackParam, trCurrent, trStatus); /* transfer callback */
         }
@@ -1774,6 +1798,9 @@ static usb_status_t USB_HostIp3516HsCancelPipe(usb_host_ip3516hs_state_struct_t
         }
         trCurrent = trPos;
     }
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    USB_HostOhciEnableIsr(usbHostState);
+#endif
     USB_HostIp3516HsUnlock();
     switch (pipe->pipeCommon.pipeType)
     {
@@ -1957,14 +1984,19 @@ static usb_status_t USB_HostIp3516HsFreeBuffer(usb_host_ip3516hs_state_struct_t
 {
     uint32_t i;
     uint32_t indexCount = (bufferLength - 1U) / 64U + 1U;
+    OSA_SR_ALLOC();
+
     if ((indexCount + index) > (sizeof(s_UsbHostIp3516HsBufferArray) / (sizeof(uint8_t) * 64U)))
     {
         indexCount = (sizeof(s_UsbHostIp3516HsBufferArray) / (sizeof(uint8_t) * 64U)) - index;
     }
+    /* the buffers are released by the ISR completion too */
+    OSA_ENTER_CRITICAL();
     for (i = index; i < (index + indexCount); i++)
     {
         usbHostState->bufferArrayBitMap[i >> 5U] &= ~(1UL << (i % 32U));
     }
+    OSA_EXIT_CRITICAL();
     return kStatus_USB_Success;
 }
 
@@ -2214,6 +2246,7 @@ static usb_status_t USB_HostIp3516HsWriteIsoPipe(usb_host_ip3516hs_state_struct_
     usb_host_ip3516hs_sptl_struct_t *sptl;
     usb_host_transfer_t *currentTr;
     uint32_t transferLength;
+    uint32_t transferOffset;
     uint32_t currentUFrame;
     uint32_t insertUFrame;
     uint32_t primedUFrame;
@@ -2221,6 +2254,9 @@ static usb_status_t USB_HostIp3516HsWriteIsoPipe(usb_host_ip3516hs_state_struct_
     indexLength_t indexLength;
     uint8_t *bufferAddress;
     void *temp;
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    usb_host_iso_packet_descriptor_t *isoPacket;
+#endif
     uint8_t speed = ((usb_host_device_instance_t *)pipe->pipeCommon.deviceHandle)->speed;
     OSA_SR_ALLOC();
 
@@ -2229,7 +2265,18 @@ static usb_status_t USB_HostIp3516HsWriteIsoPipe(usb_host_ip3516hs_state_struct_
     currentTr = tr;
     while (NULL != currentTr)
     {
-        transferLength          = (currentTr->transferLength - currentTr->transferSofar);
+        transferLength = (currentTr->transferLength - currentTr->transferSofar);
+        transferOffset = currentTr->transferSofar;
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+        /* the packets of the transfer with descriptors are primed one by one, one PTD each time */
+        isoPacket = NULL;
+        if (NULL != currentTr->isoPacketDescriptor)
+        {
+            isoPacket      = &currentTr->isoPacketDescriptor[currentTr->isoPacketIndex];
+            transferLength = isoPacket->length;
+            transferOffset = isoPacket->offset;
+        }
+#endif
         indexLength.indexLength = currentTr->union2.frame;
         if (0U == indexLength.indexLength)
         {
@@ -2270,6 +2317,13 @@ static usb_status_t USB_HostIp3516HsWriteIsoPipe(usb_host_ip3516hs_state_struct_
         }
         else
         {
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+            if (NULL != isoPacket)
+            {
+                /* the next transfer is primed after the last packet of this transfer */
+                break;
+            }
+#endif
             currentTr = currentTr->next;
             continue;
         }
@@ -2283,7 +2337,7 @@ static usb_status_t USB_HostIp3516HsWriteIsoPipe(usb_host_ip3516hs_state_struct_
         {
             for (uint32_t i = 0; i < transferLength; i++)
             {
-                bufferAddress[i] = currentTr->transferBuffer[currentTr->transferSofar + i];
+                bufferAddress[i] = currentTr->transferBuffer[transferOffset + i];
             }
         }
 
@@ -2359,6 +2413,12 @@ static usb_status_t USB_HostIp3516HsWriteIsoPipe(usb_host_ip3516hs_state_struct_
                 {
                     break;
                 }
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+                if (NULL != isoPacket)
+                {
+                    break;
+                }
+#endif
             }
         }
         else
@@ -2406,6 +2466,12 @@ static usb_status_t USB_HostIp3516HsWriteIsoPipe(usb_host_ip3516hs_state_struct_
         ptl->control1Union.stateBitField.V = 0x01U;
         ptl->stateUnion.stateBitField.A    = 0x01U;
 
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+        if (NULL != isoPacket)
+        {
+            break;
+        }
+#endif
         currentTr = currentTr->next;
     }
     OSA_EXIT_CRITICAL();
@@ -2572,6 +2638,19 @@ static usb_host_ip3516hs_pipe_struct_t *USB_HostIp3516HsGetPipe(usb_host_ip3516h
     return NULL;
 }
 
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+/* push the done record of the pipe in the ISR, the task only processes the recorded pipes */
+static void USB_HostIp3516HsEventRecord(usb_host_ip3516hs_state_struct_t *usbHostState,
+                                        usb_host_ip3516hs_pipe_struct_t *pipe,
+                                        uint32_t state)
+{
+    (void)USB_HostEventRingPush(
+        &usbHostState->eventRing, &pipe->pipeCommon, state,
+        (uint16_t)((usbHostState->usbRegBase->FLADJ_FRINDEX & USB_HOST_IP3516HS_FLADJ_FRINDEX_MASK) >>
+                   USB_HOST_IP3516HS_FLADJ_FRINDEX_SHIFT));
+}
+#endif
+
 #if ((defined(USB_HOST_CONFIG_IP3516HS_MAX_ISO)) && (USB_HOST_CONFIG_IP3516HS_MAX_ISO > 0U))
 static usb_status_t USB_HostIp3516HsCheckIsoTransferSofar(usb_host_ip3516hs_state_struct_t *usbHostState)
 {
@@ -2595,6 +2674,10 @@ static usb_status_t USB_HostIp3516HsCheckIsoTransferSofar(usb_host_ip3516hs_stat
             if (NULL != p)
             {
                 p->isBusy = 0U;
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+                USB_HostIp3516HsEventRecord(usbHostState, p,
+                                            s_UsbHostIp3516HsPtd[usbHostState->controllerId].iso[i].stateUnion.state);
+#endif
 #if 0
                 if (NULL != p->trList)
                 {
@@ -2661,6 +2744,20 @@ static usb_status_t USB_HostIp3516HsCheckIntTransferSofar(usb_host_ip3516hs_stat
             if (NULL != p)
             {
                 p->isBusy = 0U;
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+                if (0U != p->isrCompletion)
+                {
+                    USB_HostIp3516HsPipeTokenDone(usbHostState, p); /* complete the transfer in the ISR */
+                }
+                else
+#endif
+                {
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+                    USB_HostIp3516HsEventRecord(
+                        usbHostState, p,
+                        s_UsbHostIp3516HsPtd[usbHostState->controllerId].interrupt[i].stateUnion.state);
+#endif
+                }
             }
         }
     }
@@ -2686,11 +2783,19 @@ static usb_status_t USB_HostIp3516HsCheckAtlTransferSofar(usb_host_ip3516hs_stat
             if (NULL != p)
             {
                 p->isBusy = 0U;
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+                USB_HostIp3516HsEventRecord(usbHostState, p,
+                                            s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[i].stateUnion.state);
+#endif
             }
             p = USB_HostIp3516HsGetPipe(usbHostState, USB_ENDPOINT_BULK, i);
             if ((NULL != p))
             {
                 p->isBusy = 0U;
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+                USB_HostIp3516HsEventRecord(usbHostState, p,
+                                            s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[i].stateUnion.state);
+#endif
             }
         }
     }
@@ -2742,9 +2847,57 @@ static void USB_HostIp3516HsCheckGetBufferFailedPipe(usb_host_ip3516hs_state_str
     }
 }
 
-static usb_status_t USB_HostIp3516HsTokenDone(usb_host_ip3516hs_state_struct_t *usbHostState)
+#if ((defined(USB_HOST_CONFIG_IP3516HS_MAX_ISO)) && (USB_HOST_CONFIG_IP3516HS_MAX_ISO > 0U))
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+/* record the done packet in its descriptor, return 1U if it is the last packet of the transfer */
+static uint8_t USB_HostIp3516HsIsoPacketDone(usb_host_ip3516hs_state_struct_t *usbHostState,
+                                             usb_host_ip3516hs_pipe_struct_t *pipe,
+                                             usb_host_transfer_t *tr,
+                                             uint32_t tdIndex)
+{
+    usb_host_ip3516hs_ptl_struct_t *ptl         = &s_UsbHostIp3516HsPtd[usbHostState->controllerId].iso[tdIndex];
+    usb_host_iso_packet_descriptor_t *isoPacket = &tr->isoPacketDescriptor[tr->isoPacketIndex];
+    uint32_t length                             = ptl->stateUnion.stateBitField.NrBytesToTransfer;
+
+    if (length > isoPacket->length)
+    {
+        length = isoPacket->length;
+    }
+    if (USB_IN == tr->direction)
+    {
+        (void)memcpy((void *)(&tr->transferBuffer[isoPacket->offset]),
+                     (void *)(&s_UsbHostIp3516HsBufferArray[pipe->bufferIndex][0]), length);
+    }
+    if ((0U != ptl->stateUnion.stateBitField.B) || (0U != ptl->stateUnion.stateBitField.X))
+    {
+        USB_HostIsoPacketDone(tr, tr->isoPacketIndex, length, kStatus_USB_TransferFailed);
+    }
+    else
+    {
+        USB_HostIsoPacketDone(tr, tr->isoPacketIndex, length, kStatus_USB_Success);
+    }
+    tr->isoPacketIndex++;
+    /* the packet errors are in the descriptors */
+    tr->union1.transferResult = (int32_t)kStatus_USB_Success;
+
+    if (tr->isoPacketIndex >= tr->isoPacketCount)
+    {
+        return 1U;
+    }
+
+    /* release the PTD and the buffer, then prime the next packet */
+    ptl->dataUnion.dataBitField.NrBytesToTransfer = 0U;
+    (void)USB_HostIp3516HsFreeBuffer(usbHostState, pipe->bufferIndex, pipe->bufferLength);
+    pipe->bufferLength = 0U;
+    (void)USB_HostIp3516HsWriteIsoPipe(usbHostState, pipe, tr);
+    return 0U;
+}
+#endif
+#endif
+
+static void USB_HostIp3516HsPipeTokenDone(usb_host_ip3516hs_state_struct_t *usbHostState,
+                                          usb_host_ip3516hs_pipe_struct_t *pipe)
 {
-    usb_host_ip3516hs_pipe_struct_t *pipe;
     usb_host_transfer_t *trCurrent;
     usb_host_ip3516hs_pipe_struct_t *p;
     uint32_t startUFrame;
@@ -2757,290 +2910,285 @@ static usb_status_t USB_HostIp3516HsTokenDone(usb_host_ip3516hs_state_struct_t *
     usb_status_t trStatus;
     uint8_t trDone;
 
-    /* Enter critical */
-    USB_HostIp3516HsLock();
-    USB_HostOhciDisableIsr(usbHostState);
-    pipe = usbHostState->pipeListInUsing;
-    while (NULL != pipe)
+    trStatus  = kStatus_USB_Success;
+    trCurrent = pipe->trList;
+    if (NULL == trCurrent)
     {
-        trStatus  = kStatus_USB_Success;
-        trCurrent = pipe->trList;
-        if (NULL == trCurrent)
-        {
-        }
-        else
+    }
+    else
+    {
+        trDone = 0;
+        switch (pipe->pipeCommon.pipeType)
         {
-            trDone = 0;
-            switch (pipe->pipeCommon.pipeType)
-            {
-                case USB_ENDPOINT_CONTROL:
-                    if (0U != pipe->isBusy)
-                    {
-                        temp = (void *)pipe->pipeCommon.next;
-                        pipe = (usb_host_ip3516hs_pipe_struct_t *)temp;
-                        continue;
-                    }
-                    transferStatus = (usb_host_ip3516hs_transfer_status_t)trCurrent->setupStatus;
-                    switch (transferStatus)
-                    {
-                        case kStatus_UsbHostIp3516Hs_Idle:
-                            break;
-                        case kStatus_UsbHostIp3516Hs_Setup:
-                            break;
-                        case kStatus_UsbHostIp3516Hs_Data2:
-                            if ((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                           .atl[pipe->tdIndex]
-                                           .stateUnion.stateBitField.NrBytesToTransfer) &&
-                                (0U == (s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                            .atl[pipe->tdIndex]
-                                            .stateUnion.stateBitField.NrBytesToTransfer %
-                                        pipe->pipeCommon.maxPacketSize)))
-                            {
-                            }
-                            else
-                            {
-                                trCurrent->setupStatus = (uint8_t)kStatus_UsbHostIp3516Hs_Data;
-                            }
-                            if (USB_IN == trCurrent->direction)
-                            {
-                                (void)memcpy((void *)(&trCurrent->transferBuffer[trCurrent->transferSofar]),
-                                             (void *)(&s_UsbHostIp3516HsBufferArray[pipe->bufferIndex][0]),
-                                             s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                                 .atl[pipe->tdIndex]
-                                                 .stateUnion.stateBitField.NrBytesToTransfer);
-                            }
-                            trCurrent->transferSofar += s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                                            .atl[pipe->tdIndex]
-                                                            .stateUnion.stateBitField.NrBytesToTransfer;
-                            break;
-                        case kStatus_UsbHostIp3516Hs_Data:
-                            if (USB_IN == trCurrent->direction)
-                            {
-                                (void)memcpy((void *)(&trCurrent->transferBuffer[trCurrent->transferSofar]),
-                                             (void *)(&s_UsbHostIp3516HsBufferArray[pipe->bufferIndex][0]),
-                                             s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                                 .atl[pipe->tdIndex]
-                                                 .stateUnion.stateBitField.NrBytesToTransfer);
-                            }
-                            trCurrent->transferSofar += s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                                            .atl[pipe->tdIndex]
-                                                            .stateUnion.stateBitField.NrBytesToTransfer;
-                            break;
-                        case kStatus_UsbHostIp3516Hs_State:
-                            break;
-                        default:
-                            /*no action*/
-                            break;
-                    }
+            case USB_ENDPOINT_CONTROL:
+                if (0U != pipe->isBusy)
+                {
+                    return;
+                }
+                transferStatus = (usb_host_ip3516hs_transfer_status_t)trCurrent->setupStatus;
+                switch (transferStatus)
+                {
+                    case kStatus_UsbHostIp3516Hs_Idle:
+                        break;
+                    case kStatus_UsbHostIp3516Hs_Setup:
+                        break;
+                    case kStatus_UsbHostIp3516Hs_Data2:
+                        if ((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                       .atl[pipe->tdIndex]
+                                       .stateUnion.stateBitField.NrBytesToTransfer) &&
+                            (0U == (s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                        .atl[pipe->tdIndex]
+                                        .stateUnion.stateBitField.NrBytesToTransfer %
+                                    pipe->pipeCommon.maxPacketSize)))
+                        {
+                        }
+                        else
+                        {
+                            trCurrent->setupStatus = (uint8_t)kStatus_UsbHostIp3516Hs_Data;
+                        }
+                        if (USB_IN == trCurrent->direction)
+                        {
+                            (void)memcpy((void *)(&trCurrent->transferBuffer[trCurrent->transferSofar]),
+                                         (void *)(&s_UsbHostIp3516HsBufferArray[pipe->bufferIndex][0]),
+                                         s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                             .atl[pipe->tdIndex]
+                                             .stateUnion.stateBitField.NrBytesToTransfer);
+                        }
+                        trCurrent->transferSofar += s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                                        .atl[pipe->tdIndex]
+                                                        .stateUnion.stateBitField.NrBytesToTransfer;
+                        break;
+                    case kStatus_UsbHostIp3516Hs_Data:
+                        if (USB_IN == trCurrent->direction)
+                        {
+                            (void)memcpy((void *)(&trCurrent->transferBuffer[trCurrent->transferSofar]),
+                                         (void *)(&s_UsbHostIp3516HsBufferArray[pipe->bufferIndex][0]),
+                                         s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                             .atl[pipe->tdIndex]
+                                             .stateUnion.stateBitField.NrBytesToTransfer);
+                        }
+                        trCurrent->transferSofar += s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                                        .atl[pipe->tdIndex]
+                                                        .stateUnion.stateBitField.NrBytesToTransfer;
+                        break;
+                    case kStatus_UsbHostIp3516Hs_State:
+                        break;
+                    default:
+                        /*no action*/
+                        break;
+                }
 
-                    if (!((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                     .atl[pipe->tdIndex]
-                                     .stateUnion.stateBitField.A) &&
-                          (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                     .atl[pipe->tdIndex]
-                                     .control1Union.stateBitField.V)))
-                    {
-                        trDone = 1U;
-                    }
+                if (!((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                 .atl[pipe->tdIndex]
+                                 .stateUnion.stateBitField.A) &&
+                      (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                 .atl[pipe->tdIndex]
+                                 .control1Union.stateBitField.V)))
+                {
+                    trDone = 1U;
+                }
 
-                    if ((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                   .atl[pipe->tdIndex]
-                                   .stateUnion.stateBitField.B) ||
-                        (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                if ((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                               .atl[pipe->tdIndex]
+                               .stateUnion.stateBitField.B) ||
+                    (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                               .atl[pipe->tdIndex]
+                               .stateUnion.stateBitField.X))
+                {
+                    trStatus = kStatus_USB_TransferFailed;
+                }
+                else if (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
                                    .atl[pipe->tdIndex]
-                                   .stateUnion.stateBitField.X))
-                    {
-                        trStatus = kStatus_USB_TransferFailed;
-                    }
-                    else if (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                       .atl[pipe->tdIndex]
-                                       .stateUnion.stateBitField.H)
-                    {
-                        trStatus = kStatus_USB_TransferStall;
-                    }
-                    else
+                                   .stateUnion.stateBitField.H)
+                {
+                    trStatus = kStatus_USB_TransferStall;
+                }
+                else
+                {
+                    if (0U != trDone)
                     {
-                        if (0U != trDone)
-                        {
 #if ((defined USB_HOST_CONFIG_COMPLIANCE_TEST) && (USB_HOST_CONFIG_COMPLIANCE_TEST))
-                            if (1U == usbHostState->complianceTestStart)
-                            {
-                                usbHostState->complianceTest++;
-                            }
-#endif
-                            (void)USB_HostIp3516HsWriteControlPipe(usbHostState, pipe, pipe->trList);
+                        if (1U == usbHostState->complianceTestStart)
+                        {
+                            usbHostState->complianceTest++;
                         }
+#endif
+                        (void)USB_HostIp3516HsWriteControlPipe(usbHostState, pipe, pipe->trList);
                     }
+                }
 
-                    if (0U != pipe->isBusy)
-                    {
-                        temp = (void *)pipe->pipeCommon.next;
-                        pipe = (usb_host_ip3516hs_pipe_struct_t *)temp;
-                        continue;
-                    }
-
-                    s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.H = 0U;
-                    s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.X = 0U;
-                    s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.B = 0U;
-                    break;
-                case USB_ENDPOINT_BULK:
-                    if (0U != pipe->isBusy)
-                    {
-                        temp = (void *)pipe->pipeCommon.next;
-                        pipe = (usb_host_ip3516hs_pipe_struct_t *)temp;
-                        continue;
-                    }
+                if (0U != pipe->isBusy)
+                {
+                    return;
+                }
 
-                    if (USB_IN == trCurrent->direction)
-                    {
-                        uint32_t length = s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                              .atl[pipe->tdIndex]
-                                              .stateUnion.stateBitField.NrBytesToTransfer;
-                        (void)memcpy((void *)(&trCurrent->transferBuffer[trCurrent->transferSofar]),
-                                     (void *)(&s_UsbHostIp3516HsBufferArray[pipe->bufferIndex][0]), length);
-                    }
-                    trCurrent->transferSofar += s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                                    .atl[pipe->tdIndex]
-                                                    .stateUnion.stateBitField.NrBytesToTransfer;
+                s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.H = 0U;
+                s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.X = 0U;
+                s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.B = 0U;
+                break;
+            case USB_ENDPOINT_BULK:
+                if (0U != pipe->isBusy)
+                {
+                    return;
+                }
 
-                    if (!((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                     .atl[pipe->tdIndex]
-                                     .stateUnion.stateBitField.A) &&
-                          (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                     .atl[pipe->tdIndex]
-                                     .control1Union.stateBitField.V)))
-                    {
-                        trDone = 1U;
-                    }
+                if (USB_IN == trCurrent->direction)
+                {
+                    uint32_t length = s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                          .atl[pipe->tdIndex]
+                                          .stateUnion.stateBitField.NrBytesToTransfer;
+                    (void)memcpy((void *)(&trCurrent->transferBuffer[trCurrent->transferSofar]),
+                                 (void *)(&s_UsbHostIp3516HsBufferArray[pipe->bufferIndex][0]), length);
+                }
+                trCurrent->transferSofar += s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                                .atl[pipe->tdIndex]
+                                                .stateUnion.stateBitField.NrBytesToTransfer;
+
+                if (!((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                 .atl[pipe->tdIndex]
+                                 .stateUnion.stateBitField.A) &&
+                      (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                 .atl[pipe->tdIndex]
+                                 .control1Union.stateBitField.V)))
+                {
+                    trDone = 1U;
+                }
 
-                    if (0U !=
-                        s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.H)
-                    {
-                        trStatus = kStatus_USB_TransferStall;
-                    }
-                    else if ((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                        .atl[pipe->tdIndex]
-                                        .stateUnion.stateBitField.B) ||
-                             (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                        .atl[pipe->tdIndex]
-                                        .stateUnion.stateBitField.X))
-                    {
-                        trStatus = kStatus_USB_TransferFailed;
-                    }
-                    else
+                if (0U !=
+                    s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.H)
+                {
+                    trStatus = kStatus_USB_TransferStall;
+                }
+                else if ((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                    .atl[pipe->tdIndex]
+                                    .stateUnion.stateBitField.B) ||
+                         (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                    .atl[pipe->tdIndex]
+                                    .stateUnion.stateBitField.X))
+                {
+                    trStatus = kStatus_USB_TransferFailed;
+                }
+                else
+                {
+                    if (0U != trDone)
                     {
-                        if (0U != trDone)
+                        if ((0U == (pipe->trList->transferLength % pipe->pipeCommon.maxPacketSize)) &&
+                            (pipe->trList->transferSofar < pipe->trList->transferLength))
                         {
-                            if ((0U == (pipe->trList->transferLength % pipe->pipeCommon.maxPacketSize)) &&
-                                (pipe->trList->transferSofar < pipe->trList->transferLength))
-                            {
-                                (void)USB_HostIp3516HsWriteBulkPipe(usbHostState, pipe, pipe->trList);
-                            }
+                            (void)USB_HostIp3516HsWriteBulkPipe(usbHostState, pipe, pipe->trList);
                         }
                     }
+                }
 
-                    if (0U != pipe->isBusy)
-                    {
-                        temp = (void *)pipe->pipeCommon.next;
-                        pipe = (usb_host_ip3516hs_pipe_struct_t *)temp;
-                        continue;
-                    }
+                if (0U != pipe->isBusy)
+                {
+                    return;
+                }
 
-                    s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.H = 0U;
-                    s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.X = 0U;
-                    s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.B = 0U;
+                s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.H = 0U;
+                s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.X = 0U;
+                s_UsbHostIp3516HsPtd[usbHostState->controllerId].atl[pipe->tdIndex].stateUnion.stateBitField.B = 0U;
 
-                    break;
+                break;
 #if ((defined(USB_HOST_CONFIG_IP3516HS_MAX_INT)) && (USB_HOST_CONFIG_IP3516HS_MAX_INT > 0U))
-                case USB_ENDPOINT_INTERRUPT:
-                    if (0U != pipe->isBusy)
-                    {
-                        temp = (void *)pipe->pipeCommon.next;
-                        pipe = (usb_host_ip3516hs_pipe_struct_t *)temp;
-                        continue;
-                    }
+            case USB_ENDPOINT_INTERRUPT:
+                if (0U != pipe->isBusy)
+                {
+                    return;
+                }
 
-                    if (!((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                     .interrupt[pipe->tdIndex]
-                                     .stateUnion.stateBitField.A) &&
-                          (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                if (!((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                 .interrupt[pipe->tdIndex]
+                                 .stateUnion.stateBitField.A) &&
+                      (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                 .interrupt[pipe->tdIndex]
+                                 .control1Union.stateBitField.V)))
+                {
+                    trDone = 1U;
+                }
+
+                if (USB_IN == trCurrent->direction)
+                {
+                    (void)memcpy((void *)(&trCurrent->transferBuffer[trCurrent->transferSofar]),
+                                 (void *)(&s_UsbHostIp3516HsBufferArray[pipe->bufferIndex][0]),
+                                 s_UsbHostIp3516HsPtd[usbHostState->controllerId]
                                      .interrupt[pipe->tdIndex]
-                                     .control1Union.stateBitField.V)))
+                                     .stateUnion.stateBitField.NrBytesToTransfer);
+                }
+                trCurrent->transferSofar += s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                                .interrupt[pipe->tdIndex]
+                                                .stateUnion.stateBitField.NrBytesToTransfer;
+
+                if (1U == s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                              .interrupt[pipe->tdIndex]
+                              .stateUnion.stateBitField.H)
+                {
+                    trStatus = kStatus_USB_TransferStall;
+                }
+                else if ((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                    .interrupt[pipe->tdIndex]
+                                    .stateUnion.stateBitField.B) ||
+                         (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                                    .interrupt[pipe->tdIndex]
+                                    .stateUnion.stateBitField.X))
+                {
+                    trStatus = kStatus_USB_TransferFailed;
+                }
+                else
+                {
+                    /*no action*/
+                }
+                s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                    .interrupt[pipe->tdIndex]
+                    .stateUnion.stateBitField.H = 0U;
+                s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                    .interrupt[pipe->tdIndex]
+                    .stateUnion.stateBitField.X = 0U;
+                s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                    .interrupt[pipe->tdIndex]
+                    .stateUnion.stateBitField.B = 0U;
+                break;
+#endif
+#if ((defined(USB_HOST_CONFIG_IP3516HS_MAX_ISO)) && (USB_HOST_CONFIG_IP3516HS_MAX_ISO > 0U))
+            case USB_ENDPOINT_ISOCHRONOUS:
+#if 1
+                indexLength.indexLength = trCurrent->union2.frame;
+                trCurrent->union2.frame = 0u;
+                if ((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                               .iso[indexLength.state.tdIndex]
+                               .stateUnion.stateBitField.A) &&
+                    (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                               .iso[indexLength.state.tdIndex]
+                               .control1Union.stateBitField.V))
+                {
+                    return;
+                }
+
+                pipe->bufferIndex  = indexLength.state.bufferIndex;
+                pipe->bufferLength = indexLength.state.bufferLength;
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+                if (NULL != trCurrent->isoPacketDescriptor)
+                {
+                    if (0U == USB_HostIp3516HsIsoPacketDone(usbHostState, pipe, trCurrent,
+                                                            indexLength.state.tdIndex))
                     {
-                        trDone = 1U;
+                        /* the next packet is primed */
+                        return;
                     }
-
+                }
+                else
+#endif
+                {
                     if (USB_IN == trCurrent->direction)
                     {
                         (void)memcpy((void *)(&trCurrent->transferBuffer[trCurrent->transferSofar]),
                                      (void *)(&s_UsbHostIp3516HsBufferArray[pipe->bufferIndex][0]),
                                      s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                         .interrupt[pipe->tdIndex]
+                                         .iso[indexLength.state.tdIndex]
                                          .stateUnion.stateBitField.NrBytesToTransfer);
                     }
                     trCurrent->transferSofar += s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                                    .interrupt[pipe->tdIndex]
-                                                    .stateUnion.stateBitField.NrBytesToTransfer;
-
-                    if (1U == s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                  .interrupt[pipe->tdIndex]
-                                  .stateUnion.stateBitField.H)
-                    {
-                        trStatus = kStatus_USB_TransferStall;
-                    }
-                    else if ((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                        .interrupt[pipe->tdIndex]
-                                        .stateUnion.stateBitField.B) ||
-                             (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                        .interrupt[pipe->tdIndex]
-                                        .stateUnion.stateBitField.X))
-                    {
-                        trStatus = kStatus_USB_TransferFailed;
-                    }
-                    else
-                    {
-                        /*no action*/
-                    }
-                    s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                        .interrupt[pipe->tdIndex]
-                        .stateUnion.stateBitField.H = 0U;
-                    s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                        .interrupt[pipe->tdIndex]
-                        .stateUnion.stateBitField.X = 0U;
-                    s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                        .interrupt[pipe->tdIndex]
-                        .stateUnion.stateBitField.B = 0U;
-                    break;
-#endif
-#if ((defined(USB_HOST_CONFIG_IP3516HS_MAX_ISO)) && (USB_HOST_CONFIG_IP3516HS_MAX_ISO > 0U))
-                case USB_ENDPOINT_ISOCHRONOUS:
-#if 1
-                    indexLength.indexLength = trCurrent->union2.frame;
-                    trCurrent->union2.frame = 0u;
-                    if ((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                   .iso[indexLength.state.tdIndex]
-                                   .stateUnion.stateBitField.A) &&
-                        (0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                   .iso[indexLength.state.tdIndex]
-                                   .control1Union.stateBitField.V))
-                    {
-                        temp = (void *)pipe->pipeCommon.next;
-                        pipe = (usb_host_ip3516hs_pipe_struct_t *)temp;
-                        continue;
-                    }
-
-                    pipe->bufferIndex  = indexLength.state.bufferIndex;
-                    pipe->bufferLength = indexLength.state.bufferLength;
-                    if (USB_IN == trCurrent->direction)
-                    {
-                        (void)memcpy((void *)(&trCurrent->transferBuffer[trCurrent->transferSofar]),
-                                     (void *)(&s_UsbHostIp3516HsBufferArray[pipe->bufferIndex][0]),
-                                     s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                         .iso[indexLength.state.tdIndex]
-                                         .stateUnion.stateBitField.NrBytesToTransfer);
-                    }
-                    trCurrent->transferSofar += s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                                    .iso[indexLength.state.tdIndex]
+                                                    .iso[indexLength.state.tdIndex]
                                                     .stateUnion.stateBitField.NrBytesToTransfer;
 
                     if ((0U != s_UsbHostIp3516HsPtd[usbHostState->controllerId]
@@ -3056,174 +3204,339 @@ static usb_status_t USB_HostIp3516HsTokenDone(usb_host_ip3516hs_state_struct_t *
                     {
                         trCurrent->union1.transferResult = (int32_t)kStatus_USB_Success;
                     }
+                }
 
-                    if (NULL != pipe->trList)
-                    {
-                        pipe->currentTr = pipe->trList->next;
-                    }
-                    else
-                    {
-                        pipe->currentTr = NULL;
-                    }
+                if (NULL != pipe->trList)
+                {
+                    pipe->currentTr = pipe->trList->next;
+                }
+                else
+                {
+                    pipe->currentTr = NULL;
+                }
 
-                    if (NULL != pipe->currentTr)
-                    {
-                        uint32_t trValue = (uint32_t)pipe->currentTr;
-                        (void)USB_HostIp3516HsWriteIsoPipe(usbHostState, pipe, (usb_host_transfer_t *)trValue);
-                    }
+                if (NULL != pipe->currentTr)
+                {
+                    uint32_t trValue = (uint32_t)pipe->currentTr;
+                    (void)USB_HostIp3516HsWriteIsoPipe(usbHostState, pipe, (usb_host_transfer_t *)trValue);
+                }
 #else
-                    if (pipe->trList == pipe->currentTr)
-                    {
-                        temp = (void *)pipe->pipeCommon.next;
-                        pipe = (usb_host_ip3516hs_pipe_struct_t *)temp;
-                        continue;
-                    }
+                if (pipe->trList == pipe->currentTr)
+                {
+                    return;
+                }
 #endif
-                    trDone = 1U;
+                trDone = 1U;
 
-                    trStatus = (usb_status_t)trCurrent->union1.transferResult;
-                    s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                        .iso[indexLength.state.tdIndex]
-                        .dataUnion.dataBitField.NrBytesToTransfer = 0U;
+                trStatus = (usb_status_t)trCurrent->union1.transferResult;
+                s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                    .iso[indexLength.state.tdIndex]
+                    .dataUnion.dataBitField.NrBytesToTransfer = 0U;
 
-                    break;
+                break;
 #endif
-                default:
-                    /*no action*/
-                    break;
-            }
-            if (0U != trDone)
-            {
-                pipe->trList = trCurrent->next;
+            default:
+                /*no action*/
+                break;
+        }
+        if (0U != trDone)
+        {
+            pipe->trList = trCurrent->next;
 #if 0
 #if ((defined(USB_HOST_CONFIG_IP3516HS_MAX_ISO)) && (USB_HOST_CONFIG_IP3516HS_MAX_ISO > 0U))
-                if ((USB_ENDPOINT_ISOCHRONOUS != pipe->pipeCommon.pipeType) && (pipe->bufferLength))
+            if ((USB_ENDPOINT_ISOCHRONOUS != pipe->pipeCommon.pipeType) && (pipe->bufferLength))
 #else
-                if ((pipe->bufferLength)
+            if ((pipe->bufferLength)
 #endif
 
 #else
-                if ((0U != pipe->bufferLength))
+            if ((0U != pipe->bufferLength))
+#endif
+            {
+                (void)USB_HostIp3516HsFreeBuffer(usbHostState, pipe->bufferIndex, pipe->bufferLength);
+                pipe->bufferLength = 0U;
+            }
+            pipe->cutOffTime = 0U;
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+            USB_HostIp3516HsTimeoutWheelDisarm(usbHostState, trCurrent);
 #endif
-                {
-                    (void)USB_HostIp3516HsFreeBuffer(usbHostState, pipe->bufferIndex, pipe->bufferLength);
-                    pipe->bufferLength = 0U;
-                }
-                pipe->cutOffTime = USB_HOST_IP3516HS_TRANSFER_TIMEOUT_GAP;
 
-                if ((kStatus_USB_Success == (trStatus)) && (USB_ENDPOINT_CONTROL == pipe->pipeCommon.pipeType) &&
-                    (USB_REQUEST_STANDARD_CLEAR_FEATURE == trCurrent->setupPacket->bRequest) &&
-                    (USB_REQUEST_TYPE_RECIPIENT_ENDPOINT == trCurrent->setupPacket->bmRequestType) &&
-                    (USB_REQUEST_STANDARD_FEATURE_SELECTOR_ENDPOINT_HALT ==
-                     (USB_SHORT_FROM_LITTLE_ENDIAN(trCurrent->setupPacket->wValue) & 0x00FFU)))
+            if ((kStatus_USB_Success == (trStatus)) && (USB_ENDPOINT_CONTROL == pipe->pipeCommon.pipeType) &&
+                (USB_REQUEST_STANDARD_CLEAR_FEATURE == trCurrent->setupPacket->bRequest) &&
+                (USB_REQUEST_TYPE_RECIPIENT_ENDPOINT == trCurrent->setupPacket->bmRequestType) &&
+                (USB_REQUEST_STANDARD_FEATURE_SELECTOR_ENDPOINT_HALT ==
+                 (USB_SHORT_FROM_LITTLE_ENDIAN(trCurrent->setupPacket->wValue) & 0x00FFU)))
+            {
+                p = usbHostState->pipeListInUsing;
+                while (p != NULL)
                 {
-                    p = usbHostState->pipeListInUsing;
-                    while (p != NULL)
+                    /* only compute bulk and interrupt pipe */
+                    if ((p->pipeCommon.deviceHandle == pipe->pipeCommon.deviceHandle) &&
+                        ((p->pipeCommon.endpointAddress |
+                          (p->pipeCommon.direction << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT)) ==
+                         ((uint8_t)(USB_SHORT_FROM_LITTLE_ENDIAN(trCurrent->setupPacket->wIndex)))))
                     {
-                        /* only compute bulk and interrupt pipe */
-                        if ((p->pipeCommon.deviceHandle == pipe->pipeCommon.deviceHandle) &&
-                            ((p->pipeCommon.endpointAddress |
-                              (p->pipeCommon.direction << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT)) ==
-                             ((uint8_t)(USB_SHORT_FROM_LITTLE_ENDIAN(trCurrent->setupPacket->wIndex)))))
-                        {
-                            break;
-                        }
-                        temp = (void *)p->pipeCommon.next;
-                        p    = (usb_host_ip3516hs_pipe_struct_t *)temp;
+                        break;
                     }
+                    temp = (void *)p->pipeCommon.next;
+                    p    = (usb_host_ip3516hs_pipe_struct_t *)temp;
+                }
 
-                    if ((NULL != p) && ((USB_ENDPOINT_BULK == p->pipeCommon.pipeType) ||
-                                        (USB_ENDPOINT_INTERRUPT == p->pipeCommon.pipeType)))
+                if ((NULL != p) && ((USB_ENDPOINT_BULK == p->pipeCommon.pipeType) ||
+                                    (USB_ENDPOINT_INTERRUPT == p->pipeCommon.pipeType)))
+                {
+                    if (USB_ENDPOINT_BULK == p->pipeCommon.pipeType)
                     {
-                        if (USB_ENDPOINT_BULK == p->pipeCommon.pipeType)
-                        {
-                            usbHostState->usbRegBase->ATL_PTD_SKIP_MAP |= 1UL << p->tdIndex;
-                        }
+                        usbHostState->usbRegBase->ATL_PTD_SKIP_MAP |= 1UL << p->tdIndex;
+                    }
 #if ((defined(USB_HOST_CONFIG_IP3516HS_MAX_INT)) && (USB_HOST_CONFIG_IP3516HS_MAX_INT > 0U))
-                        else if (USB_ENDPOINT_INTERRUPT == p->pipeCommon.pipeType)
-                        {
-                            usbHostState->usbRegBase->INT_PTD_SKIP_MAP |= 1UL << p->tdIndex;
-                        }
+                    else if (USB_ENDPOINT_INTERRUPT == p->pipeCommon.pipeType)
+                    {
+                        usbHostState->usbRegBase->INT_PTD_SKIP_MAP |= 1UL << p->tdIndex;
+                    }
 #endif
-                        else
-                        {
-                        }
+                    else
+                    {
+                    }
 
-                        startUFrame = (uint32_t)(
+                    startUFrame = (uint32_t)(
+                        (usbHostState->usbRegBase->FLADJ_FRINDEX & USB_HOST_IP3516HS_FLADJ_FRINDEX_MASK) >>
+                        USB_HOST_IP3516HS_FLADJ_FRINDEX_SHIFT);
+                    currentUFrame = startUFrame;
+
+                    while (currentUFrame == startUFrame)
+                    {
+                        currentUFrame = (uint32_t)(
                             (usbHostState->usbRegBase->FLADJ_FRINDEX & USB_HOST_IP3516HS_FLADJ_FRINDEX_MASK) >>
                             USB_HOST_IP3516HS_FLADJ_FRINDEX_SHIFT);
-                        currentUFrame = startUFrame;
-
-                        while (currentUFrame == startUFrame)
-                        {
-                            currentUFrame = (uint32_t)(
-                                (usbHostState->usbRegBase->FLADJ_FRINDEX & USB_HOST_IP3516HS_FLADJ_FRINDEX_MASK) >>
-                                USB_HOST_IP3516HS_FLADJ_FRINDEX_SHIFT);
-                        }
+                    }
 
-                        if (USB_ENDPOINT_BULK == p->pipeCommon.pipeType)
-                        {
-                            s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                .atl[p->tdIndex]
-                                .stateUnion.stateBitField.DT = 0U;
-                            usbHostState->usbRegBase->ATL_PTD_SKIP_MAP &= ~(1UL << p->tdIndex);
-                        }
+                    if (USB_ENDPOINT_BULK == p->pipeCommon.pipeType)
+                    {
+                        s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                            .atl[p->tdIndex]
+                            .stateUnion.stateBitField.DT = 0U;
+                        usbHostState->usbRegBase->ATL_PTD_SKIP_MAP &= ~(1UL << p->tdIndex);
+                    }
 #if ((defined(USB_HOST_CONFIG_IP3516HS_MAX_INT)) && (USB_HOST_CONFIG_IP3516HS_MAX_INT > 0U))
-                        else if (USB_ENDPOINT_INTERRUPT == p->pipeCommon.pipeType)
-                        {
-                            s_UsbHostIp3516HsPtd[usbHostState->controllerId]
-                                .interrupt[p->tdIndex]
-                                .stateUnion.stateBitField.DT = 0U;
-                            usbHostState->usbRegBase->INT_PTD_SKIP_MAP &= ~(1UL << p->tdIndex);
-                        }
+                    else if (USB_ENDPOINT_INTERRUPT == p->pipeCommon.pipeType)
+                    {
+                        s_UsbHostIp3516HsPtd[usbHostState->controllerId]
+                            .interrupt[p->tdIndex]
+                            .stateUnion.stateBitField.DT = 0U;
+                        usbHostState->usbRegBase->INT_PTD_SKIP_MAP &= ~(1UL << p->tdIndex);
+                    }
 #endif
-                        else
-                        {
-                        }
+                    else
+                    {
                     }
                 }
-                /* callback function is different from the current condition */
-                trCurrent->callbackFn(trCurrent->callbackParam, trCurrent, trStatus); /* transfer callback */
+            }
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+            USB_HostMetricsTransferDone(usbHostState->hostHandle, trCurrent, trStatus);
+#endif
+            /* callback function is different from the current condition */
+            trCurrent->callbackFn(trCurrent->callbackParam, trCurrent, trStatus); /* transfer callback */
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+            if (0U == pipe->isrCompletion) /* the task checks the pipes after the ISR completion */
+#endif
+            {
                 USB_HostIp3516HsCheckGetBufferFailedPipe(usbHostState);
-                if (NULL != pipe->trList)
+            }
+            if (NULL != pipe->trList)
+            {
+                switch (pipe->pipeCommon.pipeType)
                 {
-                    switch (pipe->pipeCommon.pipeType)
-                    {
-                        case USB_ENDPOINT_BULK:
-                            (void)USB_HostIp3516HsWriteBulkPipe(usbHostState, pipe, pipe->trList);
-                            break;
+                    case USB_ENDPOINT_BULK:
+                        (void)USB_HostIp3516HsWriteBulkPipe(usbHostState, pipe, pipe->trList);
+                        break;
 
-                        case USB_ENDPOINT_CONTROL:
-                            (void)USB_HostIp3516HsWriteControlPipe(usbHostState, pipe, pipe->trList);
-                            break;
+                    case USB_ENDPOINT_CONTROL:
+                        (void)USB_HostIp3516HsWriteControlPipe(usbHostState, pipe, pipe->trList);
+                        break;
 
 #if ((defined(USB_HOST_CONFIG_IP3516HS_MAX_ISO)) && (USB_HOST_CONFIG_IP3516HS_MAX_ISO > 0U))
-                        case USB_ENDPOINT_ISOCHRONOUS:
-                            (void)USB_HostIp3516HsWriteIsoPipe(usbHostState, pipe, pipe->trList);
-                            break;
+                    case USB_ENDPOINT_ISOCHRONOUS:
+                        (void)USB_HostIp3516HsWriteIsoPipe(usbHostState, pipe, pipe->trList);
+                        break;
 #endif
 
 #if ((defined(USB_HOST_CONFIG_IP3516HS_MAX_INT)) && (USB_HOST_CONFIG_IP3516HS_MAX_INT > 0U))
-                        case USB_ENDPOINT_INTERRUPT:
-                            (void)USB_HostIp3516HsWriteInterruptPipe(usbHostState, pipe, pipe->trList);
-                            break;
+                    case USB_ENDPOINT_INTERRUPT:
+                        (void)USB_HostIp3516HsWriteInterruptPipe(usbHostState, pipe, pipe->trList);
+                        break;
 #endif
 
-                        default:
-                            /*no action*/
-                            break;
-                    }
+                    default:
+                        /*no action*/
+                        break;
                 }
             }
         }
+    }
+}
+
+static usb_status_t USB_HostIp3516HsTokenDone(usb_host_ip3516hs_state_struct_t *usbHostState)
+{
+    usb_host_ip3516hs_pipe_struct_t *pipe;
+    void *temp;
+
+    /* Enter critical */
+    USB_HostIp3516HsLock();
+    USB_HostOhciDisableIsr(usbHostState);
+    pipe = usbHostState->pipeListInUsing;
+    while (NULL != pipe)
+    {
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+        if (0U == pipe->isrCompletion) /* the pipe's transfers are completed in the ISR */
+#endif
+        {
+            USB_HostIp3516HsPipeTokenDone(usbHostState, pipe);
+        }
         temp = (void *)pipe->pipeCommon.next;
         pipe = (usb_host_ip3516hs_pipe_struct_t *)temp;
     }
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    /* the buffers that are released by the ISR completion */
+    USB_HostIp3516HsCheckGetBufferFailedPipe(usbHostState);
+#endif
     USB_HostOhciEnableIsr(usbHostState);
     USB_HostIp3516HsUnlock();
     return kStatus_USB_Success;
 }
 
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+static usb_status_t USB_HostIp3516HsEventRingDone(usb_host_ip3516hs_state_struct_t *usbHostState)
+{
+    usb_host_event_record_t recordList[USB_HOST_EVENT_RING_BATCH];
+    usb_host_ip3516hs_pipe_struct_t *pipe;
+    uint32_t recordCount;
+    uint32_t index;
+    void *temp;
+
+    if (0U != USB_HostEventRingOverflow(&usbHostState->eventRing))
+    {
+        /* the records are dropped, check all the pipes */
+        return USB_HostIp3516HsTokenDone(usbHostState);
+    }
+
+    /* Enter critical */
+    USB_HostIp3516HsLock();
+    USB_HostOhciDisableIsr(usbHostState);
+    do
+    {
+        recordCount = USB_HostEventRingDrain(&usbHostState->eventRing, &recordList[0], USB_HOST_EVENT_RING_BATCH);
+        for (index = 0U; index < recordCount; ++index)
+        {
+            temp = (void *)recordList[index].pipe;
+            pipe = (usb_host_ip3516hs_pipe_struct_t *)temp;
+            /* the pipe may be closed after the record is pushed */
+            if (0U != pipe->pipeCommon.open)
+            {
+                USB_HostIp3516HsPipeTokenDone(usbHostState, pipe);
+            }
+        }
+    } while (recordCount == USB_HOST_EVENT_RING_BATCH);
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    /* the buffers that are released by the ISR completion */
+    USB_HostIp3516HsCheckGetBufferFailedPipe(usbHostState);
+#endif
+    USB_HostOhciEnableIsr(usbHostState);
+    USB_HostIp3516HsUnlock();
+    return kStatus_USB_Success;
+}
+#endif
+
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+static void USB_HostIp3516HsTimeoutWheelDisarm(usb_host_ip3516hs_state_struct_t *usbHostState,
+                                               usb_host_transfer_t *transfer)
+{
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    USB_HostTimeoutWheelRemove(&usbHostState->timeoutWheel, transfer);
+    OSA_EXIT_CRITICAL();
+}
+
+static usb_status_t USB_HostIp3516HsSof(usb_host_ip3516hs_state_struct_t *usbHostState)
+{
+    usb_host_ip3516hs_pipe_struct_t *pipe;
+    usb_host_transfer_t *transfer;
+    usb_host_transfer_t *nextTransfer;
+    usb_host_transfer_t *searchTransfer;
+    uint32_t ticks;
+    OSA_SR_ALLOC();
+
+    /* Enter critical */
+    USB_HostIp3516HsLock();
+    OSA_ENTER_CRITICAL();
+    ticks = usbHostState->timeoutWheelSof / (USB_HOST_TIMEOUT_WHEEL_TICK_MS * 8U);
+    usbHostState->timeoutWheelSof -= ticks * USB_HOST_TIMEOUT_WHEEL_TICK_MS * 8U;
+    transfer = USB_HostTimeoutWheelAdvance(&usbHostState->timeoutWheel, ticks);
+    OSA_EXIT_CRITICAL();
+
+    while (NULL != transfer)
+    {
+        nextTransfer          = transfer->timeoutNext;
+        transfer->timeoutNext = NULL;
+        pipe                  = (usb_host_ip3516hs_pipe_struct_t *)(void *)transfer->transferPipe;
+        /* the transfer may be done or cancelled after it expires */
+        searchTransfer = pipe->trList;
+        while ((NULL != searchTransfer) && (searchTransfer != transfer))
+        {
+            searchTransfer = searchTransfer->next;
+        }
+        if (NULL == searchTransfer)
+        {
+            /* no action */
+        }
+        else if (transfer != pipe->trList)
+        {
+            /* the transfer doesn't start, check it again in the next tick */
+            OSA_ENTER_CRITICAL();
+            USB_HostTimeoutWheelAdd(&usbHostState->timeoutWheel, transfer, USB_HOST_TIMEOUT_WHEEL_TICK_MS);
+            OSA_EXIT_CRITICAL();
+        }
+        else if (0U == transfer->timeoutStarted)
+        {
+            /* the previous transfers are done, the timeout is counted from now */
+            OSA_ENTER_CRITICAL();
+            transfer->timeoutStarted = 1U;
+            USB_HostTimeoutWheelAdd(&usbHostState->timeoutWheel, transfer,
+                                    USB_HostTransferTimeout(transfer, pipe->pipeCommon.pipeType));
+            OSA_EXIT_CRITICAL();
+        }
+        else
+        {
+            transfer->union1.transferResult = (int)kStatus_USB_TransferFailed;
+            (void)USB_HostIp3516HsCancelPipe(usbHostState, pipe, transfer);
+        }
+        transfer = nextTransfer;
+    }
+
+    /* the tick source keeps running when the metrics are enabled, it is their frame number sampling tick */
+#if !((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    OSA_ENTER_CRITICAL();
+#if ((defined USB_HOST_CONFIG_HUB) && (USB_HOST_CONFIG_HUB) && (defined(USB_HOST_CONFIG_HUB_ENGINE)) && \
+     (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+    /* the tick source keeps running for the HUB port debounce */
+    if ((USB_HostTimeoutWheelIsIdle(&usbHostState->timeoutWheel)) &&
+        (0U == USB_HostHubEngineTimerPending(usbHostState->hostHandle)))
+#else
+    if (USB_HostTimeoutWheelIsIdle(&usbHostState->timeoutWheel))
+#endif
+    {
+        /* no pending transfer, stop the tick source */
+        usbHostState->usbRegBase->USBINTR &= ~USB_HOST_IP3516HS_USBINTR_SOF_E_MASK;
+    }
+    OSA_EXIT_CRITICAL();
+#endif
+    /* Exit critical */
+    USB_HostIp3516HsUnlock();
+
+    return kStatus_USB_Success;
+}
+#else
 static usb_status_t USB_HostIp3516HsSof(usb_host_ip3516hs_state_struct_t *usbHostState)
 {
     usb_host_ip3516hs_pipe_struct_t *pipe;
@@ -3237,11 +3550,19 @@ static usb_status_t USB_HostIp3516HsSof(usb_host_ip3516hs_state_struct_t *usbHos
         {
             if (NULL != pipe->trList)
             {
-                pipe->cutOffTime--;
                 if (0U == pipe->cutOffTime)
                 {
-                    pipe->trList->union1.transferResult = (int)kStatus_USB_TransferFailed;
-                    (void)USB_HostIp3516HsCancelPipe(usbHostState, pipe, pipe->trList);
+                    /* the transfer becomes the first one of the pipe, its timeout is counted from now */
+                    pipe->cutOffTime = USB_HOST_IP3516HS_TRANSFER_TIMEOUT_GAP(pipe->trList, pipe->pipeCommon.pipeType);
+                }
+                else
+                {
+                    pipe->cutOffTime--;
+                    if (0U == pipe->cutOffTime)
+                    {
+                        pipe->trList->union1.transferResult = (int)kStatus_USB_TransferFailed;
+                        (void)USB_HostIp3516HsCancelPipe(usbHostState, pipe, pipe->trList);
+                    }
                 }
             }
         }
@@ -3253,6 +3574,7 @@ static usb_status_t USB_HostIp3516HsSof(usb_host_ip3516hs_state_struct_t *usbHos
 
     return kStatus_USB_Success;
 }
+#endif
 
 static usb_status_t USB_HostIp3516HsControllerReset(usb_host_ip3516hs_state_struct_t *usbHostState)
 {
@@ -3371,8 +3693,15 @@ static usb_status_t USB_HostIp3516HsControllerInit(usb_host_ip3516hs_state_struc
 
     usbHostState->usbRegBase->USBSTS = 0xFFFFFFFFU;
 
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U)) && \
+    !((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    /* the SOF interrupt is enabled by the timeout wheel when there is pending control/bulk transfer */
+    usbHostState->usbRegBase->USBINTR = interruptState | USB_HOST_IP3516HS_USBINTR_PCDE_MASK;
+#else
+    /* the SOF is also the frame number sampling tick of the metrics, it keeps running */
     usbHostState->usbRegBase->USBINTR =
         interruptState | USB_HOST_IP3516HS_USBINTR_PCDE_MASK | USB_HOST_IP3516HS_USBINTR_SOF_E_MASK;
+#endif
 
 /* On RT600, there is no attach information when LS device is connected, the designer said it is due to the default
  * turnaround time is too small, the 0x654 is their suggested value. */
@@ -3430,6 +3759,13 @@ usb_status_t USB_HostIp3516HsCreate(uint8_t controllerId,
 
     usbHostState->usbRegBase    = (usb_host_ip3516hs_register_struct_t *)usb_base_addrs[usbHostState->controllerId];
     usbHostState->isrNumber     = (uint8_t)usb_irq[usbHostState->controllerId];
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+    USB_HostTimeoutWheelInit(&usbHostState->timeoutWheel);
+    usbHostState->timeoutWheelSof = 0U;
+#endif
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+    USB_HostEventRingInit(&usbHostState->eventRing);
+#endif
     usbHostState->ip3516HsEvent = (osa_event_handle_t)&usbHostState->taskEventHandleBuffer[0];
     if (KOSA_StatusSuccess != OSA_EventCreate(usbHostState->ip3516HsEvent, 1U))
     {
@@ -3564,7 +3900,10 @@ usb_status_t USB_HostIp3516HsOpenPipe(usb_host_controller_handle controllerHandl
     pipe->pipeCommon.currentCount    = 0U;
     pipe->pipeCommon.open            = 1U;
     pipe->tdIndex                    = 0xFFU;
-    pipe->cutOffTime                 = USB_HOST_IP3516HS_TRANSFER_TIMEOUT_GAP;
+    pipe->cutOffTime                 = 0U;
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    pipe->isrCompletion = 0U;
+#endif
     pipe->startUFrame                = 0U;
     pipe->csSlot                     = 0U;
     pipe->isBusy                     = 0U;
@@ -3728,6 +4067,29 @@ usb_status_t USB_HostIp3516HsWritePipe(usb_host_controller_handle controllerHand
         }
         trPre->next = transfer;
     }
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+    if ((USB_ENDPOINT_CONTROL == pipe->pipeCommon.pipeType) || (USB_ENDPOINT_BULK == pipe->pipeCommon.pipeType))
+    {
+        if (USB_HostTimeoutWheelIsIdle(&usbHostState->timeoutWheel))
+        {
+            /* SOF is the tick source of the wheel, it is only enabled when there are pending transfers */
+            usbHostState->timeoutWheelSof = 0U;
+            usbHostState->usbRegBase->USBINTR |= USB_HOST_IP3516HS_USBINTR_SOF_E_MASK;
+        }
+        if (transfer == pipe->trList)
+        {
+            transfer->timeoutStarted = 1U;
+            USB_HostTimeoutWheelAdd(&usbHostState->timeoutWheel, transfer,
+                                    USB_HostTransferTimeout(transfer, pipe->pipeCommon.pipeType));
+        }
+        else
+        {
+            /* the timeout is counted after the previous transfers are done, check it in the next tick */
+            transfer->timeoutStarted = 0U;
+            USB_HostTimeoutWheelAdd(&usbHostState->timeoutWheel, transfer, USB_HOST_TIMEOUT_WHEEL_TICK_MS);
+        }
+    }
+#endif
     OSA_EXIT_CRITICAL();
 
 #if ((defined(USB_HOST_CONFIG_IP3516HS_MAX_ISO)) && (USB_HOST_CONFIG_IP3516HS_MAX_ISO > 0U))
@@ -3931,6 +4293,23 @@ usb_status_t USB_HostIp3516HsIoctl(usb_host_controller_handle controllerHandle,
         case kUSB_HostTestModeInit: /* test mode control */
             USB_HostIp3516HsTestModeInit((usb_host_device_instance_t *)ioctlParam);
             break;
+#endif
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+        case kUSB_HostSetPipeIsrCompletion:
+            pipe = (usb_host_ip3516hs_pipe_struct_t *)ioctlParam;
+            /* only the interrupt pipe is supported, the others are completed in the task */
+            if ((NULL != pipe) && (USB_ENDPOINT_INTERRUPT == pipe->pipeCommon.pipeType))
+            {
+                USB_HostOhciDisableIsr(usbHostState);
+                pipe->isrCompletion = 1U;
+                USB_HostIp3516HsPipeTokenDone(usbHostState, pipe); /* the transfer that is done before */
+                USB_HostOhciEnableIsr(usbHostState);
+            }
+            else
+            {
+                status = kStatus_USB_NotSupported;
+            }
+            break;
 #endif
         default:
             status = kStatus_USB_NotSupported;
@@ -3957,6 +4336,14 @@ void USB_HostIp3516HsTaskFunction(void *hostHandle)
         {
             (void)USB_HostIp3516HsPortChange(usbHostState);
         }
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+        if (0U != (bitSet & (USB_HOST_IP3516HS_EVENT_ISO_TOKEN_DONE | USB_HOST_IP3516HS_EVENT_INT_TOKEN_DONE |
+                             USB_HOST_IP3516HS_EVENT_ATL_TOKEN_DONE)))
+        {
+            /* only the pipes of the done records are processed */
+            (void)USB_HostIp3516HsEventRingDone(usbHostState);
+        }
+#else
         if (0U != (bitSet & USB_HOST_IP3516HS_EVENT_ISO_TOKEN_DONE))
         {
             (void)USB_HostIp3516HsTokenDone(usbHostState);
@@ -3969,9 +4356,19 @@ void USB_HostIp3516HsTaskFunction(void *hostHandle)
         {
             (void)USB_HostIp3516HsTokenDone(usbHostState);
         }
+#endif
         if (0U != (bitSet & USB_HOST_IP3516HS_EVENT_SOF))
         {
             (void)USB_HostIp3516HsSof(usbHostState);
+#if ((defined USB_HOST_CONFIG_HUB) && (USB_HOST_CONFIG_HUB) && (defined(USB_HOST_CONFIG_HUB_ENGINE)) && \
+     (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+            /* the HUB ports whose debounce time expires are checked */
+            USB_HostHubEngineTimer(usbHostState->hostHandle);
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+            /* sample the frame number for the transfer latency of the metrics */
+            USB_HostMetricsTimer(usbHostState->hostHandle);
+#endif
         }
         if (0U != (bitSet & USB_HOST_IP3516HS_EVENT_ATTACH))
         {
@@ -4006,7 +4403,9 @@ void USB_HostIp3516HsIsrFunction(void *hostHandle)
 {
     usb_host_ip3516hs_state_struct_t *usbHostState;
     static uint32_t interruptStatus = 0U;
-    static uint32_t sofCount        = 0U;
+#if !((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+    static uint32_t sofCount = 0U;
+#endif
 
     if (hostHandle == NULL)
     {
@@ -4042,6 +4441,14 @@ void USB_HostIp3516HsIsrFunction(void *hostHandle)
 
     if (0U != (interruptStatus & USB_HOST_IP3516HS_USBSTS_SOF_IRQ_MASK)) /* SOF interrupt */
     {
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+        /* count micro-frames, the task advances the timeout wheel with the elapsed ticks */
+        usbHostState->timeoutWheelSof += (USB_SPEED_HIGH == usbHostState->portState->portSpeed) ? 1U : 8U;
+        if (usbHostState->timeoutWheelSof >= (USB_HOST_TIMEOUT_WHEEL_TICK_MS * 8U))
+        {
+            (void)OSA_EventSet(usbHostState->ip3516HsEvent, USB_HOST_IP3516HS_EVENT_SOF);
+        }
+#else
         if (USB_SPEED_HIGH == usbHostState->portState->portSpeed)
         {
             sofCount++;
@@ -4055,6 +4462,7 @@ void USB_HostIp3516HsIsrFunction(void *hostHandle)
             sofCount = 0U;
             (void)OSA_EventSet(usbHostState->ip3516HsEvent, USB_HOST_IP3516HS_EVENT_SOF);
         }
+#endif
     }
 
     if (0U != (interruptStatus & USB_HOST_IP3516HS_USBINTR_PCDE_MASK)) /* port change detect interrupt */
@@ -512,8 +512,14 @@ typedef struct _usb_host_ip3516hs_td_struct
 
 /*! @brief Transfer scan interval (ms)*/
 #define USB_HOST_IP3516HS_TRANSFER_SCAN_INTERVAL (200U)
-/*! @brief Time out gap for each transfer (USB_HOST_OHCI_TRANSFER_SCAN_INTERVAL * 1ms) */
-#define USB_HOST_IP3516HS_TRANSFER_TIMEOUT_GAP ((5000U * 8U) / USB_HOST_IP3516HS_TRANSFER_SCAN_INTERVAL)
+/*! @brief Transfer scan interval (unit: ms), USB_HOST_IP3516HS_TRANSFER_SCAN_INTERVAL counts micro-frames */
+#define USB_HOST_IP3516HS_TRANSFER_SCAN_MS (USB_HOST_IP3516HS_TRANSFER_SCAN_INTERVAL / 8U)
+/*! @brief Time out gap of the transfer (USB_HOST_IP3516HS_TRANSFER_SCAN_MS * 1ms), it is loaded when the transfer
+ * becomes the first one of the pipe */
+#define USB_HOST_IP3516HS_TRANSFER_TIMEOUT_GAP(transfer, pipeType)                                               \
+    ((uint16_t)MIN((USB_HostTransferTimeout((transfer), (pipeType)) + USB_HOST_IP3516HS_TRANSFER_SCAN_MS - 1U) / \
+                       USB_HOST_IP3516HS_TRANSFER_SCAN_MS,                                                       \
+                   0xFFFFU))
 
 #define USB_HOST_IP3516HS_CONTROL_PIPE_MAX_TRANSFER_LENGTH 64U
 
@@ -583,6 +589,9 @@ typedef struct _usb_host_ip3516hs_pipe_struct
     uint8_t csSlot;
     uint8_t tdIndex;
     volatile uint8_t isBusy;
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    uint8_t isrCompletion; /*!< 1 - the pipe's transfers are completed in the ISR */
+#endif
 } usb_host_ip3516hs_pipe_struct_t;
 
 /*! @brief IP3516HS controller driver instance structure */
@@ -606,6 +615,13 @@ typedef struct _usb_host_ip3516hs_state_struct
     osa_mutex_handle_t mutex;                                        /*!< Ip3516Hs layer mutex*/
     uint32_t mutexBuffer[(OSA_MUTEX_HANDLE_SIZE + 3) / 4];
     usb_host_ip3516hs_pipe_struct_t pipePool[USB_HOST_CONFIG_IP3516HS_MAX_PIPE];
+#if ((defined(USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL)) && (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL > 0U))
+    usb_host_timeout_wheel_t timeoutWheel; /*!< Control/bulk transfer timeout wheel*/
+    volatile uint32_t timeoutWheelSof;     /*!< Micro-frame count that is not processed by the wheel*/
+#endif
+#if ((defined(USB_HOST_CONFIG_EVENT_RING)) && (USB_HOST_CONFIG_EVENT_RING > 0U))
+    usb_host_event_ring_t eventRing; /*!< The done records from the ISR to the task*/
+#endif
     uint8_t controllerId;      /*!< Controller id */
     uint8_t portNumber;        /*!< Port count */
     uint8_t isrNumber;         /*!< ISR Number */
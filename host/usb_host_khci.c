@@ -12,6 +12,11 @@
 #include "usb_host_hci.h"
 #include "fsl_device_registers.h"
 #include "usb_host_khci.h"
+#if ((defined USB_HOST_CONFIG_HUB) && (USB_HOST_CONFIG_HUB) && (defined(USB_HOST_CONFIG_HUB_ENGINE)) && \
+     (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+#include "usb_host_hub.h"
+#include "usb_host_hub_app.h"
+#endif
 #include "usb_host_devices.h"
 #include "usb_host_framework.h"
 /*******************************************************************************
@@ -104,6 +109,36 @@ static uint32_t _USB_HostKhciGetFrameCountSum(usb_khci_host_state_struct_t *usbH
     return (frameNumber + totalFrameNumber);
 }
 
+/*!
+ * @brief check whether the transfer times out.
+ *
+ * The control/bulk transfer's own timeout (usb_host_transfer_t::timeout) is counted from the submission and the data
+ * progress doesn't extend it, KHCI schedules every transfer from the submission.
+ *
+ * @param usbHostPointer     Pointer of the host KHCI state structure.
+ * @param transfer           Pointer of transfer node struct.
+ * @param defaultTimeout     The timeout (ms) when the transfer doesn't have its own timeout, 0 means no timeout.
+ *
+ * @return 1 if the transfer times out, otherwise 0.
+ */
+static uint8_t _USB_HostKhciTransferTimeout(usb_khci_host_state_struct_t *usbHostPointer,
+                                            usb_host_transfer_t *transfer,
+                                            uint32_t defaultTimeout)
+{
+    uint32_t timeout = defaultTimeout;
+
+    if ((0U != transfer->timeout) && ((transfer->transferPipe->pipeType == USB_ENDPOINT_CONTROL) ||
+                                      (transfer->transferPipe->pipeType == USB_ENDPOINT_BULK)))
+    {
+        timeout = transfer->timeout;
+    }
+    if ((0U != timeout) && ((_USB_HostKhciGetFrameCountSum(usbHostPointer) - transfer->union2.frame) > timeout))
+    {
+        return 1U;
+    }
+    return 0U;
+}
+
 /*!
  * @brief host khci delay.
  *
@@ -168,7 +203,7 @@ void USB_HostKhciIsrFunction(void *hostHandle)
 
         if (0U != (status & USB_ISTAT_TOKDNE_MASK))
         {
-            /* atom transaction done - token done */
+            /* atom transaction done - token done, it is waited by the transfer process directly */
             (void)OSA_EventSet(usbHostPointer->khciEventPointer, USB_KHCI_EVENT_TOK_DONE);
         }
 
@@ -692,10 +727,45 @@ static void _USB_HostKhciProcessTrCallback(usb_host_controller_handle controller
         }
     }
 
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    USB_HostMetricsTransferDone(((usb_khci_host_state_struct_t *)controllerHandle)->hostHandle, transfer, status);
+#endif
     /* callback function is different from the current condition */
     transfer->callbackFn(transfer->callbackParam, transfer, status);
 }
 
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+/*!
+ * @brief khci ISO packet done process function.
+ *
+ * The result of the current packet is recorded in its descriptor, the transfer is done after the last packet.
+ *
+ * @param usbHostPointer         Pointer of the host khci controller handle.
+ * @param transfer               Pointer of the transfer that has the ISO packet descriptors.
+ */
+static void _USB_HostKhciIsoPacketDone(usb_khci_host_state_struct_t *usbHostPointer, usb_host_transfer_t *transfer)
+{
+    int32_t transferResult = transfer->union1.transferResult;
+
+    if (transferResult >= 0)
+    {
+        USB_HostIsoPacketDone(transfer, transfer->isoPacketIndex, (uint32_t)transferResult, kStatus_USB_Success);
+    }
+    else
+    {
+        USB_HostIsoPacketDone(transfer, transfer->isoPacketIndex, 0U, kStatus_USB_TransferFailed);
+    }
+    transfer->isoPacketIndex++;
+
+    if (transfer->isoPacketIndex >= transfer->isoPacketCount)
+    {
+        _USB_HostKhciUnlinkTrRequestFromList(usbHostPointer, transfer);
+        /* the packet errors are in the descriptors */
+        _USB_HostKhciProcessTrCallback(usbHostPointer, transfer, 0);
+    }
+}
+#endif
+
 /*!
  * @brief khci transaction done process function.
  *
@@ -1044,6 +1114,7 @@ static khci_tr_state_t _USB_HostKhciStartTranfer(usb_host_controller_handle hand
 {
     static int32_t transferResult;
     uint8_t *buf;
+    uint32_t length;
     usb_khci_host_state_struct_t *usbHostPointer = (usb_khci_host_state_struct_t *)handle;
 
     if (transfer->transferPipe->pipeType == USB_ENDPOINT_CONTROL)
@@ -1101,11 +1172,23 @@ static khci_tr_state_t _USB_HostKhciStartTranfer(usb_host_controller_handle hand
     }
     else
     {
-        buf = transfer->transferBuffer;
-        buf += transfer->transferSofar;
+        buf    = transfer->transferBuffer;
+        length = transfer->transferLength - transfer->transferSofar;
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+        if (NULL != transfer->isoPacketDescriptor)
+        {
+            /* one ISO packet in each service interval */
+            buf += transfer->isoPacketDescriptor[transfer->isoPacketIndex].offset;
+            length = transfer->isoPacketDescriptor[transfer->isoPacketIndex].length;
+        }
+        else
+#endif
+        {
+            buf += transfer->transferSofar;
+        }
         transferResult = _USB_HostKhciAtomNonblockingTransaction(
             usbHostPointer, (transfer->transferPipe->direction == USB_IN) ? (uint32_t)kTr_In : (uint32_t)kTr_Out,
-            transfer->transferPipe, buf, transfer->transferLength - transfer->transferSofar);
+            transfer->transferPipe, buf, length);
     }
 
     transfer->union1.transferResult = transferResult;
@@ -1191,10 +1274,16 @@ static khci_tr_state_t _USB_HostKhciFinishTranfer(usb_host_controller_handle han
             }
             else
             {
-                if ((_USB_HostKhciGetFrameCountSum(usbHostPointer) - transfer->union2.frame) > transfer->nakTimeout)
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                USB_HostMetricsRecordEvent(transfer->transferPipe, kUSB_HostMetricsNak);
+#endif
+                if (0U != _USB_HostKhciTransferTimeout(usbHostPointer, transfer, transfer->nakTimeout))
                 {
                     usbHostPointer->trState         = (uint32_t)kKhci_TrTransmitDone;
                     transfer->union1.transferResult = USB_KHCI_ATOM_TR_BUS_TIMEOUT;
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                    USB_HostMetricsRecordEvent(transfer->transferPipe, kUSB_HostMetricsTimeout);
+#endif
                 }
                 else
                 {
@@ -1208,6 +1297,16 @@ static khci_tr_state_t _USB_HostKhciFinishTranfer(usb_host_controller_handle han
             usbHostPointer->trState = (uint32_t)kKhci_TrTransmitDone;
         }
     }
+    if (((uint32_t)kKhci_TrStartTransmit == usbHostPointer->trState) &&
+        (0U != _USB_HostKhciTransferTimeout(usbHostPointer, transfer, 0U)))
+    {
+        /* the data progress doesn't extend the transfer's own timeout */
+        usbHostPointer->trState         = (uint32_t)kKhci_TrTransmitDone;
+        transfer->union1.transferResult = USB_KHCI_ATOM_TR_BUS_TIMEOUT;
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+        USB_HostMetricsRecordEvent(transfer->transferPipe, kUSB_HostMetricsTimeout);
+#endif
+    }
     return (khci_tr_state_t)usbHostPointer->trState;
 }
 
@@ -1387,13 +1486,22 @@ static void _USB_HostKhciTransferStateMachine(usb_host_controller_handle control
                             if (0U != (eventBit & USB_KHCI_EVENT_TOK_DONE))
                             {
                                 tempTransfer->union1.transferResult = _USB_HostKhciTransactionDone(usbHostPointer, tempTransfer);
-                                if (tempTransfer->union1.transferResult > 0U)
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+                                if (NULL != tempTransfer->isoPacketDescriptor)
                                 {
-                                    tempTransfer->transferSofar += (uint32_t)tempTransfer->union1.transferResult;
+                                    _USB_HostKhciIsoPacketDone(usbHostPointer, tempTransfer);
+                                }
+                                else
+#endif
+                                {
+                                    if (tempTransfer->union1.transferResult > 0U)
+                                    {
+                                        tempTransfer->transferSofar += (uint32_t)tempTransfer->union1.transferResult;
+                                    }
+                                    _USB_HostKhciUnlinkTrRequestFromList(usbHostPointer, tempTransfer);
+                                    _USB_HostKhciProcessTrCallback(usbHostPointer, tempTransfer,
+                                                                   tempTransfer->union1.transferResult);
                                 }
-                                _USB_HostKhciUnlinkTrRequestFromList(usbHostPointer, tempTransfer);
-                                _USB_HostKhciProcessTrCallback(usbHostPointer, tempTransfer,
-                                                               tempTransfer->union1.transferResult);
                                 usbHostPointer->trState = (uint32_t)kKhci_TrGetMsg;
                             }
                         }
@@ -1422,7 +1530,7 @@ static void _USB_HostKhciTransferStateMachine(usb_host_controller_handle control
         case kKhci_TrTransmiting:
             if (transfer != NULL)
             {
-                if ((_USB_HostKhciGetFrameCountSum(usbHostPointer) - transfer->union2.frame) > USB_TIMEOUT_OTHER)
+                if (0U != _USB_HostKhciTransferTimeout(usbHostPointer, transfer, USB_TIMEOUT_OTHER))
                 {
                     if ((transfer->transferPipe->pipeType == USB_ENDPOINT_CONTROL) ||
                         (transfer->transferPipe->pipeType == USB_ENDPOINT_BULK))
@@ -1431,6 +1539,9 @@ static void _USB_HostKhciTransferStateMachine(usb_host_controller_handle control
                         (void)_USB_HostKhciTransactionDone(usbHostPointer, transfer);
                         usbHostPointer->trState         = (uint32_t)kKhci_TrTransmitDone;
                         transfer->union1.transferResult = USB_KHCI_ATOM_TR_BUS_TIMEOUT;
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                        USB_HostMetricsRecordEvent(transfer->transferPipe, kUSB_HostMetricsTimeout);
+#endif
                         return;
                     }
                 }
@@ -1502,6 +1613,15 @@ void USB_HostKhciTaskFunction(void *hostHandle)
                     usbHostPointer->trState = (uint32_t)kKhci_IsoTrGetMsg;
                     _USB_HostKhciTransferStateMachine(usbHostPointer, &transfer);
                 }
+#if ((defined USB_HOST_CONFIG_HUB) && (USB_HOST_CONFIG_HUB) && (defined(USB_HOST_CONFIG_HUB_ENGINE)) && \
+     (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+                /* the HUB ports whose debounce time expires are checked */
+                USB_HostHubEngineTimer(usbHostPointer->hostHandle);
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                /* sample the frame number for the transfer latency of the metrics */
+                USB_HostMetricsTimer(usbHostPointer->hostHandle);
+#endif
             }
         }
         if (0U != (eventBit & USB_KHCI_EVENT_TOK_DONE))
@@ -1979,6 +2099,10 @@ static usb_status_t _USB_HostKhciCancelPipe(usb_host_controller_handle handle,
             ((trPointer == NULL) || (trPointer == temptr)))
         {
             _USB_HostKhciUnlinkTrRequestFromList(handle, temptr);
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+            USB_HostMetricsTransferDone(((usb_khci_host_state_struct_t *)handle)->hostHandle, temptr,
+                                        kStatus_USB_TransferCancel);
+#endif
             /* callback function is different from the current condition */
             temptr->callbackFn(temptr->callbackParam, temptr, kStatus_USB_TransferCancel);
             return kStatus_USB_Success;
@@ -0,0 +1,1022 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "usb_host_config.h"
+#if ((defined USB_HOST_CONFIG_LOOPBACK) && (USB_HOST_CONFIG_LOOPBACK > 0U))
+#include "usb_host.h"
+#include "usb_host_hci.h"
+#include "usb_host_loopback.h"
+#include "usb_host_devices.h"
+/* the transactions are issued to the device loopback controller */
+#include "usb_device_config.h"
+#include "usb_device.h"
+#include "usb_device_dci.h"
+#include "usb_device_loopback.h"
+
+#if !((defined USB_DEVICE_CONFIG_LOOPBACK) && (USB_DEVICE_CONFIG_LOOPBACK > 0U))
+#error The host loopback controller needs the device loopback controller, please enable USB_DEVICE_CONFIG_LOOPBACK.
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief get the bus time.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ *
+ * @return The bus time in ps, 0 if the device loopback instance is not initialized.
+ */
+static uint64_t _USB_HostLoopbackGetBusTime(usb_host_loopback_state_struct_t *loopbackState)
+{
+    usb_device_loopback_statistic_struct_t statistic;
+
+    if (kStatus_USB_Success != USB_DeviceLoopbackGetStatistic(loopbackState->controllerId, &statistic))
+    {
+        return 0U;
+    }
+    return statistic.busTime;
+}
+
+/*!
+ * @brief get the (micro)frame time.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ *
+ * @return The frame time (FS) or the micro-frame time (HS) in ps.
+ */
+static uint32_t _USB_HostLoopbackGetFrameTime(usb_host_loopback_state_struct_t *loopbackState)
+{
+    return (USB_SPEED_HIGH == loopbackState->speed) ? USB_DEVICE_LOOPBACK_HS_FRAME_TIME_PS :
+                                                      USB_DEVICE_LOOPBACK_FS_FRAME_TIME_PS;
+}
+
+/*!
+ * @brief get the bus time in ms, it is used by the timeout.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ *
+ * @return The bus time in ms.
+ */
+static uint32_t _USB_HostLoopbackGetMsec(usb_host_loopback_state_struct_t *loopbackState)
+{
+    return (uint32_t)(_USB_HostLoopbackGetBusTime(loopbackState) / USB_DEVICE_LOOPBACK_FS_FRAME_TIME_PS);
+}
+
+/*!
+ * @brief get how many data can be moved on the pipe in the rest of the frame.
+ *
+ * At least one max packet size is returned, so the transfer always makes progress.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ * @param pipePointer    Pointer of the pipe.
+ * @param frameEnd       The end of the frame in ps.
+ *
+ * @return The data length.
+ */
+static uint32_t _USB_HostLoopbackGetFrameBudget(usb_host_loopback_state_struct_t *loopbackState,
+                                                usb_host_pipe_t *pipePointer,
+                                                uint64_t frameEnd)
+{
+    uint64_t busTime = _USB_HostLoopbackGetBusTime(loopbackState);
+    uint64_t packetTime;
+    uint32_t packets = 0U;
+
+    if (USB_SPEED_HIGH == loopbackState->speed)
+    {
+        packetTime = (uint64_t)pipePointer->maxPacketSize * USB_DEVICE_LOOPBACK_HS_BYTE_TIME_PS +
+                     USB_DEVICE_LOOPBACK_HS_TRANSACTION_TIME_PS;
+    }
+    else
+    {
+        packetTime = (uint64_t)pipePointer->maxPacketSize * USB_DEVICE_LOOPBACK_FS_BYTE_TIME_PS +
+                     USB_DEVICE_LOOPBACK_FS_TRANSACTION_TIME_PS;
+    }
+    if (busTime < frameEnd)
+    {
+        packets = (uint32_t)((frameEnd - busTime) / packetTime);
+    }
+    if (0U == packets)
+    {
+        packets = 1U;
+    }
+    return packets * pipePointer->maxPacketSize;
+}
+
+/*!
+ * @brief check whether the transfer is the first transfer of its pipe in the list.
+ *
+ * The transfers of one pipe are done in the submitting order.
+ *
+ * @param listHead       The list head.
+ * @param transfer       The checked transfer.
+ *
+ * @return 1U if the transfer is the first one, otherwise 0U.
+ */
+static uint8_t _USB_HostLoopbackIsPipeHead(usb_host_transfer_t *listHead, usb_host_transfer_t *transfer)
+{
+    while ((NULL != listHead) && (listHead != transfer))
+    {
+        if (listHead->transferPipe == transfer->transferPipe)
+        {
+            return 0U;
+        }
+        listHead = listHead->next;
+    }
+    return 1U;
+}
+
+/*!
+ * @brief link the transfer to the tail of the periodic or async list.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ * @param transfer       The transfer.
+ */
+static void _USB_HostLoopbackLinkTransfer(usb_host_loopback_state_struct_t *loopbackState,
+                                          usb_host_transfer_t *transfer)
+{
+    usb_host_transfer_t **listHead;
+    usb_host_pipe_t *pipePointer = transfer->transferPipe;
+
+    if ((pipePointer->pipeType == USB_ENDPOINT_ISOCHRONOUS) || (pipePointer->pipeType == USB_ENDPOINT_INTERRUPT))
+    {
+        listHead = &loopbackState->periodicListPointer;
+    }
+    else
+    {
+        listHead = &loopbackState->asyncListPointer;
+    }
+
+    OSA_SR_ALLOC();
+    OSA_ENTER_CRITICAL();
+    transfer->next = NULL;
+    while (NULL != *listHead)
+    {
+        listHead = &((*listHead)->next);
+    }
+    *listHead = transfer;
+    OSA_EXIT_CRITICAL();
+}
+
+/*!
+ * @brief unlink the transfer from the periodic or async list.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ * @param transfer       The transfer.
+ */
+static void _USB_HostLoopbackUnlinkTransfer(usb_host_loopback_state_struct_t *loopbackState,
+                                            usb_host_transfer_t *transfer)
+{
+    usb_host_transfer_t **listHead;
+    usb_host_pipe_t *pipePointer = transfer->transferPipe;
+
+    if ((pipePointer->pipeType == USB_ENDPOINT_ISOCHRONOUS) || (pipePointer->pipeType == USB_ENDPOINT_INTERRUPT))
+    {
+        listHead = &loopbackState->periodicListPointer;
+    }
+    else
+    {
+        listHead = &loopbackState->asyncListPointer;
+    }
+
+    OSA_SR_ALLOC();
+    OSA_ENTER_CRITICAL();
+    while (NULL != *listHead)
+    {
+        if (*listHead == transfer)
+        {
+            *listHead = transfer->next;
+            break;
+        }
+        listHead = &((*listHead)->next);
+    }
+    OSA_EXIT_CRITICAL();
+}
+
+/*!
+ * @brief unlink the transfer and call the transfer callback.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ * @param transfer       The transfer.
+ * @param status         The transfer result.
+ */
+static void _USB_HostLoopbackTransferDone(usb_host_loopback_state_struct_t *loopbackState,
+                                          usb_host_transfer_t *transfer,
+                                          usb_status_t status)
+{
+    uint32_t startCycle;
+
+    _USB_HostLoopbackUnlinkTransfer(loopbackState, transfer);
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+    USB_HostMetricsTransferDone(loopbackState->hostHandle, transfer, status);
+#endif
+    loopbackState->statistic.transfers++;
+    loopbackState->statistic.bytes += transfer->transferSofar;
+
+    startCycle = (uint32_t)USB_DEVICE_LOOPBACK_CYCLE_COUNTER();
+    /* callback function is different from the current condition */
+    transfer->callbackFn(transfer->callbackParam, transfer, status);
+    loopbackState->statistic.stackCycles += (uint32_t)((uint32_t)USB_DEVICE_LOOPBACK_CYCLE_COUNTER() - startCycle);
+}
+
+/*!
+ * @brief cancel all the transfers, it is called when there is no device.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ */
+static void _USB_HostLoopbackTransferClearUp(usb_host_loopback_state_struct_t *loopbackState)
+{
+    usb_host_transfer_t *transfer;
+
+    while (NULL != loopbackState->periodicListPointer)
+    {
+        transfer = loopbackState->periodicListPointer;
+        _USB_HostLoopbackUnlinkTransfer(loopbackState, transfer);
+        transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferCancel);
+    }
+    while (NULL != loopbackState->asyncListPointer)
+    {
+        transfer = loopbackState->asyncListPointer;
+        _USB_HostLoopbackUnlinkTransfer(loopbackState, transfer);
+        transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferCancel);
+    }
+}
+
+/*!
+ * @brief move the data of the transfer.
+ *
+ * @param loopbackState    Pointer of the host loopback state structure.
+ * @param transfer         The transfer.
+ * @param endpointAddress  The endpoint address, bit7 is the direction.
+ * @param budget           The maximum data length moved this time.
+ * @param status           Return the result of the transactions.
+ *
+ * @return 1U if the data moving is done (successfully or not), 0U if it needs to be resumed later.
+ */
+static uint8_t _USB_HostLoopbackMoveData(usb_host_loopback_state_struct_t *loopbackState,
+                                         usb_host_transfer_t *transfer,
+                                         uint8_t endpointAddress,
+                                         uint32_t budget,
+                                         usb_status_t *status)
+{
+    uint32_t length      = transfer->transferLength - transfer->transferSofar;
+    uint32_t transferred = 0U;
+
+    if (length > budget)
+    {
+        length = budget;
+    }
+    *status = USB_DeviceLoopbackHostTransfer(
+        loopbackState->controllerId, endpointAddress,
+        (NULL != transfer->transferBuffer) ? (transfer->transferBuffer + transfer->transferSofar) : NULL, length,
+        &transferred);
+    transfer->transferSofar += transferred;
+
+    if (kStatus_USB_Success == *status)
+    {
+        /* a short packet or the whole length ends the data moving */
+        return ((transferred < length) || (transfer->transferSofar >= transfer->transferLength)) ? 1U : 0U;
+    }
+    /* NAK, or the device is detaching (the transfer is cancelled when the detach is handled) */
+    if ((kStatus_USB_Busy == *status) || (kStatus_USB_Error == *status))
+    {
+        return 0U;
+    }
+    return 1U;
+}
+
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+/*!
+ * @brief move the next ISO packet of the transfer that has the packet descriptors.
+ *
+ * ISO is not retried, the packet that the device does not answer in its service interval is lost and its descriptor
+ * keeps kStatus_USB_TransferCancel.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ * @param transfer       The transfer.
+ *
+ * @return 1U if all the packets are done, 0U if the next packet is moved in the next service interval.
+ */
+static uint8_t _USB_HostLoopbackMoveIsoPacket(usb_host_loopback_state_struct_t *loopbackState,
+                                              usb_host_transfer_t *transfer)
+{
+    usb_host_pipe_t *pipePointer             = transfer->transferPipe;
+    usb_host_iso_packet_descriptor_t *packet = &transfer->isoPacketDescriptor[transfer->isoPacketIndex];
+    uint32_t transferred                     = 0U;
+    usb_status_t status;
+
+    status = USB_DeviceLoopbackHostTransfer(
+        loopbackState->controllerId,
+        pipePointer->endpointAddress |
+            (uint8_t)(pipePointer->direction << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT),
+        (NULL != transfer->transferBuffer) ? (transfer->transferBuffer + packet->offset) : NULL, packet->length,
+        &transferred);
+    if ((kStatus_USB_Success == status) || (kStatus_USB_DataOverRun == status))
+    {
+        USB_HostIsoPacketDone(transfer, transfer->isoPacketIndex, transferred, status);
+    }
+    else if (kStatus_USB_Busy != status)
+    {
+        USB_HostIsoPacketDone(transfer, transfer->isoPacketIndex, 0U, kStatus_USB_TransferFailed);
+    }
+    else
+    {
+        /*no action*/
+    }
+    transfer->isoPacketIndex++;
+
+    return (transfer->isoPacketIndex >= transfer->isoPacketCount) ? 1U : 0U;
+}
+#endif
+
+/*!
+ * @brief do the control transfer stages as far as possible.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ * @param transfer       The transfer.
+ * @param frameEnd       The end of the frame in ps.
+ * @param status         Return the result.
+ *
+ * @return 1U if the transfer is done, 0U if it needs to be resumed later.
+ */
+static uint8_t _USB_HostLoopbackControlTransaction(usb_host_loopback_state_struct_t *loopbackState,
+                                                   usb_host_transfer_t *transfer,
+                                                   uint64_t frameEnd,
+                                                   usb_status_t *status)
+{
+    uint8_t statusDirection = USB_IN;
+
+    if ((uint8_t)kLoopback_StageSetup == transfer->setupStatus)
+    {
+        *status = USB_DeviceLoopbackHostSetup(loopbackState->controllerId, (const uint8_t *)transfer->setupPacket);
+        if (kStatus_USB_Success != *status)
+        {
+            return 0U;
+        }
+        transfer->setupStatus =
+            (uint8_t)((0U != transfer->transferLength) ? kLoopback_StageData : kLoopback_StageStatus);
+    }
+
+    if ((uint8_t)kLoopback_StageData == transfer->setupStatus)
+    {
+        if (0U == _USB_HostLoopbackMoveData(
+                      loopbackState, transfer,
+                      USB_CONTROL_ENDPOINT |
+                          (uint8_t)(transfer->direction << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT),
+                      _USB_HostLoopbackGetFrameBudget(loopbackState, transfer->transferPipe, frameEnd), status))
+        {
+            return 0U;
+        }
+        if (kStatus_USB_Success != *status)
+        {
+            return 1U;
+        }
+        transfer->setupStatus = (uint8_t)kLoopback_StageStatus;
+    }
+
+    /* the status stage is in the opposite direction of the data stage, it is IN if there is no data stage */
+    if ((0U != transfer->transferLength) && (USB_IN == transfer->direction))
+    {
+        statusDirection = USB_OUT;
+    }
+    *status = USB_DeviceLoopbackHostTransfer(
+        loopbackState->controllerId,
+        USB_CONTROL_ENDPOINT | (uint8_t)(statusDirection << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT), NULL, 0U,
+        NULL);
+    if ((kStatus_USB_Busy == *status) || (kStatus_USB_Error == *status))
+    {
+        return 0U;
+    }
+    return 1U;
+}
+
+/*!
+ * @brief process one transfer in the current frame.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ * @param transfer       The transfer.
+ * @param frameEnd       The end of the frame in ps.
+ */
+static void _USB_HostLoopbackProcessTransfer(usb_host_loopback_state_struct_t *loopbackState,
+                                             usb_host_transfer_t *transfer,
+                                             uint64_t frameEnd)
+{
+    usb_host_pipe_t *pipePointer = transfer->transferPipe;
+    usb_status_t status          = kStatus_USB_Success;
+    uint32_t timeout             = 0U;
+    uint32_t budget;
+    uint8_t done;
+
+    /* the transfer is tried once in each frame */
+    transfer->union1.unitHead = loopbackState->frame;
+
+    switch (pipePointer->pipeType)
+    {
+        case USB_ENDPOINT_CONTROL:
+            done = _USB_HostLoopbackControlTransaction(loopbackState, transfer, frameEnd, &status);
+            if (0U == transfer->timeout)
+            {
+                timeout = USB_HOST_LOOPBACK_CONTROL_TIMEOUT;
+            }
+            else
+            {
+                timeout = transfer->timeout;
+            }
+            break;
+
+        case USB_ENDPOINT_BULK:
+            done = _USB_HostLoopbackMoveData(
+                loopbackState, transfer,
+                pipePointer->endpointAddress |
+                    (uint8_t)(pipePointer->direction << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT),
+                _USB_HostLoopbackGetFrameBudget(loopbackState, pipePointer, frameEnd), &status);
+            /* the same NAK timeout as KHCI, nakCount is in ms */
+            if (0U == transfer->timeout)
+            {
+                timeout = pipePointer->nakCount;
+            }
+            else
+            {
+                timeout = transfer->timeout;
+            }
+            break;
+
+        default:
+            /* periodic pipes move the data of one service interval */
+            pipePointer->currentCount = (uint16_t)loopbackState->frame;
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+            if (NULL != transfer->isoPacketDescriptor)
+            {
+                /* one packet in each service interval, the packet results are in the descriptors */
+                done = _USB_HostLoopbackMoveIsoPacket(loopbackState, transfer);
+                break;
+            }
+#endif
+            budget                    = (uint32_t)pipePointer->maxPacketSize *
+                     ((0U != pipePointer->numberPerUframe) ? pipePointer->numberPerUframe : 1U);
+            done = _USB_HostLoopbackMoveData(
+                loopbackState, transfer,
+                pipePointer->endpointAddress |
+                    (uint8_t)(pipePointer->direction << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT),
+                budget, &status);
+            if ((pipePointer->pipeType == USB_ENDPOINT_ISOCHRONOUS) && (0U == done))
+            {
+                /* ISO is not retried, the data of the interval is lost */
+                done   = 1U;
+                status = kStatus_USB_Success;
+            }
+            break;
+    }
+
+    if (0U != done)
+    {
+        _USB_HostLoopbackTransferDone(loopbackState, transfer, status);
+    }
+    else if (kStatus_USB_Busy == status)
+    {
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+        USB_HostMetricsRecordEvent(pipePointer, kUSB_HostMetricsNak);
+#endif
+        if ((0U != timeout) && ((_USB_HostLoopbackGetMsec(loopbackState) - transfer->union2.frame) > timeout))
+        {
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+            USB_HostMetricsRecordEvent(pipePointer, kUSB_HostMetricsTimeout);
+#endif
+            _USB_HostLoopbackTransferDone(loopbackState, transfer, kStatus_USB_TransferFailed);
+        }
+    }
+    else
+    {
+        /*no action*/
+    }
+}
+
+/*!
+ * @brief get the next transfer that can be done in the current frame.
+ *
+ * The periodic transfers whose service interval is due are got first, then the async transfers.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ *
+ * @return The transfer, or NULL if there is no transfer left in this frame.
+ */
+static usb_host_transfer_t *_USB_HostLoopbackGetNextTransfer(usb_host_loopback_state_struct_t *loopbackState)
+{
+    usb_host_transfer_t *transfer;
+    usb_host_pipe_t *pipePointer;
+
+    for (transfer = loopbackState->periodicListPointer; NULL != transfer; transfer = transfer->next)
+    {
+        pipePointer = transfer->transferPipe;
+        if ((transfer->union1.unitHead != loopbackState->frame) &&
+            (0U != _USB_HostLoopbackIsPipeHead(loopbackState->periodicListPointer, transfer)) &&
+            ((0xFFFFU == pipePointer->currentCount) ||
+             ((uint16_t)((uint16_t)loopbackState->frame - pipePointer->currentCount) >= pipePointer->interval)))
+        {
+            return transfer;
+        }
+    }
+    for (transfer = loopbackState->asyncListPointer; NULL != transfer; transfer = transfer->next)
+    {
+        if ((transfer->union1.unitHead != loopbackState->frame) &&
+            (0U != _USB_HostLoopbackIsPipeHead(loopbackState->asyncListPointer, transfer)))
+        {
+            return transfer;
+        }
+    }
+    return NULL;
+}
+
+/*!
+ * @brief handle the device attach.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ */
+static void _USB_HostLoopbackAttach(usb_host_loopback_state_struct_t *loopbackState)
+{
+    usb_device_handle deviceHandle;
+
+    /* debounce, then reset the device to negotiate the speed */
+    (void)USB_DeviceLoopbackHostIdle(loopbackState->controllerId, USB_HOST_LOOPBACK_ATTACH_DEBOUNCE);
+    if (kStatus_USB_Success != USB_DeviceLoopbackBusReset(loopbackState->controllerId, loopbackState->speed))
+    {
+        return;
+    }
+    loopbackState->deviceAttached = 1U;
+    loopbackState->frame =
+        (uint32_t)(_USB_HostLoopbackGetBusTime(loopbackState) / _USB_HostLoopbackGetFrameTime(loopbackState));
+    (void)USB_HostAttachDevice(loopbackState->hostHandle, loopbackState->speed, 0U, 0U, 1U, &deviceHandle);
+}
+
+/*!
+ * @brief handle the device detach.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ */
+static void _USB_HostLoopbackDetach(usb_host_loopback_state_struct_t *loopbackState)
+{
+    loopbackState->deviceAttached = 0U;
+    (void)USB_HostDetachDevice(loopbackState->hostHandle, 0U, 0U);
+    _USB_HostLoopbackTransferClearUp(loopbackState);
+}
+
+/*!
+ * @brief schedule the transfers in one (micro)frame.
+ *
+ * The transfers are scheduled until the bus time of the frame is used up or there is no transfer left, then the bus
+ * time is moved to the next frame.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ */
+static void _USB_HostLoopbackScheduleFrame(usb_host_loopback_state_struct_t *loopbackState)
+{
+    usb_host_transfer_t *transfer;
+    uint32_t frameTime = _USB_HostLoopbackGetFrameTime(loopbackState);
+    uint64_t frameEnd;
+
+    loopbackState->frame = (uint32_t)(_USB_HostLoopbackGetBusTime(loopbackState) / frameTime);
+    frameEnd             = ((uint64_t)loopbackState->frame + 1U) * frameTime;
+
+    while ((0U != loopbackState->deviceAttached) && (_USB_HostLoopbackGetBusTime(loopbackState) < frameEnd))
+    {
+        transfer = _USB_HostLoopbackGetNextTransfer(loopbackState);
+        if (NULL == transfer)
+        {
+            break;
+        }
+        _USB_HostLoopbackProcessTransfer(loopbackState, transfer, frameEnd);
+    }
+
+    if (_USB_HostLoopbackGetBusTime(loopbackState) < frameEnd)
+    {
+        (void)USB_DeviceLoopbackHostIdle(loopbackState->controllerId, 1U);
+    }
+}
+
+/*!
+ * @brief Loopback task function.
+ *
+ * The function schedules the transfers of one (micro)frame.
+ *
+ * @param hostHandle   The host handle.
+ */
+void USB_HostLoopbackTaskFunction(void *hostHandle)
+{
+    usb_host_loopback_state_struct_t *loopbackState;
+    uint8_t attached = 0U;
+
+    if (hostHandle == NULL)
+    {
+        return;
+    }
+
+    loopbackState = (usb_host_loopback_state_struct_t *)(((usb_host_instance_t *)hostHandle)->controllerHandle);
+    if (loopbackState == NULL)
+    {
+        return;
+    }
+
+    if (kStatus_USB_Success != USB_DeviceLoopbackGetAttachStatus(loopbackState->controllerId, &attached))
+    {
+        attached = 0U;
+    }
+    if ((0U != attached) && (0U == loopbackState->deviceAttached))
+    {
+        if (0U != loopbackState->attachEnable)
+        {
+            _USB_HostLoopbackAttach(loopbackState);
+        }
+    }
+    else if ((0U == attached) && (0U != loopbackState->deviceAttached))
+    {
+        _USB_HostLoopbackDetach(loopbackState);
+    }
+    else
+    {
+        /*no action*/
+    }
+
+    if (0U != loopbackState->deviceAttached)
+    {
+        _USB_HostLoopbackScheduleFrame(loopbackState);
+    }
+    else
+    {
+        _USB_HostLoopbackTransferClearUp(loopbackState);
+        loopbackState->frame++;
+    }
+}
+
+/*!
+ * @brief Get the loopback controller statistics.
+ *
+ * @param hostHandle   The host handle.
+ * @param statistic    Return the statistics.
+ *
+ * @retval kStatus_USB_Success              Get successfully.
+ * @retval kStatus_USB_InvalidHandle        The hostHandle is a NULL pointer or it is not a loopback host.
+ */
+usb_status_t USB_HostLoopbackGetStatistic(usb_host_handle hostHandle, usb_host_loopback_statistic_t *statistic)
+{
+    usb_host_instance_t *hostInstance = (usb_host_instance_t *)hostHandle;
+
+    if ((hostHandle == NULL) || (statistic == NULL) || (hostInstance->controllerHandle == NULL) ||
+        (hostInstance->controllerId < (uint8_t)kUSB_ControllerLoopback0) ||
+        (hostInstance->controllerId > (uint8_t)kUSB_ControllerLoopback1))
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    *statistic = ((usb_host_loopback_state_struct_t *)hostInstance->controllerHandle)->statistic;
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief create the USB host loopback instance.
+ *
+ * This function initializes the USB host loopback controller driver.
+ *
+ * @param controllerId      The controller id, kUSB_ControllerLoopback0 or kUSB_ControllerLoopback1.
+ * @param hostHandle        The host level handle.
+ * @param controllerHandle  Return the controller instance handle.
+ *
+ * @retval kStatus_USB_Success              The host is initialized successfully.
+ * @retval kStatus_USB_AllocFail            allocate memory fail.
+ * @retval kStatus_USB_ControllerNotFound   the controller id is not a loopback controller.
+ */
+usb_status_t USB_HostLoopbackCreate(uint8_t controllerId,
+                                    usb_host_handle hostHandle,
+                                    usb_host_controller_handle *controllerHandle)
+{
+    usb_host_loopback_state_struct_t *loopbackState;
+
+    if ((controllerId < (uint8_t)kUSB_ControllerLoopback0) ||
+        ((controllerId - (uint8_t)kUSB_ControllerLoopback0) >= (uint8_t)USB_HOST_CONFIG_LOOPBACK))
+    {
+        return kStatus_USB_ControllerNotFound;
+    }
+
+    loopbackState =
+        (usb_host_loopback_state_struct_t *)OSA_MemoryAllocate(sizeof(usb_host_loopback_state_struct_t));
+    if (NULL == loopbackState)
+    {
+        *controllerHandle = NULL;
+        return kStatus_USB_AllocFail;
+    }
+
+    loopbackState->hostHandle                = hostHandle;
+    loopbackState->pipeDescriptorBasePointer = NULL;
+    loopbackState->periodicListPointer       = NULL;
+    loopbackState->asyncListPointer          = NULL;
+    loopbackState->frame                     = 0U;
+    (void)memset(&loopbackState->statistic, 0, sizeof(loopbackState->statistic));
+    loopbackState->controllerId              = controllerId;
+    loopbackState->speed                     = USB_HOST_LOOPBACK_BUS_SPEED;
+    loopbackState->deviceAttached            = 0U;
+    loopbackState->attachEnable              = 1U;
+
+    *controllerHandle = (usb_host_handle)loopbackState;
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief destroy USB host loopback instance.
+ *
+ * This function de-initialize the USB host loopback controller driver.
+ *
+ * @param controllerHandle  the controller handle.
+ *
+ * @retval kStatus_USB_Success              The host is de-initialized successfully.
+ */
+usb_status_t USB_HostLoopbackDestory(usb_host_controller_handle controllerHandle)
+{
+    OSA_MemoryFree(controllerHandle);
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief open USB host pipe.
+ *
+ * This function open one pipe according to the pipeInitPointer parameter.
+ *
+ * @param controllerHandle   the controller handle.
+ * @param pipeHandlePointer  the pipe handle pointer, it is used to return the pipe handle.
+ * @param pipeInitPointer    it is used to initialize the pipe.
+ *
+ * @retval kStatus_USB_Success           The pipe is opened successfully.
+ * @retval kStatus_USB_AllocFail         allocate memory fail.
+ */
+usb_status_t USB_HostLoopbackOpenPipe(usb_host_controller_handle controllerHandle,
+                                      usb_host_pipe_handle *pipeHandlePointer,
+                                      usb_host_pipe_init_t *pipeInitPointer)
+{
+    usb_host_loopback_state_struct_t *loopbackState = (usb_host_loopback_state_struct_t *)controllerHandle;
+    usb_host_pipe_t *pipePointer;
+    usb_host_pipe_t **pipeList;
+    uint8_t interval;
+
+    pipePointer = (usb_host_pipe_t *)OSA_MemoryAllocate(sizeof(usb_host_pipe_t));
+    if (pipePointer == NULL)
+    {
+        return kStatus_USB_AllocFail;
+    }
+
+    pipePointer->next            = NULL;
+    pipePointer->deviceHandle    = pipeInitPointer->devInstance;
+    pipePointer->endpointAddress = pipeInitPointer->endpointAddress;
+    pipePointer->direction       = pipeInitPointer->direction;
+    pipePointer->maxPacketSize   = pipeInitPointer->maxPacketSize;
+    pipePointer->pipeType        = pipeInitPointer->pipeType;
+    pipePointer->numberPerUframe = pipeInitPointer->numberPerUframe;
+    pipePointer->nakCount        = pipeInitPointer->nakCount;
+    pipePointer->nextdata01      = 0U;
+    pipePointer->open            = (uint8_t)1U;
+    /* the low 16 bits of the frame that the periodic pipe is served last time, 0xFFFF means never */
+    pipePointer->currentCount = 0xffffU;
+
+    /* the service interval in (micro)frame unit */
+    interval = (0U != pipeInitPointer->interval) ? pipeInitPointer->interval : 1U;
+    if ((pipePointer->pipeType == USB_ENDPOINT_ISOCHRONOUS) || (USB_SPEED_HIGH == loopbackState->speed))
+    {
+        pipePointer->interval = (uint16_t)(1UL << (MIN(interval, 16U) - 1U));
+    }
+    else
+    {
+        pipePointer->interval = interval;
+    }
+
+    OSA_SR_ALLOC();
+    OSA_ENTER_CRITICAL();
+    pipeList = &loopbackState->pipeDescriptorBasePointer;
+    while (NULL != *pipeList)
+    {
+        pipeList = &((*pipeList)->next);
+    }
+    *pipeList = pipePointer;
+    OSA_EXIT_CRITICAL();
+
+    *pipeHandlePointer = pipePointer;
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief close USB host pipe.
+ *
+ * This function close one pipe and release the related resources.
+ *
+ * @param controllerHandle  the controller handle.
+ * @param pipeHandle        the closing pipe handle.
+ *
+ * @retval kStatus_USB_Success              The pipe is closed successfully.
+ */
+usb_status_t USB_HostLoopbackClosePipe(usb_host_controller_handle controllerHandle, usb_host_pipe_handle pipeHandle)
+{
+    usb_host_loopback_state_struct_t *loopbackState = (usb_host_loopback_state_struct_t *)controllerHandle;
+    usb_host_pipe_t **pipeList;
+
+    OSA_SR_ALLOC();
+    OSA_ENTER_CRITICAL();
+    pipeList = &loopbackState->pipeDescriptorBasePointer;
+    while (NULL != *pipeList)
+    {
+        if (*pipeList == (usb_host_pipe_t *)pipeHandle)
+        {
+            *pipeList = (*pipeList)->next;
+            OSA_MemoryFree(pipeHandle);
+            break;
+        }
+        pipeList = &((*pipeList)->next);
+    }
+    OSA_EXIT_CRITICAL();
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief send data to pipe.
+ *
+ * This function request to send the transfer to the specified pipe.
+ *
+ * @param controllerHandle  the controller handle.
+ * @param pipeHandle        the sending pipe handle.
+ * @param transfer          the transfer which will be wrote.
+ *
+ * @retval kStatus_USB_Success              send successfully.
+ */
+usb_status_t USB_HostLoopbackWritePipe(usb_host_controller_handle controllerHandle,
+                                       usb_host_pipe_handle pipeHandle,
+                                       usb_host_transfer_t *transfer)
+{
+    usb_host_loopback_state_struct_t *loopbackState = (usb_host_loopback_state_struct_t *)controllerHandle;
+
+    transfer->transferPipe  = (usb_host_pipe_t *)pipeHandle;
+    transfer->transferSofar = 0U;
+    transfer->setupStatus   = (uint8_t)kLoopback_StageSetup;
+    /* union1 is the frame that the transfer is tried last time, union2 is the submitting time in ms */
+    transfer->union1.unitHead = loopbackState->frame - 1U;
+    transfer->union2.frame    = _USB_HostLoopbackGetMsec(loopbackState);
+
+    _USB_HostLoopbackLinkTransfer(loopbackState, transfer);
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief receive data from pipe.
+ *
+ * This function request to receive the transfer from the specified pipe.
+ *
+ * @param controllerHandle the controller handle.
+ * @param pipeHandle       the receiving pipe handle.
+ * @param transfer         the transfer which will be read.
+ *
+ * @retval kStatus_USB_Success              receive successfully.
+ */
+usb_status_t USB_HostLoopbackReadPipe(usb_host_controller_handle controllerHandle,
+                                      usb_host_pipe_handle pipeHandle,
+                                      usb_host_transfer_t *transfer)
+{
+    return USB_HostLoopbackWritePipe(controllerHandle, pipeHandle, transfer);
+}
+
+/*!
+ * @brief cancel pipe's transfers.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ * @param pipePointer    Pointer of the pipe.
+ * @param trPointer      The canceling transfer, NULL means all the transfers of the pipe.
+ *
+ * @return kStatus_USB_Success or error codes.
+ */
+static usb_status_t _USB_HostLoopbackCancelPipe(usb_host_loopback_state_struct_t *loopbackState,
+                                                usb_host_pipe_t *pipePointer,
+                                                usb_host_transfer_t *trPointer)
+{
+    usb_host_transfer_t *transfer;
+
+    if ((pipePointer->pipeType == USB_ENDPOINT_ISOCHRONOUS) || (pipePointer->pipeType == USB_ENDPOINT_INTERRUPT))
+    {
+        transfer = loopbackState->periodicListPointer;
+    }
+    else
+    {
+        transfer = loopbackState->asyncListPointer;
+    }
+
+    while (transfer != NULL)
+    {
+        if ((transfer->transferPipe == pipePointer) && ((trPointer == NULL) || (trPointer == transfer)))
+        {
+            _USB_HostLoopbackUnlinkTransfer(loopbackState, transfer);
+            /* callback function is different from the current condition */
+            transfer->callbackFn(transfer->callbackParam, transfer, kStatus_USB_TransferCancel);
+            return kStatus_USB_Success;
+        }
+        transfer = transfer->next;
+    }
+
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief loopback bus control.
+ *
+ * @param loopbackState  Pointer of the host loopback state structure.
+ * @param busControl     Bus control code.
+ *
+ * @return kStatus_USB_Success or error codes.
+ */
+static usb_status_t _USB_HostLoopbackBusControl(usb_host_loopback_state_struct_t *loopbackState, uint8_t busControl)
+{
+    usb_status_t status                   = kStatus_USB_Success;
+    usb_host_bus_control_t busControlCode = (usb_host_bus_control_t)busControl;
+
+    if (busControlCode == kUSB_HostBusReset)
+    {
+        status = USB_DeviceLoopbackBusReset(loopbackState->controllerId, loopbackState->speed);
+    }
+    else if (busControlCode == kUSB_HostBusRestart)
+    {
+        /* the device is attached again in the next task function call */
+        loopbackState->deviceAttached = 0U;
+    }
+    else if (busControlCode == kUSB_HostBusEnableAttach)
+    {
+        loopbackState->attachEnable = 1U;
+    }
+    else if (busControlCode == kUSB_HostBusDisableAttach)
+    {
+        loopbackState->attachEnable = 0U;
+    }
+    else
+    {
+        /*no action*/
+    }
+
+    return status;
+}
+
+/*!
+ * @brief io control loopback.
+ *
+ * This function implemented loopback io control.
+ *
+ * @param controllerHandle  the controller handle.
+ * @param ioctlEvent        please reference to enumeration host_busControl_t.
+ * @param ioctlParam        the control parameter.
+ *
+ * @retval kStatus_USB_Success                io control successfully.
+ * @retval kStatus_USB_InvalidHandle          The controllerHandle is a NULL pointer.
+ * @retval kStatus_USB_NotSupported           The control code is not supported.
+ */
+usb_status_t USB_HostLoopbackIoctl(usb_host_controller_handle controllerHandle, uint32_t ioctlEvent, void *ioctlParam)
+{
+    usb_host_loopback_state_struct_t *loopbackState = (usb_host_loopback_state_struct_t *)controllerHandle;
+    usb_status_t status                             = kStatus_USB_Success;
+    usb_host_cancel_param_t *param;
+
+    if (controllerHandle == NULL)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    usb_host_controller_control_t controlCode = (usb_host_controller_control_t)ioctlEvent;
+    switch (controlCode)
+    {
+        case kUSB_HostCancelTransfer:
+            param  = (usb_host_cancel_param_t *)ioctlParam;
+            status = _USB_HostLoopbackCancelPipe(loopbackState, (usb_host_pipe_t *)param->pipeHandle, param->transfer);
+            break;
+
+        case kUSB_HostBusControl:
+            status = _USB_HostLoopbackBusControl(loopbackState, *((uint8_t *)ioctlParam));
+            break;
+
+        case kUSB_HostGetFrameNumber:
+            /* the frame number is in ms like the FS controllers */
+            *((uint32_t *)ioctlParam) = _USB_HostLoopbackGetMsec(loopbackState) & 0x7FFU;
+            break;
+
+        case kUSB_HostUpdateControlEndpointAddress:
+            (void)USB_DeviceLoopbackHostIdle(loopbackState->controllerId,
+                                             (USB_SPEED_HIGH == loopbackState->speed) ?
+                                                 (USB_HOST_LOOPBACK_SET_ADDRESS_RECOVERY * 8U) :
+                                                 USB_HOST_LOOPBACK_SET_ADDRESS_RECOVERY);
+            break;
+
+        case kUSB_HostUpdateControlPacketSize:
+            /* the control pipe's max packet size is updated by the host stack, nothing is cached here */
+            break;
+
+        default:
+            status = kStatus_USB_NotSupported;
+            break;
+    }
+    return status;
+}
+#endif /* USB_HOST_CONFIG_LOOPBACK */
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __USB_HOST_LOOPBACK_H__
+#define __USB_HOST_LOOPBACK_H__
+
+/*******************************************************************************
+ * Loopback driver private structures, enumerations, macros, functions
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The bus speed negotiated with the device loopback controller, USB_SPEED_FULL or USB_SPEED_HIGH */
+#ifndef USB_HOST_LOOPBACK_BUS_SPEED
+#define USB_HOST_LOOPBACK_BUS_SPEED (USB_SPEED_FULL)
+#endif
+
+/*! @brief The attach debounce time in ms before the bus reset */
+#define USB_HOST_LOOPBACK_ATTACH_DEBOUNCE (100U)
+
+/*! @brief The default NAK timeout in ms of the control transfer */
+#define USB_HOST_LOOPBACK_CONTROL_TIMEOUT (5000U)
+
+/*! @brief The SET_ADDRESS recovery time in ms */
+#define USB_HOST_LOOPBACK_SET_ADDRESS_RECOVERY (2U)
+
+/*! @brief The control transfer stages */
+typedef enum _usb_host_loopback_control_stage
+{
+    kLoopback_StageSetup = 0U, /*!< SETUP stage */
+    kLoopback_StageData,       /*!< Data stage */
+    kLoopback_StageStatus,     /*!< Status stage */
+} usb_host_loopback_control_stage_t;
+
+/*! @brief Loopback controller driver instance structure */
+typedef struct _usb_host_loopback_state_struct
+{
+    void *hostHandle;                           /*!< Related host handle*/
+    usb_host_pipe_t *pipeDescriptorBasePointer; /*!< Pipe descriptor base pointer*/
+    usb_host_transfer_t *periodicListPointer;   /*!< Periodic list pointer, which links interrupt and ISO transfers*/
+    usb_host_transfer_t *asyncListPointer;      /*!< Async list pointer, which links control and bulk transfers*/
+    usb_host_loopback_statistic_t statistic;    /*!< Statistics*/
+    uint32_t frame;                             /*!< The (micro)frame being scheduled*/
+    uint8_t controllerId;                       /*!< Controller ID, the same ID as the device loopback controller*/
+    uint8_t speed;                              /*!< Bus speed*/
+    uint8_t deviceAttached;                     /*!< Device attach/detach state*/
+    uint8_t attachEnable;                       /*!< Attach detection is enabled or not*/
+} usb_host_loopback_state_struct_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*!
+ * @name USB host loopback APIs
+ * @{
+ */
+
+/*!
+ * @brief Creates the USB host loopback instance.
+ *
+ * This function initializes the USB host loopback controller driver. The device loopback controller with the same
+ * controller ID is the only device on the bus, it is attached when the device stack runs it.
+ *
+ * @param controllerId      The controller ID, kUSB_ControllerLoopback0 or kUSB_ControllerLoopback1.
+ * @param hostHandle        The host level handle.
+ * @param controllerHandle  Returns the controller instance handle.
+ *
+ * @retval kStatus_USB_Success              The host is initialized successfully.
+ * @retval kStatus_USB_AllocFail            Allocates memory failed.
+ * @retval kStatus_USB_ControllerNotFound   The controller ID is not a loopback controller.
+ */
+extern usb_status_t USB_HostLoopbackCreate(uint8_t controllerId,
+                                           usb_host_handle hostHandle,
+                                           usb_host_controller_handle *controllerHandle);
+
+/*!
+ * @brief Destroys the USB host loopback instance.
+ *
+ * This function deinitializes the USB host loopback controller driver.
+ *
+ * @param controllerHandle  The controller handle.
+ *
+ * @retval kStatus_USB_Success              The host is deinitialized successfully.
+ */
+extern usb_status_t USB_HostLoopbackDestory(usb_host_controller_handle controllerHandle);
+
+/*!
+ * @brief Opens the USB host pipe.
+ *
+ * This function opens a pipe according to the pipeInitPointer parameter.
+ *
+ * @param controllerHandle    The controller handle.
+ * @param pipeHandlePointer   The pipe handle pointer used to return the pipe handle.
+ * @param pipeInitPointer     It is used to initialize the pipe.
+ *
+ * @retval kStatus_USB_Success              The pipe is opened successfully.
+ * @retval kStatus_USB_AllocFail            Allocates memory failed.
+ */
+extern usb_status_t USB_HostLoopbackOpenPipe(usb_host_controller_handle controllerHandle,
+                                             usb_host_pipe_handle *pipeHandlePointer,
+                                             usb_host_pipe_init_t *pipeInitPointer);
+
+/*!
+ * @brief Closes the USB host pipe.
+ *
+ * This function closes a pipe and frees the related resources.
+ *
+ * @param controllerHandle The controller handle.
+ * @param pipeHandle       The closing pipe handle.
+ *
+ * @retval kStatus_USB_Success              The pipe is closed successfully.
+ */
+extern usb_status_t USB_HostLoopbackClosePipe(usb_host_controller_handle controllerHandle,
+                                              usb_host_pipe_handle pipeHandle);
+
+/*!
+ * @brief Sends data to the pipe.
+ *
+ * This function requests to send the transfer to the specified pipe.
+ *
+ * @param controllerHandle The controller handle.
+ * @param pipeHandle       The sending pipe handle.
+ * @param transfer         The transfer information.
+ *
+ * @retval kStatus_USB_Success              Sent successfully.
+ */
+extern usb_status_t USB_HostLoopbackWritePipe(usb_host_controller_handle controllerHandle,
+                                              usb_host_pipe_handle pipeHandle,
+                                              usb_host_transfer_t *transfer);
+
+/*!
+ * @brief Receives data from a pipe.
+ *
+ * This function requests to receive the transfer from the specified pipe.
+ *
+ * @param controllerHandle The controller handle.
+ * @param pipeHandle       The receiving pipe handle.
+ * @param transfer         The transfer information.
+ *
+ * @retval kStatus_USB_Success              Received successfully.
+ */
+extern usb_status_t USB_HostLoopbackReadPipe(usb_host_controller_handle controllerHandle,
+                                             usb_host_pipe_handle pipeHandle,
+                                             usb_host_transfer_t *transfer);
+
+/*!
+ * @brief Controls the loopback controller.
+ *
+ * This function controls the loopback controller.
+ *
+ * @param controllerHandle The controller handle.
+ * @param ioctlEvent       See the enumeration host_bus_control_t.
+ * @param ioctlParam       The control parameter.
+ *
+ * @retval kStatus_USB_Success                Cancel successfully.
+ * @retval kStatus_USB_InvalidHandle          The controllerHandle is a NULL pointer.
+ * @retval kStatus_USB_NotSupported           The control code is not supported.
+ */
+extern usb_status_t USB_HostLoopbackIoctl(usb_host_controller_handle controllerHandle,
+                                          uint32_t ioctlEvent,
+                                          void *ioctlParam);
+
+/*! @}*/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USB_HOST_LOOPBACK_H__ */
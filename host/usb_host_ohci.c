@@ -12,6 +12,11 @@
 #include "usb_host_hci.h"
 #include "fsl_device_registers.h"
 #include "usb_host_ohci.h"
+#if ((defined USB_HOST_CONFIG_HUB) && (USB_HOST_CONFIG_HUB) && (defined(USB_HOST_CONFIG_HUB_ENGINE)) && \
+     (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+#include "usb_host_hub.h"
+#include "usb_host_hub_app.h"
+#endif
 #include "usb_host_devices.h"
 
 /*******************************************************************************
@@ -33,6 +38,10 @@ static usb_status_t USB_HostOhciLinkItdTr(usb_host_ohci_state_struct_t *usbHostS
                                           usb_host_transfer_t *tr);
 static usb_status_t USB_HostOhciFreeItd(usb_host_ohci_state_struct_t *usbHostState,
                                         usb_host_ohci_isochronous_transfer_descritpor_struct_t *itd);
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+static void USB_HostOhciIsoPacketDone(usb_host_transfer_t *tr,
+                                      usb_host_ohci_isochronous_transfer_descritpor_struct_t *itd);
+#endif
 #endif
 static usb_status_t USB_HostOhciLinkGtdTr(usb_host_ohci_state_struct_t *usbHostState,
                                           usb_host_ohci_pipe_struct_t *pipe,
@@ -1042,33 +1051,43 @@ static void USB_HostOhciTdDoneHandle(usb_host_ohci_state_struct_t *usbHostState,
             itdQ = itdP;
             itdP = (usb_host_ohci_isochronous_transfer_descritpor_struct_t *)itdP->nextItd;
         }
-        currentTr->transferSofar = 0U;
-        for (uint32_t i = 0; i <= itd->stateUnion.stateBitField.FC; i++)
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+        if (NULL != currentTr->isoPacketDescriptor)
         {
-            currentTr->transferSofar += ((uint32_t)itd->OffsetPSW[i] & (USB_HOST_OHCI_ITD_TRANSFER_SIZE_MASK));
-            conditionCode = (((uint32_t)itd->OffsetPSW[i] & (USB_HOST_OHCI_ITD_CONDITION_CODE_MASK)) >>
-                             USB_HOST_OHCI_ITD_CONDITION_CODE_SHIFT);
-            if (0U != conditionCode)
+            /* the packet errors are in the descriptors, the transfer result is kept */
+            USB_HostOhciIsoPacketDone(currentTr, itd);
+        }
+        else
+#endif
+        {
+            currentTr->transferSofar = 0U;
+            for (uint32_t i = 0; i <= itd->stateUnion.stateBitField.FC; i++)
             {
-                if (conditionCode != USB_HOST_OHCI_CC_DATA_UNDERRUN)
+                currentTr->transferSofar += ((uint32_t)itd->OffsetPSW[i] & (USB_HOST_OHCI_ITD_TRANSFER_SIZE_MASK));
+                conditionCode = (((uint32_t)itd->OffsetPSW[i] & (USB_HOST_OHCI_ITD_CONDITION_CODE_MASK)) >>
+                                 USB_HOST_OHCI_ITD_CONDITION_CODE_SHIFT);
+                if (0U != conditionCode)
                 {
-                    if (kStatus_USB_Success == (usb_status_t)currentTr->union2.frame)
+                    if (conditionCode != USB_HOST_OHCI_CC_DATA_UNDERRUN)
                     {
-                        if (conditionCode == USB_HOST_OHCI_CC_DATA_OVERRUN)
-                        {
-                            currentTr->union2.frame = (uint32_t)kStatus_USB_DataOverRun;
-                        }
-                        else
+                        if (kStatus_USB_Success == (usb_status_t)currentTr->union2.frame)
                         {
-                            currentTr->union2.frame = (uint32_t)kStatus_USB_Error;
+                            if (conditionCode == USB_HOST_OHCI_CC_DATA_OVERRUN)
+                            {
+                                currentTr->union2.frame = (uint32_t)kStatus_USB_DataOverRun;
+                            }
+                            else
+                            {
+                                currentTr->union2.frame = (uint32_t)kStatus_USB_Error;
+                            }
                         }
                     }
                 }
             }
-        }
-        if (currentTr->direction == USB_OUT)
-        {
-            currentTr->transferSofar = currentTr->transferLength - currentTr->transferSofar;
+            if (currentTr->direction == USB_OUT)
+            {
+                currentTr->transferSofar = currentTr->transferLength - currentTr->transferSofar;
+            }
         }
         (void)USB_HostOhciFreeItd(usbHostState, itd);
     }
@@ -1170,7 +1189,7 @@ static void USB_HostOhciTdDoneHandle(usb_host_ohci_state_struct_t *usbHostState,
 
         if (0U != trIsFound)
         {
-            pipe->cutOffTime = USB_HOST_OHCI_TRANSFER_TIMEOUT_GAP;
+            pipe->cutOffTime = 0U;
 
             if ((kStatus_USB_Success == ((usb_status_t)currentTr->union2.frame)) &&
                 (USB_ENDPOINT_CONTROL == pipe->pipeCommon.pipeType) &&
@@ -1223,6 +1242,9 @@ static void USB_HostOhciTdDoneHandle(usb_host_ohci_state_struct_t *usbHostState,
 #if (defined(USB_HOST_OHCI_DEVICE_NOT_RESPONDING_WORKAROUND) && (USB_HOST_OHCI_DEVICE_NOT_RESPONDING_WORKAROUND))
                 pipe->deviceNotRespondingCount = 0U;
                 pipe->endpointInterval         = 0U;
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                USB_HostMetricsTransferDone(usbHostState->hostHandle, currentTr, (usb_status_t)currentTr->union2.frame);
 #endif
                 currentTr->callbackFn(currentTr->callbackParam, currentTr,
                                       (usb_status_t)currentTr->union2.frame); /* transfer callback */
@@ -1237,7 +1259,12 @@ static void USB_HostOhciTdDoneHandle(usb_host_ohci_state_struct_t *usbHostState,
         {
         }
 
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+        /* the control transfers are linked in the task, not in the ISR completion */
+        if ((0U == usbHostState->controlIsBusy) && (0U == pipe->isrCompletion))
+#else
         if (0U == usbHostState->controlIsBusy)
+#endif
         {
             p = usbHostState->pipeListInUsing;
 
@@ -1396,11 +1423,14 @@ static usb_status_t USB_HostOhciCancelPipe(usb_host_ohci_state_struct_t *usbHost
             }
             else
             {
-                pipe->cutOffTime = USB_HOST_OHCI_TRANSFER_TIMEOUT_GAP;
+                pipe->cutOffTime = 0U;
 
 #if (defined(USB_HOST_OHCI_DEVICE_NOT_RESPONDING_WORKAROUND) && (USB_HOST_OHCI_DEVICE_NOT_RESPONDING_WORKAROUND))
                 pipe->deviceNotRespondingCount = 0U;
                 pipe->endpointInterval         = 0U;
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                USB_HostMetricsTransferDone(usbHostState->hostHandle, trCurrent, kStatus_USB_TransferCancel);
 #endif
                 trCurrent->callbackFn(trCurrent->callbackParam, trCurrent,
                                       kStatus_USB_TransferCancel); /* transfer callback */
@@ -1825,6 +1855,110 @@ static void USB_HostOhciFillItd(usb_host_ohci_pipe_struct_t *pipe,
     itd->length = length;
 }
 
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+/*
+ * The packets of one ITD are the contiguous packets from packetIndex, the packet size is the offset of the next packet
+ * minus its offset. The data of one ITD is in two 4K pages at most.
+ */
+static uint32_t USB_HostOhciGetItdPacketCount(usb_host_transfer_t *tr, uint32_t packetIndex, uint32_t maxPacketCount)
+{
+    usb_host_iso_packet_descriptor_t *isoPacket = &tr->isoPacketDescriptor[packetIndex];
+    uint32_t pageAddress = ((uint32_t)tr->transferBuffer + isoPacket->offset) & USB_HOST_OHCI_ITD_BP0_MASK;
+    uint32_t endOffset   = isoPacket->offset + isoPacket->length;
+    uint32_t packetCount = 1U;
+
+    while ((packetCount < maxPacketCount) && ((packetIndex + packetCount) < tr->isoPacketCount))
+    {
+        isoPacket = &tr->isoPacketDescriptor[packetIndex + packetCount];
+        if (isoPacket->offset != endOffset)
+        {
+            break;
+        }
+        if ((0U != isoPacket->length) &&
+            ((((uint32_t)tr->transferBuffer + isoPacket->offset + isoPacket->length - 1U) &
+              USB_HOST_OHCI_ITD_BP0_MASK) > (pageAddress + 0x1000U)))
+        {
+            break;
+        }
+        endOffset += isoPacket->length;
+        packetCount++;
+    }
+    return packetCount;
+}
+
+static void USB_HostOhciFillIsoPacketItd(usb_host_ohci_pipe_struct_t *pipe,
+                                         usb_host_transfer_t *tr,
+                                         usb_host_ohci_isochronous_transfer_descritpor_struct_t *itd,
+                                         uint32_t packetIndex,
+                                         uint32_t packetCount,
+                                         uint32_t startFrame)
+{
+    usb_host_iso_packet_descriptor_t *isoPacket = &tr->isoPacketDescriptor[packetIndex];
+    uint32_t bufferAddress                      = (uint32_t)tr->transferBuffer + isoPacket->offset;
+    uint32_t length;
+
+    isoPacket = &tr->isoPacketDescriptor[packetIndex + packetCount - 1U];
+    length    = (uint32_t)tr->transferBuffer + isoPacket->offset + isoPacket->length - bufferAddress;
+
+    itd->BP0                         = bufferAddress & USB_HOST_OHCI_ITD_BP0_MASK;
+    itd->BE                          = (0U != length) ? (bufferAddress + length - 1U) : 0U;
+    itd->stateUnion.stateBitField.SF = startFrame & USB_HOST_OHCI_FMNUMBER_FN_MASK;
+    itd->stateUnion.stateBitField.DI = 0U;
+    itd->stateUnion.stateBitField.FC = packetCount - 1U;
+    itd->stateUnion.stateBitField.CC = USB_HOST_OHCI_CC_NOT_ACCESSED;
+    itd->pipe                        = pipe;
+    itd->tr                          = tr;
+    for (uint32_t i = 0; i < packetCount; i++)
+    {
+        bufferAddress     = (uint32_t)tr->transferBuffer + tr->isoPacketDescriptor[packetIndex + i].offset;
+        itd->OffsetPSW[i] = (uint16_t)((bufferAddress & 0xFFFU) | ((uint32_t)USB_HOST_OHCI_CC_NOT_ACCESSED << 12U));
+        if ((bufferAddress & USB_HOST_OHCI_ITD_BP0_MASK) != itd->BP0)
+        {
+            itd->OffsetPSW[i] |= (uint16_t)1UL << 11U;
+        }
+    }
+    itd->length      = length;
+    itd->packetIndex = packetIndex;
+}
+
+static void USB_HostOhciIsoPacketDone(usb_host_transfer_t *tr,
+                                      usb_host_ohci_isochronous_transfer_descritpor_struct_t *itd)
+{
+    usb_host_iso_packet_descriptor_t *isoPacket;
+    uint32_t conditionCode;
+    uint32_t length;
+
+    for (uint32_t i = 0; i <= itd->stateUnion.stateBitField.FC; i++)
+    {
+        isoPacket     = &tr->isoPacketDescriptor[itd->packetIndex + i];
+        length        = ((uint32_t)itd->OffsetPSW[i] & (USB_HOST_OHCI_ITD_TRANSFER_SIZE_MASK));
+        conditionCode = (((uint32_t)itd->OffsetPSW[i] & (USB_HOST_OHCI_ITD_CONDITION_CODE_MASK)) >>
+                         USB_HOST_OHCI_ITD_CONDITION_CODE_SHIFT);
+        /* the size of an OUT packet is 0 if it is sent */
+        if (USB_OUT == tr->direction)
+        {
+            length = isoPacket->length;
+        }
+        if ((USB_HOST_OHCI_CC_NO_ERROR == conditionCode) || (USB_HOST_OHCI_CC_DATA_UNDERRUN == conditionCode))
+        {
+            USB_HostIsoPacketDone(tr, itd->packetIndex + i, length, kStatus_USB_Success);
+        }
+        else if (USB_HOST_OHCI_CC_DATA_OVERRUN == conditionCode)
+        {
+            USB_HostIsoPacketDone(tr, itd->packetIndex + i, length, kStatus_USB_DataOverRun);
+        }
+        else if (USB_HOST_OHCI_CC_NOT_ACCESSED != (conditionCode & USB_HOST_OHCI_CC_NOT_ACCESSED))
+        {
+            USB_HostIsoPacketDone(tr, itd->packetIndex + i, 0U, kStatus_USB_TransferFailed);
+        }
+        else
+        {
+            /* the packet is not sent in its frame */
+        }
+    }
+}
+#endif
+
 static usb_status_t USB_HostOhciLinkItdTr(usb_host_ohci_state_struct_t *usbHostState,
                                           usb_host_ohci_pipe_struct_t *pipe,
                                           usb_host_transfer_t *tr)
@@ -1840,6 +1974,10 @@ static usb_status_t USB_HostOhciLinkItdTr(usb_host_ohci_state_struct_t *usbHostS
     void *temp;
     usb_status_t status;
     uint8_t tansaction = 1U;
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    uint32_t packetIndex;
+    uint32_t packetCount;
+#endif
 
     if (0U == remainingLength)
     {
@@ -1858,6 +1996,24 @@ static usb_status_t USB_HostOhciLinkItdTr(usb_host_ohci_state_struct_t *usbHostS
 #endif
         tansaction = 8U;
     }
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    if (NULL != tr->isoPacketDescriptor)
+    {
+        tdCount = 0U;
+        for (packetIndex = 0U; packetIndex < tr->isoPacketCount; packetIndex += packetCount)
+        {
+            packetCount = USB_HostOhciGetItdPacketCount(tr, packetIndex, tansaction);
+            tdCount++;
+        }
+#if (defined(FSL_FEATURE_USBFSH_VERSION) && (FSL_FEATURE_USBFSH_VERSION >= 200U))
+#else
+        if (1U == pipe->pipeCommon.interval)
+        {
+            tdCount++;
+        }
+#endif
+    }
+#endif
     status = USB_HostOhciGetItd(usbHostState, &p, tdCount);
     if (kStatus_USB_Success != status)
     {
@@ -1876,6 +2032,23 @@ static usb_status_t USB_HostOhciLinkItdTr(usb_host_ohci_state_struct_t *usbHostS
     currentFrame = s_UsbHostOhciHcca[usbHostState->controllerId].HccaFrameNumber;
     startFrame   = currentFrame;
 
+#if ((defined(USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR)) && (USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR > 0U))
+    if (NULL != tr->isoPacketDescriptor)
+    {
+        for (packetIndex = 0U; packetIndex < tr->isoPacketCount; packetIndex += packetCount)
+        {
+            packetCount = USB_HostOhciGetItdPacketCount(tr, packetIndex, tansaction);
+            USB_HostOhciFillIsoPacketItd(pipe, tr, p, packetIndex, packetCount, startFrame);
+            if ((packetIndex + packetCount) < tr->isoPacketCount)
+            {
+                p->nextItd = (usb_host_ohci_isochronous_transfer_descritpor_struct_t *)p->NextTD;
+                p          = p->nextItd;
+                startFrame += packetCount * ((uint32_t)pipe->pipeCommon.interval);
+            }
+        }
+        remainingLength = 0U;
+    }
+#endif
     while (0U != remainingLength)
     {
         tdLength = ((uint32_t)pipe->pipeCommon.maxPacketSize) * ((uint32_t)tansaction);
@@ -1954,6 +2127,50 @@ static usb_status_t USB_HostOhciTokenDone(usb_host_ohci_state_struct_t *usbHostS
     return kStatus_USB_Success;
 }
 
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+/* take the done GTDs of the ISR completion pipes out of the done list and complete them in the ISR */
+static void USB_HostOhciIsrTokenDone(usb_host_ohci_state_struct_t *usbHostState)
+{
+    usb_host_ohci_general_transfer_descritpor_struct_t *gtd;
+    usb_host_ohci_general_transfer_descritpor_struct_t *gtdPos;
+    usb_host_ohci_general_transfer_descritpor_struct_t *gtdPre = NULL;
+    usb_host_ohci_pipe_struct_t *pipe;
+
+    gtd = (usb_host_ohci_general_transfer_descritpor_struct_t *)((uint32_t)usbHostState->tdDoneListHead);
+    while (NULL != gtd)
+    {
+        gtdPos = (usb_host_ohci_general_transfer_descritpor_struct_t *)gtd->NextTD;
+        pipe   = NULL;
+        /* the ITD is placed before the GTD, the ISO pipe isn't completed in the ISR */
+        if (((uint32_t)gtd) >= ((uint32_t)&s_UsbHostOhciTd[usbHostState->controllerId].gtd[0]))
+        {
+            pipe = gtd->pipe;
+        }
+        if ((NULL != pipe) && (0U != pipe->isrCompletion))
+        {
+            if (NULL == gtdPre)
+            {
+                usbHostState->tdDoneListHead = gtdPos;
+            }
+            else
+            {
+                gtdPre->NextTD = (uint32_t)gtdPos;
+            }
+            if (usbHostState->tdDoneListTail == gtd)
+            {
+                usbHostState->tdDoneListTail = gtdPre;
+            }
+            USB_HostOhciTdDoneHandle(usbHostState, pipe, gtd->tr, gtd, NULL);
+        }
+        else
+        {
+            gtdPre = gtd;
+        }
+        gtd = gtdPos;
+    }
+}
+#endif
+
 static usb_status_t USB_HostOhciSof(usb_host_ohci_state_struct_t *usbHostState)
 {
     usb_host_ohci_pipe_struct_t *pipe;
@@ -1976,10 +2193,22 @@ static usb_status_t USB_HostOhciSof(usb_host_ohci_state_struct_t *usbHostState)
         {
             if (NULL != pipe->ed->trListHead)
             {
-                pipe->cutOffTime--;
                 if (0U == pipe->cutOffTime)
                 {
-                    (void)USB_HostOhciCancelPipe(usbHostState, pipe, pipe->ed->trListHead);
+                    /* the transfer becomes the first one of the pipe, its timeout is counted from now */
+                    pipe->cutOffTime =
+                        USB_HOST_OHCI_TRANSFER_TIMEOUT_GAP(pipe->ed->trListHead, pipe->pipeCommon.pipeType);
+                }
+                else
+                {
+                    pipe->cutOffTime--;
+                    if (0U == pipe->cutOffTime)
+                    {
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+                        USB_HostMetricsRecordEvent(pipe->ed->trListHead->transferPipe, kUSB_HostMetricsTimeout);
+#endif
+                        (void)USB_HostOhciCancelPipe(usbHostState, pipe, pipe->ed->trListHead);
+                    }
                 }
             }
         }
@@ -2348,6 +2577,9 @@ usb_status_t USB_HostOhciOpenPipe(usb_host_controller_handle controllerHandle,
     pipe->pipeCommon.nextdata01           = 0U;
     pipe->pipeCommon.currentCount         = 0U;
     pipe->pipeCommon.open                 = 1U;
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    pipe->isrCompletion = 0U;
+#endif
     pipe->ed->stateUnion.stateBitField.EN = pipeInit->endpointAddress;
     pipe->ed->stateUnion.stateBitField.D  = (USB_OUT == pipeInit->direction) ? 1U : 2U;
     pipe->ed->stateUnion.stateBitField.FA = ((usb_host_device_instance_t *)pipeInit->devInstance)->setAddress;
@@ -2363,7 +2595,7 @@ usb_status_t USB_HostOhciOpenPipe(usb_host_controller_handle controllerHandle,
     pipe->ed->trListHead                   = NULL;
     pipe->ed->trListTail                   = NULL;
     pipe->ed->dealTr                       = NULL;
-    pipe->cutOffTime                       = USB_HOST_OHCI_TRANSFER_TIMEOUT_GAP;
+    pipe->cutOffTime                       = 0U;
     pipe->isCanceling                      = 0U;
 #if (defined(USB_HOST_OHCI_DEVICE_NOT_RESPONDING_WORKAROUND) && (USB_HOST_OHCI_DEVICE_NOT_RESPONDING_WORKAROUND))
     pipe->deviceNotRespondingCount = 0U;
@@ -2652,6 +2884,21 @@ usb_status_t USB_HostOhciIoctl(usb_host_controller_handle controllerHandle, uint
         case kUSB_HostPortAttachEnable:
             break;
 
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+        case kUSB_HostSetPipeIsrCompletion:
+            pipe = (usb_host_ohci_pipe_struct_t *)ioctlParam;
+            /* only the interrupt pipe is supported, the others are completed in the task */
+            if ((NULL != pipe) && (USB_ENDPOINT_INTERRUPT == pipe->pipeCommon.pipeType))
+            {
+                pipe->isrCompletion = 1U; /* the GTDs that are in the done list already are completed in the task */
+            }
+            else
+            {
+                status = kStatus_USB_NotSupported;
+            }
+            break;
+#endif
+
         default:
             status = kStatus_USB_NotSupported;
             break;
@@ -2684,6 +2931,15 @@ void USB_HostOhciTaskFunction(void *hostHandle)
         if (0U != (bitSet & USB_HOST_OHCI_EVENT_SOF))
         {
             (void)USB_HostOhciSof(usbHostState);
+#if ((defined USB_HOST_CONFIG_HUB) && (USB_HOST_CONFIG_HUB) && (defined(USB_HOST_CONFIG_HUB_ENGINE)) && \
+     (USB_HOST_CONFIG_HUB_ENGINE > 0U))
+            /* the HUB ports whose debounce time expires are checked */
+            USB_HostHubEngineTimer(usbHostState->hostHandle);
+#endif
+#if ((defined(USB_HOST_CONFIG_METRICS)) && (USB_HOST_CONFIG_METRICS > 0U))
+            /* sample the frame number for the transfer latency of the metrics */
+            USB_HostMetricsTimer(usbHostState->hostHandle);
+#endif
         }
         if (0U != (bitSet & USB_HOST_OHCI_EVENT_ATTACH))
         {
@@ -2734,6 +2990,9 @@ void USB_HostOhciIsrFunction(void *hostHandle)
     if (0U != (interruptStatus & USB_HOST_OHCI_INTERRUPT_STATUS_WDH_MASK)) /* Write back done head */
     {
         USB_HostOhciLinkTdToDoneList(usbHostState);
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+        USB_HostOhciIsrTokenDone(usbHostState);
+#endif
         (void)OSA_EventSet(usbHostState->ohciEvent, USB_HOST_OHCI_EVENT_TOKEN_DONE);
     }
 
@@ -296,7 +296,8 @@ typedef struct _usb_host_ohci_isochronous_transfer_descritpor_struct
     usb_host_transfer_t *tr;
     struct _usb_host_ohci_isochronous_transfer_descritpor_struct *nextItd;
     uint32_t length;
-    uint32_t reserved[4];
+    uint32_t packetIndex; /*!< The first ISO packet descriptor of the ITD */
+    uint32_t reserved[3];
 } usb_host_ohci_isochronous_transfer_descritpor_struct_t;
 
 /*! @brief OHCI Host Controller Communications Area */
@@ -361,8 +362,12 @@ typedef struct _usb_host_ohci_td_struct
 
 /*! @brief Transfer scan interval (ms)*/
 #define USB_HOST_OHCI_TRANSFER_SCAN_INTERVAL (10U)
-/*! @brief Time out gap for each transfer (USB_HOST_OHCI_TRANSFER_SCAN_INTERVAL * 1ms) */
-#define USB_HOST_OHCI_TRANSFER_TIMEOUT_GAP (5000U / USB_HOST_OHCI_TRANSFER_SCAN_INTERVAL)
+/*! @brief Time out gap of the transfer (USB_HOST_OHCI_TRANSFER_SCAN_INTERVAL * 1ms), it is loaded when the transfer
+ * becomes the first one of the pipe. OHCI doesn't use the timeout wheel (USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL), the
+ * SOF scan already runs every USB_HOST_OHCI_TRANSFER_SCAN_INTERVAL. */
+#define USB_HOST_OHCI_TRANSFER_TIMEOUT_GAP(transfer, pipeType)                                         \
+    ((USB_HostTransferTimeout((transfer), (pipeType)) + USB_HOST_OHCI_TRANSFER_SCAN_INTERVAL - 1U) / \
+     USB_HOST_OHCI_TRANSFER_SCAN_INTERVAL)
 
 /*! @brief USB host OHCI lock */
 #define USB_HostOhciLock() (void)OSA_MutexLock(usbHostState->mutex, USB_OSA_WAIT_TIMEOUT)
@@ -428,6 +433,9 @@ typedef struct _usb_host_ohci_pipe_struct
     volatile uint8_t isBusy;
     volatile uint8_t isDone;
     volatile uint8_t isCanceling;
+#if ((defined(USB_HOST_CONFIG_PIPE_ISR_COMPLETION)) && (USB_HOST_CONFIG_PIPE_ISR_COMPLETION > 0U))
+    uint8_t isrCompletion; /*!< 1 - the pipe's transfers are completed in the ISR */
+#endif
 } usb_host_ohci_pipe_struct_t;
 
 typedef enum _usb_host_ohci_transfer_status
@@ -110,6 +110,9 @@ typedef enum _usb_controller_index
     kUSB_ControllerDwc30 = 12U,     /*!< DWC3 0U */
     kUSB_ControllerDwc31 = 13U, /*!< DWC3 1U Currently, there are no platforms which have two Dwc IPs, this is reserved
                               to be used in the future.*/
+    kUSB_ControllerLoopback0 = 14U, /*!< Software loopback controller 0U, no hardware behind it. The host loopback
+                                       controller drives the device loopback controller with the same ID. */
+    kUSB_ControllerLoopback1 = 15U, /*!< Software loopback controller 1U */
 } usb_controller_index_t;
 
 /**
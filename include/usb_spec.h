@@ -50,6 +50,8 @@ typedef struct _usb_setup_struct
 #define USB_DESCRIPTOR_LENGTH_BOS_DESCRIPTOR (5U)
 #define USB_DESCRIPTOR_LENGTH_DEVICE_CAPABILITY_USB20_EXTENSION (0x07U)
 #define USB_DESCRIPTOR_LENGTH_DEVICE_CAPABILITY_SUPERSPEED (0x0AU)
+#define USB_DESCRIPTOR_LENGTH_INTERFACE_ASSOCIATION (0x08U)
+#define USB_DESCRIPTOR_LENGTH_HID (0x09U)
 
 /* USB Device Capability Type Codes */
 #define USB_DESCRIPTOR_TYPE_DEVICE_CAPABILITY_WIRELESS (0x01U)
@@ -74,6 +76,9 @@ typedef struct _usb_setup_struct
 #define USB_DESCRIPTOR_TYPE_HID_REPORT (0x22U)
 #define USB_DESCRIPTOR_TYPE_HID_PHYSICAL (0x23U)
 
+#define USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE (0x24U)
+#define USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_ENDPOINT (0x25U)
+
 #define USB_DESCRIPTOR_TYPE_ENDPOINT_COMPANION (0x30U)
 
 /* USB standard request type */
@@ -296,4 +301,141 @@ typedef union _usb_descriptor_union
     usb_descriptor_endpoint_companion_t endpointCompanion; /* Endpoint companion descriptor */
 } usb_descriptor_union_t;
 
+/* Descriptor builder
+ *
+ * The macros below expand to the bytes of the descriptors, they are used in the initializer of an uint8_t array so
+ * the descriptors are built by the compiler and can be placed in flash. The bLength and wTotalLength fields are
+ * computed from the bytes that follow, they cannot disagree with the content. The multi-byte fields are emitted low
+ * byte first whatever the CPU byte order is. For example, a CDC ACM + HID composite configuration:
+ *
+ *     enum
+ *     {
+ *         CDC_COMM_INTERFACE = 0U,
+ *         HID_INTERFACE      = CDC_COMM_INTERFACE + USB_DESCRIPTOR_CDC_ACM_INTERFACE_COUNT,
+ *         INTERFACE_COUNT,
+ *     };
+ *     #define CDC_NOTIFICATION_ENDPOINT USB_DESCRIPTOR_ENDPOINT_ADDRESS(1U, USB_IN)
+ *     ...
+ *     static const uint8_t s_ConfigurationDescriptor[] = {USB_DESCRIPTOR_CONFIGURATION(
+ *         INTERFACE_COUNT, 1U, 0U, USB_DESCRIPTOR_CONFIGURE_ATTRIBUTE_SELF_POWERED_MASK, 50U,
+ *         USB_DESCRIPTOR_CDC_ACM_FUNCTION(CDC_COMM_INTERFACE, CDC_NOTIFICATION_ENDPOINT, 16U, 8U, CDC_BULK_IN_ENDPOINT,
+ *                                         CDC_BULK_OUT_ENDPOINT, 512U, 0U),
+ *         USB_DESCRIPTOR_INTERFACE(HID_INTERFACE, 0U, 1U, 0x03U, 0x00U, 0x00U, 0U),
+ *         USB_DESCRIPTOR_HID(0x0111U, 0U, sizeof(s_HidReportDescriptor)),
+ *         USB_DESCRIPTOR_ENDPOINT(HID_INTERRUPT_IN_ENDPOINT, USB_ENDPOINT_INTERRUPT, 8U, 4U))};
+ *
+ * The same interface and endpoint constants are used in the usb_device_class_config_list_struct_t of the device, the
+ * array is used as is (sizeof gives its length) by the descriptor callbacks or the device descriptor table.
+ */
+
+/* The byte count of a descriptor byte list */
+#define USB_DESCRIPTOR_LENGTH_OF(...) (sizeof((const uint8_t[]){__VA_ARGS__}))
+
+/* The bytes of a 16-bit and a 32-bit field */
+#define USB_DESCRIPTOR_WORD(n) (uint8_t)((uint32_t)(n)&0xFFU), (uint8_t)(((uint32_t)(n) >> 8U) & 0xFFU)
+#define USB_DESCRIPTOR_DWORD(n)                                                                                        \
+    (uint8_t)((uint32_t)(n)&0xFFU), (uint8_t)(((uint32_t)(n) >> 8U) & 0xFFU),                                          \
+        (uint8_t)(((uint32_t)(n) >> 16U) & 0xFFU), (uint8_t)(((uint32_t)(n) >> 24U) & 0xFFU)
+
+/* The endpoint address of the endpoint number and the direction (USB_IN or USB_OUT) */
+#define USB_DESCRIPTOR_ENDPOINT_ADDRESS(number, direction)                                                             \
+    ((uint8_t)(((uint32_t)(number)&USB_DESCRIPTOR_ENDPOINT_ADDRESS_NUMBER_MASK) |                                      \
+               ((uint32_t)(direction) << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT)))
+
+/* Device descriptor */
+#define USB_DESCRIPTOR_DEVICE(bcdUSB, deviceClass, deviceSubClass, deviceProtocol, maxPacketSize0, idVendor,           \
+                              idProduct, bcdDevice, iManufacturer, iProduct, iSerialNumber, numConfigurations)         \
+    USB_DESCRIPTOR_LENGTH_DEVICE, USB_DESCRIPTOR_TYPE_DEVICE, USB_DESCRIPTOR_WORD(bcdUSB), (uint8_t)(deviceClass),     \
+        (uint8_t)(deviceSubClass), (uint8_t)(deviceProtocol), (uint8_t)(maxPacketSize0),                               \
+        USB_DESCRIPTOR_WORD(idVendor), USB_DESCRIPTOR_WORD(idProduct), USB_DESCRIPTOR_WORD(bcdDevice),                 \
+        (uint8_t)(iManufacturer), (uint8_t)(iProduct), (uint8_t)(iSerialNumber), (uint8_t)(numConfigurations)
+
+/* Device qualifier descriptor */
+#define USB_DESCRIPTOR_DEVICE_QUALIFIER(bcdUSB, deviceClass, deviceSubClass, deviceProtocol, maxPacketSize0,           \
+                                        numConfigurations)                                                             \
+    USB_DESCRIPTOR_LENGTH_DEVICE_QUALITIER, USB_DESCRIPTOR_TYPE_DEVICE_QUALITIER, USB_DESCRIPTOR_WORD(bcdUSB),         \
+        (uint8_t)(deviceClass), (uint8_t)(deviceSubClass), (uint8_t)(deviceProtocol), (uint8_t)(maxPacketSize0),       \
+        (uint8_t)(numConfigurations), 0x00U
+
+/* Configuration descriptor followed by its interface, class-specific and endpoint descriptors, the wTotalLength is
+ * the length of the whole list. The bmAttributes bit 7 is set, maxPower is in 2mA units. */
+#define USB_DESCRIPTOR_CONFIGURATION(numInterfaces, configurationValue, iConfiguration, attributes, maxPower, ...)     \
+    USB_DESCRIPTOR_CONFIGURATION_OF_TYPE(USB_DESCRIPTOR_TYPE_CONFIGURE, numInterfaces, configurationValue,             \
+                                         iConfiguration, attributes, maxPower, __VA_ARGS__)
+#define USB_DESCRIPTOR_OTHER_SPEED_CONFIGURATION(numInterfaces, configurationValue, iConfiguration, attributes,        \
+                                                 maxPower, ...)                                                        \
+    USB_DESCRIPTOR_CONFIGURATION_OF_TYPE(USB_DESCRIPTOR_TYPE_OTHER_SPEED_CONFIGURATION, numInterfaces,                 \
+                                         configurationValue, iConfiguration, attributes, maxPower, __VA_ARGS__)
+#define USB_DESCRIPTOR_CONFIGURATION_OF_TYPE(type, numInterfaces, configurationValue, iConfiguration, attributes,      \
+                                             maxPower, ...)                                                            \
+    USB_DESCRIPTOR_LENGTH_CONFIGURE, (uint8_t)(type),                                                                  \
+        USB_DESCRIPTOR_WORD(USB_DESCRIPTOR_LENGTH_CONFIGURE + USB_DESCRIPTOR_LENGTH_OF(__VA_ARGS__)),                  \
+        (uint8_t)(numInterfaces), (uint8_t)(configurationValue), (uint8_t)(iConfiguration),                            \
+        (uint8_t)(USB_DESCRIPTOR_CONFIGURE_ATTRIBUTE_D7_MASK | (attributes)), (uint8_t)(maxPower), __VA_ARGS__
+
+/* Interface association descriptor */
+#define USB_DESCRIPTOR_INTERFACE_ASSOCIATION(firstInterface, interfaceCount, functionClass, functionSubClass,          \
+                                             functionProtocol, iFunction)                                              \
+    USB_DESCRIPTOR_LENGTH_INTERFACE_ASSOCIATION, USB_DESCRIPTOR_TYPE_INTERFACE_ASSOCIATION, (uint8_t)(firstInterface), \
+        (uint8_t)(interfaceCount), (uint8_t)(functionClass), (uint8_t)(functionSubClass), (uint8_t)(functionProtocol), \
+        (uint8_t)(iFunction)
+
+/* Interface descriptor */
+#define USB_DESCRIPTOR_INTERFACE(interfaceNumber, alternateSetting, numEndpoints, interfaceClass, interfaceSubClass,   \
+                                 interfaceProtocol, iInterface)                                                        \
+    USB_DESCRIPTOR_LENGTH_INTERFACE, USB_DESCRIPTOR_TYPE_INTERFACE, (uint8_t)(interfaceNumber),                        \
+        (uint8_t)(alternateSetting), (uint8_t)(numEndpoints), (uint8_t)(interfaceClass), (uint8_t)(interfaceSubClass), \
+        (uint8_t)(interfaceProtocol), (uint8_t)(iInterface)
+
+/* Endpoint descriptor, the attributes are the transfer type (USB_ENDPOINT_BULK...) and the ISO sync/usage types */
+#define USB_DESCRIPTOR_ENDPOINT(endpointAddress, attributes, maxPacketSize, interval)                                  \
+    USB_DESCRIPTOR_LENGTH_ENDPOINT, USB_DESCRIPTOR_TYPE_ENDPOINT, (uint8_t)(endpointAddress), (uint8_t)(attributes),   \
+        USB_DESCRIPTOR_WORD(maxPacketSize), (uint8_t)(interval)
+
+/* Class-specific descriptor, the bytes after bDescriptorType (the descriptor subtype first) are the arguments. A
+ * class-specific header that has its own total length (UAC, UVC) uses USB_DESCRIPTOR_LENGTH_OF on its sub-list. */
+#define USB_DESCRIPTOR_CLASS_SPECIFIC(descriptorType, ...)                                                             \
+    (uint8_t)(2U + USB_DESCRIPTOR_LENGTH_OF(__VA_ARGS__)), (uint8_t)(descriptorType), __VA_ARGS__
+
+/* HID descriptor with one report descriptor */
+#define USB_DESCRIPTOR_HID(bcdHID, countryCode, reportDescriptorLength)                                                \
+    USB_DESCRIPTOR_LENGTH_HID, USB_DESCRIPTOR_TYPE_HID, USB_DESCRIPTOR_WORD(bcdHID), (uint8_t)(countryCode), 0x01U,    \
+        USB_DESCRIPTOR_TYPE_HID_REPORT, USB_DESCRIPTOR_WORD(reportDescriptorLength)
+
+/* BOS descriptor followed by its device capability descriptors, the wTotalLength is the length of the whole list */
+#define USB_DESCRIPTOR_BOS(numDeviceCaps, ...)                                                                         \
+    USB_DESCRIPTOR_LENGTH_BOS_DESCRIPTOR, USB_DESCRIPTOR_TYPE_BOS,                                                     \
+        USB_DESCRIPTOR_WORD(USB_DESCRIPTOR_LENGTH_BOS_DESCRIPTOR + USB_DESCRIPTOR_LENGTH_OF(__VA_ARGS__)),             \
+        (uint8_t)(numDeviceCaps), __VA_ARGS__
+
+/* USB 2.0 extension device capability descriptor */
+#define USB_DESCRIPTOR_USB20_EXTENSION(attributes)                                                                     \
+    USB_DESCRIPTOR_LENGTH_DEVICE_CAPABILITY_USB20_EXTENSION, USB_DESCRIPTOR_TYPE_DEVICE_CAPABILITY,                    \
+        USB_DESCRIPTOR_TYPE_DEVICE_CAPABILITY_USB20_EXTENSION, USB_DESCRIPTOR_DWORD(attributes)
+
+/* The interfaces used by USB_DESCRIPTOR_CDC_ACM_FUNCTION, the communication interface and the data interface */
+#define USB_DESCRIPTOR_CDC_ACM_INTERFACE_COUNT (2U)
+
+/* CDC ACM function: the interface association, the communication interface with the header, call management, ACM
+ * and union functional descriptors and the notification endpoint, then the data interface (commInterface + 1) with
+ * the bulk endpoints. */
+#define USB_DESCRIPTOR_CDC_ACM_FUNCTION(commInterface, notificationEndpoint, notificationMaxPacketSize,                \
+                                        notificationInterval, bulkInEndpoint, bulkOutEndpoint, bulkMaxPacketSize,      \
+                                        iFunction)                                                                     \
+    USB_DESCRIPTOR_INTERFACE_ASSOCIATION(commInterface, USB_DESCRIPTOR_CDC_ACM_INTERFACE_COUNT, 0x02U, 0x02U, 0x00U,   \
+                                         iFunction),                                                                   \
+        USB_DESCRIPTOR_INTERFACE(commInterface, 0U, 1U, 0x02U, 0x02U, 0x00U, 0U),                                      \
+        USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x00U,                             \
+                                      USB_DESCRIPTOR_WORD(0x0110U)),                                                   \
+        USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x01U, 0x00U,                      \
+                                      (uint8_t)((commInterface) + 1U)),                                                \
+        USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x02U, 0x06U),                     \
+        USB_DESCRIPTOR_CLASS_SPECIFIC(USB_DESCRIPTOR_TYPE_CLASS_SPECIFIC_INTERFACE, 0x06U, (uint8_t)(commInterface),   \
+                                      (uint8_t)((commInterface) + 1U)),                                                \
+        USB_DESCRIPTOR_ENDPOINT(notificationEndpoint, USB_ENDPOINT_INTERRUPT, notificationMaxPacketSize,               \
+                                notificationInterval),                                                                 \
+        USB_DESCRIPTOR_INTERFACE((commInterface) + 1U, 0U, 2U, 0x0AU, 0x00U, 0x00U, 0U),                               \
+        USB_DESCRIPTOR_ENDPOINT(bulkInEndpoint, USB_ENDPOINT_BULK, bulkMaxPacketSize, 0U),                             \
+        USB_DESCRIPTOR_ENDPOINT(bulkOutEndpoint, USB_ENDPOINT_BULK, bulkMaxPacketSize, 0U)
+
 #endif /* __USB_SPEC_H__ */
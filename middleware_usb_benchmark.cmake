@@ -0,0 +1,36 @@
+#Description: USB Loopback Benchmark; user_visible: True
+include_guard(GLOBAL)
+message("middleware_usb_benchmark component is included.")
+
+target_sources(${MCUX_SDK_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/usb_benchmark.c
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/usb_benchmark_audio.c
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/usb_benchmark_audio_device.c
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/usb_benchmark_cdc_acm.c
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/usb_benchmark_cdc_rndis.c
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/usb_benchmark_cdc_rndis_device.c
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/usb_benchmark_hid.c
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/usb_benchmark_msc.c
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/usb_benchmark_video.c
+    ${CMAKE_CURRENT_LIST_DIR}/output/source/device/class/usb_device_audio.c
+    ${CMAKE_CURRENT_LIST_DIR}/output/source/device/class/usb_device_cdc_acm.c
+    ${CMAKE_CURRENT_LIST_DIR}/output/source/device/class/usb_device_cdc_rndis.c
+    ${CMAKE_CURRENT_LIST_DIR}/output/source/device/class/usb_device_hid.c
+    ${CMAKE_CURRENT_LIST_DIR}/output/source/device/class/usb_device_msc.c
+    ${CMAKE_CURRENT_LIST_DIR}/output/source/device/class/usb_device_msc_ufi.c
+    ${CMAKE_CURRENT_LIST_DIR}/output/source/device/class/usb_device_video.c
+)
+
+target_include_directories(${MCUX_SDK_PROJECT_NAME} PUBLIC
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark
+)
+
+
+include(middleware_usb_device_stack_external)
+include(middleware_usb_host_loopback)
+include(middleware_usb_host_msd)
+include(middleware_usb_host_cdc)
+include(middleware_usb_host_cdc_rndis)
+include(middleware_usb_host_hid)
+include(middleware_usb_host_video)
+include(middleware_usb_host_audio)
@@ -0,0 +1,14 @@
+#Description: USB Cache Maintenance; user_visible: True
+include_guard(GLOBAL)
+message("middleware_usb_cache component is included.")
+
+target_sources(${MCUX_SDK_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/cache/usb_cache.c
+)
+
+target_include_directories(${MCUX_SDK_PROJECT_NAME} PUBLIC
+    ${CMAKE_CURRENT_LIST_DIR}/cache
+)
+
+
+include(middleware_usb_common_header)
@@ -18,4 +18,5 @@ if(CONFIG_USE_middleware_usb_device_ip3511hs_LPC54S018M)
     include(middleware_usb_device_ip3511hs_LPC54S018M)
 endif()
 
+include(middleware_usb_cache)
 include(component_osa)
@@ -18,4 +18,5 @@ if(CONFIG_USE_middleware_usb_device_ip3511hs_LPC55S28)
     include(middleware_usb_device_ip3511hs_LPC55S28)
 endif()
 
+include(middleware_usb_cache)
 include(component_osa)
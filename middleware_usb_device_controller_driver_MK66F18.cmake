@@ -18,4 +18,5 @@ if(CONFIG_USE_middleware_usb_device_ehci_MK66F18)
     include(middleware_usb_device_ehci_MK66F18)
 endif()
 
+include(middleware_usb_cache)
 include(component_osa)
@@ -0,0 +1,15 @@
+#Description: USB Device Software Loopback Controller Driver; user_visible: True
+include_guard(GLOBAL)
+message("middleware_usb_device_loopback component is included.")
+
+target_sources(${MCUX_SDK_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/device/usb_device_loopback.c
+)
+
+target_include_directories(${MCUX_SDK_PROJECT_NAME} PUBLIC
+    ${CMAKE_CURRENT_LIST_DIR}/device
+    ${CMAKE_CURRENT_LIST_DIR}/include
+)
+
+
+include(middleware_usb_device_common_header)
@@ -0,0 +1,15 @@
+#Description: USB EHCI Register Level Model; user_visible: True
+include_guard(GLOBAL)
+message("middleware_usb_ehci_model component is included.")
+
+target_sources(${MCUX_SDK_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/model/usb_ehci_model.c
+)
+
+target_include_directories(${MCUX_SDK_PROJECT_NAME} PUBLIC
+    ${CMAKE_CURRENT_LIST_DIR}/model
+    ${CMAKE_CURRENT_LIST_DIR}/include
+)
+
+
+include(middleware_usb_common_header)
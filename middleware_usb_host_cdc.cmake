@@ -10,6 +10,8 @@ target_include_directories(${MCUX_SDK_PROJECT_NAME} PUBLIC
     ${CMAKE_CURRENT_LIST_DIR}/host/class
 )
 
+include(middleware_usb_host_class_engine)
+
 #OR Logic component
 if(${MCUX_DEVICE} STREQUAL "MIMXRT1166_cm7")
     include(middleware_usb_host_stack_MIMXRT1166_cm7)
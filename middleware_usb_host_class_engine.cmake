@@ -0,0 +1,14 @@
+#Description: USB Host Class Engine; user_visible: True
+include_guard(GLOBAL)
+message("middleware_usb_host_class_engine component is included.")
+
+target_sources(${MCUX_SDK_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/host/class/usb_host_class_engine.c
+)
+
+target_include_directories(${MCUX_SDK_PROJECT_NAME} PUBLIC
+    ${CMAKE_CURRENT_LIST_DIR}/host/class
+)
+
+
+include(middleware_usb_host_common_header)
@@ -0,0 +1,16 @@
+#Description: USB Host Software Loopback Controller Driver; user_visible: True
+include_guard(GLOBAL)
+message("middleware_usb_host_loopback component is included.")
+
+target_sources(${MCUX_SDK_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/host/usb_host_loopback.c
+)
+
+target_include_directories(${MCUX_SDK_PROJECT_NAME} PUBLIC
+    ${CMAKE_CURRENT_LIST_DIR}/host
+    ${CMAKE_CURRENT_LIST_DIR}/include
+)
+
+
+include(middleware_usb_host_common_header)
+include(middleware_usb_device_loopback)
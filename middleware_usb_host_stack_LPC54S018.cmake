@@ -24,4 +24,5 @@ if(CONFIG_USE_middleware_usb_host_ohci)
     include(middleware_usb_host_ohci)
 endif()
 
+include(middleware_usb_cache)
 include(component_osa)
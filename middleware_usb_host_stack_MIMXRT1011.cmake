@@ -18,4 +18,5 @@ target_include_directories(${MCUX_SDK_PROJECT_NAME} PUBLIC
 
 
 include(middleware_usb_host_ehci_MIMXRT1011)
+include(middleware_usb_cache)
 include(component_osa)
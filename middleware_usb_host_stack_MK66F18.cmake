@@ -24,4 +24,5 @@ if(CONFIG_USE_middleware_usb_host_khci)
     include(middleware_usb_host_khci)
 endif()
 
+include(middleware_usb_cache)
 include(component_osa)
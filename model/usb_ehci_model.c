@@ -0,0 +1,2132 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !(defined(__linux__) && defined(__x86_64__))
+#error The EHCI model traps the register accesses with the x86_64 Linux signal context, it cannot run on this target.
+#endif
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "usb_ehci_model.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Register offsets of the USBHS block, the same layout as USBHS_Type */
+#define USB_EHCI_MODEL_ID            (0x000U)
+#define USB_EHCI_MODEL_HWGENERAL     (0x004U)
+#define USB_EHCI_MODEL_HWHOST        (0x008U)
+#define USB_EHCI_MODEL_HWDEVICE      (0x00CU)
+#define USB_EHCI_MODEL_GPTIMER0LD    (0x080U)
+#define USB_EHCI_MODEL_GPTIMER0CTL   (0x084U)
+#define USB_EHCI_MODEL_GPTIMER1LD    (0x088U)
+#define USB_EHCI_MODEL_GPTIMER1CTL   (0x08CU)
+#define USB_EHCI_MODEL_HCIVERSION    (0x100U)
+#define USB_EHCI_MODEL_HCSPARAMS     (0x104U)
+#define USB_EHCI_MODEL_HCCPARAMS     (0x108U)
+#define USB_EHCI_MODEL_DCIVERSION    (0x120U)
+#define USB_EHCI_MODEL_DCCPARAMS     (0x124U)
+#define USB_EHCI_MODEL_USBCMD        (0x140U)
+#define USB_EHCI_MODEL_USBSTS        (0x144U)
+#define USB_EHCI_MODEL_USBINTR       (0x148U)
+#define USB_EHCI_MODEL_FRINDEX       (0x14CU)
+#define USB_EHCI_MODEL_DEVICEADDR    (0x154U)
+#define USB_EHCI_MODEL_PERIODICLIST  (0x154U)
+#define USB_EHCI_MODEL_ASYNCLISTADDR (0x158U)
+#define USB_EHCI_MODEL_EPLISTADDR    (0x158U)
+#define USB_EHCI_MODEL_PORTSC1       (0x184U)
+#define USB_EHCI_MODEL_OTGSC         (0x1A4U)
+#define USB_EHCI_MODEL_USBMODE       (0x1A8U)
+#define USB_EHCI_MODEL_EPSETUPSR     (0x1ACU)
+#define USB_EHCI_MODEL_EPPRIME       (0x1B0U)
+#define USB_EHCI_MODEL_EPFLUSH       (0x1B4U)
+#define USB_EHCI_MODEL_EPSR          (0x1B8U)
+#define USB_EHCI_MODEL_EPCOMPLETE    (0x1BCU)
+#define USB_EHCI_MODEL_EPCR0         (0x1C0U)
+#define USB_EHCI_MODEL_EPCR_LAST     (USB_EHCI_MODEL_EPCR0 + 4U * (USB_EHCI_MODEL_DEVICE_ENDPOINTS - 1U))
+
+/* USBCMD */
+#define USB_EHCI_MODEL_USBCMD_RS    (0x00000001U)
+#define USB_EHCI_MODEL_USBCMD_RST   (0x00000002U)
+#define USB_EHCI_MODEL_USBCMD_PSE   (0x00000010U)
+#define USB_EHCI_MODEL_USBCMD_ASE   (0x00000020U)
+#define USB_EHCI_MODEL_USBCMD_IAA   (0x00000040U)
+#define USB_EHCI_MODEL_USBCMD_SUTW  (0x00002000U)
+#define USB_EHCI_MODEL_USBCMD_FS2   (0x00008000U)
+#define USB_EHCI_MODEL_USBCMD_RESET (0x00080000U)
+
+/* USBSTS and USBINTR */
+#define USB_EHCI_MODEL_USBSTS_UI       (0x00000001U)
+#define USB_EHCI_MODEL_USBSTS_UEI      (0x00000002U)
+#define USB_EHCI_MODEL_USBSTS_PCI      (0x00000004U)
+#define USB_EHCI_MODEL_USBSTS_FRI      (0x00000008U)
+#define USB_EHCI_MODEL_USBSTS_SEI      (0x00000010U)
+#define USB_EHCI_MODEL_USBSTS_AAI      (0x00000020U)
+#define USB_EHCI_MODEL_USBSTS_URI      (0x00000040U)
+#define USB_EHCI_MODEL_USBSTS_SRI      (0x00000080U)
+#define USB_EHCI_MODEL_USBSTS_HCH      (0x00001000U)
+#define USB_EHCI_MODEL_USBSTS_PS       (0x00004000U)
+#define USB_EHCI_MODEL_USBSTS_AS       (0x00008000U)
+#define USB_EHCI_MODEL_USBSTS_TI0      (0x01000000U)
+#define USB_EHCI_MODEL_USBSTS_W1C_MASK (0x030D05FFU)
+
+/* PORTSC1 */
+#define USB_EHCI_MODEL_PORTSC1_CCS        (0x00000001U)
+#define USB_EHCI_MODEL_PORTSC1_CSC        (0x00000002U)
+#define USB_EHCI_MODEL_PORTSC1_PE         (0x00000004U)
+#define USB_EHCI_MODEL_PORTSC1_PEC        (0x00000008U)
+#define USB_EHCI_MODEL_PORTSC1_OCC        (0x00000020U)
+#define USB_EHCI_MODEL_PORTSC1_PR         (0x00000100U)
+#define USB_EHCI_MODEL_PORTSC1_HSP        (0x00000200U)
+#define USB_EHCI_MODEL_PORTSC1_PP         (0x00001000U)
+#define USB_EHCI_MODEL_PORTSC1_PSPD_SHIFT (26U)
+#define USB_EHCI_MODEL_PORTSC1_PSPD_MASK  (0x0C000000U)
+#define USB_EHCI_MODEL_PORTSC1_W1C_MASK   (0x0000002AU)
+#define USB_EHCI_MODEL_PORTSC1_RO_MASK    (0x0C000F3FU)
+
+/* OTGSC, the status bits are write 1 to clear, the state bits are read only */
+#define USB_EHCI_MODEL_OTGSC_STATE_MASK  (0x0000FF00U)
+#define USB_EHCI_MODEL_OTGSC_STATUS_MASK (0x007F0000U)
+#define USB_EHCI_MODEL_OTGSC_RESET       (0x00000F00U)
+
+/* USBMODE[CM] */
+#define USB_EHCI_MODEL_USBMODE_CM_MASK   (0x00000003U)
+#define USB_EHCI_MODEL_USBMODE_CM_DEVICE (0x00000002U)
+#define USB_EHCI_MODEL_USBMODE_CM_HOST   (0x00000003U)
+
+/* HCSPARAMS: one port with port power switch, HCCPARAMS: programmable frame list and asynchronous park */
+#define USB_EHCI_MODEL_HCSPARAMS_RESET (0x00000011U)
+#define USB_EHCI_MODEL_HCSPARAMS_PPC   (0x00000010U)
+#define USB_EHCI_MODEL_HCCPARAMS_RESET (0x00000006U)
+/* DCCPARAMS: DEN, DC and HC */
+#define USB_EHCI_MODEL_DCCPARAMS_RESET (0x00000180U | USB_EHCI_MODEL_DEVICE_ENDPOINTS)
+
+/* GPTIMERnCTL */
+#define USB_EHCI_MODEL_GPTIMER_RUN        (0x80000000U)
+#define USB_EHCI_MODEL_GPTIMER_RST        (0x40000000U)
+#define USB_EHCI_MODEL_GPTIMER_MODE       (0x01000000U)
+#define USB_EHCI_MODEL_GPTIMER_COUNT_MASK (0x00FFFFFFU)
+
+/* DEVICEADDR */
+#define USB_EHCI_MODEL_DEVICEADDR_SHIFT  (25U)
+#define USB_EHCI_MODEL_DEVICEADDR_USBADRA (0x01000000U)
+
+/* EPCRn */
+#define USB_EHCI_MODEL_EPCR_RXS        (0x00000001U)
+#define USB_EHCI_MODEL_EPCR_RXT_SHIFT  (2U)
+#define USB_EHCI_MODEL_EPCR_RXR        (0x00000040U)
+#define USB_EHCI_MODEL_EPCR_RXE        (0x00000080U)
+#define USB_EHCI_MODEL_EPCR_TXS        (0x00010000U)
+#define USB_EHCI_MODEL_EPCR_TXT_SHIFT  (18U)
+#define USB_EHCI_MODEL_EPCR_TXR        (0x00400000U)
+#define USB_EHCI_MODEL_EPCR_TXE        (0x00800000U)
+#define USB_EHCI_MODEL_EPCR_TYPE_MASK  (0x00000003U)
+#define USB_EHCI_MODEL_EPCR_TYPE_ISO   (0x00000001U)
+
+/* The link pointer terminate bit and type field */
+#define USB_EHCI_MODEL_T_BIT          (0x00000001U)
+#define USB_EHCI_MODEL_TYPE_MASK      (0x00000006U)
+#define USB_EHCI_MODEL_TYPE_ITD       (0x00000000U)
+#define USB_EHCI_MODEL_TYPE_QH        (0x00000002U)
+#define USB_EHCI_MODEL_TYPE_SITD      (0x00000004U)
+#define USB_EHCI_MODEL_POINTER_MASK   (0xFFFFFFE0U)
+#define USB_EHCI_MODEL_PAGE_MASK      (0xFFFFF000U)
+#define USB_EHCI_MODEL_PAGE_SIZE      (0x1000U)
+#define USB_EHCI_MODEL_PAGE_SHIFT     (12U)
+#define USB_EHCI_MODEL_OFFSET_MASK    (0x00000FFFU)
+
+/* Device dQH words, dQH size, dTD words */
+#define USB_EHCI_MODEL_DQH_CAPABILITIES   (0U)
+#define USB_EHCI_MODEL_DQH_CURRENT        (1U)
+#define USB_EHCI_MODEL_DQH_NEXT           (2U)
+#define USB_EHCI_MODEL_DQH_TOKEN          (3U)
+#define USB_EHCI_MODEL_DQH_PAGE0          (4U)
+#define USB_EHCI_MODEL_DQH_SETUP          (10U)
+#define USB_EHCI_MODEL_DQH_SIZE           (64U)
+#define USB_EHCI_MODEL_DQH_ZLT_DISABLE    (0x20000000U)
+#define USB_EHCI_MODEL_DTD_NEXT           (0U)
+#define USB_EHCI_MODEL_DTD_TOKEN          (1U)
+#define USB_EHCI_MODEL_DTD_PAGE0          (2U)
+#define USB_EHCI_MODEL_DTD_PAGE_COUNT     (5U)
+#define USB_EHCI_MODEL_DTD_SIZE           (28U)
+#define USB_EHCI_MODEL_DTD_ACTIVE         (0x00000080U)
+#define USB_EHCI_MODEL_DTD_BUFFER_ERROR   (0x00000020U)
+#define USB_EHCI_MODEL_DTD_ERROR_MASK     (0x00000068U)
+#define USB_EHCI_MODEL_DTD_IOC            (0x00008000U)
+#define USB_EHCI_MODEL_DTD_TOTAL_SHIFT    (16U)
+#define USB_EHCI_MODEL_DTD_TOTAL_MASK     (0x7FFF0000U)
+
+/* Host QH words, qTD words */
+#define USB_EHCI_MODEL_QH_LINK            (0U)
+#define USB_EHCI_MODEL_QH_CHARACTERISTICS (1U)
+#define USB_EHCI_MODEL_QH_CAPABILITIES    (2U)
+#define USB_EHCI_MODEL_QH_CURRENT         (3U)
+#define USB_EHCI_MODEL_QH_NEXT            (4U)
+#define USB_EHCI_MODEL_QH_ALTERNATE       (5U)
+#define USB_EHCI_MODEL_QH_TOKEN           (6U)
+#define USB_EHCI_MODEL_QH_PAGE0           (7U)
+#define USB_EHCI_MODEL_QH_SIZE            (48U)
+#define USB_EHCI_MODEL_QH_DTC             (0x00004000U)
+#define USB_EHCI_MODEL_QTD_NEXT           (0U)
+#define USB_EHCI_MODEL_QTD_ALTERNATE      (1U)
+#define USB_EHCI_MODEL_QTD_TOKEN          (2U)
+#define USB_EHCI_MODEL_QTD_PAGE0          (3U)
+#define USB_EHCI_MODEL_QTD_PAGE_COUNT     (5U)
+#define USB_EHCI_MODEL_QTD_SIZE           (32U)
+#define USB_EHCI_MODEL_QTD_ACTIVE         (0x00000080U)
+#define USB_EHCI_MODEL_QTD_HALTED         (0x00000040U)
+#define USB_EHCI_MODEL_QTD_BABBLE         (0x00000010U)
+#define USB_EHCI_MODEL_QTD_XACTERR        (0x00000008U)
+#define USB_EHCI_MODEL_QTD_PID_SHIFT      (8U)
+#define USB_EHCI_MODEL_QTD_CERR_SHIFT     (10U)
+#define USB_EHCI_MODEL_QTD_CERR_MASK      (0x00000C00U)
+#define USB_EHCI_MODEL_QTD_CPAGE_SHIFT    (12U)
+#define USB_EHCI_MODEL_QTD_CPAGE_MASK     (0x00007000U)
+#define USB_EHCI_MODEL_QTD_IOC            (0x00008000U)
+#define USB_EHCI_MODEL_QTD_TOTAL_SHIFT    (16U)
+#define USB_EHCI_MODEL_QTD_TOTAL_MASK     (0x7FFF0000U)
+#define USB_EHCI_MODEL_QTD_DT             (0x80000000U)
+
+/* Host iTD words and fields */
+#define USB_EHCI_MODEL_ITD_TRANSACTION0   (1U)
+#define USB_EHCI_MODEL_ITD_PAGE0          (9U)
+#define USB_EHCI_MODEL_ITD_PAGE_COUNT     (7U)
+#define USB_EHCI_MODEL_ITD_SIZE           (64U)
+#define USB_EHCI_MODEL_ITD_ACTIVE         (0x80000000U)
+#define USB_EHCI_MODEL_ITD_BABBLE         (0x20000000U)
+#define USB_EHCI_MODEL_ITD_XACTERR        (0x10000000U)
+#define USB_EHCI_MODEL_ITD_LENGTH_SHIFT   (16U)
+#define USB_EHCI_MODEL_ITD_LENGTH_MASK    (0x0FFF0000U)
+#define USB_EHCI_MODEL_ITD_IOC            (0x00008000U)
+#define USB_EHCI_MODEL_ITD_PG_SHIFT       (12U)
+#define USB_EHCI_MODEL_ITD_DIRECTION_IN   (0x00000800U)
+
+/* Host siTD words and fields */
+#define USB_EHCI_MODEL_SITD_ENDPOINT      (1U)
+#define USB_EHCI_MODEL_SITD_SCHEDULE      (2U)
+#define USB_EHCI_MODEL_SITD_RESULTS       (3U)
+#define USB_EHCI_MODEL_SITD_PAGE0         (4U)
+#define USB_EHCI_MODEL_SITD_PAGE_COUNT    (2U)
+#define USB_EHCI_MODEL_SITD_SIZE          (28U)
+#define USB_EHCI_MODEL_SITD_DIRECTION_IN  (0x80000000U)
+#define USB_EHCI_MODEL_SITD_ACTIVE        (0x00000080U)
+#define USB_EHCI_MODEL_SITD_BABBLE        (0x00000010U)
+#define USB_EHCI_MODEL_SITD_XACTERR       (0x00000008U)
+#define USB_EHCI_MODEL_SITD_TOTAL_SHIFT   (16U)
+#define USB_EHCI_MODEL_SITD_TOTAL_MASK    (0x03FF0000U)
+#define USB_EHCI_MODEL_SITD_PAGE_SELECT   (0x40000000U)
+#define USB_EHCI_MODEL_SITD_IOC           (0x80000000U)
+
+/* The bus tokens, the qTD PID codes */
+#define USB_EHCI_MODEL_PID_OUT   (0U)
+#define USB_EHCI_MODEL_PID_IN    (1U)
+#define USB_EHCI_MODEL_PID_SETUP (2U)
+
+/*! @brief The largest data packet of one transaction */
+#define USB_EHCI_MODEL_MAX_PACKET (1024U)
+
+/*! @brief The x86 trap flag in EFLAGS */
+#define USB_EHCI_MODEL_TRAP_FLAG (0x100U)
+
+/*! @brief Accesses one register from the model side */
+#define USB_EHCI_MODEL_REG(model, offset) ((model)->registers[(offset) >> 2U])
+
+/*! @brief The handshake of one bus transaction */
+typedef enum _usb_ehci_model_handshake
+{
+    kEhciModel_Ack = 0U,     /*!< ACK, or the data packet of an IN */
+    kEhciModel_Nak,          /*!< NAK */
+    kEhciModel_Stall,        /*!< STALL */
+    kEhciModel_Babble,       /*!< The data packet is longer than expected */
+    kEhciModel_NoResponse,   /*!< No handshake, the transaction times out */
+} usb_ehci_model_handshake_t;
+
+/*! @brief The result of one QH visit of the host schedule */
+typedef enum _usb_ehci_model_qh_result
+{
+    kEhciModel_QhIdle = 0U,  /*!< Nothing to do */
+    kEhciModel_QhNak,        /*!< The device NAKed */
+    kEhciModel_QhDone,       /*!< A transaction is done */
+    kEhciModel_QhNoTime,     /*!< Not enough time left in the micro-frame */
+} usb_ehci_model_qh_result_t;
+
+/*! @brief The state of one model instance */
+typedef struct _usb_ehci_model_state_struct
+{
+    volatile uint32_t *registers;                /*!< Model side mapping of the register window */
+    uint8_t *window;                             /*!< Driver side mapping of the register window */
+    usb_ehci_model_isr_t isr;                    /*!< Interrupt service routine */
+    void *isrParam;                              /*!< Interrupt service routine parameter */
+    usb_ehci_model_statistic_struct_t statistic; /*!< Statistics */
+    int32_t timerCount[2];                       /*!< GPTIMER remaining time in us */
+    uint32_t dmaBase;                            /*!< DMA window start */
+    uint32_t dmaLength;                          /*!< DMA window length, 0 means no restriction */
+    uint32_t asyncQh;                            /*!< The QH the asynchronous schedule resumes from, 0 to restart */
+    uint32_t dtdOffset[USB_EHCI_MODEL_DEVICE_ENDPOINTS * 2U]; /*!< Bytes done in the current dTD */
+    uint8_t zltPending[USB_EHCI_MODEL_DEVICE_ENDPOINTS * 2U]; /*!< The dTD is done, the zero length packet is not */
+    uint8_t peer;                                /*!< The connected instance, 0xFF means not connected */
+    uint8_t speed;                               /*!< The bus speed of the connection */
+    uint8_t resetCount;                          /*!< Remaining micro-frames of the device bus reset */
+    uint8_t address;                             /*!< The device address in use */
+    uint8_t addressPending;                      /*!< DEVICEADDR[USBADRA] is set, the address is used later */
+} usb_ehci_model_state_struct_t;
+
+/*! @brief The register access being single stepped */
+typedef struct _usb_ehci_model_trap_struct
+{
+    usb_ehci_model_state_struct_t *model; /*!< The accessed instance, NULL means no access is pending */
+    uint32_t offset;                      /*!< The register offset */
+    uint32_t oldValue;                    /*!< The register value before the access */
+    uint8_t write;                        /*!< The access is a write */
+} usb_ehci_model_trap_struct_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void USB_EhciModelStep(void);
+static void USB_EhciModelDeviceAttach(usb_ehci_model_state_struct_t *device, uint8_t attach);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static usb_ehci_model_state_struct_t s_UsbEhciModelState[USB_EHCI_MODEL_INSTANCE_COUNT];
+static usb_ehci_model_trap_struct_t s_UsbEhciModelTrap;
+static uint8_t *s_UsbEhciModelWindow;
+static uint8_t *s_UsbEhciModelAlias;
+static struct sigaction s_UsbEhciModelSegvAction;
+static struct sigaction s_UsbEhciModelTrapAction;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint8_t USB_EhciModelIsHost(usb_ehci_model_state_struct_t *model)
+{
+    return (uint8_t)((USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBMODE) & USB_EHCI_MODEL_USBMODE_CM_MASK) ==
+                     USB_EHCI_MODEL_USBMODE_CM_HOST);
+}
+
+static uint8_t USB_EhciModelIsDevice(usb_ehci_model_state_struct_t *model)
+{
+    return (uint8_t)((USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBMODE) & USB_EHCI_MODEL_USBMODE_CM_MASK) ==
+                     USB_EHCI_MODEL_USBMODE_CM_DEVICE);
+}
+
+static usb_ehci_model_state_struct_t *USB_EhciModelPeer(usb_ehci_model_state_struct_t *model)
+{
+    if (model->peer >= USB_EHCI_MODEL_INSTANCE_COUNT)
+    {
+        return NULL;
+    }
+    return &s_UsbEhciModelState[model->peer];
+}
+
+/*!
+ * @brief Checks a DMA access against the DMA window.
+ *
+ * @param model   The model instance.
+ * @param address The start address.
+ * @param length  The access length.
+ *
+ * @return 1 if the access is allowed.
+ */
+static uint8_t USB_EhciModelDmaValid(usb_ehci_model_state_struct_t *model, uint32_t address, uint32_t length)
+{
+    if (0U == address)
+    {
+        return 0U;
+    }
+    if (0U == model->dmaLength)
+    {
+        return 1U;
+    }
+    return (uint8_t)((address >= model->dmaBase) &&
+                     (((uint64_t)address + length) <= ((uint64_t)model->dmaBase + model->dmaLength)));
+}
+
+/*!
+ * @brief Gets a data structure the controller fetches by DMA.
+ *
+ * @param model   The model instance.
+ * @param pointer The link pointer, the low 5 bits are ignored.
+ * @param size    The data structure size.
+ *
+ * @return The data structure words, NULL if the address is not valid.
+ */
+static volatile uint32_t *USB_EhciModelFetch(usb_ehci_model_state_struct_t *model, uint32_t pointer, uint32_t size)
+{
+    uint32_t address = pointer & USB_EHCI_MODEL_POINTER_MASK;
+
+    if (0U == USB_EhciModelDmaValid(model, address, size))
+    {
+        model->statistic.descriptorErrors++;
+        return NULL;
+    }
+    return (volatile uint32_t *)(uintptr_t)address;
+}
+
+/*!
+ * @brief Moves a data packet between the bus and a buffer described by a page list.
+ *
+ * @param model     The model instance.
+ * @param pages     The buffer page list, only the page address bits are used.
+ * @param pageCount The page count.
+ * @param position  The byte position from the start of the first page.
+ * @param packet    The data packet.
+ * @param length    The data packet length.
+ * @param toMemory  1 for IN (bus to memory), 0 for OUT.
+ *
+ * @return 1 on success, 0 if the buffer is out of the page list or of the DMA window.
+ */
+static uint8_t USB_EhciModelDmaCopy(usb_ehci_model_state_struct_t *model,
+                                    volatile uint32_t *pages,
+                                    uint32_t pageCount,
+                                    uint32_t position,
+                                    uint8_t *packet,
+                                    uint32_t length,
+                                    uint8_t toMemory)
+{
+    uint32_t page;
+    uint32_t chunk;
+    uint32_t address;
+
+    while (0U != length)
+    {
+        page = position >> USB_EHCI_MODEL_PAGE_SHIFT;
+        if (page >= pageCount)
+        {
+            model->statistic.descriptorErrors++;
+            return 0U;
+        }
+        chunk = USB_EHCI_MODEL_PAGE_SIZE - (position & USB_EHCI_MODEL_OFFSET_MASK);
+        chunk = (chunk > length) ? length : chunk;
+        address = (pages[page] & USB_EHCI_MODEL_PAGE_MASK) | (position & USB_EHCI_MODEL_OFFSET_MASK);
+        if (0U == USB_EhciModelDmaValid(model, address, chunk))
+        {
+            model->statistic.descriptorErrors++;
+            return 0U;
+        }
+        if (0U != toMemory)
+        {
+            (void)memcpy((void *)(uintptr_t)address, packet, chunk);
+        }
+        else
+        {
+            (void)memcpy(packet, (void *)(uintptr_t)address, chunk);
+        }
+        packet += chunk;
+        position += chunk;
+        length -= chunk;
+    }
+    return 1U;
+}
+
+/*!
+ * @brief Puts the registers of one instance in the reset state.
+ *
+ * @param model The model instance.
+ */
+static void USB_EhciModelResetRegisters(usb_ehci_model_state_struct_t *model)
+{
+    uint32_t index;
+
+    for (index = 0U; index < (USB_EHCI_MODEL_WINDOW_SIZE >> 2U); index++)
+    {
+        model->registers[index] = 0U;
+    }
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_ID)          = 0xE461FA05U;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_HWGENERAL)   = 0x00000035U;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_HWHOST)      = 0x10020001U;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_HWDEVICE)    = (USB_EHCI_MODEL_DEVICE_ENDPOINTS << 1U) | 1U;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_HCIVERSION)  = 0x01000040U;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_HCSPARAMS)   = USB_EHCI_MODEL_HCSPARAMS_RESET;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_HCCPARAMS)   = USB_EHCI_MODEL_HCCPARAMS_RESET;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_DCIVERSION)  = 0x00000001U;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_DCCPARAMS)   = USB_EHCI_MODEL_DCCPARAMS_RESET;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBCMD)      = USB_EHCI_MODEL_USBCMD_RESET;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBSTS)      = USB_EHCI_MODEL_USBSTS_HCH;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_OTGSC)       = USB_EHCI_MODEL_OTGSC_RESET;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_EPCR0)       = USB_EHCI_MODEL_EPCR_TXE | USB_EHCI_MODEL_EPCR_RXE;
+    model->timerCount[0]  = 0;
+    model->timerCount[1]  = 0;
+    model->asyncQh        = 0U;
+    model->resetCount     = 0U;
+    model->address        = 0U;
+    model->addressPending = 0U;
+    (void)memset(model->dtdOffset, 0, sizeof(model->dtdOffset));
+    (void)memset(model->zltPending, 0, sizeof(model->zltPending));
+}
+
+/*!
+ * @brief Attaches or detaches the device of a host port.
+ *
+ * @param host   The host mode instance.
+ * @param attach 1 to attach, 0 to detach.
+ */
+static void USB_EhciModelHostPortConnect(usb_ehci_model_state_struct_t *host, uint8_t attach)
+{
+    uint32_t portsc = USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_PORTSC1);
+
+    if (0U != attach)
+    {
+        if ((0U != (portsc & USB_EHCI_MODEL_PORTSC1_CCS)) ||
+            ((0U != (USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_HCSPARAMS) & USB_EHCI_MODEL_HCSPARAMS_PPC)) &&
+             (0U == (portsc & USB_EHCI_MODEL_PORTSC1_PP))))
+        {
+            return;
+        }
+        portsc |= USB_EHCI_MODEL_PORTSC1_CCS | USB_EHCI_MODEL_PORTSC1_CSC;
+    }
+    else
+    {
+        if (0U == (portsc & USB_EHCI_MODEL_PORTSC1_CCS))
+        {
+            return;
+        }
+        if (0U != (portsc & USB_EHCI_MODEL_PORTSC1_PE))
+        {
+            portsc |= USB_EHCI_MODEL_PORTSC1_PEC;
+        }
+        portsc &= ~(USB_EHCI_MODEL_PORTSC1_CCS | USB_EHCI_MODEL_PORTSC1_PE | USB_EHCI_MODEL_PORTSC1_HSP |
+                    USB_EHCI_MODEL_PORTSC1_PSPD_MASK);
+        portsc |= USB_EHCI_MODEL_PORTSC1_CSC;
+    }
+    USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_PORTSC1) = portsc;
+    USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_PCI;
+}
+
+/*!
+ * @brief Updates the host port after the device run/stop state changes.
+ *
+ * @param device The device mode instance.
+ * @param attach 1 if the device pulled up D+, 0 if it released it.
+ */
+static void USB_EhciModelDeviceAttach(usb_ehci_model_state_struct_t *device, uint8_t attach)
+{
+    usb_ehci_model_state_struct_t *host = USB_EhciModelPeer(device);
+
+    if (0U != attach)
+    {
+        USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_PORTSC1) |= USB_EHCI_MODEL_PORTSC1_CCS;
+    }
+    else
+    {
+        USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_PORTSC1) &= ~USB_EHCI_MODEL_PORTSC1_CCS;
+    }
+    if ((NULL != host) && (0U != USB_EhciModelIsHost(host)))
+    {
+        USB_EhciModelHostPortConnect(host, attach);
+    }
+}
+
+/*!
+ * @brief Starts the bus reset of a device mode instance.
+ *
+ * @param device The device mode instance.
+ * @param speed  The bus speed.
+ */
+static void USB_EhciModelDeviceResetStart(usb_ehci_model_state_struct_t *device, uint8_t speed)
+{
+    device->speed          = speed;
+    device->resetCount     = USB_EHCI_MODEL_BUS_RESET_MICROFRAMES;
+    device->address        = 0U;
+    device->addressPending = 0U;
+    USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_PORTSC1) &=
+        ~(USB_EHCI_MODEL_PORTSC1_HSP | USB_EHCI_MODEL_PORTSC1_PSPD_MASK);
+    USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_PORTSC1) |= USB_EHCI_MODEL_PORTSC1_PR;
+    USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_URI;
+}
+
+/*!
+ * @brief Ends the bus reset of a device mode instance.
+ *
+ * @param device The device mode instance.
+ */
+static void USB_EhciModelDeviceResetEnd(usb_ehci_model_state_struct_t *device)
+{
+    uint32_t portsc = USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_PORTSC1) & ~USB_EHCI_MODEL_PORTSC1_PR;
+
+    if (USB_SPEED_HIGH == device->speed)
+    {
+        portsc |= USB_EHCI_MODEL_PORTSC1_HSP | ((uint32_t)USB_SPEED_HIGH << USB_EHCI_MODEL_PORTSC1_PSPD_SHIFT);
+    }
+    USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_PORTSC1) = portsc;
+    USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_PCI;
+}
+
+/*!
+ * @brief Loads a dTD in the overlay of a dQH.
+ *
+ * @param device The device mode instance.
+ * @param dqh    The dQH.
+ * @param index  The dQH index, endpoint * 2 + direction.
+ *
+ * @return 1 if an active dTD is loaded.
+ */
+static uint8_t USB_EhciModelDeviceLoad(usb_ehci_model_state_struct_t *device, volatile uint32_t *dqh, uint8_t index)
+{
+    uint32_t pointer = dqh[USB_EHCI_MODEL_DQH_NEXT];
+    volatile uint32_t *dtd;
+    uint32_t page;
+
+    if (0U != (pointer & USB_EHCI_MODEL_T_BIT))
+    {
+        return 0U;
+    }
+    dtd = USB_EhciModelFetch(device, pointer, USB_EHCI_MODEL_DTD_SIZE);
+    if ((NULL == dtd) || (0U == (dtd[USB_EHCI_MODEL_DTD_TOKEN] & USB_EHCI_MODEL_DTD_ACTIVE)))
+    {
+        return 0U;
+    }
+    dqh[USB_EHCI_MODEL_DQH_CURRENT] = pointer & USB_EHCI_MODEL_POINTER_MASK;
+    dqh[USB_EHCI_MODEL_DQH_NEXT]    = dtd[USB_EHCI_MODEL_DTD_NEXT];
+    dqh[USB_EHCI_MODEL_DQH_TOKEN]   = dtd[USB_EHCI_MODEL_DTD_TOKEN];
+    for (page = 0U; page < USB_EHCI_MODEL_DTD_PAGE_COUNT; page++)
+    {
+        dqh[USB_EHCI_MODEL_DQH_PAGE0 + page] = dtd[USB_EHCI_MODEL_DTD_PAGE0 + page];
+    }
+    device->dtdOffset[index]  = 0U;
+    device->zltPending[index] = 0U;
+    return 1U;
+}
+
+/*!
+ * @brief Primes the endpoints of a device mode instance, the EPPRIME write.
+ *
+ * @param device The device mode instance.
+ * @param bits   The written EPPRIME bits.
+ */
+static void USB_EhciModelDevicePrime(usb_ehci_model_state_struct_t *device, uint32_t bits)
+{
+    volatile uint32_t *dqh;
+    uint32_t bit;
+    uint8_t endpoint;
+    uint8_t direction;
+
+    for (endpoint = 0U; endpoint < USB_EHCI_MODEL_DEVICE_ENDPOINTS; endpoint++)
+    {
+        for (direction = 0U; direction < 2U; direction++)
+        {
+            bit = 1UL << (endpoint + 16U * direction);
+            if ((0U == (bits & bit)) || (0U != (USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_EPSR) & bit)))
+            {
+                continue;
+            }
+            dqh = USB_EhciModelFetch(device,
+                                     USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_EPLISTADDR) +
+                                         ((uint32_t)endpoint * 2U + direction) * USB_EHCI_MODEL_DQH_SIZE,
+                                     USB_EHCI_MODEL_DQH_SIZE);
+            if ((NULL != dqh) && (0U != USB_EhciModelDeviceLoad(device, dqh, endpoint * 2U + direction)))
+            {
+                USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_EPSR) |= bit;
+            }
+        }
+    }
+    USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_EPPRIME) = 0U;
+}
+
+/*!
+ * @brief Retires the dTD in the overlay of a dQH and advances to the next dTD.
+ *
+ * The next pointer is read from the retired dTD and not from the overlay, a dTD the driver linked after the prime is
+ * not lost (the ATDTW protocol).
+ *
+ * @param device The device mode instance.
+ * @param dqh    The dQH.
+ * @param index  The dQH index.
+ * @param bit    The EPSR/EPCOMPLETE bit of the endpoint.
+ */
+static void USB_EhciModelDeviceRetire(usb_ehci_model_state_struct_t *device,
+                                      volatile uint32_t *dqh,
+                                      uint8_t index,
+                                      uint32_t bit)
+{
+    uint32_t token = dqh[USB_EHCI_MODEL_DQH_TOKEN] & ~USB_EHCI_MODEL_DTD_ACTIVE;
+    volatile uint32_t *dtd;
+
+    dqh[USB_EHCI_MODEL_DQH_TOKEN] = token;
+    dtd = USB_EhciModelFetch(device, dqh[USB_EHCI_MODEL_DQH_CURRENT], USB_EHCI_MODEL_DTD_SIZE);
+    if (NULL != dtd)
+    {
+        dtd[USB_EHCI_MODEL_DTD_TOKEN] = token;
+        dqh[USB_EHCI_MODEL_DQH_NEXT]  = dtd[USB_EHCI_MODEL_DTD_NEXT];
+    }
+    else
+    {
+        dqh[USB_EHCI_MODEL_DQH_NEXT] = USB_EHCI_MODEL_T_BIT;
+    }
+    if (0U != (token & (USB_EHCI_MODEL_DTD_IOC | USB_EHCI_MODEL_DTD_ERROR_MASK)))
+    {
+        USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_EPCOMPLETE) |= bit;
+        USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_USBSTS) |=
+            (0U != (token & USB_EHCI_MODEL_DTD_ERROR_MASK)) ? (USB_EHCI_MODEL_USBSTS_UI | USB_EHCI_MODEL_USBSTS_UEI) :
+                                                              USB_EHCI_MODEL_USBSTS_UI;
+    }
+    if (0U == USB_EhciModelDeviceLoad(device, dqh, index))
+    {
+        USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_EPSR) &= ~bit;
+        device->dtdOffset[index]  = 0U;
+        device->zltPending[index] = 0U;
+    }
+}
+
+/*!
+ * @brief Answers one bus transaction with the device engine.
+ *
+ * @param device    The device mode instance.
+ * @param pid       The token, USB_EHCI_MODEL_PID_*.
+ * @param address   The device address of the token.
+ * @param endpoint  The endpoint number of the token.
+ * @param packet    The data packet, sent for SETUP/OUT and received for IN.
+ * @param length    The data packet length, returns the received length for IN.
+ * @param maxLength The longest data packet the host accepts for IN.
+ *
+ * @return The handshake.
+ */
+static usb_ehci_model_handshake_t USB_EhciModelDeviceTransaction(usb_ehci_model_state_struct_t *device,
+                                                                 uint8_t pid,
+                                                                 uint8_t address,
+                                                                 uint8_t endpoint,
+                                                                 uint8_t *packet,
+                                                                 uint32_t *length,
+                                                                 uint32_t maxLength)
+{
+    volatile uint32_t *dqh;
+    uint32_t epcr;
+    uint32_t bit;
+    uint32_t token;
+    uint32_t maxPacket;
+    uint32_t total;
+    uint32_t count;
+    uint32_t position;
+    uint8_t direction = (USB_EHCI_MODEL_PID_IN == pid) ? 1U : 0U;
+    uint8_t index     = endpoint * 2U + direction;
+    uint8_t done      = 0U;
+
+    if ((0U == USB_EhciModelIsDevice(device)) ||
+        (0U == (USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_USBCMD) & USB_EHCI_MODEL_USBCMD_RS)) ||
+        (0U != device->resetCount) || (address != device->address) || (endpoint >= USB_EHCI_MODEL_DEVICE_ENDPOINTS))
+    {
+        return kEhciModel_NoResponse;
+    }
+    device->statistic.transactions++;
+    epcr = USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_EPCR0 + 4U * endpoint);
+    dqh  = USB_EhciModelFetch(device, USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_EPLISTADDR) +
+                                         (uint32_t)index * USB_EHCI_MODEL_DQH_SIZE,
+                             USB_EHCI_MODEL_DQH_SIZE);
+    if (NULL == dqh)
+    {
+        device->statistic.errorCount++;
+        return kEhciModel_NoResponse;
+    }
+
+    if (USB_EHCI_MODEL_PID_SETUP == pid)
+    {
+        if ((8U != *length) || (0U != ((epcr >> USB_EHCI_MODEL_EPCR_RXT_SHIFT) & USB_EHCI_MODEL_EPCR_TYPE_MASK)))
+        {
+            device->statistic.errorCount++;
+            return kEhciModel_NoResponse;
+        }
+        (void)memcpy((void *)&dqh[USB_EHCI_MODEL_DQH_SETUP], packet, 8U);
+        /* a SETUP clears the stall of the control endpoint and trips the setup tripwire */
+        USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_EPCR0 + 4U * endpoint) =
+            epcr & ~(USB_EHCI_MODEL_EPCR_TXS | USB_EHCI_MODEL_EPCR_RXS);
+        USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_USBCMD) &= ~USB_EHCI_MODEL_USBCMD_SUTW;
+        USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_EPSETUPSR) |= 1UL << endpoint;
+        USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_UI;
+        device->statistic.byteCount += 8U;
+        return kEhciModel_Ack;
+    }
+
+    if ((0U != endpoint) &&
+        (0U == (epcr & ((0U != direction) ? USB_EHCI_MODEL_EPCR_TXE : USB_EHCI_MODEL_EPCR_RXE))))
+    {
+        device->statistic.errorCount++;
+        return kEhciModel_NoResponse;
+    }
+    if (0U != (epcr & ((0U != direction) ? USB_EHCI_MODEL_EPCR_TXS : USB_EHCI_MODEL_EPCR_RXS)))
+    {
+        device->statistic.errorCount++;
+        return kEhciModel_Stall;
+    }
+    bit = 1UL << (endpoint + 16U * direction);
+    if ((0U == (USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_EPSR) & bit)) ||
+        (0U == (dqh[USB_EHCI_MODEL_DQH_TOKEN] & USB_EHCI_MODEL_DTD_ACTIVE)))
+    {
+        if (USB_EHCI_MODEL_EPCR_TYPE_ISO ==
+            ((epcr >> ((0U != direction) ? USB_EHCI_MODEL_EPCR_TXT_SHIFT : USB_EHCI_MODEL_EPCR_RXT_SHIFT)) &
+             USB_EHCI_MODEL_EPCR_TYPE_MASK))
+        {
+            /* an unprimed isochronous endpoint sends a zero length packet or drops the data */
+            if (0U != direction)
+            {
+                *length = 0U;
+            }
+            return kEhciModel_Ack;
+        }
+        device->statistic.nakCount++;
+        return kEhciModel_Nak;
+    }
+
+    token     = dqh[USB_EHCI_MODEL_DQH_TOKEN];
+    maxPacket = (dqh[USB_EHCI_MODEL_DQH_CAPABILITIES] >> 16U) & 0x7FFU;
+    total     = (token & USB_EHCI_MODEL_DTD_TOTAL_MASK) >> USB_EHCI_MODEL_DTD_TOTAL_SHIFT;
+    position  = (dqh[USB_EHCI_MODEL_DQH_PAGE0] & USB_EHCI_MODEL_OFFSET_MASK) + device->dtdOffset[index];
+    if (0U != direction)
+    {
+        count = (total > maxPacket) ? maxPacket : total;
+        if (0U != device->zltPending[index])
+        {
+            count = 0U;
+        }
+        if (count > maxLength)
+        {
+            device->statistic.errorCount++;
+            return kEhciModel_Babble;
+        }
+        if (0U == USB_EhciModelDmaCopy(device, &dqh[USB_EHCI_MODEL_DQH_PAGE0], USB_EHCI_MODEL_DTD_PAGE_COUNT, position,
+                                       packet, count, 0U))
+        {
+            dqh[USB_EHCI_MODEL_DQH_TOKEN] = token | USB_EHCI_MODEL_DTD_BUFFER_ERROR;
+            USB_EhciModelDeviceRetire(device, dqh, index, bit);
+            return kEhciModel_NoResponse;
+        }
+        *length = count;
+        total -= count;
+        if (0U != device->zltPending[index])
+        {
+            done = 1U;
+        }
+        else if (0U == total)
+        {
+            /* the zero length packet of a transfer ending on a packet boundary, only for the last dTD */
+            if ((0U != count) && (count == maxPacket) &&
+                (0U == (dqh[USB_EHCI_MODEL_DQH_CAPABILITIES] & USB_EHCI_MODEL_DQH_ZLT_DISABLE)) &&
+                (0U != (token & USB_EHCI_MODEL_DTD_IOC)))
+            {
+                device->zltPending[index] = 1U;
+            }
+            else
+            {
+                done = 1U;
+            }
+        }
+        else
+        {
+            /*no action*/
+        }
+    }
+    else
+    {
+        count = *length;
+        if (count > maxPacket)
+        {
+            device->statistic.errorCount++;
+            return kEhciModel_NoResponse;
+        }
+        if (count > total)
+        {
+            /* the packet does not fit in the dTD */
+            token |= USB_EHCI_MODEL_DTD_BUFFER_ERROR;
+            count = total;
+            done  = 1U;
+        }
+        if (0U == USB_EhciModelDmaCopy(device, &dqh[USB_EHCI_MODEL_DQH_PAGE0], USB_EHCI_MODEL_DTD_PAGE_COUNT, position,
+                                       packet, count, 1U))
+        {
+            dqh[USB_EHCI_MODEL_DQH_TOKEN] = token | USB_EHCI_MODEL_DTD_BUFFER_ERROR;
+            USB_EhciModelDeviceRetire(device, dqh, index, bit);
+            return kEhciModel_NoResponse;
+        }
+        total -= count;
+        if ((0U == total) || (*length < maxPacket))
+        {
+            done = 1U;
+        }
+    }
+    device->dtdOffset[index] += count;
+    device->statistic.byteCount += count;
+    dqh[USB_EHCI_MODEL_DQH_TOKEN] =
+        (token & ~USB_EHCI_MODEL_DTD_TOTAL_MASK) | (total << USB_EHCI_MODEL_DTD_TOTAL_SHIFT);
+    if (0U != done)
+    {
+        /* SET_ADDRESS takes effect after the status stage */
+        if ((0U != direction) && (0U == endpoint) && (0U != device->addressPending))
+        {
+            device->address = (uint8_t)(USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_DEVICEADDR) >>
+                                        USB_EHCI_MODEL_DEVICEADDR_SHIFT);
+            device->addressPending = 0U;
+        }
+        USB_EhciModelDeviceRetire(device, dqh, index, bit);
+    }
+    return kEhciModel_Ack;
+}
+
+/*!
+ * @brief Issues one bus transaction of a host mode instance to the connected device.
+ *
+ * @param host      The host mode instance.
+ * @param pid       The token.
+ * @param address   The device address.
+ * @param endpoint  The endpoint number.
+ * @param packet    The data packet.
+ * @param length    The data packet length, returns the received length for IN.
+ * @param maxLength The longest data packet accepted for IN.
+ *
+ * @return The handshake.
+ */
+static usb_ehci_model_handshake_t USB_EhciModelHostTransaction(usb_ehci_model_state_struct_t *host,
+                                                               uint8_t pid,
+                                                               uint8_t address,
+                                                               uint8_t endpoint,
+                                                               uint8_t *packet,
+                                                               uint32_t *length,
+                                                               uint32_t maxLength)
+{
+    usb_ehci_model_state_struct_t *device = USB_EhciModelPeer(host);
+    usb_ehci_model_handshake_t handshake;
+
+    host->statistic.transactions++;
+    if ((NULL == device) || (0U == (USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_PORTSC1) & USB_EHCI_MODEL_PORTSC1_PE)))
+    {
+        handshake = kEhciModel_NoResponse;
+    }
+    else
+    {
+        handshake = USB_EhciModelDeviceTransaction(device, pid, address, endpoint, packet, length, maxLength);
+    }
+    if (kEhciModel_Nak == handshake)
+    {
+        host->statistic.nakCount++;
+    }
+    else if (kEhciModel_Ack == handshake)
+    {
+        host->statistic.byteCount += *length;
+    }
+    else
+    {
+        host->statistic.errorCount++;
+    }
+    return handshake;
+}
+
+/*!
+ * @brief Stops a host mode instance on a host system error.
+ *
+ * @param host The host mode instance.
+ */
+static void USB_EhciModelHostSystemError(usb_ehci_model_state_struct_t *host)
+{
+    USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBCMD) &= ~USB_EHCI_MODEL_USBCMD_RS;
+    USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_SEI | USB_EHCI_MODEL_USBSTS_HCH;
+}
+
+/*!
+ * @brief Visits one QH of the host schedules, it executes at most one transaction.
+ *
+ * @param host   The host mode instance.
+ * @param qh     The QH.
+ * @param budget The bytes left in the micro-frame.
+ *
+ * @return The visit result.
+ */
+static usb_ehci_model_qh_result_t USB_EhciModelHostQh(usb_ehci_model_state_struct_t *host,
+                                                      volatile uint32_t *qh,
+                                                      uint32_t *budget)
+{
+    uint8_t packet[USB_EHCI_MODEL_MAX_PACKET];
+    volatile uint32_t *qtd;
+    uint32_t token = qh[USB_EHCI_MODEL_QH_TOKEN];
+    uint32_t characteristics;
+    uint32_t pointer;
+    uint32_t maxPacket;
+    uint32_t total;
+    uint32_t request;
+    uint32_t length;
+    uint32_t position;
+    uint32_t cerr;
+    uint32_t page;
+    uint32_t overhead;
+    usb_ehci_model_handshake_t handshake;
+    uint8_t pid;
+    uint8_t done = 0U;
+
+    if (0U == (token & USB_EHCI_MODEL_QTD_ACTIVE))
+    {
+        if (0U != (token & USB_EHCI_MODEL_QTD_HALTED))
+        {
+            return kEhciModel_QhIdle;
+        }
+        /* advance the queue, the alternate pointer is used after a short packet */
+        pointer = qh[USB_EHCI_MODEL_QH_NEXT];
+        if ((0U != (token & USB_EHCI_MODEL_QTD_TOTAL_MASK)) &&
+            (0U == (qh[USB_EHCI_MODEL_QH_ALTERNATE] & USB_EHCI_MODEL_T_BIT)))
+        {
+            pointer = qh[USB_EHCI_MODEL_QH_ALTERNATE];
+        }
+        if (0U != (pointer & USB_EHCI_MODEL_T_BIT))
+        {
+            return kEhciModel_QhIdle;
+        }
+        qtd = USB_EhciModelFetch(host, pointer, USB_EHCI_MODEL_QTD_SIZE);
+        if (NULL == qtd)
+        {
+            USB_EhciModelHostSystemError(host);
+            return kEhciModel_QhIdle;
+        }
+        if (0U == (qtd[USB_EHCI_MODEL_QTD_TOKEN] & USB_EHCI_MODEL_QTD_ACTIVE))
+        {
+            return kEhciModel_QhIdle;
+        }
+        qh[USB_EHCI_MODEL_QH_CURRENT]   = pointer & USB_EHCI_MODEL_POINTER_MASK;
+        qh[USB_EHCI_MODEL_QH_NEXT]      = qtd[USB_EHCI_MODEL_QTD_NEXT];
+        qh[USB_EHCI_MODEL_QH_ALTERNATE] = qtd[USB_EHCI_MODEL_QTD_ALTERNATE];
+        if (0U != (qh[USB_EHCI_MODEL_QH_CHARACTERISTICS] & USB_EHCI_MODEL_QH_DTC))
+        {
+            token = qtd[USB_EHCI_MODEL_QTD_TOKEN];
+        }
+        else
+        {
+            token = (qtd[USB_EHCI_MODEL_QTD_TOKEN] & ~USB_EHCI_MODEL_QTD_DT) | (token & USB_EHCI_MODEL_QTD_DT);
+        }
+        for (page = 0U; page < USB_EHCI_MODEL_QTD_PAGE_COUNT; page++)
+        {
+            qh[USB_EHCI_MODEL_QH_PAGE0 + page] = qtd[USB_EHCI_MODEL_QTD_PAGE0 + page];
+        }
+        qh[USB_EHCI_MODEL_QH_TOKEN] = token;
+    }
+
+    characteristics = qh[USB_EHCI_MODEL_QH_CHARACTERISTICS];
+    maxPacket       = (characteristics >> 16U) & 0x7FFU;
+    pid             = (uint8_t)((token >> USB_EHCI_MODEL_QTD_PID_SHIFT) & 0x3U);
+    total           = (token & USB_EHCI_MODEL_QTD_TOTAL_MASK) >> USB_EHCI_MODEL_QTD_TOTAL_SHIFT;
+    request         = ((USB_EHCI_MODEL_PID_SETUP == pid) || (total < maxPacket)) ? total : maxPacket;
+    overhead        = (USB_SPEED_HIGH == host->speed) ? USB_EHCI_MODEL_HS_TRANSACTION_OVERHEAD :
+                                                        USB_EHCI_MODEL_FS_TRANSACTION_OVERHEAD;
+    if ((request + overhead) > *budget)
+    {
+        return kEhciModel_QhNoTime;
+    }
+    *budget -= overhead;
+    if ((pid > USB_EHCI_MODEL_PID_SETUP) || (request > USB_EHCI_MODEL_MAX_PACKET) || (0U == maxPacket))
+    {
+        /* reserved PID or a packet the bus cannot carry */
+        token = (token & ~USB_EHCI_MODEL_QTD_ACTIVE) | USB_EHCI_MODEL_QTD_HALTED | USB_EHCI_MODEL_QTD_BABBLE;
+        host->statistic.descriptorErrors++;
+        handshake = kEhciModel_Babble;
+    }
+    else
+    {
+        position = ((token & USB_EHCI_MODEL_QTD_CPAGE_MASK) >> USB_EHCI_MODEL_QTD_CPAGE_SHIFT) *
+                       USB_EHCI_MODEL_PAGE_SIZE +
+                   (qh[USB_EHCI_MODEL_QH_PAGE0] & USB_EHCI_MODEL_OFFSET_MASK);
+        length = request;
+        if ((USB_EHCI_MODEL_PID_IN != pid) &&
+            (0U == USB_EhciModelDmaCopy(host, &qh[USB_EHCI_MODEL_QH_PAGE0], USB_EHCI_MODEL_QTD_PAGE_COUNT, position,
+                                        packet, length, 0U)))
+        {
+            USB_EhciModelHostSystemError(host);
+            return kEhciModel_QhIdle;
+        }
+        handshake = USB_EhciModelHostTransaction(host, pid, (uint8_t)(characteristics & 0x7FU),
+                                                 (uint8_t)((characteristics >> 8U) & 0xFU), packet, &length, request);
+        switch (handshake)
+        {
+            case kEhciModel_Ack:
+                if ((USB_EHCI_MODEL_PID_IN == pid) &&
+                    (0U == USB_EhciModelDmaCopy(host, &qh[USB_EHCI_MODEL_QH_PAGE0], USB_EHCI_MODEL_QTD_PAGE_COUNT,
+                                                position, packet, length, 1U)))
+                {
+                    USB_EhciModelHostSystemError(host);
+                    return kEhciModel_QhIdle;
+                }
+                total -= length;
+                position += length;
+                qh[USB_EHCI_MODEL_QH_PAGE0] =
+                    (qh[USB_EHCI_MODEL_QH_PAGE0] & USB_EHCI_MODEL_PAGE_MASK) | (position & USB_EHCI_MODEL_OFFSET_MASK);
+                token = (token & ~(USB_EHCI_MODEL_QTD_TOTAL_MASK | USB_EHCI_MODEL_QTD_CPAGE_MASK)) |
+                        (total << USB_EHCI_MODEL_QTD_TOTAL_SHIFT) |
+                        ((position >> USB_EHCI_MODEL_PAGE_SHIFT) << USB_EHCI_MODEL_QTD_CPAGE_SHIFT);
+                token ^= USB_EHCI_MODEL_QTD_DT;
+                *budget -= (length > *budget) ? *budget : length;
+                if ((0U == total) || ((USB_EHCI_MODEL_PID_IN == pid) && (length < maxPacket)))
+                {
+                    token &= ~USB_EHCI_MODEL_QTD_ACTIVE;
+                    /* a short packet interrupts even without IOC */
+                    done = ((0U != total) || (0U != (token & USB_EHCI_MODEL_QTD_IOC))) ? 1U : 0U;
+                }
+                break;
+            case kEhciModel_Nak:
+                return kEhciModel_QhNak;
+            case kEhciModel_Stall:
+                token = (token & ~USB_EHCI_MODEL_QTD_ACTIVE) | USB_EHCI_MODEL_QTD_HALTED;
+                break;
+            case kEhciModel_Babble:
+                token = (token & ~USB_EHCI_MODEL_QTD_ACTIVE) | USB_EHCI_MODEL_QTD_HALTED | USB_EHCI_MODEL_QTD_BABBLE;
+                break;
+            default:
+                /* CERR 0 retries for ever, the qTD halts when the count runs out */
+                cerr = (token & USB_EHCI_MODEL_QTD_CERR_MASK) >> USB_EHCI_MODEL_QTD_CERR_SHIFT;
+                if (1U == cerr)
+                {
+                    token = (token & ~(USB_EHCI_MODEL_QTD_ACTIVE | USB_EHCI_MODEL_QTD_CERR_MASK)) |
+                            USB_EHCI_MODEL_QTD_HALTED | USB_EHCI_MODEL_QTD_XACTERR;
+                }
+                else if (cerr > 1U)
+                {
+                    token = (token & ~USB_EHCI_MODEL_QTD_CERR_MASK) | ((cerr - 1U) << USB_EHCI_MODEL_QTD_CERR_SHIFT);
+                }
+                else
+                {
+                    /*no action*/
+                }
+                break;
+        }
+    }
+
+    qh[USB_EHCI_MODEL_QH_TOKEN] = token;
+    if (0U == (token & USB_EHCI_MODEL_QTD_ACTIVE))
+    {
+        /* write the overlay back to the qTD */
+        qtd = USB_EhciModelFetch(host, qh[USB_EHCI_MODEL_QH_CURRENT], USB_EHCI_MODEL_QTD_SIZE);
+        if (NULL == qtd)
+        {
+            USB_EhciModelHostSystemError(host);
+            return kEhciModel_QhIdle;
+        }
+        qtd[USB_EHCI_MODEL_QTD_PAGE0] = qh[USB_EHCI_MODEL_QH_PAGE0];
+        qtd[USB_EHCI_MODEL_QTD_TOKEN] = token;
+        if (0U != (token & USB_EHCI_MODEL_QTD_HALTED))
+        {
+            USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_UEI;
+        }
+        else if (0U != done)
+        {
+            USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_UI;
+        }
+        else
+        {
+            /*no action*/
+        }
+    }
+    return kEhciModel_QhDone;
+}
+
+/*!
+ * @brief Executes the iTD transaction of the current micro-frame.
+ *
+ * @param host The host mode instance.
+ * @param itd  The iTD.
+ */
+static void USB_EhciModelHostItd(usb_ehci_model_state_struct_t *host, volatile uint32_t *itd)
+{
+    uint8_t packet[USB_EHCI_MODEL_MAX_PACKET];
+    uint32_t microframe = USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_FRINDEX) & 0x7U;
+    uint32_t transaction = itd[USB_EHCI_MODEL_ITD_TRANSACTION0 + microframe];
+    uint32_t length;
+    uint32_t done = 0U;
+    uint32_t position;
+    uint32_t maxPacket;
+    uint32_t mult;
+    uint32_t count;
+    uint32_t status = 0U;
+    usb_ehci_model_handshake_t handshake;
+    uint8_t address;
+    uint8_t endpoint;
+    uint8_t pid;
+
+    if (0U == (transaction & USB_EHCI_MODEL_ITD_ACTIVE))
+    {
+        return;
+    }
+    length    = (transaction & USB_EHCI_MODEL_ITD_LENGTH_MASK) >> USB_EHCI_MODEL_ITD_LENGTH_SHIFT;
+    position  = (((transaction >> USB_EHCI_MODEL_ITD_PG_SHIFT) & 0x7U) << USB_EHCI_MODEL_PAGE_SHIFT) |
+               (transaction & USB_EHCI_MODEL_OFFSET_MASK);
+    address   = (uint8_t)(itd[USB_EHCI_MODEL_ITD_PAGE0] & 0x7FU);
+    endpoint  = (uint8_t)((itd[USB_EHCI_MODEL_ITD_PAGE0] >> 8U) & 0xFU);
+    maxPacket = itd[USB_EHCI_MODEL_ITD_PAGE0 + 1U] & 0x7FFU;
+    pid = (0U != (itd[USB_EHCI_MODEL_ITD_PAGE0 + 1U] & USB_EHCI_MODEL_ITD_DIRECTION_IN)) ? USB_EHCI_MODEL_PID_IN :
+                                                                                          USB_EHCI_MODEL_PID_OUT;
+    mult = itd[USB_EHCI_MODEL_ITD_PAGE0 + 2U] & 0x3U;
+    mult = (0U == mult) ? 1U : mult;
+    if ((0U == maxPacket) || (maxPacket > USB_EHCI_MODEL_MAX_PACKET))
+    {
+        host->statistic.descriptorErrors++;
+        status = USB_EHCI_MODEL_ITD_BABBLE;
+        mult   = 0U;
+    }
+
+    /* up to mult packets in the micro-frame, an IN ends on a short packet */
+    for (; mult > 0U; mult--)
+    {
+        count = ((length - done) > maxPacket) ? maxPacket : (length - done);
+        if ((USB_EHCI_MODEL_PID_OUT == pid) &&
+            (0U == USB_EhciModelDmaCopy(host, &itd[USB_EHCI_MODEL_ITD_PAGE0], USB_EHCI_MODEL_ITD_PAGE_COUNT,
+                                        position + done, packet, count, 0U)))
+        {
+            USB_EhciModelHostSystemError(host);
+            return;
+        }
+        handshake = USB_EhciModelHostTransaction(host, pid, address, endpoint, packet, &count, count);
+        if (kEhciModel_Ack != handshake)
+        {
+            status = (kEhciModel_Babble == handshake) ? USB_EHCI_MODEL_ITD_BABBLE : USB_EHCI_MODEL_ITD_XACTERR;
+            break;
+        }
+        if ((USB_EHCI_MODEL_PID_IN == pid) &&
+            (0U == USB_EhciModelDmaCopy(host, &itd[USB_EHCI_MODEL_ITD_PAGE0], USB_EHCI_MODEL_ITD_PAGE_COUNT,
+                                        position + done, packet, count, 1U)))
+        {
+            USB_EhciModelHostSystemError(host);
+            return;
+        }
+        done += count;
+        if ((done >= length) || ((USB_EHCI_MODEL_PID_IN == pid) && (count < maxPacket)))
+        {
+            break;
+        }
+    }
+    if (USB_EHCI_MODEL_PID_IN == pid)
+    {
+        transaction = (transaction & ~USB_EHCI_MODEL_ITD_LENGTH_MASK) | (done << USB_EHCI_MODEL_ITD_LENGTH_SHIFT);
+    }
+    itd[USB_EHCI_MODEL_ITD_TRANSACTION0 + microframe] = (transaction & ~USB_EHCI_MODEL_ITD_ACTIVE) | status;
+    if (0U != status)
+    {
+        USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_UEI;
+    }
+    if (0U != (transaction & USB_EHCI_MODEL_ITD_IOC))
+    {
+        USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_UI;
+    }
+}
+
+/*!
+ * @brief Executes a siTD in the micro-frame of its S-mask, the split transaction timing is not modeled.
+ *
+ * @param host The host mode instance.
+ * @param sitd The siTD.
+ */
+static void USB_EhciModelHostSitd(usb_ehci_model_state_struct_t *host, volatile uint32_t *sitd)
+{
+    uint8_t packet[USB_EHCI_MODEL_MAX_PACKET];
+    uint32_t microframe = USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_FRINDEX) & 0x7U;
+    uint32_t endpointState = sitd[USB_EHCI_MODEL_SITD_ENDPOINT];
+    uint32_t results       = sitd[USB_EHCI_MODEL_SITD_RESULTS];
+    uint32_t total;
+    uint32_t count;
+    uint32_t position;
+    uint32_t status = 0U;
+    usb_ehci_model_handshake_t handshake;
+    uint8_t pid;
+
+    if ((0U == (results & USB_EHCI_MODEL_SITD_ACTIVE)) ||
+        (0U == (sitd[USB_EHCI_MODEL_SITD_SCHEDULE] & (1UL << microframe))))
+    {
+        return;
+    }
+    total    = (results & USB_EHCI_MODEL_SITD_TOTAL_MASK) >> USB_EHCI_MODEL_SITD_TOTAL_SHIFT;
+    position = ((0U != (results & USB_EHCI_MODEL_SITD_PAGE_SELECT)) ? USB_EHCI_MODEL_PAGE_SIZE : 0U) |
+               (sitd[USB_EHCI_MODEL_SITD_PAGE0] & USB_EHCI_MODEL_OFFSET_MASK);
+    pid = (0U != (endpointState & USB_EHCI_MODEL_SITD_DIRECTION_IN)) ? USB_EHCI_MODEL_PID_IN : USB_EHCI_MODEL_PID_OUT;
+    count = total;
+    if ((USB_EHCI_MODEL_PID_OUT == pid) &&
+        (0U == USB_EhciModelDmaCopy(host, &sitd[USB_EHCI_MODEL_SITD_PAGE0], USB_EHCI_MODEL_SITD_PAGE_COUNT, position,
+                                    packet, count, 0U)))
+    {
+        USB_EhciModelHostSystemError(host);
+        return;
+    }
+    handshake = USB_EhciModelHostTransaction(host, pid, (uint8_t)(endpointState & 0x7FU),
+                                             (uint8_t)((endpointState >> 8U) & 0xFU), packet, &count, total);
+    if (kEhciModel_Ack == handshake)
+    {
+        if ((USB_EHCI_MODEL_PID_IN == pid) &&
+            (0U == USB_EhciModelDmaCopy(host, &sitd[USB_EHCI_MODEL_SITD_PAGE0], USB_EHCI_MODEL_SITD_PAGE_COUNT,
+                                        position, packet, count, 1U)))
+        {
+            USB_EhciModelHostSystemError(host);
+            return;
+        }
+        total -= count;
+    }
+    else
+    {
+        status = (kEhciModel_Babble == handshake) ? USB_EHCI_MODEL_SITD_BABBLE : USB_EHCI_MODEL_SITD_XACTERR;
+    }
+    sitd[USB_EHCI_MODEL_SITD_RESULTS] =
+        (results & ~(USB_EHCI_MODEL_SITD_ACTIVE | USB_EHCI_MODEL_SITD_TOTAL_MASK | 0x0000FF00U)) |
+        (total << USB_EHCI_MODEL_SITD_TOTAL_SHIFT) | status;
+    if (0U != status)
+    {
+        USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_UEI;
+    }
+    if (0U != (results & USB_EHCI_MODEL_SITD_IOC))
+    {
+        USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_UI;
+    }
+}
+
+/*!
+ * @brief Walks the periodic frame list entry of the current micro-frame.
+ *
+ * @param host The host mode instance.
+ */
+static void USB_EhciModelHostPeriodic(usb_ehci_model_state_struct_t *host)
+{
+    volatile uint32_t *element;
+    uint32_t command   = USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBCMD);
+    uint32_t frameSize =
+        1024U >> (((0U != (command & USB_EHCI_MODEL_USBCMD_FS2)) ? 4U : 0U) | ((command >> 2U) & 0x3U));
+    uint32_t frame     = (USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_FRINDEX) >> 3U) & (frameSize - 1U);
+    uint32_t microframe = USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_FRINDEX) & 0x7U;
+    uint32_t budget    = UINT32_MAX;
+    uint32_t pointer;
+    uint32_t walk;
+
+    element = USB_EhciModelFetch(
+        host, (USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_PERIODICLIST) & USB_EHCI_MODEL_PAGE_MASK) + frame * 4U, 4U);
+    if (NULL == element)
+    {
+        USB_EhciModelHostSystemError(host);
+        return;
+    }
+    pointer = element[0];
+    for (walk = 0U; (walk < USB_EHCI_MODEL_PERIODIC_WALK_LIMIT) && (0U == (pointer & USB_EHCI_MODEL_T_BIT)); walk++)
+    {
+        switch (pointer & USB_EHCI_MODEL_TYPE_MASK)
+        {
+            case USB_EHCI_MODEL_TYPE_ITD:
+                element = USB_EhciModelFetch(host, pointer, USB_EHCI_MODEL_ITD_SIZE);
+                if (NULL != element)
+                {
+                    USB_EhciModelHostItd(host, element);
+                }
+                break;
+            case USB_EHCI_MODEL_TYPE_SITD:
+                element = USB_EhciModelFetch(host, pointer, USB_EHCI_MODEL_SITD_SIZE);
+                if (NULL != element)
+                {
+                    USB_EhciModelHostSitd(host, element);
+                }
+                break;
+            case USB_EHCI_MODEL_TYPE_QH:
+                element = USB_EhciModelFetch(host, pointer, USB_EHCI_MODEL_QH_SIZE);
+                if ((NULL != element) && (0U != (element[USB_EHCI_MODEL_QH_CAPABILITIES] & (1UL << microframe))))
+                {
+                    (void)USB_EhciModelHostQh(host, element, &budget);
+                }
+                break;
+            default:
+                /* FSTN, only the link is followed */
+                element = USB_EhciModelFetch(host, pointer, 4U);
+                break;
+        }
+        if ((NULL == element) || (0U == (USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBCMD) & USB_EHCI_MODEL_USBCMD_RS)))
+        {
+            USB_EhciModelHostSystemError(host);
+            return;
+        }
+        pointer = element[0];
+    }
+}
+
+/*!
+ * @brief Walks the asynchronous QH ring until the micro-frame is full or a whole turn of the ring is idle.
+ *
+ * @param host The host mode instance.
+ */
+static void USB_EhciModelHostAsync(usb_ehci_model_state_struct_t *host)
+{
+    volatile uint32_t *qh;
+    uint32_t budget = (USB_SPEED_HIGH == host->speed) ? USB_EHCI_MODEL_HS_MICROFRAME_BYTES :
+                                                        (USB_EHCI_MODEL_FS_FRAME_BYTES / 8U);
+    uint32_t pointer = host->asyncQh;
+    uint32_t idleStart = 0U;
+    uint32_t walk;
+    usb_ehci_model_qh_result_t result;
+
+    if (0U == pointer)
+    {
+        pointer = USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_ASYNCLISTADDR) & USB_EHCI_MODEL_POINTER_MASK;
+    }
+    for (walk = 0U; walk < USB_EHCI_MODEL_ASYNC_WALK_LIMIT; walk++)
+    {
+        qh = USB_EhciModelFetch(host, pointer, USB_EHCI_MODEL_QH_SIZE);
+        if (NULL == qh)
+        {
+            USB_EhciModelHostSystemError(host);
+            return;
+        }
+        result = USB_EhciModelHostQh(host, qh, &budget);
+        if (0U == (USB_EHCI_MODEL_REG(host, USB_EHCI_MODEL_USBCMD) & USB_EHCI_MODEL_USBCMD_RS))
+        {
+            return;
+        }
+        if (kEhciModel_QhNoTime == result)
+        {
+            break;
+        }
+        if (kEhciModel_QhDone == result)
+        {
+            idleStart = 0U;
+        }
+        else if (0U == idleStart)
+        {
+            idleStart = pointer;
+        }
+        else
+        {
+            /*no action*/
+        }
+        if ((0U != (qh[USB_EHCI_MODEL_QH_LINK] & USB_EHCI_MODEL_T_BIT)) ||
+            (USB_EHCI_MODEL_TYPE_QH != (qh[USB_EHCI_MODEL_QH_LINK] & USB_EHCI_MODEL_TYPE_MASK)))
+        {
+            /* the asynchronous schedule is a ring of QHs */
+            host->statistic.descriptorErrors++;
+            USB_EhciModelHostSystemError(host);
+            return;
+        }
+        pointer = qh[USB_EHCI_MODEL_QH_LINK] & USB_EHCI_MODEL_POINTER_MASK;
+        if (pointer == idleStart)
+        {
+            break;
+        }
+    }
+    host->asyncQh = pointer;
+}
+
+/*!
+ * @brief Advances the clock of one instance by one micro-frame.
+ *
+ * @param model The model instance.
+ */
+static void USB_EhciModelClock(usb_ehci_model_state_struct_t *model)
+{
+    uint32_t control;
+    uint32_t offset;
+    uint8_t timer;
+
+    model->statistic.microframes++;
+    for (timer = 0U; timer < 2U; timer++)
+    {
+        offset  = USB_EHCI_MODEL_GPTIMER0CTL + 8U * timer;
+        control = USB_EHCI_MODEL_REG(model, offset);
+        if (0U == (control & USB_EHCI_MODEL_GPTIMER_RUN))
+        {
+            continue;
+        }
+        model->timerCount[timer] -= 125;
+        if (model->timerCount[timer] <= 0)
+        {
+            USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBSTS) |= (USB_EHCI_MODEL_USBSTS_TI0 << timer);
+            if (0U != (control & USB_EHCI_MODEL_GPTIMER_MODE))
+            {
+                model->timerCount[timer] +=
+                    (int32_t)((USB_EHCI_MODEL_REG(model, offset - 4U) & USB_EHCI_MODEL_GPTIMER_COUNT_MASK) + 1U);
+                if (model->timerCount[timer] <= 0)
+                {
+                    model->timerCount[timer] = 1;
+                }
+            }
+            else
+            {
+                model->timerCount[timer] = 0;
+                control &= ~USB_EHCI_MODEL_GPTIMER_RUN;
+            }
+        }
+        USB_EHCI_MODEL_REG(model, offset) = (control & ~USB_EHCI_MODEL_GPTIMER_COUNT_MASK) |
+                                            ((uint32_t)model->timerCount[timer] & USB_EHCI_MODEL_GPTIMER_COUNT_MASK);
+    }
+
+    if ((0U != model->resetCount) && (0U == --model->resetCount))
+    {
+        USB_EhciModelDeviceResetEnd(model);
+    }
+
+    if (0U != (USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBCMD) & USB_EHCI_MODEL_USBCMD_RS))
+    {
+        USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_FRINDEX) =
+            (USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_FRINDEX) + 1U) & 0x3FFFU;
+        if (0U == (USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_FRINDEX) & 0x7U))
+        {
+            USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_SRI;
+        }
+        if ((0U != USB_EhciModelIsHost(model)) && (0U == (USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_FRINDEX) & 0x1FFFU)))
+        {
+            USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBSTS) |= USB_EHCI_MODEL_USBSTS_FRI;
+        }
+    }
+}
+
+/*!
+ * @brief Advances all instances by one micro-frame and runs the host schedules.
+ */
+static void USB_EhciModelStep(void)
+{
+    usb_ehci_model_state_struct_t *model;
+    uint8_t instance;
+
+    for (instance = 0U; instance < USB_EHCI_MODEL_INSTANCE_COUNT; instance++)
+    {
+        USB_EhciModelClock(&s_UsbEhciModelState[instance]);
+    }
+    for (instance = 0U; instance < USB_EHCI_MODEL_INSTANCE_COUNT; instance++)
+    {
+        model = &s_UsbEhciModelState[instance];
+        if ((0U == USB_EhciModelIsHost(model)) ||
+            (0U == (USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBCMD) & USB_EHCI_MODEL_USBCMD_RS)))
+        {
+            continue;
+        }
+        if (0U != (USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBCMD) & USB_EHCI_MODEL_USBCMD_PSE))
+        {
+            USB_EhciModelHostPeriodic(model);
+        }
+        if (0U != (USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBCMD) & USB_EHCI_MODEL_USBCMD_ASE))
+        {
+            USB_EhciModelHostAsync(model);
+        }
+    }
+}
+
+/*!
+ * @brief Applies the USBCMD write.
+ *
+ * @param model    The model instance.
+ * @param oldValue The value before the write.
+ */
+static void USB_EhciModelWriteCommand(usb_ehci_model_state_struct_t *model, uint32_t oldValue)
+{
+    uint32_t command = USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBCMD);
+    uint32_t status;
+
+    if (0U != (command & USB_EHCI_MODEL_USBCMD_RST))
+    {
+        if ((0U != USB_EhciModelIsDevice(model)) && (0U != (oldValue & USB_EHCI_MODEL_USBCMD_RS)))
+        {
+            USB_EhciModelDeviceAttach(model, 0U);
+        }
+        USB_EhciModelResetRegisters(model);
+        return;
+    }
+    if (0U != USB_EhciModelIsDevice(model))
+    {
+        if (0U != ((command ^ oldValue) & USB_EHCI_MODEL_USBCMD_RS))
+        {
+            USB_EhciModelDeviceAttach(model, (uint8_t)(command & USB_EHCI_MODEL_USBCMD_RS));
+        }
+        return;
+    }
+
+    /* the schedule status follows the enable bits, the run/stop bit controls HCHalted */
+    status = USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBSTS) &
+             ~(USB_EHCI_MODEL_USBSTS_AS | USB_EHCI_MODEL_USBSTS_PS | USB_EHCI_MODEL_USBSTS_HCH);
+    if (0U != (command & USB_EHCI_MODEL_USBCMD_ASE))
+    {
+        status |= USB_EHCI_MODEL_USBSTS_AS;
+    }
+    if (0U != (command & USB_EHCI_MODEL_USBCMD_PSE))
+    {
+        status |= USB_EHCI_MODEL_USBSTS_PS;
+    }
+    if (0U == (command & USB_EHCI_MODEL_USBCMD_RS))
+    {
+        status |= USB_EHCI_MODEL_USBSTS_HCH;
+    }
+    if (0U != (command & USB_EHCI_MODEL_USBCMD_IAA))
+    {
+        /* the doorbell rings at once, the model does not cache QHs */
+        command &= ~USB_EHCI_MODEL_USBCMD_IAA;
+        status |= USB_EHCI_MODEL_USBSTS_AAI;
+    }
+    if (0U != ((command ^ oldValue) & USB_EHCI_MODEL_USBCMD_ASE))
+    {
+        model->asyncQh = 0U;
+    }
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBCMD) = command;
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBSTS) = status;
+}
+
+/*!
+ * @brief Applies the PORTSC1 write.
+ *
+ * @param model    The model instance.
+ * @param oldValue The value before the write.
+ */
+static void USB_EhciModelWritePort(usb_ehci_model_state_struct_t *model, uint32_t oldValue)
+{
+    usb_ehci_model_state_struct_t *device;
+    uint32_t value = USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_PORTSC1);
+    uint32_t portsc;
+
+    portsc = (oldValue & USB_EHCI_MODEL_PORTSC1_RO_MASK & ~(value & USB_EHCI_MODEL_PORTSC1_W1C_MASK)) |
+             (value & ~USB_EHCI_MODEL_PORTSC1_RO_MASK);
+    if (0U == USB_EhciModelIsHost(model))
+    {
+        USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_PORTSC1) = portsc;
+        return;
+    }
+    /* software can disable the port, not enable it */
+    if (0U == (value & USB_EHCI_MODEL_PORTSC1_PE))
+    {
+        portsc &= ~USB_EHCI_MODEL_PORTSC1_PE;
+    }
+    USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_PORTSC1) = portsc;
+
+    device = USB_EhciModelPeer(model);
+    if ((0U != (value & USB_EHCI_MODEL_PORTSC1_PR)) && (0U == (oldValue & USB_EHCI_MODEL_PORTSC1_PR)))
+    {
+        /* the reset signaling is over when the driver reads PORTSC1 again, the device sees it for a while */
+        if (0U != (portsc & USB_EHCI_MODEL_PORTSC1_CCS))
+        {
+            portsc &= ~(USB_EHCI_MODEL_PORTSC1_HSP | USB_EHCI_MODEL_PORTSC1_PSPD_MASK);
+            portsc |= USB_EHCI_MODEL_PORTSC1_PE | ((uint32_t)model->speed << USB_EHCI_MODEL_PORTSC1_PSPD_SHIFT);
+            if (USB_SPEED_HIGH == model->speed)
+            {
+                portsc |= USB_EHCI_MODEL_PORTSC1_HSP;
+            }
+            if (NULL != device)
+            {
+                USB_EhciModelDeviceResetStart(device, model->speed);
+            }
+        }
+        USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_PORTSC1) = portsc;
+    }
+    if ((0U != ((value ^ oldValue) & USB_EHCI_MODEL_PORTSC1_PP)) && (NULL != device))
+    {
+        USB_EhciModelHostPortConnect(
+            model, (uint8_t)((0U != (value & USB_EHCI_MODEL_PORTSC1_PP)) && (0U != USB_EhciModelIsDevice(device)) &&
+                             (0U != (USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_USBCMD) & USB_EHCI_MODEL_USBCMD_RS))));
+    }
+}
+
+/*!
+ * @brief Applies the GPTIMERnCTL write.
+ *
+ * @param model    The model instance.
+ * @param timer    The timer, 0 or 1.
+ */
+static void USB_EhciModelWriteTimer(usb_ehci_model_state_struct_t *model, uint8_t timer)
+{
+    uint32_t offset  = USB_EHCI_MODEL_GPTIMER0CTL + 8U * timer;
+    uint32_t control = USB_EHCI_MODEL_REG(model, offset);
+
+    if ((0U != (control & USB_EHCI_MODEL_GPTIMER_RST)) || (model->timerCount[timer] <= 0))
+    {
+        model->timerCount[timer] =
+            (int32_t)((USB_EHCI_MODEL_REG(model, offset - 4U) & USB_EHCI_MODEL_GPTIMER_COUNT_MASK) + 1U);
+    }
+    USB_EHCI_MODEL_REG(model, offset) =
+        (control & (USB_EHCI_MODEL_GPTIMER_RUN | USB_EHCI_MODEL_GPTIMER_MODE)) |
+        ((uint32_t)model->timerCount[timer] & USB_EHCI_MODEL_GPTIMER_COUNT_MASK);
+}
+
+/*!
+ * @brief Applies the side effects of one register write.
+ *
+ * The written value is already in the register, the function turns it into the value the hardware keeps.
+ *
+ * @param model    The model instance.
+ * @param offset   The register offset.
+ * @param oldValue The value before the write.
+ */
+static void USB_EhciModelRegisterWrite(usb_ehci_model_state_struct_t *model, uint32_t offset, uint32_t oldValue)
+{
+    uint32_t value = USB_EHCI_MODEL_REG(model, offset);
+    uint32_t index;
+
+    switch (offset)
+    {
+        case USB_EHCI_MODEL_ID:
+        case USB_EHCI_MODEL_HWGENERAL:
+        case USB_EHCI_MODEL_HWHOST:
+        case USB_EHCI_MODEL_HWDEVICE:
+        case USB_EHCI_MODEL_HCIVERSION:
+        case USB_EHCI_MODEL_HCSPARAMS:
+        case USB_EHCI_MODEL_HCCPARAMS:
+        case USB_EHCI_MODEL_DCIVERSION:
+        case USB_EHCI_MODEL_DCCPARAMS:
+        case USB_EHCI_MODEL_EPSR:
+            USB_EHCI_MODEL_REG(model, offset) = oldValue;
+            break;
+        case USB_EHCI_MODEL_GPTIMER0CTL:
+            USB_EhciModelWriteTimer(model, 0U);
+            break;
+        case USB_EHCI_MODEL_GPTIMER1CTL:
+            USB_EhciModelWriteTimer(model, 1U);
+            break;
+        case USB_EHCI_MODEL_USBCMD:
+            USB_EhciModelWriteCommand(model, oldValue);
+            break;
+        case USB_EHCI_MODEL_USBSTS:
+            USB_EHCI_MODEL_REG(model, offset) = oldValue & ~(value & USB_EHCI_MODEL_USBSTS_W1C_MASK);
+            break;
+        case USB_EHCI_MODEL_FRINDEX:
+            USB_EHCI_MODEL_REG(model, offset) = value & 0x3FFFU;
+            break;
+        case USB_EHCI_MODEL_DEVICEADDR:
+            if ((0U != USB_EhciModelIsDevice(model)) && (0U == (value & USB_EHCI_MODEL_DEVICEADDR_USBADRA)))
+            {
+                model->address        = (uint8_t)(value >> USB_EHCI_MODEL_DEVICEADDR_SHIFT);
+                model->addressPending = 0U;
+            }
+            else
+            {
+                model->addressPending = 1U;
+            }
+            break;
+        case USB_EHCI_MODEL_ASYNCLISTADDR:
+            model->asyncQh = 0U;
+            break;
+        case USB_EHCI_MODEL_PORTSC1:
+            USB_EhciModelWritePort(model, oldValue);
+            break;
+        case USB_EHCI_MODEL_OTGSC:
+            USB_EHCI_MODEL_REG(model, offset) =
+                (oldValue & USB_EHCI_MODEL_OTGSC_STATE_MASK) |
+                (oldValue & USB_EHCI_MODEL_OTGSC_STATUS_MASK & ~(value & USB_EHCI_MODEL_OTGSC_STATUS_MASK)) |
+                (value & ~(USB_EHCI_MODEL_OTGSC_STATE_MASK | USB_EHCI_MODEL_OTGSC_STATUS_MASK));
+            break;
+        case USB_EHCI_MODEL_EPSETUPSR:
+        case USB_EHCI_MODEL_EPCOMPLETE:
+            USB_EHCI_MODEL_REG(model, offset) = oldValue & ~value;
+            break;
+        case USB_EHCI_MODEL_EPPRIME:
+            USB_EhciModelDevicePrime(model, value | oldValue);
+            break;
+        case USB_EHCI_MODEL_EPFLUSH:
+            USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_EPSR) &= ~value;
+            USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_EPPRIME) &= ~value;
+            for (index = 0U; index < (USB_EHCI_MODEL_DEVICE_ENDPOINTS * 2U); index++)
+            {
+                if (0U != (value & (1UL << ((index >> 1U) + 16U * (index & 1U)))))
+                {
+                    model->dtdOffset[index]  = 0U;
+                    model->zltPending[index] = 0U;
+                }
+            }
+            USB_EHCI_MODEL_REG(model, offset) = 0U;
+            break;
+        default:
+            if ((offset >= USB_EHCI_MODEL_EPCR0) && (offset <= USB_EHCI_MODEL_EPCR_LAST))
+            {
+                /* the data toggle resets clear themselves, the control endpoint is always enabled */
+                value &= ~(USB_EHCI_MODEL_EPCR_TXR | USB_EHCI_MODEL_EPCR_RXR);
+                if (USB_EHCI_MODEL_EPCR0 == offset)
+                {
+                    value = (value & (USB_EHCI_MODEL_EPCR_TXS | USB_EHCI_MODEL_EPCR_RXS)) | USB_EHCI_MODEL_EPCR_TXE |
+                            USB_EHCI_MODEL_EPCR_RXE;
+                }
+                USB_EHCI_MODEL_REG(model, offset) = value;
+            }
+            break;
+    }
+}
+
+/*!
+ * @brief Finds the instance of a faulting address.
+ *
+ * @param address The faulting address.
+ *
+ * @return The instance, NULL if the address is not in the register windows.
+ */
+static usb_ehci_model_state_struct_t *USB_EhciModelFind(uintptr_t address)
+{
+    uintptr_t base = (uintptr_t)s_UsbEhciModelWindow;
+
+    if ((NULL == s_UsbEhciModelWindow) || (address < base) ||
+        (address >= (base + USB_EHCI_MODEL_WINDOW_SIZE * USB_EHCI_MODEL_INSTANCE_COUNT)))
+    {
+        return NULL;
+    }
+    return &s_UsbEhciModelState[(address - base) / USB_EHCI_MODEL_WINDOW_SIZE];
+}
+
+/*!
+ * @brief The SIGSEGV handler, it opens the register window for the faulting instruction.
+ *
+ * The instruction is single stepped with the trap flag, the SIGTRAP handler closes the window again and applies the
+ * write. A fault out of the windows goes to the previous handler.
+ */
+static void USB_EhciModelSegvHandler(int signalNumber, siginfo_t *info, void *context)
+{
+    ucontext_t *userContext = (ucontext_t *)context;
+    usb_ehci_model_state_struct_t *model = USB_EhciModelFind((uintptr_t)info->si_addr);
+
+    if ((NULL == model) || (NULL != s_UsbEhciModelTrap.model))
+    {
+        /* not a register access, the instruction faults again with the previous handler */
+        (void)sigaction(SIGSEGV, &s_UsbEhciModelSegvAction, NULL);
+        return;
+    }
+    s_UsbEhciModelTrap.model    = model;
+    s_UsbEhciModelTrap.offset   = (uint32_t)(((uintptr_t)info->si_addr - (uintptr_t)model->window) & ~3UL);
+    /* the page fault error code tells a write from a read */
+    s_UsbEhciModelTrap.write =
+        (uint8_t)((0U != ((uint64_t)userContext->uc_mcontext.gregs[REG_ERR] & 0x2U)) ? 1U : 0U);
+    if (0U != s_UsbEhciModelTrap.write)
+    {
+        model->statistic.registerWrites++;
+    }
+    else
+    {
+        model->statistic.registerReads++;
+        if (USB_EHCI_MODEL_FRINDEX == s_UsbEhciModelTrap.offset)
+        {
+            /* the busy waits of the drivers poll FRINDEX, let the bus time pass */
+            USB_EhciModelStep();
+        }
+    }
+    s_UsbEhciModelTrap.oldValue = USB_EHCI_MODEL_REG(model, s_UsbEhciModelTrap.offset);
+    (void)mprotect(model->window, USB_EHCI_MODEL_WINDOW_SIZE, PROT_READ | PROT_WRITE);
+    userContext->uc_mcontext.gregs[REG_EFL] |= USB_EHCI_MODEL_TRAP_FLAG;
+    (void)signalNumber;
+}
+
+/*!
+ * @brief The SIGTRAP handler, it closes the register window after the access and applies the write.
+ */
+static void USB_EhciModelTrapHandler(int signalNumber, siginfo_t *info, void *context)
+{
+    ucontext_t *userContext = (ucontext_t *)context;
+    usb_ehci_model_state_struct_t *model = s_UsbEhciModelTrap.model;
+
+    if (NULL == model)
+    {
+        /* not a single step of the model */
+        (void)sigaction(SIGTRAP, &s_UsbEhciModelTrapAction, NULL);
+        (void)raise(SIGTRAP);
+        return;
+    }
+    userContext->uc_mcontext.gregs[REG_EFL] &= ~(greg_t)USB_EHCI_MODEL_TRAP_FLAG;
+    (void)mprotect(model->window, USB_EHCI_MODEL_WINDOW_SIZE, PROT_NONE);
+    if (0U != s_UsbEhciModelTrap.write)
+    {
+        USB_EhciModelRegisterWrite(model, s_UsbEhciModelTrap.offset, s_UsbEhciModelTrap.oldValue);
+    }
+    s_UsbEhciModelTrap.model = NULL;
+    (void)signalNumber;
+    (void)info;
+}
+
+usb_status_t USB_EhciModelInit(void)
+{
+    struct sigaction action;
+    size_t size = (size_t)USB_EHCI_MODEL_WINDOW_SIZE * USB_EHCI_MODEL_INSTANCE_COUNT;
+    uint8_t instance;
+    int fd;
+
+    if (NULL != s_UsbEhciModelWindow)
+    {
+        return kStatus_USB_Success;
+    }
+    if (USB_EHCI_MODEL_WINDOW_SIZE != (uint32_t)sysconf(_SC_PAGESIZE))
+    {
+        return kStatus_USB_Error;
+    }
+    /* one shared memory, the driver side mapping traps every access, the model side mapping does not */
+    fd = memfd_create("usb_ehci_model", MFD_CLOEXEC);
+    if (fd < 0)
+    {
+        return kStatus_USB_AllocFail;
+    }
+    if (0 != ftruncate(fd, (off_t)size))
+    {
+        (void)close(fd);
+        return kStatus_USB_AllocFail;
+    }
+    s_UsbEhciModelWindow = (uint8_t *)mmap(NULL, size, PROT_NONE, MAP_SHARED | MAP_32BIT, fd, 0);
+    s_UsbEhciModelAlias  = (uint8_t *)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if ((MAP_FAILED == (void *)s_UsbEhciModelWindow) || (MAP_FAILED == (void *)s_UsbEhciModelAlias))
+    {
+        if (MAP_FAILED != (void *)s_UsbEhciModelWindow)
+        {
+            (void)munmap(s_UsbEhciModelWindow, size);
+        }
+        if (MAP_FAILED != (void *)s_UsbEhciModelAlias)
+        {
+            (void)munmap(s_UsbEhciModelAlias, size);
+        }
+        s_UsbEhciModelWindow = NULL;
+        s_UsbEhciModelAlias  = NULL;
+        return kStatus_USB_AllocFail;
+    }
+
+    (void)memset(s_UsbEhciModelState, 0, sizeof(s_UsbEhciModelState));
+    for (instance = 0U; instance < USB_EHCI_MODEL_INSTANCE_COUNT; instance++)
+    {
+        s_UsbEhciModelState[instance].window = s_UsbEhciModelWindow + USB_EHCI_MODEL_WINDOW_SIZE * instance;
+        s_UsbEhciModelState[instance].registers =
+            (volatile uint32_t *)(void *)(s_UsbEhciModelAlias + USB_EHCI_MODEL_WINDOW_SIZE * instance);
+        s_UsbEhciModelState[instance].peer = 0xFFU;
+        USB_EhciModelResetRegisters(&s_UsbEhciModelState[instance]);
+    }
+    s_UsbEhciModelTrap.model = NULL;
+
+    (void)memset(&action, 0, sizeof(action));
+    (void)sigemptyset(&action.sa_mask);
+    action.sa_flags     = SA_SIGINFO;
+    action.sa_sigaction = USB_EhciModelSegvHandler;
+    if (0 != sigaction(SIGSEGV, &action, &s_UsbEhciModelSegvAction))
+    {
+        USB_EhciModelDeinit();
+        return kStatus_USB_Error;
+    }
+    action.sa_sigaction = USB_EhciModelTrapHandler;
+    if (0 != sigaction(SIGTRAP, &action, &s_UsbEhciModelTrapAction))
+    {
+        (void)sigaction(SIGSEGV, &s_UsbEhciModelSegvAction, NULL);
+        USB_EhciModelDeinit();
+        return kStatus_USB_Error;
+    }
+    return kStatus_USB_Success;
+}
+
+void USB_EhciModelDeinit(void)
+{
+    size_t size = (size_t)USB_EHCI_MODEL_WINDOW_SIZE * USB_EHCI_MODEL_INSTANCE_COUNT;
+    struct sigaction action;
+
+    if (NULL == s_UsbEhciModelWindow)
+    {
+        return;
+    }
+    /* only restore the handlers the model installed */
+    if ((0 == sigaction(SIGSEGV, NULL, &action)) && (USB_EhciModelSegvHandler == action.sa_sigaction))
+    {
+        (void)sigaction(SIGSEGV, &s_UsbEhciModelSegvAction, NULL);
+    }
+    if ((0 == sigaction(SIGTRAP, NULL, &action)) && (USB_EhciModelTrapHandler == action.sa_sigaction))
+    {
+        (void)sigaction(SIGTRAP, &s_UsbEhciModelTrapAction, NULL);
+    }
+    (void)munmap(s_UsbEhciModelWindow, size);
+    (void)munmap(s_UsbEhciModelAlias, size);
+    s_UsbEhciModelWindow = NULL;
+    s_UsbEhciModelAlias  = NULL;
+}
+
+uint32_t USB_EhciModelGetBase(uint8_t modelId)
+{
+    if ((NULL == s_UsbEhciModelWindow) || (modelId >= USB_EHCI_MODEL_INSTANCE_COUNT))
+    {
+        return 0U;
+    }
+    return (uint32_t)(uintptr_t)s_UsbEhciModelState[modelId].window;
+}
+
+void USB_EhciModelSetIsr(uint8_t modelId, usb_ehci_model_isr_t isr, void *isrParam)
+{
+    if (modelId < USB_EHCI_MODEL_INSTANCE_COUNT)
+    {
+        s_UsbEhciModelState[modelId].isr      = isr;
+        s_UsbEhciModelState[modelId].isrParam = isrParam;
+    }
+}
+
+usb_status_t USB_EhciModelConnect(uint8_t hostId, uint8_t deviceId, uint8_t speed)
+{
+    usb_ehci_model_state_struct_t *device;
+
+    if ((NULL == s_UsbEhciModelWindow) || (hostId >= USB_EHCI_MODEL_INSTANCE_COUNT) ||
+        (deviceId >= USB_EHCI_MODEL_INSTANCE_COUNT) || (hostId == deviceId) ||
+        ((USB_SPEED_FULL != speed) && (USB_SPEED_HIGH != speed)))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    USB_EhciModelDisconnect(hostId);
+    device                               = &s_UsbEhciModelState[deviceId];
+    s_UsbEhciModelState[hostId].peer     = deviceId;
+    s_UsbEhciModelState[hostId].speed    = speed;
+    device->peer                         = hostId;
+    device->speed                        = speed;
+    if ((0U != USB_EhciModelIsDevice(device)) &&
+        (0U != (USB_EHCI_MODEL_REG(device, USB_EHCI_MODEL_USBCMD) & USB_EHCI_MODEL_USBCMD_RS)))
+    {
+        USB_EhciModelDeviceAttach(device, 1U);
+    }
+    return kStatus_USB_Success;
+}
+
+void USB_EhciModelDisconnect(uint8_t hostId)
+{
+    usb_ehci_model_state_struct_t *host;
+    usb_ehci_model_state_struct_t *device;
+
+    if ((NULL == s_UsbEhciModelWindow) || (hostId >= USB_EHCI_MODEL_INSTANCE_COUNT))
+    {
+        return;
+    }
+    host   = &s_UsbEhciModelState[hostId];
+    device = USB_EhciModelPeer(host);
+    if (NULL == device)
+    {
+        return;
+    }
+    USB_EhciModelDeviceAttach(device, 0U);
+    device->peer = 0xFFU;
+    host->peer   = 0xFFU;
+}
+
+void USB_EhciModelSetDmaWindow(uint8_t modelId, uint32_t base, uint32_t length)
+{
+    if (modelId < USB_EHCI_MODEL_INSTANCE_COUNT)
+    {
+        s_UsbEhciModelState[modelId].dmaBase   = base;
+        s_UsbEhciModelState[modelId].dmaLength = length;
+    }
+}
+
+void USB_EhciModelRun(void)
+{
+    usb_ehci_model_state_struct_t *model;
+    uint32_t pending;
+    uint8_t instance;
+    uint8_t count;
+
+    if (NULL == s_UsbEhciModelWindow)
+    {
+        return;
+    }
+    USB_EhciModelStep();
+    for (instance = 0U; instance < USB_EHCI_MODEL_INSTANCE_COUNT; instance++)
+    {
+        model = &s_UsbEhciModelState[instance];
+        /* an interrupt source the driver does not clear does not hang the model */
+        for (count = 0U; (count < 4U) && (NULL != model->isr); count++)
+        {
+            pending = (USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBSTS) &
+                       USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_USBINTR) & USB_EHCI_MODEL_USBSTS_W1C_MASK) |
+                      (USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_OTGSC) &
+                       (USB_EHCI_MODEL_REG(model, USB_EHCI_MODEL_OTGSC) >> 8U) & USB_EHCI_MODEL_OTGSC_STATUS_MASK);
+            if (0U == pending)
+            {
+                break;
+            }
+            model->statistic.interrupts++;
+            model->isr(model->isrParam);
+        }
+    }
+}
+
+void USB_EhciModelGetStatistic(uint8_t modelId, usb_ehci_model_statistic_struct_t *statistic)
+{
+    if ((modelId < USB_EHCI_MODEL_INSTANCE_COUNT) && (NULL != statistic))
+    {
+        *statistic = s_UsbEhciModelState[modelId].statistic;
+    }
+}
+
+usb_status_t USB_EhciModelBusReset(uint8_t deviceId, uint8_t speed)
+{
+    if ((NULL == s_UsbEhciModelWindow) || (deviceId >= USB_EHCI_MODEL_INSTANCE_COUNT) ||
+        (0U == USB_EhciModelIsDevice(&s_UsbEhciModelState[deviceId])) ||
+        ((USB_SPEED_FULL != speed) && (USB_SPEED_HIGH != speed)))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    USB_EhciModelDeviceResetStart(&s_UsbEhciModelState[deviceId], speed);
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Converts a handshake to the status of the bus API.
+ */
+static usb_status_t USB_EhciModelBusStatus(usb_ehci_model_handshake_t handshake)
+{
+    usb_status_t status;
+
+    switch (handshake)
+    {
+        case kEhciModel_Ack:
+            status = kStatus_USB_Success;
+            break;
+        case kEhciModel_Nak:
+            status = kStatus_USB_Busy;
+            break;
+        case kEhciModel_Stall:
+            status = kStatus_USB_TransferStall;
+            break;
+        case kEhciModel_Babble:
+            status = kStatus_USB_DataOverRun;
+            break;
+        default:
+            status = kStatus_USB_Error;
+            break;
+    }
+    return status;
+}
+
+usb_status_t USB_EhciModelBusSetup(uint8_t deviceId, uint8_t address, uint8_t endpoint, const uint8_t *setup)
+{
+    uint8_t packet[8];
+    uint32_t length = sizeof(packet);
+
+    if ((NULL == s_UsbEhciModelWindow) || (deviceId >= USB_EHCI_MODEL_INSTANCE_COUNT) || (NULL == setup))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    (void)memcpy(packet, setup, sizeof(packet));
+    return USB_EhciModelBusStatus(USB_EhciModelDeviceTransaction(&s_UsbEhciModelState[deviceId],
+                                                                 USB_EHCI_MODEL_PID_SETUP, address, endpoint, packet,
+                                                                 &length, 0U));
+}
+
+usb_status_t USB_EhciModelBusIn(
+    uint8_t deviceId, uint8_t address, uint8_t endpoint, uint8_t *buffer, uint32_t maxLength, uint32_t *length)
+{
+    uint8_t packet[USB_EHCI_MODEL_MAX_PACKET];
+    uint32_t count = 0U;
+    usb_status_t status;
+
+    if ((NULL == s_UsbEhciModelWindow) || (deviceId >= USB_EHCI_MODEL_INSTANCE_COUNT) || (NULL == buffer) ||
+        (NULL == length))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    status = USB_EhciModelBusStatus(USB_EhciModelDeviceTransaction(&s_UsbEhciModelState[deviceId],
+                                                                   USB_EHCI_MODEL_PID_IN, address, endpoint, packet,
+                                                                   &count, maxLength));
+    *length = 0U;
+    if (kStatus_USB_Success == status)
+    {
+        (void)memcpy(buffer, packet, count);
+        *length = count;
+    }
+    return status;
+}
+
+usb_status_t USB_EhciModelBusOut(
+    uint8_t deviceId, uint8_t address, uint8_t endpoint, const uint8_t *buffer, uint32_t length)
+{
+    uint8_t packet[USB_EHCI_MODEL_MAX_PACKET];
+
+    if ((NULL == s_UsbEhciModelWindow) || (deviceId >= USB_EHCI_MODEL_INSTANCE_COUNT) ||
+        (length > USB_EHCI_MODEL_MAX_PACKET) || ((NULL == buffer) && (0U != length)))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    if (0U != length)
+    {
+        (void)memcpy(packet, buffer, length);
+    }
+    return USB_EhciModelBusStatus(USB_EhciModelDeviceTransaction(&s_UsbEhciModelState[deviceId],
+                                                                 USB_EHCI_MODEL_PID_OUT, address, endpoint, packet,
+                                                                 &length, 0U));
+}
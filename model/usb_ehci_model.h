@@ -0,0 +1,272 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __USB_EHCI_MODEL_H__
+#define __USB_EHCI_MODEL_H__
+
+#include "usb.h"
+
+/*!
+ * @addtogroup usb_ehci_model
+ * @{
+ */
+
+/*
+ * The EHCI model is a register level model of the EHCI (ChipIdea) controller for x86_64 Linux hosts. It lets the
+ * unmodified usb_device_ehci.c and usb_host_ehci.c run without a board:
+ *
+ * - Every model instance owns one page of register window. The page the drivers see is inaccessible, each register
+ *   access faults, the access is single stepped and the register semantics (write 1 to clear, prime, flush, port
+ *   reset, run/stop, timers...) are applied after the instruction. The window addresses are below 2GB because the
+ *   drivers keep the base address in an uint32_t.
+ * - The device engine consumes the dQH/dTD lists like the hardware, the host engine walks the periodic frame list
+ *   (iTD, siTD and interrupt QH) and the asynchronous QH ring (qTD). The host engine of one instance issues its
+ *   transactions to the device engine of the connected instance, so the host EHCI driver can enumerate and use the
+ *   device EHCI driver in the same process.
+ * - Time is virtual. USB_EhciModelRun advances the bus by one micro-frame and calls the interrupt service routine of
+ *   the instances that have an enabled interrupt pending. Each FRINDEX read also advances the bus by one micro-frame,
+ *   so the delay loops of the drivers (port debounce, port reset recovery...) finish without real waiting.
+ *
+ * The drivers get the window with the base address override, for example:
+ *     -DUSBHS_STACK_BASE_ADDRS="{USB_EhciModelGetBase(0U), USB_EhciModelGetBase(1U)}" -include usb_ehci_model.h
+ * (the options are for the driver files, usb_ehci_model.c is built without them). The drivers must be built without
+ * PIE (or the descriptors and buffers must be allocated below 2GB) because the controller data structures hold 32-bit
+ * addresses. The host iTD is not 32 bytes aligned with 64-bit pointers, keep USB_HOST_CONFIG_EHCI_MAX_ITD 0.
+ *
+ * The model is single threaded: the drivers, the task functions and USB_EhciModelRun must run in the same thread,
+ * USB_EhciModelRun preempts the application like the USB interrupt does.
+ *
+ * Not modeled: split transaction timing (a FS/LS periodic endpoint is served in the micro-frame of its S-mask), data
+ * toggle mismatches, suspend/resume signaling, the OTG state machine and the PHY/USBNC registers.
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief The model instance count */
+#ifndef USB_EHCI_MODEL_INSTANCE_COUNT
+#define USB_EHCI_MODEL_INSTANCE_COUNT (2U)
+#endif
+
+/*! @brief The register window size of one instance, one page */
+#define USB_EHCI_MODEL_WINDOW_SIZE (0x1000U)
+
+/*! @brief The endpoint count of the device engine, reported in DCCPARAMS */
+#define USB_EHCI_MODEL_DEVICE_ENDPOINTS (8U)
+
+/*! @brief The maximum QH count walked in one micro-frame, it stops a malformed asynchronous ring */
+#define USB_EHCI_MODEL_ASYNC_WALK_LIMIT (256U)
+
+/*! @brief The maximum element count walked in one periodic frame list entry */
+#define USB_EHCI_MODEL_PERIODIC_WALK_LIMIT (128U)
+
+/*! @brief The bus time of one HS micro-frame in bytes available for the asynchronous schedule */
+#define USB_EHCI_MODEL_HS_MICROFRAME_BYTES (7500U)
+
+/*! @brief The bus time of one FS frame in bytes, one eighth of it is available per micro-frame */
+#define USB_EHCI_MODEL_FS_FRAME_BYTES (1500U)
+
+/*! @brief The token, handshake and inter-packet overhead of one HS transaction in bytes */
+#define USB_EHCI_MODEL_HS_TRANSACTION_OVERHEAD (20U)
+
+/*! @brief The token, handshake and inter-packet overhead of one FS transaction in bytes */
+#define USB_EHCI_MODEL_FS_TRANSACTION_OVERHEAD (13U)
+
+/*! @brief The device bus reset length in micro-frames, the device sees PORTSC1[PR] during this time */
+#define USB_EHCI_MODEL_BUS_RESET_MICROFRAMES (8U)
+
+/*! @brief The interrupt service routine of one model instance */
+typedef void (*usb_ehci_model_isr_t)(void *isrParam);
+
+/*! @brief Statistics of one model instance */
+typedef struct _usb_ehci_model_statistic_struct
+{
+    uint32_t microframes;      /*!< Micro-frames simulated */
+    uint32_t registerReads;    /*!< Trapped register reads */
+    uint32_t registerWrites;   /*!< Trapped register writes, a read-modify-write instruction is one write */
+    uint32_t interrupts;       /*!< Interrupt service routine calls */
+    uint32_t transactions;     /*!< Bus transactions, SETUP, IN and OUT, issued (host) or answered (device) */
+    uint32_t nakCount;         /*!< NAKed transactions */
+    uint32_t errorCount;       /*!< STALLed, babbled and unanswered transactions */
+    uint32_t byteCount;        /*!< Data bytes moved by the acknowledged transactions */
+    uint32_t descriptorErrors; /*!< Invalid descriptor or buffer addresses, the host reports a system error */
+} usb_ehci_model_statistic_struct_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name USB EHCI model APIs
+ * @{
+ */
+
+/*!
+ * @brief Initializes the EHCI model.
+ *
+ * This function maps the register windows of all instances, puts the registers in the reset state and installs the
+ * SIGSEGV and SIGTRAP handlers that implement the register accesses.
+ *
+ * @retval kStatus_USB_Success              The model is initialized successfully.
+ * @retval kStatus_USB_AllocFail            The register windows cannot be mapped below 2GB.
+ * @retval kStatus_USB_Error                The signal handlers cannot be installed.
+ */
+usb_status_t USB_EhciModelInit(void);
+
+/*!
+ * @brief Deinitializes the EHCI model.
+ *
+ * This function restores the previous signal handlers and unmaps the register windows.
+ */
+void USB_EhciModelDeinit(void);
+
+/*!
+ * @brief Gets the register window of one instance.
+ *
+ * @param modelId  The model instance, 0 to USB_EHCI_MODEL_INSTANCE_COUNT - 1.
+ *
+ * @return The USBHS_Type base address the driver uses, 0 if the model is not initialized.
+ */
+uint32_t USB_EhciModelGetBase(uint8_t modelId);
+
+/*!
+ * @brief Sets the interrupt service routine of one instance.
+ *
+ * @param modelId  The model instance.
+ * @param isr      The routine, for example USB_DeviceEhciIsrFunction or USB_HostEhciIsrFunction. NULL masks it.
+ * @param isrParam The routine parameter, the device handle or the host handle.
+ */
+void USB_EhciModelSetIsr(uint8_t modelId, usb_ehci_model_isr_t isr, void *isrParam);
+
+/*!
+ * @brief Connects a host mode instance to a device mode instance.
+ *
+ * The device is attached to the host port when the device sets USBCMD[RS] and the host port is powered.
+ *
+ * @param hostId   The instance the host driver uses.
+ * @param deviceId The instance the device driver uses.
+ * @param speed    The bus speed, USB_SPEED_FULL or USB_SPEED_HIGH.
+ *
+ * @retval kStatus_USB_Success              The instances are connected.
+ * @retval kStatus_USB_InvalidParameter     The instances or the speed are invalid.
+ */
+usb_status_t USB_EhciModelConnect(uint8_t hostId, uint8_t deviceId, uint8_t speed);
+
+/*!
+ * @brief Disconnects the device from the host port.
+ *
+ * @param hostId   The instance the host driver uses.
+ */
+void USB_EhciModelDisconnect(uint8_t hostId);
+
+/*!
+ * @brief Restricts the addresses the instance can access by DMA.
+ *
+ * Any descriptor or buffer out of the window is reported as a system error (host) or ignored (device) instead of
+ * being accessed, it is used to fuzz the descriptor handling of the drivers. The default is no restriction.
+ *
+ * @param modelId  The model instance.
+ * @param base     The window start address.
+ * @param length   The window length, 0 removes the restriction.
+ */
+void USB_EhciModelSetDmaWindow(uint8_t modelId, uint32_t base, uint32_t length);
+
+/*!
+ * @brief Runs the model for one micro-frame.
+ *
+ * This function advances all instances by one micro-frame and calls the interrupt service routines of the instances
+ * that have an enabled interrupt pending.
+ */
+void USB_EhciModelRun(void);
+
+/*!
+ * @brief Gets the statistics of one instance.
+ *
+ * The trapped register accesses cost some micro-seconds each on the host, subtract them when profiling the drivers.
+ *
+ * @param modelId  The model instance.
+ * @param statistic Returns the statistics.
+ */
+void USB_EhciModelGetStatistic(uint8_t modelId, usb_ehci_model_statistic_struct_t *statistic);
+
+/*!
+ * @brief Resets the bus of a device mode instance without a host instance.
+ *
+ * The following functions drive the device engine from the bus side, a test can use them in place of the host
+ * driver to send arbitrary requests to the device driver.
+ *
+ * @param deviceId The device mode instance.
+ * @param speed    The bus speed, USB_SPEED_FULL or USB_SPEED_HIGH.
+ *
+ * @retval kStatus_USB_Success              The bus reset is started, it ends after USB_EHCI_MODEL_BUS_RESET_MICROFRAMES.
+ * @retval kStatus_USB_InvalidParameter     The instance is not in device mode.
+ */
+usb_status_t USB_EhciModelBusReset(uint8_t deviceId, uint8_t speed);
+
+/*!
+ * @brief Sends a SETUP transaction to a device mode instance.
+ *
+ * @param deviceId The device mode instance.
+ * @param address  The device address.
+ * @param endpoint The control endpoint number.
+ * @param setup    The 8 bytes setup packet.
+ *
+ * @retval kStatus_USB_Success              The device acknowledged the packet.
+ * @retval kStatus_USB_Error                The device did not answer.
+ */
+usb_status_t USB_EhciModelBusSetup(uint8_t deviceId, uint8_t address, uint8_t endpoint, const uint8_t *setup);
+
+/*!
+ * @brief Sends an IN transaction to a device mode instance.
+ *
+ * @param deviceId  The device mode instance.
+ * @param address   The device address.
+ * @param endpoint  The endpoint number.
+ * @param buffer    Returns the data packet.
+ * @param maxLength The buffer length, a longer packet is a babble.
+ * @param length    Returns the data packet length.
+ *
+ * @retval kStatus_USB_Success              The device sent a data packet.
+ * @retval kStatus_USB_Busy                 The device NAKed.
+ * @retval kStatus_USB_TransferStall        The device STALLed.
+ * @retval kStatus_USB_DataOverRun          The data packet is longer than maxLength, it is not acknowledged.
+ * @retval kStatus_USB_Error                The device did not answer.
+ */
+usb_status_t USB_EhciModelBusIn(
+    uint8_t deviceId, uint8_t address, uint8_t endpoint, uint8_t *buffer, uint32_t maxLength, uint32_t *length);
+
+/*!
+ * @brief Sends an OUT transaction to a device mode instance.
+ *
+ * @param deviceId The device mode instance.
+ * @param address  The device address.
+ * @param endpoint The endpoint number.
+ * @param buffer   The data packet.
+ * @param length   The data packet length.
+ *
+ * @retval kStatus_USB_Success              The device acknowledged the packet.
+ * @retval kStatus_USB_Busy                 The device NAKed.
+ * @retval kStatus_USB_TransferStall        The device STALLed.
+ * @retval kStatus_USB_Error                The device did not answer.
+ */
+usb_status_t USB_EhciModelBusOut(
+    uint8_t deviceId, uint8_t address, uint8_t endpoint, const uint8_t *buffer, uint32_t length);
+
+/*! @}*/
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* __USB_EHCI_MODEL_H__ */
@@ -34,9 +34,13 @@
 /*! @brief LPC USB IP3511 HS instance count */
 #define USB_DEVICE_CONFIG_LPCIP3511HS (1U)
 
+/*! @brief Software loopback controller instance count */
+#define USB_DEVICE_CONFIG_LOOPBACK (0U)
+
 /*! @brief Device instance count, the sum of KHCI and EHCI instance counts*/
-#define USB_DEVICE_CONFIG_NUM \
-    (USB_DEVICE_CONFIG_KHCI + USB_DEVICE_CONFIG_EHCI + USB_DEVICE_CONFIG_LPCIP3511FS + USB_DEVICE_CONFIG_LPCIP3511HS)
+#define USB_DEVICE_CONFIG_NUM                                                                                          \
+    (USB_DEVICE_CONFIG_KHCI + USB_DEVICE_CONFIG_EHCI + USB_DEVICE_CONFIG_LPCIP3511FS + USB_DEVICE_CONFIG_LPCIP3511HS + \
+     USB_DEVICE_CONFIG_LOOPBACK)
 
 /* @} */
 
@@ -107,12 +111,20 @@
 /*! @brief How many the notification message are supported when the device task is enabled. */
 #define USB_DEVICE_CONFIG_MAX_MESSAGES (8U)
 
+/*! @brief Whether the endpoints can be selected for the direct callback mode by USB_DeviceSetEndpointDirectCallback,
+ * the controller interrupt calls the endpoint callback without the notification message. */
+#define USB_DEVICE_CONFIG_ENDPOINT_DIRECT_CALLBACK (0U)
+
 /*! @brief Whether test mode enabled. */
 #define USB_DEVICE_CONFIG_USB20_TEST_MODE (0U)
 
 /*! @brief Whether device CV test is enabled. */
 #define USB_DEVICE_CONFIG_CV_TEST (0U)
 
+/*! @brief Whether the GET_DESCRIPTOR requests can be answered from a descriptor table registered by
+ * USB_DeviceClassSetDescriptorTable. */
+#define USB_DEVICE_CONFIG_DESCRIPTOR_TABLE (0U)
+
 /*! @brief Whether device compliance test is enabled. If the macro is enabled,
     the test mode and CV test macroes will be set.*/
 #ifndef USB_DEVICE_CONFIG_COMPLIANCE_TEST
@@ -138,6 +150,10 @@
 
 /*! @brief The MAX buffer length for the KHCI DMA workaround.*/
 #define USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_LENGTH (64U)
+
+/*! @brief The DMA align buffer count of the KHCI DMA workaround, the OUT endpoints receiving unaligned buffers at the
+ * same time. The maximum is 32.*/
+#define USB_DEVICE_CONFIG_KHCI_DMA_ALIGN_BUFFER_COUNT (1U)
 #endif
 
 #if ((defined(USB_DEVICE_CONFIG_EHCI)) && (USB_DEVICE_CONFIG_EHCI > 0U))
@@ -151,7 +167,8 @@
 /*! @brief Whether the keep alive feature enabled. */
 #define USB_DEVICE_CONFIG_KEEP_ALIVE_MODE (0U)
 
-/*! @brief Whether the transfer buffer is cache-enabled or not. */
+/*! @brief Whether the transfer buffer is cache-enabled or not. The cache maintenance is done by the USB cache
+ * component (cache/usb_cache.c). */
 #ifndef USB_DEVICE_CONFIG_BUFFER_PROPERTY_CACHEABLE
 #define USB_DEVICE_CONFIG_BUFFER_PROPERTY_CACHEABLE (0U)
 #endif
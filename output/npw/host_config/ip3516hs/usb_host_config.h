@@ -40,14 +40,22 @@
  */
 #define USB_HOST_CONFIG_IP3516HS (1U)
 
+/*!
+ * @brief host loopback instance count, meantime it indicates loopback enable or disable.
+ *        - if 0, host loopback driver is disable.
+ *        - if greater than 0, host loopback driver is enable, it drives the device loopback controller.
+ */
+#define USB_HOST_CONFIG_LOOPBACK (0U)
+
 /* Common configuration macros for all controllers */
 
 /*!
  * @brief host driver instance max count.
  * for example: 2 - one for khci, one for ehci.
  */
-#define USB_HOST_CONFIG_MAX_HOST \
-    (USB_HOST_CONFIG_KHCI + USB_HOST_CONFIG_EHCI + USB_HOST_CONFIG_OHCI + USB_HOST_CONFIG_IP3516HS)
+#define USB_HOST_CONFIG_MAX_HOST                                                                                       \
+    (USB_HOST_CONFIG_KHCI + USB_HOST_CONFIG_EHCI + USB_HOST_CONFIG_OHCI + USB_HOST_CONFIG_IP3516HS +                   \
+     USB_HOST_CONFIG_LOOPBACK)
 
 /*!
  * @brief host pipe max count.
@@ -97,7 +105,8 @@
  */
 #define USB_HOST_CONFIG_MAX_NAK (3000U)
 
-/*! @brief Whether the transfer buffer is cache-enabled or not. */
+/*! @brief Whether the transfer buffer is cache-enabled or not. The cache maintenance is done by the USB cache
+ * component (cache/usb_cache.c). */
 #ifndef USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE
 #define USB_HOST_CONFIG_BUFFER_PROPERTY_CACHEABLE (0U)
 #endif
@@ -109,6 +118,69 @@
 /*! @brief if 1, class driver clear stall automatically; if 0, class driver don't clear stall. */
 #define USB_HOST_CONFIG_CLASS_AUTO_CLEAR_STALL (0U)
 
+/*!
+ * @brief if 1, control and bulk transfer timeouts are tracked by a hashed timing wheel that is driven by the
+ * frame count and only ticks while transfers are pending; if 0, the controller's fixed periodic scan is used.
+ * The transfer's timeout has the same meaning in both cases, see usb_host_transfer_t::timeout.
+ */
+#define USB_HOST_CONFIG_TRANSFER_TIMEOUT_WHEEL (0U)
+
+/*!
+ * @brief host transfer metrics enable or disable.
+ *
+ * The transfer count, byte count, short packet, NAK, timeout, stall, error, retry and the submit-to-complete latency
+ * histogram are recorded for every pipe and every device, see USB_HostGetPipeMetrics and USB_HostGetDeviceMetrics.
+ *        - if 0, the metrics are not recorded.
+ *        - if greater than 0, the metrics are recorded.
+ */
+#define USB_HOST_CONFIG_METRICS (0U)
+
+/*!
+ * @brief host descriptor cache enable or disable.
+ *
+ * The interface descriptor of every alternate setting is indexed when the configuration descriptor is parsed, so
+ * switching the alternate setting doesn't need to walk the interface extended descriptors.
+ *        - if 0, the alternate setting is searched in the descriptors every time.
+ *        - if greater than 0, the alternate setting is got from the index.
+ */
+#define USB_HOST_CONFIG_DESCRIPTOR_CACHE (0U)
+
+/*!
+ * @brief the max alternate setting number of one interface that is indexed in the descriptor cache.
+ * The alternate setting that is greater than or equal to this value is still searched in the descriptors.
+ */
+#define USB_HOST_CONFIG_INTERFACE_MAX_ALTSETTING (16U)
+
+/*!
+ * @brief host pipe ISR completion enable or disable.
+ *
+ * The interrupt pipe that is opened with USB_HOST_PIPE_COMPLETION_ISR completes its transfers in the controller ISR
+ * instead of the host task, EHCI, OHCI and IP3516HS support it.
+ *        - if 0, all the transfers are completed in the host task.
+ *        - if greater than 0, USB_HOST_PIPE_COMPLETION_ISR is available.
+ */
+#define USB_HOST_CONFIG_PIPE_ISR_COMPLETION (0U)
+
+/*!
+ * @brief host event ring enable or disable.
+ *
+ * The controller ISR pushes one record (pipe, status, frame) for every done pipe, the host task only processes the
+ * pipes of the records. All the pipes are checked when the ring overflows.
+ *        - if 0, the host task checks all the pipes for every transfer done event.
+ *        - if greater than 0, the event ring is used, USB_HOST_EVENT_RING_SIZE is the record count.
+ */
+#define USB_HOST_CONFIG_EVENT_RING (0U)
+
+/*!
+ * @brief host ISO packet descriptor enable or disable.
+ *
+ * The ISO transfer can carry an array of packet descriptors (offset, requested length, actual length and status of
+ * every packet), so one transfer moves many variable-size packets and the class gets the packet boundaries back.
+ *        - if 0, the ISO transfer buffer is always split by the data length of one service interval.
+ *        - if greater than 0, usb_host_transfer_t::isoPacketDescriptor is available.
+ */
+#define USB_HOST_CONFIG_ISO_PACKET_DESCRIPTOR (0U)
+
 /* KHCI configuration */
 #if ((defined USB_HOST_CONFIG_KHCI) && (USB_HOST_CONFIG_KHCI))
 
@@ -199,6 +271,17 @@
  */
 #define USB_HOST_CONFIG_HUB (1U)
 
+/*!
+ * @brief host HUB port engine enable or disable.
+ *
+ * The engine services the ports of all HUBs concurrently: the port status changes are batched, the C_PORT_x bits
+ * reported by one status are cleared back-to-back, the connect debounce is timed with the frame number instead of
+ * blocking the HUB, and only the port reset and the enumeration at address 0 are serialized.
+ *        - if 0, the ports are processed one by one.
+ *        - if greater than 0, the HUB port engine is enable.
+ */
+#define USB_HOST_CONFIG_HUB_ENGINE (0U)
+
 /*!
  * @brief host HID class instance count, meantime it indicates HID class enable or disable.
  *        - if 0, host HID class driver is disable.
@@ -206,6 +289,14 @@
  */
 #define USB_HOST_CONFIG_HID (1U)
 
+/*!
+ * @brief host HID class interrupt IN polling engine enable or disable.
+ *        The engine keeps several transfers armed on the interrupt IN pipe and queues the reports into a ring.
+ *        - if 0, the polling engine is disable.
+ *        - if greater than 0, the polling engine is enable.
+ */
+#define USB_HOST_CONFIG_HID_POLL_ENGINE (0U)
+
 /*!
  * @brief host MSD class instance count, meantime it indicates MSD class enable or disable.
  *        - if 0, host MSD class driver is disable.
@@ -220,6 +311,14 @@
  */
 #define USB_HOST_CONFIG_CDC (1U)
 
+/*!
+ * @brief host CDC class notification polling engine enable or disable.
+ *        The engine keeps several transfers armed on the interrupt IN pipe and queues the notifications into a ring.
+ *        - if 0, the polling engine is disable.
+ *        - if greater than 0, the polling engine is enable.
+ */
+#define USB_HOST_CONFIG_CDC_POLL_ENGINE (0U)
+
 /*!
  * @brief host CDC RNDSI class instance count, meantime it indicates CDC rndis class enable or disable.
  *        - if 0, host CDC class driver is disable.
@@ -234,6 +333,15 @@
  */
 #define USB_HOST_CONFIG_AUDIO (1U)
 
+/*!
+ * @brief host AUDIO class streaming engine enable or disable.
+ *        The engine keeps several ISO transfers in flight from a PCM ring and computes the OUT packet sizes from the
+ *        device feedback endpoint or the ring fill level.
+ *        - if 0, the streaming engine is disable.
+ *        - if greater than 0, the streaming engine is enable.
+ */
+#define USB_HOST_CONFIG_AUDIO_STREAM_ENGINE (0U)
+
 /*!
  * @brief host PHDC class instance count, meantime it indicates PHDC class enable or disable.
  *        - if 0, host PHDC class driver is disable.
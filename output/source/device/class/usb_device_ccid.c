@@ -19,6 +19,9 @@
  * Definitions
  ******************************************************************************/
 
+/*! @brief The invalid command buffer index, no buffer is primed or held. */
+#define USB_DEVICE_CCID_COMMAND_BUFFER_INVALID (0xFFU)
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -26,9 +29,17 @@
 static usb_status_t USB_DeviceCcidAllocateHandle(usb_device_ccid_struct_t **handle);
 static usb_status_t USB_DeviceCcidFreeHandle(usb_device_ccid_struct_t *handle);
 static usb_status_t USB_DeviceCcidRemoveTransfer(usb_device_ccid_transfer_struct_t **transfer_queue,
+                                                 usb_device_ccid_transfer_struct_t **transfer_tail,
                                                  usb_device_ccid_transfer_struct_t **transfer);
 static usb_status_t USB_DeviceCcidAddTransfer(usb_device_ccid_transfer_struct_t **transfer_queue,
+                                              usb_device_ccid_transfer_struct_t **transfer_tail,
                                               usb_device_ccid_transfer_struct_t *transfer);
+static void USB_DeviceCcidResetTransfers(usb_device_ccid_struct_t *ccidHandle);
+static usb_status_t USB_DeviceCcidKickBulkIn(usb_device_ccid_struct_t *ccidHandle, uint8_t completed);
+static usb_status_t USB_DeviceCcidQueueResponse(usb_device_ccid_struct_t *ccidHandle,
+                                                usb_device_ccid_transfer_struct_t *transfer);
+static usb_status_t USB_DeviceCcidPrimeCommand(usb_device_ccid_struct_t *ccidHandle);
+static void USB_DeviceCcidReleaseCommand(usb_device_ccid_struct_t *ccidHandle, uint8_t index);
 static usb_status_t USB_DeviceCcidInterruptIn(usb_device_handle deviceHandle,
                                               usb_device_endpoint_callback_message_struct_t *event,
                                               void *callbackParam);
@@ -98,15 +109,17 @@ static usb_status_t USB_DeviceCcidFreeHandle(usb_device_ccid_struct_t *handle)
 /*!
  * @brief Remove a transfer node from a queue.
  *
- * This function removes a transfer node from a queue.
+ * This function removes the head transfer node from a queue.
  *
  * @param transfer_queue          A pointer points to a queue pointer.
+ * @param transfer_tail           A pointer points to the queue tail pointer, NULL for the idle queue.
  * @param transfer                It is an OUT parameter, return the transfer node pointer.
  *
  * @retval kStatus_USB_Success              Free device ccid class handle successfully.
  * @retval kStatus_USB_Busy                 Can not get transfer node due to the queue is empty.
  */
 static usb_status_t USB_DeviceCcidRemoveTransfer(usb_device_ccid_transfer_struct_t **transfer_queue,
+                                                 usb_device_ccid_transfer_struct_t **transfer_tail,
                                                  usb_device_ccid_transfer_struct_t **transfer)
 {
     OSA_SR_ALLOC();
@@ -121,6 +134,10 @@ static usb_status_t USB_DeviceCcidRemoveTransfer(usb_device_ccid_transfer_struct
     if (NULL != *transfer_queue)
     {
         *transfer_queue = (*transfer_queue)->next;
+        if ((NULL == *transfer_queue) && (NULL != transfer_tail))
+        {
+            *transfer_tail = NULL;
+        }
         OSA_EXIT_CRITICAL();
         return kStatus_USB_Success;
     }
@@ -131,50 +148,193 @@ static usb_status_t USB_DeviceCcidRemoveTransfer(usb_device_ccid_transfer_struct
 /*!
  * @brief Add a transfer node to a queue.
  *
- * This function adds a transfer node to a queue.
+ * This function appends a transfer node to the tail of a queue, or pushes it to the head when the queue has no tail
+ * pointer. Both are done in constant time.
  *
  * @param transfer_queue          A pointer points to a queue pointer.
+ * @param transfer_tail           A pointer points to the queue tail pointer, NULL for the idle queue.
  * @param transfer                The transfer node pointer.
  *
  * @retval kStatus_USB_Success              Free device ccid class handle successfully.
- * @retval kStatus_USB_Error                The transfer node has been added.
  */
 static usb_status_t USB_DeviceCcidAddTransfer(usb_device_ccid_transfer_struct_t **transfer_queue,
+                                              usb_device_ccid_transfer_struct_t **transfer_tail,
                                               usb_device_ccid_transfer_struct_t *transfer)
 {
-    usb_device_ccid_transfer_struct_t *p;
-    usb_device_ccid_transfer_struct_t *q;
     OSA_SR_ALLOC();
 
-    if (NULL == transfer_queue)
+    if ((NULL == transfer_queue) || (NULL == transfer))
     {
         return kStatus_USB_InvalidParameter;
     }
-    p = *transfer_queue;
-    q = *transfer_queue;
 
     OSA_ENTER_CRITICAL();
-    while (NULL != p)
+    if (NULL == transfer_tail)
+    {
+        transfer->next  = *transfer_queue;
+        *transfer_queue = transfer;
+    }
+    else
     {
-        q = p;
-        if (p == transfer)
+        transfer->next = NULL;
+        if (NULL != *transfer_tail)
         {
-            OSA_EXIT_CRITICAL();
-            return kStatus_USB_Error;
+            (*transfer_tail)->next = transfer;
+        }
+        else
+        {
+            *transfer_queue = transfer;
         }
-        p = p->next;
+        *transfer_tail = transfer;
     }
-    transfer->next = NULL;
-    if (NULL != q)
+    OSA_EXIT_CRITICAL();
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Reset the transfer queues and the command buffers.
+ *
+ * This function puts all transfer nodes to the idle queue and frees all command buffers.
+ *
+ * @param ccidHandle          The device ccid class handle.
+ */
+static void USB_DeviceCcidResetTransfers(usb_device_ccid_struct_t *ccidHandle)
+{
+    ccidHandle->transferHead = NULL;
+    ccidHandle->transferTail = NULL;
+    ccidHandle->transferFree = NULL;
+    for (uint8_t i = 0U; i < USB_DEVICE_CONFIG_CCID_TRANSFER_COUNT; i++)
     {
-        q->next = transfer;
+        ccidHandle->transfers[i].next = ccidHandle->transferFree;
+        ccidHandle->transferFree      = &ccidHandle->transfers[i];
     }
-    else
+    for (uint8_t i = 0U; i < USB_DEVICE_CONFIG_CCID_SLOT_MAX; i++)
     {
-        *transfer_queue = transfer;
+        ccidHandle->slotsCommandBuffer[i] = USB_DEVICE_CCID_COMMAND_BUFFER_INVALID;
+    }
+    ccidHandle->commandBufferBusy = 0U;
+    ccidHandle->commandReceiving  = USB_DEVICE_CCID_COMMAND_BUFFER_INVALID;
+}
+
+/*!
+ * @brief Send the head of the busy queue.
+ *
+ * This function sends the head transfer node of the busy queue to the host if the bulk IN pipe is idle. The busy flag
+ * is cleared (for a completed transfer), tested and set in one critical section, so a response queued by the
+ * application and the bulk IN completion cannot both send or both skip the head.
+ *
+ * @param ccidHandle          The device ccid class handle.
+ * @param completed           1 if the previous transfer of the bulk IN pipe is done, otherwise 0.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_DeviceCcidKickBulkIn(usb_device_ccid_struct_t *ccidHandle, uint8_t completed)
+{
+    usb_status_t error = kStatus_USB_Success;
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    if (0U != completed)
+    {
+        ccidHandle->bulkInBusy = 0U;
+    }
+    if ((0U == ccidHandle->bulkInBusy) && (0U != ccidHandle->endpointBulkIn) && (NULL != ccidHandle->transferHead))
+    {
+        error = USB_DeviceSendRequest(ccidHandle->handle, ccidHandle->endpointBulkIn, ccidHandle->transferHead->buffer,
+                                      ccidHandle->transferHead->length);
+        if (kStatus_USB_Success == error)
+        {
+            ccidHandle->bulkInBusy = 1U;
+        }
     }
     OSA_EXIT_CRITICAL();
-    return kStatus_USB_Success;
+    return error;
+}
+
+/*!
+ * @brief Queue a response.
+ *
+ * This function adds the transfer node to the busy queue and sends it to the host if the bulk IN pipe is idle.
+ *
+ * @param ccidHandle          The device ccid class handle.
+ * @param transfer            The transfer node keeping the response.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_DeviceCcidQueueResponse(usb_device_ccid_struct_t *ccidHandle,
+                                                usb_device_ccid_transfer_struct_t *transfer)
+{
+    usb_status_t error;
+
+    /* Add the transfer node to the busy queue */
+    error = USB_DeviceCcidAddTransfer(&ccidHandle->transferHead, &ccidHandle->transferTail, transfer);
+    if (kStatus_USB_Success != error)
+    {
+        return error;
+    }
+
+    /* If the bulk IN pipe is idle, send the response data to the host */
+    return USB_DeviceCcidKickBulkIn(ccidHandle, 0U);
+}
+
+/*!
+ * @brief Prime the bulk OUT pipe to receive a command.
+ *
+ * This function primes a free command buffer to the bulk OUT pipe if no buffer is primed. The command is received to
+ * the buffer directly, it is not copied again before it is handled by the application. The bulk OUT pipe keeps NAKing
+ * the host when all buffers are held by the pending slots.
+ *
+ * @param ccidHandle          The device ccid class handle.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_DeviceCcidPrimeCommand(usb_device_ccid_struct_t *ccidHandle)
+{
+    usb_status_t error = kStatus_USB_Success;
+    uint8_t index;
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    if ((0U != ccidHandle->endpointBulkOut) && (USB_DEVICE_CCID_COMMAND_BUFFER_INVALID == ccidHandle->commandReceiving))
+    {
+        for (index = 0U; index < USB_DEVICE_CONFIG_CCID_COMMAND_BUFFER_COUNT; index++)
+        {
+            if (0U == (ccidHandle->commandBufferBusy & (1UL << index)))
+            {
+                break;
+            }
+        }
+        if (index < USB_DEVICE_CONFIG_CCID_COMMAND_BUFFER_COUNT)
+        {
+            error = USB_DeviceRecvRequest(ccidHandle->handle, ccidHandle->endpointBulkOut,
+                                          ccidHandle->commandBuffer[index], sizeof(ccidHandle->commandBuffer[index]));
+            if (kStatus_USB_Success == error)
+            {
+                ccidHandle->commandBufferBusy |= (1UL << index);
+                ccidHandle->commandReceiving = index;
+            }
+        }
+    }
+    OSA_EXIT_CRITICAL();
+    return error;
+}
+
+/*!
+ * @brief Release a command buffer.
+ *
+ * @param ccidHandle          The device ccid class handle.
+ * @param index               The command buffer index.
+ */
+static void USB_DeviceCcidReleaseCommand(usb_device_ccid_struct_t *ccidHandle, uint8_t index)
+{
+    OSA_SR_ALLOC();
+
+    if (index < USB_DEVICE_CONFIG_CCID_COMMAND_BUFFER_COUNT)
+    {
+        OSA_ENTER_CRITICAL();
+        ccidHandle->commandBufferBusy &= ~(1UL << index);
+        OSA_EXIT_CRITICAL();
+    }
 }
 
 /*!
@@ -310,7 +470,6 @@ static usb_status_t USB_DeviceCcidBulkIn(usb_device_handle deviceHandle,
 {
     usb_device_ccid_struct_t *ccidHandle = (usb_device_ccid_struct_t *)callbackParam;
     usb_device_ccid_transfer_struct_t *transfer;
-    usb_status_t error = kStatus_USB_Error;
 
     /* endpoint callback length is USB_CANCELLED_TRANSFER_LENGTH (0xFFFFFFFFU) when transfer is canceled */
     if (((NULL == deviceHandle) || (NULL == callbackParam) || (NULL == event)) || (NULL == event->buffer) ||
@@ -320,7 +479,8 @@ static usb_status_t USB_DeviceCcidBulkIn(usb_device_handle deviceHandle,
     }
 
     /* Remove the transed transfer from the busy queue. */
-    if (kStatus_USB_Success == USB_DeviceCcidRemoveTransfer(&ccidHandle->transferHead, &transfer))
+    if (kStatus_USB_Success ==
+        USB_DeviceCcidRemoveTransfer(&ccidHandle->transferHead, &ccidHandle->transferTail, &transfer))
     {
         if (NULL != ccidHandle->configStruct->classCallback)
         {
@@ -341,28 +501,17 @@ static usb_status_t USB_DeviceCcidBulkIn(usb_device_handle deviceHandle,
         }
         /* Add the transfer node to the idle queue */
 #if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
-        if (kStatus_USB_Success != USB_DeviceCcidAddTransfer(&ccidHandle->transferFree, transfer))
+        if (kStatus_USB_Success != USB_DeviceCcidAddTransfer(&ccidHandle->transferFree, NULL, transfer))
         {
             return kStatus_USB_Error;
         }
 #else
-        (void)USB_DeviceCcidAddTransfer(&ccidHandle->transferFree, transfer);
+        (void)USB_DeviceCcidAddTransfer(&ccidHandle->transferFree, NULL, transfer);
 #endif
     }
 
-    /* Clear the bulk IN pipe busy flag. */
-    ccidHandle->bulkInBusy = 0U;
-    /* If there is a blocking transfer, send it to the host */
-    if (NULL != ccidHandle->transferHead)
-    {
-        error = USB_DeviceSendRequest(ccidHandle->handle, ccidHandle->endpointBulkIn, ccidHandle->transferHead->buffer,
-                                      ccidHandle->transferHead->length);
-        if (kStatus_USB_Success == error)
-        {
-            ccidHandle->bulkInBusy = 1U;
-        }
-    }
-    return error;
+    /* Clear the bulk IN pipe busy flag, and if there is a blocking transfer, send it to the host */
+    return USB_DeviceCcidKickBulkIn(ccidHandle, 1U);
 }
 
 /*!
@@ -388,6 +537,7 @@ static usb_status_t USB_DeviceCcidBulkOut(usb_device_handle deviceHandle,
     void *temp;
     usb_status_t usbError  = kStatus_USB_InvalidRequest;
     uint8_t response_error = USB_DEVICE_CCID_SLOT_ERROR_COMMAND_NOT_SUPPORTED;
+    uint8_t index;
 
     /* endpoint callback length is USB_CANCELLED_TRANSFER_LENGTH (0xFFFFFFFFU) when transfer is canceled */
     if (((NULL == deviceHandle) || (NULL == callbackParam) || (NULL == event)) || (NULL == event->buffer) ||
@@ -399,6 +549,10 @@ static usb_status_t USB_DeviceCcidBulkOut(usb_device_handle deviceHandle,
     temp          = (void *)event->buffer;
     commonRequest = (usb_device_ccid_common_command_t *)temp;
 
+    /* The command buffer is released when the command is handled, except it is held by a pending slot */
+    index                        = ccidHandle->commandReceiving;
+    ccidHandle->commandReceiving = USB_DEVICE_CCID_COMMAND_BUFFER_INVALID;
+
     /* Check the slot is valid or not */
     temp = (void *)&commonRequest->dwLength;
     if ((ccidHandle->slots <= commonRequest->bSlot) ||
@@ -414,6 +568,12 @@ static usb_status_t USB_DeviceCcidBulkOut(usb_device_handle deviceHandle,
             response_error = USB_DEVICE_CCID_SLOT_ERROR_BAD_LENGTH;
         }
     }
+    else if ((USB_DEVICE_CCID_COMMAND_BUFFER_INVALID != ccidHandle->slotsCommandBuffer[commonRequest->bSlot]) &&
+             (USB_DEVICE_CCID_PC_TO_RDR_ABORT != commonRequest->bMessageType))
+    {
+        /* The slot is still handling the previous command, only the abort command is accepted */
+        response_error = USB_DEVICE_CCID_SLOT_ERROR_CMD_SLOT_BUSY;
+    }
     else
     {
         /* If the slot is valid, handle the host's request */
@@ -437,8 +597,10 @@ static usb_status_t USB_DeviceCcidBulkOut(usb_device_handle deviceHandle,
                 if (NULL != ccidHandle->configStruct->classCallback)
                 {
                     usb_device_ccid_command_struct_t command;
-                    command.commandBuffer = event->buffer;
-                    command.commandLength = event->length;
+                    command.commandBuffer  = event->buffer;
+                    command.commandLength  = event->length;
+                    command.responseBuffer = NULL;
+                    command.responseLength = 0U;
                     /* Notify the up layer, the command received, and then the application need to handle the command.
                     classCallback is initialized in classInit of s_UsbDeviceClassInterfaceMap,
                     it is from the second parameter of classInit */
@@ -446,32 +608,36 @@ static usb_status_t USB_DeviceCcidBulkOut(usb_device_handle deviceHandle,
                                                                        kUSB_DeviceCcidEventCommandReceived, &command);
                     if (kStatus_USB_Success == usbError)
                     {
-                        /* Get a new transfer node from the idle queue */
-                        if (kStatus_USB_Success == USB_DeviceCcidRemoveTransfer(&ccidHandle->transferFree, &transfer))
+                        if (NULL == command.responseBuffer)
                         {
-                            /* Save the response buffer and data length to the transfer node */
-                            transfer->buffer = command.responseBuffer;
-                            transfer->length = command.responseLength;
-                            /* Add the transfer node to the busy queue */
-#if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
-                            if (kStatus_USB_Success != USB_DeviceCcidAddTransfer(&ccidHandle->transferHead, transfer))
+                            if (USB_DEVICE_CCID_COMMAND_BUFFER_INVALID ==
+                                ccidHandle->slotsCommandBuffer[commonRequest->bSlot])
                             {
-                                return kStatus_USB_Error;
+                                /* The response is sent by USB_DeviceCcidSendResponse later, the slot holds the
+                                 * command buffer until then. */
+                                ccidHandle->slotsCommandBuffer[commonRequest->bSlot] = index;
+                                index = USB_DEVICE_CCID_COMMAND_BUFFER_INVALID;
                             }
-#else
-                            (void)USB_DeviceCcidAddTransfer(&ccidHandle->transferHead, transfer);
-#endif
-                            if (0U == ccidHandle->bulkInBusy)
+                            else
                             {
-                                /* If the bulk IN pipe is idle, send the response data to the host */
-                                if (kStatus_USB_Success == USB_DeviceSendRequest(ccidHandle->handle,
-                                                                                 ccidHandle->endpointBulkIn,
-                                                                                 transfer->buffer, transfer->length))
-                                {
-                                    ccidHandle->bulkInBusy = 1U;
-                                }
+                                /* An abort command cannot be pending when the slot has a pending command */
+                                usbError       = kStatus_USB_Busy;
+                                response_error = USB_DEVICE_CCID_SLOT_ERROR_CMD_SLOT_BUSY;
                             }
                         }
+                        /* Get a new transfer node from the idle queue */
+                        else if (kStatus_USB_Success ==
+                                 USB_DeviceCcidRemoveTransfer(&ccidHandle->transferFree, NULL, &transfer))
+                        {
+                            /* Save the response buffer and data length to the transfer node */
+                            transfer->buffer = command.responseBuffer;
+                            transfer->length = command.responseLength;
+                            (void)USB_DeviceCcidQueueResponse(ccidHandle, transfer);
+                        }
+                        else
+                        {
+                            /*no action*/
+                        }
                     }
                 }
                 break;
@@ -484,7 +650,7 @@ static usb_status_t USB_DeviceCcidBulkOut(usb_device_handle deviceHandle,
     /* Response the host when the command failed. */
     if (kStatus_USB_Success != usbError)
     {
-        if (kStatus_USB_Success == USB_DeviceCcidRemoveTransfer(&ccidHandle->transferFree, &transfer))
+        if (kStatus_USB_Success == USB_DeviceCcidRemoveTransfer(&ccidHandle->transferFree, NULL, &transfer))
         {
             usb_device_ccid_slot_status_struct_t slotStatus;
             transfer->buffer                = (uint8_t *)&transfer->response;
@@ -506,6 +672,10 @@ static usb_status_t USB_DeviceCcidBulkOut(usb_device_handle deviceHandle,
                                                                                    kUSB_DeviceCcidEventGetSlotStatus,
                                                                                    &slotStatus))
                 {
+                    /* Give back the transfer node and the command buffer, the bulk OUT pipe keeps receiving */
+                    (void)USB_DeviceCcidAddTransfer(&ccidHandle->transferFree, NULL, transfer);
+                    USB_DeviceCcidReleaseCommand(ccidHandle, index);
+                    (void)USB_DeviceCcidPrimeCommand(ccidHandle);
                     return kStatus_USB_Error;
                 }
 #else
@@ -516,36 +686,17 @@ static usb_status_t USB_DeviceCcidBulkOut(usb_device_handle deviceHandle,
             transfer->response.bStatus      = slotStatus.present | USB_DEVICE_CCID_SLOT_STATUS_COMMAND_STATUS_FAILED;
             transfer->response.bError       = response_error;
             transfer->response.bClockStatus = slotStatus.clockStatus;
-#if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
-            if (kStatus_USB_Success != USB_DeviceCcidAddTransfer(&ccidHandle->transferHead, transfer))
-            {
-                return kStatus_USB_Error;
-            }
-#else
-            (void)USB_DeviceCcidAddTransfer(&ccidHandle->transferHead, transfer);
-#endif
-            if (0U == ccidHandle->bulkInBusy)
-            {
-                usbError = USB_DeviceSendRequest(ccidHandle->handle, ccidHandle->endpointBulkIn, transfer->buffer,
-                                                 transfer->length);
-                if (kStatus_USB_Success == usbError)
-                {
-                    ccidHandle->bulkInBusy = 1U;
-                }
-            }
+            usbError                        = USB_DeviceCcidQueueResponse(ccidHandle, transfer);
         }
     }
-    /* Prime next transfer to receive a command from the host */
-    if (0U != ccidHandle->endpointBulkOut)
-    {
+
+    /* Release the command buffer and prime next transfer to receive a command from the host */
+    USB_DeviceCcidReleaseCommand(ccidHandle, index);
 #if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
-        usbError = USB_DeviceRecvRequest(ccidHandle->handle, ccidHandle->endpointBulkOut, ccidHandle->commandBuffer,
-                                         sizeof(ccidHandle->commandBuffer));
+    usbError = USB_DeviceCcidPrimeCommand(ccidHandle);
 #else
-        (void)USB_DeviceRecvRequest(ccidHandle->handle, ccidHandle->endpointBulkOut, ccidHandle->commandBuffer,
-                                    sizeof(ccidHandle->commandBuffer));
+    (void)USB_DeviceCcidPrimeCommand(ccidHandle);
 #endif
-    }
     return usbError;
 }
 
@@ -676,6 +827,9 @@ static usb_status_t USB_DeviceCcidEndpointsDeinit(usb_device_ccid_struct_t *ccid
     ccidHandle->endpointBulkOut     = 0U;
     ccidHandle->endpointInterruptIn = 0U;
     ccidHandle->interfaceHandle     = NULL;
+    /* The command being received is cancelled, free its buffer */
+    USB_DeviceCcidReleaseCommand(ccidHandle, ccidHandle->commandReceiving);
+    ccidHandle->commandReceiving = USB_DEVICE_CCID_COMMAND_BUFFER_INVALID;
     return status;
 }
 
@@ -749,30 +903,17 @@ usb_status_t USB_DeviceCcidEvent(void *handle, uint32_t event, void *param)
             /* Clear slot changed status */
             ccidHandle->slotsChanged = 0U;
 
-            /* Reset the idle queue and busy queue */
-            ccidHandle->transferFree = &ccidHandle->transfers[0];
-            ccidHandle->transferHead = &ccidHandle->transfers[0];
-            for (uint8_t i = 1U; i < USB_DEVICE_CONFIG_CCID_TRANSFER_COUNT; i++)
-            {
-                ccidHandle->transferHead->next = &ccidHandle->transfers[i];
-                ccidHandle->transferHead       = &ccidHandle->transfers[i];
-            }
-            ccidHandle->transferHead->next = NULL;
-            ccidHandle->transferHead       = NULL;
+            /* Reset the idle queue, busy queue and the command buffers, the pending slots are dropped */
+            USB_DeviceCcidResetTransfers(ccidHandle);
 
             /* Initialize the endpoints of the new current configuration by using the alternate setting 0. */
             status = USB_DeviceCcidEndpointsInit(ccidHandle);
-            if (0U != ccidHandle->endpointBulkOut)
-            {
-                /* Prime a transfer to receive a command from the host */
+            /* Prime a transfer to receive a command from the host */
 #if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
-                status = USB_DeviceRecvRequest(ccidHandle->handle, ccidHandle->endpointBulkOut,
-                                               ccidHandle->commandBuffer, sizeof(ccidHandle->commandBuffer));
+            status = USB_DeviceCcidPrimeCommand(ccidHandle);
 #else
-                (void)USB_DeviceRecvRequest(ccidHandle->handle, ccidHandle->endpointBulkOut, ccidHandle->commandBuffer,
-                                            sizeof(ccidHandle->commandBuffer));
+            (void)USB_DeviceCcidPrimeCommand(ccidHandle);
 #endif
-            }
 
             /* Notify the host the slot changed when the interrut IN pipe is valid and there are some ICC present. */
             if (0U != ccidHandle->endpointInterruptIn)
@@ -834,17 +975,12 @@ usb_status_t USB_DeviceCcidEvent(void *handle, uint32_t event, void *param)
             ccidHandle->alternate = alternate;
             /* Initialize new endpoints */
             status = USB_DeviceCcidEndpointsInit(ccidHandle);
-            if (0U != ccidHandle->endpointBulkOut)
-            {
-                /* Prime a transfer to receive a command from the host */
+            /* Prime a transfer to receive a command from the host */
 #if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
-                status = USB_DeviceRecvRequest(ccidHandle->handle, ccidHandle->endpointBulkOut,
-                                               ccidHandle->commandBuffer, sizeof(ccidHandle->commandBuffer));
+            status = USB_DeviceCcidPrimeCommand(ccidHandle);
 #else
-                (void)USB_DeviceRecvRequest(ccidHandle->handle, ccidHandle->endpointBulkOut, ccidHandle->commandBuffer,
-                                            sizeof(ccidHandle->commandBuffer));
+            (void)USB_DeviceCcidPrimeCommand(ccidHandle);
 #endif
-            }
             break;
         case kUSB_DeviceClassEventSetEndpointHalt:
             if ((NULL == ccidHandle->configStruct) || (NULL == ccidHandle->interfaceHandle))
@@ -1033,15 +1169,7 @@ usb_status_t USB_DeviceCcidInit(uint8_t controllerId, usb_device_class_config_st
         return kStatus_USB_Error;
     }
 
-    ccidHandle->transferFree = &ccidHandle->transfers[0];
-    ccidHandle->transferHead = &ccidHandle->transfers[0];
-    for (uint8_t i = 1U; i < USB_DEVICE_CONFIG_CCID_TRANSFER_COUNT; i++)
-    {
-        ccidHandle->transferHead->next = &ccidHandle->transfers[i];
-        ccidHandle->transferHead       = &ccidHandle->transfers[i];
-    }
-    ccidHandle->transferHead->next = NULL;
-    ccidHandle->transferHead       = NULL;
+    USB_DeviceCcidResetTransfers(ccidHandle);
 
     *handle = (class_handle_t)ccidHandle;
     return error;
@@ -1208,4 +1336,63 @@ usb_status_t USB_DeviceCcidNotifyHardwareError(class_handle_t handle,
     OSA_EXIT_CRITICAL();
     return error;
 }
+
+/*!
+ * @brief Send the response of a pending command.
+ *
+ * The function sends the response of the command that the application keeps pending in the
+ * kUSB_DeviceCcidEventCommandReceived callback, and frees the command buffer held by the slot.
+ *
+ * @param handle The ccid class handle got from usb_device_class_config_struct_t::classHandle.
+ * @param slot   The slot number of the pending command.
+ * @param buffer The response buffer.
+ * @param length The response length.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceCcidSendResponse(class_handle_t handle, uint8_t slot, uint8_t *buffer, uint32_t length)
+{
+    usb_device_ccid_struct_t *ccidHandle;
+    usb_device_ccid_transfer_struct_t *transfer;
+    usb_status_t error;
+    uint8_t index;
+    OSA_SR_ALLOC();
+
+    ccidHandle = (usb_device_ccid_struct_t *)handle;
+
+    if (NULL == ccidHandle)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+
+    if ((slot >= ccidHandle->slots) || (NULL == buffer))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    if (USB_DEVICE_CCID_COMMAND_BUFFER_INVALID == ccidHandle->slotsCommandBuffer[slot])
+    {
+        return kStatus_USB_Error;
+    }
+
+    /* Get a new transfer node from the idle queue */
+    if (kStatus_USB_Success != USB_DeviceCcidRemoveTransfer(&ccidHandle->transferFree, NULL, &transfer))
+    {
+        return kStatus_USB_Busy;
+    }
+    transfer->buffer = buffer;
+    transfer->length = length;
+
+    /* The slot is idle again, its command buffer can receive the next command */
+    OSA_ENTER_CRITICAL();
+    index                                = ccidHandle->slotsCommandBuffer[slot];
+    ccidHandle->slotsCommandBuffer[slot] = USB_DEVICE_CCID_COMMAND_BUFFER_INVALID;
+    OSA_EXIT_CRITICAL();
+    USB_DeviceCcidReleaseCommand(ccidHandle, index);
+
+    error = USB_DeviceCcidQueueResponse(ccidHandle, transfer);
+    /* Prime the bulk OUT pipe if it is stopped due to all command buffers are held */
+    (void)USB_DeviceCcidPrimeCommand(ccidHandle);
+    return error;
+}
 #endif
@@ -29,6 +29,9 @@
 #define USB_DEVICE_CONFIG_CCID_TRANSFER_COUNT (4U)
 /*! @brief MAX maximum message length of the CCID device. */
 #define USB_DEVICE_CONFIG_CCID_MAX_MESSAGE_LENGTH (271U)
+/*! @brief MAX command buffer number of the CCID device (up to 32). A buffer is held by a slot from the command received
+ * until the response is queued, set it to the slot count plus one to let the commands of all slots overlap. */
+#define USB_DEVICE_CONFIG_CCID_COMMAND_BUFFER_COUNT (1U)
 
 /*! @}*/
 
@@ -933,7 +936,8 @@ typedef struct _usb_device_ccid_command_struct
 {
     uint8_t *commandBuffer;  /*!< The buffer address kept the command from host */
     uint32_t commandLength;  /*!< The command length from host */
-    uint8_t *responseBuffer; /*!< The response data need to be sent to host */
+    uint8_t *responseBuffer; /*!< The response data need to be sent to host, keep NULL to send the response later by
+                                  USB_DeviceCcidSendResponse */
     uint32_t responseLength; /*!< The response data length */
 } usb_device_ccid_command_struct_t;
 
@@ -965,10 +969,13 @@ typedef struct _usb_device_ccid_struct
     usb_device_class_config_struct_t *configStruct;  /*!< The configuration of the class. */
     usb_device_interface_struct_t *interfaceHandle;  /*!< Current interface handle */
     usb_device_ccid_transfer_struct_t *transferHead; /*!< Transfer queue for busy*/
+    usb_device_ccid_transfer_struct_t *transferTail; /*!< The last transfer of the busy queue*/
     usb_device_ccid_transfer_struct_t *transferFree; /*!< Transfer queue for idle*/
-    uint8_t commandBuffer[USB_DEVICE_CCID_BUFFER_4BYTE_ALIGN(
-        USB_DEVICE_CONFIG_CCID_MAX_MESSAGE_LENGTH)]; /*!< Command buffer for getting command data from host */
+    uint8_t commandBuffer[USB_DEVICE_CONFIG_CCID_COMMAND_BUFFER_COUNT][USB_DEVICE_CCID_BUFFER_4BYTE_ALIGN(
+        USB_DEVICE_CONFIG_CCID_MAX_MESSAGE_LENGTH)]; /*!< Command buffers for getting command data from host */
     usb_device_ccid_transfer_struct_t transfers[USB_DEVICE_CONFIG_CCID_TRANSFER_COUNT]; /*!< Transfer entity */
+    uint32_t commandBufferBusy; /*!< The command buffers being received or held by a slot, one bit per buffer */
+    uint8_t slotsCommandBuffer[USB_DEVICE_CONFIG_CCID_SLOT_MAX]; /*!< The command buffer held by each pending slot */
     uint8_t slotsChangeBuffer[(USB_DEVICE_CONFIG_CCID_SLOT_MAX * 2 - 1U) / 8 + 1U +
                               1U]; /*!< The buffer for saving slot status */
     uint8_t slotsSendingChangeBuffer[(USB_DEVICE_CONFIG_CCID_SLOT_MAX * 2 - 1U) / 8 + 1U +
@@ -986,6 +993,7 @@ typedef struct _usb_device_ccid_struct
     uint8_t bulkInBusy;          /*!< The bulk IN pipe is busy or not. */
     uint8_t interruptInBusy;     /*!< The interrupt IN pipe is busy or not. */
     uint8_t slotsChanged;        /*!< The slot status changed */
+    uint8_t commandReceiving;    /*!< The command buffer primed in the bulk OUT pipe */
 } usb_device_ccid_struct_t;
 
 /*******************************************************************************
@@ -1084,6 +1092,28 @@ extern usb_status_t USB_DeviceCcidNotifyHardwareError(class_handle_t handle,
                                                       uint8_t slot,
                                                       usb_device_ccid_hardware_error_t errorCode);
 
+/*!
+ * @brief Sends the response of a pending command.
+ *
+ * The function sends the response of a command that the application did not answer in the
+ * kUSB_DeviceCcidEventCommandReceived callback (usb_device_ccid_command_struct_t::responseBuffer kept NULL). The
+ * command buffer is held by the slot until this function is called, the commands received for the slot in the
+ * meantime are answered with the error USB_DEVICE_CCID_SLOT_ERROR_CMD_SLOT_BUSY, except PC_to_RDR_Abort.
+ * The commands of the other slots are still received and handled, so the slots work in parallel.
+ *
+ * The response buffer is sent without copy and must be kept until the event kUSB_DeviceCcidEventResponseSent.
+ *
+ * @param[in] handle The CCID class handle received from usb_device_class_config_struct_t::classHandle.
+ * @param[in] slot   The slot number of the pending command.
+ * @param[in] buffer The response buffer.
+ * @param[in] length The response length.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ * @retval kStatus_USB_Error                No command is pending on the slot.
+ * @retval kStatus_USB_Busy                 No transfer entity is available, try again later.
+ */
+extern usb_status_t USB_DeviceCcidSendResponse(class_handle_t handle, uint8_t slot, uint8_t *buffer, uint32_t length);
+
 /*! @}*/
 
 #if defined(__cplusplus)
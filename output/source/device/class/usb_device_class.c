@@ -68,6 +68,7 @@ static usb_status_t USB_DeviceClassGetHandleByControllerId(uint8_t controllerId,
                                                            usb_device_common_class_struct_t **handle);
 static usb_status_t USB_DeviceClassGetHandleByDeviceHandle(usb_device_handle deviceHandle,
                                                            usb_device_common_class_struct_t **handle);
+static void USB_DeviceClassBuildDispatchTable(usb_device_common_class_struct_t *classHandle, uint8_t configuration);
 
 /*******************************************************************************
  * Variables
@@ -120,6 +121,12 @@ static const usb_device_class_map_t s_UsbDeviceClassInterfaceMap[] = {
      (usb_device_class_type_t)0},
 };
 
+/* The class driver count, when it is 1 the class driver calls are resolved at compile time. */
+#define USB_DEVICE_CLASS_DRIVER_COUNT ((sizeof(s_UsbDeviceClassInterfaceMap) / sizeof(usb_device_class_map_t)) - 1U)
+
+/* The index in s_UsbDeviceClassInterfaceMap of each class type, filled by USB_DeviceClassInit. */
+static uint8_t s_UsbDeviceClassTypeMapIndex[(uint8_t)kUSB_DeviceClassTypeCcid + 1U];
+
 USB_GLOBAL USB_RAM_ADDRESS_ALIGNMENT(USB_DATA_ALIGN_SIZE) static usb_device_common_class_struct_t
     s_UsbDeviceCommonClassStruct[USB_DEVICE_CONFIG_NUM];
 USB_GLOBAL USB_RAM_ADDRESS_ALIGNMENT(USB_DATA_ALIGN_SIZE) static uint8_t
@@ -199,6 +206,9 @@ static usb_status_t USB_DeviceClassFreeHandle(uint8_t controllerId)
             s_UsbDeviceCommonClassStruct[count].handle       = NULL;
             s_UsbDeviceCommonClassStruct[count].configList   = (usb_device_class_config_list_struct_t *)NULL;
             s_UsbDeviceCommonClassStruct[count].controllerId = 0U;
+#if ((defined(USB_DEVICE_CONFIG_DESCRIPTOR_TABLE)) && (USB_DEVICE_CONFIG_DESCRIPTOR_TABLE > 0U))
+            s_UsbDeviceCommonClassStruct[count].descriptorTable = (const usb_device_descriptor_table_struct_t *)NULL;
+#endif
             OSA_EXIT_CRITICAL();
             return kStatus_USB_Success;
         }
@@ -257,19 +267,17 @@ static usb_status_t USB_DeviceClassGetHandleByDeviceHandle(usb_device_handle dev
                                                            usb_device_common_class_struct_t **handle)
 {
     uint32_t count = 0U;
-    OSA_SR_ALLOC();
 
-    OSA_ENTER_CRITICAL();
+    /* No critical section, this function runs for every event of a started device. The handle is set before the
+     * device is started and cleared after the device is de-initialized, it does not change under the caller. */
     for (; count < USB_DEVICE_CONFIG_NUM; count++)
     {
         if (deviceHandle == s_UsbDeviceCommonClassStruct[count].handle)
         {
             *handle = &s_UsbDeviceCommonClassStruct[count];
-            OSA_EXIT_CRITICAL();
             return kStatus_USB_Success;
         }
     }
-    OSA_EXIT_CRITICAL();
     return kStatus_USB_InvalidParameter;
 }
 
@@ -304,6 +312,184 @@ usb_status_t USB_DeviceClassGetDeviceHandle(uint8_t controllerId, usb_device_han
     return kStatus_USB_InvalidParameter;
 }
 
+/*!
+ * @brief Build the class dispatch table of a configuration.
+ *
+ * This function records which class owns each interface number and each endpoint address of the configuration, the
+ * class requests and the endpoint events are routed with the table instead of being passed to all classes.
+ *
+ * @param classHandle     The common class handle.
+ * @param configuration   The configuration value, 0 means the device is not configured.
+ */
+static void USB_DeviceClassBuildDispatchTable(usb_device_common_class_struct_t *classHandle, uint8_t configuration)
+{
+    usb_device_interface_list_t *interfaceList;
+    usb_device_interfaces_struct_t *interfaces;
+    usb_device_endpoint_list_t *endpointList;
+    uint8_t classIndex;
+    uint8_t interfaceIndex;
+    uint8_t alternateIndex;
+    uint8_t endpointIndex;
+    uint8_t endpointAddress;
+
+    for (interfaceIndex = 0U; interfaceIndex < USB_DEVICE_CLASS_DISPATCH_INTERFACES; interfaceIndex++)
+    {
+        classHandle->interfaceClassIndex[interfaceIndex] = USB_DEVICE_CLASS_DISPATCH_INVALID;
+    }
+    for (endpointIndex = 0U; endpointIndex < (USB_DEVICE_CONFIG_ENDPOINTS * 2U); endpointIndex++)
+    {
+        classHandle->endpointClassIndex[endpointIndex] = USB_DEVICE_CLASS_DISPATCH_INVALID;
+    }
+    if (0U == configuration)
+    {
+        return;
+    }
+
+    for (classIndex = 0U; classIndex < classHandle->configList->count; classIndex++)
+    {
+        if ((NULL == classHandle->configList->config[classIndex].classInfomation) ||
+            (configuration > classHandle->configList->config[classIndex].classInfomation->configurations))
+        {
+            continue;
+        }
+        interfaceList =
+            &classHandle->configList->config[classIndex].classInfomation->interfaceList[configuration - 1U];
+        for (interfaceIndex = 0U; interfaceIndex < interfaceList->count; interfaceIndex++)
+        {
+            interfaces = &interfaceList->interfaces[interfaceIndex];
+            if (interfaces->interfaceNumber < USB_DEVICE_CLASS_DISPATCH_INTERFACES)
+            {
+                classHandle->interfaceClassIndex[interfaces->interfaceNumber] = classIndex;
+            }
+            for (alternateIndex = 0U; alternateIndex < interfaces->count; alternateIndex++)
+            {
+                endpointList = &interfaces->interface[alternateIndex].endpointList;
+                for (endpointIndex = 0U; endpointIndex < endpointList->count; endpointIndex++)
+                {
+                    endpointAddress = endpointList->endpoint[endpointIndex].endpointAddress;
+                    if ((endpointAddress & USB_ENDPOINT_NUMBER_MASK) < USB_DEVICE_CONFIG_ENDPOINTS)
+                    {
+                        classHandle->endpointClassIndex[((uint32_t)(endpointAddress & USB_ENDPOINT_NUMBER_MASK)
+                                                         << 1U) |
+                                                        ((uint32_t)endpointAddress >>
+                                                         USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT)] =
+                            classIndex;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * @brief Get the class owning the target of an event.
+ *
+ * @param classHandle     The common class handle.
+ * @param event           The event codes. Please refer to the enumeration usb_device_class_event_t.
+ * @param param           The param type is determined by the event code.
+ *
+ * @return The index in configList, USB_DEVICE_CLASS_DISPATCH_INVALID if the event is passed to all classes.
+ */
+static uint8_t USB_DeviceClassGetOwner(usb_device_common_class_struct_t *classHandle,
+                                       usb_device_class_event_t event,
+                                       void *param)
+{
+    usb_device_control_request_struct_t *controlRequest;
+    uint32_t index;
+    uint8_t classIndex = USB_DEVICE_CLASS_DISPATCH_INVALID;
+
+    switch (event)
+    {
+        case kUSB_DeviceClassEventClassRequest:
+            controlRequest = (usb_device_control_request_struct_t *)param;
+            index          = (uint32_t)controlRequest->setup->wIndex & 0xFFU;
+            if ((controlRequest->setup->bmRequestType & USB_REQUEST_TYPE_RECIPIENT_MASK) ==
+                USB_REQUEST_TYPE_RECIPIENT_INTERFACE)
+            {
+                if (index < USB_DEVICE_CLASS_DISPATCH_INTERFACES)
+                {
+                    classIndex = classHandle->interfaceClassIndex[index];
+                }
+            }
+            else if ((controlRequest->setup->bmRequestType & USB_REQUEST_TYPE_RECIPIENT_MASK) ==
+                     USB_REQUEST_TYPE_RECIPIENT_ENDPOINT)
+            {
+                if ((index & USB_ENDPOINT_NUMBER_MASK) < USB_DEVICE_CONFIG_ENDPOINTS)
+                {
+                    classIndex = classHandle->endpointClassIndex[((index & USB_ENDPOINT_NUMBER_MASK) << 1U) |
+                                                                 ((index & 0x80U) >> 7U)];
+                }
+            }
+            else
+            {
+                /*no action*/
+            }
+            break;
+        case kUSB_DeviceClassEventSetInterface:
+            /* The Bit[15~8] is the interface, the alternate setting is in Bit[7~0]. */
+            index = (uint32_t)(*((uint16_t *)param)) >> 8U;
+            if (index < USB_DEVICE_CLASS_DISPATCH_INTERFACES)
+            {
+                classIndex = classHandle->interfaceClassIndex[index];
+            }
+            break;
+        case kUSB_DeviceClassEventSetEndpointHalt:
+        case kUSB_DeviceClassEventClearEndpointHalt:
+            index = (uint32_t)(*((uint16_t *)param)) & 0xFFU;
+            if ((index & USB_ENDPOINT_NUMBER_MASK) < USB_DEVICE_CONFIG_ENDPOINTS)
+            {
+                classIndex = classHandle->endpointClassIndex[((index & USB_ENDPOINT_NUMBER_MASK) << 1U) |
+                                                             ((index & 0x80U) >> 7U)];
+            }
+            break;
+        default:
+            /*no action*/
+            break;
+    }
+    return classIndex;
+}
+
+/*!
+ * @brief Pass an event to one class.
+ *
+ * @param classHandle     The common class handle.
+ * @param classIndex      The index of the class in configList.
+ * @param event           The event codes. Please refer to the enumeration usb_device_class_event_t.
+ * @param param           The param type is determined by the event code.
+ *
+ * @return The return value of the class driver, kStatus_USB_Error if the class type is not supported.
+ */
+static usb_status_t USB_DeviceClassCallEvent(usb_device_common_class_struct_t *classHandle,
+                                             uint8_t classIndex,
+                                             usb_device_class_event_t event,
+                                             void *param)
+{
+    usb_device_class_config_struct_t *config = &classHandle->configList->config[classIndex];
+    uint8_t mapIndex;
+
+    if (1U == USB_DEVICE_CLASS_DRIVER_COUNT)
+    {
+        /* The only class driver, the compiler calls it directly */
+        if (s_UsbDeviceClassInterfaceMap[0].type != config->classInfomation->type)
+        {
+            return kStatus_USB_Error;
+        }
+        return s_UsbDeviceClassInterfaceMap[0].classEventCallback((void *)config->classHandle, (uint32_t)event,
+                                                                  param);
+    }
+    if ((uint32_t)config->classInfomation->type >= sizeof(s_UsbDeviceClassTypeMapIndex))
+    {
+        return kStatus_USB_Error;
+    }
+    mapIndex = s_UsbDeviceClassTypeMapIndex[config->classInfomation->type];
+    if (mapIndex >= USB_DEVICE_CLASS_DRIVER_COUNT)
+    {
+        return kStatus_USB_Error;
+    }
+    return s_UsbDeviceClassInterfaceMap[mapIndex].classEventCallback((void *)config->classHandle, (uint32_t)event,
+                                                                     param);
+}
+
 /*!
  * @brief Handle the event passed to the class drivers.
  *
@@ -321,7 +507,6 @@ usb_status_t USB_DeviceClassGetDeviceHandle(uint8_t controllerId, usb_device_han
 usb_status_t USB_DeviceClassEvent(usb_device_handle handle, usb_device_class_event_t event, void *param)
 {
     usb_device_common_class_struct_t *classHandle;
-    uint8_t mapIndex;
     uint8_t classIndex;
     usb_status_t errorReturn;
     usb_status_t status = kStatus_USB_Error;
@@ -338,29 +523,35 @@ usb_status_t USB_DeviceClassEvent(usb_device_handle handle, usb_device_class_eve
         return kStatus_USB_InvalidParameter;
     }
 
+    if (kUSB_DeviceClassEventSetConfiguration == event)
+    {
+        /* The interfaces and endpoints of the new configuration */
+        USB_DeviceClassBuildDispatchTable(classHandle, (uint8_t)(*((uint16_t *)param) & 0xFFU));
+    }
+
+    /* A request to an interface or an endpoint goes to the owning class only */
+    classIndex = USB_DeviceClassGetOwner(classHandle, event, param);
+    if (USB_DEVICE_CLASS_DISPATCH_INVALID != classIndex)
+    {
+        errorReturn = USB_DeviceClassCallEvent(classHandle, classIndex, event, param);
+        return ((kStatus_USB_InvalidRequest == errorReturn) || (kStatus_USB_Success == errorReturn)) ? errorReturn :
+                                                                                                        status;
+    }
+
     for (classIndex = 0U; classIndex < classHandle->configList->count; classIndex++)
     {
-        for (mapIndex = 0U; mapIndex < (ARRAY_SIZE(s_UsbDeviceClassInterfaceMap) - 1U); mapIndex++)
+        /* Call class event callback of supported class */
+        errorReturn = USB_DeviceClassCallEvent(classHandle, classIndex, event, param);
+        /* Return the error code kStatus_USB_InvalidRequest immediately, when a class returns
+         * kStatus_USB_InvalidRequest. */
+        if (kStatus_USB_InvalidRequest == errorReturn)
         {
-            if (s_UsbDeviceClassInterfaceMap[mapIndex].type ==
-                classHandle->configList->config[classIndex].classInfomation->type)
-            {
-                /* Call class event callback of supported class */
-                errorReturn = s_UsbDeviceClassInterfaceMap[mapIndex].classEventCallback(
-                    (void *)classHandle->configList->config[classIndex].classHandle, event, param);
-                /* Return the error code kStatus_USB_InvalidRequest immediately, when a class returns
-                 * kStatus_USB_InvalidRequest. */
-                if (kStatus_USB_InvalidRequest == errorReturn)
-                {
-                    return kStatus_USB_InvalidRequest;
-                }
-                /* For composite device, it should return kStatus_USB_Success once a valid request has been handled */
-                if (kStatus_USB_Success == errorReturn)
-                {
-                    status = kStatus_USB_Success;
-                }
-                break;
-            }
+            return kStatus_USB_InvalidRequest;
+        }
+        /* For composite device, it should return kStatus_USB_Success once a valid request has been handled */
+        if (kStatus_USB_Success == errorReturn)
+        {
+            status = kStatus_USB_Success;
         }
     }
 
@@ -455,6 +646,18 @@ usb_status_t USB_DeviceClassInit(
     /* Save the configuration list */
     classHandle->configList = configList;
 
+    /* Index the class drivers by class type, and route the interfaces of the first configuration until the host
+     * selects one. */
+    for (mapIndex = 0U; mapIndex < sizeof(s_UsbDeviceClassTypeMapIndex); mapIndex++)
+    {
+        s_UsbDeviceClassTypeMapIndex[mapIndex] = USB_DEVICE_CLASS_DISPATCH_INVALID;
+    }
+    for (mapIndex = 0U; mapIndex < USB_DEVICE_CLASS_DRIVER_COUNT; mapIndex++)
+    {
+        s_UsbDeviceClassTypeMapIndex[s_UsbDeviceClassInterfaceMap[mapIndex].type] = mapIndex;
+    }
+    USB_DeviceClassBuildDispatchTable(classHandle, 1U);
+
     /* Initialize the device stack. */
     error = USB_DeviceInit(controllerId, USB_DeviceClassCallback, &classHandle->handle);
 
@@ -569,6 +772,39 @@ usb_status_t USB_DeviceClassDeinit(uint8_t controllerId /*!< [IN] Controller ID
     return error;
 }
 
+#if ((defined(USB_DEVICE_CONFIG_DESCRIPTOR_TABLE)) && (USB_DEVICE_CONFIG_DESCRIPTOR_TABLE > 0U))
+/*!
+ * @brief Register the descriptor table.
+ *
+ * This function registers the descriptor table the control pipe answers the GET_DESCRIPTOR requests with.
+ *
+ * @param controllerId   The controller id of the USB IP. Please refer to the enumeration usb_controller_index_t.
+ * @param table          The descriptor table, NULL removes the table.
+ *
+ * @retval kStatus_USB_Success              The table is registered.
+ * @retval kStatus_USB_InvalidParameter     The common class can not be found, or the table has no entry.
+ */
+usb_status_t USB_DeviceClassSetDescriptorTable(uint8_t controllerId, const usb_device_descriptor_table_struct_t *table)
+{
+    usb_device_common_class_struct_t *classHandle;
+    usb_status_t error;
+
+    if ((NULL != table) && ((NULL == table->entries) || (0U == table->count)))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    error = USB_DeviceClassGetHandleByControllerId(controllerId, &classHandle);
+    if (kStatus_USB_Success != error)
+    {
+        return error;
+    }
+
+    classHandle->descriptorTable = table;
+    return kStatus_USB_Success;
+}
+#endif
+
 /*!
  * @brief Get the USB bus speed.
  *
@@ -21,6 +21,15 @@
 /*! @brief Macro to define class handle */
 typedef void *class_handle_t;
 
+/*! @brief The interface numbers routed by the class dispatch table, a request to a higher interface number is passed
+ * to all classes */
+#ifndef USB_DEVICE_CLASS_DISPATCH_INTERFACES
+#define USB_DEVICE_CLASS_DISPATCH_INTERFACES (16U)
+#endif
+
+/*! @brief The class dispatch table entry of an interface or endpoint that no class owns */
+#define USB_DEVICE_CLASS_DISPATCH_INVALID (0xFFU)
+
 /*! @brief Available class types. */
 typedef enum _usb_usb_device_class_type
 {
@@ -282,6 +291,55 @@ typedef union _usb_device_get_descriptor_common_union
         hidPhysicalDescriptor; /*!< The structure to get HID physical descriptor. */
 } usb_device_get_descriptor_common_union_t;
 
+#if ((defined(USB_DEVICE_CONFIG_DESCRIPTOR_TABLE)) && (USB_DEVICE_CONFIG_DESCRIPTOR_TABLE > 0U))
+/*! @brief The descriptor table entry is used at all bus speeds */
+#define USB_DEVICE_DESCRIPTOR_SPEED_ANY (0xFFU)
+
+#if (ENDIANNESS == USB_LITTLE_ENDIAN)
+/*!
+ * @brief Defines a string descriptor from its UTF-16 code units.
+ *
+ * The length and the descriptor type are computed by the compiler, the storage class and the alignment (for example
+ * USB_DMA_INIT_DATA_ALIGN) can be put in front of the macro:
+ *     static const USB_DEVICE_STRING_DESCRIPTOR(s_LanguageList, 0x0409U);
+ *     static const USB_DEVICE_STRING_DESCRIPTOR(s_Manufacturer, 'N', 'X', 'P');
+ * The code units are stored in the CPU byte order, so the macro is only available on little endian CPUs.
+ */
+#define USB_DEVICE_STRING_DESCRIPTOR(name, ...)                                                                        \
+    struct                                                                                                             \
+    {                                                                                                                  \
+        uint8_t bLength;                                                                                               \
+        uint8_t bDescriptorType;                                                                                       \
+        uint16_t bString[sizeof((const uint16_t[]){__VA_ARGS__}) / sizeof(uint16_t)];                                  \
+    } name = {(uint8_t)(2U + sizeof((const uint16_t[]){__VA_ARGS__})), USB_DESCRIPTOR_TYPE_STRING,                     \
+              {__VA_ARGS__}}
+#endif
+
+/*!
+ * @brief Obtains the descriptor table entry structure.
+ *
+ * An entry answers the GET_DESCRIPTOR request with the same descriptor type, index and wIndex at the bus speed of
+ * the entry. The HID class descriptors are requested from an interface, the other descriptors from the device.
+ */
+typedef struct _usb_device_descriptor_entry_struct
+{
+    const uint8_t *descriptor; /*!< The descriptor, a configuration descriptor is followed by its interface
+                                    descriptors. It can be in the flash, it is sent without a RAM copy */
+    uint32_t length;           /*!< The descriptor length, the wTotalLength of a configuration or BOS descriptor */
+    uint16_t wIndex; /*!< The language ID of a string, the interface number of a HID class descriptor, else 0 */
+    uint8_t type;    /*!< The descriptor type, the high byte of wValue */
+    uint8_t index;   /*!< The descriptor index, the low byte of wValue */
+    uint8_t speed;   /*!< USB_SPEED_FULL, USB_SPEED_HIGH... or USB_DEVICE_DESCRIPTOR_SPEED_ANY */
+} usb_device_descriptor_entry_struct_t;
+
+/*! @brief Obtains the descriptor table structure. */
+typedef struct _usb_device_descriptor_table_struct
+{
+    const usb_device_descriptor_entry_struct_t *entries; /*!< The entry array, the first matching entry is used */
+    uint8_t count;                                       /*!< The entry count */
+} usb_device_descriptor_table_struct_t;
+#endif
+
 /*! @brief Define function type for class device instance initialization */
 typedef usb_status_t (*usb_device_class_init_call_t)(uint8_t controllerId,
                                                      usb_device_class_config_struct_t *classConfig,
@@ -315,6 +373,14 @@ typedef struct _usb_device_common_class_struct
                                                         *           get sync frame request
                                                         */
     uint8_t controllerId;                              /*!< Controller ID*/
+    uint8_t interfaceClassIndex[USB_DEVICE_CLASS_DISPATCH_INTERFACES]; /*!< Index in configList of the class owning
+                                                                          each interface of the current configuration */
+    uint8_t endpointClassIndex[USB_DEVICE_CONFIG_ENDPOINTS * 2U]; /*!< Index in configList of the class owning each
+                                                                     endpoint (number * 2 + direction) of the current
+                                                                     configuration */
+#if ((defined(USB_DEVICE_CONFIG_DESCRIPTOR_TABLE)) && (USB_DEVICE_CONFIG_DESCRIPTOR_TABLE > 0U))
+    const usb_device_descriptor_table_struct_t *descriptorTable; /*!< The descriptors served without the callback */
+#endif
 } usb_device_common_class_struct_t;
 
 /*******************************************************************************
@@ -371,6 +437,22 @@ usb_status_t USB_DeviceClassDeinit(uint8_t controllerId);
  */
 usb_status_t USB_DeviceClassGetSpeed(uint8_t controllerId, uint8_t *speed);
 
+#if ((defined(USB_DEVICE_CONFIG_DESCRIPTOR_TABLE)) && (USB_DEVICE_CONFIG_DESCRIPTOR_TABLE > 0U))
+/*!
+ * @brief Registers the descriptor table.
+ *
+ * The GET_DESCRIPTOR requests found in the table are answered from the table by the control pipe, the other
+ * requests are passed to the device callback (kUSB_DeviceEventGetDeviceDescriptor...) as before. Call the function
+ * after #USB_DeviceClassInit and before the device is run, the table must not change while the device runs.
+ *
+ * @param[in] controllerId   The controller ID of the USB IP. See the enumeration #usb_controller_index_t.
+ * @param[in] table          The descriptor table, NULL removes the table.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceClassSetDescriptorTable(uint8_t controllerId, const usb_device_descriptor_table_struct_t *table);
+#endif
+
 /*!
  * @brief Handles the event passed to the class drivers.
  *
@@ -20,12 +20,25 @@
  * Definitions
  ******************************************************************************/
 
+/*! @brief The frame count mask in full speed, the count is in frames */
+#define USB_DEVICE_DFU_FS_FRAME_COUNT_MASK (0x000007FFU)
+/*! @brief The frame count mask in high speed, the count is in micro-frames */
+#define USB_DEVICE_DFU_HS_FRAME_COUNT_MASK (0x00003FFFU)
+/*! @brief The maximum value of bwPollTimeout */
+#define USB_DEVICE_DFU_POLL_TIMEOUT_MAX (0x00FFFFFFU)
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
 
 static usb_status_t USB_DeviceDfuAllocateHandle(usb_device_dfu_struct_t **handle);
 static usb_status_t USB_DeviceDfuFreeHandle(usb_device_dfu_struct_t *handle);
+static void USB_DeviceDfuStreamReset(usb_device_dfu_struct_t *dfuHandle);
+static void USB_DeviceDfuStreamProgram(usb_device_dfu_struct_t *dfuHandle);
+static uint32_t USB_DeviceDfuStreamPollTimeout(usb_device_dfu_struct_t *dfuHandle, uint32_t blocks);
+static usb_status_t USB_DeviceDfuStreamRequest(usb_device_dfu_struct_t *dfuHandle,
+                                               usb_device_dfu_event_t dfuRequest,
+                                               usb_device_control_request_struct_t *controlRequest);
 
 /*******************************************************************************
  * Variables
@@ -73,11 +86,336 @@ static usb_status_t USB_DeviceDfuAllocateHandle(usb_device_dfu_struct_t **handle
  */
 static usb_status_t USB_DeviceDfuFreeHandle(usb_device_dfu_struct_t *handle)
 {
-    handle->handle       = NULL;
-    handle->configStruct = (usb_device_class_config_struct_t *)NULL;
+    handle->handle                = NULL;
+    handle->configStruct          = (usb_device_class_config_struct_t *)NULL;
+    handle->stream.config.writeFn = NULL;
     return kStatus_USB_Success;
 }
 
+#if defined(USB_DEVICE_CONFIG_GET_SOF_COUNT) && (USB_DEVICE_CONFIG_GET_SOF_COUNT > 0U)
+/*!
+ * @brief Get the time elapsed since the block programming started.
+ *
+ * @param dfuHandle          The device dfu class handle.
+ *
+ * @return The elapsed time in ms.
+ */
+static uint32_t USB_DeviceDfuStreamElapsed(usb_device_dfu_struct_t *dfuHandle)
+{
+    uint32_t frame = dfuHandle->stream.programStart;
+
+    (void)USB_DeviceGetStatus(dfuHandle->handle, kUSB_DeviceStatusGetCurrentFrameCount, &frame);
+    if (USB_SPEED_HIGH == dfuHandle->stream.speed)
+    {
+        return ((frame - dfuHandle->stream.programStart) & USB_DEVICE_DFU_HS_FRAME_COUNT_MASK) / 8U;
+    }
+    return (frame - dfuHandle->stream.programStart) & USB_DEVICE_DFU_FS_FRAME_COUNT_MASK;
+}
+#endif
+
+/*!
+ * @brief Reset the download stream to dfuIDLE.
+ *
+ * This function drops the buffered blocks. The block being programmed cannot be stopped, its result is ignored.
+ *
+ * @param dfuHandle          The device dfu class handle.
+ */
+static void USB_DeviceDfuStreamReset(usb_device_dfu_struct_t *dfuHandle)
+{
+    usb_device_dfu_stream_struct_t *stream = &dfuHandle->stream;
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    if (0U != stream->programming)
+    {
+        stream->discard      = 1U;
+        stream->blockCount   = 1U;
+        stream->receiveIndex = (uint8_t)((stream->programIndex + 1U) % USB_DEVICE_CONFIG_DFU_STREAM_BUFFER_COUNT);
+    }
+    else
+    {
+        stream->blockCount   = 0U;
+        stream->receiveIndex = stream->programIndex;
+    }
+    stream->state       = (uint8_t)kUSB_DeviceDfuStateDfuIdle;
+    stream->status      = (uint8_t)kUSB_DeviceDfuStatusOk;
+    stream->imageLength = 0U;
+    OSA_EXIT_CRITICAL();
+}
+
+/*!
+ * @brief Start programming the oldest buffered block.
+ *
+ * This function hands the oldest buffered block to the flash writer if the writer is idle.
+ *
+ * @param dfuHandle          The device dfu class handle.
+ */
+static void USB_DeviceDfuStreamProgram(usb_device_dfu_struct_t *dfuHandle)
+{
+    usb_device_dfu_stream_struct_t *stream = &dfuHandle->stream;
+    uint8_t *buffer                        = NULL;
+    uint32_t offset                        = 0U;
+    uint32_t length                        = 0U;
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    if ((0U == stream->programming) && (0U != stream->blockCount) &&
+        ((uint8_t)kUSB_DeviceDfuStateError != stream->state))
+    {
+        stream->programming = 1U;
+        buffer              = &stream->config.buffer[stream->programIndex * stream->config.transferSize];
+        offset              = stream->blockOffset[stream->programIndex];
+        length              = stream->blockLength[stream->programIndex];
+#if defined(USB_DEVICE_CONFIG_GET_SOF_COUNT) && (USB_DEVICE_CONFIG_GET_SOF_COUNT > 0U)
+        stream->speed = USB_SPEED_FULL;
+        (void)USB_DeviceGetStatus(dfuHandle->handle, kUSB_DeviceStatusSpeed, &stream->speed);
+        (void)USB_DeviceGetStatus(dfuHandle->handle, kUSB_DeviceStatusGetCurrentFrameCount, &stream->programStart);
+#endif
+    }
+    OSA_EXIT_CRITICAL();
+
+    if (NULL != buffer)
+    {
+        /* The writer may finish the block and call USB_DeviceDfuStreamWriteDone before it returns */
+        if (kStatus_USB_Success != stream->config.writeFn(stream->config.writerParam, offset, buffer, length))
+        {
+            OSA_ENTER_CRITICAL();
+            stream->programming  = 0U;
+            stream->discard      = 0U;
+            stream->blockCount   = 0U;
+            stream->receiveIndex = stream->programIndex;
+            stream->state        = (uint8_t)kUSB_DeviceDfuStateError;
+            stream->status       = (uint8_t)kUSB_DeviceDfuStatusErrWrite;
+            OSA_EXIT_CRITICAL();
+        }
+    }
+}
+
+/*!
+ * @brief Get the bwPollTimeout.
+ *
+ * This function estimates the time the flash writer needs to program the given count of blocks.
+ *
+ * @param dfuHandle          The device dfu class handle.
+ * @param blocks             The block count the host should wait for.
+ *
+ * @return The bwPollTimeout in ms.
+ */
+static uint32_t USB_DeviceDfuStreamPollTimeout(usb_device_dfu_struct_t *dfuHandle, uint32_t blocks)
+{
+    uint32_t timeout = dfuHandle->stream.programTime * blocks;
+#if defined(USB_DEVICE_CONFIG_GET_SOF_COUNT) && (USB_DEVICE_CONFIG_GET_SOF_COUNT > 0U)
+    uint32_t elapsed = 0U;
+
+    if (0U != dfuHandle->stream.programming)
+    {
+        elapsed = USB_DeviceDfuStreamElapsed(dfuHandle);
+    }
+    timeout = (timeout > elapsed) ? (timeout - elapsed) : 0U;
+#endif
+
+    /* Do not let the host poll back-to-back */
+    if (0U == timeout)
+    {
+        timeout = 1U;
+    }
+    if (timeout > USB_DEVICE_DFU_POLL_TIMEOUT_MAX)
+    {
+        timeout = USB_DEVICE_DFU_POLL_TIMEOUT_MAX;
+    }
+    return timeout;
+}
+
+/*!
+ * @brief Handle the dfu request in the download stream mode.
+ *
+ * This function handles DFU_DNLOAD, DFU_GETSTATUS, DFU_GETSTATE, DFU_CLRSTATUS and DFU_ABORT.
+ *
+ * @param dfuHandle          The device dfu class handle.
+ * @param dfuRequest         The dfu request event.
+ * @param controlRequest     The control request.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ * @retval kStatus_USB_InvalidRequest       The request is invalid in current state, the control pipe is stalled.
+ */
+static usb_status_t USB_DeviceDfuStreamRequest(usb_device_dfu_struct_t *dfuHandle,
+                                               usb_device_dfu_event_t dfuRequest,
+                                               usb_device_control_request_struct_t *controlRequest)
+{
+    usb_device_dfu_stream_struct_t *stream = &dfuHandle->stream;
+    usb_status_t error                     = kStatus_USB_InvalidRequest;
+    uint32_t pollTimeout                   = 0U;
+    uint8_t manifest                       = 0U;
+    OSA_SR_ALLOC();
+
+    switch (dfuRequest)
+    {
+        case kUSB_DeviceDfuEventDownLoad:
+            if (0U == controlRequest->setup->wLength)
+            {
+                /* The end of the image */
+                if ((uint8_t)kUSB_DeviceDfuStateDnloadIdle == stream->state)
+                {
+                    stream->state = (uint8_t)kUSB_DeviceDfuStateManifestSync;
+                    error         = kStatus_USB_Success;
+                }
+            }
+            else if (0U != controlRequest->isSetup)
+            {
+                /* Get a free block buffer to receive the block */
+                OSA_ENTER_CRITICAL();
+                if ((((uint8_t)kUSB_DeviceDfuStateDfuIdle == stream->state) ||
+                     ((uint8_t)kUSB_DeviceDfuStateDnloadIdle == stream->state)) &&
+                    (controlRequest->setup->wLength <= stream->config.transferSize) &&
+                    (stream->blockCount < USB_DEVICE_CONFIG_DFU_STREAM_BUFFER_COUNT))
+                {
+                    if ((uint8_t)kUSB_DeviceDfuStateDfuIdle == stream->state)
+                    {
+                        stream->imageLength = 0U;
+                    }
+                    controlRequest->buffer = &stream->config.buffer[stream->receiveIndex * stream->config.transferSize];
+                    controlRequest->length = controlRequest->setup->wLength;
+                    error                  = kStatus_USB_Success;
+                }
+                OSA_EXIT_CRITICAL();
+            }
+            else
+            {
+                /* The block is received, queue it to the flash writer */
+                OSA_ENTER_CRITICAL();
+                stream->blockOffset[stream->receiveIndex] = stream->imageLength;
+                stream->blockLength[stream->receiveIndex] = controlRequest->length;
+                stream->imageLength += controlRequest->length;
+                stream->receiveIndex =
+                    (uint8_t)((stream->receiveIndex + 1U) % USB_DEVICE_CONFIG_DFU_STREAM_BUFFER_COUNT);
+                stream->blockCount++;
+                stream->state = (uint8_t)kUSB_DeviceDfuStateDnloadSync;
+                OSA_EXIT_CRITICAL();
+                USB_DeviceDfuStreamProgram(dfuHandle);
+                error = kStatus_USB_Success;
+            }
+            break;
+        case kUSB_DeviceDfuEventGetStatus:
+            OSA_ENTER_CRITICAL();
+            switch (stream->state)
+            {
+                case (uint8_t)kUSB_DeviceDfuStateDnloadSync:
+                case (uint8_t)kUSB_DeviceDfuStateDnBusy:
+                    if (stream->blockCount < USB_DEVICE_CONFIG_DFU_STREAM_BUFFER_COUNT)
+                    {
+#if !(defined(USB_DEVICE_CONFIG_GET_SOF_COUNT) && (USB_DEVICE_CONFIG_GET_SOF_COUNT > 0U))
+                        if ((uint8_t)kUSB_DeviceDfuStateDnBusy == stream->state)
+                        {
+                            /* The buffer was freed in time, shorten the estimation */
+                            stream->programTime -= (stream->programTime >> 3U);
+                        }
+#endif
+                        /* A buffer is free, the host can send the next block now */
+                        stream->state = (uint8_t)kUSB_DeviceDfuStateDnloadIdle;
+                    }
+                    else
+                    {
+#if !(defined(USB_DEVICE_CONFIG_GET_SOF_COUNT) && (USB_DEVICE_CONFIG_GET_SOF_COUNT > 0U))
+                        if ((uint8_t)kUSB_DeviceDfuStateDnBusy == stream->state)
+                        {
+                            /* The host waited for nothing, lengthen the estimation */
+                            stream->programTime += (stream->programTime >> 1U) + 1U;
+                        }
+#endif
+                        stream->state = (uint8_t)kUSB_DeviceDfuStateDnBusy;
+                        pollTimeout   = USB_DeviceDfuStreamPollTimeout(dfuHandle, 1U);
+                    }
+                    break;
+                case (uint8_t)kUSB_DeviceDfuStateManifestSync:
+                case (uint8_t)kUSB_DeviceDfuStateManifest:
+                    if (0U != stream->blockCount)
+                    {
+                        /* Wait for the buffered blocks */
+                        stream->state = (uint8_t)kUSB_DeviceDfuStateManifest;
+                        pollTimeout   = USB_DeviceDfuStreamPollTimeout(dfuHandle, stream->blockCount);
+                    }
+                    else
+                    {
+                        manifest = 1U;
+                    }
+                    break;
+                default:
+                    /*no action*/
+                    break;
+            }
+            OSA_EXIT_CRITICAL();
+
+            if (0U != manifest)
+            {
+                usb_device_dfu_status_t status = kUSB_DeviceDfuStatusOk;
+
+                if (NULL != stream->config.manifestFn)
+                {
+                    status = stream->config.manifestFn(stream->config.writerParam, stream->imageLength);
+                }
+                if (kUSB_DeviceDfuStatusOk != status)
+                {
+                    stream->state  = (uint8_t)kUSB_DeviceDfuStateError;
+                    stream->status = (uint8_t)status;
+                }
+                else if (0U != stream->config.manifestationTolerant)
+                {
+                    stream->state = (uint8_t)kUSB_DeviceDfuStateDfuIdle;
+                }
+                else
+                {
+                    stream->state = (uint8_t)kUSB_DeviceDfuStateManifestWaitReset;
+                }
+            }
+
+            stream->statusResponse.bStatus          = stream->status;
+            stream->statusResponse.bwPollTimeout[0] = (uint8_t)(pollTimeout & 0xFFU);
+            stream->statusResponse.bwPollTimeout[1] = (uint8_t)((pollTimeout >> 8U) & 0xFFU);
+            stream->statusResponse.bwPollTimeout[2] = (uint8_t)((pollTimeout >> 16U) & 0xFFU);
+            stream->statusResponse.bState           = stream->state;
+            stream->statusResponse.iString          = 0U;
+            controlRequest->buffer                  = (uint8_t *)&stream->statusResponse;
+            controlRequest->length                  = USB_DEVICE_DFU_STATUS_LENGTH;
+            error                                   = kStatus_USB_Success;
+            break;
+        case kUSB_DeviceDfuEventGetState:
+            stream->statusResponse.bState = stream->state;
+            controlRequest->buffer        = &stream->statusResponse.bState;
+            controlRequest->length        = 1U;
+            error                         = kStatus_USB_Success;
+            break;
+        case kUSB_DeviceDfuEventClearStatus:
+            if ((uint8_t)kUSB_DeviceDfuStateError == stream->state)
+            {
+                USB_DeviceDfuStreamReset(dfuHandle);
+                error = kStatus_USB_Success;
+            }
+            break;
+        case kUSB_DeviceDfuEventAbort:
+            if (((uint8_t)kUSB_DeviceDfuStateDfuIdle == stream->state) ||
+                ((uint8_t)kUSB_DeviceDfuStateDnloadSync == stream->state) ||
+                ((uint8_t)kUSB_DeviceDfuStateDnloadIdle == stream->state) ||
+                ((uint8_t)kUSB_DeviceDfuStateManifestSync == stream->state) ||
+                ((uint8_t)kUSB_DeviceDfuStateUploadIdle == stream->state))
+            {
+                USB_DeviceDfuStreamReset(dfuHandle);
+                error = kStatus_USB_Success;
+            }
+            break;
+        default:
+            /*no action*/
+            break;
+    }
+
+    if (kStatus_USB_Success != error)
+    {
+        /* The request is stalled, the device enters dfuERROR */
+        stream->state  = (uint8_t)kUSB_DeviceDfuStateError;
+        stream->status = (uint8_t)kUSB_DeviceDfuStatusErrStalledPkt;
+    }
+    return error;
+}
+
 /*!
  * @brief Handle the event passed to the dfu class.
  *
@@ -109,6 +447,10 @@ usb_status_t USB_DeviceDfuEvent(void *handle, uint32_t event, void *param)
     switch (eventCode)
     {
         case kUSB_DeviceClassEventDeviceReset:
+            if (NULL != dfuHandle->stream.config.writeFn)
+            {
+                USB_DeviceDfuStreamReset(dfuHandle);
+            }
             error = kStatus_USB_Success;
             break;
         case kUSB_DeviceClassEventSetConfiguration:
@@ -187,12 +529,23 @@ usb_status_t USB_DeviceDfuEvent(void *handle, uint32_t event, void *param)
                 }
             }
 
-            if (dfuRequest != -1)
+            if ((dfuRequest != -1) && (NULL != dfuHandle->stream.config.writeFn) &&
+                (dfuRequest != (int32_t)kUSB_DeviceDfuEventDetach) &&
+                (dfuRequest != (int32_t)kUSB_DeviceDfuEventUpLoad))
+            {
+                /* The download stream handles the request, DFU_DETACH and DFU_UPLOAD are still passed to the app */
+                error = USB_DeviceDfuStreamRequest(dfuHandle, (usb_device_dfu_event_t)dfuRequest, controlRequest);
+            }
+            else if (dfuRequest != -1)
             {
                 /* ClassCallback is initialized in classInit of s_UsbDeviceClassInterfaceMap,
                 it is from the second parameter of classInit */
                 error = dfuHandle->configStruct->classCallback((class_handle_t)dfuHandle, dfuRequest, controlRequest);
             }
+            else
+            {
+                /*no action*/
+            }
         }
         break;
         default:
@@ -277,4 +630,98 @@ usb_status_t USB_DeviceDfuDeinit(class_handle_t handle)
     return kStatus_USB_Success;
 #endif
 }
+
+/*!
+ * @brief Initialize the dfu download stream.
+ *
+ * The function sets the flash writer and the block buffers, and resets the stream to dfuIDLE.
+ *
+ * @param handle The dfu class handle got from usb_device_class_config_struct_t::classHandle.
+ * @param config The stream configuration.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceDfuStreamInit(class_handle_t handle, usb_device_dfu_stream_config_struct_t *config)
+{
+    usb_device_dfu_struct_t *dfuHandle = (usb_device_dfu_struct_t *)handle;
+    usb_device_dfu_stream_struct_t *stream;
+
+    if (NULL == dfuHandle)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if ((NULL == config) || (NULL == config->buffer) || (NULL == config->writeFn) || (0U == config->transferSize))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    stream = &dfuHandle->stream;
+    if (0U != stream->programming)
+    {
+        return kStatus_USB_Busy;
+    }
+    stream->config       = *config;
+    stream->programTime  = config->pollTimeout;
+    stream->programIndex = 0U;
+    stream->discard      = 0U;
+    USB_DeviceDfuStreamReset(dfuHandle);
+    return kStatus_USB_Success;
+}
+
+/*!
+ * @brief Notify the flash writer has finished a block.
+ *
+ * The function frees the block buffer, measures the program time and starts programming the next buffered block.
+ *
+ * @param handle The dfu class handle got from usb_device_class_config_struct_t::classHandle.
+ * @param status The program result.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceDfuStreamWriteDone(class_handle_t handle, usb_device_dfu_status_t status)
+{
+    usb_device_dfu_struct_t *dfuHandle = (usb_device_dfu_struct_t *)handle;
+    usb_device_dfu_stream_struct_t *stream;
+    OSA_SR_ALLOC();
+
+    if (NULL == dfuHandle)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+
+    stream = &dfuHandle->stream;
+    OSA_ENTER_CRITICAL();
+    if (0U == stream->programming)
+    {
+        OSA_EXIT_CRITICAL();
+        return kStatus_USB_Error;
+    }
+#if defined(USB_DEVICE_CONFIG_GET_SOF_COUNT) && (USB_DEVICE_CONFIG_GET_SOF_COUNT > 0U)
+    /* Average the measured program time, rounded up */
+    stream->programTime = (stream->programTime * 3U + USB_DeviceDfuStreamElapsed(dfuHandle) + 3U) / 4U;
+#endif
+    stream->programming  = 0U;
+    stream->programIndex = (uint8_t)((stream->programIndex + 1U) % USB_DEVICE_CONFIG_DFU_STREAM_BUFFER_COUNT);
+    stream->blockCount--;
+    if (0U != stream->discard)
+    {
+        stream->discard = 0U;
+    }
+    else if (kUSB_DeviceDfuStatusOk != status)
+    {
+        /* Drop the buffered blocks, the host gets the error in the next DFU_GETSTATUS */
+        stream->blockCount   = 0U;
+        stream->receiveIndex = stream->programIndex;
+        stream->state        = (uint8_t)kUSB_DeviceDfuStateError;
+        stream->status       = (uint8_t)status;
+    }
+    else
+    {
+        /*no action*/
+    }
+    OSA_EXIT_CRITICAL();
+
+    USB_DeviceDfuStreamProgram(dfuHandle);
+    return kStatus_USB_Success;
+}
 #endif
@@ -31,6 +31,14 @@
 #define USB_DEVICE_DFU_GETSTATE (0x05U)
 #define USB_DEVICE_DFU_ABORT (0x06U)
 
+/*! @brief The block buffer count of the DFU download stream */
+#ifndef USB_DEVICE_CONFIG_DFU_STREAM_BUFFER_COUNT
+#define USB_DEVICE_CONFIG_DFU_STREAM_BUFFER_COUNT (2U)
+#endif
+
+/*! @brief The length of the DFU_GETSTATUS response */
+#define USB_DEVICE_DFU_STATUS_LENGTH (6U)
+
 /*! @brief Available common EVENT types in dfu class callback */
 typedef enum _usb_device_dfu_event
 {
@@ -43,11 +51,122 @@ typedef enum _usb_device_dfu_event
     kUSB_DeviceDfuEventAbort,          /*!< Abort request */
 } usb_device_dfu_event_t;
 
+/*! @brief DFU device state, the bState of the DFU_GETSTATUS response */
+typedef enum _usb_device_dfu_state
+{
+    kUSB_DeviceDfuStateAppIdle = 0x00U,      /*!< appIDLE */
+    kUSB_DeviceDfuStateAppDetach,            /*!< appDETACH */
+    kUSB_DeviceDfuStateDfuIdle,              /*!< dfuIDLE */
+    kUSB_DeviceDfuStateDnloadSync,           /*!< dfuDNLOAD-SYNC */
+    kUSB_DeviceDfuStateDnBusy,               /*!< dfuDNBUSY */
+    kUSB_DeviceDfuStateDnloadIdle,           /*!< dfuDNLOAD-IDLE */
+    kUSB_DeviceDfuStateManifestSync,         /*!< dfuMANIFEST-SYNC */
+    kUSB_DeviceDfuStateManifest,             /*!< dfuMANIFEST */
+    kUSB_DeviceDfuStateManifestWaitReset,    /*!< dfuMANIFEST-WAIT-RESET */
+    kUSB_DeviceDfuStateUploadIdle,           /*!< dfuUPLOAD-IDLE */
+    kUSB_DeviceDfuStateError,                /*!< dfuERROR */
+} usb_device_dfu_state_t;
+
+/*! @brief DFU device status, the bStatus of the DFU_GETSTATUS response */
+typedef enum _usb_device_dfu_status
+{
+    kUSB_DeviceDfuStatusOk = 0x00U,    /*!< No error condition is present */
+    kUSB_DeviceDfuStatusErrTarget,     /*!< File is not targeted for use by this device */
+    kUSB_DeviceDfuStatusErrFile,       /*!< File is for this device but fails some vendor-specific verification test */
+    kUSB_DeviceDfuStatusErrWrite,      /*!< Device is unable to write memory */
+    kUSB_DeviceDfuStatusErrErase,      /*!< Memory erase function failed */
+    kUSB_DeviceDfuStatusErrCheckErased, /*!< Memory erase check failed */
+    kUSB_DeviceDfuStatusErrProg,       /*!< Program memory function failed */
+    kUSB_DeviceDfuStatusErrVerify,     /*!< Programmed memory failed verification */
+    kUSB_DeviceDfuStatusErrAddress,    /*!< Cannot program memory due to received address that is out of range */
+    kUSB_DeviceDfuStatusErrNotDone,    /*!< Received DFU_DNLOAD with wLength = 0, but device does not think it has all
+                                            of the data yet */
+    kUSB_DeviceDfuStatusErrFirmware,   /*!< Device's firmware is corrupt */
+    kUSB_DeviceDfuStatusErrVendor,     /*!< iString indicates a vendor-specific error */
+    kUSB_DeviceDfuStatusErrUsbr,       /*!< Device detected unexpected USB reset signaling */
+    kUSB_DeviceDfuStatusErrPor,        /*!< Device detected unexpected power on reset */
+    kUSB_DeviceDfuStatusErrUnknown,    /*!< Something went wrong, but the device does not know what it was */
+    kUSB_DeviceDfuStatusErrStalledPkt, /*!< Device stalled an unexpected request */
+} usb_device_dfu_status_t;
+
+/*!
+ * @brief Starts programming a block of the DFU download stream.
+ *
+ * The function must not wait for the flash, it starts the erase and program of the block and returns, and
+ * USB_DeviceDfuStreamWriteDone is called when the block is programmed. The buffer is kept until then.
+ *
+ * @param writerParam The writerParam of the stream configuration.
+ * @param offset      The offset of the block in the image.
+ * @param buffer      The block data.
+ * @param length      The block length.
+ *
+ * @return kStatus_USB_Success if the program is started, otherwise the download fails with errWRITE.
+ */
+typedef usb_status_t (*usb_device_dfu_flash_write_t)(void *writerParam,
+                                                     uint32_t offset,
+                                                     uint8_t *buffer,
+                                                     uint32_t length);
+
+/*!
+ * @brief Manifests the downloaded image.
+ *
+ * The function is called in the DFU_GETSTATUS request once all blocks are programmed, it should be short.
+ *
+ * @param writerParam The writerParam of the stream configuration.
+ * @param length      The image length.
+ *
+ * @return A DFU status code, kUSB_DeviceDfuStatusOk if the image is valid.
+ */
+typedef usb_device_dfu_status_t (*usb_device_dfu_flash_manifest_t)(void *writerParam, uint32_t length);
+
+/*! @brief The DFU download stream configuration */
+typedef struct _usb_device_dfu_stream_config_struct
+{
+    uint8_t *buffer; /*!< The block buffers, USB_DEVICE_CONFIG_DFU_STREAM_BUFFER_COUNT * transferSize bytes, aligned to
+                          USB_DATA_ALIGN_SIZE */
+    uint32_t transferSize;                      /*!< The wTransferSize of the DFU functional descriptor */
+    uint32_t pollTimeout;                       /*!< The bwPollTimeout in ms used before a program time is measured */
+    usb_device_dfu_flash_write_t writeFn;       /*!< Starts programming a block */
+    usb_device_dfu_flash_manifest_t manifestFn; /*!< Manifests the image, optional */
+    void *writerParam;                          /*!< The parameter of writeFn and manifestFn */
+    uint8_t manifestationTolerant;              /*!< The bitManifestationTolerant of the DFU functional descriptor */
+} usb_device_dfu_stream_config_struct_t;
+
+/*! @brief The DFU_GETSTATUS response */
+typedef struct _usb_device_dfu_status_response_struct
+{
+    uint8_t bStatus;          /*!< The status resulting from the execution of the most recent request */
+    uint8_t bwPollTimeout[3]; /*!< The minimum time in ms the host should wait before the next DFU_GETSTATUS */
+    uint8_t bState;           /*!< The state the device is going to enter immediately following the response */
+    uint8_t iString;          /*!< The index of the status description string */
+} usb_device_dfu_status_response_struct_t;
+
+/*! @brief The DFU download stream state */
+typedef struct _usb_device_dfu_stream_struct
+{
+    usb_device_dfu_stream_config_struct_t config;                  /*!< The stream configuration */
+    usb_device_dfu_status_response_struct_t statusResponse;        /*!< The DFU_GETSTATUS response buffer */
+    uint32_t blockOffset[USB_DEVICE_CONFIG_DFU_STREAM_BUFFER_COUNT]; /*!< The image offset of each buffered block */
+    uint32_t blockLength[USB_DEVICE_CONFIG_DFU_STREAM_BUFFER_COUNT]; /*!< The length of each buffered block */
+    uint32_t imageLength;  /*!< The downloaded length of the image */
+    uint32_t programTime;  /*!< The estimated program time of one block in ms */
+    uint32_t programStart; /*!< The frame count when the block programming started */
+    uint8_t state;         /*!< The DFU state, see usb_device_dfu_state_t */
+    uint8_t status;        /*!< The DFU status, see usb_device_dfu_status_t */
+    uint8_t receiveIndex;  /*!< The buffer receiving the next block */
+    uint8_t programIndex;  /*!< The oldest buffered block, programming or next to program */
+    uint8_t blockCount;    /*!< The buffered blocks including the one programming */
+    uint8_t programming;   /*!< The block of programIndex is programming */
+    uint8_t discard;       /*!< The block programming is aborted, its result is ignored */
+    uint8_t speed;         /*!< The bus speed when the block programming started */
+} usb_device_dfu_stream_struct_t;
+
 /*! @brief The DFU device class status structure */
 typedef struct _usb_device_dfu_struct
 {
     usb_device_handle handle;                       /*!< The device handle */
     usb_device_class_config_struct_t *configStruct; /*!< The configuration of the class. */
+    usb_device_dfu_stream_struct_t stream;          /*!< The download stream, used when the flash writer is set */
 } usb_device_dfu_struct_t;
 
 /*******************************************************************************
@@ -100,6 +219,45 @@ extern usb_status_t USB_DeviceDfuDeinit(class_handle_t handle);
  */
 extern usb_status_t USB_DeviceDfuEvent(void *handle, uint32_t event, void *param);
 
+/*!
+ * @name USB device DFU class APIs
+ * @{
+ */
+
+/*!
+ * @brief Initializes the DFU download stream.
+ *
+ * Once the stream is initialized, the class handles DFU_DNLOAD, DFU_GETSTATUS, DFU_GETSTATE, DFU_CLRSTATUS and
+ * DFU_ABORT itself and the application does not get these events. Each downloaded block is received to a free block
+ * buffer and handed to the flash writer, the host gets dfuDNLOAD-IDLE without waiting while a buffer is free, so the
+ * next block is transferred while the previous one is programmed. When all buffers are used, the host gets dfuDNBUSY
+ * with the bwPollTimeout estimated from the measured program time of the previous blocks (the frame count is used
+ * when USB_DEVICE_CONFIG_GET_SOF_COUNT is enabled, otherwise the estimation follows the polling results).
+ *
+ * The whole block of wTransferSize is received in the data stage of one control transfer, the controller driver
+ * splits it to packets.
+ *
+ * @param[in] handle The DFU class handle received from usb_device_class_config_struct_t::classHandle.
+ * @param[in] config The stream configuration.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+extern usb_status_t USB_DeviceDfuStreamInit(class_handle_t handle, usb_device_dfu_stream_config_struct_t *config);
+
+/*!
+ * @brief Notifies that the flash writer has finished a block.
+ *
+ * The function can be called in the flash interrupt, or in usb_device_dfu_flash_write_t for a synchronous writer.
+ *
+ * @param[in] handle The DFU class handle received from usb_device_class_config_struct_t::classHandle.
+ * @param[in] status kUSB_DeviceDfuStatusOk, or the error reported to the host.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+extern usb_status_t USB_DeviceDfuStreamWriteDone(class_handle_t handle, usb_device_dfu_status_t status);
+
+/*! @}*/
+
 #if defined(__cplusplus)
 }
 #endif
@@ -37,6 +37,7 @@ static usb_status_t USB_DevicePhdcInterruptInCallback(usb_device_handle handle,
                                                       void *callbackParam);
 static usb_status_t USB_DevicePhdcEndpointsInit(usb_device_phdc_struct_t *phdcHandle);
 static usb_status_t USB_DevicePhdcEndpointsDeinit(usb_device_phdc_struct_t *phdcHandle);
+static usb_status_t USB_DevicePhdcSchedule(usb_device_phdc_struct_t *phdcHandle, usb_device_phdc_pipe_t *pipe);
 
 /*******************************************************************************
  * Variables
@@ -46,6 +47,14 @@ static usb_status_t USB_DevicePhdcEndpointsDeinit(usb_device_phdc_struct_t *phdc
 USB_GLOBAL USB_RAM_ADDRESS_ALIGNMENT(USB_DATA_ALIGN_SIZE) static usb_device_phdc_struct_t
     g_phdcHandle[USB_DEVICE_CONFIG_PHDC];
 
+/*! @brief the Meta-data message preamble buffer of each PHDC instance */
+USB_GLOBAL USB_RAM_ADDRESS_ALIGNMENT(USB_DATA_ALIGN_SIZE) static uint8_t
+    s_PhdcPreambleBuffer[USB_DEVICE_CONFIG_PHDC][USB_DATA_ALIGN_SIZE_MULTIPLE(USB_DEVICE_PHDC_MESSAGE_PREAMBLE_LENGTH)];
+
+/*! @brief the Meta-data message preamble signature */
+static const uint8_t s_PhdcPreambleSignature[USB_DEVICE_PHDC_MESSAGE_PREAMBLE_SIGNATURE_SIZE] = {
+    'P', 'h', 'd', 'c', 'Q', 'o', 'S', 'S', 'i', 'g', 'n', 'a', 't', 'u', 'r', 'e'};
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
@@ -92,6 +101,315 @@ static usb_status_t USB_DevicePhdcFreeHandle(usb_device_phdc_struct_t *handle)
     return kStatus_USB_Success;
 }
 
+/*!
+ * @brief Get the index of a latency/reliability bin.
+ *
+ * @param qos             The latency/reliability bin, only one bit is set.
+ *
+ * @return The bin index, USB_DEVICE_PHDC_QOS_BIN_COUNT if the bin is invalid.
+ */
+static uint8_t USB_DevicePhdcQosBin(uint8_t qos)
+{
+    uint8_t bin;
+
+    for (bin = 0U; bin < USB_DEVICE_PHDC_QOS_BIN_COUNT; bin++)
+    {
+        if (((uint32_t)1U << bin) == (uint32_t)qos)
+        {
+            break;
+        }
+    }
+    return bin;
+}
+
+/*!
+ * @brief Remove the first request of a bin queue.
+ *
+ * The caller must be in the critical section.
+ *
+ * @param phdcHandle      The device PHDC class handle.
+ * @param bin             The bin index.
+ *
+ * @return The request, NULL if the queue is empty.
+ */
+static usb_device_phdc_send_request_t *USB_DevicePhdcDequeue(usb_device_phdc_struct_t *phdcHandle, uint8_t bin)
+{
+    usb_device_phdc_send_queue_t *queue     = &phdcHandle->sendQueue;
+    usb_device_phdc_send_request_t *request = queue->head[bin];
+
+    if (NULL != request)
+    {
+        queue->head[bin] = request->next;
+        if (NULL == queue->head[bin])
+        {
+            queue->tail[bin] = NULL;
+        }
+        request->next = NULL;
+    }
+    return request;
+}
+
+/*!
+ * @brief Reset the send queues.
+ *
+ * This function puts all requests in the free list, the queued requests are dropped without notification.
+ *
+ * @param phdcHandle      The device PHDC class handle.
+ */
+static void USB_DevicePhdcSendQueueReset(usb_device_phdc_struct_t *phdcHandle)
+{
+    usb_device_phdc_send_queue_t *queue = &phdcHandle->sendQueue;
+
+    queue->freeList = NULL;
+    for (uint32_t count = 0U; count < USB_DEVICE_CONFIG_PHDC_SEND_QUEUE_SIZE; count++)
+    {
+        queue->request[count].next = queue->freeList;
+        queue->freeList            = &queue->request[count];
+    }
+    for (uint32_t bin = 0U; bin < USB_DEVICE_PHDC_QOS_BIN_COUNT; bin++)
+    {
+        queue->head[bin] = NULL;
+        queue->tail[bin] = NULL;
+    }
+    phdcHandle->bulkIn.request      = NULL;
+    phdcHandle->interruptIn.request = NULL;
+    phdcHandle->preambleTransfers   = 0U;
+}
+
+/*!
+ * @brief Flush the send queues.
+ *
+ * This function removes the queued requests and notifies them with USB_CANCELLED_TRANSFER_LENGTH, the request being
+ * sent is notified by the pipe callback.
+ *
+ * @param phdcHandle      The device PHDC class handle.
+ */
+static void USB_DevicePhdcSendQueueFlush(usb_device_phdc_struct_t *phdcHandle)
+{
+    usb_device_endpoint_callback_message_struct_t message;
+    usb_device_phdc_send_request_t *request;
+    uint32_t event;
+    OSA_SR_ALLOC();
+
+    for (uint8_t bin = 0U; bin < USB_DEVICE_PHDC_QOS_BIN_COUNT; bin++)
+    {
+        do
+        {
+            OSA_ENTER_CRITICAL();
+            request = USB_DevicePhdcDequeue(phdcHandle, bin);
+            if (NULL != request)
+            {
+                message.buffer                 = request->buffer;
+                request->next                  = phdcHandle->sendQueue.freeList;
+                phdcHandle->sendQueue.freeList = request;
+            }
+            /* The announced transfers are flushed */
+            phdcHandle->preambleTransfers = 0U;
+            OSA_EXIT_CRITICAL();
+
+            if ((NULL != request) && (NULL != phdcHandle->configStruct) &&
+                (NULL != phdcHandle->configStruct->classCallback))
+            {
+                message.length  = USB_CANCELLED_TRANSFER_LENGTH;
+                message.isSetup = 0U;
+                event           = (0U == bin) ? (uint32_t)kUSB_DevicePhdcEventInterruptInSendComplete :
+                                                (uint32_t)kUSB_DevicePhdcEventBulkInSendComplete;
+                /* classCallback is initialized in classInit of s_UsbDeviceClassInterfaceMap,
+                it is from the second parameter of classInit */
+                (void)phdcHandle->configStruct->classCallback((class_handle_t)phdcHandle, event, &message);
+            }
+        } while (NULL != request);
+    }
+}
+
+/*!
+ * @brief Send the next queued data through a pipe.
+ *
+ * The interrupt IN pipe sends the Low.Good bin and the bulk IN pipe sends the other bins, the lowest latency bin
+ * first. When the Meta-data message preamble feature is set, the bulk IN pipe sends the preamble of the bin and then
+ * the transfers announced by the preamble.
+ *
+ * @param phdcHandle      The device PHDC class handle.
+ * @param pipe            The interrupt IN pipe or the bulk IN pipe.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_DevicePhdcSchedule(usb_device_phdc_struct_t *phdcHandle, usb_device_phdc_pipe_t *pipe)
+{
+    usb_device_phdc_send_queue_t *queue     = &phdcHandle->sendQueue;
+    usb_device_phdc_send_request_t *request = NULL;
+    uint8_t *buffer                         = NULL;
+    uint32_t length                         = 0U;
+    usb_status_t error                      = kStatus_USB_Success;
+    uint8_t announced                       = 0U;
+    uint8_t bin;
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    if ((0U == pipe->isBusy) && (0U != pipe->ep) && (0U != phdcHandle->configuration) &&
+        (NULL != phdcHandle->interfaceHandle))
+    {
+        if (pipe == &phdcHandle->interruptIn)
+        {
+            request = USB_DevicePhdcDequeue(phdcHandle, 0U);
+        }
+        else if ((0U != phdcHandle->preambleEnabled) && (0U != phdcHandle->preambleTransfers))
+        {
+            /* The transfers announced by the preamble go before any other bin */
+            request = USB_DevicePhdcDequeue(phdcHandle, phdcHandle->preambleBin);
+            if (NULL != request)
+            {
+                phdcHandle->preambleTransfers--;
+                announced = 1U;
+            }
+            else
+            {
+                phdcHandle->preambleTransfers = 0U;
+            }
+        }
+        else
+        {
+            for (bin = 1U; bin < USB_DEVICE_PHDC_QOS_BIN_COUNT; bin++)
+            {
+                if (NULL != queue->head[bin])
+                {
+                    break;
+                }
+            }
+            if (bin >= USB_DEVICE_PHDC_QOS_BIN_COUNT)
+            {
+                /* no queued data */
+            }
+            else if (0U != phdcHandle->preambleEnabled)
+            {
+                uint8_t transfers = 0U;
+
+                for (request = queue->head[bin];
+                     (NULL != request) && (transfers < USB_DEVICE_CONFIG_PHDC_PREAMBLE_MAX_TRANSFERS);
+                     request = request->next)
+                {
+                    transfers++;
+                }
+                request = NULL;
+                buffer  = phdcHandle->preambleBuffer;
+                length  = USB_DEVICE_PHDC_MESSAGE_PREAMBLE_LENGTH;
+                (void)memcpy(buffer, s_PhdcPreambleSignature, USB_DEVICE_PHDC_MESSAGE_PREAMBLE_SIGNATURE_SIZE);
+                buffer[USB_DEVICE_PHDC_MESSAGE_PREAMBLE_SIGNATURE_SIZE]      = transfers;
+                buffer[USB_DEVICE_PHDC_MESSAGE_PREAMBLE_SIGNATURE_SIZE + 1U] = USB_DEVICE_PHDC_QOS_ENCODING_VERSION;
+                buffer[USB_DEVICE_PHDC_MESSAGE_PREAMBLE_SIGNATURE_SIZE + 2U] = (uint8_t)(1U << bin);
+                buffer[USB_DEVICE_PHDC_MESSAGE_PREAMBLE_SIGNATURE_SIZE + 3U] = 0U; /* no opaque data */
+                phdcHandle->preambleBin       = bin;
+                phdcHandle->preambleTransfers = transfers;
+            }
+            else
+            {
+                request = USB_DevicePhdcDequeue(phdcHandle, bin);
+            }
+        }
+        if (NULL != request)
+        {
+            buffer = request->buffer;
+            length = request->length;
+        }
+        if (NULL != buffer)
+        {
+            pipe->isBusy  = 1U;
+            pipe->request = request;
+        }
+    }
+    OSA_EXIT_CRITICAL();
+
+    if (NULL == buffer)
+    {
+        return kStatus_USB_Success;
+    }
+    if (0U != pipe->pipeStall)
+    {
+        pipe->pipeDataBuffer = buffer;
+        pipe->pipeDataLen    = length;
+        return kStatus_USB_Success;
+    }
+    error = USB_DeviceSendRequest(phdcHandle->handle, pipe->ep, buffer, length);
+    if (kStatus_USB_Success != error)
+    {
+        OSA_ENTER_CRITICAL();
+        pipe->isBusy  = 0U;
+        pipe->request = NULL;
+        if (NULL != request)
+        {
+            /* Put the request back to the head of the queue, it is sent next time */
+            bin           = USB_DevicePhdcQosBin(request->qos);
+            request->next = queue->head[bin];
+            if (NULL == queue->head[bin])
+            {
+                queue->tail[bin] = request;
+            }
+            queue->head[bin] = request;
+            if (0U != announced)
+            {
+                phdcHandle->preambleTransfers++;
+            }
+        }
+        else
+        {
+            phdcHandle->preambleTransfers = 0U;
+        }
+        OSA_EXIT_CRITICAL();
+    }
+    return error;
+}
+
+/*!
+ * @brief Complete the transfer of a sending pipe.
+ *
+ * This function frees the queued request of the transfer and sends the next queued data before the application is
+ * notified.
+ *
+ * @param phdcHandle      The device PHDC class handle.
+ * @param pipe            The interrupt IN pipe or the bulk IN pipe.
+ * @param message         The result of the pipe transfer.
+ *
+ * @return 1 if the application is notified, 0 if the transfer is the Meta-data message preamble of the class.
+ */
+static uint8_t USB_DevicePhdcSendDone(usb_device_phdc_struct_t *phdcHandle,
+                                      usb_device_phdc_pipe_t *pipe,
+                                      usb_device_endpoint_callback_message_struct_t *message)
+{
+    usb_device_phdc_send_request_t *request;
+    uint8_t notify = 1U;
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    request       = pipe->request;
+    pipe->request = NULL;
+    pipe->isBusy  = 0U;
+    if (NULL != request)
+    {
+        request->next                  = phdcHandle->sendQueue.freeList;
+        phdcHandle->sendQueue.freeList = request;
+    }
+    if (pipe == &phdcHandle->bulkIn)
+    {
+        if (message->buffer == phdcHandle->preambleBuffer)
+        {
+            notify = 0U;
+        }
+        if (USB_CANCELLED_TRANSFER_LENGTH == message->length)
+        {
+            /* The host does not get the announced transfers */
+            phdcHandle->preambleTransfers = 0U;
+        }
+    }
+    OSA_EXIT_CRITICAL();
+
+    /* The pipe is stopped by the bus reset, the interface change or the stall when the transfer is cancelled */
+    if (USB_CANCELLED_TRANSFER_LENGTH != message->length)
+    {
+        (void)USB_DevicePhdcSchedule(phdcHandle, pipe);
+    }
+    return notify;
+}
+
 /*!
  * @brief bulk IN endpoint callback function.
  *
@@ -120,7 +438,10 @@ static usb_status_t USB_DevicePhdcBulkInCallback(usb_device_handle handle,
     {
         return kStatus_USB_InvalidHandle;
     }
-    phdcHandle->bulkIn.isBusy = 0U;
+    if (0U == USB_DevicePhdcSendDone(phdcHandle, &phdcHandle->bulkIn, message))
+    {
+        return kStatus_USB_Success;
+    }
     if ((NULL != phdcHandle->configStruct) && (NULL != phdcHandle->configStruct->classCallback))
     {
         /* classCallback is initialized in classInit of s_UsbDeviceClassInterfaceMap,
@@ -200,7 +521,7 @@ static usb_status_t USB_DevicePhdcInterruptInCallback(usb_device_handle handle,
     {
         return kStatus_USB_InvalidHandle;
     }
-    phdcHandle->interruptIn.isBusy = 0U;
+    (void)USB_DevicePhdcSendDone(phdcHandle, &phdcHandle->interruptIn, message);
     if ((NULL != phdcHandle->configStruct) && (NULL != phdcHandle->configStruct->classCallback))
     {
         /* classCallback is initialized in classInit of s_UsbDeviceClassInterfaceMap,
@@ -361,7 +682,10 @@ usb_status_t USB_DevicePhdcEvent(void *handle, uint32_t event, void *param)
             phdcHandle->bulkIn.isBusy      = 0U;
             phdcHandle->bulkOut.isBusy     = 0U;
             phdcHandle->interruptIn.isBusy = 0U;
-            error                          = kStatus_USB_Success;
+            /* The bus reset clears the Meta-data message preamble feature */
+            phdcHandle->preambleEnabled = 0U;
+            USB_DevicePhdcSendQueueFlush(phdcHandle);
+            error = kStatus_USB_Success;
             break;
         case kUSB_DeviceClassEventSetConfiguration:
             temp8 = ((uint8_t *)param);
@@ -379,6 +703,7 @@ usb_status_t USB_DevicePhdcEvent(void *handle, uint32_t event, void *param)
             {
                 error = USB_DevicePhdcEndpointsDeinit(phdcHandle);
             }
+            USB_DevicePhdcSendQueueFlush(phdcHandle);
             phdcHandle->configuration = *temp8;
             phdcHandle->alternate     = 0U;
             error                     = USB_DevicePhdcEndpointsInit(phdcHandle);
@@ -401,7 +726,8 @@ usb_status_t USB_DevicePhdcEvent(void *handle, uint32_t event, void *param)
                 error = kStatus_USB_Success;
                 break;
             }
-            error                 = USB_DevicePhdcEndpointsDeinit(phdcHandle);
+            error = USB_DevicePhdcEndpointsDeinit(phdcHandle);
+            USB_DevicePhdcSendQueueFlush(phdcHandle);
             phdcHandle->alternate = alternate;
             error                 = USB_DevicePhdcEndpointsInit(phdcHandle);
             break;
@@ -475,6 +801,8 @@ usb_status_t USB_DevicePhdcEvent(void *handle, uint32_t event, void *param)
                                 phdcHandle->interruptIn.pipeDataLen    = 0U;
                             }
                         }
+                        /* The queued data waits for the transfer cancelled by the stall */
+                        (void)USB_DevicePhdcSchedule(phdcHandle, &phdcHandle->interruptIn);
                     }
                     else if (USB_IN == ((phdcHandle->interfaceHandle->endpointList.endpoint[count].endpointAddress &
                                          USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_MASK) >>
@@ -506,6 +834,7 @@ usb_status_t USB_DevicePhdcEvent(void *handle, uint32_t event, void *param)
                                 phdcHandle->bulkIn.pipeDataLen    = 0U;
                             }
                         }
+                        (void)USB_DevicePhdcSchedule(phdcHandle, &phdcHandle->bulkIn);
                     }
                     else
                     {
@@ -567,6 +896,13 @@ usb_status_t USB_DevicePhdcEvent(void *handle, uint32_t event, void *param)
                         it is from the second parameter of classInit */
                         error = phdcHandle->configStruct->classCallback(
                             (class_handle_t)phdcHandle, kUSB_DevicePhdcEventSetFeature, &controlRequest->setup->wValue);
+                        if ((kStatus_USB_Success == error) &&
+                            (USB_DEVICE_PHDC_FEATURE_METADATA == (controlRequest->setup->wValue & 0xFFU)))
+                        {
+                            /* The bulk data queued by USB_DevicePhdcQueueSend is preceded by the preamble */
+                            phdcHandle->preambleEnabled   = 1U;
+                            phdcHandle->preambleTransfers = 0U;
+                        }
                     }
                 }
                 break;
@@ -581,6 +917,12 @@ usb_status_t USB_DevicePhdcEvent(void *handle, uint32_t event, void *param)
                         error = phdcHandle->configStruct->classCallback((class_handle_t)phdcHandle,
                                                                         kUSB_DevicePhdcEventClearFeature,
                                                                         &controlRequest->setup->wValue);
+                        if ((kStatus_USB_Success == error) &&
+                            (USB_DEVICE_PHDC_FEATURE_METADATA == (controlRequest->setup->wValue & 0xFFU)))
+                        {
+                            phdcHandle->preambleEnabled   = 0U;
+                            phdcHandle->preambleTransfers = 0U;
+                        }
                     }
                 }
                 break;
@@ -647,9 +989,12 @@ usb_status_t USB_DevicePhdcInit(uint8_t controllerId, usb_device_class_config_st
     {
         return kStatus_USB_InvalidHandle;
     }
-    phdcHandle->configStruct  = config;
-    phdcHandle->configuration = 0U;
-    phdcHandle->alternate     = 0xff;
+    phdcHandle->configStruct    = config;
+    phdcHandle->configuration   = 0U;
+    phdcHandle->alternate       = 0xff;
+    phdcHandle->preambleEnabled = 0U;
+    phdcHandle->preambleBuffer  = s_PhdcPreambleBuffer[phdcHandle - &g_phdcHandle[0]];
+    USB_DevicePhdcSendQueueReset(phdcHandle);
 
     *handle = (class_handle_t)phdcHandle;
     return error;
@@ -677,6 +1022,7 @@ usb_status_t USB_DevicePhdcDeinit(class_handle_t handle)
         return kStatus_USB_InvalidHandle;
     }
     error = USB_DevicePhdcEndpointsDeinit(phdcHandle);
+    USB_DevicePhdcSendQueueFlush(phdcHandle);
 #if (defined(USB_DEVICE_CONFIG_RETURN_VALUE_CHECK) && (USB_DEVICE_CONFIG_RETURN_VALUE_CHECK > 0U))
     if (kStatus_USB_Success != USB_DevicePhdcFreeHandle(phdcHandle))
     {
@@ -792,4 +1138,76 @@ usb_status_t USB_DevicePhdcRecv(class_handle_t handle, uint8_t ep, uint8_t *buff
     return error;
 }
 
+/*!
+ * @brief Queue data to send with a latency/reliability bin.
+ *
+ * The function queues the data in the queue of the bin, the data is sent through the interrupt IN pipe for the
+ * Low.Good bin and through the bulk IN pipe for the other bins.
+ *
+ * @param[in] handle The PHDC class handle got from usb_device_class_config_struct_t::classHandle.
+ * @param[in] qos    The latency/reliability bin.
+ * @param[in] buffer The memory address to hold the data need to be sent.
+ * @param[in] length The data length need to be sent.
+ *
+ * @retval kStatus_USB_InvalidHandle        The device handle not be found.
+ * @retval kStatus_USB_InvalidParameter     The bin is invalid or the pipe of the bin is not available.
+ * @retval kStatus_USB_Busy                 No free send request.
+ * @retval kStatus_USB_Success              The data is queued.
+ */
+usb_status_t USB_DevicePhdcQueueSend(class_handle_t handle, uint8_t qos, uint8_t *buffer, uint32_t length)
+{
+    usb_device_phdc_struct_t *phdcHandle;
+    usb_device_phdc_send_queue_t *queue;
+    usb_device_phdc_send_request_t *request;
+    usb_device_phdc_pipe_t *pipe;
+    uint8_t bin;
+    OSA_SR_ALLOC();
+
+    if (NULL == handle)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    phdcHandle = (usb_device_phdc_struct_t *)handle;
+    queue      = &phdcHandle->sendQueue;
+    bin        = USB_DevicePhdcQosBin(qos);
+    if (bin >= USB_DEVICE_PHDC_QOS_BIN_COUNT)
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+    pipe = (0U == bin) ? &phdcHandle->interruptIn : &phdcHandle->bulkIn;
+    if ((0U == pipe->ep) || (0U == phdcHandle->configuration))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    OSA_ENTER_CRITICAL();
+    request = queue->freeList;
+    if (NULL != request)
+    {
+        queue->freeList = request->next;
+        request->next   = NULL;
+        request->buffer = buffer;
+        request->length = length;
+        request->qos    = qos;
+        if (NULL == queue->tail[bin])
+        {
+            queue->head[bin] = request;
+        }
+        else
+        {
+            queue->tail[bin]->next = request;
+        }
+        queue->tail[bin] = request;
+    }
+    OSA_EXIT_CRITICAL();
+
+    if (NULL == request)
+    {
+        return kStatus_USB_Busy;
+    }
+    /* The error is kept in the queue, the data is sent when the pipe completes the current transfer */
+    (void)USB_DevicePhdcSchedule(phdcHandle, pipe);
+    return kStatus_USB_Success;
+}
+
 #endif
@@ -26,6 +26,40 @@
 #define USB_DEVICE_PHDC_REQUEST_CLEAR_FEATURE (0x01U)
 /*! @brief The PHDC class get data status request */
 #define USB_DEVICE_PHDC_REQUEST_GET_STATUS (0x00U)
+/*! @brief The PHDC Meta-data message preamble feature selector */
+#define USB_DEVICE_PHDC_FEATURE_METADATA (0x01U)
+/*! @brief The PHDC QoS information encoding version */
+#define USB_DEVICE_PHDC_QOS_ENCODING_VERSION (0x01U)
+/*! @brief The Meta-data message preamble signature size */
+#define USB_DEVICE_PHDC_MESSAGE_PREAMBLE_SIGNATURE_SIZE (0x10U)
+/*! @brief The Meta-data message preamble length without opaque data */
+#define USB_DEVICE_PHDC_MESSAGE_PREAMBLE_LENGTH (USB_DEVICE_PHDC_MESSAGE_PREAMBLE_SIGNATURE_SIZE + 4U)
+
+/*! @brief The PHDC latency/reliability bins, the interrupt IN pipe carries the Low.Good bin only */
+#define USB_DEVICE_PHDC_QOS_LOW_GOOD       (0x01U)
+#define USB_DEVICE_PHDC_QOS_MEDIUM_GOOD    (0x02U)
+#define USB_DEVICE_PHDC_QOS_MEDIUM_BETTER  (0x04U)
+#define USB_DEVICE_PHDC_QOS_MEDIUM_BEST    (0x08U)
+#define USB_DEVICE_PHDC_QOS_HIGH_BEST      (0x10U)
+#define USB_DEVICE_PHDC_QOS_VERY_HIGH_BEST (0x20U)
+/*! @brief The latency/reliability bin count */
+#define USB_DEVICE_PHDC_QOS_BIN_COUNT (6U)
+
+/*! @brief The count of send requests one PHDC instance can queue */
+#ifndef USB_DEVICE_CONFIG_PHDC_SEND_QUEUE_SIZE
+#define USB_DEVICE_CONFIG_PHDC_SEND_QUEUE_SIZE (8U)
+#endif
+
+/*!
+ * @brief The maximum transfer count one Meta-data message preamble announces.
+ *
+ * The queued messages of the same bin share one preamble up to this count. The announced messages are sent before
+ * any message of a lower latency bin, so 1 gives the shortest latency to the urgent bulk data.
+ */
+#ifndef USB_DEVICE_CONFIG_PHDC_PREAMBLE_MAX_TRANSFERS
+#define USB_DEVICE_CONFIG_PHDC_PREAMBLE_MAX_TRANSFERS (1U)
+#endif
+
 /*! @brief Available common EVENT types in PHDC class callback */
 typedef enum
 {
@@ -37,16 +71,35 @@ typedef enum
     kUSB_DevicePhdcEventGetStatus,                      /*!< Get status request */
 } usb_device_phdc_event_t;
 
+/*! @brief Definition of queued send request structure. */
+typedef struct _usb_device_phdc_send_request
+{
+    struct _usb_device_phdc_send_request *next; /*!< The next request of the same bin or of the free list */
+    uint8_t *buffer;                            /*!< The data buffer */
+    uint32_t length;                            /*!< The data length */
+    uint8_t qos;                                /*!< The latency/reliability bin of the data */
+} usb_device_phdc_send_request_t;
+
 /*! @brief Definition of pipe structure. */
 typedef struct _usb_device_phdc_pipe
 {
-    uint8_t *pipeDataBuffer; /*!< pipe data buffer backup when stall */
-    uint32_t pipeDataLen;    /*!< pipe data length backup when stall  */
-    uint8_t pipeStall;       /*!< pipe is stall  */
-    uint8_t ep;              /*!< The endpoint number of the pipe. */
-    uint8_t isBusy;          /*!< 1: The pipe is transferring packet, 0: The pipe is idle. */
+    usb_device_phdc_send_request_t *request; /*!< The queued request being sent, NULL for the direct send */
+    uint8_t *pipeDataBuffer;                 /*!< pipe data buffer backup when stall */
+    uint32_t pipeDataLen;                    /*!< pipe data length backup when stall  */
+    uint8_t pipeStall;                       /*!< pipe is stall  */
+    uint8_t ep;                              /*!< The endpoint number of the pipe. */
+    uint8_t isBusy;                          /*!< 1: The pipe is transferring packet, 0: The pipe is idle. */
 } usb_device_phdc_pipe_t;
 
+/*! @brief Definition of send queue structure, one FIFO queue for each latency/reliability bin. */
+typedef struct _usb_device_phdc_send_queue
+{
+    usb_device_phdc_send_request_t request[USB_DEVICE_CONFIG_PHDC_SEND_QUEUE_SIZE]; /*!< The request pool */
+    usb_device_phdc_send_request_t *freeList;                                       /*!< The free requests */
+    usb_device_phdc_send_request_t *head[USB_DEVICE_PHDC_QOS_BIN_COUNT];            /*!< The queue head of each bin */
+    usb_device_phdc_send_request_t *tail[USB_DEVICE_PHDC_QOS_BIN_COUNT];            /*!< The queue tail of each bin */
+} usb_device_phdc_send_queue_t;
+
 /*! @brief The PHDC device class status structure */
 typedef struct _usb_device_phdc_struct
 {
@@ -56,9 +109,14 @@ typedef struct _usb_device_phdc_struct
     usb_device_phdc_pipe_t bulkIn;                  /*!< The bulk in pipe for sending data */
     usb_device_phdc_pipe_t bulkOut;                 /*!< The bulk out pipe for receiving data */
     usb_device_phdc_pipe_t interruptIn;             /*!< The interrupt in pipe for sending data */
+    usb_device_phdc_send_queue_t sendQueue;         /*!< The queues of the data sent by USB_DevicePhdcQueueSend */
+    uint8_t *preambleBuffer;                        /*!< The Meta-data message preamble buffer */
     uint8_t configuration;                          /*!< Current configuration */
     uint8_t interfaceNumber;                        /*!< The interface number of the class */
     uint8_t alternate;                              /*!< Current alternate setting of the interface */
+    uint8_t preambleEnabled;                        /*!< The Meta-data message preamble feature is set by the host */
+    uint8_t preambleBin;                            /*!< The bin announced by the last preamble */
+    uint8_t preambleTransfers;                      /*!< The transfers the last preamble announced, not sent yet */
 } usb_device_phdc_struct_t;
 
 /*******************************************************************************
@@ -156,6 +214,33 @@ extern usb_status_t USB_DevicePhdcSend(class_handle_t handle, uint8_t ep, uint8_
  */
 extern usb_status_t USB_DevicePhdcRecv(class_handle_t handle, uint8_t ep, uint8_t *buffer, uint32_t length);
 
+/*!
+ * @brief Queues data to send with a latency/reliability bin.
+ *
+ * The function queues the data in the queue of the bin and the class sends the queued data of the lowest latency bin
+ * first when the pipe is idle. The Low.Good data is sent through the interrupt IN pipe, so it does not wait for the
+ * bulk data, and the data of the other bins is sent through the bulk IN pipe. When the host sets the Meta-data
+ * message preamble feature, the class sends the preamble of the bin before the bulk data.
+ * The kUSB_DevicePhdcEventInterruptInSendComplete or kUSB_DevicePhdcEventBulkInSendComplete event is notified
+ * for each queued data, the queued data is notified with USB_CANCELLED_TRANSFER_LENGTH when the bus is reset or
+ * the interface is changed.
+ *
+ * @param[in] handle The PHDC class handle received from usb_device_class_config_struct_t::classHandle.
+ * @param[in] qos    The latency/reliability bin, one of USB_DEVICE_PHDC_QOS_LOW_GOOD to
+ *                   USB_DEVICE_PHDC_QOS_VERY_HIGH_BEST.
+ * @param[in] buffer The memory address to hold the data to be sent.
+ * @param[in] length The data length to be sent.
+ *
+ * @retval kStatus_USB_InvalidHandle        The device handle is not found.
+ * @retval kStatus_USB_InvalidParameter     The bin is invalid or the pipe of the bin is not available.
+ * @retval kStatus_USB_Busy                 No free send request, see USB_DEVICE_CONFIG_PHDC_SEND_QUEUE_SIZE.
+ * @retval kStatus_USB_Success              The data is queued.
+ *
+ * @note Do not call USB_DevicePhdcSend for a pipe used by this function, the direct data may break the transfers
+ * announced by the preamble.
+ */
+extern usb_status_t USB_DevicePhdcQueueSend(class_handle_t handle, uint8_t qos, uint8_t *buffer, uint32_t length);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -23,6 +23,10 @@
  * Prototypes
  ******************************************************************************/
 
+static usb_status_t USB_DevicePrinterStreamPrime(usb_device_printer_struct_t *printerHandle);
+static usb_status_t USB_DevicePrinterStreamReceived(usb_device_printer_struct_t *printerHandle,
+                                                    usb_device_endpoint_callback_message_struct_t *message);
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -62,6 +66,102 @@ static usb_status_t USB_DevicePrinterFreeHandle(usb_device_printer_struct_t *pri
     return kStatus_USB_Success;
 }
 
+/*!
+ * @brief Prime a free buffer of the receive stream.
+ *
+ * This function primes the next free stream buffer in the bulk OUT pipe, if no buffer is primed and the flow control
+ * hook does not hold the pipe. The host is NAKed while no buffer is primed.
+ *
+ * @param printerHandle   The printer class handle.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_DevicePrinterStreamPrime(usb_device_printer_struct_t *printerHandle)
+{
+    usb_device_printer_stream_struct_t *stream = &printerHandle->stream;
+    usb_status_t status                        = kStatus_USB_Success;
+    uint8_t *buffer                            = NULL;
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    if ((NULL != stream->config.buffer) && (0U == stream->primed) && (NULL != printerHandle->interfaceHandle) &&
+        (0U != printerHandle->bulkOutEndpoint) && (stream->count < USB_DEVICE_CONFIG_PRINTER_STREAM_BUFFER_COUNT))
+    {
+        stream->primed = 1U;
+        buffer         = &stream->config.buffer[stream->writeIndex * stream->config.bufferSize];
+    }
+    OSA_EXIT_CRITICAL();
+
+    if (NULL != buffer)
+    {
+        if ((NULL != stream->config.flowControlFn) &&
+            (0U != stream->config.flowControlFn(stream->config.flowControlParam, stream->count)))
+        {
+            /* The print engine cannot take more data, hold the pipe until USB_DevicePrinterStreamResume */
+            stream->primed = 0U;
+        }
+        else
+        {
+            status = USB_DevicePrinterRecv((class_handle_t)printerHandle, printerHandle->bulkOutEndpoint, buffer,
+                                           stream->config.bufferSize);
+            if (kStatus_USB_Success != status)
+            {
+                stream->primed = 0U;
+            }
+        }
+    }
+    return status;
+}
+
+/*!
+ * @brief Handle the received buffer of the receive stream.
+ *
+ * This function queues the received buffer to the print engine, primes the next free buffer and notifies the
+ * application.
+ *
+ * @param printerHandle   The printer class handle.
+ * @param message         The result of the bulk OUT pipe transfer.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+static usb_status_t USB_DevicePrinterStreamReceived(usb_device_printer_struct_t *printerHandle,
+                                                    usb_device_endpoint_callback_message_struct_t *message)
+{
+    usb_device_printer_stream_struct_t *stream = &printerHandle->stream;
+    usb_status_t status                        = kStatus_USB_Success;
+    OSA_SR_ALLOC();
+
+    /* The cancelled buffer is primed again when the pipe is initialized or un-stalled */
+    if (USB_CANCELLED_TRANSFER_LENGTH == message->length)
+    {
+        stream->primed = 0U;
+        return kStatus_USB_Success;
+    }
+
+    OSA_ENTER_CRITICAL();
+    stream->primed = 0U;
+    if (0U != message->length)
+    {
+        stream->length[stream->writeIndex] = message->length;
+        stream->writeIndex = (uint8_t)((stream->writeIndex + 1U) % USB_DEVICE_CONFIG_PRINTER_STREAM_BUFFER_COUNT);
+        stream->count++;
+    }
+    OSA_EXIT_CRITICAL();
+
+    /* Prime the next buffer before notifying the application, so the host keeps sending */
+    (void)USB_DevicePrinterStreamPrime(printerHandle);
+
+    if ((0U != message->length) && (NULL != printerHandle->classConfig) &&
+        (NULL != printerHandle->classConfig->classCallback))
+    {
+        /* ClassCallback is initialized in classInit of s_UsbDeviceClassInterfaceMap,
+        it is from the second parameter of classInit */
+        status = printerHandle->classConfig->classCallback((class_handle_t)printerHandle,
+                                                           kUSB_DevicePrinterEventStreamData, message);
+    }
+    return status;
+}
+
 /*!
  * @brief bulk IN endpoint callback function.
  *
@@ -129,6 +229,10 @@ static usb_status_t USB_DevicePrinterBulkOutCallback(usb_device_handle handle,
         return kStatus_USB_InvalidHandle;
     }
     printerHandle->bulkOutBusy = 0U;
+    if (NULL != printerHandle->stream.config.buffer)
+    {
+        return USB_DevicePrinterStreamReceived(printerHandle, message);
+    }
     if ((NULL != printerHandle->classConfig) && (NULL != printerHandle->classConfig->classCallback))
     {
         /* ClassCallback is initialized in classInit of s_UsbDeviceClassInterfaceMap,
@@ -220,6 +324,7 @@ static usb_status_t USB_DevicePrinterEndpointsInit(usb_device_printer_struct_t *
             printerHandle->bulkOutPipeDataBuffer = (uint8_t *)USB_INVALID_TRANSFER_BUFFER;
             printerHandle->bulkOutPipeStall      = 0U;
             printerHandle->bulkOutPipeDataLen    = 0U;
+            printerHandle->bulkOutEndpoint = epInitStruct.endpointAddress & USB_DESCRIPTOR_ENDPOINT_ADDRESS_NUMBER_MASK;
         }
         epCallback.callbackParam = printerHandle;
 
@@ -297,6 +402,8 @@ usb_status_t USB_DevicePrinterInit(uint8_t controllerId,
     printerHandle->configuration   = 0U;
     printerHandle->interfaceNumber = 0U;
     printerHandle->interfaceHandle = NULL;
+    printerHandle->bulkOutEndpoint = 0U;
+    printerHandle->stream.config.buffer = NULL;
 
     *handle = (class_handle_t)printerHandle;
 
@@ -348,6 +455,8 @@ usb_status_t USB_DevicePrinterEvent(void *handle, uint32_t event, void *param)
             printerHandle->interfaceNumber = 0U;
             printerHandle->bulkInBusy      = 0U;
             printerHandle->bulkOutBusy     = 0U;
+            printerHandle->bulkOutEndpoint = 0U;
+            printerHandle->stream.primed   = 0U;
             status                         = kStatus_USB_Success;
             break;
 
@@ -376,6 +485,7 @@ usb_status_t USB_DevicePrinterEvent(void *handle, uint32_t event, void *param)
 
             /* Initialize the endpoints of the new current configuration */
             status = USB_DevicePrinterEndpointsInit(printerHandle);
+            (void)USB_DevicePrinterStreamPrime(printerHandle);
             break;
 
         case kUSB_DeviceClassEventSetInterface:
@@ -407,6 +517,7 @@ usb_status_t USB_DevicePrinterEvent(void *handle, uint32_t event, void *param)
             printerHandle->bulkOutBusy = 0U;
             /* Initialize new endpoints */
             status = USB_DevicePrinterEndpointsInit(printerHandle);
+            (void)USB_DevicePrinterStreamPrime(printerHandle);
             break;
 
         case kUSB_DeviceClassEventSetEndpointHalt:
@@ -520,6 +631,8 @@ usb_status_t USB_DevicePrinterEvent(void *handle, uint32_t event, void *param)
                                 printerHandle->bulkOutPipeDataLen    = 0U;
                             }
                         }
+                        /* Prime the stream buffer cancelled by the stall */
+                        (void)USB_DevicePrinterStreamPrime(printerHandle);
                     }
                     break;
                 }
@@ -595,6 +708,7 @@ usb_status_t USB_DevicePrinterEvent(void *handle, uint32_t event, void *param)
                         (void)USB_DevicePrinterEndpointsDeinit(printerHandle);
                         (void)USB_DevicePrinterEndpointsInit(printerHandle);
 #endif
+                        (void)USB_DevicePrinterStreamPrime(printerHandle);
                         /* ClassCallback is initialized in classInit of s_UsbDeviceClassInterfaceMap,
                         it is from the second parameter of classInit */
                         status = printerHandle->classConfig->classCallback(
@@ -677,4 +791,92 @@ usb_status_t USB_DevicePrinterRecv(class_handle_t handle, uint8_t ep, uint8_t *b
 
     return status;
 }
+
+usb_status_t USB_DevicePrinterStreamInit(class_handle_t handle, usb_device_printer_stream_config_struct_t *config)
+{
+    usb_device_printer_struct_t *printerHandle = (usb_device_printer_struct_t *)handle;
+    usb_device_printer_stream_struct_t *stream;
+
+    if (NULL == handle)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if ((NULL == config) || (NULL == config->buffer) || (0U == config->bufferSize))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    stream = &printerHandle->stream;
+    if ((0U != stream->primed) || (0U != printerHandle->bulkOutBusy))
+    {
+        return kStatus_USB_Busy;
+    }
+    stream->config     = *config;
+    stream->writeIndex = 0U;
+    stream->readIndex  = 0U;
+    stream->count      = 0U;
+
+    return USB_DevicePrinterStreamPrime(printerHandle);
+}
+
+usb_status_t USB_DevicePrinterStreamGet(class_handle_t handle, uint8_t **buffer, uint32_t *length)
+{
+    usb_device_printer_struct_t *printerHandle = (usb_device_printer_struct_t *)handle;
+    usb_device_printer_stream_struct_t *stream;
+
+    if (NULL == handle)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+    if ((NULL == buffer) || (NULL == length))
+    {
+        return kStatus_USB_InvalidParameter;
+    }
+
+    stream = &printerHandle->stream;
+    /* The count is only increased in the callback, the oldest buffer is kept until it is released */
+    if ((NULL == stream->config.buffer) || (0U == stream->count))
+    {
+        return kStatus_USB_Busy;
+    }
+    *buffer = &stream->config.buffer[stream->readIndex * stream->config.bufferSize];
+    *length = stream->length[stream->readIndex];
+    return kStatus_USB_Success;
+}
+
+usb_status_t USB_DevicePrinterStreamRelease(class_handle_t handle)
+{
+    usb_device_printer_struct_t *printerHandle = (usb_device_printer_struct_t *)handle;
+    usb_device_printer_stream_struct_t *stream;
+    OSA_SR_ALLOC();
+
+    if (NULL == handle)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+
+    stream = &printerHandle->stream;
+    OSA_ENTER_CRITICAL();
+    if (0U == stream->count)
+    {
+        OSA_EXIT_CRITICAL();
+        return kStatus_USB_Error;
+    }
+    stream->readIndex = (uint8_t)((stream->readIndex + 1U) % USB_DEVICE_CONFIG_PRINTER_STREAM_BUFFER_COUNT);
+    stream->count--;
+    OSA_EXIT_CRITICAL();
+
+    /* The pipe may wait for the free buffer */
+    return USB_DevicePrinterStreamPrime(printerHandle);
+}
+
+usb_status_t USB_DevicePrinterStreamResume(class_handle_t handle)
+{
+    if (NULL == handle)
+    {
+        return kStatus_USB_InvalidHandle;
+    }
+
+    return USB_DevicePrinterStreamPrime((usb_device_printer_struct_t *)handle);
+}
 #endif
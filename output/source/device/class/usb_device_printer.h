@@ -38,6 +38,11 @@
 #define USB_DEVICE_PRINTER_PORT_STATUS_DEFAULT_VALUE \
     (USB_DEVICE_PRINTER_PORT_STATUS_SELECT_MASK | USB_DEVICE_PRINTER_PORT_STATUS_NOT_ERROR_MASK)
 
+/*! @brief The buffer count of the printer receive stream */
+#ifndef USB_DEVICE_CONFIG_PRINTER_STREAM_BUFFER_COUNT
+#define USB_DEVICE_CONFIG_PRINTER_STREAM_BUFFER_COUNT (4U)
+#endif
+
 /*! @brief Available common EVENT types in printer class callback */
 typedef enum _usb_device_printer_event
 {
@@ -46,6 +51,8 @@ typedef enum _usb_device_printer_event
     kUSB_DevicePrinterEventGetDeviceId,          /*!< Get device ID request */
     kUSB_DevicePrinterEventGetPortStatus,        /*!< Get port status request */
     kUSB_DevicePrinterEventSoftReset,            /*!< Soft reset request */
+    kUSB_DevicePrinterEventStreamData,           /*!< A receive stream buffer is filled, get it by
+                                                      USB_DevicePrinterStreamGet */
 } usb_device_printer_event_t;
 
 typedef struct _usb_device_printer_class_request
@@ -57,6 +64,37 @@ typedef struct _usb_device_printer_class_request
     uint8_t configIndex;      /*!< GET_DEVICE_ID request config index */
 } usb_device_printer_class_request_t;
 
+/*!
+ * @brief The flow control hook of the printer receive stream.
+ *
+ * @param param  The flowControlParam of the stream configuration.
+ * @param count  The received buffers not released by the print engine.
+ *
+ * @return Non-zero to hold the bulk OUT pipe (the host is NAKed) until USB_DevicePrinterStreamResume is called.
+ */
+typedef uint8_t (*usb_device_printer_flow_control_t)(void *param, uint32_t count);
+
+/*! @brief The printer receive stream configuration */
+typedef struct _usb_device_printer_stream_config_struct
+{
+    uint8_t *buffer; /*!< The stream buffers, USB_DEVICE_CONFIG_PRINTER_STREAM_BUFFER_COUNT * bufferSize bytes,
+                          aligned to USB_DATA_ALIGN_SIZE */
+    uint32_t bufferSize; /*!< The size of one buffer, a multiple of the bulk OUT max packet size */
+    usb_device_printer_flow_control_t flowControlFn; /*!< The flow control hook, optional */
+    void *flowControlParam;                          /*!< The parameter of flowControlFn */
+} usb_device_printer_stream_config_struct_t;
+
+/*! @brief The printer receive stream state */
+typedef struct _usb_device_printer_stream_struct
+{
+    usb_device_printer_stream_config_struct_t config;               /*!< The stream configuration */
+    uint32_t length[USB_DEVICE_CONFIG_PRINTER_STREAM_BUFFER_COUNT]; /*!< The received length of each buffer */
+    uint8_t writeIndex; /*!< The buffer primed, or primed next, in the bulk OUT pipe */
+    uint8_t readIndex;  /*!< The oldest received buffer */
+    uint8_t count;      /*!< The received buffers not released by the print engine */
+    uint8_t primed;     /*!< The buffer of writeIndex is primed */
+} usb_device_printer_stream_struct_t;
+
 /*! @brief The printer device class instance structure */
 typedef struct _usb_device_printer_struct
 {
@@ -67,6 +105,7 @@ typedef struct _usb_device_printer_struct
     uint32_t bulkInPipeDataLen;                     /*!< IN pipe data length backup when stall  */
     uint8_t *bulkOutPipeDataBuffer;                 /*!< OUT pipe data buffer backup when stall */
     uint32_t bulkOutPipeDataLen;                    /*!< OUT pipe data length backup when stall  */
+    usb_device_printer_stream_struct_t stream;      /*!< The receive stream, used when the buffers are set */
     uint8_t configuration;                          /*!< Current configuration */
     uint8_t interfaceNumber;                        /*!< Interface number in the device descriptor */
     uint8_t alternate;                              /*!< Interface alternate value */
@@ -74,6 +113,7 @@ typedef struct _usb_device_printer_struct
     uint8_t bulkOutBusy;                            /*!< BULK OUT pipe busy flag */
     uint8_t bulkInPipeStall;                        /*!< bulk IN pipe stall flag */
     uint8_t bulkOutPipeStall;                       /*!< bulk OUT pipe stall flag */
+    uint8_t bulkOutEndpoint;                        /*!< bulk OUT endpoint number */
 } usb_device_printer_struct_t;
 
 /*******************************************************************************
@@ -180,6 +220,55 @@ extern usb_status_t USB_DevicePrinterSend(class_handle_t handle, uint8_t ep, uin
  */
 extern usb_status_t USB_DevicePrinterRecv(class_handle_t handle, uint8_t ep, uint8_t *buffer, uint32_t length);
 
+/*!
+ * @brief Initializes the receive stream.
+ *
+ * In the stream mode the class keeps one of the stream buffers primed in the bulk OUT pipe, and primes the next free
+ * buffer in the transfer callback, so the host is not stalled between the buffers while the print engine works. The
+ * received buffers are queued to the print engine and the event kUSB_DevicePrinterEventStreamData is sent to the
+ * application, the print engine gets them by USB_DevicePrinterStreamGet and releases them by
+ * USB_DevicePrinterStreamRelease. When all buffers are received and not released, or flowControlFn holds the pipe,
+ * no buffer is primed and the host is NAKed.
+ * USB_DevicePrinterRecv must not be used in the stream mode.
+ *
+ * @param[in] handle The printer class handle received from usb_device_class_config_struct_t::classHandle.
+ * @param[in] config The stream configuration.
+ * @return A USB error code or kStatus_USB_Success.
+ */
+extern usb_status_t USB_DevicePrinterStreamInit(class_handle_t handle,
+                                                usb_device_printer_stream_config_struct_t *config);
+
+/*!
+ * @brief Gets the oldest received buffer of the receive stream.
+ *
+ * The function returns the same buffer until it is released by USB_DevicePrinterStreamRelease.
+ *
+ * @param[in] handle  The printer class handle received from usb_device_class_config_struct_t::classHandle.
+ * @param[out] buffer Returns the buffer address.
+ * @param[out] length Returns the received length.
+ * @return A USB error code or kStatus_USB_Success.
+ * @retval kStatus_USB_Busy             No buffer is received.
+ */
+extern usb_status_t USB_DevicePrinterStreamGet(class_handle_t handle, uint8_t **buffer, uint32_t *length);
+
+/*!
+ * @brief Releases the oldest received buffer of the receive stream.
+ *
+ * The buffer is primed again if the bulk OUT pipe is waiting for a free buffer.
+ *
+ * @param[in] handle The printer class handle received from usb_device_class_config_struct_t::classHandle.
+ * @return A USB error code or kStatus_USB_Success.
+ */
+extern usb_status_t USB_DevicePrinterStreamRelease(class_handle_t handle);
+
+/*!
+ * @brief Resumes the receive stream held by the flow control hook.
+ *
+ * @param[in] handle The printer class handle received from usb_device_class_config_struct_t::classHandle.
+ * @return A USB error code or kStatus_USB_Success.
+ */
+extern usb_status_t USB_DevicePrinterStreamResume(class_handle_t handle);
+
 /*! @}*/
 
 #if defined(__cplusplus)
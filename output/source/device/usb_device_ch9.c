@@ -56,6 +56,12 @@ static usb_status_t USB_DeviceCh9GetDescriptor(usb_device_common_class_struct_t
                                                usb_setup_struct_t *setup,
                                                uint8_t **buffer,
                                                uint32_t *length);
+#if ((defined(USB_DEVICE_CONFIG_DESCRIPTOR_TABLE)) && (USB_DEVICE_CONFIG_DESCRIPTOR_TABLE > 0U))
+static usb_status_t USB_DeviceCh9GetTableDescriptor(usb_device_common_class_struct_t *classHandle,
+                                                    usb_setup_struct_t *setup,
+                                                    uint8_t **buffer,
+                                                    uint32_t *length);
+#endif
 static usb_status_t USB_DeviceCh9GetConfiguration(usb_device_common_class_struct_t *classHandle,
                                                   usb_setup_struct_t *setup,
                                                   uint8_t **buffer,
@@ -448,6 +454,60 @@ static usb_status_t USB_DeviceCh9SetAddress(usb_device_common_class_struct_t *cl
     return error;
 }
 
+#if ((defined(USB_DEVICE_CONFIG_DESCRIPTOR_TABLE)) && (USB_DEVICE_CONFIG_DESCRIPTOR_TABLE > 0U))
+/*!
+ * @brief Handle get descriptor request from the descriptor table.
+ *
+ * This function looks the requested descriptor up in the registered descriptor table.
+ *
+ * @param handle          The device handle. It equals the value returned from USB_DeviceInit.
+ * @param setup           The pointer of the setup packet.
+ * @param buffer          It is an out parameter, is used to save the buffer address to response the host's request.
+ * @param length          It is an out parameter, the data length.
+ *
+ * @retval kStatus_USB_Success              The descriptor is in the table.
+ * @retval kStatus_USB_InvalidRequest       The descriptor is not in the table.
+ */
+static usb_status_t USB_DeviceCh9GetTableDescriptor(usb_device_common_class_struct_t *classHandle,
+                                                    usb_setup_struct_t *setup,
+                                                    uint8_t **buffer,
+                                                    uint32_t *length)
+{
+    const usb_device_descriptor_entry_struct_t *entry;
+    uint8_t descriptorType  = (uint8_t)((setup->wValue & 0xFF00U) >> 8U);
+    uint8_t descriptorIndex = (uint8_t)((setup->wValue & 0x00FFU));
+    uint8_t recipient       = USB_REQUEST_TYPE_RECIPIENT_DEVICE;
+    uint8_t speed           = USB_SPEED_FULL;
+    uint8_t index;
+
+    /* The HID class descriptors are the interface descriptors the ch9 handles */
+    if ((USB_DESCRIPTOR_TYPE_HID == descriptorType) || (USB_DESCRIPTOR_TYPE_HID_REPORT == descriptorType) ||
+        (USB_DESCRIPTOR_TYPE_HID_PHYSICAL == descriptorType))
+    {
+        recipient = USB_REQUEST_TYPE_RECIPIENT_INTERFACE;
+    }
+    if ((setup->bmRequestType & USB_REQUEST_TYPE_RECIPIENT_MASK) != recipient)
+    {
+        return kStatus_USB_InvalidRequest;
+    }
+
+    (void)USB_DeviceGetStatus(classHandle->handle, kUSB_DeviceStatusSpeed, &speed);
+    for (index = 0U; index < classHandle->descriptorTable->count; index++)
+    {
+        entry = &classHandle->descriptorTable->entries[index];
+        if ((descriptorType == entry->type) && (descriptorIndex == entry->index) && (setup->wIndex == entry->wIndex) &&
+            ((USB_DEVICE_DESCRIPTOR_SPEED_ANY == entry->speed) || (speed == entry->speed)))
+        {
+            /* the control IN transfer only reads the buffer */
+            *buffer = (uint8_t *)entry->descriptor;
+            *length = entry->length;
+            return kStatus_USB_Success;
+        }
+    }
+    return kStatus_USB_InvalidRequest;
+}
+
+#endif
 /*!
  * @brief Handle get descriptor request.
  *
@@ -492,6 +552,14 @@ static usb_status_t USB_DeviceCh9GetDescriptor(usb_device_common_class_struct_t
     {
         return error;
     }
+#if ((defined(USB_DEVICE_CONFIG_DESCRIPTOR_TABLE)) && (USB_DEVICE_CONFIG_DESCRIPTOR_TABLE > 0U))
+    /* Only the descriptors not in the table are got from the application. */
+    if ((NULL != classHandle->descriptorTable) &&
+        (kStatus_USB_Success == USB_DeviceCh9GetTableDescriptor(classHandle, setup, buffer, length)))
+    {
+        return kStatus_USB_Success;
+    }
+#endif
     commonDescriptor.commonDescriptor.length = setup->wLength;
     if (USB_DESCRIPTOR_TYPE_DEVICE == descriptorType)
     {